@@ -185,6 +185,13 @@ namespace SceneryEditorX
     void Editor::OnUpdate(DeltaTime dt)
     {
         Module::OnUpdate(dt);
+
+        if (m_CurrentScene && m_CurrentScene == m_EditorScene)
+        {
+            m_TimeSinceLastSave += dt.GetSeconds();
+            if (m_TimeSinceLastSave > 300.0f)
+                SaveSceneAuto();
+        }
     }
 
     void Editor::OnUIRender()
@@ -255,6 +262,12 @@ namespace SceneryEditorX
 
     void Editor::SaveSceneAuto()
     {
+        if (!m_EditorScene || m_SceneFilePath.empty())
+            return;
+
+        /// Runs at the frame boundary; only the registry copy happens here, encoding and I/O are on a worker.
+        if (m_SceneAutosave.Begin(*m_EditorScene, m_SceneFilePath + ".auto"))
+            m_TimeSinceLastSave = 0.0f;
     }
 
     void Editor::SaveSceneAs()
@@ -20,6 +20,7 @@
 #include <SceneryEditorX/core/events/key_events.h>
 #include <SceneryEditorX/core/events/mouse_events.h>
 #include <SceneryEditorX/platform/settings/user_settings.h>
+#include <SceneryEditorX/scene/scene_snapshot.h>
 #include <Editor/core/viewport.h>
 
 /// ---------------------------------------------------------
@@ -160,6 +161,7 @@ namespace SceneryEditorX
         } m_LoadAutoSavePopupData;
 
 		float m_TimeSinceLastSave = 0.0f; /// time (in seconds) since scene was last saved.  Counts up only when scene is in Edit mode. If exceeds 300s then scene is automatically saved
+		SceneAutosave m_SceneAutosave;    /// copies the scene between frames and writes the snapshot on a worker thread
 
 		float m_RequiredProjectVersion = 0.0f;
 		bool m_ProjectUpdateNeeded = false;
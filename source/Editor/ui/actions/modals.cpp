@@ -10,7 +10,9 @@
 * Created: 29/3/2025
 * -------------------------------------------------------
 */
+#include <format>
 #include <imgui/imgui.h>
+#include <SceneryEditorX/asset/xplane/dsf_writer.h>
 #include <SceneryEditorX/ui/ui.h>
 
 // -------------------------------------------------------
@@ -27,6 +29,11 @@ namespace UI
     INTERNAL char projectName[128];
 	INTERNAL char projectLocation[2048];
 
+	// Export DSF modal state
+	INTERNAL char dsfExportPath[2048];
+	INTERNAL int dsfExportTile[2] = { 0, 0 };
+	INTERNAL std::string dsfExportStatus;
+
 	// ---------------------------------------------------------
 
     void UIManager::ExitConfirmationModal(GLFWwindow *window)
@@ -132,6 +139,58 @@ namespace UI
         }
     }
 
+    void UIManager::ExportDSFModal()
+    {
+        if (!showExportDSFModal)
+            return;
+
+        ImGui::OpenPopup("Export DSF");
+        if (ImGui::BeginPopupModal("Export DSF", &showExportDSFModal, ImGuiWindowFlags_AlwaysAutoResize))
+        {
+            ImGui::Text("Export the project placements as an overlay DSF tile.");
+            ImGui::Separator();
+            ImGui::InputText("Output File", dsfExportPath, sizeof(dsfExportPath));
+            ImGui::InputInt2("Tile West / South", dsfExportTile);
+
+            if (ImGui::Button("Export", ImVec2(100.0f, 0.0f)))
+            {
+                SceneryEditorX::DSFOverlay overlay;
+                overlay.west = dsfExportTile[0];
+                overlay.south = dsfExportTile[1];
+
+                if (!dsfOverlaySource || !dsfOverlaySource(overlay))
+                {
+                    dsfExportStatus = "Nothing to export in this tile.";
+                }
+                else
+                {
+                    SceneryEditorX::DSFWriter writer;
+                    if (writer.Save(overlay, dsfExportPath))
+                    {
+                        const SceneryEditorX::DSFWriteStats &stats = writer.GetStats();
+                        dsfExportStatus = std::format("Wrote {:.1f} KiB ({} points in {} pools) in {:.1f} ms.",
+                                                      stats.outputBytes / 1024.0, stats.pointCount, stats.poolCount, stats.totalMs);
+                    }
+                    else
+                    {
+                        dsfExportStatus = "Export failed: " + writer.GetError();
+                    }
+                }
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Close", ImVec2(100.0f, 0.0f)))
+            {
+                showExportDSFModal = false;
+                dsfExportStatus.clear();
+            }
+
+            if (!dsfExportStatus.empty())
+                ImGui::TextWrapped("%s", dsfExportStatus.c_str());
+
+            ImGui::EndPopup();
+        }
+    }
+
 } // namespace UI
 
 // -------------------------------------------------------
@@ -69,7 +69,11 @@ namespace UI
                     if (ImGui::BeginMenu("Export to File"))
                     {
                         ImGui::MenuItem("Export '.apt'", nullptr);
-                        ImGui::MenuItem("Export '.dsf'", nullptr);
+                        /// Disabled until a project installs dsfOverlaySource; the editor has no placements of its own to export.
+                        if (ImGui::MenuItem("Export '.dsf'", nullptr, false, static_cast<bool>(dsfOverlaySource)))
+                        {
+                            showExportDSFModal = true;
+                        }
                         ImGui::EndMenu();
                     }
                     ImGui::MenuItem("Export Terrain", nullptr);
@@ -204,6 +208,8 @@ namespace UI
 			}
         ImGui::EndMainMenuBar();
         }
+
+        ExportDSFModal();
     }
 
 } // namespace UI
@@ -21,6 +21,7 @@ namespace UI
 	bool showExitModal = false;
 	bool showAboutModal = false;
 	bool showSettingsPanel = false;
+	bool showExportDSFModal = false;
 
 }
 
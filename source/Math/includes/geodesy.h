@@ -0,0 +1,141 @@
+﻿/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* geodesy.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <Math/math_config.h>
+#include <Math/includes/vector.h>
+#include <cstddef>
+
+/// -----------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/// WGS 84 reference ellipsoid (NGA.STND.0036).
+	namespace WGS84
+	{
+		constexpr double A = 6378137.0;					///< Semi-major axis, metres
+		constexpr double F = 1.0 / 298.257223563;		///< Flattening
+		constexpr double B = A * (1.0 - F);				///< Semi-minor axis, metres
+		constexpr double E2 = F * (2.0 - F);			///< First eccentricity squared
+		constexpr double EP2 = E2 / (1.0 - E2);			///< Second eccentricity squared
+	}
+
+	/// Geodetic position on the WGS 84 ellipsoid.
+	struct GeoPosition
+	{
+		double latitude = 0.0;		///< Degrees, north positive
+		double longitude = 0.0;		///< Degrees, east positive
+		double altitude = 0.0;		///< Metres above the ellipsoid
+	};
+
+	/// Earth-centred, earth-fixed metres: +X through the prime meridian on the equator, +Z through the north pole.
+	XMATH_API DVec3 GeodeticToEcef(const GeoPosition &position);
+
+	/**
+	 * @brief Converts earth-centred, earth-fixed metres to a geodetic position.
+	 *
+	 * Bowring's method iterated twice, written with square roots only so the batch version
+	 * vectorises; within a nanometre of the exact solution from the deepest trench to low orbit.
+	 * Points within about 40 km of the centre of the earth are not supported.
+	 */
+	XMATH_API GeoPosition EcefToGeodetic(const DVec3 &ecef);
+
+	/// @name Batch conversions
+	/// Structure of arrays, one element per point. Outputs may alias inputs element for element.
+	/// Runs four points at a time with AVX2 when the processor has it, see IsGeodesyVectorized().
+	/// @{
+	XMATH_API void GeodeticToEcef(const double *latitude, const double *longitude, const double *altitude, double *x, double *y, double *z, size_t count);
+	XMATH_API void EcefToGeodetic(const double *x, const double *y, const double *z, double *latitude, double *longitude, double *altitude, size_t count);
+	/// @}
+
+	/// True when the batch conversions use AVX2 and FMA on this processor.
+	XMATH_API bool IsGeodesyVectorized();
+
+	/// Result of GeodesicInverse().
+	struct GeodesicLine
+	{
+		double distance = 0.0;			///< Metres along the ellipsoid
+		double initialBearing = 0.0;	///< Degrees clockwise from true north at the start, [0, 360)
+		double finalBearing = 0.0;		///< Degrees at the end, in the direction of travel
+		bool converged = true;			///< False for nearly antipodal points, where the result is approximate
+	};
+
+	/**
+	 * @brief Shortest path between two positions on the ellipsoid (Vincenty's inverse formula).
+	 *
+	 * Accurate to well under a millimetre; altitudes are ignored. Nearly antipodal pairs may not
+	 * converge, in which case the last iteration is returned and @c converged is false.
+	 */
+	XMATH_API GeodesicLine GeodesicInverse(const GeoPosition &from, const GeoPosition &to);
+
+	/**
+	 * @brief Position reached by following a geodesic (Vincenty's direct formula).
+	 *
+	 * @param bearing      Degrees clockwise from true north at the start.
+	 * @param distance     Metres along the ellipsoid.
+	 * @param finalBearing Receives the bearing at the destination, if not null.
+	 * @return The destination, at the altitude of @p from.
+	 */
+	XMATH_API GeoPosition GeodesicDirect(const GeoPosition &from, double bearing, double distance, double *finalBearing = nullptr);
+
+	/**
+	 * @brief East-north-up frame tangent to the ellipsoid at an origin, such as an airport datum.
+	 *
+	 * Enu conversions are exact rigid transforms of ECEF coordinates, so "up" drops away from a
+	 * point's altitude with distance from the origin (about 8 m at 10 km). Project() instead maps
+	 * a position to the tangent plane straight along the origin's up axis and keeps its altitude
+	 * as the height, which is how scenery is laid out; Unproject() is its exact inverse.
+	 *
+	 * The batch versions take structures of arrays like the free functions and may be called from
+	 * several threads at once.
+	 */
+	class XMATH_API LocalTangentPlane
+	{
+	public:
+		LocalTangentPlane() : LocalTangentPlane(GeoPosition{}) {}
+		explicit LocalTangentPlane(const GeoPosition &origin);
+
+		[[nodiscard]] const GeoPosition &GetOrigin() const { return m_Origin; }
+		[[nodiscard]] const DVec3 &GetOriginEcef() const { return m_OriginEcef; }
+
+		/// Unit axes of the frame in ECEF.
+		[[nodiscard]] const DVec3 &GetEast() const { return m_East; }
+		[[nodiscard]] const DVec3 &GetNorth() const { return m_North; }
+		[[nodiscard]] const DVec3 &GetUp() const { return m_Up; }
+
+		[[nodiscard]] DVec3 EcefToEnu(const DVec3 &ecef) const;
+		[[nodiscard]] DVec3 EnuToEcef(const DVec3 &enu) const;
+		[[nodiscard]] DVec3 GeodeticToEnu(const GeoPosition &position) const;
+		[[nodiscard]] GeoPosition EnuToGeodetic(const DVec3 &enu) const;
+
+		/// East and north on the tangent plane of the point on the ellipsoid below @p position, and its altitude.
+		[[nodiscard]] DVec3 Project(const GeoPosition &position) const;
+
+		/// Position whose Project() is (@p local.x, @p local.y) with altitude @p local.z. NaN for points off the earth's disc.
+		[[nodiscard]] GeoPosition Unproject(const DVec3 &local) const;
+
+		void GeodeticToEnu(const double *latitude, const double *longitude, const double *altitude, double *east, double *north, double *up, size_t count) const;
+		void EnuToGeodetic(const double *east, const double *north, const double *up, double *latitude, double *longitude, double *altitude, size_t count) const;
+		void Project(const double *latitude, const double *longitude, const double *altitude, double *east, double *north, double *height, size_t count) const;
+		void Unproject(const double *east, const double *north, const double *height, double *latitude, double *longitude, double *altitude, size_t count) const;
+
+	private:
+		GeoPosition m_Origin;
+		DVec3 m_OriginEcef;
+		DVec3 m_East;
+		DVec3 m_North;
+		DVec3 m_Up;
+	};
+
+}
+
+/// -----------------------------------------------------
@@ -0,0 +1,144 @@
+﻿/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* tessellation.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <Math/math_config.h>
+#include <Math/includes/vector.h>
+#include <cstdint>
+#include <vector>
+
+/// -----------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/**
+	 * @brief Polygon node with an optional bezier control point.
+	 *
+	 * Matches apt.dat pavement nodes and DSF bezier polygon windings: the control point is the
+	 * handle leaving the node towards the next one, and the handle arriving from the previous
+	 * node is its mirror image through the node.
+	 */
+	struct TessNode
+	{
+		DVec2 position;
+		DVec2 control;
+		bool bezier = false;
+	};
+
+	/// Closed ring of nodes. The first ring of a polygon is its outer boundary, the rest are holes.
+	using TessRing = std::vector<TessNode>;
+
+	struct TessOptions
+	{
+		double pixelTolerance = 0.25;		///< Maximum distance between a curve and its flattened chord, in pixels
+		double unitsPerPixel = 1.0;			///< Size of a pixel in polygon units at the current zoom
+		uint32_t maxDepth = 12;				///< Subdivision limit per curve, at most 2^maxDepth chords
+
+		[[nodiscard]] double GetTolerance() const { return pixelTolerance * unitsPerPixel; }
+	};
+
+	/// Triangulated polygon. Vertices are the flattened rings in order; ringStarts[i] is the first vertex of ring i.
+	struct TessMesh
+	{
+		std::vector<DVec2> vertices;
+		std::vector<uint32_t> indices;		///< Counter-clockwise triangles
+		std::vector<uint32_t> ringStarts;
+	};
+
+	/**
+	 * @brief Appends the flattened outline of a closed ring to @p out.
+	 *
+	 * Straight edges contribute their start node only. Curved edges are cubic beziers, split
+	 * at their midpoint until the control points lie within the tolerance of the chord, so
+	 * gentle curves and small zoom levels produce few vertices.
+	 */
+	XMATH_API void FlattenRing(const TessRing &ring, const TessOptions &options, std::vector<DVec2> &out);
+
+	/// Appends the flattened edge from @p from to @p to, like one edge of FlattenRing(): the end node is left to the next edge.
+	XMATH_API void FlattenBezierEdge(const TessNode &from, const TessNode &to, const TessOptions &options, std::vector<DVec2> &out);
+
+	/**
+	 * @brief Ear clipping triangulation of a polygon with holes.
+	 *
+	 * Holes are bridged into the outer ring, then ears are clipped with a z-order hash once
+	 * the polygon exceeds a few dozen vertices. Degenerate input (duplicate points, collinear
+	 * runs, self-touching rings, self intersections) never fails: the clipper falls back to
+	 * curing local intersections and then to splitting the polygon along a valid diagonal.
+	 * Follows the approach of Mapbox's earcut.
+	 *
+	 * @param vertices   Flattened rings, outer ring first. Either orientation is accepted.
+	 * @param ringStarts First vertex of each ring. An empty list means a single ring.
+	 * @param indices    Receives counter-clockwise triangles indexing @p vertices.
+	 */
+	XMATH_API void Triangulate(const std::vector<DVec2> &vertices, const std::vector<uint32_t> &ringStarts, std::vector<uint32_t> &indices);
+
+	/**
+	 * @brief Incremental tessellation of one bezier polygon with holes.
+	 *
+	 * Flattened points are cached per edge. Moving a node re-flattens only the two edges
+	 * that meet at it; inserting or removing a node re-flattens only its ring. The polygon is
+	 * then re-triangulated, which is linear in the vertex count for typical pavement, as
+	 * holes tie every ring into one clipping loop.
+	 *
+	 * Changing the zoom only re-flattens when the new tolerance is finer than the cached one
+	 * or more than twice as coarse, so scrolling the wheel does not rebuild every polygon.
+	 */
+	class XMATH_API PolygonTessellator
+	{
+	public:
+		struct UpdateStats
+		{
+			uint32_t edgesFlattened = 0;	///< Edges re-flattened since the last GetMesh()
+			uint32_t ringsAssembled = 0;
+			bool triangulated = false;
+		};
+
+		PolygonTessellator() = default;
+		explicit PolygonTessellator(std::vector<TessRing> rings, const TessOptions &options = {});
+
+		void SetPolygon(std::vector<TessRing> rings, const TessOptions &options = {});
+		void SetOptions(const TessOptions &options);
+
+		void MoveNode(uint32_t ring, uint32_t node, const TessNode &value);
+		void InsertNode(uint32_t ring, uint32_t before, const TessNode &value);
+		void RemoveNode(uint32_t ring, uint32_t node);
+
+		[[nodiscard]] const std::vector<TessRing> &GetRings() const { return m_Rings; }
+		[[nodiscard]] const TessOptions &GetOptions() const { return m_Options; }
+
+		/// Brings the mesh up to date with the edits since the last call.
+		const TessMesh &GetMesh();
+
+		/// What the last GetMesh() had to redo.
+		[[nodiscard]] const UpdateStats &GetLastUpdate() const { return m_LastUpdate; }
+
+	private:
+		void FlattenEdge(uint32_t ring, uint32_t edge);
+		void InvalidateRing(uint32_t ring);
+
+		std::vector<TessRing> m_Rings;
+		TessOptions m_Options;
+		double m_CachedTolerance = 0.0;
+
+		std::vector<std::vector<std::vector<DVec2>>> m_Edges;	///< [ring][edge] flattened points, end node excluded
+		std::vector<std::vector<uint32_t>> m_DirtyEdges;
+		std::vector<uint8_t> m_DirtyRings;
+		bool m_DirtyMesh = true;
+
+		TessMesh m_Mesh;
+		UpdateStats m_Pending;
+		UpdateStats m_LastUpdate;
+	};
+
+}
+
+/// -----------------------------------------------------
@@ -23,6 +23,8 @@ namespace SceneryEditorX
 	using Vec2 = Utils::TVector2<float>;
 	using Vec3 = Utils::TVector3<float>;
 	using Vec4 = Utils::TVector4<float>;
+	using DVec2 = Utils::TVector2<double>;
+	using DVec3 = Utils::TVector3<double>;
 
 	#ifndef SEDX_MATH_HAS_VECTOR_ALIASES
 	#define SEDX_MATH_HAS_VECTOR_ALIASES 1
@@ -0,0 +1,707 @@
+﻿/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* geodesy.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include <Math/includes/geodesy.h>
+#include <cmath>
+#include <numbers>
+
+/// AVX2 kernels are compiled for their target only and picked at run time, so the library still runs on older processors.
+#if defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <immintrin.h>
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+		#define SEDX_AVX2_TARGET
+	#else
+		#define SEDX_AVX2_TARGET __attribute__((target("avx2,fma")))
+	#endif
+	#define SEDX_X_AVX2 1
+#else
+	#define SEDX_X_AVX2 0
+#endif
+
+/// -----------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		constexpr double RADIANS = std::numbers::pi / 180.0;
+		constexpr double DEGREES = 180.0 / std::numbers::pi;
+
+		/// Bowring iterations of EcefToGeodetic(). One is good to a few micrometres near the surface, two to rounding.
+		constexpr int BOWRING_ITERATIONS = 2;
+
+		DVec3 ToEcef(const double latitude, const double longitude, const double altitude)
+		{
+			const double phi = latitude * RADIANS;
+			const double lambda = longitude * RADIANS;
+			const double sinPhi = std::sin(phi);
+			const double cosPhi = std::cos(phi);
+
+			/// Prime vertical radius of curvature.
+			const double n = WGS84::A / std::sqrt(1.0 - WGS84::E2 * sinPhi * sinPhi);
+			return {(n + altitude) * cosPhi * std::cos(lambda), (n + altitude) * cosPhi * std::sin(lambda), (n * (1.0 - WGS84::E2) + altitude) * sinPhi};
+		}
+
+		GeoPosition ToGeodetic(const double x, const double y, const double z)
+		{
+			const double p = std::sqrt(x * x + y * y);
+
+			/// Parametric latitude, first of the point scaled onto a sphere, then from each latitude estimate.
+			double sinBeta = z * WGS84::A;
+			double cosBeta = p * WGS84::B;
+			double numerator = z;
+			double denominator = p;
+			for (int i = 0; i < BOWRING_ITERATIONS; ++i)
+			{
+				const double length = std::sqrt(sinBeta * sinBeta + cosBeta * cosBeta);
+				sinBeta /= length;
+				cosBeta /= length;
+				numerator = z + WGS84::EP2 * WGS84::B * sinBeta * sinBeta * sinBeta;
+				denominator = p - WGS84::E2 * WGS84::A * cosBeta * cosBeta * cosBeta;
+				sinBeta = (1.0 - WGS84::F) * numerator;
+				cosBeta = denominator;
+			}
+
+			/// Height along the normal, without the 1 / cos(latitude) that breaks down at the poles.
+			const double length = std::sqrt(numerator * numerator + denominator * denominator);
+			const double sinPhi = numerator / length;
+			const double cosPhi = denominator / length;
+			const double altitude = p * cosPhi + z * sinPhi - WGS84::A * std::sqrt(1.0 - WGS84::E2 * sinPhi * sinPhi);
+			return {std::atan2(numerator, denominator) * DEGREES, std::atan2(y, x) * DEGREES, altitude};
+		}
+
+		/// Distance along the frame's up axis from @p point to the ellipsoid, nearest crossing first.
+		double DistanceToEllipsoid(const DVec3 &point, const DVec3 &up)
+		{
+			/// Scale the ellipsoid to a unit sphere and solve |p + t d|^2 = 1 in the cancellation free form.
+			const DVec3 p(point.x / WGS84::A, point.y / WGS84::A, point.z / WGS84::B);
+			const DVec3 d(up.x / WGS84::A, up.y / WGS84::A, up.z / WGS84::B);
+			const double a = d.x * d.x + d.y * d.y + d.z * d.z;
+			const double b = p.x * d.x + p.y * d.y + p.z * d.z;
+			const double c = p.x * p.x + p.y * p.y + p.z * p.z - 1.0;
+			const double q = b + std::copysign(std::sqrt(b * b - a * c), b);
+			return -c / q;
+		}
+
+		double NormalizeBearing(const double degrees)
+		{
+			const double bearing = std::fmod(degrees, 360.0);
+			return bearing < 0.0 ? bearing + 360.0 : bearing;
+		}
+
+		double NormalizeLongitude(const double degrees)
+		{
+			const double longitude = std::fmod(degrees + 180.0, 360.0);
+			return (longitude <= 0.0 ? longitude + 360.0 : longitude) - 180.0;
+		}
+
+		/// -----------------------------------------------------
+
+	#if SEDX_X_AVX2
+		bool DetectAvx2()
+		{
+		#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+				return false;
+
+			/// FMA, OSXSAVE and AVX, then the operating system saving the YMM registers, then AVX2.
+			__cpuid(info, 1);
+			constexpr int required = (1 << 12) | (1 << 27) | (1 << 28);
+			if ((info[2] & required) != required || (_xgetbv(0) & 6) != 6)
+				return false;
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+		#else
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+		#endif
+		}
+
+		/// Four lanes of double precision. Polynomials are Taylor series carried far enough that the
+		/// truncation error is below rounding, so lanes agree with the C library to an ulp or two.
+		namespace Avx2
+		{
+			SEDX_AVX2_TARGET inline __m256d Set(const double value)
+			{
+				return _mm256_set1_pd(value);
+			}
+
+			SEDX_AVX2_TARGET inline __m256d Select(const __m256d mask, const __m256d ifTrue, const __m256d ifFalse)
+			{
+				return _mm256_blendv_pd(ifFalse, ifTrue, mask);
+			}
+
+			SEDX_AVX2_TARGET inline __m256d Negate(const __m256d mask, const __m256d value)
+			{
+				return _mm256_xor_pd(value, _mm256_and_pd(mask, Set(-0.0)));
+			}
+
+			/// sin and cos of any angle within a few turns, by Cody-Waite reduction to [-pi/4, pi/4].
+			SEDX_AVX2_TARGET inline void SinCos(const __m256d angle, __m256d &sine, __m256d &cosine)
+			{
+				constexpr double PI_2_HIGH = 1.5707963267948966;
+				constexpr double PI_2_LOW = 6.123233995736766e-17;
+
+				const __m256d quadrant = _mm256_round_pd(_mm256_mul_pd(angle, Set(2.0 / std::numbers::pi)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+				__m256d r = _mm256_fnmadd_pd(quadrant, Set(PI_2_HIGH), angle);
+				r = _mm256_fnmadd_pd(quadrant, Set(PI_2_LOW), r);
+				const __m256d r2 = _mm256_mul_pd(r, r);
+
+				/// sin r = r - r^3/3! + ... - r^19/19!, cos r = 1 - r^2/2! + ... + r^20/20!
+				__m256d s = Set(-1.0 / 121645100408832000.0);
+				s = _mm256_fmadd_pd(s, r2, Set(1.0 / 355687428096000.0));
+				s = _mm256_fmadd_pd(s, r2, Set(-1.0 / 1307674368000.0));
+				s = _mm256_fmadd_pd(s, r2, Set(1.0 / 6227020800.0));
+				s = _mm256_fmadd_pd(s, r2, Set(-1.0 / 39916800.0));
+				s = _mm256_fmadd_pd(s, r2, Set(1.0 / 362880.0));
+				s = _mm256_fmadd_pd(s, r2, Set(-1.0 / 5040.0));
+				s = _mm256_fmadd_pd(s, r2, Set(1.0 / 120.0));
+				s = _mm256_fmadd_pd(s, r2, Set(-1.0 / 6.0));
+				s = _mm256_fmadd_pd(_mm256_mul_pd(s, r2), r, r);
+
+				__m256d c = Set(1.0 / 2432902008176640000.0);
+				c = _mm256_fmadd_pd(c, r2, Set(-1.0 / 6402373705728000.0));
+				c = _mm256_fmadd_pd(c, r2, Set(1.0 / 20922789888000.0));
+				c = _mm256_fmadd_pd(c, r2, Set(-1.0 / 87178291200.0));
+				c = _mm256_fmadd_pd(c, r2, Set(1.0 / 479001600.0));
+				c = _mm256_fmadd_pd(c, r2, Set(-1.0 / 3628800.0));
+				c = _mm256_fmadd_pd(c, r2, Set(1.0 / 40320.0));
+				c = _mm256_fmadd_pd(c, r2, Set(-1.0 / 720.0));
+				c = _mm256_fmadd_pd(c, r2, Set(1.0 / 24.0));
+				c = _mm256_fmadd_pd(c, r2, Set(-0.5));
+				c = _mm256_fmadd_pd(c, r2, Set(1.0));
+
+				/// Quadrant 0..3: swap sine and cosine in odd quadrants, then fix the signs.
+				const __m256d q = _mm256_sub_pd(quadrant, _mm256_mul_pd(_mm256_floor_pd(_mm256_mul_pd(quadrant, Set(0.25))), Set(4.0)));
+				const __m256d odd = _mm256_or_pd(_mm256_cmp_pd(q, Set(1.0), _CMP_EQ_OQ), _mm256_cmp_pd(q, Set(3.0), _CMP_EQ_OQ));
+				const __m256d sineNegative = _mm256_cmp_pd(q, Set(1.5), _CMP_GT_OQ);
+				const __m256d cosineNegative = _mm256_and_pd(_mm256_cmp_pd(q, Set(0.5), _CMP_GT_OQ), _mm256_cmp_pd(q, Set(2.5), _CMP_LT_OQ));
+				sine = Negate(sineNegative, Select(odd, c, s));
+				cosine = Negate(cosineNegative, Select(odd, s, c));
+			}
+
+			/// atan2 over all quadrants. The ratio is folded into [0, tan(pi/8)] and halved once, where 13 series terms suffice.
+			SEDX_AVX2_TARGET inline __m256d Atan2(const __m256d y, const __m256d x)
+			{
+				const __m256d absY = _mm256_andnot_pd(Set(-0.0), y);
+				const __m256d absX = _mm256_andnot_pd(Set(-0.0), x);
+				const __m256d steep = _mm256_cmp_pd(absY, absX, _CMP_GT_OQ);
+				const __m256d low = _mm256_min_pd(absY, absX);
+				const __m256d high = _mm256_max_pd(absY, absX);
+				__m256d t = _mm256_div_pd(low, _mm256_max_pd(high, Set(1e-300)));
+
+				const __m256d folded = _mm256_cmp_pd(t, Set(0.41421356237309503), _CMP_GT_OQ);
+				t = Select(folded, _mm256_div_pd(_mm256_sub_pd(t, Set(1.0)), _mm256_add_pd(t, Set(1.0))), t);
+				const __m256d base = _mm256_and_pd(folded, Set(std::numbers::pi / 4.0));
+
+				/// atan t = 2 atan(t / (1 + sqrt(1 + t^2)))
+				t = _mm256_div_pd(t, _mm256_add_pd(Set(1.0), _mm256_sqrt_pd(_mm256_fmadd_pd(t, t, Set(1.0)))));
+				const __m256d t2 = _mm256_mul_pd(t, t);
+				__m256d series = Set(1.0 / 25.0);
+				for (int n = 11; n >= 1; --n)
+					series = _mm256_fmadd_pd(series, t2, Set((n % 2 ? -1.0 : 1.0) / (2.0 * n + 1.0)));
+				series = _mm256_fmadd_pd(_mm256_mul_pd(series, t2), t, t);
+				__m256d result = _mm256_fmadd_pd(series, Set(2.0), base);
+
+				result = Select(steep, _mm256_sub_pd(Set(std::numbers::pi / 2.0), result), result);
+				result = Select(_mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OQ), _mm256_sub_pd(Set(std::numbers::pi), result), result);
+				return _mm256_or_pd(result, _mm256_and_pd(y, Set(-0.0)));
+			}
+
+			SEDX_AVX2_TARGET inline void ToEcef(const __m256d latitude, const __m256d longitude, const __m256d altitude, __m256d &x, __m256d &y, __m256d &z)
+			{
+				__m256d sinPhi, cosPhi, sinLambda, cosLambda;
+				SinCos(_mm256_mul_pd(latitude, Set(RADIANS)), sinPhi, cosPhi);
+				SinCos(_mm256_mul_pd(longitude, Set(RADIANS)), sinLambda, cosLambda);
+
+				const __m256d n = _mm256_div_pd(Set(WGS84::A), _mm256_sqrt_pd(_mm256_fnmadd_pd(_mm256_mul_pd(Set(WGS84::E2), sinPhi), sinPhi, Set(1.0))));
+				const __m256d horizontal = _mm256_mul_pd(_mm256_add_pd(n, altitude), cosPhi);
+				x = _mm256_mul_pd(horizontal, cosLambda);
+				y = _mm256_mul_pd(horizontal, sinLambda);
+				z = _mm256_mul_pd(_mm256_fmadd_pd(n, Set(1.0 - WGS84::E2), altitude), sinPhi);
+			}
+
+			SEDX_AVX2_TARGET inline void ToGeodetic(const __m256d x, const __m256d y, const __m256d z, __m256d &latitude, __m256d &longitude, __m256d &altitude)
+			{
+				const __m256d p = _mm256_sqrt_pd(_mm256_fmadd_pd(x, x, _mm256_mul_pd(y, y)));
+				__m256d sinBeta = _mm256_mul_pd(z, Set(WGS84::A));
+				__m256d cosBeta = _mm256_mul_pd(p, Set(WGS84::B));
+				__m256d numerator = z;
+				__m256d denominator = p;
+				for (int i = 0; i < BOWRING_ITERATIONS; ++i)
+				{
+					const __m256d length = _mm256_sqrt_pd(_mm256_fmadd_pd(sinBeta, sinBeta, _mm256_mul_pd(cosBeta, cosBeta)));
+					sinBeta = _mm256_div_pd(sinBeta, length);
+					cosBeta = _mm256_div_pd(cosBeta, length);
+					numerator = _mm256_fmadd_pd(_mm256_mul_pd(_mm256_mul_pd(sinBeta, sinBeta), sinBeta), Set(WGS84::EP2 * WGS84::B), z);
+					denominator = _mm256_fnmadd_pd(_mm256_mul_pd(_mm256_mul_pd(cosBeta, cosBeta), cosBeta), Set(WGS84::E2 * WGS84::A), p);
+					sinBeta = _mm256_mul_pd(numerator, Set(1.0 - WGS84::F));
+					cosBeta = denominator;
+				}
+
+				const __m256d length = _mm256_sqrt_pd(_mm256_fmadd_pd(numerator, numerator, _mm256_mul_pd(denominator, denominator)));
+				const __m256d sinPhi = _mm256_div_pd(numerator, length);
+				const __m256d cosPhi = _mm256_div_pd(denominator, length);
+				const __m256d radius = _mm256_mul_pd(Set(WGS84::A), _mm256_sqrt_pd(_mm256_fnmadd_pd(_mm256_mul_pd(Set(WGS84::E2), sinPhi), sinPhi, Set(1.0))));
+				altitude = _mm256_sub_pd(_mm256_fmadd_pd(p, cosPhi, _mm256_mul_pd(z, sinPhi)), radius);
+				latitude = _mm256_mul_pd(Atan2(numerator, denominator), Set(DEGREES));
+				longitude = _mm256_mul_pd(Atan2(y, x), Set(DEGREES));
+			}
+
+			/// Frame axes and origin broadcast once per batch.
+			struct Frame
+			{
+				__m256d origin[3];
+				__m256d east[3];
+				__m256d north[3];
+				__m256d up[3];
+			};
+
+			SEDX_AVX2_TARGET inline void Broadcast(__m256d (&out)[3], const DVec3 &value)
+			{
+				out[0] = Set(value.x);
+				out[1] = Set(value.y);
+				out[2] = Set(value.z);
+			}
+
+			SEDX_AVX2_TARGET inline Frame LoadFrame(const LocalTangentPlane &plane)
+			{
+				Frame frame;
+				Broadcast(frame.origin, plane.GetOriginEcef());
+				Broadcast(frame.east, plane.GetEast());
+				Broadcast(frame.north, plane.GetNorth());
+				Broadcast(frame.up, plane.GetUp());
+				return frame;
+			}
+
+			SEDX_AVX2_TARGET inline __m256d Dot(const __m256d (&axis)[3], const __m256d dx, const __m256d dy, const __m256d dz)
+			{
+				return _mm256_fmadd_pd(axis[0], dx, _mm256_fmadd_pd(axis[1], dy, _mm256_mul_pd(axis[2], dz)));
+			}
+
+			SEDX_AVX2_TARGET inline void ToEnu(const Frame &frame, const __m256d x, const __m256d y, const __m256d z, __m256d &east, __m256d &north, __m256d &up)
+			{
+				const __m256d dx = _mm256_sub_pd(x, frame.origin[0]);
+				const __m256d dy = _mm256_sub_pd(y, frame.origin[1]);
+				const __m256d dz = _mm256_sub_pd(z, frame.origin[2]);
+				east = Dot(frame.east, dx, dy, dz);
+				north = Dot(frame.north, dx, dy, dz);
+				up = Dot(frame.up, dx, dy, dz);
+			}
+
+			SEDX_AVX2_TARGET inline void FromEnu(const Frame &frame, const __m256d east, const __m256d north, const __m256d up, __m256d (&ecef)[3])
+			{
+				for (int axis = 0; axis < 3; ++axis)
+					ecef[axis] = _mm256_fmadd_pd(frame.east[axis], east, _mm256_fmadd_pd(frame.north[axis], north, _mm256_fmadd_pd(frame.up[axis], up, frame.origin[axis])));
+			}
+
+			/// -----------------------------------------------------
+
+			SEDX_AVX2_TARGET size_t GeodeticToEcef(const double *latitude, const double *longitude, const double *altitude, double *x, double *y, double *z, const size_t count)
+			{
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					__m256d vx, vy, vz;
+					ToEcef(_mm256_loadu_pd(latitude + i), _mm256_loadu_pd(longitude + i), _mm256_loadu_pd(altitude + i), vx, vy, vz);
+					_mm256_storeu_pd(x + i, vx);
+					_mm256_storeu_pd(y + i, vy);
+					_mm256_storeu_pd(z + i, vz);
+				}
+				return i;
+			}
+
+			SEDX_AVX2_TARGET size_t EcefToGeodetic(const double *x, const double *y, const double *z, double *latitude, double *longitude, double *altitude, const size_t count)
+			{
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					__m256d lat, lon, alt;
+					ToGeodetic(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), _mm256_loadu_pd(z + i), lat, lon, alt);
+					_mm256_storeu_pd(latitude + i, lat);
+					_mm256_storeu_pd(longitude + i, lon);
+					_mm256_storeu_pd(altitude + i, alt);
+				}
+				return i;
+			}
+
+			SEDX_AVX2_TARGET size_t GeodeticToEnu(const LocalTangentPlane &plane, const double *latitude, const double *longitude, const double *altitude, double *east,
+			                                      double *north, double *up, const size_t count, const bool project)
+			{
+				const Frame frame = LoadFrame(plane);
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					/// Projection drops the point to the ellipsoid and carries its altitude through as the height.
+					const __m256d alt = _mm256_loadu_pd(altitude + i);
+					__m256d x, y, z, e, n, u;
+					ToEcef(_mm256_loadu_pd(latitude + i), _mm256_loadu_pd(longitude + i), project ? _mm256_setzero_pd() : alt, x, y, z);
+					ToEnu(frame, x, y, z, e, n, u);
+					_mm256_storeu_pd(east + i, e);
+					_mm256_storeu_pd(north + i, n);
+					_mm256_storeu_pd(up + i, project ? alt : u);
+				}
+				return i;
+			}
+
+			SEDX_AVX2_TARGET size_t EnuToGeodetic(const LocalTangentPlane &plane, const double *east, const double *north, const double *up, double *latitude,
+			                                      double *longitude, double *altitude, const size_t count)
+			{
+				const Frame frame = LoadFrame(plane);
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					__m256d ecef[3], lat, lon, alt;
+					FromEnu(frame, _mm256_loadu_pd(east + i), _mm256_loadu_pd(north + i), _mm256_loadu_pd(up + i), ecef);
+					ToGeodetic(ecef[0], ecef[1], ecef[2], lat, lon, alt);
+					_mm256_storeu_pd(latitude + i, lat);
+					_mm256_storeu_pd(longitude + i, lon);
+					_mm256_storeu_pd(altitude + i, alt);
+				}
+				return i;
+			}
+
+			SEDX_AVX2_TARGET size_t Unproject(const LocalTangentPlane &plane, const double *east, const double *north, const double *height, double *latitude,
+			                                  double *longitude, double *altitude, const size_t count)
+			{
+				const Frame frame = LoadFrame(plane);
+
+				/// The ray direction is the frame's up axis for every point, so only the start varies.
+				const DVec3 &upAxis = plane.GetUp();
+				const __m256d scale[3] = {Set(1.0 / WGS84::A), Set(1.0 / WGS84::A), Set(1.0 / WGS84::B)};
+				const __m256d d[3] = {Set(upAxis.x / WGS84::A), Set(upAxis.y / WGS84::A), Set(upAxis.z / WGS84::B)};
+				const __m256d a = _mm256_fmadd_pd(d[0], d[0], _mm256_fmadd_pd(d[1], d[1], _mm256_mul_pd(d[2], d[2])));
+
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m256d h = _mm256_loadu_pd(height + i);
+					__m256d point[3], lat, lon, alt;
+					FromEnu(frame, _mm256_loadu_pd(east + i), _mm256_loadu_pd(north + i), _mm256_setzero_pd(), point);
+					const __m256d px = _mm256_mul_pd(point[0], scale[0]);
+					const __m256d py = _mm256_mul_pd(point[1], scale[1]);
+					const __m256d pz = _mm256_mul_pd(point[2], scale[2]);
+					const __m256d b = _mm256_fmadd_pd(px, d[0], _mm256_fmadd_pd(py, d[1], _mm256_mul_pd(pz, d[2])));
+					const __m256d c = _mm256_sub_pd(_mm256_fmadd_pd(px, px, _mm256_fmadd_pd(py, py, _mm256_mul_pd(pz, pz))), Set(1.0));
+					const __m256d root = _mm256_sqrt_pd(_mm256_fmsub_pd(b, b, _mm256_mul_pd(a, c)));
+					const __m256d q = _mm256_add_pd(b, _mm256_or_pd(root, _mm256_and_pd(b, Set(-0.0))));
+					const __m256d t = _mm256_div_pd(_mm256_xor_pd(c, Set(-0.0)), q);
+
+					for (int axis = 0; axis < 3; ++axis)
+						point[axis] = _mm256_fmadd_pd(frame.up[axis], t, point[axis]);
+					ToGeodetic(point[0], point[1], point[2], lat, lon, alt);
+					_mm256_storeu_pd(latitude + i, lat);
+					_mm256_storeu_pd(longitude + i, lon);
+					_mm256_storeu_pd(altitude + i, h);
+				}
+				return i;
+			}
+		}
+	#endif
+
+		bool UseAvx2()
+		{
+		#if SEDX_X_AVX2
+			static const bool available = DetectAvx2();
+			return available;
+		#else
+			return false;
+		#endif
+		}
+	}
+
+	/// -----------------------------------------------------
+
+	DVec3 GeodeticToEcef(const GeoPosition &position)
+	{
+		return ToEcef(position.latitude, position.longitude, position.altitude);
+	}
+
+	GeoPosition EcefToGeodetic(const DVec3 &ecef)
+	{
+		return ToGeodetic(ecef.x, ecef.y, ecef.z);
+	}
+
+	void GeodeticToEcef(const double *latitude, const double *longitude, const double *altitude, double *x, double *y, double *z, const size_t count)
+	{
+		size_t i = 0;
+	#if SEDX_X_AVX2
+		if (UseAvx2())
+			i = Avx2::GeodeticToEcef(latitude, longitude, altitude, x, y, z, count);
+	#endif
+		for (; i < count; ++i)
+		{
+			const DVec3 ecef = ToEcef(latitude[i], longitude[i], altitude[i]);
+			x[i] = ecef.x;
+			y[i] = ecef.y;
+			z[i] = ecef.z;
+		}
+	}
+
+	void EcefToGeodetic(const double *x, const double *y, const double *z, double *latitude, double *longitude, double *altitude, const size_t count)
+	{
+		size_t i = 0;
+	#if SEDX_X_AVX2
+		if (UseAvx2())
+			i = Avx2::EcefToGeodetic(x, y, z, latitude, longitude, altitude, count);
+	#endif
+		for (; i < count; ++i)
+		{
+			const GeoPosition position = ToGeodetic(x[i], y[i], z[i]);
+			latitude[i] = position.latitude;
+			longitude[i] = position.longitude;
+			altitude[i] = position.altitude;
+		}
+	}
+
+	bool IsGeodesyVectorized()
+	{
+		return UseAvx2();
+	}
+
+	/// -----------------------------------------------------
+
+	GeodesicLine GeodesicInverse(const GeoPosition &from, const GeoPosition &to)
+	{
+		constexpr double f = WGS84::F;
+		constexpr double a = WGS84::A;
+		constexpr double b = WGS84::B;
+
+		/// Reduced latitudes and the difference in longitude.
+		const double tanU1 = (1.0 - f) * std::tan(from.latitude * RADIANS);
+		const double tanU2 = (1.0 - f) * std::tan(to.latitude * RADIANS);
+		const double cosU1 = 1.0 / std::sqrt(1.0 + tanU1 * tanU1);
+		const double cosU2 = 1.0 / std::sqrt(1.0 + tanU2 * tanU2);
+		const double sinU1 = tanU1 * cosU1;
+		const double sinU2 = tanU2 * cosU2;
+		const double l = (to.longitude - from.longitude) * RADIANS;
+
+		GeodesicLine line;
+		line.converged = false;
+		double lambda = l;
+		double sinLambda = 0.0, cosLambda = 1.0;
+		double sinSigma = 0.0, cosSigma = 1.0, sigma = 0.0;
+		double sinAlpha = 0.0, cosSqAlpha = 1.0, cos2SigmaM = 0.0;
+		for (int iteration = 0; iteration < 200; ++iteration)
+		{
+			sinLambda = std::sin(lambda);
+			cosLambda = std::cos(lambda);
+			const double crossTerm = cosU1 * sinU2 - sinU1 * cosU2 * cosLambda;
+			sinSigma = std::sqrt((cosU2 * sinLambda) * (cosU2 * sinLambda) + crossTerm * crossTerm);
+			if (sinSigma == 0.0)
+			{
+				/// Coincident points.
+				line.converged = true;
+				return line;
+			}
+			cosSigma = sinU1 * sinU2 + cosU1 * cosU2 * cosLambda;
+			sigma = std::atan2(sinSigma, cosSigma);
+			sinAlpha = cosU1 * cosU2 * sinLambda / sinSigma;
+			cosSqAlpha = 1.0 - sinAlpha * sinAlpha;
+
+			/// Both points on the equator: the geodesic follows it.
+			cos2SigmaM = cosSqAlpha != 0.0 ? cosSigma - 2.0 * sinU1 * sinU2 / cosSqAlpha : 0.0;
+			const double c = f / 16.0 * cosSqAlpha * (4.0 + f * (4.0 - 3.0 * cosSqAlpha));
+			const double previous = lambda;
+			lambda = l + (1.0 - c) * f * sinAlpha * (sigma + c * sinSigma * (cos2SigmaM + c * cosSigma * (-1.0 + 2.0 * cos2SigmaM * cos2SigmaM)));
+			if (std::abs(lambda - previous) < 1e-12)
+			{
+				line.converged = true;
+				break;
+			}
+		}
+
+		const double uSq = cosSqAlpha * (a * a - b * b) / (b * b);
+		const double bigA = 1.0 + uSq / 16384.0 * (4096.0 + uSq * (-768.0 + uSq * (320.0 - 175.0 * uSq)));
+		const double bigB = uSq / 1024.0 * (256.0 + uSq * (-128.0 + uSq * (74.0 - 47.0 * uSq)));
+		const double deltaSigma = bigB * sinSigma *
+		                          (cos2SigmaM + bigB / 4.0 *
+		                                            (cosSigma * (-1.0 + 2.0 * cos2SigmaM * cos2SigmaM) -
+		                                             bigB / 6.0 * cos2SigmaM * (-3.0 + 4.0 * sinSigma * sinSigma) * (-3.0 + 4.0 * cos2SigmaM * cos2SigmaM)));
+
+		line.distance = b * bigA * (sigma - deltaSigma);
+		line.initialBearing = NormalizeBearing(std::atan2(cosU2 * sinLambda, cosU1 * sinU2 - sinU1 * cosU2 * cosLambda) * DEGREES);
+		line.finalBearing = NormalizeBearing(std::atan2(cosU1 * sinLambda, -sinU1 * cosU2 + cosU1 * sinU2 * cosLambda) * DEGREES);
+		return line;
+	}
+
+	GeoPosition GeodesicDirect(const GeoPosition &from, const double bearing, const double distance, double *finalBearing)
+	{
+		constexpr double f = WGS84::F;
+		constexpr double a = WGS84::A;
+		constexpr double b = WGS84::B;
+
+		const double alpha1 = bearing * RADIANS;
+		const double sinAlpha1 = std::sin(alpha1);
+		const double cosAlpha1 = std::cos(alpha1);
+		const double tanU1 = (1.0 - f) * std::tan(from.latitude * RADIANS);
+		const double cosU1 = 1.0 / std::sqrt(1.0 + tanU1 * tanU1);
+		const double sinU1 = tanU1 * cosU1;
+
+		/// Angular distance on the auxiliary sphere from the equator to the start, and the azimuth at the equator.
+		const double sigma1 = std::atan2(tanU1, cosAlpha1);
+		const double sinAlpha = cosU1 * sinAlpha1;
+		const double cosSqAlpha = 1.0 - sinAlpha * sinAlpha;
+		const double uSq = cosSqAlpha * (a * a - b * b) / (b * b);
+		const double bigA = 1.0 + uSq / 16384.0 * (4096.0 + uSq * (-768.0 + uSq * (320.0 - 175.0 * uSq)));
+		const double bigB = uSq / 1024.0 * (256.0 + uSq * (-128.0 + uSq * (74.0 - 47.0 * uSq)));
+
+		double sigma = distance / (b * bigA);
+		double sinSigma = 0.0, cosSigma = 1.0, cos2SigmaM = 0.0;
+		for (int iteration = 0; iteration < 200; ++iteration)
+		{
+			cos2SigmaM = std::cos(2.0 * sigma1 + sigma);
+			sinSigma = std::sin(sigma);
+			cosSigma = std::cos(sigma);
+			const double deltaSigma = bigB * sinSigma *
+			                          (cos2SigmaM + bigB / 4.0 *
+			                                            (cosSigma * (-1.0 + 2.0 * cos2SigmaM * cos2SigmaM) -
+			                                             bigB / 6.0 * cos2SigmaM * (-3.0 + 4.0 * sinSigma * sinSigma) * (-3.0 + 4.0 * cos2SigmaM * cos2SigmaM)));
+			const double previous = sigma;
+			sigma = distance / (b * bigA) + deltaSigma;
+			if (std::abs(sigma - previous) < 1e-12)
+				break;
+		}
+		sinSigma = std::sin(sigma);
+		cosSigma = std::cos(sigma);
+		cos2SigmaM = std::cos(2.0 * sigma1 + sigma);
+
+		const double x = sinU1 * sinSigma - cosU1 * cosSigma * cosAlpha1;
+		const double latitude = std::atan2(sinU1 * cosSigma + cosU1 * sinSigma * cosAlpha1, (1.0 - f) * std::sqrt(sinAlpha * sinAlpha + x * x));
+		const double lambda = std::atan2(sinSigma * sinAlpha1, cosU1 * cosSigma - sinU1 * sinSigma * cosAlpha1);
+		const double c = f / 16.0 * cosSqAlpha * (4.0 + f * (4.0 - 3.0 * cosSqAlpha));
+		const double l = lambda - (1.0 - c) * f * sinAlpha * (sigma + c * sinSigma * (cos2SigmaM + c * cosSigma * (-1.0 + 2.0 * cos2SigmaM * cos2SigmaM)));
+
+		if (finalBearing)
+			*finalBearing = NormalizeBearing(std::atan2(sinAlpha, -x) * DEGREES);
+		return {latitude * DEGREES, NormalizeLongitude(from.longitude + l * DEGREES), from.altitude};
+	}
+
+	/// -----------------------------------------------------
+
+	LocalTangentPlane::LocalTangentPlane(const GeoPosition &origin) : m_Origin(origin), m_OriginEcef(GeodeticToEcef(origin))
+	{
+		const double phi = origin.latitude * RADIANS;
+		const double lambda = origin.longitude * RADIANS;
+		const double sinPhi = std::sin(phi);
+		const double cosPhi = std::cos(phi);
+		const double sinLambda = std::sin(lambda);
+		const double cosLambda = std::cos(lambda);
+		m_East = DVec3(-sinLambda, cosLambda, 0.0);
+		m_North = DVec3(-sinPhi * cosLambda, -sinPhi * sinLambda, cosPhi);
+		m_Up = DVec3(cosPhi * cosLambda, cosPhi * sinLambda, sinPhi);
+	}
+
+	DVec3 LocalTangentPlane::EcefToEnu(const DVec3 &ecef) const
+	{
+		const DVec3 d = ecef - m_OriginEcef;
+		return {m_East.x * d.x + m_East.y * d.y + m_East.z * d.z, m_North.x * d.x + m_North.y * d.y + m_North.z * d.z, m_Up.x * d.x + m_Up.y * d.y + m_Up.z * d.z};
+	}
+
+	DVec3 LocalTangentPlane::EnuToEcef(const DVec3 &enu) const
+	{
+		return m_OriginEcef + m_East * enu.x + m_North * enu.y + m_Up * enu.z;
+	}
+
+	DVec3 LocalTangentPlane::GeodeticToEnu(const GeoPosition &position) const
+	{
+		return EcefToEnu(GeodeticToEcef(position));
+	}
+
+	GeoPosition LocalTangentPlane::EnuToGeodetic(const DVec3 &enu) const
+	{
+		return EcefToGeodetic(EnuToEcef(enu));
+	}
+
+	DVec3 LocalTangentPlane::Project(const GeoPosition &position) const
+	{
+		const DVec3 enu = EcefToEnu(ToEcef(position.latitude, position.longitude, 0.0));
+		return {enu.x, enu.y, position.altitude};
+	}
+
+	GeoPosition LocalTangentPlane::Unproject(const DVec3 &local) const
+	{
+		const DVec3 point = EnuToEcef(DVec3(local.x, local.y, 0.0));
+		GeoPosition position = EcefToGeodetic(point + m_Up * DistanceToEllipsoid(point, m_Up));
+		position.altitude = local.z;
+		return position;
+	}
+
+	void LocalTangentPlane::GeodeticToEnu(const double *latitude, const double *longitude, const double *altitude, double *east, double *north, double *up, const size_t count) const
+	{
+		size_t i = 0;
+	#if SEDX_X_AVX2
+		if (UseAvx2())
+			i = Avx2::GeodeticToEnu(*this, latitude, longitude, altitude, east, north, up, count, false);
+	#endif
+		for (; i < count; ++i)
+		{
+			const DVec3 enu = EcefToEnu(ToEcef(latitude[i], longitude[i], altitude[i]));
+			east[i] = enu.x;
+			north[i] = enu.y;
+			up[i] = enu.z;
+		}
+	}
+
+	void LocalTangentPlane::EnuToGeodetic(const double *east, const double *north, const double *up, double *latitude, double *longitude, double *altitude, const size_t count) const
+	{
+		size_t i = 0;
+	#if SEDX_X_AVX2
+		if (UseAvx2())
+			i = Avx2::EnuToGeodetic(*this, east, north, up, latitude, longitude, altitude, count);
+	#endif
+		for (; i < count; ++i)
+		{
+			const GeoPosition position = EnuToGeodetic(DVec3(east[i], north[i], up[i]));
+			latitude[i] = position.latitude;
+			longitude[i] = position.longitude;
+			altitude[i] = position.altitude;
+		}
+	}
+
+	void LocalTangentPlane::Project(const double *latitude, const double *longitude, const double *altitude, double *east, double *north, double *height, const size_t count) const
+	{
+		size_t i = 0;
+	#if SEDX_X_AVX2
+		if (UseAvx2())
+			i = Avx2::GeodeticToEnu(*this, latitude, longitude, altitude, east, north, height, count, true);
+	#endif
+		for (; i < count; ++i)
+		{
+			const DVec3 local = Project(GeoPosition{latitude[i], longitude[i], altitude[i]});
+			east[i] = local.x;
+			north[i] = local.y;
+			height[i] = local.z;
+		}
+	}
+
+	void LocalTangentPlane::Unproject(const double *east, const double *north, const double *height, double *latitude, double *longitude, double *altitude, const size_t count) const
+	{
+		size_t i = 0;
+	#if SEDX_X_AVX2
+		if (UseAvx2())
+			i = Avx2::Unproject(*this, east, north, height, latitude, longitude, altitude, count);
+	#endif
+		for (; i < count; ++i)
+		{
+			const GeoPosition position = Unproject(DVec3(east[i], north[i], height[i]));
+			latitude[i] = position.latitude;
+			longitude[i] = position.longitude;
+			altitude[i] = position.altitude;
+		}
+	}
+
+}
+
+/// -----------------------------------------------------
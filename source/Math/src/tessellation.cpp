@@ -0,0 +1,884 @@
+﻿/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* tessellation.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include <Math/includes/tessellation.h>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+/// -----------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		/// Squared distance from @p p to the segment a-b.
+		double DistanceToSegmentSq(const DVec2 &p, const DVec2 &a, const DVec2 &b)
+		{
+			const DVec2 ab = b - a;
+			const DVec2 ap = p - a;
+			const double length = ab.Length2();
+			double t = length > 0.0 ? (ap.x * ab.x + ap.y * ab.y) / length : 0.0;
+			t = std::clamp(t, 0.0, 1.0);
+			const DVec2 d = ap - ab * t;
+			return d.Length2();
+		}
+
+		/// Appends the points after p0 of a cubic, ending with p3.
+		void FlattenCubic(const DVec2 &p0, const DVec2 &p1, const DVec2 &p2, const DVec2 &p3, const double toleranceSq, const uint32_t depth,
+		                  std::vector<DVec2> &out)
+		{
+			if (depth == 0 || (DistanceToSegmentSq(p1, p0, p3) <= toleranceSq && DistanceToSegmentSq(p2, p0, p3) <= toleranceSq))
+			{
+				out.push_back(p3);
+				return;
+			}
+
+			const DVec2 p01 = (p0 + p1) * 0.5;
+			const DVec2 p12 = (p1 + p2) * 0.5;
+			const DVec2 p23 = (p2 + p3) * 0.5;
+			const DVec2 p012 = (p01 + p12) * 0.5;
+			const DVec2 p123 = (p12 + p23) * 0.5;
+			const DVec2 mid = (p012 + p123) * 0.5;
+			FlattenCubic(p0, p01, p012, mid, toleranceSq, depth - 1, out);
+			FlattenCubic(mid, p123, p23, p3, toleranceSq, depth - 1, out);
+		}
+
+		/// Flattens the edge from @p from to @p to, without the end point.
+		void FlattenEdgePoints(const TessNode &from, const TessNode &to, const TessOptions &options, std::vector<DVec2> &out)
+		{
+			out.push_back(from.position);
+			if (!from.bezier && !to.bezier)
+				return;
+
+			const DVec2 p1 = from.bezier ? from.control : from.position;
+			const DVec2 p2 = to.bezier ? to.position * 2.0 - to.control : to.position;
+			const double tolerance = std::max(options.GetTolerance(), 1e-12);
+			FlattenCubic(from.position, p1, p2, to.position, tolerance * tolerance, options.maxDepth, out);
+			out.pop_back();
+		}
+
+		/// -----------------------------------------------------
+
+		struct EarNode
+		{
+			uint32_t i = 0;
+			double x = 0.0;
+			double y = 0.0;
+			EarNode *prev = nullptr;
+			EarNode *next = nullptr;
+			uint32_t z = 0;
+			EarNode *prevZ = nullptr;
+			EarNode *nextZ = nullptr;
+			bool steiner = false;
+		};
+
+		/// Twice the negated signed area of a-b-c: negative when the corner turns left.
+		double Area(const EarNode *p, const EarNode *q, const EarNode *r)
+		{
+			return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+		}
+
+		bool Equals(const EarNode *a, const EarNode *b)
+		{
+			return a->x == b->x && a->y == b->y;
+		}
+
+		bool PointInTriangle(const double ax, const double ay, const double bx, const double by, const double cx, const double cy, const double px,
+		                     const double py)
+		{
+			return (cx - px) * (ay - py) >= (ax - px) * (cy - py) && (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+			       (bx - px) * (cy - py) >= (cx - px) * (by - py);
+		}
+
+		/// As PointInTriangle(), but a point on top of the first corner is outside: bridged holes duplicate vertices.
+		bool PointInTriangleExceptFirst(const double ax, const double ay, const double bx, const double by, const double cx, const double cy,
+		                                const double px, const double py)
+		{
+			return !(ax == px && ay == py) && PointInTriangle(ax, ay, bx, by, cx, cy, px, py);
+		}
+
+		int Sign(const double value)
+		{
+			return value > 0.0 ? 1 : value < 0.0 ? -1 : 0;
+		}
+
+		bool OnSegment(const EarNode *p, const EarNode *q, const EarNode *r)
+		{
+			return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x) && q->y <= std::max(p->y, r->y) && q->y >= std::min(p->y, r->y);
+		}
+
+		bool Intersects(const EarNode *p1, const EarNode *q1, const EarNode *p2, const EarNode *q2)
+		{
+			const int o1 = Sign(Area(p1, q1, p2));
+			const int o2 = Sign(Area(p1, q1, q2));
+			const int o3 = Sign(Area(p2, q2, p1));
+			const int o4 = Sign(Area(p2, q2, q1));
+			if (o1 != o2 && o3 != o4)
+				return true;
+			return (o1 == 0 && OnSegment(p1, p2, q1)) || (o2 == 0 && OnSegment(p1, q2, q1)) || (o3 == 0 && OnSegment(p2, p1, q2)) ||
+			       (o4 == 0 && OnSegment(p2, q1, q2));
+		}
+
+		bool IntersectsPolygon(const EarNode *a, const EarNode *b)
+		{
+			const EarNode *p = a;
+			do
+			{
+				if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i && Intersects(p, p->next, a, b))
+					return true;
+				p = p->next;
+			}
+			while (p != a);
+			return false;
+		}
+
+		/// Whether the diagonal a-b starts into the interior of the polygon at a.
+		bool LocallyInside(const EarNode *a, const EarNode *b)
+		{
+			return Area(a->prev, a, a->next) < 0.0 ? Area(a, b, a->next) >= 0.0 && Area(a, a->prev, b) >= 0.0
+			                                       : Area(a, b, a->prev) < 0.0 || Area(a, a->next, b) < 0.0;
+		}
+
+		bool MiddleInside(const EarNode *a, const EarNode *b)
+		{
+			const EarNode *p = a;
+			bool inside = false;
+			const double px = (a->x + b->x) / 2.0;
+			const double py = (a->y + b->y) / 2.0;
+			do
+			{
+				if ((p->y > py) != (p->next->y > py) && p->next->y != p->y && px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x)
+					inside = !inside;
+				p = p->next;
+			}
+			while (p != a);
+			return inside;
+		}
+
+		bool IsValidDiagonal(const EarNode *a, const EarNode *b)
+		{
+			return a->next->i != b->i && a->prev->i != b->i && !IntersectsPolygon(a, b) &&
+			       ((LocallyInside(a, b) && LocallyInside(b, a) && MiddleInside(a, b) && (Area(a->prev, a, b->prev) != 0.0 || Area(a, b->prev, b) != 0.0)) ||
+			        (Equals(a, b) && Area(a->prev, a, a->next) > 0.0 && Area(b->prev, b, b->next) > 0.0));
+		}
+
+		bool SectorContainsSector(const EarNode *m, const EarNode *p)
+		{
+			return Area(m->prev, m, p->prev) < 0.0 && Area(p->next, m, m->next) < 0.0;
+		}
+
+		/// 2D Morton code of a point scaled into [0, 32767].
+		uint32_t ZOrder(const double x, const double y, const double minX, const double minY, const double invSize)
+		{
+			auto spread = [](uint32_t v) {
+				v = (v | (v << 8)) & 0x00FF00FF;
+				v = (v | (v << 4)) & 0x0F0F0F0F;
+				v = (v | (v << 2)) & 0x33333333;
+				v = (v | (v << 1)) & 0x55555555;
+				return v;
+			};
+			return spread(static_cast<uint32_t>((x - minX) * invSize)) | (spread(static_cast<uint32_t>((y - minY) * invSize)) << 1);
+		}
+
+		/// -----------------------------------------------------
+
+		class EarClipper
+		{
+		public:
+			EarClipper(const std::vector<DVec2> &vertices, std::vector<uint32_t> &indices) : m_Vertices(vertices), m_Indices(indices) {}
+
+			void Run(const std::vector<uint32_t> &ringStarts)
+			{
+				const auto count = static_cast<uint32_t>(m_Vertices.size());
+				const uint32_t outerEnd = ringStarts.size() > 1 ? std::min(ringStarts[1], count) : count;
+				const uint32_t outerStart = ringStarts.empty() ? 0 : std::min(ringStarts[0], outerEnd);
+
+				EarNode *outer = LinkedList(outerStart, outerEnd, true);
+				if (!outer || outer->next == outer->prev)
+					return;
+
+				if (ringStarts.size() > 1)
+					outer = EliminateHoles(ringStarts, outer);
+
+				/// Small polygons are clipped faster without the z-order hash.
+				if (count > 80)
+				{
+					double minX = HUGE_VAL, minY = HUGE_VAL, maxX = -HUGE_VAL, maxY = -HUGE_VAL;
+					for (uint32_t i = outerStart; i < outerEnd; ++i)
+					{
+						const DVec2 &v = m_Vertices[i];
+						if (!std::isfinite(v.x) || !std::isfinite(v.y))
+							continue;
+						minX = std::min(minX, v.x);
+						minY = std::min(minY, v.y);
+						maxX = std::max(maxX, v.x);
+						maxY = std::max(maxY, v.y);
+					}
+					const double size = std::max(maxX - minX, maxY - minY);
+					m_MinX = minX;
+					m_MinY = minY;
+					m_InvSize = size > 0.0 ? 32767.0 / size : 0.0;
+				}
+
+				EarcutLinked(outer, 0);
+			}
+
+		private:
+			EarNode *InsertNode(const uint32_t i, const double x, const double y, EarNode *last)
+			{
+				EarNode &p = m_Nodes.emplace_back();
+				p.i = i;
+				p.x = x;
+				p.y = y;
+				if (!last)
+				{
+					p.prev = &p;
+					p.next = &p;
+				}
+				else
+				{
+					p.next = last->next;
+					p.prev = last;
+					last->next->prev = &p;
+					last->next = &p;
+				}
+				return &p;
+			}
+
+			static void RemoveNode(EarNode *p)
+			{
+				p->next->prev = p->prev;
+				p->prev->next = p->next;
+				if (p->prevZ)
+					p->prevZ->nextZ = p->nextZ;
+				if (p->nextZ)
+					p->nextZ->prevZ = p->prevZ;
+			}
+
+			/// Links the ring [start, end) counter-clockwise for the outer ring and clockwise for holes. Non-finite points are dropped.
+			EarNode *LinkedList(const uint32_t start, const uint32_t end, const bool outer)
+			{
+				if (end <= start)
+					return nullptr;
+
+				const auto finite = [this](const uint32_t i) { return std::isfinite(m_Vertices[i].x) && std::isfinite(m_Vertices[i].y); };
+
+				double area = 0.0;
+				uint32_t j = end;
+				for (uint32_t i = end; i-- > start;)
+				{
+					if (finite(i))
+					{
+						j = i;
+						break;
+					}
+				}
+				for (uint32_t i = start; i < end && j != end; ++i)
+				{
+					if (!finite(i))
+						continue;
+					area += (m_Vertices[j].x - m_Vertices[i].x) * (m_Vertices[i].y + m_Vertices[j].y);
+					j = i;
+				}
+
+				EarNode *last = nullptr;
+				const auto add = [&](const uint32_t i) {
+					if (finite(i))
+						last = InsertNode(i, m_Vertices[i].x, m_Vertices[i].y, last);
+				};
+				if (outer == (area > 0.0))
+				{
+					for (uint32_t i = start; i < end; ++i)
+						add(i);
+				}
+				else
+				{
+					for (uint32_t i = end; i-- > start;)
+						add(i);
+				}
+
+				if (last && Equals(last, last->next))
+				{
+					EarNode *next = last->next;
+					RemoveNode(last);
+					last = last == next ? nullptr : next;
+				}
+				return last;
+			}
+
+			/// Removes duplicate and collinear points between start and end.
+			static EarNode *FilterPoints(EarNode *start, EarNode *end = nullptr)
+			{
+				if (!start)
+					return start;
+				if (!end)
+					end = start;
+
+				EarNode *p = start;
+				bool again;
+				do
+				{
+					again = false;
+					if (!p->steiner && (Equals(p, p->next) || Area(p->prev, p, p->next) == 0.0))
+					{
+						RemoveNode(p);
+						p = end = p->prev;
+						if (p == p->next)
+							break;
+						again = true;
+					}
+					else
+					{
+						p = p->next;
+					}
+				}
+				while (again || p != end);
+				return end;
+			}
+
+			void EmitTriangle(const EarNode *a, const EarNode *b, const EarNode *c)
+			{
+				m_Indices.push_back(a->i);
+				m_Indices.push_back(b->i);
+				m_Indices.push_back(c->i);
+			}
+
+			void EarcutLinked(EarNode *ear, const int pass)
+			{
+				if (!ear)
+					return;
+				if (pass == 0 && m_InvSize != 0.0)
+					IndexCurve(ear);
+
+				EarNode *stop = ear;
+				while (ear->prev != ear->next)
+				{
+					EarNode *prev = ear->prev;
+					EarNode *next = ear->next;
+					if (m_InvSize != 0.0 ? IsEarHashed(ear) : IsEar(ear))
+					{
+						EmitTriangle(prev, ear, next);
+						RemoveNode(ear);
+						ear = next->next;
+						stop = next->next;
+						continue;
+					}
+
+					ear = next;
+					if (ear == stop)
+					{
+						/// No ear left: drop degenerate points, then untangle local self intersections, then split.
+						if (pass == 0)
+						{
+							EarcutLinked(FilterPoints(ear), 1);
+						}
+						else if (pass == 1)
+						{
+							ear = CureLocalIntersections(FilterPoints(ear));
+							EarcutLinked(ear, 2);
+						}
+						else
+						{
+							SplitEarcut(ear);
+						}
+						break;
+					}
+				}
+			}
+
+			static bool IsEar(const EarNode *ear)
+			{
+				const EarNode *a = ear->prev;
+				const EarNode *b = ear;
+				const EarNode *c = ear->next;
+				if (Area(a, b, c) >= 0.0)
+					return false;
+
+				const double x0 = std::min({ a->x, b->x, c->x });
+				const double y0 = std::min({ a->y, b->y, c->y });
+				const double x1 = std::max({ a->x, b->x, c->x });
+				const double y1 = std::max({ a->y, b->y, c->y });
+				for (const EarNode *p = c->next; p != a; p = p->next)
+				{
+					if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 &&
+						PointInTriangleExceptFirst(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && Area(p->prev, p, p->next) >= 0.0)
+						return false;
+				}
+				return true;
+			}
+
+			bool IsEarHashed(const EarNode *ear) const
+			{
+				const EarNode *a = ear->prev;
+				const EarNode *b = ear;
+				const EarNode *c = ear->next;
+				if (Area(a, b, c) >= 0.0)
+					return false;
+
+				const double x0 = std::min({ a->x, b->x, c->x });
+				const double y0 = std::min({ a->y, b->y, c->y });
+				const double x1 = std::max({ a->x, b->x, c->x });
+				const double y1 = std::max({ a->y, b->y, c->y });
+				const uint32_t minZ = ZOrder(x0, y0, m_MinX, m_MinY, m_InvSize);
+				const uint32_t maxZ = ZOrder(x1, y1, m_MinX, m_MinY, m_InvSize);
+
+				const auto blocks = [&](const EarNode *p) {
+					return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c &&
+					       PointInTriangleExceptFirst(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && Area(p->prev, p, p->next) >= 0.0;
+				};
+
+				/// Walk the z-order list both ways from the ear until outside the triangle's z range.
+				const EarNode *p = ear->prevZ;
+				const EarNode *n = ear->nextZ;
+				while (p && p->z >= minZ && n && n->z <= maxZ)
+				{
+					if (blocks(p))
+						return false;
+					p = p->prevZ;
+					if (blocks(n))
+						return false;
+					n = n->nextZ;
+				}
+				for (; p && p->z >= minZ; p = p->prevZ)
+				{
+					if (blocks(p))
+						return false;
+				}
+				for (; n && n->z <= maxZ; n = n->nextZ)
+				{
+					if (blocks(n))
+						return false;
+				}
+				return true;
+			}
+
+			EarNode *CureLocalIntersections(EarNode *start)
+			{
+				EarNode *p = start;
+				do
+				{
+					EarNode *a = p->prev;
+					EarNode *b = p->next->next;
+					if (!Equals(a, b) && Intersects(a, p, p->next, b) && LocallyInside(a, b) && LocallyInside(b, a))
+					{
+						EmitTriangle(a, p, b);
+						RemoveNode(p);
+						RemoveNode(p->next);
+						p = start = b;
+					}
+					p = p->next;
+				}
+				while (p != start);
+				return FilterPoints(p);
+			}
+
+			/// Splits the polygon along the first valid diagonal and clips both halves.
+			void SplitEarcut(EarNode *start)
+			{
+				EarNode *a = start;
+				do
+				{
+					for (EarNode *b = a->next->next; b != a->prev; b = b->next)
+					{
+						if (a->i != b->i && IsValidDiagonal(a, b))
+						{
+							EarNode *c = SplitPolygon(a, b);
+							a = FilterPoints(a, a->next);
+							c = FilterPoints(c, c->next);
+							EarcutLinked(a, 0);
+							EarcutLinked(c, 0);
+							return;
+						}
+					}
+					a = a->next;
+				}
+				while (a != start);
+			}
+
+			/// Links a and b with a bridge, duplicating both, and returns the copy of b in the second loop.
+			EarNode *SplitPolygon(EarNode *a, EarNode *b)
+			{
+				EarNode &a2 = m_Nodes.emplace_back();
+				a2.i = a->i;
+				a2.x = a->x;
+				a2.y = a->y;
+				EarNode &b2 = m_Nodes.emplace_back();
+				b2.i = b->i;
+				b2.x = b->x;
+				b2.y = b->y;
+
+				EarNode *an = a->next;
+				EarNode *bp = b->prev;
+				a->next = b;
+				b->prev = a;
+				a2.next = an;
+				an->prev = &a2;
+				b2.next = &a2;
+				a2.prev = &b2;
+				bp->next = &b2;
+				b2.prev = bp;
+				return &b2;
+			}
+
+			EarNode *EliminateHoles(const std::vector<uint32_t> &ringStarts, EarNode *outer)
+			{
+				const auto count = static_cast<uint32_t>(m_Vertices.size());
+				std::vector<EarNode *> queue;
+				for (size_t ring = 1; ring < ringStarts.size(); ++ring)
+				{
+					const uint32_t start = std::min(ringStarts[ring], count);
+					const uint32_t end = ring + 1 < ringStarts.size() ? std::min(ringStarts[ring + 1], count) : count;
+					EarNode *list = LinkedList(start, end, false);
+					if (!list)
+						continue;
+					if (list == list->next)
+						list->steiner = true;
+					queue.push_back(GetLeftmost(list));
+				}
+
+				std::sort(queue.begin(), queue.end(), [](const EarNode *a, const EarNode *b) { return a->x < b->x || (a->x == b->x && a->y < b->y); });
+				for (EarNode *hole : queue)
+					outer = EliminateHole(hole, outer);
+				return outer;
+			}
+
+			EarNode *EliminateHole(EarNode *hole, EarNode *outer)
+			{
+				EarNode *bridge = FindHoleBridge(hole, outer);
+				if (!bridge)
+					return outer;
+
+				EarNode *bridgeReverse = SplitPolygon(bridge, hole);
+				FilterPoints(bridgeReverse, bridgeReverse->next);
+				return FilterPoints(bridge, bridge->next);
+			}
+
+			/// Outer ring vertex the leftmost point of a hole can be connected to without crossing an edge.
+			static EarNode *FindHoleBridge(const EarNode *hole, EarNode *outer)
+			{
+				EarNode *p = outer;
+				const double hx = hole->x;
+				const double hy = hole->y;
+				double qx = -HUGE_VAL;
+				EarNode *m = nullptr;
+
+				/// Closest outer edge hit by a ray cast left from the hole.
+				do
+				{
+					if (hy <= p->y && hy >= p->next->y && p->next->y != p->y)
+					{
+						const double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+						if (x <= hx && x > qx)
+						{
+							qx = x;
+							m = p->x < p->next->x ? p : p->next;
+							if (x == hx)
+								return m;
+						}
+					}
+					p = p->next;
+				}
+				while (p != outer);
+
+				if (!m)
+					return nullptr;
+
+				/// A reflex vertex inside the triangle (hole, hit, m) would block the bridge; take the one closest in angle instead.
+				const EarNode *stop = m;
+				const double mx = m->x;
+				const double my = m->y;
+				double tanMin = HUGE_VAL;
+				p = m;
+				do
+				{
+					if (hx >= p->x && p->x >= mx && hx != p->x &&
+						PointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y))
+					{
+						const double tan = std::abs(hy - p->y) / (hx - p->x);
+						if (LocallyInside(p, hole) && (tan < tanMin || (tan == tanMin && (p->x > m->x || (p->x == m->x && SectorContainsSector(m, p))))))
+						{
+							m = p;
+							tanMin = tan;
+						}
+					}
+					p = p->next;
+				}
+				while (p != stop);
+				return m;
+			}
+
+			static EarNode *GetLeftmost(EarNode *start)
+			{
+				EarNode *p = start;
+				EarNode *leftmost = start;
+				do
+				{
+					if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y))
+						leftmost = p;
+					p = p->next;
+				}
+				while (p != start);
+				return leftmost;
+			}
+
+			void IndexCurve(EarNode *start) const
+			{
+				EarNode *p = start;
+				do
+				{
+					p->z = ZOrder(p->x, p->y, m_MinX, m_MinY, m_InvSize);
+					p->prevZ = p->prev;
+					p->nextZ = p->next;
+					p = p->next;
+				}
+				while (p != start);
+
+				p->prevZ->nextZ = nullptr;
+				p->prevZ = nullptr;
+				SortLinked(p);
+			}
+
+			/// Bottom-up merge sort of the z list.
+			static void SortLinked(EarNode *list)
+			{
+				uint32_t inSize = 1;
+				uint32_t merges;
+				do
+				{
+					EarNode *p = list;
+					list = nullptr;
+					EarNode *tail = nullptr;
+					merges = 0;
+					while (p)
+					{
+						++merges;
+						EarNode *q = p;
+						uint32_t pSize = 0;
+						for (uint32_t i = 0; i < inSize && q; ++i)
+						{
+							++pSize;
+							q = q->nextZ;
+						}
+						uint32_t qSize = inSize;
+
+						while (pSize > 0 || (qSize > 0 && q))
+						{
+							EarNode *e;
+							if (pSize != 0 && (qSize == 0 || !q || p->z <= q->z))
+							{
+								e = p;
+								p = p->nextZ;
+								--pSize;
+							}
+							else
+							{
+								e = q;
+								q = q->nextZ;
+								--qSize;
+							}
+							if (tail)
+								tail->nextZ = e;
+							else
+								list = e;
+							e->prevZ = tail;
+							tail = e;
+						}
+						p = q;
+					}
+					tail->nextZ = nullptr;
+					inSize *= 2;
+				}
+				while (merges > 1);
+			}
+
+			const std::vector<DVec2> &m_Vertices;
+			std::vector<uint32_t> &m_Indices;
+			std::deque<EarNode> m_Nodes;	///< Stable addresses while the lists are spliced
+			double m_MinX = 0.0;
+			double m_MinY = 0.0;
+			double m_InvSize = 0.0;
+		};
+	}
+
+	/// -----------------------------------------------------
+
+	void FlattenRing(const TessRing &ring, const TessOptions &options, std::vector<DVec2> &out)
+	{
+		for (size_t i = 0; i < ring.size(); ++i)
+			FlattenEdgePoints(ring[i], ring[(i + 1) % ring.size()], options, out);
+	}
+
+	void FlattenBezierEdge(const TessNode &from, const TessNode &to, const TessOptions &options, std::vector<DVec2> &out)
+	{
+		FlattenEdgePoints(from, to, options, out);
+	}
+
+	void Triangulate(const std::vector<DVec2> &vertices, const std::vector<uint32_t> &ringStarts, std::vector<uint32_t> &indices)
+	{
+		indices.clear();
+		if (vertices.size() < 3)
+			return;
+		indices.reserve((vertices.size() + 2 * ringStarts.size()) * 3);
+		EarClipper(vertices, indices).Run(ringStarts);
+	}
+
+	/// -----------------------------------------------------
+
+	PolygonTessellator::PolygonTessellator(std::vector<TessRing> rings, const TessOptions &options)
+	{
+		SetPolygon(std::move(rings), options);
+	}
+
+	void PolygonTessellator::SetPolygon(std::vector<TessRing> rings, const TessOptions &options)
+	{
+		m_Rings = std::move(rings);
+		m_Options = options;
+		m_CachedTolerance = options.GetTolerance();
+		m_Edges.assign(m_Rings.size(), {});
+		m_DirtyEdges.assign(m_Rings.size(), {});
+		m_DirtyRings.assign(m_Rings.size(), 1);
+		for (size_t ring = 0; ring < m_Rings.size(); ++ring)
+			m_Edges[ring].resize(m_Rings[ring].size());
+		m_DirtyMesh = true;
+	}
+
+	void PolygonTessellator::SetOptions(const TessOptions &options)
+	{
+		const double tolerance = options.GetTolerance();
+		const bool refine = tolerance < m_CachedTolerance || tolerance > m_CachedTolerance * 2.0 || options.maxDepth != m_Options.maxDepth;
+		m_Options = options;
+		if (!refine)
+			return;
+
+		m_CachedTolerance = tolerance;
+		for (uint32_t ring = 0; ring < m_Rings.size(); ++ring)
+			InvalidateRing(ring);
+	}
+
+	void PolygonTessellator::MoveNode(const uint32_t ring, const uint32_t node, const TessNode &value)
+	{
+		if (ring >= m_Rings.size() || node >= m_Rings[ring].size())
+			return;
+
+		const auto count = static_cast<uint32_t>(m_Rings[ring].size());
+		m_Rings[ring][node] = value;
+		m_DirtyEdges[ring].push_back((node + count - 1) % count);
+		m_DirtyEdges[ring].push_back(node);
+		m_DirtyMesh = true;
+	}
+
+	void PolygonTessellator::InsertNode(const uint32_t ring, uint32_t before, const TessNode &value)
+	{
+		if (ring >= m_Rings.size())
+			return;
+
+		before = std::min(before, static_cast<uint32_t>(m_Rings[ring].size()));
+		m_Rings[ring].insert(m_Rings[ring].begin() + before, value);
+		m_Edges[ring].insert(m_Edges[ring].begin() + before, std::vector<DVec2>());
+
+		/// Indices of pending edges after the insertion point shift by one.
+		for (uint32_t &edge : m_DirtyEdges[ring])
+		{
+			if (edge >= before)
+				++edge;
+		}
+		const auto count = static_cast<uint32_t>(m_Rings[ring].size());
+		m_DirtyEdges[ring].push_back((before + count - 1) % count);
+		m_DirtyEdges[ring].push_back(before);
+		m_DirtyMesh = true;
+	}
+
+	void PolygonTessellator::RemoveNode(const uint32_t ring, const uint32_t node)
+	{
+		if (ring >= m_Rings.size() || node >= m_Rings[ring].size())
+			return;
+
+		m_Rings[ring].erase(m_Rings[ring].begin() + node);
+		m_Edges[ring].erase(m_Edges[ring].begin() + node);
+
+		auto &dirty = m_DirtyEdges[ring];
+		dirty.erase(std::remove(dirty.begin(), dirty.end(), node), dirty.end());
+		for (uint32_t &edge : dirty)
+		{
+			if (edge > node)
+				--edge;
+		}
+		if (const auto count = static_cast<uint32_t>(m_Rings[ring].size()))
+			dirty.push_back((node + count - 1) % count);
+		m_DirtyMesh = true;
+	}
+
+	void PolygonTessellator::InvalidateRing(const uint32_t ring)
+	{
+		m_DirtyRings[ring] = 1;
+		m_DirtyEdges[ring].clear();
+		m_DirtyMesh = true;
+	}
+
+	void PolygonTessellator::FlattenEdge(const uint32_t ring, const uint32_t edge)
+	{
+		const TessRing &nodes = m_Rings[ring];
+		std::vector<DVec2> &points = m_Edges[ring][edge];
+		points.clear();
+		FlattenEdgePoints(nodes[edge], nodes[(edge + 1) % nodes.size()], m_Options, points);
+		++m_Pending.edgesFlattened;
+	}
+
+	const TessMesh &PolygonTessellator::GetMesh()
+	{
+		if (!m_DirtyMesh)
+		{
+			m_LastUpdate = {};
+			return m_Mesh;
+		}
+
+		m_Pending = {};
+		for (uint32_t ring = 0; ring < m_Rings.size(); ++ring)
+		{
+			if (m_DirtyRings[ring])
+			{
+				for (uint32_t edge = 0; edge < m_Rings[ring].size(); ++edge)
+					FlattenEdge(ring, edge);
+				m_DirtyRings[ring] = 0;
+			}
+			else
+			{
+				auto &dirty = m_DirtyEdges[ring];
+				std::sort(dirty.begin(), dirty.end());
+				dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+				for (const uint32_t edge : dirty)
+					FlattenEdge(ring, edge);
+			}
+			m_DirtyEdges[ring].clear();
+		}
+
+		m_Mesh.vertices.clear();
+		m_Mesh.ringStarts.clear();
+		for (const auto &edges : m_Edges)
+		{
+			m_Mesh.ringStarts.push_back(static_cast<uint32_t>(m_Mesh.vertices.size()));
+			for (const auto &points : edges)
+				m_Mesh.vertices.insert(m_Mesh.vertices.end(), points.begin(), points.end());
+			++m_Pending.ringsAssembled;
+		}
+
+		Triangulate(m_Mesh.vertices, m_Mesh.ringStarts, m_Mesh.indices);
+		m_Pending.triangulated = true;
+		m_LastUpdate = m_Pending;
+		m_DirtyMesh = false;
+		return m_Mesh;
+	}
+
+}
+
+/// -----------------------------------------------------
@@ -0,0 +1,705 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* bc_encoder.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "bc_encoder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		constexpr int BLOCK_TEXELS = 16;
+
+		/// -------------------------------------------------------
+		/// Shared helpers
+		/// -------------------------------------------------------
+
+		/**
+		 * Principal axis of a point cloud in up to 4 dimensions via power iteration.
+		 * Returns false if the points are (nearly) identical.
+		 */
+		template<int N>
+		bool PrincipalAxis(const float (&points)[BLOCK_TEXELS][4], float (&mean)[4], float (&axis)[4])
+		{
+			for (int c = 0; c < 4; ++c)
+				mean[c] = 0.0f;
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+				for (int c = 0; c < N; ++c)
+					mean[c] += points[i][c];
+			for (int c = 0; c < N; ++c)
+				mean[c] /= static_cast<float>(BLOCK_TEXELS);
+
+			float cov[4][4] = {};
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+			{
+				float d[4];
+				for (int c = 0; c < N; ++c)
+					d[c] = points[i][c] - mean[c];
+				for (int r = 0; r < N; ++r)
+					for (int c = r; c < N; ++c)
+						cov[r][c] += d[r] * d[c];
+			}
+			for (int r = 0; r < N; ++r)
+				for (int c = 0; c < r; ++c)
+					cov[r][c] = cov[c][r];
+
+			/// Seed with the diagonal so the iteration starts close to the dominant direction.
+			float v[4] = {};
+			for (int c = 0; c < N; ++c)
+				v[c] = cov[c][c] + 1e-3f * static_cast<float>(c + 1);
+
+			for (int iteration = 0; iteration < 8; ++iteration)
+			{
+				float next[4] = {};
+				for (int r = 0; r < N; ++r)
+					for (int c = 0; c < N; ++c)
+						next[r] += cov[r][c] * v[c];
+
+				float len = 0.0f;
+				for (int c = 0; c < N; ++c)
+					len += next[c] * next[c];
+				if (len < 1e-12f)
+					return false;
+
+				len = 1.0f / std::sqrt(len);
+				for (int c = 0; c < N; ++c)
+					v[c] = next[c] * len;
+			}
+
+			for (int c = 0; c < 4; ++c)
+				axis[c] = c < N ? v[c] : 0.0f;
+			return true;
+		}
+
+		/// Least squares endpoints for fixed interpolation weights (weight applies to endpoint 1).
+		template<int N>
+		bool SolveEndpoints(const float (&points)[BLOCK_TEXELS][4], const float *weights, float (&e0)[4], float (&e1)[4])
+		{
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float ax[4] = {}, bx[4] = {};
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+			{
+				const float b = weights[i];
+				const float a = 1.0f - b;
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+				for (int c = 0; c < N; ++c)
+				{
+					ax[c] += a * points[i][c];
+					bx[c] += b * points[i][c];
+				}
+			}
+
+			const float det = aa * bb - ab * ab;
+			if (std::fabs(det) < 1e-6f)
+				return false;
+
+			const float inv = 1.0f / det;
+			for (int c = 0; c < N; ++c)
+			{
+				e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) * inv, 0.0f, 255.0f);
+				e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) * inv, 0.0f, 255.0f);
+			}
+			return true;
+		}
+
+		/// -------------------------------------------------------
+		/// BC1
+		/// -------------------------------------------------------
+
+		uint16_t PackRGB565(const float *c)
+		{
+			const auto r = static_cast<uint16_t>(std::clamp(static_cast<int>(c[0] * 31.0f / 255.0f + 0.5f), 0, 31));
+			const auto g = static_cast<uint16_t>(std::clamp(static_cast<int>(c[1] * 63.0f / 255.0f + 0.5f), 0, 63));
+			const auto b = static_cast<uint16_t>(std::clamp(static_cast<int>(c[2] * 31.0f / 255.0f + 0.5f), 0, 31));
+			return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+		}
+
+		void UnpackRGB565(const uint16_t c, int *out)
+		{
+			const int r = (c >> 11) & 31;
+			const int g = (c >> 5) & 63;
+			const int b = c & 31;
+			out[0] = (r << 3) | (r >> 2);
+			out[1] = (g << 2) | (g >> 4);
+			out[2] = (b << 3) | (b >> 2);
+		}
+
+		void BuildBC1Palette(const uint16_t c0, const uint16_t c1, const bool fourColor, int (&palette)[4][4])
+		{
+			UnpackRGB565(c0, palette[0]);
+			UnpackRGB565(c1, palette[1]);
+			palette[0][3] = 255;
+			palette[1][3] = 255;
+			for (int c = 0; c < 3; ++c)
+			{
+				if (fourColor)
+				{
+					palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+					palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+				}
+				else
+				{
+					palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+					palette[3][c] = 0;
+				}
+			}
+			palette[2][3] = 255;
+			palette[3][3] = fourColor ? 255 : 0;
+		}
+
+		/// Picks the nearest 4 colour palette entry per texel; returns the total squared error.
+		float MatchBC1Indices(const float (&points)[BLOCK_TEXELS][4], const uint16_t c0, const uint16_t c1, uint32_t &outIndices)
+		{
+			int palette[4][4];
+			BuildBC1Palette(c0, c1, true, palette);
+
+			float total = 0.0f;
+			outIndices = 0;
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+			{
+				float best = std::numeric_limits<float>::max();
+				uint32_t bestIndex = 0;
+				for (uint32_t p = 0; p < 4; ++p)
+				{
+					float err = 0.0f;
+					for (int c = 0; c < 3; ++c)
+					{
+						const float d = points[i][c] - static_cast<float>(palette[p][c]);
+						err += d * d;
+					}
+					if (err < best)
+					{
+						best = err;
+						bestIndex = p;
+					}
+				}
+				outIndices |= bestIndex << (i * 2);
+				total += best;
+			}
+			return total;
+		}
+
+		void WriteBC1(uint16_t c0, uint16_t c1, uint32_t indices, uint8_t *out)
+		{
+			if (c0 < c1)
+			{
+				std::swap(c0, c1);
+				/// 0 <-> 1 and 2 <-> 3 is a flip of the low bit of every index.
+				indices ^= 0x55555555u;
+			}
+			else if (c0 == c1)
+			{
+				indices = 0;
+			}
+
+			out[0] = static_cast<uint8_t>(c0 & 0xFF);
+			out[1] = static_cast<uint8_t>(c0 >> 8);
+			out[2] = static_cast<uint8_t>(c1 & 0xFF);
+			out[3] = static_cast<uint8_t>(c1 >> 8);
+			std::memcpy(out + 4, &indices, 4);
+		}
+
+		void EncodeColorBlock(const uint8_t *rgba, uint8_t *out)
+		{
+			float points[BLOCK_TEXELS][4];
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+				for (int c = 0; c < 4; ++c)
+					points[i][c] = static_cast<float>(rgba[i * 4 + c]);
+
+			float mean[4], axis[4];
+			if (!PrincipalAxis<3>(points, mean, axis))
+			{
+				const uint16_t c = PackRGB565(points[0]);
+				WriteBC1(c, c, 0, out);
+				return;
+			}
+
+			/// Endpoints are the extreme texels along the principal axis.
+			float minT = std::numeric_limits<float>::max();
+			float maxT = -std::numeric_limits<float>::max();
+			int minI = 0, maxI = 0;
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+			{
+				const float t = (points[i][0] - mean[0]) * axis[0] + (points[i][1] - mean[1]) * axis[1] + (points[i][2] - mean[2]) * axis[2];
+				if (t < minT) { minT = t; minI = i; }
+				if (t > maxT) { maxT = t; maxI = i; }
+			}
+
+			uint16_t c0 = PackRGB565(points[maxI]);
+			uint16_t c1 = PackRGB565(points[minI]);
+			uint32_t indices = 0;
+			float error = MatchBC1Indices(points, c0, c1, indices);
+
+			static constexpr float indexWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+			for (int iteration = 0; iteration < 2; ++iteration)
+			{
+				float weights[BLOCK_TEXELS];
+				for (int i = 0; i < BLOCK_TEXELS; ++i)
+					weights[i] = indexWeights[(indices >> (i * 2)) & 3];
+
+				float e0[4], e1[4];
+				if (!SolveEndpoints<3>(points, weights, e0, e1))
+					break;
+
+				const uint16_t n0 = PackRGB565(e0);
+				const uint16_t n1 = PackRGB565(e1);
+				uint32_t nIndices = 0;
+				const float nError = MatchBC1Indices(points, n0, n1, nIndices);
+				if (nError >= error)
+					break;
+
+				c0 = n0;
+				c1 = n1;
+				indices = nIndices;
+				error = nError;
+			}
+
+			WriteBC1(c0, c1, indices, out);
+		}
+
+		/// -------------------------------------------------------
+		/// BC4
+		/// -------------------------------------------------------
+
+		void BuildBC4Palette(const int a0, const int a1, int (&palette)[8])
+		{
+			palette[0] = a0;
+			palette[1] = a1;
+			if (a0 > a1)
+			{
+				for (int i = 1; i <= 6; ++i)
+					palette[i + 1] = ((7 - i) * a0 + i * a1 + 3) / 7;
+			}
+			else
+			{
+				for (int i = 1; i <= 4; ++i)
+					palette[i + 1] = ((5 - i) * a0 + i * a1 + 2) / 5;
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+		}
+
+		int MatchBC4Indices(const uint8_t *values, const int a0, const int a1, uint64_t &outIndices)
+		{
+			int palette[8];
+			BuildBC4Palette(a0, a1, palette);
+
+			int total = 0;
+			outIndices = 0;
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+			{
+				int best = std::numeric_limits<int>::max();
+				uint64_t bestIndex = 0;
+				for (int p = 0; p < 8; ++p)
+				{
+					const int d = static_cast<int>(values[i]) - palette[p];
+					if (d * d < best)
+					{
+						best = d * d;
+						bestIndex = static_cast<uint64_t>(p);
+					}
+				}
+				outIndices |= bestIndex << (i * 3);
+				total += best;
+			}
+			return total;
+		}
+
+		/// -------------------------------------------------------
+		/// BC7 (mode 6)
+		/// -------------------------------------------------------
+
+		constexpr int BC7_WEIGHTS4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		class BitWriter
+		{
+		public:
+			explicit BitWriter(uint8_t *out) : m_Out(out) { std::memset(out, 0, 16); }
+
+			void Write(uint32_t value, const uint32_t bits)
+			{
+				for (uint32_t i = 0; i < bits; ++i, ++m_Position, value >>= 1)
+				{
+					if (value & 1)
+						m_Out[m_Position >> 3] |= static_cast<uint8_t>(1u << (m_Position & 7));
+				}
+			}
+
+		private:
+			uint8_t *m_Out;
+			uint32_t m_Position = 0;
+		};
+
+		class BitReader
+		{
+		public:
+			explicit BitReader(const uint8_t *in) : m_In(in) {}
+
+			uint32_t Read(const uint32_t bits)
+			{
+				uint32_t value = 0;
+				for (uint32_t i = 0; i < bits; ++i, ++m_Position)
+					value |= static_cast<uint32_t>((m_In[m_Position >> 3] >> (m_Position & 7)) & 1) << i;
+				return value;
+			}
+
+		private:
+			const uint8_t *m_In;
+			uint32_t m_Position = 0;
+		};
+
+		struct BC7Endpoint
+		{
+			uint32_t q[4] = {};	///< 7 bit per channel
+			uint32_t p = 0;		///< shared p-bit
+
+			[[nodiscard]] int Value(const int c) const { return static_cast<int>((q[c] << 1) | p); }
+		};
+
+		BC7Endpoint QuantizeBC7(const float (&e)[4])
+		{
+			BC7Endpoint best;
+			float bestErr = std::numeric_limits<float>::max();
+			for (uint32_t p = 0; p < 2; ++p)
+			{
+				BC7Endpoint candidate;
+				candidate.p = p;
+				float err = 0.0f;
+				for (int c = 0; c < 4; ++c)
+				{
+					const int q = std::clamp(static_cast<int>(std::floor((e[c] - static_cast<float>(p)) * 0.5f + 0.5f)), 0, 127);
+					candidate.q[c] = static_cast<uint32_t>(q);
+					const float d = static_cast<float>(candidate.Value(c)) - e[c];
+					err += d * d;
+				}
+				if (err < bestErr)
+				{
+					bestErr = err;
+					best = candidate;
+				}
+			}
+			return best;
+		}
+
+		inline int InterpolateBC7(const int e0, const int e1, const int weight)
+		{
+			return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+		}
+
+		/// Projects texels onto the quantised endpoint line, then checks the neighbouring indices.
+		float MatchBC7Indices(const float (&points)[BLOCK_TEXELS][4], const BC7Endpoint &e0, const BC7Endpoint &e1, uint8_t (&outIndices)[BLOCK_TEXELS])
+		{
+			int palette[16][4];
+			float dir[4];
+			float dirLenSq = 0.0f;
+			for (int c = 0; c < 4; ++c)
+			{
+				for (int k = 0; k < 16; ++k)
+					palette[k][c] = InterpolateBC7(e0.Value(c), e1.Value(c), BC7_WEIGHTS4[k]);
+				dir[c] = static_cast<float>(e1.Value(c) - e0.Value(c));
+				dirLenSq += dir[c] * dir[c];
+			}
+
+			float total = 0.0f;
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+			{
+				int guess = 0;
+				if (dirLenSq > 0.0f)
+				{
+					float t = 0.0f;
+					for (int c = 0; c < 4; ++c)
+						t += (points[i][c] - static_cast<float>(e0.Value(c))) * dir[c];
+					guess = std::clamp(static_cast<int>(t / dirLenSq * 15.0f + 0.5f), 0, 15);
+				}
+
+				float best = std::numeric_limits<float>::max();
+				int bestIndex = guess;
+				for (int k = std::max(guess - 1, 0); k <= std::min(guess + 1, 15); ++k)
+				{
+					float err = 0.0f;
+					for (int c = 0; c < 4; ++c)
+					{
+						const float d = points[i][c] - static_cast<float>(palette[k][c]);
+						err += d * d;
+					}
+					if (err < best)
+					{
+						best = err;
+						bestIndex = k;
+					}
+				}
+				outIndices[i] = static_cast<uint8_t>(bestIndex);
+				total += best;
+			}
+			return total;
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	void BCEncoder::EncodeBC1(const uint8_t *rgba, uint8_t *outBlock)
+	{
+		EncodeColorBlock(rgba, outBlock);
+	}
+
+	void BCEncoder::EncodeBC4(const uint8_t *values, uint8_t *outBlock)
+	{
+		int minV = 255, maxV = 0;
+		int minInner = 255, maxInner = 0;
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			const int v = values[i];
+			minV = std::min(minV, v);
+			maxV = std::max(maxV, v);
+			if (v != 0 && v != 255)
+			{
+				minInner = std::min(minInner, v);
+				maxInner = std::max(maxInner, v);
+			}
+		}
+
+		/// 8 value palette: a0 > a1 (or a single flat value).
+		int a0 = maxV, a1 = minV;
+		uint64_t indices = 0;
+		int error = MatchBC4Indices(values, a0, a1, indices);
+
+		/// 6 value palette with explicit 0 and 255: a0 <= a1.
+		if (error > 0 && minInner <= maxInner)
+		{
+			uint64_t altIndices = 0;
+			const int altError = MatchBC4Indices(values, minInner, maxInner, altIndices);
+			if (altError < error)
+			{
+				a0 = minInner;
+				a1 = maxInner;
+				indices = altIndices;
+				error = altError;
+			}
+		}
+
+		outBlock[0] = static_cast<uint8_t>(a0);
+		outBlock[1] = static_cast<uint8_t>(a1);
+		for (int i = 0; i < 6; ++i)
+			outBlock[2 + i] = static_cast<uint8_t>((indices >> (i * 8)) & 0xFF);
+	}
+
+	void BCEncoder::EncodeBC3(const uint8_t *rgba, uint8_t *outBlock)
+	{
+		uint8_t alpha[BLOCK_TEXELS];
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+			alpha[i] = rgba[i * 4 + 3];
+
+		EncodeBC4(alpha, outBlock);
+		EncodeColorBlock(rgba, outBlock + 8);
+	}
+
+	void BCEncoder::EncodeBC5(const uint8_t *rgba, uint8_t *outBlock)
+	{
+		uint8_t red[BLOCK_TEXELS], green[BLOCK_TEXELS];
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			red[i] = rgba[i * 4 + 0];
+			green[i] = rgba[i * 4 + 1];
+		}
+
+		EncodeBC4(red, outBlock);
+		EncodeBC4(green, outBlock + 8);
+	}
+
+	void BCEncoder::EncodeBC7(const uint8_t *rgba, uint8_t *outBlock)
+	{
+		float points[BLOCK_TEXELS][4];
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+			for (int c = 0; c < 4; ++c)
+				points[i][c] = static_cast<float>(rgba[i * 4 + c]);
+
+		float mean[4], axis[4];
+		float lo[4], hi[4];
+		if (PrincipalAxis<4>(points, mean, axis))
+		{
+			float minT = std::numeric_limits<float>::max();
+			float maxT = -std::numeric_limits<float>::max();
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+			{
+				float t = 0.0f;
+				for (int c = 0; c < 4; ++c)
+					t += (points[i][c] - mean[c]) * axis[c];
+				minT = std::min(minT, t);
+				maxT = std::max(maxT, t);
+			}
+			for (int c = 0; c < 4; ++c)
+			{
+				lo[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+				hi[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+			}
+		}
+		else
+		{
+			for (int c = 0; c < 4; ++c)
+			{
+				lo[c] = points[0][c];
+				hi[c] = points[0][c];
+			}
+		}
+
+		BC7Endpoint e0 = QuantizeBC7(lo);
+		BC7Endpoint e1 = QuantizeBC7(hi);
+		uint8_t indices[BLOCK_TEXELS];
+		float error = MatchBC7Indices(points, e0, e1, indices);
+
+		for (int iteration = 0; iteration < 2 && error > 0.0f; ++iteration)
+		{
+			float weights[BLOCK_TEXELS];
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+				weights[i] = static_cast<float>(BC7_WEIGHTS4[indices[i]]) / 64.0f;
+
+			float r0[4], r1[4];
+			if (!SolveEndpoints<4>(points, weights, r0, r1))
+				break;
+
+			const BC7Endpoint n0 = QuantizeBC7(r0);
+			const BC7Endpoint n1 = QuantizeBC7(r1);
+			uint8_t nIndices[BLOCK_TEXELS];
+			const float nError = MatchBC7Indices(points, n0, n1, nIndices);
+			if (nError >= error)
+				break;
+
+			e0 = n0;
+			e1 = n1;
+			std::memcpy(indices, nIndices, sizeof(indices));
+			error = nError;
+		}
+
+		/// The anchor (texel 0) index is stored with an implicit 0 MSB.
+		if (indices[0] & 8)
+		{
+			std::swap(e0, e1);
+			for (auto &index : indices)
+				index = static_cast<uint8_t>(15 - index);
+		}
+
+		BitWriter writer(outBlock);
+		writer.Write(1u << 6, 7);
+		for (int c = 0; c < 4; ++c)
+		{
+			writer.Write(e0.q[c], 7);
+			writer.Write(e1.q[c], 7);
+		}
+		writer.Write(e0.p, 1);
+		writer.Write(e1.p, 1);
+		writer.Write(indices[0], 3);
+		for (int i = 1; i < BLOCK_TEXELS; ++i)
+			writer.Write(indices[i], 4);
+	}
+
+	/// -------------------------------------------------------
+
+	void BCEncoder::DecodeBC1(const uint8_t *block, uint8_t *outRGBA)
+	{
+		const uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+		const uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+		uint32_t indices;
+		std::memcpy(&indices, block + 4, 4);
+
+		int palette[4][4];
+		BuildBC1Palette(c0, c1, c0 > c1, palette);
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			const uint32_t index = (indices >> (i * 2)) & 3;
+			for (int c = 0; c < 4; ++c)
+				outRGBA[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+		}
+	}
+
+	void BCEncoder::DecodeBC4(const uint8_t *block, uint8_t *outValues)
+	{
+		int palette[8];
+		BuildBC4Palette(block[0], block[1], palette);
+
+		uint64_t indices = 0;
+		for (int i = 0; i < 6; ++i)
+			indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+			outValues[i] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+	}
+
+	void BCEncoder::DecodeBC3(const uint8_t *block, uint8_t *outRGBA)
+	{
+		/// BC2/BC3 colour blocks are always decoded in 4 colour mode.
+		const uint16_t c0 = static_cast<uint16_t>(block[8] | (block[9] << 8));
+		const uint16_t c1 = static_cast<uint16_t>(block[10] | (block[11] << 8));
+		uint32_t indices;
+		std::memcpy(&indices, block + 12, 4);
+
+		int palette[4][4];
+		BuildBC1Palette(c0, c1, true, palette);
+
+		uint8_t alpha[BLOCK_TEXELS];
+		DecodeBC4(block, alpha);
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			const uint32_t index = (indices >> (i * 2)) & 3;
+			for (int c = 0; c < 3; ++c)
+				outRGBA[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+			outRGBA[i * 4 + 3] = alpha[i];
+		}
+	}
+
+	void BCEncoder::DecodeBC5(const uint8_t *block, uint8_t *outRGBA)
+	{
+		uint8_t red[BLOCK_TEXELS], green[BLOCK_TEXELS];
+		DecodeBC4(block, red);
+		DecodeBC4(block + 8, green);
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			outRGBA[i * 4 + 0] = red[i];
+			outRGBA[i * 4 + 1] = green[i];
+			outRGBA[i * 4 + 2] = 0;
+			outRGBA[i * 4 + 3] = 255;
+		}
+	}
+
+	bool BCEncoder::DecodeBC7(const uint8_t *block, uint8_t *outRGBA)
+	{
+		BitReader reader(block);
+		if (reader.Read(7) != (1u << 6))
+			return false;
+
+		BC7Endpoint e0, e1;
+		for (int c = 0; c < 4; ++c)
+		{
+			e0.q[c] = reader.Read(7);
+			e1.q[c] = reader.Read(7);
+		}
+		e0.p = reader.Read(1);
+		e1.p = reader.Read(1);
+
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			const uint32_t index = reader.Read(i == 0 ? 3 : 4);
+			for (int c = 0; c < 4; ++c)
+				outRGBA[i * 4 + c] = static_cast<uint8_t>(InterpolateBC7(e0.Value(c), e1.Value(c), BC7_WEIGHTS4[index]));
+		}
+		return true;
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,55 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* bc_encoder.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/**
+	 * @brief CPU block compressors for the formats X-Plane accepts in DDS files.
+	 *
+	 * Every function works on a single 4x4 block given as 16 RGBA8 texels in row order.
+	 * The decoders exist so exported data can be verified (PSNR) and previewed without a GPU.
+	 *
+	 * - BC1: PCA endpoint fit followed by least squares refinement, always 4 colour mode.
+	 * - BC3: BC1 colour + BC4 alpha.
+	 * - BC4: tries both the 8 value and the 6 value (+0/255) palettes and keeps the better one.
+	 * - BC5: two BC4 blocks for the red and green channels (normal maps).
+	 * - BC7: mode 6 only (single subset RGBA, 7.7.7.7+p endpoints, 4 bit indices).
+	 */
+	class BCEncoder
+	{
+	public:
+		static void EncodeBC1(const uint8_t *rgba, uint8_t *outBlock);
+		static void EncodeBC3(const uint8_t *rgba, uint8_t *outBlock);
+		static void EncodeBC4(const uint8_t *values, uint8_t *outBlock);
+		static void EncodeBC5(const uint8_t *rgba, uint8_t *outBlock);
+		static void EncodeBC7(const uint8_t *rgba, uint8_t *outBlock);
+
+		static void DecodeBC1(const uint8_t *block, uint8_t *outRGBA);
+		static void DecodeBC3(const uint8_t *block, uint8_t *outRGBA);
+		static void DecodeBC4(const uint8_t *block, uint8_t *outValues);
+		static void DecodeBC5(const uint8_t *block, uint8_t *outRGBA);
+
+		/**
+		 * @brief Decodes a BC7 block.
+		 * @return false if the block uses a mode other than 6, in which case the output is left untouched.
+		 */
+		static bool DecodeBC7(const uint8_t *block, uint8_t *outRGBA);
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,393 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* mip_generator.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "mip_generator.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <emmintrin.h>
+	#define SEDX_MIP_SSE 1
+#else
+	#define SEDX_MIP_SSE 0
+#endif
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		constexpr uint32_t ROW_GRAIN = 8;
+
+		/// -------------------------------------------------------
+
+		const std::array<float, 256> &GetSRGBToLinearTable()
+		{
+			static const std::array<float, 256> table = []()
+			{
+				std::array<float, 256> t {};
+				for (uint32_t i = 0; i < 256; ++i)
+				{
+					const float c = static_cast<float>(i) / 255.0f;
+					t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+				}
+				return t;
+			}();
+			return table;
+		}
+
+		/// 16 bit quantised linear -> sRGB8. A step is ~0.05 of an 8 bit LSB even in the darkest range.
+		const std::vector<uint8_t> &GetLinearToSRGBTable()
+		{
+			static const std::vector<uint8_t> table = []()
+			{
+				std::vector<uint8_t> t(65536);
+				for (uint32_t i = 0; i < 65536; ++i)
+				{
+					const float l = static_cast<float>(i) / 65535.0f;
+					const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+					t[i] = static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+				}
+				return t;
+			}();
+			return table;
+		}
+
+		inline uint8_t EncodeUNorm(const float v)
+		{
+			return static_cast<uint8_t>(std::clamp(v * 255.0f + 0.5f, 0.0f, 255.0f));
+		}
+
+		inline uint8_t EncodeSRGB(const float v, const std::vector<uint8_t> &table)
+		{
+			const float q = std::clamp(v, 0.0f, 1.0f) * 65535.0f + 0.5f;
+			return table[static_cast<uint32_t>(q)];
+		}
+
+		/// -------------------------------------------------------
+
+		double BesselI0(const double x)
+		{
+			double sum = 1.0;
+			double term = 1.0;
+			const double halfSq = x * x * 0.25;
+			for (int k = 1; k < 32; ++k)
+			{
+				term *= halfSq / (static_cast<double>(k) * k);
+				sum += term;
+				if (term < sum * 1e-12)
+					break;
+			}
+			return sum;
+		}
+
+		/// Support radius of each filter, in destination texels.
+		float GetFilterRadius(const MipFilter filter)
+		{
+			switch (filter)
+			{
+				case MipFilter::Box:      return 0.5f;
+				case MipFilter::Triangle: return 1.0f;
+				case MipFilter::Kaiser:   return 3.0f;
+			}
+			return 0.5f;
+		}
+
+		float EvaluateFilter(const MipFilter filter, const float t)
+		{
+			const float at = std::fabs(t);
+			switch (filter)
+			{
+				case MipFilter::Box:
+					return at <= 0.5f ? 1.0f : 0.0f;
+				case MipFilter::Triangle:
+					return std::max(0.0f, 1.0f - at);
+				case MipFilter::Kaiser:
+				{
+					constexpr double alpha = 4.0;
+					constexpr double radius = 3.0;
+					if (at >= radius)
+						return 0.0f;
+					const double x = at * 3.14159265358979323846;
+					const double sinc = at < 1e-6 ? 1.0 : std::sin(x) / x;
+					const double r = at / radius;
+					const double window = BesselI0(alpha * std::sqrt(1.0 - r * r)) / BesselI0(alpha);
+					return static_cast<float>(sinc * window);
+				}
+			}
+			return 0.0f;
+		}
+
+		/**
+		 * Polyphase kernel for one axis: `taps` source indices and weights per destination texel.
+		 * Odd source sizes get their own phase per texel instead of assuming an exact 2:1 ratio.
+		 */
+		struct AxisKernel
+		{
+			uint32_t taps = 0;
+			std::vector<uint32_t> indices;
+			std::vector<float> weights;
+		};
+
+		AxisKernel BuildKernel(const uint32_t srcSize, const uint32_t dstSize, const MipSettings &settings)
+		{
+			AxisKernel kernel;
+			if (srcSize == dstSize)
+			{
+				kernel.taps = 1;
+				kernel.indices.resize(dstSize);
+				kernel.weights.assign(dstSize, 1.0f);
+				for (uint32_t i = 0; i < dstSize; ++i)
+					kernel.indices[i] = i;
+				return kernel;
+			}
+
+			const float scale = static_cast<float>(srcSize) / static_cast<float>(dstSize);
+			const float support = GetFilterRadius(settings.filter) * scale;
+			kernel.taps = static_cast<uint32_t>(std::ceil(support * 2.0f)) + 1;
+			kernel.indices.resize(static_cast<size_t>(dstSize) * kernel.taps);
+			kernel.weights.resize(static_cast<size_t>(dstSize) * kernel.taps);
+
+			const int32_t size = static_cast<int32_t>(srcSize);
+			for (uint32_t i = 0; i < dstSize; ++i)
+			{
+				const float center = (static_cast<float>(i) + 0.5f) * scale;
+				const int32_t first = static_cast<int32_t>(std::floor(center - support));
+
+				float total = 0.0f;
+				for (uint32_t k = 0; k < kernel.taps; ++k)
+				{
+					const int32_t j = first + static_cast<int32_t>(k);
+					const float t = (static_cast<float>(j) + 0.5f - center) / scale;
+					const float w = EvaluateFilter(settings.filter, t);
+
+					int32_t src;
+					if (settings.wrap)
+						src = ((j % size) + size) % size;
+					else
+						src = std::clamp(j, 0, size - 1);
+
+					kernel.indices[i * kernel.taps + k] = static_cast<uint32_t>(src);
+					kernel.weights[i * kernel.taps + k] = w;
+					total += w;
+				}
+
+				const float inv = total != 0.0f ? 1.0f / total : 0.0f;
+				for (uint32_t k = 0; k < kernel.taps; ++k)
+					kernel.weights[i * kernel.taps + k] *= inv;
+			}
+			return kernel;
+		}
+
+		/// -------------------------------------------------------
+
+		void FilterRow(const float *src, float *dst, const uint32_t dstWidth, const AxisKernel &kernel)
+		{
+			for (uint32_t x = 0; x < dstWidth; ++x)
+			{
+				const uint32_t *idx = kernel.indices.data() + static_cast<size_t>(x) * kernel.taps;
+				const float *w = kernel.weights.data() + static_cast<size_t>(x) * kernel.taps;
+#if SEDX_MIP_SSE
+				__m128 acc = _mm_setzero_ps();
+				for (uint32_t k = 0; k < kernel.taps; ++k)
+					acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w[k]), _mm_loadu_ps(src + idx[k] * 4)));
+				_mm_storeu_ps(dst + x * 4, acc);
+#else
+				float acc[4] = {};
+				for (uint32_t k = 0; k < kernel.taps; ++k)
+				{
+					const float *s = src + idx[k] * 4;
+					for (int c = 0; c < 4; ++c)
+						acc[c] += w[k] * s[c];
+				}
+				for (int c = 0; c < 4; ++c)
+					dst[x * 4 + c] = acc[c];
+#endif
+			}
+		}
+
+		/// Accumulates weight * src into dst for a whole row; `count` is in floats.
+		void AccumulateRow(const float *src, float *dst, const size_t count, const float weight)
+		{
+			size_t i = 0;
+#if SEDX_MIP_SSE
+			const __m128 w = _mm_set1_ps(weight);
+			for (; i + 8 <= count; i += 8)
+			{
+				_mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(w, _mm_loadu_ps(src + i))));
+				_mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_mul_ps(w, _mm_loadu_ps(src + i + 4))));
+			}
+#endif
+			for (; i < count; ++i)
+				dst[i] += weight * src[i];
+		}
+
+		void RenormalizeRow(float *row, const uint32_t width)
+		{
+			for (uint32_t x = 0; x < width; ++x)
+			{
+				float *n = row + x * 4;
+				const float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				if (len > 1e-6f)
+				{
+					const float inv = 1.0f / len;
+					n[0] *= inv;
+					n[1] *= inv;
+					n[2] *= inv;
+				}
+				else
+				{
+					n[0] = 0.0f;
+					n[1] = 0.0f;
+					n[2] = 1.0f;
+				}
+			}
+		}
+
+		void RunRows(ThreadPool *pool, const uint32_t rows, const std::function<void(uint32_t, uint32_t)> &func)
+		{
+			if (pool)
+				pool->ParallelForRange(rows, ROW_GRAIN, func);
+			else
+				func(0, rows);
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	uint32_t MipGenerator::GetMipLevelCount(uint32_t width, uint32_t height)
+	{
+		uint32_t levels = 1;
+		while (width > 1 || height > 1)
+		{
+			width = std::max(width / 2, 1u);
+			height = std::max(height / 2, 1u);
+			++levels;
+		}
+		return levels;
+	}
+
+	FloatImage MipGenerator::FromRGBA8(const uint8_t *rgba, const uint32_t width, const uint32_t height, const MipSettings &settings)
+	{
+		FloatImage image;
+		image.width = width;
+		image.height = height;
+		image.texels.resize(static_cast<size_t>(width) * height * 4);
+
+		const auto &srgb = GetSRGBToLinearTable();
+		const size_t count = static_cast<size_t>(width) * height;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint8_t *s = rgba + i * 4;
+			float *d = image.texels.data() + i * 4;
+			for (int c = 0; c < 3; ++c)
+			{
+				if (settings.normalMap)
+					d[c] = static_cast<float>(s[c]) / 127.5f - 1.0f;
+				else if (settings.sRGB)
+					d[c] = srgb[s[c]];
+				else
+					d[c] = static_cast<float>(s[c]) / 255.0f;
+			}
+			d[3] = static_cast<float>(s[3]) / 255.0f;
+		}
+		return image;
+	}
+
+	void MipGenerator::ToRGBA8(const FloatImage &image, const MipSettings &settings, std::vector<uint8_t> &outRGBA)
+	{
+		const size_t count = static_cast<size_t>(image.width) * image.height;
+		outRGBA.resize(count * 4);
+
+		const auto &srgb = GetLinearToSRGBTable();
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float *s = image.texels.data() + i * 4;
+			uint8_t *d = outRGBA.data() + i * 4;
+			for (int c = 0; c < 3; ++c)
+			{
+				if (settings.normalMap)
+					d[c] = EncodeUNorm(s[c] * 0.5f + 0.5f);
+				else if (settings.sRGB)
+					d[c] = EncodeSRGB(s[c], srgb);
+				else
+					d[c] = EncodeUNorm(s[c]);
+			}
+			d[3] = EncodeUNorm(s[3]);
+		}
+	}
+
+	FloatImage MipGenerator::Downsample(const FloatImage &source, const MipSettings &settings, ThreadPool *pool)
+	{
+		FloatImage result;
+		result.width = std::max(source.width / 2, 1u);
+		result.height = std::max(source.height / 2, 1u);
+		result.texels.assign(static_cast<size_t>(result.width) * result.height * 4, 0.0f);
+
+		const AxisKernel horizontal = BuildKernel(source.width, result.width, settings);
+		const AxisKernel vertical = BuildKernel(source.height, result.height, settings);
+
+		/// Horizontal pass: every source row is narrowed to the destination width.
+		FloatImage narrowed;
+		narrowed.width = result.width;
+		narrowed.height = source.height;
+		narrowed.texels.resize(static_cast<size_t>(narrowed.width) * narrowed.height * 4);
+
+		RunRows(pool, source.height, [&](const uint32_t begin, const uint32_t end)
+		{
+			for (uint32_t y = begin; y < end; ++y)
+				FilterRow(source.Row(y), narrowed.Row(y), result.width, horizontal);
+		});
+
+		/// Vertical pass: accumulate whole rows so the inner loop stays contiguous.
+		RunRows(pool, result.height, [&](const uint32_t begin, const uint32_t end)
+		{
+			const size_t rowFloats = static_cast<size_t>(result.width) * 4;
+			for (uint32_t y = begin; y < end; ++y)
+			{
+				float *dst = result.Row(y);
+				for (uint32_t k = 0; k < vertical.taps; ++k)
+				{
+					const float w = vertical.weights[static_cast<size_t>(y) * vertical.taps + k];
+					if (w != 0.0f)
+						AccumulateRow(narrowed.Row(vertical.indices[static_cast<size_t>(y) * vertical.taps + k]), dst, rowFloats, w);
+				}
+
+				if (settings.normalMap)
+					RenormalizeRow(dst, result.width);
+			}
+		});
+
+		return result;
+	}
+
+	std::vector<FloatImage> MipGenerator::GenerateChain(FloatImage base, const MipSettings &settings, ThreadPool *pool)
+	{
+		uint32_t levels = GetMipLevelCount(base.width, base.height);
+		if (settings.maxLevels > 0)
+			levels = std::min(levels, settings.maxLevels);
+
+		std::vector<FloatImage> chain;
+		chain.reserve(levels);
+		chain.emplace_back(std::move(base));
+		for (uint32_t level = 1; level < levels; ++level)
+			chain.emplace_back(Downsample(chain.back(), settings, pool));
+
+		return chain;
+	}
+
+}
+
+/// -------------------------------------------------------
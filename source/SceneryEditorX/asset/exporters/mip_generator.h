@@ -0,0 +1,89 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* mip_generator.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	class ThreadPool;
+
+	/// Reconstruction filter used when halving a mip level.
+	enum class MipFilter : uint8_t
+	{
+		Box = 0,	///< 2x2 average, cheapest and softest
+		Triangle,	///< Tent filter with a 2 texel radius
+		Kaiser		///< Kaiser windowed sinc, sharpest (default)
+	};
+
+	struct MipSettings
+	{
+		MipFilter filter = MipFilter::Kaiser;
+		bool sRGB = true;		///< Colour channels are sRGB encoded and are filtered in linear space
+		bool normalMap = false;	///< RGB holds a tangent space normal; each level is renormalised
+		bool wrap = true;		///< Wrap at the edges (tiling textures) instead of clamping
+		uint32_t maxLevels = 0;	///< 0 generates the full chain down to 1x1
+	};
+
+	/**
+	 * @brief Linear, 4 channel float image used as the working format of the pipeline.
+	 *
+	 * Texels are stored as interleaved RGBA so a texel maps to a single SSE register.
+	 */
+	struct FloatImage
+	{
+		uint32_t width = 0;
+		uint32_t height = 0;
+		std::vector<float> texels;
+
+		[[nodiscard]] float *Row(const uint32_t y) { return texels.data() + static_cast<size_t>(y) * width * 4; }
+		[[nodiscard]] const float *Row(const uint32_t y) const { return texels.data() + static_cast<size_t>(y) * width * 4; }
+	};
+
+	class MipGenerator
+	{
+	public:
+		/**
+		 * @brief Decodes RGBA8 texels into the working format.
+		 *
+		 * sRGB colour is linearised, normal maps are expanded to [-1, 1], alpha is always linear.
+		 */
+		static FloatImage FromRGBA8(const uint8_t *rgba, uint32_t width, uint32_t height, const MipSettings &settings);
+
+		/**
+		 * @brief Encodes a working image back to RGBA8 using the same conventions as FromRGBA8().
+		 */
+		static void ToRGBA8(const FloatImage &image, const MipSettings &settings, std::vector<uint8_t> &outRGBA);
+
+		/**
+		 * @brief Produces a single level half the size of the source (rounded down, at least 1).
+		 */
+		static FloatImage Downsample(const FloatImage &source, const MipSettings &settings, ThreadPool *pool = nullptr);
+
+		/**
+		 * @brief Builds the full mip chain; element 0 is the base image.
+		 */
+		static std::vector<FloatImage> GenerateChain(FloatImage base, const MipSettings &settings, ThreadPool *pool = nullptr);
+
+		/**
+		 * @brief Number of levels in a full chain for the given top level size.
+		 */
+		static uint32_t GetMipLevelCount(uint32_t width, uint32_t height);
+	};
+
+}
+
+/// -------------------------------------------------------
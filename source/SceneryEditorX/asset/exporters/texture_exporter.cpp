@@ -10,3 +10,227 @@
 * Created: 10/8/2025
 * -------------------------------------------------------
 */
+#include "texture_exporter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include "bc_encoder.h"
+#include <SceneryEditorX/core/threading/thread_pool.h>
+#include <SceneryEditorX/logging/asserts.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		/// Tiles are 16x16 blocks (64x64 texels), small enough to balance well across workers.
+		constexpr uint32_t TILE_BLOCKS = 16;
+
+		using Clock = std::chrono::high_resolution_clock;
+
+		double ElapsedMs(const Clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		}
+
+		/// Gathers a 4x4 block, clamping reads past the right and bottom edges.
+		void GatherBlock(const uint8_t *rgba, const uint32_t width, const uint32_t height, const uint32_t bx, const uint32_t by, uint8_t (&block)[64])
+		{
+			for (uint32_t y = 0; y < 4; ++y)
+			{
+				const uint32_t sy = std::min(by * 4 + y, height - 1);
+				for (uint32_t x = 0; x < 4; ++x)
+				{
+					const uint32_t sx = std::min(bx * 4 + x, width - 1);
+					std::memcpy(block + (y * 4 + x) * 4, rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+				}
+			}
+		}
+
+		void EncodeBlock(const TextureCompression compression, const uint8_t *rgba, uint8_t *out)
+		{
+			switch (compression)
+			{
+				case TextureCompression::BC1: BCEncoder::EncodeBC1(rgba, out); break;
+				case TextureCompression::BC3: BCEncoder::EncodeBC3(rgba, out); break;
+				case TextureCompression::BC5: BCEncoder::EncodeBC5(rgba, out); break;
+				case TextureCompression::BC7: BCEncoder::EncodeBC7(rgba, out); break;
+				case TextureCompression::None: break;
+			}
+		}
+
+		void DecodeBlock(const TextureCompression compression, const uint8_t *block, uint8_t *rgba)
+		{
+			switch (compression)
+			{
+				case TextureCompression::BC1: BCEncoder::DecodeBC1(block, rgba); break;
+				case TextureCompression::BC3: BCEncoder::DecodeBC3(block, rgba); break;
+				case TextureCompression::BC5: BCEncoder::DecodeBC5(block, rgba); break;
+				case TextureCompression::BC7: BCEncoder::DecodeBC7(block, rgba); break;
+				case TextureCompression::None: break;
+			}
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	dds::DXGI_FORMAT TextureExporter::GetDXGIFormat(const TextureCompression compression, const bool sRGB)
+	{
+		switch (compression)
+		{
+			case TextureCompression::None: return sRGB ? dds::DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : dds::DXGI_FORMAT_R8G8B8A8_UNORM;
+			case TextureCompression::BC1:  return sRGB ? dds::DXGI_FORMAT_BC1_UNORM_SRGB : dds::DXGI_FORMAT_BC1_UNORM;
+			case TextureCompression::BC3:  return sRGB ? dds::DXGI_FORMAT_BC3_UNORM_SRGB : dds::DXGI_FORMAT_BC3_UNORM;
+			case TextureCompression::BC5:  return dds::DXGI_FORMAT_BC5_UNORM;
+			case TextureCompression::BC7:  return sRGB ? dds::DXGI_FORMAT_BC7_UNORM_SRGB : dds::DXGI_FORMAT_BC7_UNORM;
+		}
+		return dds::DXGI_FORMAT_UNKNOWN;
+	}
+
+	uint32_t TextureExporter::GetBlockBytes(const TextureCompression compression)
+	{
+		switch (compression)
+		{
+			case TextureCompression::BC1: return 8;
+			case TextureCompression::BC3:
+			case TextureCompression::BC5:
+			case TextureCompression::BC7: return 16;
+			case TextureCompression::None: return 0;
+		}
+		return 0;
+	}
+
+	std::vector<uint8_t> TextureExporter::CompressLevel(const uint8_t *rgba, const uint32_t width, const uint32_t height, const TextureCompression compression, ThreadPool &pool)
+	{
+		if (compression == TextureCompression::None)
+			return { rgba, rgba + static_cast<size_t>(width) * height * 4 };
+
+		const uint32_t blockBytes = GetBlockBytes(compression);
+		const uint32_t blocksX = (width + 3) / 4;
+		const uint32_t blocksY = (height + 3) / 4;
+		const uint32_t tilesX = (blocksX + TILE_BLOCKS - 1) / TILE_BLOCKS;
+		const uint32_t tilesY = (blocksY + TILE_BLOCKS - 1) / TILE_BLOCKS;
+
+		std::vector<uint8_t> output(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+		pool.ParallelFor(tilesX * tilesY, [&](const uint32_t tile)
+		{
+			const uint32_t tx = tile % tilesX;
+			const uint32_t ty = tile / tilesX;
+			const uint32_t bxEnd = std::min((tx + 1) * TILE_BLOCKS, blocksX);
+			const uint32_t byEnd = std::min((ty + 1) * TILE_BLOCKS, blocksY);
+
+			uint8_t block[64];
+			for (uint32_t by = ty * TILE_BLOCKS; by < byEnd; ++by)
+			{
+				for (uint32_t bx = tx * TILE_BLOCKS; bx < bxEnd; ++bx)
+				{
+					GatherBlock(rgba, width, height, bx, by, block);
+					EncodeBlock(compression, block, output.data() + (static_cast<size_t>(by) * blocksX + bx) * blockBytes);
+				}
+			}
+		});
+
+		return output;
+	}
+
+	std::vector<uint8_t> TextureExporter::DecompressLevel(const uint8_t *data, const uint32_t width, const uint32_t height, const TextureCompression compression)
+	{
+		if (compression == TextureCompression::None)
+			return { data, data + static_cast<size_t>(width) * height * 4 };
+
+		const uint32_t blockBytes = GetBlockBytes(compression);
+		const uint32_t blocksX = (width + 3) / 4;
+		const uint32_t blocksY = (height + 3) / 4;
+
+		std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+		uint8_t block[64];
+		for (uint32_t by = 0; by < blocksY; ++by)
+		{
+			for (uint32_t bx = 0; bx < blocksX; ++bx)
+			{
+				DecodeBlock(compression, data + (static_cast<size_t>(by) * blocksX + bx) * blockBytes, block);
+				for (uint32_t y = 0; y < 4 && by * 4 + y < height; ++y)
+				{
+					const uint32_t columns = std::min(4u, width - bx * 4);
+					std::memcpy(rgba.data() + ((static_cast<size_t>(by) * 4 + y) * width + bx * 4) * 4, block + y * 16, columns * 4);
+				}
+			}
+		}
+		return rgba;
+	}
+
+	std::vector<uint8_t> TextureExporter::EncodeDDS(const uint8_t *rgba, const uint32_t width, const uint32_t height, const TextureExportSettings &settings,
+	                                                TextureExportStats *stats, ThreadPool *pool)
+	{
+		if (!rgba || width == 0 || height == 0)
+			return {};
+
+		ThreadPool &workers = pool ? *pool : ThreadPool::Get();
+		const auto start = Clock::now();
+
+		/// Build the mip chain in linear float space.
+		MipSettings mipSettings = settings.mips;
+		if (!settings.generateMips)
+			mipSettings.maxLevels = 1;
+
+		std::vector<FloatImage> chain = MipGenerator::GenerateChain(MipGenerator::FromRGBA8(rgba, width, height, mipSettings), mipSettings, &workers);
+		const double mipMs = ElapsedMs(start);
+
+		/// Reserve the whole file up front so each level can be written at its dds::Header offset.
+		const auto levelCount = static_cast<uint32_t>(chain.size());
+		const dds::DXGI_FORMAT format = GetDXGIFormat(settings.compression, mipSettings.sRGB && !mipSettings.normalMap);
+
+		dds::Header header = {};
+		dds::write_header(&header, format, width, height, levelCount);
+		std::vector<uint8_t> file(header.data_offset() + header.data_size());
+		std::memcpy(file.data(), &header, sizeof(dds::Header));
+
+		const auto compressStart = Clock::now();
+		std::vector<uint8_t> levelRGBA;
+		for (uint32_t level = 0; level < levelCount; ++level)
+		{
+			const FloatImage &image = chain[level];
+			if (level == 0 && !mipSettings.normalMap)
+				levelRGBA.assign(rgba, rgba + static_cast<size_t>(width) * height * 4); ///< The top level is exact, skip the round trip.
+			else
+				MipGenerator::ToRGBA8(image, mipSettings, levelRGBA);
+
+			const std::vector<uint8_t> encoded = CompressLevel(levelRGBA.data(), image.width, image.height, settings.compression, workers);
+			SEDX_CORE_ASSERT(encoded.size() == header.mip_size(level));
+			std::memcpy(file.data() + header.mip_offset(level), encoded.data(), encoded.size());
+		}
+
+		if (stats)
+		{
+			stats->width = width;
+			stats->height = height;
+			stats->mipLevels = levelCount;
+			stats->outputBytes = file.size();
+			stats->mipMilliseconds = mipMs;
+			stats->compressMilliseconds = ElapsedMs(compressStart);
+			stats->totalMilliseconds = ElapsedMs(start);
+		}
+
+		return file;
+	}
+
+	bool TextureExporter::ExportDDS(const std::filesystem::path &path, const uint8_t *rgba, const uint32_t width, const uint32_t height,
+	                                const TextureExportSettings &settings, TextureExportStats *stats, ThreadPool *pool)
+	{
+		const std::vector<uint8_t> file = EncodeDDS(rgba, width, height, settings, stats, pool);
+		if (file.empty())
+			return false;
+
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		if (!stream)
+			return false;
+
+		stream.write(reinterpret_cast<const char *>(file.data()), static_cast<std::streamsize>(file.size()));
+		return stream.good();
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -2,7 +2,7 @@
 * -------------------------------------------------------
 * Scenery Editor X
 * -------------------------------------------------------
-* Copyright (c) 2025 Thomas Ray 
+* Copyright (c) 2025 Thomas Ray
 * Copyright (c) 2025 Coalition of Freeware Developers
 * -------------------------------------------------------
 * texture_exporter.h
@@ -10,3 +10,84 @@
 * Created: 10/8/2025
 * -------------------------------------------------------
 */
+#pragma once
+#include <filesystem>
+#include <vector>
+#include "mip_generator.h"
+#include "SceneryEditorX/renderer/dds.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	class ThreadPool;
+
+	/// Output encoding of an exported texture.
+	enum class TextureCompression : uint8_t
+	{
+		None = 0,	///< Uncompressed RGBA8
+		BC1,		///< Opaque colour (DXT1)
+		BC3,		///< Colour + smooth alpha (DXT5)
+		BC5,		///< Two channel, used for X-Plane normal maps
+		BC7			///< High quality RGBA
+	};
+
+	struct TextureExportSettings
+	{
+		TextureCompression compression = TextureCompression::BC7;
+		MipSettings mips;
+		bool generateMips = true;
+	};
+
+	struct TextureExportStats
+	{
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t mipLevels = 0;
+		uint64_t outputBytes = 0;
+		double mipMilliseconds = 0.0;
+		double compressMilliseconds = 0.0;
+		double totalMilliseconds = 0.0;
+	};
+
+	/**
+	 * @brief CPU texture processing pipeline: mip chain generation, block compression and DDS output.
+	 *
+	 * Input is decoded RGBA8 (e.g. from TextureImporter::ToBufferFromFile). Mips are filtered in
+	 * linear space on the pool, then each level is compressed in 64x64 texel tiles in parallel and
+	 * written after a DX10 header built with dds::write_header().
+	 */
+	class TextureExporter
+	{
+	public:
+		/**
+		 * @brief Encodes a complete DDS file into memory.
+		 * @param pool Worker pool to use; nullptr uses ThreadPool::Get().
+		 */
+		static std::vector<uint8_t> EncodeDDS(const uint8_t *rgba, uint32_t width, uint32_t height, const TextureExportSettings &settings,
+		                                      TextureExportStats *stats = nullptr, ThreadPool *pool = nullptr);
+
+		/**
+		 * @brief Encodes and writes a DDS file.
+		 * @return false if the input is empty or the file cannot be written.
+		 */
+		static bool ExportDDS(const std::filesystem::path &path, const uint8_t *rgba, uint32_t width, uint32_t height,
+		                      const TextureExportSettings &settings, TextureExportStats *stats = nullptr, ThreadPool *pool = nullptr);
+
+		/**
+		 * @brief Compresses a single RGBA8 level. Partial edge blocks are padded by clamping.
+		 */
+		static std::vector<uint8_t> CompressLevel(const uint8_t *rgba, uint32_t width, uint32_t height, TextureCompression compression, ThreadPool &pool);
+
+		/**
+		 * @brief Decodes a level produced by CompressLevel() back to RGBA8 (for verification and previews).
+		 */
+		static std::vector<uint8_t> DecompressLevel(const uint8_t *data, uint32_t width, uint32_t height, TextureCompression compression);
+
+		[[nodiscard]] static dds::DXGI_FORMAT GetDXGIFormat(TextureCompression compression, bool sRGB);
+		[[nodiscard]] static uint32_t GetBlockBytes(TextureCompression compression);
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,295 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* asset_reload_monitor.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "asset_reload_monitor.h"
+#include <algorithm>
+#include <deque>
+#include <ranges>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	AssetReloadMonitor::AssetReloadMonitor(std::unique_ptr<FileWatcher> watcher, const std::chrono::milliseconds debounce) :
+		m_Watcher(std::move(watcher)), m_Debounce(debounce)
+	{
+	}
+
+	std::string AssetReloadMonitor::MakeKey(const std::filesystem::path &path)
+	{
+		std::error_code ec;
+		const std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+		return (ec ? path : absolute).lexically_normal().string();
+	}
+
+	bool AssetReloadMonitor::WatchDirectory(const std::filesystem::path &directory)
+	{
+		std::lock_guard<std::mutex> lock(m_WatcherMutex);
+		return m_Watcher->AddDirectory(directory);
+	}
+
+	void AssetReloadMonitor::UnwatchDirectory(const std::filesystem::path &directory)
+	{
+		std::lock_guard<std::mutex> lock(m_WatcherMutex);
+		m_Watcher->RemoveDirectory(directory);
+	}
+
+	/// -------------------------------------------------------
+
+	void AssetReloadMonitor::TrackAsset(const AssetHandle handle, const std::filesystem::path &path)
+	{
+		std::string key = MakeKey(path);
+		std::lock_guard<std::mutex> lock(m_IndexMutex);
+		if (const auto it = m_AssetPaths.find(handle); it != m_AssetPaths.end())
+		{
+			if (const auto indexed = m_PathIndex.find(it->second); indexed != m_PathIndex.end() && indexed->second == handle)
+				m_PathIndex.erase(indexed);
+		}
+		m_PathIndex.insert_or_assign(key, handle);
+		m_AssetPaths.insert_or_assign(handle, std::move(key));
+	}
+
+	void AssetReloadMonitor::UntrackAsset(const AssetHandle handle)
+	{
+		std::lock_guard<std::mutex> lock(m_IndexMutex);
+		const auto it = m_AssetPaths.find(handle);
+		if (it == m_AssetPaths.end())
+			return;
+
+		if (const auto indexed = m_PathIndex.find(it->second); indexed != m_PathIndex.end() && indexed->second == handle)
+			m_PathIndex.erase(indexed);
+		m_AssetPaths.erase(it);
+	}
+
+	AssetHandle AssetReloadMonitor::FindAsset(const std::filesystem::path &path) const
+	{
+		const std::string key = MakeKey(path);
+		std::lock_guard<std::mutex> lock(m_IndexMutex);
+		const auto it = m_PathIndex.find(key);
+		return it != m_PathIndex.end() ? it->second : AssetHandle(0);
+	}
+
+	size_t AssetReloadMonitor::GetTrackedAssetCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_IndexMutex);
+		return m_AssetPaths.size();
+	}
+
+	void AssetReloadMonitor::RegisterDependency(const AssetHandle dependency, const AssetHandle dependent)
+	{
+		std::lock_guard<std::mutex> lock(m_IndexMutex);
+		m_Dependents[dependency].insert(dependent);
+		m_Dependencies[dependent].insert(dependency);
+	}
+
+	void AssetReloadMonitor::DeregisterDependency(const AssetHandle dependency, const AssetHandle dependent)
+	{
+		std::lock_guard<std::mutex> lock(m_IndexMutex);
+		if (const auto it = m_Dependents.find(dependency); it != m_Dependents.end())
+		{
+			it->second.erase(dependent);
+			if (it->second.empty())
+				m_Dependents.erase(it);
+		}
+		if (const auto it = m_Dependencies.find(dependent); it != m_Dependencies.end())
+		{
+			it->second.erase(dependency);
+			if (it->second.empty())
+				m_Dependencies.erase(it);
+		}
+	}
+
+	void AssetReloadMonitor::DeregisterDependencies(const AssetHandle handle)
+	{
+		std::lock_guard<std::mutex> lock(m_IndexMutex);
+		const auto it = m_Dependencies.find(handle);
+		if (it == m_Dependencies.end())
+			return;
+
+		for (const AssetHandle &dependency : it->second)
+		{
+			if (const auto dependents = m_Dependents.find(dependency); dependents != m_Dependents.end())
+			{
+				dependents->second.erase(handle);
+				if (dependents->second.empty())
+					m_Dependents.erase(dependents);
+			}
+		}
+		m_Dependencies.erase(it);
+	}
+
+	/// -------------------------------------------------------
+
+	size_t AssetReloadMonitor::Update(std::vector<AssetReloadRequest> &requests, const std::chrono::milliseconds wait)
+	{
+		std::lock_guard<std::mutex> lock(m_WatcherMutex);
+
+		// With changes pending, only wait until the oldest of them has settled
+		std::chrono::milliseconds timeout = wait;
+		if (!m_Pending.empty())
+		{
+			Clock::time_point due = Clock::time_point::max();
+			for (const PendingChange &change : m_Pending | std::views::values)
+				due = std::min(due, change.Last + m_Debounce);
+			const auto untilDue = std::chrono::ceil<std::chrono::milliseconds>(due - Clock::now());
+			timeout = std::clamp(untilDue, std::chrono::milliseconds(0), wait);
+		}
+
+		m_Events.clear();
+		if (m_Watcher->Poll(m_Events, timeout) > 0)
+			Collect(m_Events);
+
+		const Clock::time_point now = Clock::now();
+		std::vector<std::pair<std::string, PendingChange>> settled;
+		for (auto it = m_Pending.begin(); it != m_Pending.end();)
+		{
+			if (now - it->second.Last >= m_Debounce)
+			{
+				settled.emplace_back(it->first, it->second);
+				it = m_Pending.erase(it);
+			}
+			else
+				++it;
+		}
+
+		const size_t before = requests.size();
+		if (!settled.empty())
+			Resolve(settled, now, requests);
+		return requests.size() - before;
+	}
+
+	bool AssetReloadMonitor::HasPendingChanges() const
+	{
+		std::lock_guard<std::mutex> lock(m_WatcherMutex);
+		return !m_Pending.empty();
+	}
+
+	void AssetReloadMonitor::Collect(const std::vector<FileChangeEvent> &events)
+	{
+		uint64_t coalesced = 0;
+		for (const FileChangeEvent &event : events)
+		{
+			const bool overflow = event.Type == FileChangeType::Overflow;
+			auto [it, inserted] = m_Pending.try_emplace(MakeKey(event.Path), PendingChange{ event.Time, event.Time });
+			PendingChange &change = it->second;
+			if (!inserted)
+				++coalesced;
+
+			// The last event decides: a delete followed by a create is an atomic save, not a removal
+			change.Last = std::max(change.Last, event.Time);
+			change.Removed = event.Type == FileChangeType::Removed;
+			change.Overflow |= overflow;
+		}
+
+		std::lock_guard<std::mutex> lock(m_StatsMutex);
+		m_Stats.fileEvents += events.size();
+		m_Stats.coalescedEvents += coalesced;
+	}
+
+	void AssetReloadMonitor::Resolve(const std::vector<std::pair<std::string, PendingChange>> &settled, const Clock::time_point now,
+	                                 std::vector<AssetReloadRequest> &requests)
+	{
+		const size_t first = requests.size();
+		uint64_t unindexed = 0;
+		uint64_t overflows = 0;
+		uint64_t dependents = 0;
+
+		std::lock_guard<std::mutex> lock(m_IndexMutex);
+		std::unordered_set<AssetHandle> queued;
+
+		const auto enqueue = [&](const AssetHandle &handle, const AssetReloadReason reason, const Clock::time_point eventTime)
+		{
+			if (queued.insert(handle).second)
+				requests.push_back({ handle, reason, eventTime });
+		};
+
+		for (const auto &[key, change] : settled)
+		{
+			if (change.Overflow)
+			{
+				// Events were lost, so every tracked file below the root may have changed
+				++overflows;
+				for (const auto &[path, handle] : m_PathIndex)
+				{
+					if (path.size() > key.size() && path.starts_with(key) && path[key.size()] == std::filesystem::path::preferred_separator)
+					{
+						std::error_code ec;
+						const bool exists = std::filesystem::exists(path, ec);
+						enqueue(handle, exists ? AssetReloadReason::FileChanged : AssetReloadReason::FileRemoved, change.First);
+					}
+				}
+				continue;
+			}
+
+			const auto it = m_PathIndex.find(key);
+			if (it == m_PathIndex.end())
+			{
+				++unindexed;
+				continue;
+			}
+			enqueue(it->second, change.Removed ? AssetReloadReason::FileRemoved : AssetReloadReason::FileChanged, change.First);
+		}
+
+		const size_t directEnd = requests.size();
+
+		// Breadth first, so an asset is reloaded after whatever it depends on at a shallower level
+		std::deque<size_t> open;
+		for (size_t i = first; i < directEnd; ++i)
+			open.push_back(i);
+		while (!open.empty())
+		{
+			const AssetHandle handle = requests[open.front()].Handle;
+			const Clock::time_point eventTime = requests[open.front()].EventTime;
+			open.pop_front();
+
+			const auto it = m_Dependents.find(handle);
+			if (it == m_Dependents.end())
+				continue;
+
+			for (const AssetHandle &dependent : it->second)
+			{
+				const size_t count = requests.size();
+				enqueue(dependent, AssetReloadReason::Dependency, eventTime);
+				if (requests.size() != count)
+				{
+					++dependents;
+					open.push_back(count);
+				}
+			}
+		}
+
+		std::lock_guard<std::mutex> statsLock(m_StatsMutex);
+		m_Stats.unindexedChanges += unindexed;
+		m_Stats.overflows += overflows;
+		m_Stats.reloadsQueued += requests.size() - first;
+		m_Stats.dependentReloads += dependents;
+		for (size_t i = first; i < directEnd; ++i)
+		{
+			const double latencyMs = std::chrono::duration<double, std::milli>(now - requests[i].EventTime).count();
+			m_Stats.lastLatencyMs = latencyMs;
+			m_Stats.maxLatencyMs = std::max(m_Stats.maxLatencyMs, latencyMs);
+			m_LatencySumMs += latencyMs;
+			++m_LatencySamples;
+		}
+		if (m_LatencySamples > 0)
+			m_Stats.averageLatencyMs = m_LatencySumMs / static_cast<double>(m_LatencySamples);
+	}
+
+	AssetReloadStats AssetReloadMonitor::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_StatsMutex);
+		return m_Stats;
+	}
+
+} // namespace SceneryEditorX
+
+/// -------------------------------------------------------
@@ -0,0 +1,156 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* asset_reload_monitor.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "SceneryEditorX/core/identifiers/uuid.h"
+#include "SceneryEditorX/platform/filesystem/file_watcher.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	using AssetHandle = UUID;
+
+	enum class AssetReloadReason : uint8_t
+	{
+		FileChanged,	///< The asset's own file was written or replaced
+		FileRemoved,	///< The asset's file is gone; the owner decides whether to keep the loaded copy
+		Dependency		///< An asset this one depends on is being reloaded
+	};
+
+	struct AssetReloadRequest
+	{
+		AssetHandle Handle{ 0 };
+		AssetReloadReason Reason = AssetReloadReason::FileChanged;
+		std::chrono::steady_clock::time_point EventTime;	///< First file event of the burst that caused the reload
+	};
+
+	struct AssetReloadStats
+	{
+		uint64_t fileEvents = 0;		///< Raw events from the watcher
+		uint64_t coalescedEvents = 0;	///< Events folded into a change that was already pending
+		uint64_t unindexedChanges = 0;	///< Settled changes to files no tracked asset uses
+		uint64_t overflows = 0;			///< Times the watcher lost events and a root was rescanned
+		uint64_t reloadsQueued = 0;
+		uint64_t dependentReloads = 0;	///< Part of reloadsQueued that came through dependencies
+		double lastLatencyMs = 0.0;		///< First file event to reload request, debounce included
+		double averageLatencyMs = 0.0;
+		double maxLatencyMs = 0.0;
+	};
+
+	/**
+	 * @class AssetReloadMonitor
+	 * @brief Turns file changes below the asset directories into targeted asset reloads.
+	 *
+	 * The monitor owns a FileWatcher on the project's asset directory and any scenery packs
+	 * it references, and a path index from file to AssetHandle. Events for the same file
+	 * are coalesced and only handed out once the file has been quiet for the debounce time,
+	 * so a save that arrives as create, several writes and a close, or as a rename over the
+	 * old file, reloads the asset once. Each changed asset is followed by the assets that
+	 * registered a dependency on it, transitively, and nothing else is touched.
+	 *
+	 * Update() is meant to be called from the asset thread; the index and dependency
+	 * functions may be called from any thread.
+	 */
+	class AssetReloadMonitor
+	{
+	public:
+		explicit AssetReloadMonitor(std::unique_ptr<FileWatcher> watcher = FileWatcher::Create(),
+		                            std::chrono::milliseconds debounce = std::chrono::milliseconds(100));
+
+		AssetReloadMonitor(const AssetReloadMonitor &) = delete;
+		AssetReloadMonitor &operator=(const AssetReloadMonitor &) = delete;
+
+		/// Watches an asset directory or scenery pack, recursively.
+		bool WatchDirectory(const std::filesystem::path &directory);
+		void UnwatchDirectory(const std::filesystem::path &directory);
+
+		/// Maps @p path to @p handle, replacing any path the asset had before.
+		void TrackAsset(AssetHandle handle, const std::filesystem::path &path);
+		void UntrackAsset(AssetHandle handle);
+		/// Returns the asset using @p path, or a null handle.
+		[[nodiscard]] AssetHandle FindAsset(const std::filesystem::path &path) const;
+		/// Number of assets with a tracked path.
+		[[nodiscard]] size_t GetTrackedAssetCount() const;
+
+		/// @p dependent is reloaded whenever @p dependency is.
+		void RegisterDependency(AssetHandle dependency, AssetHandle dependent);
+		void DeregisterDependency(AssetHandle dependency, AssetHandle dependent);
+		/// Removes every dependency @p handle has; assets depending on it keep theirs.
+		void DeregisterDependencies(AssetHandle handle);
+
+		/**
+		 * @brief Collects file events and appends the reloads whose changes have settled.
+		 *
+		 * Changed assets come before their dependents, and every handle appears at most once
+		 * per call. Changes still inside the debounce window stay pending for a later call.
+		 *
+		 * @param wait How long to block for the first file event if nothing is pending.
+		 * @return Number of requests appended.
+		 */
+		size_t Update(std::vector<AssetReloadRequest> &requests, std::chrono::milliseconds wait = {});
+
+		/// Whether changes are waiting out the debounce time.
+		[[nodiscard]] bool HasPendingChanges() const;
+
+		[[nodiscard]] AssetReloadStats GetStats() const;
+		[[nodiscard]] const char *GetBackendName() const { return m_Watcher->GetBackendName(); }
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		struct PendingChange
+		{
+			Clock::time_point First;
+			Clock::time_point Last;
+			bool Removed = false;
+			bool Overflow = false;
+		};
+
+		static std::string MakeKey(const std::filesystem::path &path);
+		void Collect(const std::vector<FileChangeEvent> &events);
+		void Resolve(const std::vector<std::pair<std::string, PendingChange>> &settled, Clock::time_point now,
+		             std::vector<AssetReloadRequest> &requests);
+
+		std::unique_ptr<FileWatcher> m_Watcher;
+		std::chrono::milliseconds m_Debounce;
+
+		// Watcher and pending changes; only Update() and the watch functions touch these
+		std::unordered_map<std::string, PendingChange> m_Pending;
+		std::vector<FileChangeEvent> m_Events;
+		mutable std::mutex m_WatcherMutex;
+
+		// Path index and dependency graph
+		std::unordered_map<std::string, AssetHandle> m_PathIndex;
+		std::unordered_map<AssetHandle, std::string> m_AssetPaths;
+		std::unordered_map<AssetHandle, std::unordered_set<AssetHandle>> m_Dependents;   ///< Asset handle -> assets that depend on it
+		std::unordered_map<AssetHandle, std::unordered_set<AssetHandle>> m_Dependencies; ///< Asset handle -> assets that it depends on
+		mutable std::mutex m_IndexMutex;
+
+		AssetReloadStats m_Stats;
+		double m_LatencySumMs = 0.0;
+		uint64_t m_LatencySamples = 0;
+		mutable std::mutex m_StatsMutex;
+	};
+
+} // namespace SceneryEditorX
+
+/// -------------------------------------------------------
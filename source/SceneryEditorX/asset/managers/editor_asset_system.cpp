@@ -46,7 +46,29 @@ namespace SceneryEditorX
 	void EditorAssetSystem::AssetMonitorUpdate()
 	{
 		Timer timer;
-		EnsureAllLoadedCurrent();
+
+		/// Nothing registers asset paths with the monitor yet, so fall back to the full timestamp sweep until something does.
+		if (m_ReloadMonitor.GetTrackedAssetCount() == 0)
+		{
+			EnsureAllLoadedCurrent();
+			m_AssetUpdatePerf = timer.ElapsedMillis();
+			return;
+		}
+
+		/// Only assets whose files changed, and the assets depending on them, are queued.
+		m_ReloadRequests.clear();
+		m_ReloadMonitor.Update(m_ReloadRequests);
+		for (const AssetReloadRequest &request : m_ReloadRequests)
+		{
+			/// Keep what is loaded when the file disappears; the asset manager reports it as missing
+			if (request.Reason == AssetReloadReason::FileRemoved)
+				continue;
+
+			auto metadata = Project::GetEditorAssetManager()->GetMetadata(request.Handle);
+			if (metadata.IsValid())
+				QueueAssetLoad(metadata);
+		}
+
 		m_AssetUpdatePerf = timer.ElapsedMillis();
 	}
 
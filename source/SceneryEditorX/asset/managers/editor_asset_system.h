@@ -16,6 +16,7 @@
 #include <queue>
 #include "SceneryEditorX/asset/asset.h"
 #include "SceneryEditorX/asset/asset_metadata.h"
+#include "SceneryEditorX/asset/managers/asset_reload_monitor.h"
 #include "SceneryEditorX/core/threading/thread.h"
 
 /// -------------------------------------------------------
@@ -50,6 +51,9 @@ namespace SceneryEditorX
 		/// Monitor for updated assets, and if any are found queue them for reload
 		void AssetMonitorUpdate();
 
+		/// Path index, dependency graph and file watcher that drive AssetMonitorUpdate()
+		AssetReloadMonitor &GetReloadMonitor() { return m_ReloadMonitor; }
+
 	private:
 		/// The asset thread's mainline
 		void AssetThreadFunc();
@@ -75,6 +79,8 @@ namespace SceneryEditorX
 		std::mutex m_AMLoadedAssetsMutex;
 
 		/// Asset Monitoring
+		AssetReloadMonitor m_ReloadMonitor;
+		std::vector<AssetReloadRequest> m_ReloadRequests;
 		float m_AssetUpdatePerf = 0.0f;
 	};
 
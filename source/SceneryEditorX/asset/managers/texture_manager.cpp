@@ -37,6 +37,31 @@ namespace SceneryEditorX
 	    }
 	}
 
+	TextureResidencyManager::TextureID TextureManager::StreamTexture(const std::string &path)
+	{
+	    if (const auto it = streamedTextures.find(path); it != streamedTextures.end())
+	        return it->second;
+	
+	    const TextureResidencyManager::TextureID id = residency.Register(path);
+	    if (id == TextureResidencyManager::InvalidTexture)
+	    {
+	        SEDX_CORE_WARN_TAG("Texture", "Unable to stream texture: {}", path);
+	        return id;
+	    }
+	
+	    streamedTextures[path] = id;
+	    return id;
+	}
+	
+	void TextureManager::ReleaseStreamedTexture(const std::string &path)
+	{
+	    if (const auto it = streamedTextures.find(path); it != streamedTextures.end())
+	    {
+	        residency.Unregister(it->second);
+	        streamedTextures.erase(it);
+	    }
+	}
+
 
 }
 
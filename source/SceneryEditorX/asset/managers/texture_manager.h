@@ -14,6 +14,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include "texture_residency.h"
 #include "SceneryEditorX/scene/texture.h"
 
 /// -------------------------------------------------------
@@ -30,8 +31,23 @@ namespace SceneryEditorX
 	    std::shared_ptr<TextureAsset> LoadTexture(const std::string &path);
 	    void UnloadTexture(const std::string &path);
 	
+	    /**
+	     * @brief Registers a DDS file for progressive mip streaming.
+	     *
+	     * Only the header and mip tail are read here; finer levels follow on demand through GetResidency().
+	     */
+	    TextureResidencyManager::TextureID StreamTexture(const std::string &path);
+	    void ReleaseStreamedTexture(const std::string &path);
+	
+	    /// Call once per frame after the renderer has reported texture coverage.
+	    void Update() { residency.Update(); }
+	
+	    TextureResidencyManager &GetResidency() { return residency; }
+	
 	private:
 	    std::unordered_map<std::string, std::shared_ptr<TextureAsset>> textures;
+	    std::unordered_map<std::string, TextureResidencyManager::TextureID> streamedTextures;
+	    TextureResidencyManager residency;
 	};
 	
 }
@@ -0,0 +1,499 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* texture_residency.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "texture_residency.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	uint64_t FileTextureStreamSource::GetFileSize(const std::filesystem::path &path)
+	{
+		std::error_code error;
+		const auto size = std::filesystem::file_size(path, error);
+		return error ? 0 : static_cast<uint64_t>(size);
+	}
+
+	bool FileTextureStreamSource::Read(const std::filesystem::path &path, const uint64_t offset, const uint64_t size, uint8_t *dst)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream)
+			return false;
+
+		stream.seekg(static_cast<std::streamoff>(offset));
+		stream.read(reinterpret_cast<char *>(dst), static_cast<std::streamsize>(size));
+		return stream.gcount() == static_cast<std::streamsize>(size);
+	}
+
+	/// -------------------------------------------------------
+
+	TextureResidencyManager::TextureResidencyManager(const TextureResidencySettings &settings, std::shared_ptr<TextureStreamSource> source, ThreadPool *pool)
+		: m_Settings(settings), m_Source(std::move(source)), m_Pool(pool)
+	{
+		if (!m_Source)
+			m_Source = std::make_shared<FileTextureStreamSource>();
+		if (!m_Pool && m_Settings.asyncIO)
+			m_Pool = &ThreadPool::Get();
+
+		m_Settings.maxInFlight = std::max(m_Settings.maxInFlight, 1u);
+		m_Stats.budgetBytes = m_Settings.budgetBytes;
+	}
+
+	TextureResidencyManager::~TextureResidencyManager()
+	{
+		/// Workers write into the pending records, they must finish before the records are freed.
+		for (const auto &pending : m_Pending)
+		{
+			if (pending->done.valid())
+				pending->done.wait();
+		}
+	}
+
+	uint32_t TextureResidencyManager::ComputeDesiredMip(const uint32_t width, const uint32_t height, const float screenPixels, const uint32_t mipCount, const float lodBias)
+	{
+		if (mipCount == 0)
+			return 0;
+		if (screenPixels <= 0.0f)
+			return mipCount - 1;
+
+		/// Round towards the finer level so the texture is never magnified.
+		const float largest = static_cast<float>(std::max(width, height));
+		const float lod = std::log2(largest / screenPixels) + lodBias;
+		if (lod <= 0.0f)
+			return 0;
+
+		return std::min(static_cast<uint32_t>(lod), mipCount - 1);
+	}
+
+	/// -------------------------------------------------------
+
+	TextureResidencyManager::TextureID TextureResidencyManager::Register(const std::filesystem::path &path)
+	{
+		const uint64_t fileSize = m_Source->GetFileSize(path);
+		if (fileSize < sizeof(dds::Header::magic) + sizeof(dds::DDS_HEADER))
+			return InvalidTexture;
+
+		uint8_t headerBytes[sizeof(dds::Header)] = {};
+		const uint64_t headerSize = std::min<uint64_t>(sizeof(dds::Header), fileSize);
+		if (!m_Source->Read(path, 0, headerSize, headerBytes))
+			return InvalidTexture;
+
+		StreamedTexture texture;
+		texture.header = dds::read_header(headerBytes, headerSize);
+		if (!texture.header.is_valid() || texture.header.data_offset() + texture.header.data_size() > fileSize)
+			return InvalidTexture;
+
+		const dds::Header &header = texture.header;
+		texture.path = path;
+		texture.mipCount = header.mip_levels();
+		texture.streamable = header.array_size() == 1 && !header.is_cubemap() && !header.is_3d();
+		texture.mips.resize(texture.mipCount);
+
+		uint64_t tailOffset = header.data_offset();
+		uint64_t tailSize = header.data_size();
+		if (texture.streamable)
+		{
+			texture.tailMip = texture.mipCount - 1;
+			for (uint32_t mip = 0; mip < texture.mipCount; ++mip)
+			{
+				if (std::max(header.width() >> mip, 1u) <= m_Settings.tailDimension && std::max(header.height() >> mip, 1u) <= m_Settings.tailDimension)
+				{
+					texture.tailMip = mip;
+					break;
+				}
+			}
+			tailOffset = header.mip_offset(texture.tailMip);
+			tailSize = header.data_offset() + header.slice_size() - tailOffset;
+		}
+
+		/// The tail levels are contiguous at the end of the slice, one read covers all of them.
+		std::vector<uint8_t> tail(tailSize);
+		if (!m_Source->Read(path, tailOffset, tailSize, tail.data()))
+			return InvalidTexture;
+
+		m_Stats.bytesRead += headerSize + tailSize;
+
+		TextureID id;
+		if (!m_FreeSlots.empty())
+		{
+			id = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+			texture.generation = m_Textures[id].generation + 1;
+		}
+		else
+		{
+			id = static_cast<TextureID>(m_Textures.size());
+			m_Textures.emplace_back();
+		}
+
+		texture.residentMip = texture.tailMip;
+		texture.desiredMip = texture.tailMip;
+		texture.lastUsedFrame = m_Frame;
+		texture.active = true;
+
+		if (texture.streamable)
+		{
+			const uint8_t *cursor = tail.data();
+			for (uint32_t mip = texture.tailMip; mip < texture.mipCount; ++mip)
+			{
+				const uint64_t size = header.mip_size(mip);
+				AddResident(texture, mip, std::vector<uint8_t>(cursor, cursor + size));
+				cursor += size;
+			}
+		}
+		else
+		{
+			AddResident(texture, 0, std::move(tail));
+		}
+
+		m_Textures[id] = std::move(texture);
+		m_EvictionOrderValid = false;
+		++m_Stats.textureCount;
+
+		if (m_OnResident)
+			m_OnResident(id, m_Textures[id].residentMip);
+
+		return id;
+	}
+
+	void TextureResidencyManager::Unregister(const TextureID id)
+	{
+		StreamedTexture *texture = Find(id);
+		if (!texture)
+			return;
+
+		/// A read still in flight is discarded by the generation check when it completes.
+		m_Stats.residentBytes -= texture->residentBytes;
+		texture->mips.clear();
+		texture->residentBytes = 0;
+		texture->pendingMip = NoMip;
+		texture->active = false;
+		texture->path.clear();
+
+		m_FreeSlots.push_back(id);
+		m_EvictionOrderValid = false;
+		--m_Stats.textureCount;
+	}
+
+	void TextureResidencyManager::RequestCoverage(const TextureID id, const float screenPixels)
+	{
+		if (const StreamedTexture *texture = Find(id))
+			RequestMip(id, ComputeDesiredMip(texture->header.width(), texture->header.height(), screenPixels, texture->mipCount, m_Settings.lodBias));
+	}
+
+	void TextureResidencyManager::RequestMip(const TextureID id, const uint32_t mip)
+	{
+		StreamedTexture *texture = Find(id);
+		if (!texture)
+			return;
+
+		texture->frameRequestMip = std::min(texture->frameRequestMip, mip);
+		texture->lastUsedFrame = m_Frame;
+	}
+
+	void TextureResidencyManager::SetBudget(const uint64_t budgetBytes)
+	{
+		m_Settings.budgetBytes = budgetBytes;
+		m_Stats.budgetBytes = budgetBytes;
+	}
+
+	/// -------------------------------------------------------
+
+	void TextureResidencyManager::Update()
+	{
+		m_EvictionOrderValid = false;
+
+		CollectReads(false);
+		RefreshDemand();
+
+		/// Shrinking the budget (or registering large tails) may have left us over it.
+		if (m_Stats.residentBytes + m_Stats.inFlightBytes > m_Settings.budgetBytes)
+			EnsureBudget(0, InvalidTexture);
+
+		if (m_Pending.size() < m_Settings.maxInFlight)
+		{
+			std::vector<TextureID> candidates;
+			for (TextureID id = 0; id < m_Textures.size(); ++id)
+			{
+				const StreamedTexture &texture = m_Textures[id];
+				if (texture.active && texture.streamable && !texture.failed && texture.pendingMip == NoMip && texture.residentMip > texture.desiredMip)
+					candidates.push_back(id);
+			}
+
+			/// Most recently used first, then the textures that are furthest from what they need.
+			std::sort(candidates.begin(), candidates.end(), [this](const TextureID a, const TextureID b) {
+				const StreamedTexture &ta = m_Textures[a];
+				const StreamedTexture &tb = m_Textures[b];
+				if (ta.lastUsedFrame != tb.lastUsedFrame)
+					return ta.lastUsedFrame > tb.lastUsedFrame;
+				const uint32_t deficitA = ta.residentMip - ta.desiredMip;
+				const uint32_t deficitB = tb.residentMip - tb.desiredMip;
+				if (deficitA != deficitB)
+					return deficitA > deficitB;
+				return a < b;
+			});
+
+			for (const TextureID id : candidates)
+			{
+				if (m_Pending.size() >= m_Settings.maxInFlight)
+					break;
+
+				StreamedTexture &texture = m_Textures[id];
+				if (!EnsureBudget(texture.header.mip_size(texture.residentMip - 1), id))
+					continue;
+
+				IssueRead(id, texture);
+			}
+		}
+
+		m_Stats.pendingRequests = static_cast<uint32_t>(m_Pending.size());
+		++m_Frame;
+	}
+
+	void TextureResidencyManager::Flush()
+	{
+		CollectReads(true);
+		m_Stats.pendingRequests = 0;
+	}
+
+	void TextureResidencyManager::RefreshDemand()
+	{
+		for (StreamedTexture &texture : m_Textures)
+		{
+			if (!texture.active || !texture.streamable)
+				continue;
+
+			if (texture.frameRequestMip != NoMip)
+			{
+				texture.desiredMip = std::min(texture.frameRequestMip, texture.tailMip);
+				texture.frameRequestMip = NoMip;
+			}
+			else if (m_Frame - texture.lastUsedFrame > m_Settings.idleFrames)
+			{
+				texture.desiredMip = texture.tailMip;
+			}
+		}
+	}
+
+	bool TextureResidencyManager::EnsureBudget(const uint64_t bytes, const TextureID requester)
+	{
+		const auto fits = [&]() { return m_Stats.residentBytes + m_Stats.inFlightBytes + bytes <= m_Settings.budgetBytes; };
+		if (fits())
+			return true;
+
+		if (!m_EvictionOrderValid)
+		{
+			m_EvictionOrder.clear();
+			for (TextureID id = 0; id < m_Textures.size(); ++id)
+			{
+				if (m_Textures[id].active && m_Textures[id].streamable)
+					m_EvictionOrder.push_back(id);
+			}
+			std::stable_sort(m_EvictionOrder.begin(), m_EvictionOrder.end(), [this](const TextureID a, const TextureID b) {
+				return m_Textures[a].lastUsedFrame < m_Textures[b].lastUsedFrame;
+			});
+			m_EvictionOrderValid = true;
+		}
+
+		/// Budget enforcement without a requester may evict anything, a read may only evict older textures.
+		const uint64_t requesterFrame = requester == InvalidTexture ? std::numeric_limits<uint64_t>::max() : m_Textures[requester].lastUsedFrame;
+
+		/// First pass drops detail nobody currently wants, the second falls back to least recently used.
+		for (const TextureID id : m_EvictionOrder)
+		{
+			StreamedTexture &texture = m_Textures[id];
+			while (id != requester && texture.pendingMip == NoMip && texture.residentMip < texture.desiredMip && !fits())
+				EvictLevel(texture);
+			if (fits())
+				return true;
+		}
+
+		for (const TextureID id : m_EvictionOrder)
+		{
+			StreamedTexture &texture = m_Textures[id];
+			if (id == requester || texture.pendingMip != NoMip || texture.lastUsedFrame >= requesterFrame)
+				continue;
+
+			while (texture.residentMip < texture.tailMip && !fits())
+				EvictLevel(texture);
+			if (fits())
+				return true;
+		}
+
+		return fits();
+	}
+
+	void TextureResidencyManager::EvictLevel(StreamedTexture &texture)
+	{
+		std::vector<uint8_t> &level = texture.mips[texture.residentMip];
+		const uint64_t size = level.size();
+
+		level.clear();
+		level.shrink_to_fit();
+		texture.residentBytes -= size;
+		++texture.residentMip;
+
+		m_Stats.residentBytes -= size;
+		m_Stats.evictedBytes += size;
+		++m_Stats.evictions;
+	}
+
+	void TextureResidencyManager::IssueRead(const TextureID id, StreamedTexture &texture)
+	{
+		auto pending = std::make_unique<PendingRead>();
+		pending->id = id;
+		pending->generation = texture.generation;
+		pending->mip = texture.residentMip - 1;
+		pending->data.resize(texture.header.mip_size(pending->mip));
+		pending->issued = std::chrono::steady_clock::now();
+
+		const uint64_t offset = texture.header.mip_offset(pending->mip);
+		const uint64_t size = pending->data.size();
+		uint8_t *dst = pending->data.data();
+
+		if (m_Pool)
+		{
+			pending->done = m_Pool->Submit([source = m_Source, path = texture.path, offset, size, dst]() { return source->Read(path, offset, size, dst); });
+		}
+		else
+		{
+			std::promise<bool> result;
+			result.set_value(m_Source->Read(texture.path, offset, size, dst));
+			pending->done = result.get_future();
+		}
+
+		texture.pendingMip = pending->mip;
+		m_Stats.inFlightBytes += size;
+		m_Pending.push_back(std::move(pending));
+	}
+
+	void TextureResidencyManager::CollectReads(const bool wait)
+	{
+		size_t kept = 0;
+		for (size_t i = 0; i < m_Pending.size(); ++i)
+		{
+			std::unique_ptr<PendingRead> &pending = m_Pending[i];
+			if (!wait && pending->done.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				if (kept != i)
+					m_Pending[kept] = std::move(pending);
+				++kept;
+				continue;
+			}
+
+			const bool ok = pending->done.get();
+			const uint64_t size = pending->data.size();
+			m_Stats.inFlightBytes -= size;
+
+			StreamedTexture *texture = Find(pending->id);
+			if (!texture || texture->generation != pending->generation || texture->pendingMip != pending->mip)
+				continue;
+
+			texture->pendingMip = NoMip;
+			if (!ok)
+			{
+				/// Leave the texture at its current detail rather than retrying every frame.
+				texture->failed = true;
+				++m_Stats.failedRequests;
+				continue;
+			}
+
+			const double latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pending->issued).count();
+			m_Stats.lastLatencyMs = latency;
+			m_Stats.maxLatencyMs = std::max(m_Stats.maxLatencyMs, latency);
+			m_TotalLatencyMs += latency;
+			++m_Stats.completedRequests;
+			m_Stats.averageLatencyMs = m_TotalLatencyMs / static_cast<double>(m_Stats.completedRequests);
+			m_Stats.bytesRead += size;
+
+			AddResident(*texture, pending->mip, std::move(pending->data));
+			if (m_OnResident)
+				m_OnResident(pending->id, texture->residentMip);
+		}
+		m_Pending.resize(kept);
+	}
+
+	void TextureResidencyManager::AddResident(StreamedTexture &texture, const uint32_t mip, std::vector<uint8_t> data)
+	{
+		const uint64_t size = data.size();
+		texture.mips[mip] = std::move(data);
+		texture.residentMip = std::min(texture.residentMip, mip);
+		texture.residentBytes += size;
+
+		m_Stats.residentBytes += size;
+		m_Stats.peakResidentBytes = std::max(m_Stats.peakResidentBytes, m_Stats.residentBytes);
+	}
+
+	/// -------------------------------------------------------
+
+	TextureResidencyManager::StreamedTexture *TextureResidencyManager::Find(const TextureID id)
+	{
+		return id < m_Textures.size() && m_Textures[id].active ? &m_Textures[id] : nullptr;
+	}
+
+	const TextureResidencyManager::StreamedTexture *TextureResidencyManager::Find(const TextureID id) const
+	{
+		return id < m_Textures.size() && m_Textures[id].active ? &m_Textures[id] : nullptr;
+	}
+
+	bool TextureResidencyManager::IsValid(const TextureID id) const
+	{
+		return Find(id) != nullptr;
+	}
+
+	uint32_t TextureResidencyManager::GetResidentMip(const TextureID id) const
+	{
+		const StreamedTexture *texture = Find(id);
+		return texture ? texture->residentMip : 0;
+	}
+
+	uint32_t TextureResidencyManager::GetDesiredMip(const TextureID id) const
+	{
+		const StreamedTexture *texture = Find(id);
+		return texture ? texture->desiredMip : 0;
+	}
+
+	uint32_t TextureResidencyManager::GetTailMip(const TextureID id) const
+	{
+		const StreamedTexture *texture = Find(id);
+		return texture ? texture->tailMip : 0;
+	}
+
+	uint32_t TextureResidencyManager::GetMipCount(const TextureID id) const
+	{
+		const StreamedTexture *texture = Find(id);
+		return texture ? texture->mipCount : 0;
+	}
+
+	const dds::Header *TextureResidencyManager::GetHeader(const TextureID id) const
+	{
+		const StreamedTexture *texture = Find(id);
+		return texture ? &texture->header : nullptr;
+	}
+
+	const std::vector<uint8_t> *TextureResidencyManager::GetMipData(const TextureID id, const uint32_t mip) const
+	{
+		const StreamedTexture *texture = Find(id);
+		if (!texture || mip >= texture->mips.size() || mip < texture->residentMip)
+			return nullptr;
+		return &texture->mips[mip];
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,223 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* texture_residency.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+#include "SceneryEditorX/renderer/dds.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	class ThreadPool;
+
+	/**
+	 * @brief Byte range reader used by the residency manager.
+	 *
+	 * Read() may be called from worker threads concurrently, implementations must be thread safe.
+	 */
+	class TextureStreamSource
+	{
+	public:
+		virtual ~TextureStreamSource() = default;
+
+		/// Returns the size of the file in bytes, or 0 if it cannot be opened.
+		virtual uint64_t GetFileSize(const std::filesystem::path &path) = 0;
+
+		/// Reads exactly `size` bytes starting at `offset` into `dst`. Returns false on a short read.
+		virtual bool Read(const std::filesystem::path &path, uint64_t offset, uint64_t size, uint8_t *dst) = 0;
+	};
+
+	/// Default source reading from disk with one seek per request.
+	class FileTextureStreamSource : public TextureStreamSource
+	{
+	public:
+		uint64_t GetFileSize(const std::filesystem::path &path) override;
+		bool Read(const std::filesystem::path &path, uint64_t offset, uint64_t size, uint8_t *dst) override;
+	};
+
+	struct TextureResidencySettings
+	{
+		uint64_t budgetBytes = 512ull << 20;	///< Upper bound for streamed mip data (mip tails are always resident)
+		uint32_t tailDimension = 64;			///< Levels with a largest side <= this are loaded on registration and never evicted
+		uint32_t maxInFlight = 8;				///< Concurrent mip reads
+		uint32_t idleFrames = 120;				///< Frames without demand before a texture only wants its tail
+		float lodBias = 0.0f;					///< Added to the computed mip, positive values stream less detail
+		bool asyncIO = true;					///< Read on the thread pool; false reads inline in Update()
+	};
+
+	struct TextureResidencyStats
+	{
+		uint64_t budgetBytes = 0;
+		uint64_t residentBytes = 0;
+		uint64_t peakResidentBytes = 0;
+		uint64_t inFlightBytes = 0;
+		uint64_t bytesRead = 0;
+		uint64_t evictions = 0;		///< Mip levels dropped to stay within budget
+		uint64_t evictedBytes = 0;
+		uint64_t completedRequests = 0;
+		uint64_t failedRequests = 0;
+		uint32_t pendingRequests = 0;
+		uint32_t textureCount = 0;
+		double lastLatencyMs = 0.0;	///< Request issue to data available, per mip level
+		double averageLatencyMs = 0.0;
+		double maxLatencyMs = 0.0;
+	};
+
+	/**
+	 * @brief Keeps DDS mip chains partially resident under a memory budget.
+	 *
+	 * Registering a texture reads the header and the mip tail with a single ranged read. Each frame
+	 * the renderer reports how large the texture is on screen, Update() turns that into a desired top
+	 * level and streams finer levels one at a time, least detailed first. When a read would exceed the
+	 * budget, surplus detail and then least recently used levels of other textures are evicted.
+	 *
+	 * All public methods belong to the render thread; only the file reads run on the pool. The manager
+	 * owns CPU copies of the resident levels, the residency callback is the hook for the GPU upload.
+	 */
+	class TextureResidencyManager
+	{
+	public:
+		using TextureID = uint32_t;
+		static constexpr TextureID InvalidTexture = ~0u;
+
+		/**
+		 * @param source Reader for mip data; nullptr uses FileTextureStreamSource.
+		 * @param pool Pool for asynchronous reads; nullptr uses ThreadPool::Get().
+		 */
+		explicit TextureResidencyManager(const TextureResidencySettings &settings = {}, std::shared_ptr<TextureStreamSource> source = nullptr,
+		                                 ThreadPool *pool = nullptr);
+		~TextureResidencyManager();
+
+		TextureResidencyManager(const TextureResidencyManager &) = delete;
+		TextureResidencyManager &operator=(const TextureResidencyManager &) = delete;
+
+		/**
+		 * @brief Reads the header and the mip tail of a DDS file.
+		 * @return InvalidTexture if the file is missing, truncated or not a DDS.
+		 *
+		 * Arrays, cube maps and volume textures are not streamed and are loaded whole.
+		 */
+		TextureID Register(const std::filesystem::path &path);
+		void Unregister(TextureID id);
+
+		/**
+		 * @brief Reports the on-screen size (largest side, in pixels) the texture is drawn at this frame.
+		 *
+		 * Several reports in one frame keep the most detailed request.
+		 */
+		void RequestCoverage(TextureID id, float screenPixels);
+
+		/// Explicitly requests a top level for this frame.
+		void RequestMip(TextureID id, uint32_t mip);
+
+		/**
+		 * @brief Applies finished reads, enforces the budget and issues new reads. Call once per frame.
+		 */
+		void Update();
+
+		/// Waits for all outstanding reads and applies them.
+		void Flush();
+
+		void SetBudget(uint64_t budgetBytes);
+		void SetResidencyCallback(std::function<void(TextureID, uint32_t residentMip)> callback) { m_OnResident = std::move(callback); }
+
+		[[nodiscard]] bool IsValid(TextureID id) const;
+		[[nodiscard]] uint32_t GetResidentMip(TextureID id) const;
+		[[nodiscard]] uint32_t GetDesiredMip(TextureID id) const;
+		[[nodiscard]] uint32_t GetTailMip(TextureID id) const;
+		[[nodiscard]] uint32_t GetMipCount(TextureID id) const;
+		[[nodiscard]] const dds::Header *GetHeader(TextureID id) const;
+
+		/**
+		 * @brief Resident data of one level, nullptr if it is not loaded.
+		 *
+		 * For textures that are not streamed, level 0 holds the entire pixel payload.
+		 */
+		[[nodiscard]] const std::vector<uint8_t> *GetMipData(TextureID id, uint32_t mip) const;
+
+		[[nodiscard]] const TextureResidencyStats &GetStats() const { return m_Stats; }
+		[[nodiscard]] const TextureResidencySettings &GetSettings() const { return m_Settings; }
+		[[nodiscard]] uint64_t GetFrame() const { return m_Frame; }
+
+		/**
+		 * @brief Level whose size best matches the on-screen footprint.
+		 */
+		static uint32_t ComputeDesiredMip(uint32_t width, uint32_t height, float screenPixels, uint32_t mipCount, float lodBias = 0.0f);
+
+	private:
+		static constexpr uint32_t NoMip = ~0u;
+
+		struct StreamedTexture
+		{
+			std::filesystem::path path;
+			dds::Header header {};
+			std::vector<std::vector<uint8_t>> mips;
+			uint64_t residentBytes = 0;
+			uint64_t lastUsedFrame = 0;
+			uint32_t generation = 0;
+			uint32_t mipCount = 0;
+			uint32_t tailMip = 0;
+			uint32_t residentMip = 0;
+			uint32_t desiredMip = 0;
+			uint32_t frameRequestMip = NoMip;
+			uint32_t pendingMip = NoMip;
+			bool streamable = false;
+			bool failed = false;
+			bool active = false;
+		};
+
+		struct PendingRead
+		{
+			TextureID id = InvalidTexture;
+			uint32_t generation = 0;
+			uint32_t mip = 0;
+			std::vector<uint8_t> data;
+			std::future<bool> done;
+			std::chrono::steady_clock::time_point issued;
+		};
+
+		StreamedTexture *Find(TextureID id);
+		[[nodiscard]] const StreamedTexture *Find(TextureID id) const;
+
+		void CollectReads(bool wait);
+		void RefreshDemand();
+		bool EnsureBudget(uint64_t bytes, TextureID requester);
+		void EvictLevel(StreamedTexture &texture);
+		void IssueRead(TextureID id, StreamedTexture &texture);
+		void AddResident(StreamedTexture &texture, uint32_t mip, std::vector<uint8_t> data);
+
+		TextureResidencySettings m_Settings;
+		std::shared_ptr<TextureStreamSource> m_Source;
+		ThreadPool *m_Pool = nullptr;
+
+		std::vector<StreamedTexture> m_Textures;
+		std::vector<TextureID> m_FreeSlots;
+		std::vector<std::unique_ptr<PendingRead>> m_Pending;
+		std::vector<TextureID> m_EvictionOrder;
+		bool m_EvictionOrderValid = false;
+
+		std::function<void(TextureID, uint32_t)> m_OnResident;
+		TextureResidencyStats m_Stats;
+		double m_TotalLatencyMs = 0.0;
+		uint64_t m_Frame = 1;
+	};
+
+}
+
+/// -------------------------------------------------------
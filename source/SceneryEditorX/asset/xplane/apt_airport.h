@@ -0,0 +1,320 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* apt_airport.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// -------------------------------------------------------
+
+/**
+ * Row codes of the X-Plane apt.dat format (versions 1000 to 1200).
+ *
+ * Every line starts with a numeric row code followed by whitespace separated fields. An
+ * airport begins with a 1, 16 or 17 header row and runs until the next header or the
+ * final 99 row.
+ */
+namespace SceneryEditorX::Apt
+{
+	enum RowCode : int
+	{
+		LandAirport = 1,
+		Seaplane = 16,
+		Heliport = 17,
+		Runway = 100,
+		WaterRunway = 101,
+		Helipad = 102,
+		Pavement = 110,
+		Node = 111,
+		BezierNode = 112,
+		CloseLoop = 113,
+		BezierCloseLoop = 114,
+		EndNode = 115,
+		BezierEndNode = 116,
+		LinearFeature = 120,
+		Boundary = 130,
+		Viewpoint = 14,
+		StartupLegacy = 15,
+		Beacon = 18,
+		Windsock = 19,
+		Sign = 20,
+		LightingObject = 21,
+		FrequencyFirst = 50,			///< 50-56: legacy 10 kHz frequency rows
+		FrequencyLast = 56,
+		Frequency833First = 1050,		///< 1050-1056: 8.33 kHz frequency rows
+		Frequency833Last = 1056,
+		Flow = 1000,
+		FlowWind = 1001,
+		FlowCeiling = 1002,
+		FlowVisibility = 1003,
+		FlowTime = 1004,
+		FlowRunway = 1100,
+		FlowPattern = 1101,
+		TaxiNetwork = 1200,
+		TaxiNode = 1201,
+		TaxiEdge = 1202,
+		TaxiActiveZone = 1204,
+		TruckEdge = 1206,
+		Startup = 1300,
+		StartupMetadata = 1301,
+		Metadata = 1302,
+		TruckParking = 1400,
+		TruckDestination = 1401,
+		EndOfFile = 99
+	};
+
+	constexpr bool IsAirportHeader(const int code)
+	{
+		return code == LandAirport || code == Seaplane || code == Heliport;
+	}
+
+	enum class AirportType : uint8_t
+	{
+		Land = LandAirport,
+		Seaplane = Seaplane,
+		Heliport = Heliport
+	};
+
+}
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	struct AptRunwayEnd
+	{
+		std::string number;
+		double latitude = 0.0;
+		double longitude = 0.0;
+		double displacedThreshold = 0.0;	///< Metres
+		double overrun = 0.0;				///< Metres
+		int markings = 0;
+		int approachLights = 0;
+		bool touchdownLights = false;
+		int reil = 0;
+	};
+
+	struct AptRunway
+	{
+		double width = 0.0;				///< Metres
+		int surface = 0;
+		int shoulder = 0;
+		double smoothness = 0.25;
+		bool centreLights = false;
+		int edgeLights = 0;
+		bool autoSigns = false;
+		AptRunwayEnd ends[2];
+	};
+
+	struct AptWaterRunway
+	{
+		double width = 0.0;
+		bool buoys = false;
+		std::string numbers[2];
+		double latitude[2] = {};
+		double longitude[2] = {};
+	};
+
+	struct AptHelipad
+	{
+		std::string name;
+		double latitude = 0.0;
+		double longitude = 0.0;
+		double heading = 0.0;
+		double length = 0.0;
+		double width = 0.0;
+		int surface = 0;
+		int markings = 0;
+		int shoulder = 0;
+		double smoothness = 0.25;
+		int edgeLights = 0;
+	};
+
+	/// Node of a pavement, linear feature or boundary contour (rows 111-116).
+	struct AptNode
+	{
+		double latitude = 0.0;
+		double longitude = 0.0;
+		double controlLatitude = 0.0;	///< Bezier control point, valid when bezier is set
+		double controlLongitude = 0.0;
+		bool bezier = false;
+		std::vector<int> lineAttributes;	///< Line and light codes applied from this node on
+	};
+
+	struct AptContour
+	{
+		std::vector<AptNode> nodes;
+		bool closed = false;
+	};
+
+	enum class AptPolygonKind : uint8_t
+	{
+		Pavement = Apt::Pavement,
+		LinearFeature = Apt::LinearFeature,
+		Boundary = Apt::Boundary
+	};
+
+	/// Taxiway or apron pavement (110), painted line chain (120) or airport boundary (130).
+	struct AptPolygon
+	{
+		AptPolygonKind kind = AptPolygonKind::Pavement;
+		int surface = 0;					///< Pavement only
+		double smoothness = 0.25;			///< Pavement only
+		double textureHeading = 0.0;		///< Pavement only
+		std::string name;
+		std::vector<AptContour> contours;	///< Outer ring first, then holes
+	};
+
+	struct AptSign
+	{
+		double latitude = 0.0;
+		double longitude = 0.0;
+		double heading = 0.0;
+		int size = 0;
+		std::string text;
+	};
+
+	struct AptLight
+	{
+		double latitude = 0.0;
+		double longitude = 0.0;
+		int type = 0;
+		double heading = 0.0;
+		double glideslope = 0.0;
+		std::string runway;
+		std::string description;
+	};
+
+	/// Beacon (18), windsock (19) or tower viewpoint (14).
+	struct AptMarker
+	{
+		int code = 0;
+		double latitude = 0.0;
+		double longitude = 0.0;
+		double value = 0.0;				///< Beacon type, windsock lighting or viewpoint height in feet
+		std::string name;
+	};
+
+	struct AptStartup
+	{
+		double latitude = 0.0;
+		double longitude = 0.0;
+		double heading = 0.0;
+		std::string locationType;		///< gate, hangar, misc or tie-down
+		std::string aircraftTypes;		///< Pipe separated categories
+		std::string name;
+		char widthCode = 0;				///< ICAO category from 1301, 0 if absent
+		std::string operationType;
+		std::string airlines;
+	};
+
+	struct AptFrequency
+	{
+		int code = 0;					///< Row code normalised to the 50-56 range
+		uint32_t kilohertz = 0;
+		std::string name;
+	};
+
+	struct AptFlowRunwayRule
+	{
+		std::string runway;
+		uint32_t frequency = 0;
+		std::string legTypes;			///< Pipe separated: arrivals, departures, ...
+		std::string aircraftTypes;
+		double headingFrom = 0.0;		///< Departure heading range the rule applies to
+		double headingTo = 0.0;
+		double initialHeadingFrom = 0.0;	///< Initial heading range ATC assigns
+		double initialHeadingTo = 0.0;
+		std::string name;
+	};
+
+	struct AptFlow
+	{
+		std::string name;
+		struct Wind { std::string metar; double fromHeading = 0.0; double toHeading = 0.0; double maxSpeed = 0.0; };
+		struct Ceiling { std::string metar; double feet = 0.0; };
+		struct Visibility { std::string metar; double statuteMiles = 0.0; };
+		struct Time { int from = 0; int to = 0; };
+		std::vector<Wind> windRules;
+		std::vector<Ceiling> ceilingRules;
+		std::vector<Visibility> visibilityRules;
+		std::vector<Time> timeRules;
+		std::vector<AptFlowRunwayRule> runwayRules;
+		std::vector<std::pair<std::string, std::string>> patterns;	///< Runway and side
+	};
+
+	struct AptTaxiNode
+	{
+		uint32_t id = 0;
+		double latitude = 0.0;
+		double longitude = 0.0;
+		std::string usage;				///< dest, init, both or junc
+		std::string name;
+	};
+
+	struct AptTaxiEdge
+	{
+		uint32_t from = 0;
+		uint32_t to = 0;
+		bool oneWay = false;
+		bool groundTruck = false;		///< 1206 service road
+		std::string type;				///< runway, taxiway or taxiway_X width class
+		std::string name;
+		std::vector<std::pair<std::string, std::string>> activeZones;	///< Zone type and runway list
+	};
+
+	/// Any row the parser keeps verbatim: truck parking, destinations and codes it does not model.
+	struct AptRecord
+	{
+		int code = 0;
+		std::string fields;				///< Everything after the row code
+	};
+
+	struct AptAirport
+	{
+		Apt::AirportType type = Apt::AirportType::Land;
+		int elevation = 0;				///< Feet MSL
+		std::string ident;
+		std::string name;
+		std::vector<std::pair<std::string, std::string>> metadata;	///< 1302 key/value rows
+
+		std::vector<AptRunway> runways;
+		std::vector<AptWaterRunway> waterRunways;
+		std::vector<AptHelipad> helipads;
+		std::vector<AptPolygon> polygons;
+		std::vector<AptSign> signs;
+		std::vector<AptLight> lights;
+		std::vector<AptMarker> markers;
+		std::vector<AptStartup> startups;
+		std::vector<AptFrequency> frequencies;
+		std::vector<AptFlow> flows;
+		std::vector<AptTaxiNode> taxiNodes;
+		std::vector<AptTaxiEdge> taxiEdges;
+		std::vector<AptRecord> otherRows;
+
+		/// Value of a 1302 metadata key such as "icao_code", or nullptr.
+		[[nodiscard]] const std::string *FindMetadata(const std::string &key) const
+		{
+			for (const auto &[name, value] : metadata)
+			{
+				if (name == key)
+					return &value;
+			}
+			return nullptr;
+		}
+	};
+
+}
+
+/// -------------------------------------------------------
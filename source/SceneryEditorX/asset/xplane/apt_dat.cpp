@@ -0,0 +1,829 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* apt_dat.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "apt_dat.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include "SceneryEditorX/core/threading/thread_pool.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		constexpr char INDEX_MAGIC[8] = { 'S', 'E', 'D', 'X', 'A', 'P', 'T', 'I' };
+		constexpr uint32_t INDEX_VERSION = 1;
+		constexpr size_t MIN_CHUNK_BYTES = 1 << 20;
+
+		double MillisecondsSince(const std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		bool IsSpace(const char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
+
+		/// End of the line starting at @p pos, excluding the '\n'.
+		size_t LineEnd(const char *data, const size_t pos, const size_t size)
+		{
+			const void *newline = std::memchr(data + pos, '\n', size - pos);
+			return newline ? static_cast<size_t>(static_cast<const char *>(newline) - data) : size;
+		}
+
+		/// Row code of the line at @p pos if it is an airport header or the 99 row, else 0. Only looks at the first bytes.
+		int PeekBoundary(const char *data, size_t pos, const size_t end)
+		{
+			while (pos < end && IsSpace(data[pos]))
+				++pos;
+			if (pos + 1 >= end)
+				return 0;
+
+			const char c0 = data[pos];
+			const char c1 = data[pos + 1];
+			if (c0 == '1' && IsSpace(c1))
+				return Apt::LandAirport;
+			if (pos + 2 < end && !IsSpace(data[pos + 2]))
+				return 0;
+			if (c0 == '1' && c1 == '6')
+				return Apt::Seaplane;
+			if (c0 == '1' && c1 == '7')
+				return Apt::Heliport;
+			if (c0 == '9' && c1 == '9')
+				return Apt::EndOfFile;
+			return 0;
+		}
+
+		/// Calls @p func for every non-blank row in [begin, end).
+		template<typename Func>
+		void ForEachLine(const char *data, size_t begin, const size_t end, Func &&func)
+		{
+			AptRow row;
+			while (begin < end)
+			{
+				const size_t lineEnd = LineEnd(data, begin, end);
+				if (AptDatFile::Tokenize(std::string_view(data + begin, lineEnd - begin), row))
+					func(row);
+				begin = lineEnd + 1;
+			}
+		}
+
+		std::string ToString(const std::string_view text)
+		{
+			return std::string(text);
+		}
+
+		/// Builds an AptAirport one row at a time, tracking which polygon, flow, edge or startup following rows belong to.
+		class AirportBuilder
+		{
+		public:
+			explicit AirportBuilder(AptAirport &out) : m_Out(out) {}
+
+			void Add(const AptRow &row)
+			{
+				if (row.code >= Apt::Node && row.code <= Apt::BezierEndNode)
+				{
+					AddNode(row);
+					return;
+				}
+				m_Polygon = nullptr;
+
+				switch (row.code)
+				{
+				case Apt::LandAirport:
+				case Apt::Seaplane:
+				case Apt::Heliport:
+					m_Out.type = static_cast<Apt::AirportType>(row.code);
+					m_Out.elevation = row.Int(1);
+					m_Out.ident = ToString(row.Token(4));
+					m_Out.name = ToString(row.Rest(5));
+					break;
+				case Apt::Runway:
+					AddRunway(row);
+					break;
+				case Apt::WaterRunway:
+				{
+					AptWaterRunway &runway = m_Out.waterRunways.emplace_back();
+					runway.width = row.Double(1);
+					runway.buoys = row.Int(2) != 0;
+					for (uint32_t end = 0; end < 2; ++end)
+					{
+						runway.numbers[end] = ToString(row.Token(3 + end * 3));
+						runway.latitude[end] = row.Double(4 + end * 3);
+						runway.longitude[end] = row.Double(5 + end * 3);
+					}
+					break;
+				}
+				case Apt::Helipad:
+				{
+					AptHelipad &helipad = m_Out.helipads.emplace_back();
+					helipad.name = ToString(row.Token(1));
+					helipad.latitude = row.Double(2);
+					helipad.longitude = row.Double(3);
+					helipad.heading = row.Double(4);
+					helipad.length = row.Double(5);
+					helipad.width = row.Double(6);
+					helipad.surface = row.Int(7);
+					helipad.markings = row.Int(8);
+					helipad.shoulder = row.Int(9);
+					helipad.smoothness = row.Double(10, 0.25);
+					helipad.edgeLights = row.Int(11);
+					break;
+				}
+				case Apt::Pavement:
+				{
+					m_Polygon = &m_Out.polygons.emplace_back();
+					m_Polygon->kind = AptPolygonKind::Pavement;
+					m_Polygon->surface = row.Int(1);
+					m_Polygon->smoothness = row.Double(2, 0.25);
+					m_Polygon->textureHeading = row.Double(3);
+					m_Polygon->name = ToString(row.Rest(4));
+					m_ContourOpen = false;
+					break;
+				}
+				case Apt::LinearFeature:
+				case Apt::Boundary:
+				{
+					m_Polygon = &m_Out.polygons.emplace_back();
+					m_Polygon->kind = static_cast<AptPolygonKind>(row.code);
+					m_Polygon->name = ToString(row.Rest(1));
+					m_ContourOpen = false;
+					break;
+				}
+				case Apt::Viewpoint:
+				case Apt::Beacon:
+				case Apt::Windsock:
+				{
+					AptMarker &marker = m_Out.markers.emplace_back();
+					marker.code = row.code;
+					marker.latitude = row.Double(1);
+					marker.longitude = row.Double(2);
+					marker.value = row.Double(3);
+					marker.name = ToString(row.Rest(row.code == Apt::Viewpoint ? 5 : 4));
+					break;
+				}
+				case Apt::StartupLegacy:
+				{
+					AptStartup &startup = m_Out.startups.emplace_back();
+					startup.latitude = row.Double(1);
+					startup.longitude = row.Double(2);
+					startup.heading = row.Double(3);
+					startup.name = ToString(row.Rest(4));
+					m_Startup = nullptr;
+					break;
+				}
+				case Apt::Startup:
+				{
+					m_Startup = &m_Out.startups.emplace_back();
+					m_Startup->latitude = row.Double(1);
+					m_Startup->longitude = row.Double(2);
+					m_Startup->heading = row.Double(3);
+					m_Startup->locationType = ToString(row.Token(4));
+					m_Startup->aircraftTypes = ToString(row.Token(5));
+					m_Startup->name = ToString(row.Rest(6));
+					break;
+				}
+				case Apt::StartupMetadata:
+					if (!m_Startup)
+						break;
+					m_Startup->widthCode = row.Token(1).empty() ? 0 : row.Token(1).front();
+					m_Startup->operationType = ToString(row.Token(2));
+					m_Startup->airlines = ToString(row.Rest(3));
+					break;
+				case Apt::Sign:
+				{
+					AptSign &sign = m_Out.signs.emplace_back();
+					sign.latitude = row.Double(1);
+					sign.longitude = row.Double(2);
+					sign.heading = row.Double(3);
+					sign.size = row.Int(5);
+					sign.text = ToString(row.Rest(6));
+					break;
+				}
+				case Apt::LightingObject:
+				{
+					AptLight &light = m_Out.lights.emplace_back();
+					light.latitude = row.Double(1);
+					light.longitude = row.Double(2);
+					light.type = row.Int(3);
+					light.heading = row.Double(4);
+					light.glideslope = row.Double(5);
+					light.runway = ToString(row.Token(6));
+					light.description = ToString(row.Rest(7));
+					break;
+				}
+				case Apt::Flow:
+					m_Flow = &m_Out.flows.emplace_back();
+					m_Flow->name = ToString(row.Rest(1));
+					break;
+				case Apt::FlowWind:
+				case Apt::FlowCeiling:
+				case Apt::FlowVisibility:
+				case Apt::FlowTime:
+				case Apt::FlowRunway:
+				case Apt::FlowPattern:
+					if (m_Flow)
+						AddFlowRule(row);
+					else
+						AddOther(row);
+					break;
+				case Apt::TaxiNetwork:
+					break;
+				case Apt::TaxiNode:
+				{
+					AptTaxiNode &node = m_Out.taxiNodes.emplace_back();
+					node.latitude = row.Double(1);
+					node.longitude = row.Double(2);
+					node.usage = ToString(row.Token(3));
+					node.id = static_cast<uint32_t>(row.Int(4));
+					node.name = ToString(row.Rest(5));
+					break;
+				}
+				case Apt::TaxiEdge:
+				case Apt::TruckEdge:
+				{
+					m_Edge = &m_Out.taxiEdges.emplace_back();
+					m_Edge->from = static_cast<uint32_t>(row.Int(1));
+					m_Edge->to = static_cast<uint32_t>(row.Int(2));
+					m_Edge->oneWay = row.Token(3) == "oneway";
+					m_Edge->groundTruck = row.code == Apt::TruckEdge;
+					if (m_Edge->groundTruck)
+					{
+						m_Edge->name = ToString(row.Rest(4));
+					}
+					else
+					{
+						m_Edge->type = ToString(row.Token(4));
+						m_Edge->name = ToString(row.Rest(5));
+					}
+					break;
+				}
+				case Apt::TaxiActiveZone:
+					if (m_Edge)
+						m_Edge->activeZones.emplace_back(ToString(row.Token(1)), ToString(row.Rest(2)));
+					break;
+				case Apt::Metadata:
+					m_Out.metadata.emplace_back(ToString(row.Token(1)), ToString(row.Rest(2)));
+					break;
+				default:
+					if ((row.code >= Apt::FrequencyFirst && row.code <= Apt::FrequencyLast) ||
+						(row.code >= Apt::Frequency833First && row.code <= Apt::Frequency833Last))
+					{
+						AptFrequency &frequency = m_Out.frequencies.emplace_back();
+						const bool legacy = row.code <= Apt::FrequencyLast;
+						frequency.code = legacy ? row.code : row.code - 1000;
+						frequency.kilohertz = static_cast<uint32_t>(row.Int(1)) * (legacy ? 10u : 1u);
+						frequency.name = ToString(row.Rest(2));
+					}
+					else
+					{
+						AddOther(row);
+					}
+					break;
+				}
+			}
+
+		private:
+			void AddRunway(const AptRow &row)
+			{
+				AptRunway &runway = m_Out.runways.emplace_back();
+				runway.width = row.Double(1);
+				runway.surface = row.Int(2);
+				runway.shoulder = row.Int(3);
+				runway.smoothness = row.Double(4, 0.25);
+				runway.centreLights = row.Int(5) != 0;
+				runway.edgeLights = row.Int(6);
+				runway.autoSigns = row.Int(7) != 0;
+				for (uint32_t i = 0; i < 2; ++i)
+				{
+					const uint32_t base = 8 + i * 9;
+					AptRunwayEnd &end = runway.ends[i];
+					end.number = ToString(row.Token(base));
+					end.latitude = row.Double(base + 1);
+					end.longitude = row.Double(base + 2);
+					end.displacedThreshold = row.Double(base + 3);
+					end.overrun = row.Double(base + 4);
+					end.markings = row.Int(base + 5);
+					end.approachLights = row.Int(base + 6);
+					end.touchdownLights = row.Int(base + 7) != 0;
+					end.reil = row.Int(base + 8);
+				}
+			}
+
+			void AddNode(const AptRow &row)
+			{
+				if (!m_Polygon)
+				{
+					AddOther(row);
+					return;
+				}
+				if (!m_ContourOpen)
+				{
+					m_Polygon->contours.emplace_back();
+					m_ContourOpen = true;
+				}
+
+				const bool bezier = row.code == Apt::BezierNode || row.code == Apt::BezierCloseLoop || row.code == Apt::BezierEndNode;
+				AptNode &node = m_Polygon->contours.back().nodes.emplace_back();
+				node.latitude = row.Double(1);
+				node.longitude = row.Double(2);
+				node.bezier = bezier;
+				uint32_t attribute = 3;
+				if (bezier)
+				{
+					node.controlLatitude = row.Double(3);
+					node.controlLongitude = row.Double(4);
+					attribute = 5;
+				}
+				for (; attribute < row.tokenCount; ++attribute)
+					node.lineAttributes.push_back(row.Int(attribute));
+
+				if (row.code == Apt::CloseLoop || row.code == Apt::BezierCloseLoop)
+				{
+					m_Polygon->contours.back().closed = true;
+					m_ContourOpen = false;
+				}
+				else if (row.code == Apt::EndNode || row.code == Apt::BezierEndNode)
+				{
+					m_ContourOpen = false;
+				}
+			}
+
+			void AddFlowRule(const AptRow &row)
+			{
+				switch (row.code)
+				{
+				case Apt::FlowWind:
+					m_Flow->windRules.push_back({ ToString(row.Token(1)), row.Double(2), row.Double(3), row.Double(4) });
+					break;
+				case Apt::FlowCeiling:
+					m_Flow->ceilingRules.push_back({ ToString(row.Token(1)), row.Double(2) });
+					break;
+				case Apt::FlowVisibility:
+					m_Flow->visibilityRules.push_back({ ToString(row.Token(1)), row.Double(2) });
+					break;
+				case Apt::FlowTime:
+					m_Flow->timeRules.push_back({ row.Int(1), row.Int(2) });
+					break;
+				case Apt::FlowRunway:
+				{
+					AptFlowRunwayRule &rule = m_Flow->runwayRules.emplace_back();
+					rule.runway = ToString(row.Token(1));
+					rule.frequency = static_cast<uint32_t>(row.Int(2));
+					rule.legTypes = ToString(row.Token(3));
+					rule.aircraftTypes = ToString(row.Token(4));
+					rule.headingFrom = row.Double(5);
+					rule.headingTo = row.Double(6);
+					rule.initialHeadingFrom = row.Double(7);
+					rule.initialHeadingTo = row.Double(8);
+					rule.name = ToString(row.Rest(9));
+					break;
+				}
+				default:
+					m_Flow->patterns.emplace_back(ToString(row.Token(1)), ToString(row.Token(2)));
+					break;
+				}
+			}
+
+			void AddOther(const AptRow &row)
+			{
+				m_Out.otherRows.push_back({ row.code, ToString(row.Rest(1)) });
+			}
+
+			AptAirport &m_Out;
+			AptPolygon *m_Polygon = nullptr;
+			bool m_ContourOpen = false;
+			AptFlow *m_Flow = nullptr;
+			AptTaxiEdge *m_Edge = nullptr;
+			AptStartup *m_Startup = nullptr;
+		};
+
+		template<typename T>
+		void WriteValue(std::ofstream &stream, const T &value)
+		{
+			stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+		}
+
+		template<typename T>
+		bool ReadValue(std::ifstream &stream, T &value)
+		{
+			return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+		}
+
+		void WriteString(std::ofstream &stream, const std::string &text)
+		{
+			const auto length = static_cast<uint16_t>(std::min<size_t>(text.size(), UINT16_MAX));
+			WriteValue(stream, length);
+			stream.write(text.data(), length);
+		}
+
+		bool ReadString(std::ifstream &stream, std::string &text)
+		{
+			uint16_t length = 0;
+			if (!ReadValue(stream, length))
+				return false;
+			text.resize(length);
+			return static_cast<bool>(stream.read(text.data(), length));
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	std::string_view AptRow::Rest(const uint32_t index) const
+	{
+		if (index >= tokenCount)
+			return {};
+		return line.substr(static_cast<size_t>(tokens[index].data() - line.data()));
+	}
+
+	double AptRow::Double(const uint32_t index, const double fallback) const
+	{
+		const std::string_view token = Token(index);
+		double value = fallback;
+		if (std::from_chars(token.data(), token.data() + token.size(), value).ec != std::errc())
+			return fallback;
+		return value;
+	}
+
+	int AptRow::Int(const uint32_t index, const int fallback) const
+	{
+		const std::string_view token = Token(index);
+		int value = fallback;
+		if (std::from_chars(token.data(), token.data() + token.size(), value).ec != std::errc())
+			return fallback;
+		return value;
+	}
+
+	/// -------------------------------------------------------
+
+	bool AptDatFile::Tokenize(std::string_view line, AptRow &row)
+	{
+		while (!line.empty() && IsSpace(line.back()))
+			line.remove_suffix(1);
+
+		row.tokenCount = 0;
+		row.line = line;
+		size_t pos = 0;
+		while (pos < line.size() && row.tokenCount < AptRow::MAX_TOKENS)
+		{
+			while (pos < line.size() && IsSpace(line[pos]))
+				++pos;
+			if (pos == line.size())
+				break;
+			const size_t start = pos;
+			while (pos < line.size() && !IsSpace(line[pos]))
+				++pos;
+			row.tokens[row.tokenCount++] = line.substr(start, pos - start);
+		}
+
+		if (row.tokenCount == 0)
+			return false;
+		const std::string_view code = row.tokens[0];
+		const auto result = std::from_chars(code.data(), code.data() + code.size(), row.code);
+		return result.ec == std::errc() && result.ptr == code.data() + code.size();
+	}
+
+	/// -------------------------------------------------------
+
+	bool AptDatFile::Open(const std::filesystem::path &path, const AptIndexOptions &options)
+	{
+		Close();
+		if (!m_File.Open(path))
+			return Fail("cannot map " + path.string());
+
+		m_Data = reinterpret_cast<const char *>(m_File.GetData());
+		m_Size = m_File.GetSize();
+		std::error_code error;
+		m_SourceTime = static_cast<uint64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+
+		if (!options.useCache)
+			return BuildIndex(options);
+
+		std::filesystem::path cachePath = options.cachePath;
+		if (cachePath.empty())
+			cachePath = path.string() + ".sedxidx";
+		if (LoadIndex(cachePath))
+			return true;
+
+		m_Error.clear();
+		if (!BuildIndex(options))
+			return false;
+
+		/// A read-only scenery folder just means the next Open() scans again.
+		SaveIndex(cachePath);
+		return true;
+	}
+
+	bool AptDatFile::Load(const char *data, const size_t size, const AptIndexOptions &options)
+	{
+		Close();
+		m_Data = data;
+		m_Size = size;
+		return BuildIndex(options);
+	}
+
+	void AptDatFile::Close()
+	{
+		m_File.Close();
+		m_Data = nullptr;
+		m_Size = 0;
+		m_SourceTime = 0;
+		m_Version = 0;
+		m_Error.clear();
+		m_Airports.clear();
+		m_ByIdent.clear();
+		m_Stats = {};
+	}
+
+	bool AptDatFile::Fail(std::string error)
+	{
+		m_Error = std::move(error);
+		return false;
+	}
+
+	bool AptDatFile::BuildIndex(const AptIndexOptions &options)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		m_Airports.clear();
+		m_Stats = {};
+		m_Stats.fileBytes = m_Size;
+
+		/// Header: an 'I' or 'A' line-ending marker, then the version row.
+		size_t pos = 0;
+		while (pos < m_Size && (IsSpace(m_Data[pos]) || m_Data[pos] == '\n'))
+			++pos;
+		if (pos == m_Size || (m_Data[pos] != 'I' && m_Data[pos] != 'A'))
+		{
+			m_Data = nullptr;
+			return Fail("not an apt.dat file");
+		}
+		pos = LineEnd(m_Data, pos, m_Size) + 1;
+		if (pos < m_Size)
+		{
+			AptRow row;
+			const size_t end = LineEnd(m_Data, pos, m_Size);
+			if (Tokenize(std::string_view(m_Data + pos, end - pos), row))
+				m_Version = row.code;
+			pos = end + 1;
+		}
+		const size_t bodyStart = std::min(pos, m_Size);
+
+		ThreadPool &pool = options.threadPool ? *options.threadPool : ThreadPool::Get();
+		const size_t bodySize = m_Size - bodyStart;
+		uint32_t chunkCount = 1;
+		if (options.parallel)
+		{
+			const size_t maxChunks = static_cast<size_t>(pool.GetWorkerCount() + 1) * 4;
+			chunkCount = static_cast<uint32_t>(std::clamp<size_t>(bodySize / MIN_CHUNK_BYTES, 1, maxChunks));
+		}
+		m_Stats.chunkCount = chunkCount;
+
+		/// Each chunk owns the lines that start inside it; a chunk boundary inside a line belongs to the earlier chunk.
+		struct Chunk
+		{
+			std::vector<AptIndexEntry> airports;
+			size_t endRow = SIZE_MAX;	///< First 99 row in the chunk
+		};
+		std::vector<Chunk> chunks(chunkCount);
+		const auto scan = [&](const uint32_t index)
+		{
+			size_t begin = bodyStart + bodySize * index / chunkCount;
+			const size_t end = bodyStart + bodySize * (index + 1) / chunkCount;
+			if (index > 0 && m_Data[begin - 1] != '\n')
+				begin = LineEnd(m_Data, begin, m_Size) + 1;
+
+			Chunk &chunk = chunks[index];
+			AptRow row;
+			while (begin < end)
+			{
+				const size_t lineEnd = LineEnd(m_Data, begin, m_Size);
+				const int boundary = PeekBoundary(m_Data, begin, lineEnd);
+				if (boundary == Apt::EndOfFile)
+				{
+					chunk.endRow = std::min(chunk.endRow, begin);
+				}
+				else if (boundary && Tokenize(std::string_view(m_Data + begin, lineEnd - begin), row))
+				{
+					AptIndexEntry &entry = chunk.airports.emplace_back();
+					entry.type = static_cast<Apt::AirportType>(row.code);
+					entry.elevation = row.Int(1);
+					entry.ident = std::string(row.Token(4));
+					entry.name = std::string(row.Rest(5));
+					entry.offset = begin;
+				}
+				begin = lineEnd + 1;
+			}
+		};
+
+		if (chunkCount > 1)
+			pool.ParallelFor(chunkCount, scan);
+		else
+			scan(0);
+
+		/// X-Plane stops reading at the first 99 row; so does the index.
+		size_t endRow = m_Size;
+		for (const Chunk &chunk : chunks)
+			endRow = std::min(endRow, chunk.endRow);
+
+		for (Chunk &chunk : chunks)
+		{
+			for (AptIndexEntry &entry : chunk.airports)
+			{
+				if (entry.offset < endRow)
+					m_Airports.push_back(std::move(entry));
+			}
+		}
+
+		for (size_t i = 0; i < m_Airports.size(); ++i)
+		{
+			const uint64_t end = i + 1 < m_Airports.size() ? m_Airports[i + 1].offset : endRow;
+			m_Airports[i].length = end - m_Airports[i].offset;
+		}
+
+		SortIndex();
+		m_Stats.indexMs = MillisecondsSince(start);
+		return true;
+	}
+
+	void AptDatFile::SortIndex()
+	{
+		m_ByIdent.resize(m_Airports.size());
+		for (uint32_t i = 0; i < m_ByIdent.size(); ++i)
+			m_ByIdent[i] = i;
+		std::stable_sort(m_ByIdent.begin(), m_ByIdent.end(), [this](const uint32_t a, const uint32_t b) {
+			return m_Airports[a].ident < m_Airports[b].ident;
+		});
+
+		m_Stats.airportCount = static_cast<uint32_t>(m_Airports.size());
+		m_Stats.duplicateCount = 0;
+		for (size_t i = 1; i < m_ByIdent.size(); ++i)
+		{
+			if (m_Airports[m_ByIdent[i]].ident == m_Airports[m_ByIdent[i - 1]].ident)
+				++m_Stats.duplicateCount;
+		}
+	}
+
+	const AptIndexEntry *AptDatFile::Find(const std::string_view ident) const
+	{
+		const auto it = std::lower_bound(m_ByIdent.begin(), m_ByIdent.end(), ident, [this](const uint32_t index, const std::string_view key) {
+			return std::string_view(m_Airports[index].ident) < key;
+		});
+		if (it == m_ByIdent.end() || m_Airports[*it].ident != ident)
+			return nullptr;
+		return &m_Airports[*it];
+	}
+
+	/// -------------------------------------------------------
+
+	void AptDatFile::ForEachRow(const AptIndexEntry &entry, const std::function<void(const AptRow &)> &func) const
+	{
+		if (!m_Data || entry.offset + entry.length > m_Size)
+			return;
+		ForEachLine(m_Data, entry.offset, entry.offset + entry.length, func);
+	}
+
+	bool AptDatFile::ReadAirport(const std::string_view ident, AptAirport &out)
+	{
+		const AptIndexEntry *entry = Find(ident);
+		if (!entry)
+			return Fail("airport " + std::string(ident) + " is not in the index");
+		if (!ReadAirport(*entry, out))
+			return Fail("airport " + std::string(ident) + " lies outside the file; the index is stale");
+		return true;
+	}
+
+	bool AptDatFile::ReadAirport(const AptIndexEntry &entry, AptAirport &out) const
+	{
+		if (!m_Data || entry.offset + entry.length > m_Size)
+			return false;
+
+		out = AptAirport();
+		AirportBuilder builder(out);
+		ForEachLine(m_Data, entry.offset, entry.offset + entry.length, [&builder](const AptRow &row) { builder.Add(row); });
+		return true;
+	}
+
+	bool AptDatFile::ParseAll(std::vector<AptAirport> &out, const AptIndexOptions &options)
+	{
+		if (!m_Data)
+			return Fail(m_Error.empty() ? "no apt.dat loaded" : m_Error);
+
+		out.clear();
+		out.resize(m_Airports.size());
+		const auto parse = [&](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i)
+				ReadAirport(m_Airports[i], out[i]);
+		};
+
+		const auto count = static_cast<uint32_t>(m_Airports.size());
+		if (options.parallel && count > 1)
+			(options.threadPool ? *options.threadPool : ThreadPool::Get()).ParallelForRange(count, 64, parse);
+		else
+			parse(0, count);
+		return true;
+	}
+
+	/// -------------------------------------------------------
+
+	bool AptDatFile::SaveIndex(const std::filesystem::path &path) const
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		if (!stream)
+			return false;
+
+		stream.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+		WriteValue(stream, INDEX_VERSION);
+		WriteValue(stream, static_cast<uint64_t>(m_Size));
+		WriteValue(stream, m_SourceTime);
+		WriteValue(stream, static_cast<int32_t>(m_Version));
+		WriteValue(stream, static_cast<uint32_t>(m_Airports.size()));
+		for (const AptIndexEntry &entry : m_Airports)
+		{
+			WriteValue(stream, entry.offset);
+			WriteValue(stream, entry.length);
+			WriteValue(stream, static_cast<uint8_t>(entry.type));
+			WriteValue(stream, static_cast<int32_t>(entry.elevation));
+			WriteString(stream, entry.ident);
+			WriteString(stream, entry.name);
+		}
+		return static_cast<bool>(stream);
+	}
+
+	bool AptDatFile::LoadIndex(const std::filesystem::path &path)
+	{
+		if (!m_Data)
+			return Fail("load the apt.dat before its index");
+
+		const auto start = std::chrono::steady_clock::now();
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream)
+			return Fail("cannot open " + path.string());
+
+		char magic[sizeof(INDEX_MAGIC)];
+		uint32_t version = 0;
+		uint64_t sourceSize = 0;
+		uint64_t sourceTime = 0;
+		int32_t aptVersion = 0;
+		uint32_t count = 0;
+		if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+			!ReadValue(stream, version) || version != INDEX_VERSION)
+			return Fail(path.string() + " is not an apt.dat index");
+		if (!ReadValue(stream, sourceSize) || !ReadValue(stream, sourceTime) || sourceSize != m_Size || sourceTime != m_SourceTime)
+			return Fail(path.string() + " is out of date");
+		if (!ReadValue(stream, aptVersion) || !ReadValue(stream, count))
+			return Fail(path.string() + " is truncated");
+
+		/// The count is read from the file, so it is checked against the bytes left before it sizes anything.
+		constexpr uint64_t minEntryBytes = sizeof(uint64_t) * 2 + sizeof(uint8_t) + sizeof(int32_t) + sizeof(uint16_t) * 2;
+		std::error_code sizeError;
+		const uint64_t fileSize = std::filesystem::file_size(path, sizeError);
+		const std::streamoff position = stream.tellg();
+		if (sizeError || position < 0 || static_cast<uint64_t>(position) > fileSize ||
+			static_cast<uint64_t>(count) * minEntryBytes > fileSize - static_cast<uint64_t>(position))
+			return Fail(path.string() + " is truncated");
+
+		std::vector<AptIndexEntry> airports(count);
+		for (AptIndexEntry &entry : airports)
+		{
+			uint8_t type = 0;
+			int32_t elevation = 0;
+			if (!ReadValue(stream, entry.offset) || !ReadValue(stream, entry.length) || !ReadValue(stream, type) ||
+				!ReadValue(stream, elevation) || !ReadString(stream, entry.ident) || !ReadString(stream, entry.name))
+				return Fail(path.string() + " is truncated");
+
+			/// Catches an apt.dat rewritten within the file system's time stamp resolution.
+			if (!Apt::IsAirportHeader(type) || entry.offset + entry.length > m_Size ||
+				PeekBoundary(m_Data, entry.offset, m_Size) != type)
+				return Fail(path.string() + " does not match the apt.dat");
+
+			entry.type = static_cast<Apt::AirportType>(type);
+			entry.elevation = elevation;
+		}
+
+		m_Version = aptVersion;
+		m_Airports = std::move(airports);
+		m_Stats = {};
+		m_Stats.fileBytes = m_Size;
+		m_Stats.fromCache = true;
+		SortIndex();
+		m_Stats.indexMs = MillisecondsSince(start);
+		return true;
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,153 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* apt_dat.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "apt_airport.h"
+#include "SceneryEditorX/utils/filestreaming/mapped_file.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	class ThreadPool;
+
+	/**
+	 * @brief One tokenized apt.dat line.
+	 *
+	 * Tokens are views into the mapped file; nothing is copied. Lines with more than
+	 * MAX_TOKENS fields keep the tail in the last token's Rest().
+	 */
+	struct AptRow
+	{
+		static constexpr uint32_t MAX_TOKENS = 32;
+
+		int code = 0;
+		uint32_t tokenCount = 0;				///< Including the row code
+		std::string_view line;					///< Without the line ending
+		std::string_view tokens[MAX_TOKENS];
+
+		[[nodiscard]] std::string_view Token(const uint32_t index) const { return index < tokenCount ? tokens[index] : std::string_view(); }
+
+		/// Token @p index and everything after it, e.g. an airport name containing spaces.
+		[[nodiscard]] std::string_view Rest(uint32_t index) const;
+
+		[[nodiscard]] double Double(uint32_t index, double fallback = 0.0) const;
+		[[nodiscard]] int Int(uint32_t index, int fallback = 0) const;
+	};
+
+	/// Index entry for one airport: its header fields and where its rows live in the file.
+	struct AptIndexEntry
+	{
+		std::string ident;
+		std::string name;
+		Apt::AirportType type = Apt::AirportType::Land;
+		int elevation = 0;
+		uint64_t offset = 0;		///< Byte offset of the header row
+		uint64_t length = 0;		///< Bytes up to the next airport or the 99 row
+	};
+
+	struct AptIndexOptions
+	{
+		bool parallel = true;				///< Scan the file in chunks on worker threads
+		ThreadPool *threadPool = nullptr;	///< Defaults to ThreadPool::Get()
+		bool useCache = true;				///< Load/save the index sidecar next to the file (Open() only)
+		std::filesystem::path cachePath;	///< Defaults to "<file>.sedxidx"
+	};
+
+	struct AptIndexStats
+	{
+		size_t fileBytes = 0;
+		uint32_t airportCount = 0;
+		uint32_t duplicateCount = 0;		///< Airports whose ident was already indexed; the first wins lookups
+		uint32_t chunkCount = 0;
+		bool fromCache = false;
+		double indexMs = 0.0;				///< Scan or cache load
+	};
+
+	/**
+	 * @brief Random access reader for X-Plane apt.dat files.
+	 *
+	 * Open() maps the file and builds an index of every airport header: ident, name and the
+	 * byte range of its rows. The scan splits the file into chunks on worker threads, so only
+	 * header lines are tokenized. The index is saved to a sidecar file and reused as long as
+	 * the size and modification time of the apt.dat match.
+	 *
+	 * ReadAirport() then parses a single airport from its byte range, so importing one
+	 * airport from the global apt.dat touches only a few kilobytes of the mapping.
+	 * ParseAll() parses every airport in parallel, handing each worker whole airports.
+	 */
+	class AptDatFile
+	{
+	public:
+		AptDatFile() = default;
+		AptDatFile(const AptDatFile &) = delete;
+		AptDatFile &operator=(const AptDatFile &) = delete;
+
+		bool Open(const std::filesystem::path &path, const AptIndexOptions &options = {});
+
+		/// Indexes an apt.dat already in memory. @p data must stay valid until Close() or the next Load/Open.
+		bool Load(const char *data, size_t size, const AptIndexOptions &options = {});
+
+		void Close();
+
+		[[nodiscard]] bool IsOpen() const { return m_Data != nullptr; }
+		[[nodiscard]] const std::string &GetError() const { return m_Error; }
+		[[nodiscard]] int GetVersion() const { return m_Version; }
+		[[nodiscard]] const AptIndexStats &GetStats() const { return m_Stats; }
+
+		/// Airports in file order.
+		[[nodiscard]] const std::vector<AptIndexEntry> &GetAirports() const { return m_Airports; }
+
+		/// Binary search over the ident index. Returns nullptr if @p ident is not in the file.
+		[[nodiscard]] const AptIndexEntry *Find(std::string_view ident) const;
+
+		/// Calls @p func for every row of @p entry, header included. Rows are only valid during the call.
+		void ForEachRow(const AptIndexEntry &entry, const std::function<void(const AptRow &)> &func) const;
+
+		/// Parses one airport from its byte range. Unknown row codes are kept in AptAirport::otherRows.
+		bool ReadAirport(std::string_view ident, AptAirport &out);
+		bool ReadAirport(const AptIndexEntry &entry, AptAirport &out) const;
+
+		/// Parses every airport, in parallel unless @p options disables it. @p out is in file order.
+		bool ParseAll(std::vector<AptAirport> &out, const AptIndexOptions &options = {});
+
+		bool SaveIndex(const std::filesystem::path &path) const;
+		bool LoadIndex(const std::filesystem::path &path);
+
+		/// Splits @p line into @p row. Returns false for blank lines and lines without a numeric row code.
+		static bool Tokenize(std::string_view line, AptRow &row);
+
+	private:
+		bool BuildIndex(const AptIndexOptions &options);
+		void SortIndex();
+		bool Fail(std::string error);
+
+		MappedFile m_File;
+		const char *m_Data = nullptr;
+		size_t m_Size = 0;
+		uint64_t m_SourceTime = 0;		///< Modification time stamp the cache is keyed on
+		int m_Version = 0;
+		std::string m_Error;
+		std::vector<AptIndexEntry> m_Airports;
+		std::vector<uint32_t> m_ByIdent;
+		AptIndexStats m_Stats;
+	};
+
+}
+
+/// -------------------------------------------------------
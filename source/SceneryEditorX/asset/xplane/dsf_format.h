@@ -0,0 +1,120 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* dsf_format.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// -------------------------------------------------------
+
+/**
+ * Constants of the X-Plane Distribution Scenery Format (DSF 1).
+ *
+ * A DSF file is the 8 byte cookie "XPLNEDSF", a 32-bit version, a sequence of atoms and a
+ * 16 byte MD5 of everything before it. Every atom starts with a 32-bit id and a 32-bit length
+ * that includes the 8 byte atom header. All values are little endian.
+ */
+namespace SceneryEditorX::DSF
+{
+	inline constexpr char COOKIE[8] = { 'X', 'P', 'L', 'N', 'E', 'D', 'S', 'F' };
+	inline constexpr uint32_t VERSION = 1;
+	inline constexpr size_t HEADER_SIZE = 12;
+	inline constexpr size_t ATOM_HEADER_SIZE = 8;
+	inline constexpr size_t FOOTER_SIZE = 16;
+
+	/// Global scenery ships DSFs inside 7z archives with this signature.
+	inline constexpr uint8_t SEVEN_ZIP_SIGNATURE[6] = { '7', 'z', 0xBC, 0xAF, 0x27, 0x1C };
+
+	constexpr uint32_t MakeAtomID(const char a, const char b, const char c, const char d)
+	{
+		return (static_cast<uint32_t>(static_cast<uint8_t>(a)) << 24) | (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 16) |
+		       (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 8) | static_cast<uint32_t>(static_cast<uint8_t>(d));
+	}
+
+	namespace Atom
+	{
+		inline constexpr uint32_t Head = MakeAtomID('H', 'E', 'A', 'D');
+		inline constexpr uint32_t Properties = MakeAtomID('P', 'R', 'O', 'P');
+		inline constexpr uint32_t Definitions = MakeAtomID('D', 'E', 'F', 'N');
+		inline constexpr uint32_t TerrainTypes = MakeAtomID('T', 'E', 'R', 'T');
+		inline constexpr uint32_t Objects = MakeAtomID('O', 'B', 'J', 'T');
+		inline constexpr uint32_t Polygons = MakeAtomID('P', 'O', 'L', 'Y');
+		inline constexpr uint32_t Networks = MakeAtomID('N', 'E', 'T', 'W');
+		inline constexpr uint32_t RasterNames = MakeAtomID('D', 'E', 'M', 'N');
+		inline constexpr uint32_t Geodata = MakeAtomID('G', 'E', 'O', 'D');
+		inline constexpr uint32_t Pool = MakeAtomID('P', 'O', 'O', 'L');
+		inline constexpr uint32_t Scale = MakeAtomID('S', 'C', 'A', 'L');
+		inline constexpr uint32_t Pool32 = MakeAtomID('P', 'O', '3', '2');
+		inline constexpr uint32_t Scale32 = MakeAtomID('S', 'C', '3', '2');
+		inline constexpr uint32_t Rasters = MakeAtomID('D', 'E', 'M', 'S');
+		inline constexpr uint32_t Commands = MakeAtomID('C', 'M', 'D', 'S');
+	}
+
+	/// Per-plane encoding of a planar numeric pool.
+	enum class PoolEncoding : uint8_t
+	{
+		Raw = 0,
+		Differenced = 1,
+		RunLength = 2,
+		RunLengthDifferenced = 3
+	};
+
+	/// Opcodes of the command section.
+	enum class Command : uint8_t
+	{
+		Reserved = 0,
+		PoolSelect = 1,
+		JunctionOffsetSelect = 2,
+		SetDefinition8 = 3,
+		SetDefinition16 = 4,
+		SetDefinition32 = 5,
+		SetRoadSubtype8 = 6,
+		Object = 7,
+		ObjectRange = 8,
+		NetworkChain = 9,
+		NetworkChainRange = 10,
+		NetworkChain32 = 11,
+		Polygon = 12,
+		PolygonRange = 13,
+		NestedPolygon = 14,
+		NestedPolygonRange = 15,
+		TerrainPatch = 16,
+		TerrainPatchFlags = 17,
+		TerrainPatchFlagsLOD = 18,
+		PatchTriangle = 23,
+		PatchTriangleCrossPool = 24,
+		PatchTriangleRange = 25,
+		PatchTriangleStrip = 26,
+		PatchTriangleStripCrossPool = 27,
+		PatchTriangleStripRange = 28,
+		PatchTriangleFan = 29,
+		PatchTriangleFanCrossPool = 30,
+		PatchTriangleFanRange = 31,
+		Comment8 = 32,
+		Comment16 = 33,
+		Comment32 = 34
+	};
+
+	/// Terrain patch flag bits.
+	inline constexpr uint8_t PATCH_PHYSICAL = 0x01;
+	inline constexpr uint8_t PATCH_OVERLAY = 0x02;
+
+	enum class PrimitiveType : uint8_t
+	{
+		Triangles,
+		TriangleStrip,
+		TriangleFan
+	};
+
+}
+
+/// -------------------------------------------------------
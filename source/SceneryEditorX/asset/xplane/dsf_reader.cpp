@@ -0,0 +1,790 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* dsf_reader.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "dsf_reader.h"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <SceneryEditorX/core/identifiers/md5.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	static_assert(std::endian::native == std::endian::little, "DSF decoding assumes a little endian host");
+
+	namespace
+	{
+		double MillisecondsSince(const std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		/// Bounds checked little endian cursor. The first overrun latches failure and every later read returns 0.
+		class ByteCursor
+		{
+		public:
+			explicit ByteCursor(const std::span<const uint8_t> data) : m_Data(data) {}
+
+			template<typename T>
+			T Read()
+			{
+				T value{};
+				if (m_Offset + sizeof(T) > m_Data.size())
+				{
+					m_Good = false;
+					m_Offset = m_Data.size();
+					return value;
+				}
+				std::memcpy(&value, m_Data.data() + m_Offset, sizeof(T));
+				m_Offset += sizeof(T);
+				return value;
+			}
+
+			std::span<const uint8_t> ReadBytes(const size_t size)
+			{
+				if (size > m_Data.size() - m_Offset)
+				{
+					m_Good = false;
+					m_Offset = m_Data.size();
+					return {};
+				}
+				const std::span<const uint8_t> bytes = m_Data.subspan(m_Offset, size);
+				m_Offset += size;
+				return bytes;
+			}
+
+			[[nodiscard]] bool IsGood() const { return m_Good; }
+			[[nodiscard]] bool AtEnd() const { return m_Offset >= m_Data.size(); }
+			[[nodiscard]] size_t GetOffset() const { return m_Offset; }
+
+		private:
+			std::span<const uint8_t> m_Data;
+			size_t m_Offset = 0;
+			bool m_Good = true;
+		};
+
+		/// Calls func(id, payload) for every atom in @p data. Returns false on a malformed atom header.
+		template<typename Func>
+		bool ForEachAtom(const std::span<const uint8_t> data, Func &&func)
+		{
+			size_t offset = 0;
+			while (offset < data.size())
+			{
+				if (data.size() - offset < DSF::ATOM_HEADER_SIZE)
+					return false;
+
+				uint32_t id;
+				uint32_t length;
+				std::memcpy(&id, data.data() + offset, sizeof(id));
+				std::memcpy(&length, data.data() + offset + 4, sizeof(length));
+				if (length < DSF::ATOM_HEADER_SIZE || length > data.size() - offset)
+					return false;
+
+				func(id, data.subspan(offset + DSF::ATOM_HEADER_SIZE, length - DSF::ATOM_HEADER_SIZE));
+				offset += length;
+			}
+			return true;
+		}
+
+		/// Null terminated strings packed back to back.
+		std::vector<std::string> ReadStringTable(const std::span<const uint8_t> data)
+		{
+			std::vector<std::string> strings;
+			const char *text = reinterpret_cast<const char *>(data.data());
+			size_t offset = 0;
+			while (offset < data.size())
+			{
+				const size_t length = strnlen(text + offset, data.size() - offset);
+				strings.emplace_back(text + offset, length);
+				offset += length + 1;
+			}
+			return strings;
+		}
+
+		/**
+		 * Decodes one planar numeric pool into @p pool. Every plane is stored as a whole, one after
+		 * another, so planes are decoded in order and scattered into the interleaved layout.
+		 */
+		template<typename T>
+		bool DecodePool(const std::span<const uint8_t> poolData, const std::span<const uint8_t> scaleData, DSFPointPool<T> &pool, std::string &error)
+		{
+			ByteCursor cursor(poolData);
+			const auto pointCount = cursor.Read<uint32_t>();
+			const auto planeCount = cursor.Read<uint8_t>();
+			if (!cursor.IsGood())
+			{
+				error = "truncated pool header";
+				return false;
+			}
+			if (scaleData.size() < static_cast<size_t>(planeCount) * 2 * sizeof(float))
+			{
+				error = "scale atom has fewer planes than its pool";
+				return false;
+			}
+			/// Each point needs at least one bit per plane of payload, except with run length encoding.
+			if (pointCount > poolData.size() * 128 + 1)
+			{
+				error = "pool point count exceeds its data";
+				return false;
+			}
+
+			pool = DSFPointPool<T>(pointCount, planeCount);
+			T *values = pool.GetRawValues().data();
+
+			for (uint32_t plane = 0; plane < planeCount; ++plane)
+			{
+				float scale;
+				float offset;
+				std::memcpy(&scale, scaleData.data() + plane * 8, sizeof(float));
+				std::memcpy(&offset, scaleData.data() + plane * 8 + 4, sizeof(float));
+				pool.SetScale(plane, scale, offset);
+
+				const auto encoding = static_cast<DSF::PoolEncoding>(cursor.Read<uint8_t>());
+				T *out = values + plane;
+				const bool runLength = encoding == DSF::PoolEncoding::RunLength || encoding == DSF::PoolEncoding::RunLengthDifferenced;
+				const bool differenced = encoding == DSF::PoolEncoding::Differenced || encoding == DSF::PoolEncoding::RunLengthDifferenced;
+				if (static_cast<uint8_t>(encoding) > static_cast<uint8_t>(DSF::PoolEncoding::RunLengthDifferenced))
+				{
+					error = "unknown pool encoding " + std::to_string(static_cast<int>(encoding));
+					return false;
+				}
+
+				if (!runLength)
+				{
+					const std::span<const uint8_t> raw = cursor.ReadBytes(static_cast<size_t>(pointCount) * sizeof(T));
+					if (!cursor.IsGood())
+						break;
+					for (uint32_t i = 0; i < pointCount; ++i)
+						std::memcpy(out + static_cast<size_t>(i) * planeCount, raw.data() + i * sizeof(T), sizeof(T));
+				}
+				else
+				{
+					uint32_t i = 0;
+					while (i < pointCount && cursor.IsGood())
+					{
+						const auto code = cursor.Read<uint8_t>();
+						const uint32_t run = code & 0x7F;
+						if (run > pointCount - i)
+						{
+							error = "run length overflows pool";
+							return false;
+						}
+						if (code & 0x80)
+						{
+							const T value = cursor.Read<T>();
+							for (uint32_t r = 0; r < run; ++r)
+								out[static_cast<size_t>(i + r) * planeCount] = value;
+						}
+						else
+						{
+							const std::span<const uint8_t> raw = cursor.ReadBytes(static_cast<size_t>(run) * sizeof(T));
+							for (uint32_t r = 0; r < run && cursor.IsGood(); ++r)
+								std::memcpy(out + static_cast<size_t>(i + r) * planeCount, raw.data() + r * sizeof(T), sizeof(T));
+						}
+						i += run;
+					}
+				}
+
+				if (differenced)
+				{
+					T sum = 0;
+					for (uint32_t i = 0; i < pointCount; ++i)
+					{
+						T &value = out[static_cast<size_t>(i) * planeCount];
+						sum = static_cast<T>(sum + value);
+						value = sum;
+					}
+				}
+			}
+
+			if (!cursor.IsGood())
+			{
+				error = "truncated pool data";
+				return false;
+			}
+			return true;
+		}
+
+		bool ParseDouble(const std::string &text, double &value)
+		{
+			const char *end = text.data() + text.size();
+			return std::from_chars(text.data(), end, value).ptr == end && !text.empty();
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	bool DSFReader::Open(const std::filesystem::path &path, const DSFReadOptions &options)
+	{
+		Close();
+		if (!m_File.Open(path))
+			return Fail("cannot map " + path.string());
+
+		m_Data = m_File.GetData();
+		m_Size = m_File.GetSize();
+		return Parse(options);
+	}
+
+	bool DSFReader::Load(const uint8_t *data, const size_t size, const DSFReadOptions &options)
+	{
+		Close();
+		m_Data = data;
+		m_Size = size;
+		return Parse(options);
+	}
+
+	void DSFReader::Close()
+	{
+		m_File.Close();
+		m_Data = nullptr;
+		m_Size = 0;
+		m_Commands = {};
+		m_Error.clear();
+		m_Properties.clear();
+		m_TerrainDefinitions.clear();
+		m_ObjectDefinitions.clear();
+		m_PolygonDefinitions.clear();
+		m_NetworkDefinitions.clear();
+		m_RasterDefinitions.clear();
+		m_Pools.clear();
+		m_Pools32.clear();
+		m_Stats = {};
+	}
+
+	bool DSFReader::Fail(std::string error)
+	{
+		m_Error = std::move(error);
+		m_Data = nullptr;
+		return false;
+	}
+
+	bool DSFReader::Parse(const DSFReadOptions &options)
+	{
+		const auto atomStart = std::chrono::steady_clock::now();
+		m_Stats.fileBytes = m_Size;
+
+		if (m_Size >= sizeof(DSF::SEVEN_ZIP_SIGNATURE) && std::memcmp(m_Data, DSF::SEVEN_ZIP_SIGNATURE, sizeof(DSF::SEVEN_ZIP_SIGNATURE)) == 0)
+			return Fail("DSF is 7z compressed; extract it before loading");
+		if (m_Size < DSF::HEADER_SIZE + DSF::FOOTER_SIZE || std::memcmp(m_Data, DSF::COOKIE, sizeof(DSF::COOKIE)) != 0)
+			return Fail("not a DSF file");
+
+		uint32_t version;
+		std::memcpy(&version, m_Data + sizeof(DSF::COOKIE), sizeof(version));
+		if (version != DSF::VERSION)
+			return Fail("unsupported DSF version " + std::to_string(version));
+
+		if (options.verifyChecksum)
+		{
+			const MD5::Digest digest = MD5::Compute(m_Data, m_Size - DSF::FOOTER_SIZE);
+			if (std::memcmp(digest.data(), m_Data + m_Size - DSF::FOOTER_SIZE, DSF::FOOTER_SIZE) != 0)
+				return Fail("DSF checksum mismatch");
+		}
+
+		const std::span<const uint8_t> atoms(m_Data + DSF::HEADER_SIZE, m_Size - DSF::HEADER_SIZE - DSF::FOOTER_SIZE);
+		std::vector<PoolSource> poolSources;
+		std::vector<PoolSource> pool32Sources;
+		bool good = true;
+
+		const bool walked = ForEachAtom(atoms, [&](const uint32_t id, const std::span<const uint8_t> payload) {
+			switch (id)
+			{
+				case DSF::Atom::Head:
+					good &= ForEachAtom(payload, [&](const uint32_t childID, const std::span<const uint8_t> child) {
+						if (childID != DSF::Atom::Properties)
+							return;
+						const std::vector<std::string> strings = ReadStringTable(child);
+						for (size_t i = 0; i + 1 < strings.size(); i += 2)
+							m_Properties.emplace_back(strings[i], strings[i + 1]);
+					});
+					break;
+
+				case DSF::Atom::Definitions:
+					good &= ForEachAtom(payload, [&](const uint32_t childID, const std::span<const uint8_t> child) {
+						switch (childID)
+						{
+							case DSF::Atom::TerrainTypes: m_TerrainDefinitions = ReadStringTable(child); break;
+							case DSF::Atom::Objects: m_ObjectDefinitions = ReadStringTable(child); break;
+							case DSF::Atom::Polygons: m_PolygonDefinitions = ReadStringTable(child); break;
+							case DSF::Atom::Networks: m_NetworkDefinitions = ReadStringTable(child); break;
+							case DSF::Atom::RasterNames: m_RasterDefinitions = ReadStringTable(child); break;
+							default: break;
+						}
+					});
+					break;
+
+				case DSF::Atom::Geodata:
+					good &= ReadGeodata(payload, poolSources, pool32Sources);
+					break;
+
+				case DSF::Atom::Commands:
+					m_Commands = payload;
+					break;
+
+				default:
+					/// DEMS and unknown atoms are skipped whole.
+					break;
+			}
+		});
+
+		if (!walked || !good)
+			return Fail(m_Error.empty() ? "malformed atom tree" : m_Error);
+		m_Stats.atomMs = MillisecondsSince(atomStart);
+
+		/// Pools are independent, so they decode in parallel. Each one is at most 64k points.
+		const auto decodeStart = std::chrono::steady_clock::now();
+		const uint32_t total = static_cast<uint32_t>(poolSources.size() + pool32Sources.size());
+		m_Pools.resize(poolSources.size());
+		m_Pools32.resize(pool32Sources.size());
+		std::vector<std::string> errors(total);
+
+		const auto decode = [&](const uint32_t index) {
+			if (index < poolSources.size())
+				DecodePool(poolSources[index].pool, poolSources[index].scale, m_Pools[index], errors[index]);
+			else
+			{
+				const size_t index32 = index - poolSources.size();
+				DecodePool(pool32Sources[index32].pool, pool32Sources[index32].scale, m_Pools32[index32], errors[index]);
+			}
+		};
+
+		if (options.parallelPools && total > 1)
+			(options.threadPool ? *options.threadPool : ThreadPool::Get()).ParallelFor(total, decode);
+		else
+		{
+			for (uint32_t i = 0; i < total; ++i)
+				decode(i);
+		}
+
+		for (uint32_t i = 0; i < total; ++i)
+		{
+			if (!errors[i].empty())
+			{
+				const bool is32 = i >= poolSources.size();
+				return Fail((is32 ? "PO32 " : "POOL ") + std::to_string(is32 ? i - poolSources.size() : i) + ": " + errors[i]);
+			}
+		}
+		m_Stats.poolDecodeMs = MillisecondsSince(decodeStart);
+
+		m_Stats.poolCount = static_cast<uint32_t>(m_Pools.size());
+		m_Stats.pool32Count = static_cast<uint32_t>(m_Pools32.size());
+		size_t memory = 0;
+		for (const DSFPool16 &pool : m_Pools)
+		{
+			m_Stats.pointCount += pool.GetPointCount();
+			memory += pool.GetMemoryUsage();
+		}
+		for (const DSFPool32 &pool : m_Pools32)
+		{
+			m_Stats.pointCount += pool.GetPointCount();
+			memory += pool.GetMemoryUsage();
+		}
+		for (const auto *table : { &m_TerrainDefinitions, &m_ObjectDefinitions, &m_PolygonDefinitions, &m_NetworkDefinitions, &m_RasterDefinitions })
+		{
+			for (const std::string &definition : *table)
+				memory += sizeof(std::string) + definition.capacity();
+		}
+		m_Stats.memoryBytes = memory;
+		return true;
+	}
+
+	bool DSFReader::ReadGeodata(const std::span<const uint8_t> geodata, std::vector<PoolSource> &pools, std::vector<PoolSource> &pools32)
+	{
+		/// Scale atoms pair with pool atoms of the same width by order, wherever they appear in GEOD.
+		std::vector<std::span<const uint8_t>> scales;
+		std::vector<std::span<const uint8_t>> scales32;
+		const bool walked = ForEachAtom(geodata, [&](const uint32_t id, const std::span<const uint8_t> payload) {
+			switch (id)
+			{
+				case DSF::Atom::Pool: pools.push_back({ payload, {} }); break;
+				case DSF::Atom::Pool32: pools32.push_back({ payload, {} }); break;
+				case DSF::Atom::Scale: scales.push_back(payload); break;
+				case DSF::Atom::Scale32: scales32.push_back(payload); break;
+				default: break;
+			}
+		});
+
+		if (!walked)
+		{
+			m_Error = "malformed GEOD atom";
+			return false;
+		}
+		if (scales.size() != pools.size() || scales32.size() != pools32.size())
+		{
+			m_Error = "GEOD has " + std::to_string(pools.size() + pools32.size()) + " pools but " +
+			          std::to_string(scales.size() + scales32.size()) + " scale atoms";
+			return false;
+		}
+
+		for (size_t i = 0; i < pools.size(); ++i)
+			pools[i].scale = scales[i];
+		for (size_t i = 0; i < pools32.size(); ++i)
+			pools32[i].scale = scales32[i];
+		return true;
+	}
+
+	/// -------------------------------------------------------
+
+	const std::string *DSFReader::FindProperty(const std::string_view name) const
+	{
+		const auto it = std::ranges::find_if(m_Properties, [&](const auto &property) { return property.first == name; });
+		return it == m_Properties.end() ? nullptr : &it->second;
+	}
+
+	bool DSFReader::GetBounds(double &west, double &south, double &east, double &north) const
+	{
+		const std::string *values[] = { FindProperty("sim/west"), FindProperty("sim/south"), FindProperty("sim/east"), FindProperty("sim/north") };
+		double *outputs[] = { &west, &south, &east, &north };
+		for (int i = 0; i < 4; ++i)
+		{
+			if (!values[i] || !ParseDouble(*values[i], *outputs[i]))
+				return false;
+		}
+		return true;
+	}
+
+	/// -------------------------------------------------------
+
+	bool DSFReader::ReadCommands(DSFCommandHandler &handler, DSFCommandStats *stats)
+	{
+		if (!m_Data)
+			return Fail(m_Error.empty() ? "no DSF loaded" : m_Error);
+
+		const auto start = std::chrono::steady_clock::now();
+		DSFCommandStats counts;
+		ByteCursor cursor(m_Commands);
+
+		uint32_t poolIndex = 0;
+		uint32_t junctionOffset = 0;
+		uint32_t definition = 0;
+		uint32_t roadSubtype = 0;
+		DSFPatch patch;
+		bool patchOpen = false;
+		std::string error;
+
+		const DSFPool16 *pool = m_Pools.empty() ? nullptr : &m_Pools[0];
+		const DSFPool32 *pool32 = m_Pools32.empty() ? nullptr : &m_Pools32[0];
+
+		/// Appends point @p index of the current pool to m_Coords.
+		const auto appendPoint = [&](const uint32_t index) -> bool {
+			if (!pool || index >= pool->GetPointCount())
+			{
+				error = "point index " + std::to_string(index) + " outside pool " + std::to_string(poolIndex);
+				return false;
+			}
+			const size_t at = m_Coords.size();
+			m_Coords.resize(at + pool->GetPlaneCount());
+			pool->GetPoint(index, m_Coords.data() + at);
+			return true;
+		};
+
+		const auto appendPoint32 = [&](const uint32_t index) -> bool {
+			if (!pool32 || index >= pool32->GetPointCount())
+			{
+				error = "point index " + std::to_string(index) + " outside 32-bit pool " + std::to_string(poolIndex);
+				return false;
+			}
+			const size_t at = m_Coords.size();
+			m_Coords.resize(at + pool32->GetPlaneCount());
+			pool32->GetPoint(index, m_Coords.data() + at);
+			return true;
+		};
+
+		/// Cross-pool vertices are padded or cut to the current pool's plane count so the stride stays uniform.
+		const auto appendCrossPoolPoint = [&](const uint32_t crossPool, const uint32_t index) -> bool {
+			if (crossPool >= m_Pools.size() || index >= m_Pools[crossPool].GetPointCount() || !pool)
+			{
+				error = "cross-pool vertex " + std::to_string(crossPool) + ":" + std::to_string(index) + " out of range";
+				return false;
+			}
+			const DSFPool16 &source = m_Pools[crossPool];
+			const uint32_t stride = pool->GetPlaneCount();
+			const size_t at = m_Coords.size();
+			m_Coords.resize(at + std::max(stride, source.GetPlaneCount()), 0.0);
+			source.GetPoint(index, m_Coords.data() + at);
+			m_Coords.resize(at + stride);
+			return true;
+		};
+
+		const auto emitPrimitive = [&](const DSF::PrimitiveType type) {
+			const uint32_t planes = pool ? pool->GetPlaneCount() : 0;
+			DSFPrimitive primitive;
+			primitive.type = type;
+			primitive.planeCount = planes;
+			primitive.vertexCount = planes ? static_cast<uint32_t>(m_Coords.size() / planes) : 0;
+			primitive.coords = m_Coords;
+			handler.OnPatchPrimitive(primitive);
+			++counts.primitives;
+			counts.vertices += primitive.vertexCount;
+		};
+
+		const auto emitPolygon = [&](const uint16_t parameter) {
+			DSFPolygon polygon;
+			polygon.definition = definition;
+			polygon.parameter = parameter;
+			polygon.planeCount = pool ? pool->GetPlaneCount() : 0;
+			polygon.coords = m_Coords;
+			polygon.windingEnds = m_WindingEnds;
+			handler.OnPolygon(polygon);
+			++counts.polygons;
+		};
+
+		const auto emitChain = [&]() {
+			DSFNetworkChain chain;
+			chain.definition = definition;
+			chain.subtype = roadSubtype;
+			chain.planeCount = pool32 ? pool32->GetPlaneCount() : 0;
+			chain.coords = m_Coords;
+			handler.OnNetworkChain(chain);
+			++counts.networkChains;
+		};
+
+		bool ok = true;
+		while (ok && !cursor.AtEnd())
+		{
+			const size_t commandOffset = cursor.GetOffset();
+			const auto command = static_cast<DSF::Command>(cursor.Read<uint8_t>());
+			m_Coords.clear();
+			m_WindingEnds.clear();
+
+			switch (command)
+			{
+				case DSF::Command::PoolSelect:
+				{
+					poolIndex = cursor.Read<uint16_t>();
+					pool = poolIndex < m_Pools.size() ? &m_Pools[poolIndex] : nullptr;
+					pool32 = poolIndex < m_Pools32.size() ? &m_Pools32[poolIndex] : nullptr;
+					break;
+				}
+				case DSF::Command::JunctionOffsetSelect: junctionOffset = cursor.Read<uint32_t>(); break;
+				case DSF::Command::SetDefinition8: definition = cursor.Read<uint8_t>(); break;
+				case DSF::Command::SetDefinition16: definition = cursor.Read<uint16_t>(); break;
+				case DSF::Command::SetDefinition32: definition = cursor.Read<uint32_t>(); break;
+				case DSF::Command::SetRoadSubtype8: roadSubtype = cursor.Read<uint8_t>(); break;
+
+				case DSF::Command::Object:
+				case DSF::Command::ObjectRange:
+				{
+					const uint32_t first = cursor.Read<uint16_t>();
+					const uint32_t last = command == DSF::Command::Object ? first + 1 : cursor.Read<uint16_t>();
+					for (uint32_t index = first; index < last && ok && cursor.IsGood(); ++index)
+					{
+						m_Coords.clear();
+						ok = appendPoint(index);
+						if (ok)
+						{
+							handler.OnObject({ definition, pool->GetPlaneCount(), m_Coords.data() });
+							++counts.objects;
+						}
+					}
+					break;
+				}
+
+				case DSF::Command::NetworkChain:
+				case DSF::Command::NetworkChain32:
+				{
+					const uint32_t count = cursor.Read<uint8_t>();
+					for (uint32_t i = 0; i < count && ok && cursor.IsGood(); ++i)
+					{
+						const uint32_t index = command == DSF::Command::NetworkChain ? cursor.Read<uint16_t>() + junctionOffset : cursor.Read<uint32_t>();
+						ok = cursor.IsGood() && appendPoint32(index);
+					}
+					if (ok && cursor.IsGood())
+						emitChain();
+					break;
+				}
+				case DSF::Command::NetworkChainRange:
+				{
+					const uint32_t first = cursor.Read<uint16_t>() + junctionOffset;
+					const uint32_t last = cursor.Read<uint16_t>() + junctionOffset;
+					for (uint32_t index = first; index < last && ok && cursor.IsGood(); ++index)
+						ok = appendPoint32(index);
+					if (ok && cursor.IsGood())
+						emitChain();
+					break;
+				}
+
+				case DSF::Command::Polygon:
+				{
+					const uint16_t parameter = cursor.Read<uint16_t>();
+					const uint32_t count = cursor.Read<uint8_t>();
+					for (uint32_t i = 0; i < count && ok && cursor.IsGood(); ++i)
+						ok = appendPoint(cursor.Read<uint16_t>());
+					if (ok && cursor.IsGood())
+					{
+						m_WindingEnds.push_back(count);
+						emitPolygon(parameter);
+					}
+					break;
+				}
+				case DSF::Command::PolygonRange:
+				{
+					const uint16_t parameter = cursor.Read<uint16_t>();
+					const uint32_t first = cursor.Read<uint16_t>();
+					const uint32_t last = cursor.Read<uint16_t>();
+					for (uint32_t index = first; index < last && ok && cursor.IsGood(); ++index)
+						ok = appendPoint(index);
+					if (ok && cursor.IsGood())
+					{
+						m_WindingEnds.push_back(last > first ? last - first : 0);
+						emitPolygon(parameter);
+					}
+					break;
+				}
+				case DSF::Command::NestedPolygon:
+				{
+					const uint16_t parameter = cursor.Read<uint16_t>();
+					const uint32_t windings = cursor.Read<uint8_t>();
+					uint32_t points = 0;
+					for (uint32_t w = 0; w < windings && ok && cursor.IsGood(); ++w)
+					{
+						const uint32_t count = cursor.Read<uint8_t>();
+						for (uint32_t i = 0; i < count && ok && cursor.IsGood(); ++i)
+							ok = appendPoint(cursor.Read<uint16_t>());
+						points += count;
+						m_WindingEnds.push_back(points);
+					}
+					if (ok && cursor.IsGood())
+						emitPolygon(parameter);
+					break;
+				}
+				case DSF::Command::NestedPolygonRange:
+				{
+					const uint16_t parameter = cursor.Read<uint16_t>();
+					const uint32_t windings = cursor.Read<uint8_t>();
+					uint32_t first = cursor.Read<uint16_t>();
+					uint32_t points = 0;
+					for (uint32_t w = 0; w < windings && ok && cursor.IsGood(); ++w)
+					{
+						const uint32_t last = cursor.Read<uint16_t>();
+						for (uint32_t index = first; index < last && ok; ++index)
+							ok = appendPoint(index);
+						points += last > first ? last - first : 0;
+						m_WindingEnds.push_back(points);
+						first = last;
+					}
+					if (ok && cursor.IsGood())
+						emitPolygon(parameter);
+					break;
+				}
+
+				case DSF::Command::TerrainPatch:
+				case DSF::Command::TerrainPatchFlags:
+				case DSF::Command::TerrainPatchFlagsLOD:
+				{
+					/// A new patch inherits flags and LOD from the previous one unless it sets them.
+					if (command != DSF::Command::TerrainPatch)
+						patch.flags = cursor.Read<uint8_t>();
+					if (command == DSF::Command::TerrainPatchFlagsLOD)
+					{
+						patch.nearLOD = cursor.Read<float>();
+						patch.farLOD = cursor.Read<float>();
+					}
+					if (!cursor.IsGood())
+						break;
+					if (patchOpen)
+						handler.OnEndPatch();
+					patch.definition = definition;
+					handler.OnBeginPatch(patch);
+					patchOpen = true;
+					++counts.patches;
+					break;
+				}
+
+				case DSF::Command::PatchTriangle:
+				case DSF::Command::PatchTriangleStrip:
+				case DSF::Command::PatchTriangleFan:
+				{
+					const uint32_t count = cursor.Read<uint8_t>();
+					for (uint32_t i = 0; i < count && ok && cursor.IsGood(); ++i)
+						ok = appendPoint(cursor.Read<uint16_t>());
+					if (ok && cursor.IsGood())
+						emitPrimitive(command == DSF::Command::PatchTriangle ? DSF::PrimitiveType::Triangles :
+						              command == DSF::Command::PatchTriangleStrip ? DSF::PrimitiveType::TriangleStrip : DSF::PrimitiveType::TriangleFan);
+					break;
+				}
+				case DSF::Command::PatchTriangleCrossPool:
+				case DSF::Command::PatchTriangleStripCrossPool:
+				case DSF::Command::PatchTriangleFanCrossPool:
+				{
+					const uint32_t count = cursor.Read<uint8_t>();
+					for (uint32_t i = 0; i < count && ok && cursor.IsGood(); ++i)
+					{
+						const uint32_t crossPool = cursor.Read<uint16_t>();
+						const uint32_t index = cursor.Read<uint16_t>();
+						ok = cursor.IsGood() && appendCrossPoolPoint(crossPool, index);
+					}
+					if (ok && cursor.IsGood())
+						emitPrimitive(command == DSF::Command::PatchTriangleCrossPool ? DSF::PrimitiveType::Triangles :
+						              command == DSF::Command::PatchTriangleStripCrossPool ? DSF::PrimitiveType::TriangleStrip : DSF::PrimitiveType::TriangleFan);
+					break;
+				}
+				case DSF::Command::PatchTriangleRange:
+				case DSF::Command::PatchTriangleStripRange:
+				case DSF::Command::PatchTriangleFanRange:
+				{
+					const uint32_t first = cursor.Read<uint16_t>();
+					const uint32_t last = cursor.Read<uint16_t>();
+					for (uint32_t index = first; index < last && ok && cursor.IsGood(); ++index)
+						ok = appendPoint(index);
+					if (ok && cursor.IsGood())
+						emitPrimitive(command == DSF::Command::PatchTriangleRange ? DSF::PrimitiveType::Triangles :
+						              command == DSF::Command::PatchTriangleStripRange ? DSF::PrimitiveType::TriangleStrip : DSF::PrimitiveType::TriangleFan);
+					break;
+				}
+
+				case DSF::Command::Comment8:
+				case DSF::Command::Comment16:
+				case DSF::Command::Comment32:
+				{
+					const size_t length = command == DSF::Command::Comment8 ? cursor.Read<uint8_t>() :
+					                      command == DSF::Command::Comment16 ? cursor.Read<uint16_t>() : cursor.Read<uint32_t>();
+					const std::span<const uint8_t> text = cursor.ReadBytes(length);
+					if (cursor.IsGood())
+						handler.OnComment({ reinterpret_cast<const char *>(text.data()), text.size() });
+					break;
+				}
+
+				default:
+					error = "unknown command " + std::to_string(static_cast<int>(command));
+					ok = false;
+					break;
+			}
+
+			if (ok && !cursor.IsGood())
+				error = "truncated command";
+			ok = ok && cursor.IsGood();
+			if (!ok)
+				error += " at command offset " + std::to_string(commandOffset);
+		}
+
+		if (patchOpen)
+			handler.OnEndPatch();
+
+		counts.ms = MillisecondsSince(start);
+		if (stats)
+			*stats = counts;
+
+		if (!ok)
+		{
+			m_Error = std::move(error);
+			return false;
+		}
+		return true;
+	}
+
+}
+
+/// -------------------------------------------------------
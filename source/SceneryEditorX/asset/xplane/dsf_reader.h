@@ -0,0 +1,274 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* dsf_reader.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "dsf_format.h"
+#include "SceneryEditorX/utils/filestreaming/mapped_file.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	class ThreadPool;
+
+	/**
+	 * @brief Decoded planar numeric point pool.
+	 *
+	 * Points stay quantized to the pool's integer type and are stored interleaved by point,
+	 * which keeps a full tile at 2 bytes per plane instead of 8. GetPoint() applies the
+	 * per-plane scale and offset.
+	 */
+	template<typename T>
+	class DSFPointPool
+	{
+	public:
+		DSFPointPool() = default;
+		DSFPointPool(const uint32_t pointCount, const uint32_t planeCount) : m_PointCount(pointCount), m_PlaneCount(planeCount),
+			m_Values(static_cast<size_t>(pointCount) * planeCount), m_Steps(planeCount, 1.0), m_Offsets(planeCount, 0.0)
+		{
+		}
+
+		[[nodiscard]] uint32_t GetPointCount() const { return m_PointCount; }
+		[[nodiscard]] uint32_t GetPlaneCount() const { return m_PlaneCount; }
+
+		/// Writes GetPlaneCount() values for point @p index to @p out.
+		void GetPoint(const uint32_t index, double *out) const
+		{
+			const T *values = &m_Values[static_cast<size_t>(index) * m_PlaneCount];
+			for (uint32_t plane = 0; plane < m_PlaneCount; ++plane)
+				out[plane] = m_Offsets[plane] + static_cast<double>(values[plane]) * m_Steps[plane];
+		}
+
+		[[nodiscard]] double GetValue(const uint32_t index, const uint32_t plane) const
+		{
+			return m_Offsets[plane] + static_cast<double>(m_Values[static_cast<size_t>(index) * m_PlaneCount + plane]) * m_Steps[plane];
+		}
+
+		/// Scale and offset as stored in the SCAL/SC32 atom: value = offset + raw / max(T) * scale.
+		void SetScale(const uint32_t plane, const double scale, const double offset)
+		{
+			m_Steps[plane] = scale == 0.0 ? 1.0 : scale / static_cast<double>(std::numeric_limits<T>::max());
+			m_Offsets[plane] = offset;
+		}
+
+		[[nodiscard]] double GetScale(const uint32_t plane) const { return m_Steps[plane] * static_cast<double>(std::numeric_limits<T>::max()); }
+		[[nodiscard]] double GetOffset(const uint32_t plane) const { return m_Offsets[plane]; }
+
+		[[nodiscard]] std::vector<T> &GetRawValues() { return m_Values; }
+		[[nodiscard]] const std::vector<T> &GetRawValues() const { return m_Values; }
+
+		[[nodiscard]] size_t GetMemoryUsage() const
+		{
+			return m_Values.capacity() * sizeof(T) + (m_Steps.capacity() + m_Offsets.capacity()) * sizeof(double);
+		}
+
+	private:
+		uint32_t m_PointCount = 0;
+		uint32_t m_PlaneCount = 0;
+		std::vector<T> m_Values;
+		std::vector<double> m_Steps;
+		std::vector<double> m_Offsets;
+	};
+
+	using DSFPool16 = DSFPointPool<uint16_t>;
+	using DSFPool32 = DSFPointPool<uint32_t>;
+
+	/// -------------------------------------------------------
+
+	/// Object placement. Planes are longitude, latitude, heading and optionally MSL elevation.
+	struct DSFObject
+	{
+		uint32_t definition = 0;
+		uint32_t planeCount = 0;
+		const double *point = nullptr;
+	};
+
+	/// Polygon with one or more windings; the first is the outer ring. Each point is planeCount doubles.
+	struct DSFPolygon
+	{
+		uint32_t definition = 0;
+		uint16_t parameter = 0;
+		uint32_t planeCount = 0;
+		std::span<const double> coords;
+		std::span<const uint32_t> windingEnds;	///< One past the last point of each winding
+	};
+
+	/// Road network chain. Planes are longitude, latitude, elevation, junction id and any bezier controls.
+	struct DSFNetworkChain
+	{
+		uint32_t definition = 0;
+		uint32_t subtype = 0;
+		uint32_t planeCount = 0;
+		std::span<const double> coords;
+	};
+
+	struct DSFPatch
+	{
+		uint32_t definition = 0;
+		uint8_t flags = 0;				///< DSF::PATCH_PHYSICAL | DSF::PATCH_OVERLAY
+		float nearLOD = 0.0f;
+		float farLOD = -1.0f;
+	};
+
+	/// Triangles, strip or fan of a terrain patch. Planes are longitude, latitude, elevation, normal x/z, then texture coordinates.
+	struct DSFPrimitive
+	{
+		DSF::PrimitiveType type = DSF::PrimitiveType::Triangles;
+		uint32_t planeCount = 0;
+		uint32_t vertexCount = 0;
+		std::span<const double> coords;
+	};
+
+	/**
+	 * @brief Receives the command section of a DSF in file order.
+	 *
+	 * Coordinates are decoded and passed in batches per entity. The spans point into scratch
+	 * buffers owned by the reader and are only valid for the duration of the call.
+	 */
+	class DSFCommandHandler
+	{
+	public:
+		virtual ~DSFCommandHandler() = default;
+
+		virtual void OnObject(const DSFObject &) {}
+		virtual void OnPolygon(const DSFPolygon &) {}
+		virtual void OnNetworkChain(const DSFNetworkChain &) {}
+		virtual void OnBeginPatch(const DSFPatch &) {}
+		virtual void OnPatchPrimitive(const DSFPrimitive &) {}
+		virtual void OnEndPatch() {}
+		virtual void OnComment(std::string_view) {}
+	};
+
+	/// -------------------------------------------------------
+
+	struct DSFReadOptions
+	{
+		bool parallelPools = true;		///< Decode point pools on worker threads
+		ThreadPool *threadPool = nullptr;	///< Defaults to ThreadPool::Get()
+		bool verifyChecksum = false;		///< Check the MD5 footer; costs one extra pass over the file
+	};
+
+	struct DSFReadStats
+	{
+		size_t fileBytes = 0;
+		uint32_t poolCount = 0;
+		uint32_t pool32Count = 0;
+		uint64_t pointCount = 0;
+		size_t memoryBytes = 0;			///< Decoded pools and definition tables
+		double atomMs = 0.0;			///< Walking the atom tree and reading tables
+		double poolDecodeMs = 0.0;
+	};
+
+	struct DSFCommandStats
+	{
+		uint64_t objects = 0;
+		uint64_t polygons = 0;
+		uint64_t networkChains = 0;
+		uint64_t patches = 0;
+		uint64_t primitives = 0;
+		uint64_t vertices = 0;
+		double ms = 0.0;
+	};
+
+	/**
+	 * @brief Reader for X-Plane DSF tiles.
+	 *
+	 * Open() maps the file, walks the atom tree, reads the properties and definition tables and
+	 * decodes every point pool, in parallel across pools. ReadCommands() then streams the
+	 * command section into a handler and can be called any number of times.
+	 *
+	 * Raster (DEMS) atoms are walked but not decoded. Compressed DSFs from the global scenery
+	 * are rejected with an error; they must be extracted from their 7z archive first. The MD5
+	 * footer is only checked when DSFReadOptions::verifyChecksum is set.
+	 */
+	class DSFReader
+	{
+	public:
+		using Properties = std::vector<std::pair<std::string, std::string>>;
+
+		DSFReader() = default;
+		DSFReader(const DSFReader &) = delete;
+		DSFReader &operator=(const DSFReader &) = delete;
+
+		bool Open(const std::filesystem::path &path, const DSFReadOptions &options = {});
+
+		/// Reads a DSF already in memory. @p data must stay valid until Close() or the next Load/Open.
+		bool Load(const uint8_t *data, size_t size, const DSFReadOptions &options = {});
+
+		void Close();
+
+		/// Streams the command section. Returns false and sets GetError() on malformed commands.
+		bool ReadCommands(DSFCommandHandler &handler, DSFCommandStats *stats = nullptr);
+
+		[[nodiscard]] bool IsOpen() const { return m_Data != nullptr; }
+		[[nodiscard]] const std::string &GetError() const { return m_Error; }
+
+		[[nodiscard]] const Properties &GetProperties() const { return m_Properties; }
+		[[nodiscard]] const std::string *FindProperty(std::string_view name) const;
+
+		/// Tile bounds from the sim/west, sim/south, sim/east and sim/north properties.
+		bool GetBounds(double &west, double &south, double &east, double &north) const;
+
+		[[nodiscard]] const std::vector<std::string> &GetTerrainDefinitions() const { return m_TerrainDefinitions; }
+		[[nodiscard]] const std::vector<std::string> &GetObjectDefinitions() const { return m_ObjectDefinitions; }
+		[[nodiscard]] const std::vector<std::string> &GetPolygonDefinitions() const { return m_PolygonDefinitions; }
+		[[nodiscard]] const std::vector<std::string> &GetNetworkDefinitions() const { return m_NetworkDefinitions; }
+		[[nodiscard]] const std::vector<std::string> &GetRasterDefinitions() const { return m_RasterDefinitions; }
+
+		[[nodiscard]] const std::vector<DSFPool16> &GetPools() const { return m_Pools; }
+		[[nodiscard]] const std::vector<DSFPool32> &GetPools32() const { return m_Pools32; }
+
+		[[nodiscard]] const DSFReadStats &GetStats() const { return m_Stats; }
+
+	private:
+		struct PoolSource
+		{
+			std::span<const uint8_t> pool;
+			std::span<const uint8_t> scale;
+		};
+
+		bool Parse(const DSFReadOptions &options);
+		bool ReadGeodata(std::span<const uint8_t> geodata, std::vector<PoolSource> &pools, std::vector<PoolSource> &pools32);
+		bool Fail(std::string error);
+
+		MappedFile m_File;
+		const uint8_t *m_Data = nullptr;
+		size_t m_Size = 0;
+		std::span<const uint8_t> m_Commands;
+		std::string m_Error;
+
+		Properties m_Properties;
+		std::vector<std::string> m_TerrainDefinitions;
+		std::vector<std::string> m_ObjectDefinitions;
+		std::vector<std::string> m_PolygonDefinitions;
+		std::vector<std::string> m_NetworkDefinitions;
+		std::vector<std::string> m_RasterDefinitions;
+		std::vector<DSFPool16> m_Pools;
+		std::vector<DSFPool32> m_Pools32;
+		DSFReadStats m_Stats;
+
+		/// Scratch buffers reused across commands.
+		std::vector<double> m_Coords;
+		std::vector<uint32_t> m_WindingEnds;
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,593 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* dsf_writer.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "dsf_writer.h"
+#include "dsf_format.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <SceneryEditorX/core/identifiers/md5.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	static_assert(std::endian::native == std::endian::little, "DSF encoding assumes a little endian host");
+
+	namespace
+	{
+		/// Pool indices are 16-bit and range commands take an exclusive end, so a pool holds at most 65535 points.
+		constexpr uint32_t MAX_POOL_POINTS = 65535;
+		constexpr uint32_t MAX_RAW = std::numeric_limits<uint16_t>::max();
+
+		double MillisecondsSince(const std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		template<typename T>
+		void Put(std::vector<uint8_t> &out, const T value)
+		{
+			const size_t at = out.size();
+			out.resize(at + sizeof(T));
+			std::memcpy(out.data() + at, &value, sizeof(T));
+		}
+
+		void PutCommand(std::vector<uint8_t> &out, const DSF::Command command)
+		{
+			out.push_back(static_cast<uint8_t>(command));
+		}
+
+		void PutAtom(std::vector<uint8_t> &out, const uint32_t id, const std::vector<uint8_t> &payload)
+		{
+			Put(out, id);
+			Put(out, static_cast<uint32_t>(payload.size() + DSF::ATOM_HEADER_SIZE));
+			out.insert(out.end(), payload.begin(), payload.end());
+		}
+
+		std::vector<uint8_t> StringTable(const std::vector<std::string> &strings)
+		{
+			std::vector<uint8_t> table;
+			for (const std::string &text : strings)
+			{
+				table.insert(table.end(), text.begin(), text.end());
+				table.push_back(0);
+			}
+			return table;
+		}
+
+		/// 16-bit per axis Morton code of a tile relative position, so nearby placements share pools.
+		uint32_t MortonKey(const double u, const double v)
+		{
+			const auto spread = [](uint32_t x) {
+				x = (x | (x << 8)) & 0x00FF00FF;
+				x = (x | (x << 4)) & 0x0F0F0F0F;
+				x = (x | (x << 2)) & 0x33333333;
+				x = (x | (x << 1)) & 0x55555555;
+				return x;
+			};
+			const auto quantize = [](const double t) { return static_cast<uint32_t>(std::clamp(t, 0.0, 1.0) * MAX_RAW); };
+			return spread(quantize(u)) | (spread(quantize(v)) << 1);
+		}
+
+		/// Run length encodes one plane: repeat runs of 3+ equal values, literal runs otherwise, at most 127 per run.
+		void EncodeRunLength(const uint16_t *values, const size_t count, std::vector<uint8_t> &out)
+		{
+			size_t i = 0;
+			while (i < count)
+			{
+				size_t repeat = 1;
+				while (i + repeat < count && repeat < 127 && values[i + repeat] == values[i])
+					++repeat;
+				if (repeat >= 3)
+				{
+					out.push_back(static_cast<uint8_t>(0x80 | repeat));
+					Put(out, values[i]);
+					i += repeat;
+					continue;
+				}
+
+				size_t literal = 0;
+				while (i + literal < count && literal < 127)
+				{
+					const size_t at = i + literal;
+					if (at + 2 < count && values[at] == values[at + 1] && values[at] == values[at + 2])
+						break;
+					++literal;
+				}
+				out.push_back(static_cast<uint8_t>(literal));
+				const size_t at = out.size();
+				out.resize(at + literal * sizeof(uint16_t));
+				std::memcpy(out.data() + at, values + i, literal * sizeof(uint16_t));
+				i += literal;
+			}
+		}
+
+		/// Appends the encoding byte and data of the smallest encoding of @p values.
+		void EncodePlane(const std::vector<uint16_t> &values, std::vector<uint8_t> &out)
+		{
+			std::vector<uint16_t> deltas(values.size());
+			uint16_t previous = 0;
+			for (size_t i = 0; i < values.size(); ++i)
+			{
+				deltas[i] = static_cast<uint16_t>(values[i] - previous);
+				previous = values[i];
+			}
+
+			std::vector<uint8_t> runLength;
+			std::vector<uint8_t> runLengthDeltas;
+			EncodeRunLength(values.data(), values.size(), runLength);
+			EncodeRunLength(deltas.data(), deltas.size(), runLengthDeltas);
+
+			/// Differenced without run lengths is never smaller than raw, and raw decodes fastest on ties.
+			const size_t rawSize = values.size() * sizeof(uint16_t);
+			if (rawSize <= runLength.size() && rawSize <= runLengthDeltas.size())
+			{
+				out.push_back(static_cast<uint8_t>(DSF::PoolEncoding::Raw));
+				const size_t at = out.size();
+				out.resize(at + rawSize);
+				std::memcpy(out.data() + at, values.data(), rawSize);
+			}
+			else if (runLength.size() <= runLengthDeltas.size())
+			{
+				out.push_back(static_cast<uint8_t>(DSF::PoolEncoding::RunLength));
+				out.insert(out.end(), runLength.begin(), runLength.end());
+			}
+			else
+			{
+				out.push_back(static_cast<uint8_t>(DSF::PoolEncoding::RunLengthDifferenced));
+				out.insert(out.end(), runLengthDeltas.begin(), runLengthDeltas.end());
+			}
+		}
+
+		/**
+		 * Picks the float offset and scale that cover [min, max] and quantizes the plane against
+		 * them. The SCAL atom stores floats, so both are rounded outward first and the values are
+		 * quantized against the rounded numbers the reader will see.
+		 */
+		void QuantizePlane(const std::vector<double> &plane, std::vector<uint16_t> &raw, float &scale, float &offset)
+		{
+			const auto [minIt, maxIt] = std::ranges::minmax_element(plane);
+			offset = static_cast<float>(*minIt);
+			if (static_cast<double>(offset) > *minIt)
+				offset = std::nextafter(offset, -std::numeric_limits<float>::infinity());
+
+			scale = static_cast<float>(*maxIt - static_cast<double>(offset));
+			if (static_cast<double>(offset) + static_cast<double>(scale) < *maxIt)
+				scale = std::nextafter(scale, std::numeric_limits<float>::infinity());
+
+			raw.resize(plane.size());
+			if (scale == 0.0f)
+			{
+				/// A zero scale reads back as offset + raw, which is exact here.
+				std::ranges::fill(raw, uint16_t(0));
+				return;
+			}
+
+			const double step = static_cast<double>(scale) / MAX_RAW;
+			for (size_t i = 0; i < plane.size(); ++i)
+			{
+				const double quantized = std::round((plane[i] - static_cast<double>(offset)) / step);
+				raw[i] = static_cast<uint16_t>(std::clamp(quantized, 0.0, static_cast<double>(MAX_RAW)));
+			}
+		}
+
+		enum class PlacementKind : uint8_t
+		{
+			Object,
+			Polygon,
+			Line
+		};
+
+		struct Placement
+		{
+			PlacementKind kind = PlacementKind::Object;
+			uint32_t definition = 0;
+			uint32_t source = 0;
+			uint32_t pointCount = 0;
+			uint32_t key = 0;
+		};
+
+		struct PoolLayout
+		{
+			uint32_t planeCount = 0;
+			uint32_t pointCount = 0;
+			std::vector<Placement> placements;
+
+			std::vector<uint8_t> pool;
+			std::vector<uint8_t> scale;
+			std::vector<uint8_t> commands;
+		};
+
+		/// Definition last set by the commands of one pool.
+		struct DefinitionState
+		{
+			PlacementKind kind = PlacementKind::Object;
+			int64_t definition = -1;
+		};
+
+		void SetDefinition(std::vector<uint8_t> &out, const uint32_t definition)
+		{
+			if (definition <= std::numeric_limits<uint8_t>::max())
+			{
+				PutCommand(out, DSF::Command::SetDefinition8);
+				Put(out, static_cast<uint8_t>(definition));
+			}
+			else if (definition <= std::numeric_limits<uint16_t>::max())
+			{
+				PutCommand(out, DSF::Command::SetDefinition16);
+				Put(out, static_cast<uint16_t>(definition));
+			}
+			else
+			{
+				PutCommand(out, DSF::Command::SetDefinition32);
+				Put(out, definition);
+			}
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	bool DSFWriter::Fail(std::string error)
+	{
+		m_Error = std::move(error);
+		return false;
+	}
+
+	bool DSFWriter::Write(const DSFOverlay &overlay, std::vector<uint8_t> &out, const DSFWriteOptions &options)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		m_Error.clear();
+		m_Stats = {};
+
+		const double west = overlay.west;
+		const double south = overlay.south;
+		const auto inTile = [&](const double lon, const double lat) {
+			return lon >= west && lon <= west + 1.0 && lat >= south && lat <= south + 1.0;
+		};
+
+		/// Definition tables, in first use order.
+		std::vector<std::string> objectDefinitions;
+		std::vector<std::string> polygonDefinitions;
+		std::unordered_map<std::string, uint32_t> objectLookup;
+		std::unordered_map<std::string, uint32_t> polygonLookup;
+		const auto intern = [](std::vector<std::string> &table, std::unordered_map<std::string, uint32_t> &lookup, const std::string &name) {
+			const auto [it, inserted] = lookup.try_emplace(name, static_cast<uint32_t>(table.size()));
+			if (inserted)
+				table.push_back(name);
+			return it->second;
+		};
+
+		/**
+		 * Placements grouped by plane count, since every point of a pool has the same planes.
+		 * Objects never share pools with polygons: their third plane is a heading, and mixing it
+		 * with a polygon's extra plane would stretch both scales.
+		 */
+		constexpr uint32_t POLYGON_GROUP = 0x100;
+		std::unordered_map<uint32_t, std::vector<Placement>> groups;
+
+		for (uint32_t i = 0; i < overlay.objects.size(); ++i)
+		{
+			const DSFOverlayObject &object = overlay.objects[i];
+			if (object.definition.empty())
+				return Fail("object " + std::to_string(i) + " has no definition");
+			if (!inTile(object.longitude, object.latitude))
+				return Fail("object " + std::to_string(i) + " lies outside the tile");
+
+			const uint32_t planes = object.elevation ? 4 : 3;
+			groups[planes].push_back({ PlacementKind::Object, intern(objectDefinitions, objectLookup, object.definition), i, 1,
+			                           MortonKey(object.longitude - west, object.latitude - south) });
+		}
+
+		const auto addPolygon = [&](const PlacementKind kind, const uint32_t index, const std::string &definition, const uint32_t planeCount,
+		                            const std::vector<const std::vector<double> *> &windings) -> bool {
+			const std::string label = (kind == PlacementKind::Line ? "line " : "polygon ") + std::to_string(index);
+			if (definition.empty())
+				return Fail(label + " has no definition");
+			if (planeCount < 2 || planeCount > std::numeric_limits<uint8_t>::max())
+				return Fail(label + " has " + std::to_string(planeCount) + " planes");
+			if (windings.empty() || windings.size() > std::numeric_limits<uint8_t>::max())
+				return Fail(label + " has " + std::to_string(windings.size()) + " windings");
+
+			size_t points = 0;
+			double minLon = west + 1.0, minLat = south + 1.0, maxLon = west, maxLat = south;
+			for (const std::vector<double> *winding : windings)
+			{
+				if (winding->empty() || winding->size() % planeCount)
+					return Fail(label + " has a winding that is not a whole number of points");
+				for (size_t p = 0; p < winding->size(); p += planeCount)
+				{
+					const double lon = (*winding)[p];
+					const double lat = (*winding)[p + 1];
+					if (!inTile(lon, lat))
+						return Fail(label + " lies outside the tile");
+					minLon = std::min(minLon, lon);
+					maxLon = std::max(maxLon, lon);
+					minLat = std::min(minLat, lat);
+					maxLat = std::max(maxLat, lat);
+				}
+				points += winding->size() / planeCount;
+			}
+			if (points > MAX_POOL_POINTS)
+				return Fail(label + " has more than " + std::to_string(MAX_POOL_POINTS) + " points");
+
+			groups[POLYGON_GROUP | planeCount].push_back({ kind, intern(polygonDefinitions, polygonLookup, definition), index, static_cast<uint32_t>(points),
+			                               MortonKey((minLon + maxLon) * 0.5 - west, (minLat + maxLat) * 0.5 - south) });
+			return true;
+		};
+
+		for (uint32_t i = 0; i < overlay.polygons.size(); ++i)
+		{
+			const DSFOverlayPolygon &polygon = overlay.polygons[i];
+			std::vector<const std::vector<double> *> windings;
+			for (const std::vector<double> &winding : polygon.windings)
+				windings.push_back(&winding);
+			if (!addPolygon(PlacementKind::Polygon, i, polygon.definition, polygon.planeCount, windings))
+				return false;
+		}
+		for (uint32_t i = 0; i < overlay.lines.size(); ++i)
+		{
+			const DSFOverlayLine &line = overlay.lines[i];
+			if (!addPolygon(PlacementKind::Line, i, line.definition, line.planeCount, { &line.coords }))
+				return false;
+		}
+
+		/// Partition each group along the Morton curve into pools, then order every pool by definition for range commands.
+		std::vector<uint32_t> groupKeys;
+		for (const auto &[key, placements] : groups)
+			groupKeys.push_back(key);
+		std::ranges::sort(groupKeys);
+
+		std::vector<PoolLayout> pools;
+		for (const uint32_t key : groupKeys)
+		{
+			const uint32_t planes = key & ~POLYGON_GROUP;
+			std::vector<Placement> &placements = groups[key];
+			std::ranges::stable_sort(placements, {}, &Placement::key);
+			const size_t firstPool = pools.size();
+			for (const Placement &placement : placements)
+			{
+				if (pools.size() == firstPool || pools.back().pointCount + placement.pointCount > MAX_POOL_POINTS)
+					pools.push_back({ planes, 0, {}, {}, {}, {} });
+				pools.back().placements.push_back(placement);
+				pools.back().pointCount += placement.pointCount;
+			}
+		}
+		for (PoolLayout &pool : pools)
+		{
+			std::ranges::stable_sort(pool.placements, [](const Placement &a, const Placement &b) {
+				return a.kind != b.kind ? a.kind < b.kind : a.definition < b.definition;
+			});
+		}
+		if (pools.size() > std::numeric_limits<uint16_t>::max() + 1u)
+			return Fail("overlay needs more than 65536 point pools");
+		m_Stats.layoutMs = MillisecondsSince(start);
+
+		/// Pools are independent: gather, quantize, encode and emit each one's commands on its own worker.
+		const auto encodeStart = std::chrono::steady_clock::now();
+		const auto encodePool = [&](const uint32_t poolIndex) {
+			PoolLayout &layout = pools[poolIndex];
+			const uint32_t planes = layout.planeCount;
+			std::vector<std::vector<double>> values(planes);
+			for (std::vector<double> &plane : values)
+				plane.reserve(layout.pointCount);
+
+			const auto gather = [&](const std::vector<double> &coords) {
+				for (size_t p = 0; p < coords.size(); p += planes)
+				{
+					for (uint32_t plane = 0; plane < planes; ++plane)
+						values[plane].push_back(coords[p + plane]);
+				}
+			};
+
+			std::vector<uint8_t> &commands = layout.commands;
+			PutCommand(commands, DSF::Command::PoolSelect);
+			Put(commands, static_cast<uint16_t>(poolIndex));
+
+			/// Each pool resets the definition so pools can be emitted in any order.
+			DefinitionState state;
+			uint32_t next = 0;
+			for (size_t i = 0; i < layout.placements.size();)
+			{
+				const Placement &placement = layout.placements[i];
+				if (state.kind != placement.kind || state.definition != placement.definition)
+				{
+					SetDefinition(commands, placement.definition);
+					state = { placement.kind, placement.definition };
+				}
+
+				const uint32_t first = next;
+				switch (placement.kind)
+				{
+					case PlacementKind::Object:
+					{
+						/// Consecutive objects of one definition occupy consecutive points.
+						size_t end = i;
+						while (end < layout.placements.size() && layout.placements[end].kind == PlacementKind::Object &&
+						       layout.placements[end].definition == placement.definition)
+						{
+							const DSFOverlayObject &object = overlay.objects[layout.placements[end].source];
+							values[0].push_back(object.longitude);
+							values[1].push_back(object.latitude);
+							values[2].push_back(object.heading);
+							if (planes == 4)
+								values[3].push_back(*object.elevation);
+							++end;
+						}
+						next += static_cast<uint32_t>(end - i);
+						if (next - first == 1)
+						{
+							PutCommand(commands, DSF::Command::Object);
+							Put(commands, static_cast<uint16_t>(first));
+						}
+						else
+						{
+							PutCommand(commands, DSF::Command::ObjectRange);
+							Put(commands, static_cast<uint16_t>(first));
+							Put(commands, static_cast<uint16_t>(next));
+						}
+						i = end;
+						continue;
+					}
+					case PlacementKind::Polygon:
+					{
+						const DSFOverlayPolygon &polygon = overlay.polygons[placement.source];
+						for (const std::vector<double> &winding : polygon.windings)
+							gather(winding);
+						next += placement.pointCount;
+
+						if (polygon.windings.size() == 1)
+						{
+							PutCommand(commands, DSF::Command::PolygonRange);
+							Put(commands, polygon.parameter);
+							Put(commands, static_cast<uint16_t>(first));
+							Put(commands, static_cast<uint16_t>(next));
+						}
+						else
+						{
+							PutCommand(commands, DSF::Command::NestedPolygonRange);
+							Put(commands, polygon.parameter);
+							Put(commands, static_cast<uint8_t>(polygon.windings.size()));
+							uint32_t end = first;
+							Put(commands, static_cast<uint16_t>(end));
+							for (const std::vector<double> &winding : polygon.windings)
+							{
+								end += static_cast<uint32_t>(winding.size() / planes);
+								Put(commands, static_cast<uint16_t>(end));
+							}
+						}
+						break;
+					}
+					case PlacementKind::Line:
+					{
+						const DSFOverlayLine &line = overlay.lines[placement.source];
+						gather(line.coords);
+						next += placement.pointCount;
+						PutCommand(commands, DSF::Command::PolygonRange);
+						Put(commands, static_cast<uint16_t>(line.closed ? 1 : 0));
+						Put(commands, static_cast<uint16_t>(first));
+						Put(commands, static_cast<uint16_t>(next));
+						break;
+					}
+				}
+				++i;
+			}
+
+			Put(layout.pool, layout.pointCount);
+			Put(layout.pool, static_cast<uint8_t>(planes));
+			std::vector<uint16_t> raw;
+			for (uint32_t plane = 0; plane < planes; ++plane)
+			{
+				float scale;
+				float offset;
+				QuantizePlane(values[plane], raw, scale, offset);
+				EncodePlane(raw, layout.pool);
+				Put(layout.scale, scale);
+				Put(layout.scale, offset);
+			}
+		};
+
+		const uint32_t poolCount = static_cast<uint32_t>(pools.size());
+		if (options.parallelPools && poolCount > 1)
+			(options.threadPool ? *options.threadPool : ThreadPool::Get()).ParallelFor(poolCount, encodePool);
+		else
+		{
+			for (uint32_t i = 0; i < poolCount; ++i)
+				encodePool(i);
+		}
+		m_Stats.encodeMs = MillisecondsSince(encodeStart);
+
+		/// Assemble the atoms.
+		out.assign(DSF::COOKIE, DSF::COOKIE + sizeof(DSF::COOKIE));
+		Put(out, DSF::VERSION);
+
+		std::vector<std::string> properties = {
+			"sim/west", std::to_string(overlay.west), "sim/east", std::to_string(overlay.west + 1),
+			"sim/south", std::to_string(overlay.south), "sim/north", std::to_string(overlay.south + 1),
+			"sim/planet", "earth", "sim/overlay", "1", "sim/creation_agent", "Scenery Editor X"
+		};
+		for (const auto &[name, value] : overlay.properties)
+		{
+			properties.push_back(name);
+			properties.push_back(value);
+		}
+		std::vector<uint8_t> head;
+		PutAtom(head, DSF::Atom::Properties, StringTable(properties));
+		PutAtom(out, DSF::Atom::Head, head);
+
+		std::vector<uint8_t> definitions;
+		PutAtom(definitions, DSF::Atom::TerrainTypes, {});
+		PutAtom(definitions, DSF::Atom::Objects, StringTable(objectDefinitions));
+		PutAtom(definitions, DSF::Atom::Polygons, StringTable(polygonDefinitions));
+		PutAtom(definitions, DSF::Atom::Networks, {});
+		PutAtom(definitions, DSF::Atom::RasterNames, {});
+		PutAtom(out, DSF::Atom::Definitions, definitions);
+
+		std::vector<uint8_t> geodata;
+		for (const PoolLayout &pool : pools)
+			PutAtom(geodata, DSF::Atom::Pool, pool.pool);
+		for (const PoolLayout &pool : pools)
+			PutAtom(geodata, DSF::Atom::Scale, pool.scale);
+		PutAtom(out, DSF::Atom::Geodata, geodata);
+
+		std::vector<uint8_t> commands;
+		for (const PoolLayout &pool : pools)
+			commands.insert(commands.end(), pool.commands.begin(), pool.commands.end());
+		PutAtom(out, DSF::Atom::Commands, commands);
+
+		const MD5::Digest digest = MD5::Compute(out.data(), out.size());
+		out.insert(out.end(), digest.begin(), digest.end());
+
+		m_Stats.outputBytes = out.size();
+		m_Stats.poolCount = poolCount;
+		for (const PoolLayout &pool : pools)
+			m_Stats.pointCount += pool.pointCount;
+		m_Stats.totalMs = MillisecondsSince(start);
+		return true;
+	}
+
+	bool DSFWriter::Save(const DSFOverlay &overlay, const std::filesystem::path &path, const DSFWriteOptions &options)
+	{
+		std::vector<uint8_t> bytes;
+		if (!Write(overlay, bytes, options))
+			return false;
+
+		std::filesystem::path temp = path;
+		temp += ".tmp";
+		{
+			std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+			if (!file)
+				return Fail("cannot write " + temp.string());
+			file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+			if (!file)
+				return Fail("cannot write " + temp.string());
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temp, path, error);
+		if (error)
+		{
+			std::filesystem::remove(temp, error);
+			return Fail("cannot replace " + path.string());
+		}
+		return true;
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,112 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* dsf_writer.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	class ThreadPool;
+
+	struct DSFOverlayObject
+	{
+		std::string definition;				///< Library or relative path of the .obj/.agp
+		double longitude = 0.0;
+		double latitude = 0.0;
+		double heading = 0.0;				///< Degrees true
+		std::optional<double> elevation;	///< MSL metres; unset drapes the object on the terrain
+	};
+
+	/// Polygon placement such as a facade, forest or draped polygon.
+	struct DSFOverlayPolygon
+	{
+		std::string definition;
+		uint16_t parameter = 0;				///< Definition specific, e.g. facade height or forest density
+		uint32_t planeCount = 2;			///< Longitude, latitude, then any per-point extras (bezier controls, UVs)
+		std::vector<std::vector<double>> windings;	///< planeCount values per point; the first winding is the outer ring
+	};
+
+	/// Line placement (.lin). Written as a single winding polygon whose parameter marks it closed.
+	struct DSFOverlayLine
+	{
+		std::string definition;
+		bool closed = false;
+		uint32_t planeCount = 2;
+		std::vector<double> coords;
+	};
+
+	/// Everything written to one overlay tile.
+	struct DSFOverlay
+	{
+		int west = 0;						///< Tile south-west corner in whole degrees
+		int south = 0;
+		std::vector<std::pair<std::string, std::string>> properties;	///< Extra properties, e.g. sim/exclude_obj
+		std::vector<DSFOverlayObject> objects;
+		std::vector<DSFOverlayPolygon> polygons;
+		std::vector<DSFOverlayLine> lines;
+	};
+
+	struct DSFWriteOptions
+	{
+		bool parallelPools = true;			///< Quantize and encode point pools on worker threads
+		ThreadPool *threadPool = nullptr;	///< Defaults to ThreadPool::Get()
+	};
+
+	struct DSFWriteStats
+	{
+		size_t outputBytes = 0;
+		uint32_t poolCount = 0;
+		uint64_t pointCount = 0;
+		double layoutMs = 0.0;				///< Definition tables and pool partitioning
+		double encodeMs = 0.0;				///< Quantizing and encoding the pools
+		double totalMs = 0.0;
+	};
+
+	/**
+	 * @brief Writes overlay DSF tiles from object, polygon and line placements.
+	 *
+	 * Definitions are deduplicated into the OBJT and POLY tables. Placements are partitioned
+	 * into spatially coherent 16-bit pools, and each pool plane is scaled to its own min/max,
+	 * so precision follows the extent of the pool rather than the whole tile. Every plane is
+	 * stored with whichever of the four DSF encodings is smallest. Within a pool, placements
+	 * are grouped by definition so consecutive points collapse into range commands. The file
+	 * ends with the MD5 footer X-Plane checks.
+	 */
+	class DSFWriter
+	{
+	public:
+		/// Encodes @p overlay into @p out. Returns false and sets GetError() on invalid placements.
+		bool Write(const DSFOverlay &overlay, std::vector<uint8_t> &out, const DSFWriteOptions &options = {});
+
+		/// Writes to a temporary file next to @p path and renames it into place.
+		bool Save(const DSFOverlay &overlay, const std::filesystem::path &path, const DSFWriteOptions &options = {});
+
+		[[nodiscard]] const std::string &GetError() const { return m_Error; }
+		[[nodiscard]] const DSFWriteStats &GetStats() const { return m_Stats; }
+
+	private:
+		bool Fail(std::string error);
+
+		std::string m_Error;
+		DSFWriteStats m_Stats;
+	};
+
+}
+
+/// -------------------------------------------------------
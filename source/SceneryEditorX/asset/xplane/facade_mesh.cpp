@@ -0,0 +1,511 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* facade_mesh.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "facade_mesh.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <Math/includes/tessellation.h>
+#include <X-PlaneSceneryLibrary/XPFac.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		/// Upper bound on repeated panels, so a mistyped length cannot generate millions of quads.
+		constexpr int MAX_REPEATS = 4096;
+
+		/// A run of one panel along an axis: where it lies in metres and which texture strip it shows.
+		struct Strip
+		{
+			float start;
+			float end;
+			float texStart;
+			float texEnd;
+		};
+
+		float PanelWidth(const std::vector<XPAsset::FacPanel> &panels, const float scale)
+		{
+			float width = 0.0f;
+			for (const XPAsset::FacPanel &panel : panels)
+				width += std::abs(panel.fEnd - panel.fStart) * scale;
+			return width;
+		}
+
+		/// Lays out first, then repeated middle panels, then last panels, stretched to exactly @p target metres.
+		void FillAxis(const std::vector<XPAsset::FacPanel> &first, const std::vector<XPAsset::FacPanel> &middle, const std::vector<XPAsset::FacPanel> &last,
+		              const float scale, const float target, std::vector<Strip> &out)
+		{
+			out.clear();
+			const float fixed = PanelWidth(first, scale) + PanelWidth(last, scale);
+			const float repeat = PanelWidth(middle, scale);
+			int count = 0;
+			if (repeat > 0.0f)
+			{
+				const int minimum = first.empty() && last.empty() ? 1 : 0;
+				count = std::clamp(static_cast<int>(std::lround((target - fixed) / repeat)), minimum, MAX_REPEATS);
+			}
+
+			const float natural = fixed + repeat * static_cast<float>(count);
+			if (natural <= 0.0f)
+			{
+				out.push_back({0.0f, target, 0.0f, 1.0f});
+				return;
+			}
+
+			const float stretch = target / natural;
+			float position = 0.0f;
+			const auto emit = [&](const std::vector<XPAsset::FacPanel> &panels)
+			{
+				for (const XPAsset::FacPanel &panel : panels)
+				{
+					const float width = std::abs(panel.fEnd - panel.fStart) * scale * stretch;
+					out.push_back({position, position + width, panel.fStart, panel.fEnd});
+					position += width;
+				}
+			};
+			emit(first);
+			for (int i = 0; i < count; ++i)
+				emit(middle);
+			emit(last);
+			out.back().end = target;
+		}
+
+		bool HeadingInRange(const float heading, const float minimum, const float maximum)
+		{
+			return minimum <= maximum ? heading >= minimum && heading <= maximum : heading >= minimum || heading <= maximum;
+		}
+
+		float WrapHeading(const float heading)
+		{
+			const float wrapped = std::fmod(heading, 360.0f);
+			return wrapped < 0.0f ? wrapped + 360.0f : wrapped;
+		}
+
+		Vec3 NormalizeOr(const Vec3 &vector, const Vec3 &fallback)
+		{
+			const float length = std::sqrt(vector.x * vector.x + vector.y * vector.y + vector.z * vector.z);
+			return length > 1e-12f ? vector / length : fallback;
+		}
+
+		uint32_t Bucket(const float value, const float size)
+		{
+			return static_cast<uint32_t>(std::max(0.0f, std::floor(value / size)));
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	size_t FacadeSegmentCache::KeyHash::operator()(const Key &key) const noexcept
+	{
+		uint64_t hash = reinterpret_cast<uintptr_t>(key.facade) * 0x9e3779b97f4a7c15ull;
+		hash ^= (static_cast<uint64_t>(key.wall) << 40 | static_cast<uint64_t>(key.heightKey) << 20) ^ key.lengthBucket;
+		hash ^= hash >> 29;
+		hash *= 0xbf58476d1ce4e5b9ull;
+		return static_cast<size_t>(hash ^ (hash >> 32));
+	}
+
+	const FacadeSegmentCache::Entry *FacadeSegmentCache::Find(const Key &key)
+	{
+		const auto it = m_Entries.find(key);
+		if (it == m_Entries.end())
+		{
+			++m_Misses;
+			return nullptr;
+		}
+		++m_Hits;
+		return &it->second;
+	}
+
+	const FacadeSegmentCache::Entry &FacadeSegmentCache::Insert(const Key &key, Entry entry)
+	{
+		return m_Entries.insert_or_assign(key, std::move(entry)).first->second;
+	}
+
+	void FacadeSegmentCache::Erase(const XPAsset::Fac *facade)
+	{
+		std::erase_if(m_Entries, [facade](const auto &entry) { return entry.first.facade == facade; });
+	}
+
+	void FacadeSegmentCache::Clear()
+	{
+		m_Entries.clear();
+		m_Hits = 0;
+		m_Misses = 0;
+	}
+
+	/// -------------------------------------------------------
+
+	FacadeGenerator::FacadeGenerator(const XPAsset::Fac &facade, FacadeSegmentCache *cache, const FacadeMeshOptions &options)
+		: m_Facade(&facade), m_Cache(cache), m_Options(options)
+	{
+	}
+
+	void FacadeGenerator::SetFootprint(std::vector<DVec2> footprint, const float height)
+	{
+		m_Footprint = std::move(footprint);
+		m_Edges.assign(GetEdgeCount(), {});
+		m_DirtyEdges.assign(m_Edges.size(), 1);
+		SetHeight(height);
+	}
+
+	void FacadeGenerator::MoveNode(const uint32_t node, const DVec2 &position)
+	{
+		if (node >= m_Footprint.size())
+			return;
+
+		m_Footprint[node] = position;
+		const auto edgeCount = static_cast<uint32_t>(m_Edges.size());
+		if (node < edgeCount)
+			m_DirtyEdges[node] = 1;
+		if (node > 0)
+			m_DirtyEdges[node - 1] = 1;
+		else if (edgeCount == m_Footprint.size() && edgeCount > 0)
+			m_DirtyEdges[edgeCount - 1] = 1;
+		m_DirtyRoof = true;
+		m_DirtyMesh = true;
+	}
+
+	void FacadeGenerator::SetHeight(const float height)
+	{
+		m_Height = height;
+
+		/// Type 2: the lowest floor that reaches the height, or the tallest one.
+		m_Floor = 0;
+		const std::vector<XPAsset::FacFloor> &floors = m_Facade->Floors;
+		for (uint32_t i = 0; i < floors.size(); ++i)
+		{
+			const float floorHeight = floors[i].GetHeight();
+			const float bestHeight = floors[m_Floor].GetHeight();
+			const bool reaches = floorHeight >= height;
+			const bool bestReaches = bestHeight >= height;
+			if ((reaches && (!bestReaches || floorHeight < bestHeight)) || (!reaches && !bestReaches && floorHeight > bestHeight))
+				m_Floor = i;
+		}
+		InvalidateAll();
+	}
+
+	uint32_t FacadeGenerator::GetEdgeCount() const
+	{
+		const auto count = static_cast<uint32_t>(m_Footprint.size());
+		if (count < 2)
+			return 0;
+		return m_Facade->bRing && count >= 3 ? count : count - 1;
+	}
+
+	void FacadeGenerator::InvalidateAll()
+	{
+		std::ranges::fill(m_DirtyEdges, 1);
+		m_DirtyRoof = true;
+		m_DirtyMesh = true;
+	}
+
+	/// -------------------------------------------------------
+
+	void FacadeGenerator::LayoutWall(const uint32_t wall, const float length, FacadeSegmentCache::Entry &out) const
+	{
+		const XPAsset::FacWall &facadeWall = (*m_Facade->GetWalls(m_Floor))[wall];
+		out.length = length;
+
+		if (!m_Facade->bType2)
+		{
+			out.height = (static_cast<float>(Bucket(m_Height, m_Options.heightBucket)) + 0.5f) * m_Options.heightBucket;
+
+			std::vector<Strip> across;
+			std::vector<Strip> up;
+			FillAxis(facadeWall.Left, facadeWall.Center, facadeWall.Right, facadeWall.fScaleS, length, across);
+			FillAxis(facadeWall.Bottom, facadeWall.Middle, facadeWall.Top, facadeWall.fScaleT, out.height, up);
+
+			out.vertices.reserve(across.size() * up.size() * 4);
+			out.indices.reserve(across.size() * up.size() * 6);
+			for (const Strip &column : across)
+			{
+				for (const Strip &row : up)
+				{
+					const auto base = static_cast<uint32_t>(out.vertices.size());
+					const Vec3 normal(0.0f, 0.0f, -1.0f);
+					out.vertices.push_back({Vec3(column.start, row.start, 0.0f), normal, Vec2(column.texStart, row.texStart)});
+					out.vertices.push_back({Vec3(column.end, row.start, 0.0f), normal, Vec2(column.texEnd, row.texStart)});
+					out.vertices.push_back({Vec3(column.end, row.end, 0.0f), normal, Vec2(column.texEnd, row.texEnd)});
+					out.vertices.push_back({Vec3(column.start, row.end, 0.0f), normal, Vec2(column.texStart, row.texEnd)});
+
+					/// Counter-clockwise seen from -Z.
+					out.indices.insert(out.indices.end(), {base, base + 2, base + 1, base, base + 3, base + 2});
+				}
+			}
+			return;
+		}
+
+		/// Type 2: the widest spelling that fits, or the narrowest if none does.
+		const XPAsset::FacFloor &floor = m_Facade->Floors[m_Floor];
+		out.height = floor.GetHeight();
+		const std::vector<uint32_t> *best = nullptr;
+		float bestWidth = 0.0f;
+		for (const std::vector<uint32_t> &spelling : facadeWall.Spellings)
+		{
+			float width = 0.0f;
+			for (const uint32_t segment : spelling)
+				width += floor.Segments[segment].fWidth;
+			const bool fits = width <= length;
+			const bool bestFits = best && bestWidth <= length;
+			if (!best || (fits && (!bestFits || width > bestWidth)) || (!fits && !bestFits && width < bestWidth))
+			{
+				best = &spelling;
+				bestWidth = width;
+			}
+		}
+		if (!best || bestWidth <= 0.0f)
+			return;
+
+		const float stretch = length / bestWidth;
+		float offset = 0.0f;
+		for (const uint32_t segmentIndex : *best)
+		{
+			const XPAsset::FacSegment &segment = floor.Segments[segmentIndex];
+			const auto base = static_cast<uint32_t>(out.vertices.size());
+			for (const XPAsset::Vertex &vertex : segment.Vertices)
+			{
+				const Vec3 normal = NormalizeOr(Vec3(vertex.NX / stretch, vertex.NY, vertex.NZ), Vec3(0.0f, 0.0f, -1.0f));
+				out.vertices.push_back({Vec3((offset + vertex.X) * stretch, vertex.Y, vertex.Z), normal, Vec2(vertex.U, vertex.V)});
+			}
+			for (const uint32_t index : segment.Indices)
+				out.indices.push_back(base + index);
+			for (const XPAsset::FacAttachment &attachment : segment.Attachments)
+				out.objects.push_back({attachment.intObject, Vec3((offset + attachment.X) * stretch, attachment.Y, attachment.Z), attachment.fHeading, attachment.bDraped});
+			offset += segment.fWidth;
+		}
+	}
+
+	void FacadeGenerator::BuildEdge(const uint32_t edge)
+	{
+		EdgeMesh &mesh = m_Edges[edge];
+		mesh.vertices.clear();
+		mesh.indices.clear();
+		mesh.objects.clear();
+		++m_Pending.edgesBuilt;
+
+		const std::vector<XPAsset::FacWall> *walls = m_Facade->GetWalls(m_Floor);
+		if (!walls)
+			return;
+
+		DVec2 start = m_Footprint[edge];
+		DVec2 end = m_Footprint[(edge + 1) % m_Footprint.size()];
+		if (m_Reversed)
+			std::swap(start, end);
+		const double dx = end.x - start.x;
+		const double dz = end.y - start.y;
+		const double edgeLength = std::sqrt(dx * dx + dz * dz);
+		if (!(edgeLength > 1e-6))
+			return;
+
+		/// Edge frame: X along the edge, Y up, Z into the building. Walls face -Z, i.e. outwards.
+		const Vec3 along(static_cast<float>(dx / edgeLength), 0.0f, static_cast<float>(dz / edgeLength));
+		const Vec3 inward(-along.z, 0.0f, along.x);
+		const float facing = WrapHeading(static_cast<float>(std::atan2(-inward.x, inward.z) * 180.0 / std::numbers::pi));
+		const auto length = static_cast<float>(edgeLength);
+
+		/// First wall that matches the width and facing, then the first that matches the width, then the first.
+		uint32_t wall = 0;
+		bool widthMatch = false;
+		for (uint32_t i = 0; i < walls->size(); ++i)
+		{
+			const XPAsset::FacWall &candidate = (*walls)[i];
+			if (length < candidate.fMinWidth || length > candidate.fMaxWidth)
+				continue;
+			if (HeadingInRange(facing, candidate.fMinHeading, candidate.fMaxHeading))
+			{
+				wall = i;
+				break;
+			}
+			if (!widthMatch)
+			{
+				wall = i;
+				widthMatch = true;
+			}
+		}
+
+		const uint32_t lengthBucket = Bucket(length, m_Options.lengthBucket);
+		const float bucketLength = (static_cast<float>(lengthBucket) + 0.5f) * m_Options.lengthBucket;
+		const FacadeSegmentCache::Key key = {m_Facade, wall, lengthBucket, m_Facade->bType2 ? m_Floor : Bucket(m_Height, m_Options.heightBucket)};
+
+		const FacadeSegmentCache::Entry *layout = m_Cache ? m_Cache->Find(key) : nullptr;
+		FacadeSegmentCache::Entry local;
+		if (layout)
+			++m_Pending.cacheHits;
+		else
+		{
+			++m_Pending.cacheMisses;
+			LayoutWall(wall, bucketLength, local);
+			layout = m_Cache ? &m_Cache->Insert(key, std::move(local)) : &local;
+		}
+
+		/// Stretch the bucket's layout to the exact edge; type 1 walls also stretch to the exact height.
+		const float stretchX = length / layout->length;
+		const float stretchY = !m_Facade->bType2 && layout->height > 0.0f ? m_Height / layout->height : 1.0f;
+		const Vec3 up(0.0f, 1.0f, 0.0f);
+		const Vec3 origin(static_cast<float>(start.x), 0.0f, static_cast<float>(start.y));
+
+		mesh.vertices.reserve(layout->vertices.size());
+		for (const FacadeVertex &vertex : layout->vertices)
+		{
+			const Vec3 normal = NormalizeOr(Vec3(vertex.normal.x / stretchX, vertex.normal.y / stretchY, vertex.normal.z), Vec3(0.0f, 0.0f, -1.0f));
+			FacadeVertex &out = mesh.vertices.emplace_back();
+			out.position = origin + along * (vertex.position.x * stretchX) + up * (vertex.position.y * stretchY) + inward * vertex.position.z;
+			out.normal = along * normal.x + up * normal.y + inward * normal.z;
+			out.texcoord = vertex.texcoord;
+		}
+		mesh.indices = layout->indices;
+		for (const FacadeObjectPlacement &object : layout->objects)
+		{
+			FacadeObjectPlacement &out = mesh.objects.emplace_back(object);
+			out.position = origin + along * (object.position.x * stretchX) + up * object.position.y + inward * object.position.z;
+			out.heading = WrapHeading(facing + object.heading);
+		}
+	}
+
+	void FacadeGenerator::BuildRoof()
+	{
+		m_Roof.vertices.clear();
+		m_Roof.indices.clear();
+		m_Pending.roofBuilt = true;
+
+		const XPAsset::Fac &facade = *m_Facade;
+		if (!facade.bRing || m_Footprint.size() < 3 || !facade.GetWalls(m_Floor))
+			return;
+		if (facade.bType2 && facade.Floors[m_Floor].RoofHeights.empty())
+			return;
+		const float roofHeight = facade.bType2 ? facade.Floors[m_Floor].GetHeight() : m_Height;
+
+		std::vector<uint32_t> triangles;
+		Triangulate(m_Footprint, {}, triangles);
+
+		/// Roof texture: metres per unit when ROOF_SCALE is given, otherwise the footprint's bounds
+		/// mapped onto the ROOF coordinates (or the whole texture). North is up in both.
+		DVec2 minimum = m_Footprint.front();
+		DVec2 maximum = m_Footprint.front();
+		for (const DVec2 &point : m_Footprint)
+		{
+			minimum = DVec2(std::min(minimum.x, point.x), std::min(minimum.y, point.y));
+			maximum = DVec2(std::max(maximum.x, point.x), std::max(maximum.y, point.y));
+		}
+		float s0 = 0.0f, t0 = 0.0f, s1 = 1.0f, t1 = 1.0f;
+		if (!facade.bType2 && !facade.Lods.empty() && facade.Lods.front().RoofCoords.size() >= 4)
+		{
+			const std::vector<float> &coords = facade.Lods.front().RoofCoords;
+			s0 = s1 = coords[0];
+			t0 = t1 = coords[1];
+			for (size_t i = 2; i + 1 < coords.size(); i += 2)
+			{
+				s0 = std::min(s0, coords[i]);
+				s1 = std::max(s1, coords[i]);
+				t0 = std::min(t0, coords[i + 1]);
+				t1 = std::max(t1, coords[i + 1]);
+			}
+		}
+		const double width = std::max(maximum.x - minimum.x, 1e-6);
+		const double depth = std::max(maximum.y - minimum.y, 1e-6);
+
+		m_Roof.vertices.reserve(m_Footprint.size());
+		for (const DVec2 &point : m_Footprint)
+		{
+			FacadeVertex &vertex = m_Roof.vertices.emplace_back();
+			vertex.position = Vec3(static_cast<float>(point.x), roofHeight, static_cast<float>(point.y));
+			vertex.normal = Vec3(0.0f, 1.0f, 0.0f);
+			if (facade.fRoofScaleS > 0.0f && facade.fRoofScaleT > 0.0f)
+				vertex.texcoord = Vec2(static_cast<float>(point.x) / facade.fRoofScaleS, static_cast<float>(-point.y) / facade.fRoofScaleT);
+			else
+				vertex.texcoord = Vec2(s0 + (s1 - s0) * static_cast<float>((point.x - minimum.x) / width), t0 + (t1 - t0) * static_cast<float>((maximum.y - point.y) / depth));
+		}
+
+		/// Triangulate() winds counter-clockwise on the X/Z plane, which faces down once Z points south.
+		m_Roof.indices.reserve(triangles.size());
+		for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+			m_Roof.indices.insert(m_Roof.indices.end(), {triangles[i], triangles[i + 2], triangles[i + 1]});
+	}
+
+	const FacadeMesh &FacadeGenerator::GetMesh()
+	{
+		/// Z points south, so a positive shoelace sum on X/Z is a ring with its interior on the right.
+		if (m_Facade->bRing && m_Footprint.size() >= 3)
+		{
+			double area = 0.0;
+			for (size_t i = 0; i < m_Footprint.size(); ++i)
+			{
+				const DVec2 &a = m_Footprint[i];
+				const DVec2 &b = m_Footprint[(i + 1) % m_Footprint.size()];
+				area += a.x * b.y - b.x * a.y;
+			}
+			if ((area < 0.0) != m_Reversed)
+			{
+				m_Reversed = area < 0.0;
+				InvalidateAll();
+			}
+		}
+
+		for (uint32_t edge = 0; edge < m_Edges.size(); ++edge)
+		{
+			if (!m_DirtyEdges[edge])
+				continue;
+			BuildEdge(edge);
+			m_DirtyEdges[edge] = 0;
+		}
+		if (m_DirtyRoof)
+		{
+			BuildRoof();
+			m_DirtyRoof = false;
+		}
+
+		if (m_DirtyMesh)
+		{
+			size_t vertexCount = m_Roof.vertices.size();
+			size_t indexCount = m_Roof.indices.size();
+			size_t objectCount = 0;
+			for (const EdgeMesh &edge : m_Edges)
+			{
+				vertexCount += edge.vertices.size();
+				indexCount += edge.indices.size();
+				objectCount += edge.objects.size();
+			}
+
+			m_Mesh.vertices.clear();
+			m_Mesh.indices.clear();
+			m_Mesh.objects.clear();
+			m_Mesh.vertices.reserve(vertexCount);
+			m_Mesh.indices.reserve(indexCount);
+			m_Mesh.objects.reserve(objectCount);
+
+			const auto append = [this](const EdgeMesh &part)
+			{
+				const auto base = static_cast<uint32_t>(m_Mesh.vertices.size());
+				m_Mesh.vertices.insert(m_Mesh.vertices.end(), part.vertices.begin(), part.vertices.end());
+				for (const uint32_t index : part.indices)
+					m_Mesh.indices.push_back(base + index);
+				m_Mesh.objects.insert(m_Mesh.objects.end(), part.objects.begin(), part.objects.end());
+			};
+			for (const EdgeMesh &edge : m_Edges)
+				append(edge);
+			m_Mesh.roofVertexStart = static_cast<uint32_t>(m_Mesh.vertices.size());
+			m_Mesh.roofIndexStart = static_cast<uint32_t>(m_Mesh.indices.size());
+			append(m_Roof);
+			m_DirtyMesh = false;
+		}
+
+		m_LastUpdate = m_Pending;
+		m_Pending = {};
+		return m_Mesh;
+	}
+
+}
+
+/// -------------------------------------------------------
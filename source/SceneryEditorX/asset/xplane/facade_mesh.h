@@ -0,0 +1,196 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* facade_mesh.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <Math/includes/vector.h>
+#include <SceneryEditorX/utils/pointers.h>
+
+/// -------------------------------------------------------
+
+namespace XPAsset
+{
+	class Fac;
+}
+
+namespace SceneryEditorX
+{
+	class MeshSource;
+
+	struct FacadeVertex
+	{
+		Vec3 position;			///< Metres, X-Plane axes: +X east, +Y up, +Z south
+		Vec3 normal;
+		Vec2 texcoord;
+	};
+
+	/// An object attached by a type 2 segment.
+	struct FacadeObjectPlacement
+	{
+		uint32_t object = 0;	///< Into XPAsset::Fac::Objects
+		Vec3 position;
+		float heading = 0.0f;	///< Degrees clockwise from north
+		bool draped = true;
+	};
+
+	/// Generated building. Triangles wind counter-clockwise seen from the front.
+	struct FacadeMesh
+	{
+		std::vector<FacadeVertex> vertices;
+		std::vector<uint32_t> indices;
+		uint32_t roofVertexStart = 0;			///< Vertices before this are walls, the rest is the roof
+		uint32_t roofIndexStart = 0;			///< Same for indices
+		std::vector<FacadeObjectPlacement> objects;
+	};
+
+	struct FacadeMeshOptions
+	{
+		float lengthBucket = 0.5f;				///< Edge lengths within one bucket share a cached wall
+		float heightBucket = 0.5f;				///< Same for type 1 heights; type 2 heights pick a floor instead
+	};
+
+	/**
+	 * @brief Wall meshes shared between buildings.
+	 *
+	 * An entry is one wall laid out for an edge of a representative length, in edge space:
+	 * X along the edge, Y up, the front facing -Z. Buildings stretch it to their exact length,
+	 * which never moves a vertex by more than half a bucket. Keyed by (facade, wall, length
+	 * bucket, height) where the height is a bucket for type 1 facades and a floor for type 2.
+	 *
+	 * Not thread safe. Remove a facade's entries before it is reloaded or destroyed.
+	 */
+	class FacadeSegmentCache
+	{
+	public:
+		struct Key
+		{
+			const XPAsset::Fac *facade = nullptr;
+			uint32_t wall = 0;
+			uint32_t lengthBucket = 0;
+			uint32_t heightKey = 0;
+
+			bool operator==(const Key &other) const = default;
+		};
+
+		struct Entry
+		{
+			std::vector<FacadeVertex> vertices;
+			std::vector<uint32_t> indices;
+			std::vector<FacadeObjectPlacement> objects;	///< Edge space, heading relative to the wall's front
+			float length = 0.0f;
+			float height = 0.0f;
+		};
+
+		[[nodiscard]] const Entry *Find(const Key &key);
+		const Entry &Insert(const Key &key, Entry entry);
+		void Erase(const XPAsset::Fac *facade);
+		void Clear();
+
+		[[nodiscard]] size_t GetSize() const { return m_Entries.size(); }
+		[[nodiscard]] uint64_t GetHits() const { return m_Hits; }
+		[[nodiscard]] uint64_t GetMisses() const { return m_Misses; }
+
+	private:
+		struct KeyHash
+		{
+			size_t operator()(const Key &key) const noexcept;
+		};
+
+		std::unordered_map<Key, Entry, KeyHash> m_Entries;
+		uint64_t m_Hits = 0;
+		uint64_t m_Misses = 0;
+	};
+
+	/**
+	 * @brief Builds the mesh of one facade placement and keeps it up to date as its footprint is edited.
+	 *
+	 * The footprint is in metres on the X/Z plane (X east, Z south). Either winding is accepted;
+	 * walls face away from the interior of a ring, and to the left of an open facade's direction of
+	 * travel. Each edge picks the first wall whose width and facing ranges contain it.
+	 *
+	 * Type 1 facades repeat their CENTER and MIDDLE panels to fill the edge and the height and
+	 * stretch the result to fit. Type 2 facades use the floor matching the height, the spelling
+	 * that best fills the edge, and its segment meshes stretched along the edge. Closed footprints
+	 * get a flat roof at the wall height, triangulated with Triangulate().
+	 *
+	 * Walls are kept per edge. Moving a node rebuilds the two edges meeting at it and the roof;
+	 * GetMesh() then joins the edges, which is a copy.
+	 */
+	class FacadeGenerator
+	{
+	public:
+		struct UpdateStats
+		{
+			uint32_t edgesBuilt = 0;		///< Edges rebuilt since the last GetMesh()
+			uint32_t cacheHits = 0;
+			uint32_t cacheMisses = 0;
+			bool roofBuilt = false;
+		};
+
+		/// @param cache Shared wall cache. Without one every edge is laid out from scratch.
+		explicit FacadeGenerator(const XPAsset::Fac &facade, FacadeSegmentCache *cache = nullptr, const FacadeMeshOptions &options = {});
+
+		void SetFootprint(std::vector<DVec2> footprint, float height);
+		void MoveNode(uint32_t node, const DVec2 &position);
+		void SetHeight(float height);
+
+		[[nodiscard]] const std::vector<DVec2> &GetFootprint() const { return m_Footprint; }
+		[[nodiscard]] float GetHeight() const { return m_Height; }
+
+		/// Brings the mesh up to date with the edits since the last call.
+		const FacadeMesh &GetMesh();
+
+		/// What the last GetMesh() had to redo.
+		[[nodiscard]] const UpdateStats &GetLastUpdate() const { return m_LastUpdate; }
+
+		/// Copies a generated mesh into a MeshSource with a wall submesh (material 0) and a roof submesh (material 1).
+		static Ref<MeshSource> CreateMeshSource(const FacadeMesh &mesh);
+
+	private:
+		struct EdgeMesh
+		{
+			std::vector<FacadeVertex> vertices;
+			std::vector<uint32_t> indices;
+			std::vector<FacadeObjectPlacement> objects;
+		};
+
+		[[nodiscard]] uint32_t GetEdgeCount() const;
+		void BuildEdge(uint32_t edge);
+		void BuildRoof();
+		void LayoutWall(uint32_t wall, float length, FacadeSegmentCache::Entry &out) const;
+		void InvalidateAll();
+
+		const XPAsset::Fac *m_Facade;
+		FacadeSegmentCache *m_Cache;
+		FacadeMeshOptions m_Options;
+
+		std::vector<DVec2> m_Footprint;
+		float m_Height = 0.0f;
+		uint32_t m_Floor = 0;
+		bool m_Reversed = false;			///< Ring interior lies to the left, so edges are walked backwards
+
+		std::vector<EdgeMesh> m_Edges;
+		std::vector<uint8_t> m_DirtyEdges;
+		EdgeMesh m_Roof;
+		bool m_DirtyRoof = true;
+		bool m_DirtyMesh = true;
+
+		FacadeMesh m_Mesh;
+		UpdateStats m_Pending;
+		UpdateStats m_LastUpdate;
+	};
+
+}
+
+/// -------------------------------------------------------
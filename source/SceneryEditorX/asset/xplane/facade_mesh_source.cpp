@@ -0,0 +1,71 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* facade_mesh_source.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "facade_mesh.h"
+#include <cmath>
+#include <SceneryEditorX/asset/mesh/mesh.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/// Kept apart from facade_mesh.cpp so the generator does not depend on the renderer headers mesh.h pulls in.
+	Ref<MeshSource> FacadeGenerator::CreateMeshSource(const FacadeMesh &mesh)
+	{
+		std::vector<Vertex> vertices;
+		vertices.reserve(mesh.vertices.size());
+		for (const FacadeVertex &source : mesh.vertices)
+		{
+			/// Walls are textured along the horizontal, so the tangent is the horizontal direction of the face.
+			const Vec3 &normal = source.normal;
+			Vec3 tangent(normal.z, 0.0f, -normal.x);
+			const float length = std::sqrt(tangent.x * tangent.x + tangent.z * tangent.z);
+			tangent = length > 1e-4f ? tangent / length : Vec3(1.0f, 0.0f, 0.0f);
+
+			Vertex &vertex = vertices.emplace_back();
+			vertex.Position = source.position;
+			vertex.Normal = normal;
+			vertex.Tangent = tangent;
+			vertex.Binormal = Vec3(normal.y * tangent.z - normal.z * tangent.y, normal.z * tangent.x - normal.x * tangent.z, normal.x * tangent.y - normal.y * tangent.x);
+			vertex.Texcoord = source.texcoord;
+		}
+
+		/// Roof indices are stored relative to the roof's first vertex, like any submesh.
+		std::vector<Index> indices;
+		indices.reserve(mesh.indices.size() / 3);
+		for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+		{
+			const uint32_t base = i < mesh.roofIndexStart ? 0 : mesh.roofVertexStart;
+			indices.push_back({mesh.indices[i] - base, mesh.indices[i + 1] - base, mesh.indices[i + 2] - base});
+		}
+
+		std::vector<Submesh> submeshes(2);
+		submeshes[0].BaseVertex = 0;
+		submeshes[0].VertexCount = mesh.roofVertexStart;
+		submeshes[0].BaseIndex = 0;
+		submeshes[0].IndexCount = mesh.roofIndexStart;
+		submeshes[0].MaterialIndex = 0;
+		submeshes[0].MeshName = "Walls";
+
+		submeshes[1].BaseVertex = mesh.roofVertexStart;
+		submeshes[1].VertexCount = static_cast<uint32_t>(mesh.vertices.size()) - mesh.roofVertexStart;
+		submeshes[1].BaseIndex = mesh.roofIndexStart;
+		submeshes[1].IndexCount = static_cast<uint32_t>(mesh.indices.size()) - mesh.roofIndexStart;
+		submeshes[1].MaterialIndex = 1;
+		submeshes[1].MeshName = "Roof";
+
+		return CreateRef<MeshSource>(vertices, indices, submeshes);
+	}
+
+}
+
+/// -------------------------------------------------------
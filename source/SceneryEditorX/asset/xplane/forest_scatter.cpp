@@ -0,0 +1,523 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* forest_scatter.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "forest_scatter.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <string>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+#include <X-PlaneSceneryLibrary/XPFor.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <emmintrin.h>
+	#define SEDX_FOREST_SSE 1
+#else
+	#define SEDX_FOREST_SSE 0
+#endif
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		/// Samples per squared minimum distance that this sampler packs into a large area with 30 attempts, measured over 16 km2.
+		constexpr double PACKING = 0.625;
+
+		/// Tiles in the grid covering the polygon's bounds, whether the polygon touches them or not.
+		constexpr uint64_t MAX_GRID_TILES = 1ull << 24;
+
+		/// Cells of the neighbouring tiles copied around each tile, enough for a candidate to see every sample within reach.
+		constexpr uint32_t APRON = 2;
+
+		/// X of an empty cell. Far enough that no distance test against it passes, close enough that squaring it stays finite.
+		constexpr float EMPTY = 1e18f;
+
+		double MillisecondsSince(const std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		/// splitmix64 finaliser.
+		uint64_t Mix(uint64_t value)
+		{
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+			return value ^ (value >> 31);
+		}
+
+		/// splitmix64 stream, one per tile.
+		class Random
+		{
+		public:
+			explicit Random(const uint64_t seed) : m_State(seed) {}
+
+			uint64_t Next()
+			{
+				m_State += 0x9E3779B97F4A7C15ull;
+				return Mix(m_State);
+			}
+
+			/// [0, 1)
+			float Uniform() { return static_cast<float>(Next() >> 40) * 0x1.0p-24f; }
+
+		private:
+			uint64_t m_State;
+		};
+
+		/// Polygon edge in buffer space. Horizontal edges keep a slope of 0 and never count as a crossing.
+		struct Edge
+		{
+			float ax;
+			float az;
+			float bz;
+			float slope;		///< dx/dz
+			float maxX;
+		};
+
+		enum class TileState : uint8_t
+		{
+			Outside,
+			Inside,
+			Clipped
+		};
+
+		struct Tile
+		{
+			std::vector<Vec2> grid;			///< Sample of each cell with an apron around the tile, or EMPTY
+			std::vector<Vec2> points;		///< Samples in the order they were placed
+			std::vector<ForestInstance> instances;
+		};
+
+		/// Directions for candidates around a sample. A table lookup avoids sin and cos and the mispredicted branches of rejection sampling.
+		constexpr uint32_t DIRECTION_COUNT = 1024;
+
+		const std::array<Vec2, DIRECTION_COUNT> &GetDirections()
+		{
+			static const std::array<Vec2, DIRECTION_COUNT> directions = []()
+			{
+				std::array<Vec2, DIRECTION_COUNT> table;
+				for (uint32_t i = 0; i < DIRECTION_COUNT; ++i)
+				{
+					const double angle = 2.0 * std::numbers::pi * i / DIRECTION_COUNT;
+					table[i] = Vec2(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+				}
+				return table;
+			}();
+			return directions;
+		}
+
+		static_assert(sizeof(Vec2) == 2 * sizeof(float), "Grid rows are read as packed floats");
+
+		/// True when no sample in the 5x5 cells centred on @p cell is closer than the minimum distance to (x, z).
+		bool IsClear(const Vec2 *cell, const uint32_t stride, const float x, const float z, const float radiusSquared)
+		{
+#if SEDX_FOREST_SSE
+			const __m128 point = _mm_setr_ps(x, z, x, z);
+			const __m128 limit = _mm_set1_ps(radiusSquared);
+			int close = 0;
+			for (int dz = -2; dz <= 2; ++dz)
+			{
+				/// One row: samples -2 to 1 in two registers, sample 2 in the low half of a third
+				const float *row = &(cell + static_cast<std::ptrdiff_t>(dz) * static_cast<std::ptrdiff_t>(stride) - 2)->x;
+				__m128 a = _mm_sub_ps(_mm_loadu_ps(row), point);
+				__m128 b = _mm_sub_ps(_mm_loadu_ps(row + 4), point);
+				__m128 c = _mm_sub_ps(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double *>(row + 8))), point);
+				a = _mm_mul_ps(a, a);
+				b = _mm_mul_ps(b, b);
+				c = _mm_mul_ps(c, c);
+				const __m128 ab = _mm_add_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+				const __m128 cc = _mm_add_ss(c, _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1)));
+				close |= _mm_movemask_ps(_mm_cmplt_ps(ab, limit)) | (_mm_movemask_ps(_mm_cmplt_ss(cc, limit)) & 1);
+			}
+			return close == 0;
+#else
+			for (int dz = -2; dz <= 2; ++dz)
+			{
+				const Vec2 *row = cell + static_cast<std::ptrdiff_t>(dz) * static_cast<std::ptrdiff_t>(stride);
+				for (int dx = -2; dx <= 2; ++dx)
+				{
+					if ((row[dx].x - x) * (row[dx].x - x) + (row[dx].y - z) * (row[dx].y - z) < radiusSquared)
+						return false;
+				}
+			}
+			return true;
+#endif
+		}
+
+		/// Even-odd test of every point against @p edges, which must include every edge spanning the points' rows.
+		void ContainsPoints(const std::vector<Edge> &edges, const std::vector<Vec2> &points, std::vector<uint8_t> &inside)
+		{
+			inside.assign(points.size(), 0);
+			size_t i = 0;
+#if SEDX_FOREST_SSE
+			for (; i + 4 <= points.size(); i += 4)
+			{
+				const __m128 px = _mm_setr_ps(points[i].x, points[i + 1].x, points[i + 2].x, points[i + 3].x);
+				const __m128 pz = _mm_setr_ps(points[i].y, points[i + 1].y, points[i + 2].y, points[i + 3].y);
+				__m128 parity = _mm_setzero_ps();
+				for (const Edge &edge : edges)
+				{
+					const __m128 az = _mm_set1_ps(edge.az);
+					const __m128 crosses = _mm_xor_ps(_mm_cmpgt_ps(az, pz), _mm_cmpgt_ps(_mm_set1_ps(edge.bz), pz));
+					const __m128 x = _mm_add_ps(_mm_set1_ps(edge.ax), _mm_mul_ps(_mm_sub_ps(pz, az), _mm_set1_ps(edge.slope)));
+					parity = _mm_xor_ps(parity, _mm_and_ps(crosses, _mm_cmplt_ps(px, x)));
+				}
+
+				const int mask = _mm_movemask_ps(parity);
+				for (size_t lane = 0; lane < 4; ++lane)
+					inside[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+			}
+#endif
+			for (; i < points.size(); ++i)
+			{
+				const Vec2 &point = points[i];
+				bool parity = false;
+				for (const Edge &edge : edges)
+				{
+					if ((edge.az > point.y) != (edge.bz > point.y) && point.x < edge.ax + (point.y - edge.az) * edge.slope)
+						parity = !parity;
+				}
+				inside[i] = parity;
+			}
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	float ForestDensityFromParameter(const uint16_t parameter)
+	{
+		return static_cast<float>(std::min(parameter % 1000, 255)) / 255.0f;
+	}
+
+	bool ForestScatter::Fail(std::string error)
+	{
+		m_Error = std::move(error);
+		return false;
+	}
+
+	bool ForestScatter::Scatter(const XPAsset::For &forest, const std::vector<DVec2> &vertices, const std::vector<uint32_t> &ringStarts,
+	                            ForestInstanceBuffer &out, const ForestScatterOptions &options)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		m_Stats = {};
+		m_Error.clear();
+		out.origin = DVec2(0.0, 0.0);
+		out.instances.clear();
+
+		if (forest.Trees.empty() || forest.fSpacingX <= 0.0f || forest.fSpacingZ <= 0.0f)
+			return Fail("Forest has no trees to plant");
+		if (vertices.size() < 3)
+			return Fail("Forest polygon needs at least three points");
+		if (!ringStarts.empty() && (ringStarts.front() != 0 || !std::ranges::is_sorted(ringStarts) || ringStarts.back() >= vertices.size()))
+			return Fail("Forest polygon has invalid ring starts");
+		if (std::ranges::any_of(vertices, [](const DVec2 &vertex) { return !std::isfinite(vertex.x) || !std::isfinite(vertex.y); }))
+			return Fail("Forest polygon has a non-finite coordinate");
+		if (options.cellsPerTile < 4 || options.attempts == 0)
+			return Fail("Forest tiles need at least 4 cells and 1 attempt");
+		if (!(options.density > 0.0f))
+			return true;
+
+		/// Even-odd area, assuming the holes lie inside the outer ring.
+		const size_t ringCount = std::max<size_t>(ringStarts.size(), 1);
+		const auto ringBegin = [&](const size_t ring) -> size_t { return ringStarts.empty() ? 0 : ringStarts[ring]; };
+		const auto ringEnd = [&](const size_t ring) -> size_t { return ring + 1 < ringStarts.size() ? ringStarts[ring + 1] : vertices.size(); };
+		double area = 0.0;
+		for (size_t ring = 0; ring < ringCount; ++ring)
+		{
+			double twiceArea = 0.0;
+			for (size_t i = ringBegin(ring), end = ringEnd(ring); i < end; ++i)
+			{
+				const DVec2 &a = vertices[i];
+				const DVec2 &b = vertices[i + 1 < end ? i + 1 : ringBegin(ring)];
+				twiceArea += a.x * b.y - b.x * a.y;
+			}
+			area += (ring == 0 ? 0.5 : -0.5) * std::abs(twiceArea);
+		}
+
+		const double spacingArea = static_cast<double>(forest.fSpacingX) * forest.fSpacingZ;
+		const double expected = std::max(area, 0.0) * options.density / spacingArea;
+		if (expected > static_cast<double>(options.maxInstances))
+			return Fail("Forest polygon would plant about " + std::to_string(static_cast<uint64_t>(expected)) + " trees, more than the limit of " + std::to_string(options.maxInstances));
+
+		/// A cell can hold at most one sample, so only the 5x5 cells around a candidate need checking.
+		const double minDistance = std::sqrt(PACKING * spacingArea / options.density);
+		const double cellSize = minDistance / std::numbers::sqrt2;
+		const uint32_t cells = options.cellsPerTile;
+		const double tileSize = cellSize * cells;
+
+		DVec2 minimum = vertices.front();
+		DVec2 maximum = vertices.front();
+		for (const DVec2 &vertex : vertices)
+		{
+			minimum = DVec2(std::min(minimum.x, vertex.x), std::min(minimum.y, vertex.y));
+			maximum = DVec2(std::max(maximum.x, vertex.x), std::max(maximum.y, vertex.y));
+		}
+
+		/// The tile grid is anchored at the origin of polygon space, not at the polygon, so tiles stay put when it is edited.
+		const int64_t tileX0 = static_cast<int64_t>(std::floor(minimum.x / tileSize));
+		const int64_t tileZ0 = static_cast<int64_t>(std::floor(minimum.y / tileSize));
+		const uint64_t tilesX = static_cast<uint64_t>(static_cast<int64_t>(std::floor(maximum.x / tileSize)) - tileX0 + 1);
+		const uint64_t tilesZ = static_cast<uint64_t>(static_cast<int64_t>(std::floor(maximum.y / tileSize)) - tileZ0 + 1);
+		if (tilesX * tilesZ > MAX_GRID_TILES)
+			return Fail("Forest polygon spans too many tiles");
+
+		out.origin = DVec2(static_cast<double>(tileX0) * tileSize, static_cast<double>(tileZ0) * tileSize);
+		m_Stats.minDistance = static_cast<float>(minDistance);
+
+		/// Bucket the edges by tile row and mark every tile an edge passes through as clipped.
+		const float tile = static_cast<float>(tileSize);
+		std::vector<std::vector<Edge>> rowEdges(tilesZ);
+		std::vector<TileState> states(tilesX * tilesZ, TileState::Outside);
+		for (size_t ring = 0; ring < ringCount; ++ring)
+		{
+			for (size_t i = ringBegin(ring), end = ringEnd(ring); i < end; ++i)
+			{
+				const DVec2 a = vertices[i] - out.origin;
+				const DVec2 b = vertices[i + 1 < end ? i + 1 : ringBegin(ring)] - out.origin;
+				Edge edge;
+				edge.ax = static_cast<float>(a.x);
+				edge.az = static_cast<float>(a.y);
+				edge.bz = static_cast<float>(b.y);
+				edge.slope = edge.az != edge.bz ? static_cast<float>((b.x - a.x) / (b.y - a.y)) : 0.0f;
+				edge.maxX = static_cast<float>(std::max(a.x, b.x));
+
+				const double lowZ = std::min(a.y, b.y);
+				const double highZ = std::max(a.y, b.y);
+				const uint64_t firstRow = static_cast<uint64_t>(std::max(std::floor(lowZ / tileSize), 0.0));
+				const uint64_t lastRow = std::min<uint64_t>(static_cast<uint64_t>(std::max(std::floor(highZ / tileSize), 0.0)), tilesZ - 1);
+				for (uint64_t row = firstRow; row <= lastRow; ++row)
+				{
+					rowEdges[row].push_back(edge);
+
+					/// The part of the edge inside this row
+					double x0 = a.x;
+					double x1 = b.x;
+					if (a.y != b.y)
+					{
+						const double z0 = std::max(lowZ, static_cast<double>(row) * tileSize);
+						const double z1 = std::min(highZ, static_cast<double>(row + 1) * tileSize);
+						x0 = a.x + (z0 - a.y) * (b.x - a.x) / (b.y - a.y);
+						x1 = a.x + (z1 - a.y) * (b.x - a.x) / (b.y - a.y);
+					}
+					const uint64_t firstColumn = static_cast<uint64_t>(std::max(std::floor(std::min(x0, x1) / tileSize), 0.0));
+					const uint64_t lastColumn = std::min<uint64_t>(static_cast<uint64_t>(std::max(std::floor(std::max(x0, x1) / tileSize), 0.0)), tilesX - 1);
+					for (uint64_t column = firstColumn; column <= lastColumn; ++column)
+						states[row * tilesX + column] = TileState::Clipped;
+				}
+			}
+		}
+
+		/// Tiles no edge passes through are wholly inside or outside; count crossings along the row's centre line.
+		std::vector<float> crossings;
+		for (uint64_t row = 0; row < tilesZ; ++row)
+		{
+			const float z = (static_cast<float>(row) + 0.5f) * tile;
+			crossings.clear();
+			for (const Edge &edge : rowEdges[row])
+			{
+				if ((edge.az > z) != (edge.bz > z))
+					crossings.push_back(edge.ax + (z - edge.az) * edge.slope);
+			}
+			std::ranges::sort(crossings);
+
+			size_t passed = 0;
+			for (uint64_t column = 0; column < tilesX; ++column)
+			{
+				const float x = (static_cast<float>(column) + 0.5f) * tile;
+				while (passed < crossings.size() && crossings[passed] < x)
+					++passed;
+				TileState &state = states[row * tilesX + column];
+				if (state != TileState::Clipped)
+					state = passed % 2 ? TileState::Inside : TileState::Outside;
+			}
+		}
+
+		/// Tiles sampled in the same phase are at least one tile apart, further than a candidate ever looks.
+		std::vector<Tile> tiles(tilesX * tilesZ);
+		std::array<std::vector<uint32_t>, 4> phases;
+		for (uint64_t index = 0; index < tiles.size(); ++index)
+		{
+			if (states[index] == TileState::Outside)
+				continue;
+			const int64_t tileX = tileX0 + static_cast<int64_t>(index % tilesX);
+			const int64_t tileZ = tileZ0 + static_cast<int64_t>(index / tilesX);
+			phases[(tileX & 1) | ((tileZ & 1) << 1)].push_back(static_cast<uint32_t>(index));
+			tiles[index].grid.assign(static_cast<size_t>(cells + 2 * APRON) * (cells + 2 * APRON), Vec2(EMPTY, EMPTY));
+			++m_Stats.tiles;
+			m_Stats.clippedTiles += states[index] == TileState::Clipped;
+		}
+
+		std::vector<float> cumulative;
+		float totalFrequency = 0.0f;
+		const bool uniform = std::ranges::all_of(forest.Trees, [](const XPAsset::ForTree &tree) { return tree.fFrequency <= 0.0f; });
+		for (const XPAsset::ForTree &tree : forest.Trees)
+		{
+			totalFrequency += uniform ? 1.0f : tree.fFrequency;
+			cumulative.push_back(totalFrequency);
+		}
+
+		const float radius = static_cast<float>(minDistance);
+		const float radiusSquared = radius * radius;
+		const float inverseCell = static_cast<float>(1.0 / cellSize);
+		const uint32_t stride = cells + 2 * APRON;
+		const std::array<Vec2, DIRECTION_COUNT> &directions = GetDirections();
+
+		const auto sampleTile = [&](const uint32_t index)
+		{
+			Tile &current = tiles[index];
+			const uint64_t column = index % tilesX;
+			const uint64_t row = index / tilesX;
+			const float left = static_cast<float>(column) * tile;
+			const float top = static_cast<float>(row) * tile;
+
+			/// Copy the edges of the neighbours sampled in earlier phases into the apron. Later ones are still empty.
+			for (uint32_t z = 0; z < stride; ++z)
+			{
+				for (uint32_t x = 0; x < stride; ++x)
+				{
+					if (x >= APRON && x < APRON + cells && z >= APRON && z < APRON + cells)
+						continue;
+					const int64_t cellX = static_cast<int64_t>(column * cells + x) - APRON;
+					const int64_t cellZ = static_cast<int64_t>(row * cells + z) - APRON;
+					if (cellX < 0 || cellZ < 0 || cellX >= static_cast<int64_t>(tilesX * cells) || cellZ >= static_cast<int64_t>(tilesZ * cells))
+						continue;
+					const Tile &owner = tiles[static_cast<size_t>(cellZ / cells) * tilesX + static_cast<size_t>(cellX / cells)];
+					if (!owner.grid.empty())
+						current.grid[z * stride + x] = owner.grid[static_cast<size_t>(cellZ % cells + APRON) * stride + static_cast<size_t>(cellX % cells + APRON)];
+				}
+			}
+
+			const uint64_t tileSeed = Mix(options.seed ^ Mix(static_cast<uint64_t>(tileX0 + static_cast<int64_t>(column)) ^ Mix(static_cast<uint64_t>(tileZ0 + static_cast<int64_t>(row)))));
+			Random random(tileSeed);
+
+			const auto tryAdd = [&](const float x, const float z)
+			{
+				/// Compared before truncating, which only matches floor() for positive values
+				const float cellX = (x - left) * inverseCell;
+				const float cellZ = (z - top) * inverseCell;
+				if (!(cellX >= 0.0f && cellZ >= 0.0f && cellX < static_cast<float>(cells) && cellZ < static_cast<float>(cells)))
+					return false;
+				Vec2 *slot = &current.grid[(static_cast<size_t>(cellZ) + APRON) * stride + static_cast<size_t>(cellX) + APRON];
+				if (slot->x != EMPTY || !IsClear(slot, stride, x, z, radiusSquared))
+					return false;
+
+				*slot = Vec2(x, z);
+				current.points.emplace_back(x, z);
+				return true;
+			};
+
+			/// Bridson's algorithm, restarted from random darts until a round of them all lands too close to a tree.
+			std::vector<uint32_t> active;
+			while (true)
+			{
+				bool seeded = false;
+				for (uint32_t attempt = 0; attempt < options.attempts && !seeded; ++attempt)
+					seeded = tryAdd(left + random.Uniform() * tile, top + random.Uniform() * tile);
+				if (!seeded)
+					break;
+				active.push_back(static_cast<uint32_t>(current.points.size() - 1));
+
+				while (!active.empty())
+				{
+					const size_t slot = static_cast<size_t>(random.Next() % active.size());
+					const Vec2 centre = current.points[active[slot]];
+					bool placed = false;
+					for (uint32_t attempt = 0; attempt < options.attempts && !placed; ++attempt)
+					{
+						/// A direction and a distance between one and two minimum distances
+						const uint64_t bits = random.Next();
+						const Vec2 &direction = directions[bits % DIRECTION_COUNT];
+						const float distance = radius * (1.0f + static_cast<float>(bits >> 40) * 0x1.0p-24f);
+						const float dx = direction.x * distance;
+						const float dz = direction.y * distance;
+						placed = tryAdd(centre.x + dx, centre.y + dz);
+					}
+
+					if (placed)
+						active.push_back(static_cast<uint32_t>(current.points.size() - 1));
+					else
+					{
+						active[slot] = active.back();
+						active.pop_back();
+					}
+				}
+			}
+
+			/// Only edges ending right of the tile can cross a ray cast towards +X from inside it.
+			std::vector<uint8_t> inside;
+			if (states[index] == TileState::Clipped)
+			{
+				std::vector<Edge> edges;
+				for (const Edge &edge : rowEdges[row])
+				{
+					if (edge.maxX >= left)
+						edges.push_back(edge);
+				}
+				ContainsPoints(edges, current.points, inside);
+			}
+
+			/// Species, height and heading hash the sample's index, so clipping a tree never changes its neighbours.
+			for (size_t i = 0; i < current.points.size(); ++i)
+			{
+				if (!inside.empty() && !inside[i])
+					continue;
+
+				const uint64_t hash = Mix(tileSeed + 0x9E3779B97F4A7C15ull * (i + 1));
+				const float pick = static_cast<float>(hash >> 40) * 0x1.0p-24f * totalFrequency;
+				const size_t species = std::min<size_t>(std::ranges::upper_bound(cumulative, pick) - cumulative.begin(), cumulative.size() - 1);
+				const XPAsset::ForTree &tree = forest.Trees[species];
+
+				ForestInstance &instance = current.instances.emplace_back();
+				instance.x = current.points[i].x;
+				instance.z = current.points[i].y;
+				instance.height = tree.fMinHeight + static_cast<float>((hash >> 16) & 0xFFFFFF) * 0x1.0p-24f * (tree.fMaxHeight - tree.fMinHeight);
+				instance.tree = static_cast<uint16_t>(species);
+				instance.heading = static_cast<uint16_t>(hash & 0xFFFF);
+			}
+		};
+
+		ThreadPool *pool = options.parallel ? (options.threadPool ? options.threadPool : &ThreadPool::Get()) : nullptr;
+		for (const std::vector<uint32_t> &phase : phases)
+		{
+			if (pool && phase.size() > 1)
+				pool->ParallelFor(static_cast<uint32_t>(phase.size()), [&](const uint32_t i) { sampleTile(phase[i]); });
+			else
+			{
+				for (const uint32_t index : phase)
+					sampleTile(index);
+			}
+		}
+
+		/// Tile order, so the buffer is identical however the phases were scheduled.
+		size_t total = 0;
+		for (const Tile &current : tiles)
+		{
+			total += current.instances.size();
+			m_Stats.samples += current.points.size();
+		}
+		out.instances.reserve(total);
+		for (const Tile &current : tiles)
+			out.instances.insert(out.instances.end(), current.instances.begin(), current.instances.end());
+
+		m_Stats.instances = out.instances.size();
+		m_Stats.totalMs = MillisecondsSince(start);
+		return true;
+	}
+
+}
+
+/// -------------------------------------------------------
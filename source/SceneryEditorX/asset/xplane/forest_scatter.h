@@ -0,0 +1,116 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* forest_scatter.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <Math/includes/vector.h>
+
+/// -------------------------------------------------------
+
+namespace XPAsset
+{
+	class For;
+}
+
+namespace SceneryEditorX
+{
+	class ThreadPool;
+
+	/// One tree, packed for upload as per-instance vertex data.
+	struct ForestInstance
+	{
+		float x = 0.0f;			///< Metres from ForestInstanceBuffer::origin, +X east
+		float z = 0.0f;			///< Metres, +Z south
+		float height = 0.0f;	///< Metres
+		uint16_t tree = 0;		///< Into XPAsset::For::Trees
+		uint16_t heading = 0;	///< Clockwise from north, 65536 per turn
+	};
+
+	static_assert(sizeof(ForestInstance) == 16, "ForestInstance is uploaded as is");
+
+	struct ForestInstanceBuffer
+	{
+		DVec2 origin;			///< Polygon coordinates of the instances' (0, 0)
+		std::vector<ForestInstance> instances;
+	};
+
+	struct ForestScatterOptions
+	{
+		float density = 1.0f;				///< Fraction of the forest's SPACING density, see ForestDensityFromParameter()
+		uint64_t seed = 0;
+		uint32_t cellsPerTile = 32;			///< Tile width in sample grid cells; a cell is the minimum distance / sqrt(2)
+		uint32_t attempts = 30;				///< Candidates tried around each tree before it is retired
+		uint64_t maxInstances = 8'000'000;	///< Polygons expected to plant more fail instead
+		bool parallel = true;
+		ThreadPool *threadPool = nullptr;	///< Defaults to ThreadPool::Get()
+	};
+
+	struct ForestScatterStats
+	{
+		uint32_t tiles = 0;					///< Tiles touching the polygon
+		uint32_t clippedTiles = 0;			///< Tiles crossed by an edge, whose trees were tested against the polygon
+		uint64_t samples = 0;				///< Poisson-disk samples, inside the polygon or not
+		uint64_t instances = 0;
+		float minDistance = 0.0f;			///< Metres between any two trees
+		double totalMs = 0.0;
+	};
+
+	/// Density of a DSF forest polygon: the parameter's low digits are 0-255, the thousands select the fill mode.
+	[[nodiscard]] float ForestDensityFromParameter(uint16_t parameter);
+
+	/**
+	 * @brief Plants the trees of a forest polygon.
+	 *
+	 * Trees are Poisson-disk samples (Bridson's algorithm): no two are closer than a minimum
+	 * distance chosen so the polygon gets, on average, one tree per SPACING x by SPACING z
+	 * rectangle at full density. Each tree picks its species by TREE frequency and a random
+	 * height and heading.
+	 *
+	 * The plane is cut into square tiles on a fixed grid. Tiles are processed in four phases by
+	 * the parity of their coordinates, so tiles sampled at the same time are never neighbours and
+	 * can run in parallel, while each still sees the trees of the neighbours sampled before it.
+	 * Every tile draws from its own random stream, so the result depends only on the seed, the
+	 * forest and the polygon, never on the thread count. It also means editing a polygon only
+	 * moves trees within a few tiles of the edit.
+	 *
+	 * Tiles that no edge crosses are kept or dropped whole. Trees of the others are tested against
+	 * the polygon four at a time with SSE2 where available, using only the edges spanning the
+	 * tile's row. Holes use the even-odd rule. The distance test of each candidate against the
+	 * 5x5 cells around it is vectorised the same way.
+	 *
+	 * Only area fill is planted; the line and point fill modes of DSF forests are not.
+	 */
+	class ForestScatter
+	{
+	public:
+		/**
+		 * @param vertices   Rings in metres on the X/Z plane, outer ring first. Either orientation is accepted.
+		 * @param ringStarts First vertex of each ring, as for Triangulate(). An empty list means a single ring.
+		 */
+		bool Scatter(const XPAsset::For &forest, const std::vector<DVec2> &vertices, const std::vector<uint32_t> &ringStarts,
+		             ForestInstanceBuffer &out, const ForestScatterOptions &options = {});
+
+		[[nodiscard]] const std::string &GetError() const { return m_Error; }
+		[[nodiscard]] const ForestScatterStats &GetStats() const { return m_Stats; }
+
+	private:
+		bool Fail(std::string error);
+
+		std::string m_Error;
+		ForestScatterStats m_Stats;
+	};
+
+}
+
+/// -------------------------------------------------------
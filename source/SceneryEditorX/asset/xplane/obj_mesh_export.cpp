@@ -0,0 +1,74 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* obj_mesh_export.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "obj_writer.h"
+#include <numeric>
+#include <Math/includes/math_utils.h>
+#include <SceneryEditorX/asset/mesh/mesh.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/// Kept apart from obj_writer.cpp so the writer itself does not depend on the renderer headers mesh.h pulls in.
+	ObjExportMesh ObjWriter::FromMeshSource(const MeshSource &source, const std::vector<uint32_t> &submeshes)
+	{
+		const std::vector<Submesh> &allSubmeshes = source.GetSubmeshes();
+		const std::vector<Vertex> &vertices = source.GetVertices();
+		const std::vector<Index> &triangles = source.GetIndices();
+
+		std::vector<uint32_t> selected = submeshes;
+		if (selected.empty())
+		{
+			selected.resize(allSubmeshes.size());
+			std::iota(selected.begin(), selected.end(), 0u);
+		}
+
+		ObjExportMesh mesh;
+		for (const uint32_t submeshIndex : selected)
+		{
+			if (submeshIndex >= allSubmeshes.size())
+				continue;
+
+			const Submesh &submesh = allSubmeshes[submeshIndex];
+			const auto base = static_cast<uint32_t>(mesh.vertices.size());
+			for (uint32_t i = 0; i < submesh.VertexCount && submesh.BaseVertex + i < vertices.size(); ++i)
+			{
+				const Vertex &vertex = vertices[submesh.BaseVertex + i];
+				const Vec4 position = submesh.Transform * Vec4(vertex.Position, 1.0f);
+				const Vec4 normal = submesh.Transform * Vec4(vertex.Normal, 0.0f);
+
+				ObjExportVertex &out = mesh.vertices.emplace_back();
+				out.position = Vec3(position.x, position.y, position.z);
+				out.normal = Normalize(Vec3(normal.x, normal.y, normal.z));
+				out.texcoord = vertex.Texcoord;
+			}
+
+			/// Submesh index ranges count indices, MeshSource stores whole triangles.
+			ObjExportPart &part = mesh.parts.emplace_back();
+			part.indexStart = static_cast<uint32_t>(mesh.indices.size());
+			const uint32_t firstTriangle = submesh.BaseIndex / 3;
+			for (uint32_t i = 0; i < submesh.IndexCount / 3 && firstTriangle + i < triangles.size(); ++i)
+			{
+				const Index &triangle = triangles[firstTriangle + i];
+				mesh.indices.push_back(base + triangle.V1);
+				mesh.indices.push_back(base + triangle.V2);
+				mesh.indices.push_back(base + triangle.V3);
+			}
+			part.indexCount = static_cast<uint32_t>(mesh.indices.size()) - part.indexStart;
+		}
+		return mesh;
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,634 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* obj_writer.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "obj_writer.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+#include <X-PlaneSceneryLibrary/XPObj.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		constexpr uint32_t UNASSIGNED = std::numeric_limits<uint32_t>::max();
+
+		double MillisecondsSince(const std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		/// Appends OBJ8 text to a string. Numbers go through std::to_chars, never a stream or locale.
+		class ObjText
+		{
+		public:
+			explicit ObjText(std::string &out) : m_Out(out) {}
+
+			ObjText &Word(const std::string_view text)
+			{
+				m_Out += ' ';
+				m_Out += text;
+				return *this;
+			}
+
+			/// Shortest form that reads back as the same float.
+			ObjText &Float(const float value)
+			{
+				char buffer[32];
+				buffer[0] = ' ';
+				const auto result = std::to_chars(buffer + 1, buffer + sizeof(buffer), value);
+				m_Out.append(buffer, result.ptr);
+				return *this;
+			}
+
+			ObjText &Floats(const float *values, const size_t count)
+			{
+				for (size_t i = 0; i < count; ++i)
+					Float(values[i]);
+				return *this;
+			}
+
+			ObjText &Uint(const uint64_t value)
+			{
+				char buffer[24];
+				buffer[0] = ' ';
+				const auto result = std::to_chars(buffer + 1, buffer + sizeof(buffer), value);
+				m_Out.append(buffer, result.ptr);
+				return *this;
+			}
+
+			/// Starts a line with @p command; the previous line must have been ended.
+			ObjText &Line(const std::string_view command)
+			{
+				m_Out += command;
+				return *this;
+			}
+
+			void End() { m_Out += '\n'; }
+
+			/// Writes the index table as IDX10 runs followed by single IDX lines.
+			void Indices(const std::vector<uint32_t> &indices)
+			{
+				size_t i = 0;
+				for (; i + 10 <= indices.size(); i += 10)
+				{
+					Line("IDX10");
+					for (size_t j = i; j < i + 10; ++j)
+						Uint(indices[j]);
+					End();
+				}
+				for (; i < indices.size(); ++i)
+				{
+					Line("IDX").Uint(indices[i]);
+					End();
+				}
+			}
+
+		private:
+			std::string &m_Out;
+		};
+
+		void WriteHeader(ObjText &text)
+		{
+			text.Line("I");
+			text.End();
+			text.Line("800");
+			text.End();
+			text.Line("OBJ");
+			text.End();
+			text.End();
+		}
+
+		/// Bitwise vertex key; two vertices merge only if every float matches exactly.
+		using VertexKey = std::array<uint32_t, 8>;
+
+		struct VertexKeyHash
+		{
+			size_t operator()(const VertexKey &key) const noexcept
+			{
+				uint64_t hash = 0xcbf29ce484222325ull;
+				for (const uint32_t word : key)
+					hash = (hash ^ word) * 0x100000001b3ull;
+				return static_cast<size_t>(hash ^ (hash >> 32));
+			}
+		};
+
+		VertexKey MakeKey(const ObjExportVertex &vertex)
+		{
+			const float values[8] = {vertex.position.x, vertex.position.y, vertex.position.z, vertex.normal.x, vertex.normal.y, vertex.normal.z, vertex.texcoord.x, vertex.texcoord.y};
+			VertexKey key;
+			std::memcpy(key.data(), values, sizeof(values));
+			return key;
+		}
+
+		bool IsFinite(const ObjExportVertex &vertex)
+		{
+			return std::isfinite(vertex.position.x) && std::isfinite(vertex.position.y) && std::isfinite(vertex.position.z) &&
+			       std::isfinite(vertex.normal.x) && std::isfinite(vertex.normal.y) && std::isfinite(vertex.normal.z) &&
+			       std::isfinite(vertex.texcoord.x) && std::isfinite(vertex.texcoord.y);
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	bool ObjWriter::Fail(std::string error)
+	{
+		m_Error = std::move(error);
+		return false;
+	}
+
+	bool ObjWriter::Write(const ObjExportMesh &mesh, std::string &out, const ObjWriteOptions &options)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		m_Stats = {};
+		m_Error.clear();
+		out.clear();
+
+		/// Validate everything up front so a bad part never leaves half an object behind.
+		const auto vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+		for (size_t i = 0; i < mesh.parts.size(); ++i)
+		{
+			const ObjExportPart &part = mesh.parts[i];
+			if (part.indexStart % 3 != 0 || part.indexCount % 3 != 0)
+				return Fail("part " + std::to_string(i) + " does not cover whole triangles");
+			if (static_cast<size_t>(part.indexStart) + part.indexCount > mesh.indices.size())
+				return Fail("part " + std::to_string(i) + " is outside the index list");
+			if (!mesh.lods.empty() && part.lod >= mesh.lods.size())
+				return Fail("part " + std::to_string(i) + " uses LOD " + std::to_string(part.lod) + " of " + std::to_string(mesh.lods.size()));
+			for (uint32_t j = part.indexStart; j < part.indexStart + part.indexCount; ++j)
+			{
+				if (mesh.indices[j] >= vertexCount)
+					return Fail("index " + std::to_string(j) + " is outside the vertex list");
+			}
+		}
+		for (size_t i = 0; i < mesh.vertices.size(); ++i)
+		{
+			if (!IsFinite(mesh.vertices[i]))
+				return Fail("vertex " + std::to_string(i) + " is not finite");
+		}
+
+		/// Parts are grouped by LOD; within a LOD they keep their order.
+		std::vector<uint32_t> partOrder(mesh.parts.size());
+		std::iota(partOrder.begin(), partOrder.end(), 0u);
+		if (!mesh.lods.empty())
+			std::ranges::stable_sort(partOrder, {}, [&](const uint32_t part) { return mesh.parts[part].lod; });
+
+		/// Renumber vertices. Reordering follows first use, so each part's indices stay close
+		/// together; deduplication maps a vertex to the first one with the same bits.
+		std::vector<uint32_t> remap(vertexCount, UNASSIGNED);
+		std::vector<uint32_t> sourceOf;
+		sourceOf.reserve(vertexCount);
+		std::unordered_map<VertexKey, uint32_t, VertexKeyHash> unique;
+		if (options.deduplicate)
+			unique.reserve(vertexCount);
+
+		const auto assign = [&](const uint32_t vertex)
+		{
+			if (remap[vertex] != UNASSIGNED)
+				return;
+			if (options.deduplicate)
+			{
+				const auto [it, inserted] = unique.try_emplace(MakeKey(mesh.vertices[vertex]), static_cast<uint32_t>(sourceOf.size()));
+				if (!inserted)
+				{
+					remap[vertex] = it->second;
+					return;
+				}
+			}
+			remap[vertex] = static_cast<uint32_t>(sourceOf.size());
+			sourceOf.push_back(vertex);
+		};
+
+		if (options.reorder)
+		{
+			for (const uint32_t part : partOrder)
+			{
+				const ObjExportPart &exportPart = mesh.parts[part];
+				for (uint32_t i = exportPart.indexStart; i < exportPart.indexStart + exportPart.indexCount; ++i)
+					assign(mesh.indices[i]);
+			}
+		}
+		else
+		{
+			for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+				assign(vertex);
+		}
+
+		/// Index table in part order, and where each part's TRIS starts.
+		std::vector<uint32_t> indices;
+		std::vector<uint32_t> partOffsets(mesh.parts.size());
+		indices.reserve(mesh.indices.size());
+		for (const uint32_t part : partOrder)
+		{
+			const ObjExportPart &exportPart = mesh.parts[part];
+			partOffsets[part] = static_cast<uint32_t>(indices.size());
+			for (uint32_t i = exportPart.indexStart; i < exportPart.indexStart + exportPart.indexCount; i += 3)
+			{
+				const uint32_t a = remap[mesh.indices[i]];
+				const uint32_t b = remap[mesh.indices[i + 1]];
+				const uint32_t c = remap[mesh.indices[i + 2]];
+				indices.push_back(a);
+				indices.push_back(options.reverseWinding ? c : b);
+				indices.push_back(options.reverseWinding ? b : c);
+			}
+		}
+
+		/// About 90 bytes per VT line and 40 per IDX10 line.
+		out.reserve(256 + sourceOf.size() * 96 + indices.size() * 5 + mesh.parts.size() * 64);
+		ObjText text(out);
+		WriteHeader(text);
+
+		const std::pair<const char *, const std::string *> textures[] = {
+			{"TEXTURE", &mesh.texture}, {"TEXTURE_LIT", &mesh.litTexture}, {"TEXTURE_NORMAL", &mesh.normalTexture}, {"TEXTURE_DRAPED", &mesh.drapedTexture}};
+		for (const auto &[command, path] : textures)
+		{
+			if (path->empty())
+				continue;
+			text.Line(command).Word(*path);
+			text.End();
+		}
+		for (const std::string &global : mesh.globals)
+		{
+			text.Line(global);
+			text.End();
+		}
+
+		text.Line("POINT_COUNTS").Uint(sourceOf.size()).Uint(0).Uint(0).Uint(indices.size());
+		text.End();
+		text.End();
+
+		for (const uint32_t source : sourceOf)
+		{
+			const ObjExportVertex &vertex = mesh.vertices[source];
+			text.Line("VT").Float(vertex.position.x).Float(vertex.position.y).Float(vertex.position.z)
+				.Float(vertex.normal.x).Float(vertex.normal.y).Float(vertex.normal.z)
+				.Float(vertex.texcoord.x).Float(vertex.texcoord.y);
+			text.End();
+		}
+		text.End();
+
+		text.Indices(indices);
+		text.End();
+
+		/// State is written where it changes. A new LOD restates draping and attributes, so no
+		/// LOD block relies on what the one before it left behind.
+		uint32_t currentLod = UNASSIGNED;
+		bool draped = false;
+		const std::vector<std::string> *attributes = nullptr;
+		for (const uint32_t part : partOrder)
+		{
+			const ObjExportPart &exportPart = mesh.parts[part];
+			bool lodStart = false;
+			if (!mesh.lods.empty() && exportPart.lod != currentLod)
+			{
+				currentLod = exportPart.lod;
+				text.Line("ATTR_LOD").Float(mesh.lods[currentLod].nearDistance).Float(mesh.lods[currentLod].farDistance);
+				text.End();
+				lodStart = true;
+				attributes = nullptr;
+			}
+
+			if (exportPart.draped != draped || (lodStart && draped))
+			{
+				draped = exportPart.draped;
+				text.Line(draped ? "ATTR_draped" : "ATTR_no_draped");
+				text.End();
+			}
+			if (!attributes ? !exportPart.attributes.empty() : *attributes != exportPart.attributes)
+			{
+				for (const std::string &attribute : exportPart.attributes)
+				{
+					text.Line(attribute);
+					text.End();
+				}
+			}
+			attributes = &exportPart.attributes;
+
+			if (exportPart.indexCount)
+			{
+				text.Line("TRIS").Uint(partOffsets[part]).Uint(exportPart.indexCount);
+				text.End();
+			}
+		}
+
+		m_Stats.objectCount = 1;
+		m_Stats.outputBytes = out.size();
+		m_Stats.inputVertices = vertexCount;
+		m_Stats.outputVertices = sourceOf.size();
+		m_Stats.triangles = indices.size() / 3;
+		m_Stats.totalMs = MillisecondsSince(start);
+		return true;
+	}
+
+	bool ObjWriter::Write(const XPAsset::Obj &obj, std::string &out)
+	{
+		using namespace XPAsset;
+
+		const auto start = std::chrono::steady_clock::now();
+		m_Stats = {};
+		m_Error.clear();
+		out.clear();
+
+		if (!obj.Validate())
+			return Fail("object tables are inconsistent");
+
+		out.reserve(256 + obj.Vertices.size() * 96 + (obj.LineVertices.size() + obj.LightVertices.size()) * 72 + obj.Indices.size() * 5 + obj.Commands.size() * 48);
+		ObjText text(out);
+		WriteHeader(text);
+
+		const auto pathText = [](const std::filesystem::path &path) { return path.generic_string(); };
+		if (obj.bHasBaseTex)
+			text.Line("TEXTURE").Word(pathText(obj.pBaseTex)).End();
+		if (obj.bHasLitTex)
+			text.Line("TEXTURE_LIT").Word(pathText(obj.pLitTex)).End();
+		if (obj.bHasNormalTex)
+		{
+			text.Line("TEXTURE_NORMAL");
+			if (obj.dblNormalScale != 1.0)
+				text.Float(static_cast<float>(obj.dblNormalScale));
+			text.Word(pathText(obj.pNormalTex)).End();
+		}
+		if (obj.bHasDrapedBaseTex)
+			text.Line("TEXTURE_DRAPED").Word(pathText(obj.pDrapedBaseTex)).End();
+		if (obj.bHasDrapedNormalTex)
+			text.Line("TEXTURE_DRAPED_NORMAL").Float(static_cast<float>(obj.dblDrapedNormalScale)).Word(pathText(obj.pDrapedNormalTex)).End();
+
+		/// Global properties (GLOBAL_*, BLEND_GLASS, ...) lead the command stream and belong in the header.
+		size_t headerCommands = 0;
+		while (headerCommands < obj.Commands.size() && obj.Commands[headerCommands].Type == ObjCommandType::Attribute &&
+		       !obj.GetString(obj.Commands[headerCommands].A).starts_with("ATTR_"))
+			++headerCommands;
+
+		const auto writeAttribute = [&](const ObjCommand &command)
+		{
+			text.Line(obj.GetString(command.A));
+			if (command.B != OBJ_NO_STRING)
+				text.Word(obj.GetString(command.B));
+			text.End();
+		};
+		for (size_t i = 0; i < headerCommands; ++i)
+			writeAttribute(obj.Commands[i]);
+
+		text.Line("POINT_COUNTS").Uint(obj.Vertices.size()).Uint(obj.LineVertices.size()).Uint(obj.LightVertices.size()).Uint(obj.Indices.size());
+		text.End();
+		text.End();
+
+		for (const Vertex &vertex : obj.Vertices)
+		{
+			float values[8];
+			std::memcpy(values, &vertex, sizeof(values));
+			text.Line("VT").Floats(values, 8).End();
+		}
+		for (const ObjColorVertex &vertex : obj.LineVertices)
+		{
+			float values[6];
+			std::memcpy(values, &vertex, sizeof(values));
+			text.Line("VLINE").Floats(values, 6).End();
+		}
+		for (const ObjColorVertex &vertex : obj.LightVertices)
+		{
+			float values[6];
+			std::memcpy(values, &vertex, sizeof(values));
+			text.Line("VLIGHT").Floats(values, 6).End();
+		}
+		text.End();
+
+		text.Indices(obj.Indices);
+		text.End();
+
+		for (size_t i = headerCommands; i < obj.Commands.size(); ++i)
+		{
+			const ObjCommand &command = obj.Commands[i];
+			switch (command.Type)
+			{
+			case ObjCommandType::Tris:
+				text.Line("TRIS").Uint(command.A).Uint(command.B).End();
+				break;
+			case ObjCommandType::Lines:
+				text.Line("LINES").Uint(command.A).Uint(command.B).End();
+				break;
+			case ObjCommandType::Lights:
+				text.Line("LIGHTS").Uint(command.A).Uint(command.B).End();
+				break;
+			case ObjCommandType::AnimBegin:
+				text.Line("ANIM_begin").End();
+				break;
+			case ObjCommandType::AnimEnd:
+				text.Line("ANIM_end").End();
+				break;
+			case ObjCommandType::Lod:
+			{
+				const ObjLod &lod = obj.Lods[command.A];
+				text.Line("ATTR_LOD").Float(lod.fNear).Float(lod.fFar).End();
+				break;
+			}
+			case ObjCommandType::Attribute:
+				writeAttribute(command);
+				break;
+			case ObjCommandType::Light:
+			{
+				const ObjLight &light = obj.Lights[command.A];
+				switch (light.Type)
+				{
+				case ObjLightType::Named:
+					text.Line("LIGHT_NAMED").Word(obj.GetString(light.intName)).Floats(light.Position, 3);
+					break;
+				case ObjLightType::Param:
+					text.Line("LIGHT_PARAM").Word(obj.GetString(light.intName)).Floats(light.Position, 3);
+					if (light.intParams != OBJ_NO_STRING)
+						text.Word(obj.GetString(light.intParams));
+					break;
+				case ObjLightType::Custom:
+				case ObjLightType::SpillCustom:
+					text.Line(light.Type == ObjLightType::Custom ? "LIGHT_CUSTOM" : "LIGHT_SPILL_CUSTOM").Floats(light.Position, 3).Floats(light.Values, 9).Word(obj.GetString(light.intName));
+					break;
+				}
+				text.End();
+				break;
+			}
+			case ObjCommandType::Animation:
+			{
+				const ObjAnimation &animation = obj.Animations[command.A];
+				const ObjAnimKey *keys = obj.AnimKeys.data() + animation.intKeyStart;
+				const std::string_view dataref = obj.GetString(animation.intDataref);
+
+				/// Two keys without a loop use the short form, everything else a key table.
+				const bool shortForm = animation.intKeyCount == 2 && animation.fLoop == 0.0f;
+				switch (animation.Type)
+				{
+				case ObjAnimationType::Translate:
+					if (shortForm)
+					{
+						text.Line("ANIM_trans").Float(keys[0].X).Float(keys[0].Y).Float(keys[0].Z).Float(keys[1].X).Float(keys[1].Y).Float(keys[1].Z)
+							.Float(keys[0].Value).Float(keys[1].Value).Word(dataref).End();
+						break;
+					}
+					text.Line("ANIM_trans_begin").Word(dataref).End();
+					for (uint32_t i = 0; i < animation.intKeyCount; ++i)
+						text.Line("ANIM_trans_key").Float(keys[i].Value).Float(keys[i].X).Float(keys[i].Y).Float(keys[i].Z).End();
+					if (animation.fLoop != 0.0f)
+						text.Line("ANIM_keyframe_loop").Float(animation.fLoop).End();
+					text.Line("ANIM_trans_end").End();
+					break;
+				case ObjAnimationType::Rotate:
+					if (shortForm)
+					{
+						text.Line("ANIM_rotate").Floats(animation.Axis, 3).Float(keys[0].X).Float(keys[1].X).Float(keys[0].Value).Float(keys[1].Value).Word(dataref).End();
+						break;
+					}
+					text.Line("ANIM_rotate_begin").Floats(animation.Axis, 3).Word(dataref).End();
+					for (uint32_t i = 0; i < animation.intKeyCount; ++i)
+						text.Line("ANIM_rotate_key").Float(keys[i].Value).Float(keys[i].X).End();
+					if (animation.fLoop != 0.0f)
+						text.Line("ANIM_keyframe_loop").Float(animation.fLoop).End();
+					text.Line("ANIM_rotate_end").End();
+					break;
+				case ObjAnimationType::Hide:
+				case ObjAnimationType::Show:
+					if (animation.intKeyCount != 2)
+						return Fail("ANIM_hide/ANIM_show needs exactly two keys");
+					text.Line(animation.Type == ObjAnimationType::Hide ? "ANIM_hide" : "ANIM_show").Float(keys[0].Value).Float(keys[1].Value).Word(dataref).End();
+					if (animation.fLoop != 0.0f)
+						text.Line("ANIM_keyframe_loop").Float(animation.fLoop).End();
+					break;
+				}
+				break;
+			}
+			}
+		}
+
+		m_Stats.objectCount = 1;
+		m_Stats.outputBytes = out.size();
+		m_Stats.inputVertices = obj.Vertices.size();
+		m_Stats.outputVertices = obj.Vertices.size();
+		m_Stats.triangles = obj.Indices.size() / 3;
+		m_Stats.totalMs = MillisecondsSince(start);
+		return true;
+	}
+
+	/// -------------------------------------------------------
+
+	bool ObjWriter::SaveText(const std::string &text, const std::filesystem::path &path)
+	{
+		std::filesystem::path temp = path;
+		temp += ".tmp";
+		{
+			std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+			if (!file)
+				return Fail("cannot write " + temp.string());
+			file.write(text.data(), static_cast<std::streamsize>(text.size()));
+			if (!file)
+				return Fail("cannot write " + temp.string());
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temp, path, error);
+		if (error)
+		{
+			std::filesystem::remove(temp, error);
+			return Fail("cannot replace " + path.string());
+		}
+		return true;
+	}
+
+	bool ObjWriter::Save(const ObjExportMesh &mesh, const std::filesystem::path &path, const ObjWriteOptions &options)
+	{
+		return Write(mesh, m_Buffer, options) && SaveText(m_Buffer, path);
+	}
+
+	bool ObjWriter::Save(const XPAsset::Obj &obj, const std::filesystem::path &path)
+	{
+		return Write(obj, m_Buffer) && SaveText(m_Buffer, path);
+	}
+
+	bool ObjWriter::WriteBatch(const std::vector<ObjExportJob> &jobs, const ObjWriteOptions &options)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		m_Stats = {};
+		m_Error.clear();
+
+		std::mutex mutex;
+		ObjWriteStats total;
+		size_t failedJob = jobs.size();
+		std::atomic<bool> failed = false;
+
+		/// Each range gets its own writer, so every worker reuses one text buffer.
+		const auto writeRange = [&](const uint32_t begin, const uint32_t end)
+		{
+			ObjWriter writer;
+			ObjWriteStats rangeStats;
+			for (uint32_t i = begin; i < end && !failed.load(std::memory_order_relaxed); ++i)
+			{
+				const ObjExportJob &job = jobs[i];
+				bool written;
+				if (job.mesh && !job.obj)
+					written = writer.Save(*job.mesh, job.path, options);
+				else if (job.obj && !job.mesh)
+					written = writer.Save(*job.obj, job.path);
+				else
+					written = writer.Fail("job needs exactly one of mesh and obj");
+
+				if (!written)
+				{
+					/// Report the first failing job in input order, whichever thread finds it.
+					std::lock_guard lock(mutex);
+					if (i < failedJob)
+					{
+						failedJob = i;
+						m_Error = job.path.string() + ": " + writer.GetError();
+					}
+					failed = true;
+					break;
+				}
+
+				const ObjWriteStats &stats = writer.GetStats();
+				++rangeStats.objectCount;
+				rangeStats.outputBytes += stats.outputBytes;
+				rangeStats.inputVertices += stats.inputVertices;
+				rangeStats.outputVertices += stats.outputVertices;
+				rangeStats.triangles += stats.triangles;
+			}
+
+			std::lock_guard lock(mutex);
+			total.objectCount += rangeStats.objectCount;
+			total.outputBytes += rangeStats.outputBytes;
+			total.inputVertices += rangeStats.inputVertices;
+			total.outputVertices += rangeStats.outputVertices;
+			total.triangles += rangeStats.triangles;
+		};
+
+		const auto count = static_cast<uint32_t>(jobs.size());
+		if (options.parallel && count > 1)
+			(options.threadPool ? *options.threadPool : ThreadPool::Get()).ParallelForRange(count, 4, writeRange);
+		else
+			writeRange(0, count);
+
+		m_Stats = total;
+		m_Stats.totalMs = MillisecondsSince(start);
+		return !failed;
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,150 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* obj_writer.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <Math/includes/vector.h>
+
+/// -------------------------------------------------------
+
+namespace XPAsset
+{
+	class Obj;
+}
+
+namespace SceneryEditorX
+{
+	class MeshSource;
+	class ThreadPool;
+
+	struct ObjExportVertex
+	{
+		Vec3 position;			///< Metres, X-Plane axes: +X east, +Y up, -Z north
+		Vec3 normal;
+		Vec2 texcoord;
+	};
+
+	/// One TRIS block and the state it is drawn with.
+	struct ObjExportPart
+	{
+		uint32_t indexStart = 0;				///< Into ObjExportMesh::indices, a multiple of 3
+		uint32_t indexCount = 0;
+		uint32_t lod = 0;						///< Into ObjExportMesh::lods; ignored when there are none
+		bool draped = false;
+		std::vector<std::string> attributes;	///< Full ATTR_ lines without the newline, e.g. "ATTR_hard concrete"
+												///< Written whenever they differ from the previous part's list, so a
+												///< part that turns state off lists the reset (ATTR_no_hard) itself.
+	};
+
+	struct ObjExportLod
+	{
+		float nearDistance = 0.0f;
+		float farDistance = 0.0f;
+	};
+
+	/// Triangle mesh to export. Textures are written as given, relative to the .obj.
+	struct ObjExportMesh
+	{
+		std::vector<ObjExportVertex> vertices;
+		std::vector<uint32_t> indices;			///< Triangle list
+		std::vector<ObjExportPart> parts;
+		std::vector<ObjExportLod> lods;			///< Empty for an object without ATTR_LOD
+		std::string texture;
+		std::string litTexture;
+		std::string normalTexture;
+		std::string drapedTexture;
+		std::vector<std::string> globals;		///< Header lines such as "GLOBAL_no_shadow"
+	};
+
+	struct ObjWriteOptions
+	{
+		bool deduplicate = true;				///< Merge bitwise identical vertices
+		bool reorder = true;					///< Renumber vertices in first-use order, LOD by LOD
+		bool reverseWinding = false;			///< Swap the last two indices of every triangle
+		bool parallel = true;					///< WriteBatch() only
+		ThreadPool *threadPool = nullptr;		///< Defaults to ThreadPool::Get()
+	};
+
+	struct ObjWriteStats
+	{
+		uint32_t objectCount = 0;
+		size_t outputBytes = 0;
+		uint64_t inputVertices = 0;
+		uint64_t outputVertices = 0;			///< After deduplication
+		uint64_t triangles = 0;
+		double totalMs = 0.0;
+	};
+
+	/// One object of a WriteBatch(). Exactly one of mesh and obj is set.
+	struct ObjExportJob
+	{
+		const ObjExportMesh *mesh = nullptr;
+		const XPAsset::Obj *obj = nullptr;
+		std::filesystem::path path;
+	};
+
+	/**
+	 * @brief Writes X-Plane OBJ8 text.
+	 *
+	 * Text is appended to a caller owned std::string that is cleared but keeps its capacity,
+	 * so a writer exporting many objects allocates once. Numbers are formatted with
+	 * std::to_chars in their shortest round-trip form, which makes the output deterministic and
+	 * lets the OBJ loader read back exactly the floats that were written.
+	 *
+	 * An ObjExportMesh is deduplicated and reordered, its indices are packed into IDX10 runs,
+	 * and parts are grouped into ATTR_LOD blocks with ATTR_ lines written only where the state
+	 * changes. An XPAsset::Obj is written command for command, so loading the output and writing
+	 * it again produces the same bytes.
+	 */
+	class ObjWriter
+	{
+	public:
+		/// Formats @p mesh into @p out. Returns false and sets GetError() on out of range indices or parts.
+		bool Write(const ObjExportMesh &mesh, std::string &out, const ObjWriteOptions &options = {});
+
+		/// Formats a loaded object, animations, lights and attributes included.
+		bool Write(const XPAsset::Obj &obj, std::string &out);
+
+		/// Writes to a temporary file next to @p path and renames it into place.
+		bool Save(const ObjExportMesh &mesh, const std::filesystem::path &path, const ObjWriteOptions &options = {});
+		bool Save(const XPAsset::Obj &obj, const std::filesystem::path &path);
+
+		/// Writes every job, across worker threads unless @p options disables it. Stops at the first error.
+		bool WriteBatch(const std::vector<ObjExportJob> &jobs, const ObjWriteOptions &options = {});
+
+		/**
+		 * @brief Builds an export mesh from submeshes of a MeshSource.
+		 *
+		 * Vertices are moved into object space by each submesh's transform and every submesh becomes
+		 * one part in LOD 0. Textures and attributes are left for the caller to fill in. An empty
+		 * @p submeshes takes all of them.
+		 */
+		static ObjExportMesh FromMeshSource(const MeshSource &source, const std::vector<uint32_t> &submeshes = {});
+
+		[[nodiscard]] const std::string &GetError() const { return m_Error; }
+		[[nodiscard]] const ObjWriteStats &GetStats() const { return m_Stats; }
+
+	private:
+		bool Fail(std::string error);
+		bool SaveText(const std::string &text, const std::filesystem::path &path);
+
+		std::string m_Buffer;
+		std::string m_Error;
+		ObjWriteStats m_Stats;
+	};
+
+}
+
+/// -------------------------------------------------------
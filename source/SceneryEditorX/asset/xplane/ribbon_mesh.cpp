@@ -0,0 +1,566 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* ribbon_mesh.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "ribbon_mesh.h"
+#include <algorithm>
+#include <cmath>
+#include <X-PlaneSceneryLibrary/XPLin.h>
+#include <X-PlaneSceneryLibrary/XPNet.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		/// Flattened points closer than this to the previous one are dropped, so every segment has a direction.
+		constexpr double MIN_SEGMENT = 1e-6;
+
+		DVec2 Direction(const DVec2 &from, const DVec2 &to)
+		{
+			const double dx = to.x - from.x;
+			const double dz = to.y - from.y;
+			const double length = std::sqrt(dx * dx + dz * dz);
+			return {dx / length, dz / length};
+		}
+
+		/// Right of the direction of travel with +Y up, X east and Z south.
+		DVec2 RightOf(const DVec2 &direction)
+		{
+			return {-direction.y, direction.x};
+		}
+
+		/// How the cross section is laid out at one point of the path.
+		struct Join
+		{
+			DVec2 rightIn;			///< Right of the incoming segment
+			DVec2 rightOut;			///< Right of the outgoing segment
+			DVec2 miter;			///< Unit direction the cross section is laid along
+			double scale = 1.0;		///< Lateral metres to metres along the miter, clamped to the limit
+			double turn = 0.0;		///< Positive when the path turns right
+			bool bevel = false;
+		};
+
+		Join MakeJoin(const DVec2 &in, const DVec2 &out, const double miterLimit)
+		{
+			Join join;
+			join.rightIn = RightOf(in);
+			join.rightOut = RightOf(out);
+			join.turn = out.x * join.rightIn.x + out.y * join.rightIn.y;
+
+			const double mx = join.rightIn.x + join.rightOut.x;
+			const double mz = join.rightIn.y + join.rightOut.y;
+			const double length = std::sqrt(mx * mx + mz * mz);
+			if (length < 1e-9)
+			{
+				/// Reversal: there is no miter, both sides are bevelled.
+				join.miter = join.rightIn;
+				join.bevel = true;
+				return join;
+			}
+
+			join.miter = {mx / length, mz / length};
+			const double cosHalf = join.miter.x * join.rightIn.x + join.miter.y * join.rightIn.y;
+			join.bevel = cosHalf * miterLimit < 1.0;
+			join.scale = 1.0 / std::max(cosHalf, 1.0 / miterLimit);
+			return join;
+		}
+
+		/// Which side of a bevel a cross section belongs to. Mitered joins have a single section.
+		enum class Section : uint8_t
+		{
+			Incoming,
+			Outgoing
+		};
+
+		DVec2 Offset(const Join &join, const DVec2 &point, const double lateral, const Section section)
+		{
+			/// The inner side of a bevel keeps the (clamped) miter so both sections share it.
+			if (!join.bevel || lateral * join.turn > 0.0)
+				return {point.x + join.miter.x * lateral * join.scale, point.y + join.miter.y * lateral * join.scale};
+
+			const DVec2 &right = section == Section::Incoming ? join.rightIn : join.rightOut;
+			return {point.x + right.x * lateral, point.y + right.y * lateral};
+		}
+
+		Vec3 StripNormal(const RibbonStrip &strip, const DVec2 &right)
+		{
+			/// Perpendicular to the path and to the strip's rise from its left to its right edge.
+			const auto rise = static_cast<double>(strip.rightHeight - strip.leftHeight);
+			const auto width = static_cast<double>(strip.right - strip.left);
+			const double nx = -right.x * rise;
+			const double nz = -right.y * rise;
+			const double length = std::sqrt(nx * nx + width * width + nz * nz);
+			if (length < 1e-9)
+				return {0.0f, 1.0f, 0.0f};
+			return {static_cast<float>(nx / length), static_cast<float>(width / length), static_cast<float>(nz / length)};
+		}
+
+		/// Left and right vertex of one strip at one cross section.
+		struct Pair
+		{
+			uint32_t left;
+			uint32_t right;
+		};
+
+		uint32_t AddVertex(std::vector<RibbonVertex> &vertices, const DVec2 &position, const float height, const Vec3 &normal, const float s, const float t)
+		{
+			const auto index = static_cast<uint32_t>(vertices.size());
+			vertices.push_back({Vec3(static_cast<float>(position.x), height, static_cast<float>(position.y)), normal, Vec2(s, t)});
+			return index;
+		}
+
+		/// Two triangles from section a to section b, winding counter-clockwise seen from above. Triangles
+		/// collapsed by a shared inner vertex are skipped.
+		void AddQuad(std::vector<uint32_t> &indices, const Pair &a, const Pair &b)
+		{
+			if (a.left != b.left)
+				indices.insert(indices.end(), {a.left, a.right, b.left});
+			if (a.right != b.right)
+				indices.insert(indices.end(), {a.right, b.right, b.left});
+		}
+
+		uint32_t FindSlot(const std::vector<uint32_t> &materials, const uint32_t material)
+		{
+			return static_cast<uint32_t>(std::ranges::lower_bound(materials, material) - materials.begin());
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	RibbonProfile MakeLineProfile(const XPAsset::Lin &line)
+	{
+		/// S_OFFSET and cap coordinates are in texture units; SCALE says how many metres a whole texture covers.
+		const float sScale = 1.0f / line.fTexWidth;
+		const float tScale = 1.0f / line.GetTexHeight();
+		const float metres = line.fScaleX * sScale;
+
+		RibbonProfile profile;
+		profile.repeatLength = line.fScaleY;
+		for (const XPAsset::LinLayer &layer : line.Layers)
+		{
+			RibbonStrip &strip = profile.strips.emplace_back();
+			strip.left = (layer.fS1 - layer.fSm) * metres;
+			strip.right = (layer.fS2 - layer.fSm) * metres;
+			strip.sLeft = layer.fS1 * sScale;
+			strip.sRight = layer.fS2 * sScale;
+			strip.material = layer.intLayer;
+		}
+
+		const auto addCaps = [&](const std::vector<XPAsset::LinCap> &caps, std::vector<RibbonCap> &out)
+		{
+			for (const XPAsset::LinCap &source : caps)
+			{
+				RibbonCap &cap = out.emplace_back();
+				cap.left = (source.fS1 - source.fSm) * metres;
+				cap.right = (source.fS2 - source.fSm) * metres;
+				cap.sLeft = source.fS1 * sScale;
+				cap.sRight = source.fS2 * sScale;
+				cap.tInner = source.fT1 * tScale;
+				cap.tOuter = source.fT2 * tScale;
+				cap.length = std::abs(source.fT2 - source.fT1) * tScale * line.fScaleY;
+				cap.material = source.intLayer;
+			}
+		};
+		addCaps(line.StartCaps, profile.startCaps);
+		addCaps(line.EndCaps, profile.endCaps);
+		return profile;
+	}
+
+	RibbonProfile MakeRoadProfile(const XPAsset::Net &network, const XPAsset::NetRoadType &road)
+	{
+		RibbonProfile profile;
+		profile.repeatLength = road.fLength;
+		if (road.Segments.empty())
+			return profile;
+
+		float nearest = road.Segments.front().fNear;
+		for (const XPAsset::NetSegment &segment : road.Segments)
+			nearest = std::min(nearest, segment.fNear);
+
+		const float sScale = 1.0f / network.fScale;
+		for (const XPAsset::NetSegment &segment : road.Segments)
+		{
+			if (segment.fNear != nearest)
+				continue;
+
+			RibbonStrip &strip = profile.strips.emplace_back();
+			strip.left = (segment.fLat1 - 0.5f) * road.fWidth;
+			strip.right = (segment.fLat2 - 0.5f) * road.fWidth;
+			strip.leftHeight = segment.bDraped ? 0.0f : segment.fY1;
+			strip.rightHeight = segment.bDraped ? 0.0f : segment.fY2;
+			strip.sLeft = segment.fS1 * sScale;
+			strip.sRight = segment.fS2 * sScale;
+			strip.material = segment.intTexture;
+		}
+		return profile;
+	}
+
+	/// -------------------------------------------------------
+
+	RibbonTessellator::RibbonTessellator(RibbonProfile profile, const RibbonOptions &options)
+		: m_Profile(std::move(profile)), m_Options(options)
+	{
+		/// Parts store their indices grouped by material, so keep every list in material order.
+		const auto byMaterial = [](const auto &a, const auto &b) { return a.material < b.material; };
+		std::ranges::stable_sort(m_Profile.strips, byMaterial);
+		std::ranges::stable_sort(m_Profile.startCaps, byMaterial);
+		std::ranges::stable_sort(m_Profile.endCaps, byMaterial);
+		m_Profile.repeatLength = std::max(m_Profile.repeatLength, 1e-3f);
+		m_Options.miterLimit = std::max(m_Options.miterLimit, 1.0f);
+
+		for (const RibbonStrip &strip : m_Profile.strips)
+			m_Materials.push_back(strip.material);
+		for (const RibbonCap &cap : m_Profile.startCaps)
+			m_Materials.push_back(cap.material);
+		for (const RibbonCap &cap : m_Profile.endCaps)
+			m_Materials.push_back(cap.material);
+		std::ranges::sort(m_Materials);
+		m_Materials.erase(std::ranges::unique(m_Materials).begin(), m_Materials.end());
+
+		for (const RibbonStrip &strip : m_Profile.strips)
+			m_StripSlots.push_back(FindSlot(m_Materials, strip.material));
+	}
+
+	void RibbonTessellator::SetChain(std::vector<TessNode> nodes, const bool closed)
+	{
+		m_Nodes = std::move(nodes);
+		m_Closed = closed;
+		m_Edges.assign(GetEdgeCount(), {});
+		m_DirtyPoints.assign(m_Edges.size(), 1);
+		m_DirtyMeshes.assign(m_Edges.size(), 1);
+		m_DirtyCaps = true;
+		m_DirtyMesh = true;
+	}
+
+	void RibbonTessellator::MoveNode(const uint32_t node, const TessNode &value)
+	{
+		if (node >= m_Nodes.size())
+			return;
+
+		/// The two edges meeting at the node change shape, and the joins at their far ends change with them.
+		m_Nodes[node] = value;
+		MarkEdge(m_DirtyPoints, static_cast<int64_t>(node) - 1);
+		MarkEdge(m_DirtyPoints, node);
+		for (int64_t edge = static_cast<int64_t>(node) - 2; edge <= static_cast<int64_t>(node) + 1; ++edge)
+			MarkEdge(m_DirtyMeshes, edge);
+		m_DirtyMesh = true;
+	}
+
+	uint32_t RibbonTessellator::GetEdgeCount() const
+	{
+		const auto count = static_cast<uint32_t>(m_Nodes.size());
+		if (count < 2)
+			return 0;
+		return m_Closed && count >= 3 ? count : count - 1;
+	}
+
+	void RibbonTessellator::MarkEdge(std::vector<uint8_t> &dirty, int64_t edge) const
+	{
+		const auto count = static_cast<int64_t>(m_Edges.size());
+		if (count == 0)
+			return;
+		if (m_Closed && count == static_cast<int64_t>(m_Nodes.size()))
+			edge = (edge % count + count) % count;
+		if (edge >= 0 && edge < count)
+			dirty[edge] = 1;
+	}
+
+	const RibbonTessellator::Edge *RibbonTessellator::GetNeighbour(const uint32_t edge, const int step) const
+	{
+		const auto count = static_cast<int64_t>(m_Edges.size());
+		int64_t neighbour = static_cast<int64_t>(edge) + step;
+		if (m_Closed && count == static_cast<int64_t>(m_Nodes.size()))
+			neighbour = (neighbour + count) % count;
+		if (neighbour < 0 || neighbour >= count || m_Edges[neighbour].points.size() < 2)
+			return nullptr;
+		return &m_Edges[neighbour];
+	}
+
+	void RibbonTessellator::FlattenEdge(const uint32_t edge)
+	{
+		++m_Pending.edgesFlattened;
+
+		const TessNode &from = m_Nodes[edge];
+		const TessNode &to = m_Nodes[(edge + 1) % m_Nodes.size()];
+		std::vector<DVec2> &points = m_Edges[edge].points;
+		points.clear();
+		FlattenBezierEdge(from, to, m_Options.tessellation, points);
+		points.push_back(to.position);
+
+		/// Drop repeated points so every segment has a direction, keeping the end node exact.
+		double length = 0.0;
+		size_t kept = 1;
+		for (size_t i = 1; i < points.size(); ++i)
+		{
+			const double dx = points[i].x - points[kept - 1].x;
+			const double dz = points[i].y - points[kept - 1].y;
+			const double step = std::sqrt(dx * dx + dz * dz);
+			if (step < MIN_SEGMENT)
+			{
+				if (i + 1 == points.size() && kept > 1)
+					points[kept - 1] = points[i];
+				continue;
+			}
+			length += step;
+			points[kept++] = points[i];
+		}
+		points.resize(kept);
+		m_Edges[edge].length = length;
+	}
+
+	void RibbonTessellator::BuildEdge(const uint32_t edge)
+	{
+		++m_Pending.edgesBuilt;
+
+		Edge &current = m_Edges[edge];
+		Part &part = current.mesh;
+		part.vertices.clear();
+		part.indices.clear();
+		part.slotStarts.assign(m_Materials.size() + 1, 0);
+
+		const std::vector<DVec2> &points = current.points;
+		if (points.size() < 2)
+			return;
+
+		/// Joins at every point. The ends use the neighbouring edges, or run square at the ends of an open chain.
+		const size_t last = points.size() - 1;
+		const Edge *previous = GetNeighbour(edge, -1);
+		const Edge *next = GetNeighbour(edge, 1);
+		std::vector<Join> joins(points.size());
+		std::vector<float> along(points.size());
+		double distance = 0.0;
+		DVec2 in = previous ? Direction(previous->points[previous->points.size() - 2], previous->points.back()) : Direction(points[0], points[1]);
+		for (size_t i = 0; i <= last; ++i)
+		{
+			const DVec2 out = i < last ? Direction(points[i], points[i + 1]) : next ? Direction(next->points[0], next->points[1]) : in;
+			joins[i] = MakeJoin(in, out, m_Options.miterLimit);
+			if (i > 0)
+			{
+				const double dx = points[i].x - points[i - 1].x;
+				const double dz = points[i].y - points[i - 1].y;
+				distance += std::sqrt(dx * dx + dz * dz);
+			}
+			along[i] = static_cast<float>(distance / m_Profile.repeatLength);
+			in = out;
+		}
+
+		/// Texture coordinates along the edge start at 0; GetMesh() continues them from the previous edges.
+		part.vertices.reserve(points.size() * m_Profile.strips.size() * 2);
+		part.indices.reserve(last * m_Profile.strips.size() * 6);
+		uint32_t nextSlot = 0;
+		for (size_t s = 0; s < m_Profile.strips.size(); ++s)
+		{
+			const RibbonStrip &strip = m_Profile.strips[s];
+			while (nextSlot <= m_StripSlots[s])
+				part.slotStarts[nextSlot++] = static_cast<uint32_t>(part.indices.size());
+
+			/// The outgoing section of a bevel reuses the incoming section's vertices on the inner side.
+			const auto addSection = [&](const size_t i, const Section section, const Pair *incoming)
+			{
+				const Join &join = joins[i];
+				const DVec2 &right = join.bevel ? (section == Section::Incoming ? join.rightIn : join.rightOut) : join.miter;
+				const Vec3 normal = StripNormal(strip, right);
+				const auto add = [&](const float lateral, const float height, const float s, const uint32_t shared)
+				{
+					if (incoming && lateral * join.turn > 0.0)
+						return shared;
+					return AddVertex(part.vertices, Offset(join, points[i], lateral, section), height, normal, s, along[i]);
+				};
+				const uint32_t left = add(strip.left, strip.leftHeight, strip.sLeft, incoming ? incoming->left : 0);
+				const uint32_t rightIndex = add(strip.right, strip.rightHeight, strip.sRight, incoming ? incoming->right : 0);
+				return Pair{left, rightIndex};
+			};
+
+			/// A bevel is owned by the edge leaving it: the edge arriving stops at its incoming section.
+			Pair previousPair{};
+			for (size_t i = 0; i <= last; ++i)
+			{
+				const Join &join = joins[i];
+				if (!join.bevel || i == last)
+				{
+					const Pair pair = addSection(i, Section::Incoming, nullptr);
+					if (i > 0)
+						AddQuad(part.indices, previousPair, pair);
+					previousPair = pair;
+					continue;
+				}
+
+				/// The wedge between the two sections fills the outer side.
+				const Pair incoming = addSection(i, Section::Incoming, nullptr);
+				if (i > 0)
+					AddQuad(part.indices, previousPair, incoming);
+				const Pair outgoing = addSection(i, Section::Outgoing, &incoming);
+				AddQuad(part.indices, incoming, outgoing);
+				previousPair = outgoing;
+			}
+		}
+		while (nextSlot <= m_Materials.size())
+			part.slotStarts[nextSlot++] = static_cast<uint32_t>(part.indices.size());
+	}
+
+	void RibbonTessellator::BuildCaps()
+	{
+		m_Pending.capsBuilt = true;
+
+		const auto build = [this](Part &part, const std::vector<RibbonCap> &caps, const bool start)
+		{
+			part.vertices.clear();
+			part.indices.clear();
+			part.slotStarts.assign(m_Materials.size() + 1, 0);
+			if (m_Closed || caps.empty())
+				return;
+
+			/// The first or last edge that has a direction.
+			const Edge *edge = nullptr;
+			for (size_t i = 0; i < m_Edges.size(); ++i)
+			{
+				const Edge &candidate = m_Edges[start ? i : m_Edges.size() - 1 - i];
+				if (candidate.points.size() >= 2)
+				{
+					edge = &candidate;
+					break;
+				}
+			}
+			if (!edge)
+				return;
+
+			const std::vector<DVec2> &points = edge->points;
+			const DVec2 end = start ? points.front() : points.back();
+			const DVec2 direction = start ? Direction(points[0], points[1]) : Direction(points[points.size() - 2], points.back());
+			const DVec2 right = RightOf(direction);
+			const Vec3 up(0.0f, 1.0f, 0.0f);
+
+			/// Sections run in the direction of travel: outer to inner before the start, inner to outer past the end.
+			uint32_t nextSlot = 0;
+			for (const RibbonCap &cap : caps)
+			{
+				const uint32_t slot = FindSlot(m_Materials, cap.material);
+				while (nextSlot <= slot)
+					part.slotStarts[nextSlot++] = static_cast<uint32_t>(part.indices.size());
+
+				const double extend = start ? -cap.length : cap.length;
+				const DVec2 outer(end.x + direction.x * extend, end.y + direction.y * extend);
+				const auto addSection = [&](const DVec2 &point, const float t)
+				{
+					const DVec2 left(point.x + right.x * cap.left, point.y + right.y * cap.left);
+					const DVec2 rightPoint(point.x + right.x * cap.right, point.y + right.y * cap.right);
+					return Pair{AddVertex(part.vertices, left, 0.0f, up, cap.sLeft, t), AddVertex(part.vertices, rightPoint, 0.0f, up, cap.sRight, t)};
+				};
+				const Pair inner = addSection(end, cap.tInner);
+				const Pair outerPair = addSection(outer, cap.tOuter);
+				if (start)
+					AddQuad(part.indices, outerPair, inner);
+				else
+					AddQuad(part.indices, inner, outerPair);
+			}
+			while (nextSlot <= m_Materials.size())
+				part.slotStarts[nextSlot++] = static_cast<uint32_t>(part.indices.size());
+		};
+
+		build(m_StartCap, m_Profile.startCaps, true);
+		build(m_EndCap, m_Profile.endCaps, false);
+	}
+
+	const RibbonMesh &RibbonTessellator::GetMesh()
+	{
+		/// Caps follow whichever edges are first and last to have a direction.
+		bool endsFlattened = false;
+		for (uint32_t edge = 0; edge < m_Edges.size(); ++edge)
+		{
+			if (!m_DirtyPoints[edge])
+				continue;
+			FlattenEdge(edge);
+			m_DirtyPoints[edge] = 0;
+			endsFlattened |= edge <= 1 || edge + 2 >= m_Edges.size();
+		}
+		if (m_DirtyCaps || (endsFlattened && !m_Closed))
+		{
+			BuildCaps();
+			m_DirtyCaps = false;
+		}
+		for (uint32_t edge = 0; edge < m_Edges.size(); ++edge)
+		{
+			if (!m_DirtyMeshes[edge])
+				continue;
+			BuildEdge(edge);
+			m_DirtyMeshes[edge] = 0;
+		}
+
+		if (m_DirtyMesh)
+		{
+			std::vector<const Part *> parts;
+			parts.reserve(m_Edges.size() + 2);
+			parts.push_back(&m_StartCap);
+			for (const Edge &edge : m_Edges)
+				parts.push_back(&edge.mesh);
+			parts.push_back(&m_EndCap);
+
+			size_t vertexCount = 0;
+			size_t indexCount = 0;
+			for (const Part *part : parts)
+			{
+				vertexCount += part->vertices.size();
+				indexCount += part->indices.size();
+			}
+
+			m_Mesh.vertices.clear();
+			m_Mesh.indices.clear();
+			m_Mesh.batches.clear();
+			m_Mesh.vertices.reserve(vertexCount);
+			m_Mesh.indices.reserve(indexCount);
+
+			/// Edges continue the texture from the length of the chain before them. Only the fraction of a repeat is
+			/// kept, which the texture cannot tell apart, so coordinates stay small on long chains.
+			std::vector<uint32_t> bases;
+			bases.reserve(parts.size());
+			double distance = 0.0;
+			for (size_t p = 0; p < parts.size(); ++p)
+			{
+				bases.push_back(static_cast<uint32_t>(m_Mesh.vertices.size()));
+				m_Mesh.vertices.insert(m_Mesh.vertices.end(), parts[p]->vertices.begin(), parts[p]->vertices.end());
+				if (p == 0 || p + 1 == parts.size())
+					continue;
+
+				const double repeats = distance / m_Profile.repeatLength;
+				const auto offset = static_cast<float>(repeats - std::floor(repeats));
+				for (size_t v = bases.back(); v < m_Mesh.vertices.size(); ++v)
+					m_Mesh.vertices[v].texcoord.y += offset;
+				distance += m_Edges[p - 1].length;
+			}
+
+			for (uint32_t slot = 0; slot < m_Materials.size(); ++slot)
+			{
+				const auto start = static_cast<uint32_t>(m_Mesh.indices.size());
+				for (size_t p = 0; p < parts.size(); ++p)
+				{
+					const Part &part = *parts[p];
+					if (part.slotStarts.empty())
+						continue;
+					for (uint32_t i = part.slotStarts[slot]; i < part.slotStarts[slot + 1]; ++i)
+						m_Mesh.indices.push_back(bases[p] + part.indices[i]);
+				}
+				const auto count = static_cast<uint32_t>(m_Mesh.indices.size()) - start;
+				if (count > 0)
+					m_Mesh.batches.push_back({m_Materials[slot], start, count});
+			}
+			m_DirtyMesh = false;
+		}
+
+		m_LastUpdate = m_Pending;
+		m_Pending = {};
+		return m_Mesh;
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,188 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* ribbon_mesh.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <Math/includes/tessellation.h>
+#include <Math/includes/vector.h>
+#include <SceneryEditorX/utils/pointers.h>
+
+/// -------------------------------------------------------
+
+namespace XPAsset
+{
+	class Lin;
+	class Net;
+	struct NetRoadType;
+}
+
+namespace SceneryEditorX
+{
+	class MeshSource;
+
+	/// One quad strip of a ribbon's cross section. Lateral offsets are metres, positive to the right of the direction of travel.
+	struct RibbonStrip
+	{
+		float left = 0.0f;
+		float right = 0.0f;
+		float leftHeight = 0.0f;	///< Metres above the path
+		float rightHeight = 0.0f;
+		float sLeft = 0.0f;			///< Texture coordinate across the strip
+		float sRight = 0.0f;
+		uint32_t material = 0;		///< Line layer or road texture; the mesh has one batch per material
+	};
+
+	/// Texture drawn past an open end of a ribbon, flat on the path.
+	struct RibbonCap
+	{
+		float left = 0.0f;
+		float right = 0.0f;
+		float sLeft = 0.0f;
+		float sRight = 0.0f;
+		float tInner = 0.0f;		///< Texture coordinate at the end of the path
+		float tOuter = 0.0f;
+		float length = 0.0f;		///< Metres the cap extends past the end
+		uint32_t material = 0;
+	};
+
+	struct RibbonProfile
+	{
+		std::vector<RibbonStrip> strips;
+		std::vector<RibbonCap> startCaps;
+		std::vector<RibbonCap> endCaps;
+		float repeatLength = 1.0f;	///< Metres of path per repeat of the texture along it
+	};
+
+	/// Cross section of a painted line: one strip per S_OFFSET, the layer as the material.
+	[[nodiscard]] RibbonProfile MakeLineProfile(const XPAsset::Lin &line);
+
+	/// Cross section of a road type at its nearest LOD, the texture as the material. Draped segments lie on the path.
+	[[nodiscard]] RibbonProfile MakeRoadProfile(const XPAsset::Net &network, const XPAsset::NetRoadType &road);
+
+	struct RibbonVertex
+	{
+		Vec3 position;			///< Metres, X-Plane axes: +X east, +Y up, +Z south
+		Vec3 normal;
+		Vec2 texcoord;
+	};
+
+	/// A run of indices drawn with one material.
+	struct RibbonBatch
+	{
+		uint32_t material = 0;
+		uint32_t indexStart = 0;
+		uint32_t indexCount = 0;
+	};
+
+	/// Generated strip geometry. Triangles wind counter-clockwise seen from above; batches are in ascending material order.
+	struct RibbonMesh
+	{
+		std::vector<RibbonVertex> vertices;
+		std::vector<uint32_t> indices;
+		std::vector<RibbonBatch> batches;
+	};
+
+	struct RibbonOptions
+	{
+		TessOptions tessellation;	///< Flattening of curved edges
+		float miterLimit = 4.0f;	///< Joins whose miter would be longer than this many half widths are bevelled
+	};
+
+	/**
+	 * @brief Builds the strip geometry of one line or road chain and keeps it up to date as it is edited.
+	 *
+	 * Nodes are in metres on the X/Z plane (X east, Z south) and may carry bezier handles like apt.dat
+	 * line nodes. Curved edges are flattened with FlattenBezierEdge(), then every strip of the profile is
+	 * offset along the path. Corners are mitered so strips stay the same width; corners sharper than
+	 * the miter limit are bevelled on their outer side, with the inner side held at the limit. The
+	 * texture runs continuously along the whole chain, and open chains get the profile's caps.
+	 *
+	 * Flattened points and strip meshes are cached per edge. Moving a node re-flattens the two edges
+	 * meeting at it and rebuilds the meshes of the four edges whose joins it affects; GetMesh() then
+	 * joins the edges, which is a copy. Tight curves narrower than the ribbon fold on their inner side.
+	 */
+	class RibbonTessellator
+	{
+	public:
+		struct UpdateStats
+		{
+			uint32_t edgesFlattened = 0;	///< Edges re-flattened since the last GetMesh()
+			uint32_t edgesBuilt = 0;		///< Edge meshes rebuilt
+			bool capsBuilt = false;
+		};
+
+		explicit RibbonTessellator(RibbonProfile profile, const RibbonOptions &options = {});
+
+		void SetChain(std::vector<TessNode> nodes, bool closed);
+		void MoveNode(uint32_t node, const TessNode &value);
+
+		[[nodiscard]] const std::vector<TessNode> &GetNodes() const { return m_Nodes; }
+		[[nodiscard]] bool IsClosed() const { return m_Closed; }
+		[[nodiscard]] const RibbonProfile &GetProfile() const { return m_Profile; }
+
+		/// Brings the mesh up to date with the edits since the last call.
+		const RibbonMesh &GetMesh();
+
+		/// What the last GetMesh() had to redo.
+		[[nodiscard]] const UpdateStats &GetLastUpdate() const { return m_LastUpdate; }
+
+		/// Copies a generated mesh into a MeshSource with one submesh per batch.
+		static Ref<MeshSource> CreateMeshSource(const RibbonMesh &mesh);
+
+	private:
+		/// Geometry of one edge or cap. Indices are grouped by material slot and relative to the part's vertices.
+		struct Part
+		{
+			std::vector<RibbonVertex> vertices;
+			std::vector<uint32_t> indices;
+			std::vector<uint32_t> slotStarts;	///< First index of each material slot, plus the end
+		};
+
+		struct Edge
+		{
+			std::vector<DVec2> points;			///< Flattened, both end nodes included, no repeated points
+			double length = 0.0;
+			Part mesh;
+		};
+
+		[[nodiscard]] uint32_t GetEdgeCount() const;
+		[[nodiscard]] const Edge *GetNeighbour(uint32_t edge, int step) const;
+		void FlattenEdge(uint32_t edge);
+		void BuildEdge(uint32_t edge);
+		void BuildCaps();
+		void MarkEdge(std::vector<uint8_t> &dirty, int64_t edge) const;
+
+		RibbonProfile m_Profile;
+		RibbonOptions m_Options;
+		std::vector<uint32_t> m_StripSlots;		///< Material slot of each strip; the profile is kept sorted by material
+		std::vector<uint32_t> m_Materials;		///< Material of each slot, ascending
+
+		std::vector<TessNode> m_Nodes;
+		bool m_Closed = false;
+
+		std::vector<Edge> m_Edges;
+		std::vector<uint8_t> m_DirtyPoints;
+		std::vector<uint8_t> m_DirtyMeshes;
+		Part m_StartCap;
+		Part m_EndCap;
+		bool m_DirtyCaps = true;
+		bool m_DirtyMesh = true;
+
+		RibbonMesh m_Mesh;
+		UpdateStats m_Pending;
+		UpdateStats m_LastUpdate;
+	};
+
+}
+
+/// -------------------------------------------------------
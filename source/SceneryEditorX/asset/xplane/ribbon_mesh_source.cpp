@@ -0,0 +1,93 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* ribbon_mesh_source.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "ribbon_mesh.h"
+#include <cmath>
+#include <string>
+#include <SceneryEditorX/asset/mesh/mesh.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/// Kept apart from ribbon_mesh.cpp so the tessellator does not depend on the renderer headers mesh.h pulls in.
+	Ref<MeshSource> RibbonTessellator::CreateMeshSource(const RibbonMesh &mesh)
+	{
+		/// S runs across the ribbon, so the tangent follows the texture: accumulate dP/dS over the triangles.
+		std::vector<Vec3> tangents(mesh.vertices.size(), Vec3(0.0f, 0.0f, 0.0f));
+		for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+		{
+			const RibbonVertex &a = mesh.vertices[mesh.indices[i]];
+			const RibbonVertex &b = mesh.vertices[mesh.indices[i + 1]];
+			const RibbonVertex &c = mesh.vertices[mesh.indices[i + 2]];
+			const Vec3 e1 = b.position - a.position;
+			const Vec3 e2 = c.position - a.position;
+			const float du1 = b.texcoord.x - a.texcoord.x;
+			const float dv1 = b.texcoord.y - a.texcoord.y;
+			const float du2 = c.texcoord.x - a.texcoord.x;
+			const float dv2 = c.texcoord.y - a.texcoord.y;
+			const float determinant = du1 * dv2 - du2 * dv1;
+			if (std::abs(determinant) < 1e-12f)
+				continue;
+
+			const Vec3 tangent = (e1 * dv2 - e2 * dv1) / determinant;
+			for (size_t corner = 0; corner < 3; ++corner)
+				tangents[mesh.indices[i + corner]] = tangents[mesh.indices[i + corner]] + tangent;
+		}
+
+		std::vector<Vertex> vertices;
+		vertices.reserve(mesh.vertices.size());
+		for (size_t v = 0; v < mesh.vertices.size(); ++v)
+		{
+			const RibbonVertex &source = mesh.vertices[v];
+			const Vec3 &normal = source.normal;
+
+			/// Make the tangent perpendicular to the normal, falling back to east for untextured strips.
+			const Vec3 &sum = tangents[v];
+			const float along = sum.x * normal.x + sum.y * normal.y + sum.z * normal.z;
+			Vec3 tangent = sum - normal * along;
+			const float length = std::sqrt(tangent.x * tangent.x + tangent.y * tangent.y + tangent.z * tangent.z);
+			tangent = length > 1e-6f ? tangent / length : Vec3(1.0f, 0.0f, 0.0f);
+
+			Vertex &vertex = vertices.emplace_back();
+			vertex.Position = source.position;
+			vertex.Normal = normal;
+			vertex.Tangent = tangent;
+			vertex.Binormal = Vec3(normal.y * tangent.z - normal.z * tangent.y, normal.z * tangent.x - normal.x * tangent.z, normal.x * tangent.y - normal.y * tangent.x);
+			vertex.Texcoord = source.texcoord;
+		}
+
+		std::vector<Index> indices;
+		indices.reserve(mesh.indices.size() / 3);
+		for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+			indices.push_back({mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2]});
+
+		/// Batches share the vertices, so every submesh spans all of them.
+		std::vector<Submesh> submeshes;
+		submeshes.reserve(mesh.batches.size());
+		for (const RibbonBatch &batch : mesh.batches)
+		{
+			Submesh &submesh = submeshes.emplace_back();
+			submesh.BaseVertex = 0;
+			submesh.VertexCount = static_cast<uint32_t>(mesh.vertices.size());
+			submesh.BaseIndex = batch.indexStart;
+			submesh.IndexCount = batch.indexCount;
+			submesh.MaterialIndex = batch.material;
+			submesh.MeshName = "Material " + std::to_string(batch.material);
+		}
+
+		return CreateRef<MeshSource>(vertices, indices, submeshes);
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,532 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* terrain_height.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "terrain_height.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <string>
+#include <Math/includes/geodesy.h>
+#include <SceneryEditorX/asset/xplane/dsf_reader.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		/// Average triangles per grid cell the index is sized for, and the largest grid per tile.
+		constexpr double TRIANGLES_PER_CELL = 2.0;
+		constexpr uint32_t MAX_GRID = 2048;
+
+		/// Degrees (about 1 cm) trimmed off triangle bounds when binning. Raster triangles line up with the
+		/// cell edges, and without the trim float rounding would file each one under up to four cells.
+		constexpr float BIN_TRIM = 1e-7f;
+
+		/// Degrees a point may lie outside a triangle and still hit it. Covers both the trim and the rounding
+		/// of vertices to float, so points on a shared edge always hit one of its triangles.
+		constexpr double EDGE_TOLERANCE = 2.0 * BIN_TRIM;
+
+		/// Positions per ParallelForRange() job.
+		constexpr uint32_t QUERY_GRAIN = 4096;
+
+		double MillisecondsSince(const std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		/// Tile of a position as one number, or -1 off the globe. Longitudes wrap, latitude 90 belongs to the tiles below it.
+		int64_t TileKey(const double latitude, double longitude, int &west, int &south)
+		{
+			if (!(latitude >= -90.0 && latitude <= 90.0) || !std::isfinite(longitude))
+				return -1;
+			longitude -= 360.0 * std::floor((longitude + 180.0) / 360.0);
+			west = std::min(static_cast<int>(std::floor(longitude)), 179);
+			south = std::min(static_cast<int>(std::floor(latitude)), 89);
+			return static_cast<int64_t>(south + 90) * 360 + (west + 180);
+		}
+
+		int64_t TileKey(const double latitude, const double longitude)
+		{
+			int west, south;
+			return TileKey(latitude, longitude, west, south);
+		}
+
+		int64_t TileKeyOf(const int west, const int south)
+		{
+			if (west < -180 || west > 179 || south < -90 || south > 89)
+				return -1;
+			return static_cast<int64_t>(south + 90) * 360 + (west + 180);
+		}
+
+		/// Unrolls triangles, strips and fans of @p vertexCount vertices starting at @p base.
+		void AppendTriangles(const DSF::PrimitiveType type, const uint32_t base, const uint32_t vertexCount, std::vector<uint32_t> &indices)
+		{
+			if (vertexCount < 3)
+				return;
+			switch (type)
+			{
+			case DSF::PrimitiveType::Triangles:
+				for (uint32_t i = 0; i + 2 < vertexCount; i += 3)
+					indices.insert(indices.end(), {base + i, base + i + 1, base + i + 2});
+				break;
+			case DSF::PrimitiveType::TriangleStrip:
+				/// Every other triangle of a strip is flipped to keep the winding.
+				for (uint32_t i = 0; i + 2 < vertexCount; ++i)
+				{
+					if (i % 2 == 0)
+						indices.insert(indices.end(), {base + i, base + i + 1, base + i + 2});
+					else
+						indices.insert(indices.end(), {base + i + 1, base + i, base + i + 2});
+				}
+				break;
+			case DSF::PrimitiveType::TriangleFan:
+				for (uint32_t i = 1; i + 1 < vertexCount; ++i)
+					indices.insert(indices.end(), {base, base + i, base + i + 1});
+				break;
+			}
+		}
+
+		/// Picks the base mesh out of a DSF's command stream.
+		class TerrainCollector final : public DSFCommandHandler
+		{
+		public:
+			explicit TerrainCollector(TerrainMesh &out) : m_Out(out) {}
+
+			void OnBeginPatch(const DSFPatch &patch) override
+			{
+				m_Keep = (patch.flags & DSF::PATCH_PHYSICAL) != 0 && (patch.flags & DSF::PATCH_OVERLAY) == 0 && patch.nearLOD <= 0.0f;
+			}
+
+			void OnPatchPrimitive(const DSFPrimitive &primitive) override
+			{
+				if (m_Keep)
+					AppendTerrainPrimitive(primitive, m_Out);
+			}
+
+			void OnEndPatch() override { m_Keep = false; }
+
+		private:
+			TerrainMesh &m_Out;
+			bool m_Keep = false;
+		};
+	}
+
+	/// -------------------------------------------------------
+
+	void AppendTerrainPrimitive(const DSFPrimitive &primitive, TerrainMesh &out)
+	{
+		if (primitive.planeCount < 3 || primitive.coords.size() < static_cast<size_t>(primitive.vertexCount) * primitive.planeCount)
+			return;
+
+		const uint32_t base = static_cast<uint32_t>(out.vertices.size());
+		out.vertices.reserve(out.vertices.size() + primitive.vertexCount);
+		for (uint32_t i = 0; i < primitive.vertexCount; ++i)
+		{
+			const double *point = &primitive.coords[static_cast<size_t>(i) * primitive.planeCount];
+			out.vertices.emplace_back(point[0], point[1], point[2]);
+		}
+		AppendTriangles(primitive.type, base, primitive.vertexCount, out.indices);
+	}
+
+	bool BuildTerrainMesh(DSFReader &reader, TerrainMesh &out)
+	{
+		out = {};
+		TerrainCollector collector(out);
+		return reader.ReadCommands(collector);
+	}
+
+	void BuildTerrainMesh(const float *heights, const uint32_t columns, const uint32_t rows, const double west, const double south, const double east, const double north,
+	                      TerrainMesh &out)
+	{
+		out = {};
+		if (columns < 2 || rows < 2)
+			return;
+
+		out.vertices.reserve(static_cast<size_t>(columns) * rows);
+		for (uint32_t row = 0; row < rows; ++row)
+		{
+			const double latitude = north - (north - south) * row / (rows - 1);
+			for (uint32_t column = 0; column < columns; ++column)
+				out.vertices.emplace_back(west + (east - west) * column / (columns - 1), latitude, heights[static_cast<size_t>(row) * columns + column]);
+		}
+
+		/// Counter-clockwise seen from above; cells touching a void (NaN post) are left out.
+		out.indices.reserve(static_cast<size_t>(columns - 1) * (rows - 1) * 6);
+		for (uint32_t row = 0; row + 1 < rows; ++row)
+		{
+			for (uint32_t column = 0; column + 1 < columns; ++column)
+			{
+				const uint32_t nw = row * columns + column;
+				const uint32_t ne = nw + 1;
+				const uint32_t sw = nw + columns;
+				const uint32_t se = sw + 1;
+				if (std::isnan(out.vertices[nw].z) || std::isnan(out.vertices[ne].z) || std::isnan(out.vertices[sw].z) || std::isnan(out.vertices[se].z))
+					continue;
+				out.indices.insert(out.indices.end(), {nw, sw, ne, ne, sw, se});
+			}
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	struct TerrainHeightService::Tile
+	{
+		int west = 0;
+		int south = 0;
+		std::vector<float> positions;			///< Degrees east and north of the corner, then elevation
+		std::vector<uint32_t> indices;
+		std::vector<uint32_t> cellStarts;		///< grid * grid + 1 offsets into cellTriangles, rows from the south
+		std::vector<uint32_t> cellTriangles;
+		uint32_t grid = 0;
+		double sinCentre = 0.0;					///< Of the tile's middle latitude
+		double cosCentre = 1.0;
+		bool pinned = false;
+		uint64_t lastUse = 0;
+		size_t bytes = 0;
+
+		[[nodiscard]] uint32_t Cell(const double degrees) const
+		{
+			return static_cast<uint32_t>(std::clamp(static_cast<int64_t>(degrees * grid), int64_t(0), static_cast<int64_t>(grid) - 1));
+		}
+
+		void Build(const TerrainMesh &mesh)
+		{
+			positions.resize(mesh.vertices.size() * 3);
+			for (size_t i = 0; i < mesh.vertices.size(); ++i)
+			{
+				positions[i * 3] = static_cast<float>(mesh.vertices[i].x - west);
+				positions[i * 3 + 1] = static_cast<float>(mesh.vertices[i].y - south);
+				positions[i * 3 + 2] = static_cast<float>(mesh.vertices[i].z);
+			}
+			indices = mesh.indices;
+			sinCentre = std::sin((south + 0.5) * (std::numbers::pi / 180.0));
+			cosCentre = std::cos((south + 0.5) * (std::numbers::pi / 180.0));
+
+			const size_t triangles = indices.size() / 3;
+			grid = static_cast<uint32_t>(std::clamp(std::ceil(std::sqrt(static_cast<double>(triangles) / TRIANGLES_PER_CELL)), 1.0, static_cast<double>(MAX_GRID)));
+
+			/// Counting pass, then fill: each triangle goes to every cell its bounds overlap.
+			const auto forEachCell = [&](const size_t triangle, const auto &visit)
+			{
+				const float *a = &positions[indices[triangle * 3] * 3];
+				const float *b = &positions[indices[triangle * 3 + 1] * 3];
+				const float *c = &positions[indices[triangle * 3 + 2] * 3];
+				const auto range = [&](const float low, const float high, uint32_t &first, uint32_t &last)
+				{
+					const bool trim = high - low > 2.0f * BIN_TRIM;
+					first = Cell(trim ? low + BIN_TRIM : low);
+					last = Cell(trim ? high - BIN_TRIM : high);
+				};
+				uint32_t x0, x1, y0, y1;
+				range(std::min({a[0], b[0], c[0]}), std::max({a[0], b[0], c[0]}), x0, x1);
+				range(std::min({a[1], b[1], c[1]}), std::max({a[1], b[1], c[1]}), y0, y1);
+				for (uint32_t y = y0; y <= y1; ++y)
+				{
+					for (uint32_t x = x0; x <= x1; ++x)
+						visit(y * grid + x);
+				}
+			};
+
+			cellStarts.assign(static_cast<size_t>(grid) * grid + 1, 0);
+			for (size_t t = 0; t < triangles; ++t)
+				forEachCell(t, [&](const uint32_t cell) { ++cellStarts[cell + 1]; });
+			for (size_t cell = 1; cell < cellStarts.size(); ++cell)
+				cellStarts[cell] += cellStarts[cell - 1];
+
+			cellTriangles.resize(cellStarts.back());
+			std::vector<uint32_t> cursor(cellStarts.begin(), cellStarts.end() - 1);
+			for (size_t t = 0; t < triangles; ++t)
+				forEachCell(t, [&](const uint32_t cell) { cellTriangles[cursor[cell]++] = static_cast<uint32_t>(t); });
+
+			bytes = sizeof(Tile) + positions.capacity() * sizeof(float) +
+			        (indices.capacity() + cellStarts.capacity() + cellTriangles.capacity()) * sizeof(uint32_t);
+		}
+
+		bool Sample(const double latitude, const double longitude, TerrainSample &out) const
+		{
+			if (!grid)
+				return false;
+
+			const double x = longitude - 360.0 * std::floor((longitude + 180.0) / 360.0) - west;
+			const double y = latitude - south;
+			const uint32_t cell = Cell(y) * grid + Cell(x);
+			for (uint32_t k = cellStarts[cell]; k < cellStarts[cell + 1]; ++k)
+			{
+				const uint32_t triangle = cellTriangles[k];
+				const float *a = &positions[indices[triangle * 3] * 3];
+				const float *b = &positions[indices[triangle * 3 + 1] * 3];
+				const float *c = &positions[indices[triangle * 3 + 2] * 3];
+
+				/// Barycentric coordinates scaled by the signed area; divided out only for the hit.
+				double area = (static_cast<double>(b[1]) - c[1]) * (a[0] - c[0]) + (static_cast<double>(c[0]) - b[0]) * (a[1] - c[1]);
+				if (area == 0.0)
+					continue;
+				double u = (static_cast<double>(b[1]) - c[1]) * (x - c[0]) + (static_cast<double>(c[0]) - b[0]) * (y - c[1]);
+				double v = (static_cast<double>(c[1]) - a[1]) * (x - c[0]) + (static_cast<double>(a[0]) - c[0]) * (y - c[1]);
+				if (area < 0.0)
+				{
+					area = -area;
+					u = -u;
+					v = -v;
+				}
+				/// Each scaled coordinate is the distance to an edge times its length, the L1 length stands in for it.
+				const double slackA = -EDGE_TOLERANCE * (std::abs(static_cast<double>(c[0]) - b[0]) + std::abs(static_cast<double>(c[1]) - b[1]));
+				const double slackB = -EDGE_TOLERANCE * (std::abs(static_cast<double>(a[0]) - c[0]) + std::abs(static_cast<double>(a[1]) - c[1]));
+				const double slackC = -EDGE_TOLERANCE * (std::abs(static_cast<double>(b[0]) - a[0]) + std::abs(static_cast<double>(b[1]) - a[1]));
+				if (u < slackA || v < slackB || area - u - v < slackC)
+					continue;
+				u /= area;
+				v /= area;
+				const double w = 1.0 - u - v;
+
+				out.height = u * a[2] + v * b[2] + w * c[2];
+				out.hit = true;
+
+				/// Normal of the triangle in metres, using the ellipsoid's radii of curvature at the query. Sine and
+				/// cosine of the latitude come from series about the tile's middle, exact to 1e-9 within the tile.
+				const double delta = (y - 0.5) * (std::numbers::pi / 180.0);
+				const double even = 1.0 - delta * delta * 0.5, odd = delta * (1.0 - delta * delta / 6.0);
+				const double sinPhi = sinCentre * even + cosCentre * odd;
+				const double cosPhi = cosCentre * even - sinCentre * odd;
+				const double curvature = 1.0 - WGS84::E2 * sinPhi * sinPhi;
+				const double metresPerDegreeEast = WGS84::A / std::sqrt(curvature) * cosPhi * (std::numbers::pi / 180.0);
+				const double metresPerDegreeNorth = WGS84::A * (1.0 - WGS84::E2) / (curvature * std::sqrt(curvature)) * (std::numbers::pi / 180.0);
+				const double e1x = (static_cast<double>(b[0]) - a[0]) * metresPerDegreeEast, e1y = (static_cast<double>(b[1]) - a[1]) * metresPerDegreeNorth;
+				const double e2x = (static_cast<double>(c[0]) - a[0]) * metresPerDegreeEast, e2y = (static_cast<double>(c[1]) - a[1]) * metresPerDegreeNorth;
+				const double e1z = static_cast<double>(b[2]) - a[2], e2z = static_cast<double>(c[2]) - a[2];
+				double nx = e1y * e2z - e1z * e2y;
+				double ny = e1z * e2x - e1x * e2z;
+				double nz = e1x * e2y - e1y * e2x;
+				const double length = std::copysign(std::sqrt(nx * nx + ny * ny + nz * nz), nz);
+				if (length != 0.0)
+				{
+					nx /= length;
+					ny /= length;
+					nz /= length;
+					out.normal = Vec3(static_cast<float>(nx), static_cast<float>(ny), static_cast<float>(nz));
+				}
+				return true;
+			}
+			return false;
+		}
+	};
+
+	/// -------------------------------------------------------
+
+	TerrainHeightService::TerrainHeightService(const size_t memoryBudget) : m_MemoryBudget(memoryBudget)
+	{
+	}
+
+	TerrainHeightService::~TerrainHeightService() = default;
+
+	void TerrainHeightService::SetTileLoader(TileLoader loader)
+	{
+		m_Loader = std::move(loader);
+	}
+
+	void TerrainHeightService::SetMemoryBudget(const size_t bytes)
+	{
+		m_MemoryBudget = bytes;
+		++m_Clock;
+		Evict();
+	}
+
+	bool TerrainHeightService::Fail(std::string error)
+	{
+		m_Error = std::move(error);
+		return false;
+	}
+
+	bool TerrainHeightService::AddTile(const int west, const int south, const TerrainMesh &mesh)
+	{
+		const int64_t key = TileKeyOf(west, south);
+		if (key < 0)
+			return Fail("Tile " + std::to_string(west) + ", " + std::to_string(south) + " is off the globe");
+		if (mesh.indices.size() % 3 != 0)
+			return Fail("Terrain index count is not a multiple of three");
+		for (const uint32_t index : mesh.indices)
+		{
+			if (index >= mesh.vertices.size())
+				return Fail("Terrain index " + std::to_string(index) + " is past the last vertex");
+		}
+
+		RemoveTile(west, south);
+		auto tile = std::make_unique<Tile>();
+		tile->west = west;
+		tile->south = south;
+		tile->pinned = true;
+		tile->lastUse = m_Clock;
+		tile->Build(mesh);
+
+		m_Stats.memoryBytes += tile->bytes;
+		m_Tiles.emplace(key, std::move(tile));
+		m_Stats.residentTiles = static_cast<uint32_t>(m_Tiles.size());
+		Evict();
+		return true;
+	}
+
+	void TerrainHeightService::RemoveTile(const int west, const int south)
+	{
+		const auto found = m_Tiles.find(TileKeyOf(west, south));
+		if (found == m_Tiles.end())
+			return;
+		m_Stats.memoryBytes -= found->second->bytes;
+		m_Tiles.erase(found);
+		m_Stats.residentTiles = static_cast<uint32_t>(m_Tiles.size());
+	}
+
+	void TerrainHeightService::Clear()
+	{
+		m_Tiles.clear();
+		m_Stats.memoryBytes = 0;
+		m_Stats.residentTiles = 0;
+	}
+
+	TerrainHeightService::Tile *TerrainHeightService::Acquire(const int64_t key)
+	{
+		if (key < 0)
+			return nullptr;
+
+		const auto found = m_Tiles.find(key);
+		if (found != m_Tiles.end())
+		{
+			found->second->lastUse = m_Clock;
+			return found->second.get();
+		}
+		if (!m_Loader)
+			return nullptr;
+
+		/// Tiles without terrain are cached too, empty, so the loader is not asked again every frame.
+		auto tile = std::make_unique<Tile>();
+		tile->west = static_cast<int>(key % 360) - 180;
+		tile->south = static_cast<int>(key / 360) - 90;
+		tile->lastUse = m_Clock;
+
+		TerrainMesh mesh;
+		const bool valid = m_Loader(tile->west, tile->south, mesh) && mesh.indices.size() % 3 == 0 &&
+		                   std::ranges::all_of(mesh.indices, [&](const uint32_t index) { return index < mesh.vertices.size(); });
+		if (valid)
+		{
+			tile->Build(mesh);
+			++m_Stats.tilesLoaded;
+		}
+		else
+			tile->bytes = sizeof(Tile);
+
+		Tile *result = tile.get();
+		m_Stats.memoryBytes += tile->bytes;
+		m_Tiles.emplace(key, std::move(tile));
+		m_Stats.residentTiles = static_cast<uint32_t>(m_Tiles.size());
+		return result;
+	}
+
+	void TerrainHeightService::Evict()
+	{
+		/// Tile counts stay in the tens, so a scan for the oldest beats keeping an ordered list up to date per query.
+		while (m_Stats.memoryBytes > m_MemoryBudget)
+		{
+			auto oldest = m_Tiles.end();
+			for (auto it = m_Tiles.begin(); it != m_Tiles.end(); ++it)
+			{
+				if (!it->second->pinned && it->second->lastUse < m_Clock && (oldest == m_Tiles.end() || it->second->lastUse < oldest->second->lastUse))
+					oldest = it;
+			}
+			if (oldest == m_Tiles.end())
+				break;
+
+			m_Stats.memoryBytes -= oldest->second->bytes;
+			m_Tiles.erase(oldest);
+			++m_Stats.tilesEvicted;
+		}
+		m_Stats.residentTiles = static_cast<uint32_t>(m_Tiles.size());
+	}
+
+	bool TerrainHeightService::Sample(const double latitude, const double longitude, TerrainSample &out)
+	{
+		++m_Clock;
+		out = {};
+		const Tile *tile = Acquire(TileKey(latitude, longitude));
+		const bool hit = tile && tile->Sample(latitude, longitude, out);
+		Evict();
+
+		++m_Stats.queries;
+		if (!hit)
+			++m_Stats.misses;
+		return hit;
+	}
+
+	void TerrainHeightService::Sample(const double *latitude, const double *longitude, TerrainSample *out, const size_t count, const TerrainQueryOptions &options)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		++m_Clock;
+
+		/// Load every tile the batch touches first, so the workers below only read the map.
+		int64_t lastKey = -1;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const int64_t key = TileKey(latitude[i], longitude[i]);
+			if (key != lastKey)
+			{
+				Acquire(key);
+				lastKey = key;
+			}
+		}
+
+		std::atomic<uint64_t> misses = 0;
+		const auto run = [&](const size_t begin, const size_t end)
+		{
+			const Tile *tile = nullptr;
+			int64_t tileKey = -1;
+			uint64_t localMisses = 0;
+			for (size_t i = begin; i < end; ++i)
+			{
+				out[i] = {};
+				const int64_t key = TileKey(latitude[i], longitude[i]);
+				if (key != tileKey)
+				{
+					const auto found = m_Tiles.find(key);
+					tile = found != m_Tiles.end() ? found->second.get() : nullptr;
+					tileKey = key;
+				}
+				if (!tile || !tile->Sample(latitude[i], longitude[i], out[i]))
+					++localMisses;
+			}
+			misses += localMisses;
+		};
+
+		ThreadPool *pool = options.parallel && count > QUERY_GRAIN ? (options.threadPool ? options.threadPool : &ThreadPool::Get()) : nullptr;
+		if (pool)
+		{
+			/// ParallelForRange() counts in 32 bits; larger batches go in slices.
+			constexpr size_t slice = size_t(1) << 30;
+			for (size_t first = 0; first < count; first += slice)
+			{
+				const uint32_t length = static_cast<uint32_t>(std::min(slice, count - first));
+				pool->ParallelForRange(length, QUERY_GRAIN, [&](const uint32_t begin, const uint32_t end) { run(first + begin, first + end); });
+			}
+		}
+		else
+			run(0, count);
+
+		Evict();
+		m_Stats.queries += count;
+		m_Stats.misses += misses;
+		m_Stats.lastBatchMs = MillisecondsSince(start);
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,148 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* terrain_height.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Math/includes/vector.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	class DSFReader;
+	class ThreadPool;
+	struct DSFPrimitive;
+
+	/// Terrain triangles. Vertices are longitude and latitude in degrees and elevation in metres MSL.
+	struct TerrainMesh
+	{
+		std::vector<DVec3> vertices;
+		std::vector<uint32_t> indices;		///< Three per triangle
+	};
+
+	/// Appends the triangles of a DSF patch primitive, unrolling strips and fans.
+	void AppendTerrainPrimitive(const DSFPrimitive &primitive, TerrainMesh &out);
+
+	/**
+	 * @brief Collects the base mesh of an open DSF.
+	 *
+	 * Only physical, non-overlay patches at the nearest LOD are kept: those are the surface
+	 * the sim drives on. Returns false with DSFReader::GetError() set on malformed commands.
+	 */
+	bool BuildTerrainMesh(DSFReader &reader, TerrainMesh &out);
+
+	/**
+	 * @brief Triangulates an elevation raster, two triangles per cell.
+	 *
+	 * @param heights Row major, north row first as in DEM GeoTIFFs and HGT files. Posts sit on
+	 *                the bounds, so the first and last columns are at @p west and @p east.
+	 */
+	void BuildTerrainMesh(const float *heights, uint32_t columns, uint32_t rows, double west, double south, double east, double north, TerrainMesh &out);
+
+	/// -------------------------------------------------------
+
+	struct TerrainSample
+	{
+		double height = std::numeric_limits<double>::quiet_NaN();	///< Metres MSL, NaN where no terrain was hit
+		Vec3 normal = Vec3(0.0f, 0.0f, 1.0f);						///< Unit, east-north-up
+		bool hit = false;
+	};
+
+	struct TerrainQueryOptions
+	{
+		bool parallel = true;
+		ThreadPool *threadPool = nullptr;	///< Defaults to ThreadPool::Get()
+	};
+
+	struct TerrainHeightStats
+	{
+		uint32_t residentTiles = 0;			///< Tiles in memory, empty ones included
+		size_t memoryBytes = 0;
+		uint64_t tilesLoaded = 0;
+		uint64_t tilesEvicted = 0;
+		uint64_t queries = 0;
+		uint64_t misses = 0;				///< Queries that hit no triangle
+		double lastBatchMs = 0.0;
+	};
+
+	/**
+	 * @brief Ground elevation under lat/lon positions, for snapping placed objects to terrain.
+	 *
+	 * Terrain is held per 1 x 1 degree tile, as DSFs are. Each tile's triangles are binned into a
+	 * uniform grid sized to about two triangles per cell, stored as one offsets array and one
+	 * triangle list, so a query is a cell lookup and a handful of barycentric tests. Vertices are
+	 * kept as floats relative to the tile corner (a few millimetres of resolution).
+	 *
+	 * Tiles come either from AddTile(), which pins them, or from the tile loader on first use.
+	 * Loaded tiles are cached and the least recently used ones are dropped whenever the cache
+	 * goes over its memory budget; a tile a query is using is never dropped by that query.
+	 *
+	 * Batch queries load the tiles they need up front and then run read only on the thread pool.
+	 * The service itself is not thread safe: drive it from one thread.
+	 */
+	class TerrainHeightService
+	{
+	public:
+		/// Fills the mesh of the tile whose south-west corner is (@p west, @p south). False when there is no terrain there.
+		using TileLoader = std::function<bool(int west, int south, TerrainMesh &out)>;
+
+		explicit TerrainHeightService(size_t memoryBudget = size_t(512) << 20);
+		~TerrainHeightService();
+
+		TerrainHeightService(const TerrainHeightService &) = delete;
+		TerrainHeightService &operator=(const TerrainHeightService &) = delete;
+
+		void SetTileLoader(TileLoader loader);
+
+		/// Evicts right away when the cache is already over the new budget.
+		void SetMemoryBudget(size_t bytes);
+		[[nodiscard]] size_t GetMemoryBudget() const { return m_MemoryBudget; }
+
+		/// Indexes @p mesh as the tile at (@p west, @p south), replacing any cached one. Vertices may spill over the tile edge.
+		bool AddTile(int west, int south, const TerrainMesh &mesh);
+		void RemoveTile(int west, int south);
+		void Clear();
+
+		/// Ground under one position. Returns false, with @p out.hit false, outside the terrain.
+		bool Sample(double latitude, double longitude, TerrainSample &out);
+
+		/// Ground under @p count positions, in parallel.
+		void Sample(const double *latitude, const double *longitude, TerrainSample *out, size_t count, const TerrainQueryOptions &options = {});
+
+		[[nodiscard]] const std::string &GetError() const { return m_Error; }
+		[[nodiscard]] const TerrainHeightStats &GetStats() const { return m_Stats; }
+
+	private:
+		struct Tile;
+
+		Tile *Acquire(int64_t key);
+		void Evict();
+		bool Fail(std::string error);
+
+		std::unordered_map<int64_t, std::unique_ptr<Tile>> m_Tiles;
+		TileLoader m_Loader;
+		size_t m_MemoryBudget;
+		uint64_t m_Clock = 0;				///< Stamp of the current query, for least recently used eviction
+		std::string m_Error;
+		TerrainHeightStats m_Stats;
+	};
+
+}
+
+/// -------------------------------------------------------
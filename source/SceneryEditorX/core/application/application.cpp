@@ -131,6 +131,9 @@ namespace SceneryEditorX
 
         m_Window->ProcessEvents();
 
+		// Frame point for the event bus; its listeners may post and queue freely, so run them before taking the lock
+		m_EventBus.Dispatch();
+
 		// NOTE: we have no control over what func() does.  holding this lock while calling func() is a bad idea:
 		// 1) func() might be slow (means we hold the lock for ages)
 		// 2) func() might result in events getting queued, in which case we have a deadlock
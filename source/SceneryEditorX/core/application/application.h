@@ -14,6 +14,7 @@
 #include <deque>
 #include "application_data.h"
 #include "SceneryEditorX/core/events/application_events.h"
+#include "SceneryEditorX/core/events/event_bus.h"
 #include "SceneryEditorX/core/events/event_system.h"
 #include "SceneryEditorX/core/modules/module_stage.h"
 #include "SceneryEditorX/core/time/time.h"
@@ -91,6 +92,9 @@ namespace SceneryEditorX
 			m_EventQueue.emplace_back(true, func);
 		}
 
+		/// Queued, type-indexed events that any thread can post; delivered in ProcessEvents().
+		EventBus &GetEventBus() { return m_EventBus; }
+
 		// Creates & Dispatches an event either immediately, or adds it to an event queue which will be processed after the next call
 		// to SyncEvents().
 		// Waiting until after next sync gives the application some control over _when_ the events will be processed.
@@ -135,6 +139,7 @@ namespace SceneryEditorX
         std::unordered_map<const char *, PerformanceProfiler::PerFrameData> m_ProfilerPreviousFrameData;
         std::deque<std::pair<bool, std::function<void()>>> m_EventQueue;
         std::mutex m_EventQueueMutex;
+        EventBus m_EventBus;
         std::vector<EventCallbackFn> m_EventCallbacks;
 
 		uint32_t currentFrameIndex = 0;
@@ -34,6 +34,7 @@ namespace SceneryEditorX
 
 		EVENT_CLASS_TYPE(WindowResize)
 		EVENT_CLASS_CATEGORY(EventCategoryApplication)
+		EVENT_CLASS_COALESCED
 	private:
 		unsigned int m_Width, m_Height;
 	};
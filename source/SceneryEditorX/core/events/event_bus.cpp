@@ -0,0 +1,66 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* event_bus.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "event_bus.h"
+#include "SceneryEditorX/logging/asserts.h"
+
+/// -------------------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	EventBus::~EventBus()
+	{
+		const uint32_t count = m_ChannelCount.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < count; ++i)
+			delete m_Ordered[i].load(std::memory_order_relaxed);
+	}
+
+	uint32_t EventBus::NextTypeIndex()
+	{
+		static std::atomic<uint32_t> next = 0;
+		const uint32_t index = next.fetch_add(1, std::memory_order_relaxed);
+		SEDX_CORE_ASSERT(index < MaxEventTypes, "Raise EventBus::MaxEventTypes");
+		return index;
+	}
+
+	void EventBus::Unsubscribe(const ListenerHandle handle)
+	{
+		const uint32_t typeSlot = static_cast<uint32_t>(handle >> 32);
+		if (typeSlot == 0 || typeSlot > MaxEventTypes)
+			return;
+
+		if (EventChannelBase *channel = m_Channels[typeSlot - 1].load(std::memory_order_acquire))
+			channel->RemoveListener(static_cast<uint32_t>(handle));
+	}
+
+	uint32_t EventBus::Dispatch()
+	{
+		// Channels created while dispatching are picked up on the next frame
+		const uint32_t count = m_ChannelCount.load(std::memory_order_acquire);
+		uint32_t delivered = 0;
+		for (uint32_t i = 0; i < count; ++i)
+			delivered += m_Ordered[i].load(std::memory_order_acquire)->Dispatch();
+		return delivered;
+	}
+
+	EventBusStats EventBus::GetStats() const
+	{
+		EventBusStats stats;
+		const uint32_t count = m_ChannelCount.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < count; ++i)
+			m_Ordered[i].load(std::memory_order_acquire)->AddStats(stats);
+		return stats;
+	}
+
+}
+
+/// -------------------------------------------------------------------
@@ -0,0 +1,458 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* event_bus.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// -------------------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/**
+	 * @brief Events of which only the latest one per dispatch is delivered.
+	 *
+	 * An event class opts in with EVENT_CLASS_COALESCED, e.g. mouse moves and resizes,
+	 * where listeners only care about where things ended up this frame.
+	 */
+	template<typename T>
+	concept CoalescedEvent = requires { { T::Coalesced } -> std::convertible_to<bool>; } && T::Coalesced;
+
+	struct EventBusStats
+	{
+		uint64_t Posted = 0;
+		uint64_t Delivered = 0;		///< Events handed to listeners; coalesced events count once
+		uint64_t Coalesced = 0;		///< Events dropped because a later one of the same type replaced them
+		uint64_t Dropped = 0;		///< Posts refused because a channel ran out of storage
+	};
+
+	/// -------------------------------------------------------------------
+
+	class EventChannelBase
+	{
+	public:
+		virtual ~EventChannelBase() = default;
+
+		virtual uint32_t Dispatch() = 0;
+		virtual void RemoveListener(uint32_t id) = 0;
+		virtual void AddStats(EventBusStats &stats) const = 0;
+	};
+
+	/**
+	 * @brief Pooled storage, queue and listeners for one event type.
+	 *
+	 * Events live in fixed chunks of nodes addressed by 32-bit index. Free nodes sit on a
+	 * Treiber stack whose head carries a tag against ABA, and posted nodes go through an
+	 * intrusive multi-producer single-consumer queue, so posting never takes a lock once
+	 * the pool has grown to the working size. Growing the pool takes a mutex.
+	 *
+	 * Dispatch() and the listener functions must be called from one thread.
+	 */
+	template<typename T>
+	class EventChannel final : public EventChannelBase
+	{
+	public:
+		using ListenerFn = std::function<bool(T &)>;
+
+		EventChannel()
+		{
+			m_Stub = Acquire();
+			At(m_Stub).Next.store(Nil, std::memory_order_relaxed);
+			m_Back.store(m_Stub, std::memory_order_relaxed);
+			m_Front = m_Stub;
+		}
+
+		~EventChannel() override
+		{
+			for (uint32_t index = Pop(); index != Nil; index = Pop())
+				At(index).Event.reset();
+
+			const uint32_t chunkCount = m_ChunkCount.load(std::memory_order_acquire);
+			for (uint32_t chunk = 0; chunk < chunkCount; ++chunk)
+				delete[] m_Chunks[chunk].load(std::memory_order_relaxed);
+		}
+
+		EventChannel(const EventChannel &) = delete;
+		EventChannel &operator=(const EventChannel &) = delete;
+
+		/**
+		 * @brief Constructs an event in the pool and queues it. Safe from any thread.
+		 * @return False if the pool is full.
+		 */
+		template<typename... Args>
+		bool Post(Args &&...args)
+		{
+			const uint32_t index = Acquire();
+			if (index == Nil)
+			{
+				m_Dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			At(index).Event.emplace(std::forward<Args>(args)...);
+			Push(index);
+			m_Posted.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		uint32_t AddListener(ListenerFn fn)
+		{
+			const uint32_t id = ++m_LastListenerId;
+			if (m_Dispatching)
+				m_PendingListeners.push_back({id, std::move(fn)});
+			else
+				m_Listeners.push_back({id, std::move(fn)});
+			return id;
+		}
+
+		void RemoveListener(uint32_t id) override
+		{
+			for (auto *listeners : {&m_Listeners, &m_PendingListeners})
+			{
+				for (Listener &listener : *listeners)
+				{
+					if (listener.Id == id)
+					{
+						listener.Id = 0;
+						m_HasRemovedListeners = true;
+					}
+				}
+			}
+
+			if (!m_Dispatching)
+				CompactListeners();
+		}
+
+		/**
+		 * @brief Delivers every event queued so far, oldest first.
+		 *
+		 * Listeners run in the order they subscribed; one returning true stops the event
+		 * there. Events posted while dispatching wait for the next Dispatch().
+		 *
+		 * @return Number of events delivered.
+		 */
+		uint32_t Dispatch() override
+		{
+			m_Batch.clear();
+			for (uint32_t index = Pop(); index != Nil; index = Pop())
+				m_Batch.push_back(index);
+			if (m_Batch.empty())
+				return 0;
+
+			size_t first = 0;
+			if constexpr (CoalescedEvent<T>)
+			{
+				first = m_Batch.size() - 1;
+				m_Coalesced += first;
+			}
+
+			m_Dispatching = true;
+			for (size_t i = first; i < m_Batch.size(); ++i)
+			{
+				T &event = *At(m_Batch[i]).Event;
+				for (const Listener &listener : m_Listeners)
+				{
+					if (listener.Id != 0 && listener.Fn(event))
+						break;
+				}
+			}
+			m_Dispatching = false;
+
+			for (const uint32_t index : m_Batch)
+			{
+				At(index).Event.reset();
+				Release(index);
+			}
+
+			const auto delivered = static_cast<uint32_t>(m_Batch.size() - first);
+			m_Delivered += delivered;
+
+			if (!m_PendingListeners.empty())
+			{
+				for (Listener &listener : m_PendingListeners)
+					m_Listeners.push_back(std::move(listener));
+				m_PendingListeners.clear();
+			}
+			CompactListeners();
+			return delivered;
+		}
+
+		void AddStats(EventBusStats &stats) const override
+		{
+			stats.Posted += m_Posted.load(std::memory_order_relaxed);
+			stats.Dropped += m_Dropped.load(std::memory_order_relaxed);
+			stats.Delivered += m_Delivered;
+			stats.Coalesced += m_Coalesced;
+		}
+
+	private:
+		static constexpr uint32_t Nil = 0xFFFFFFFFu;
+		static constexpr uint32_t ChunkShift = 8;
+		static constexpr uint32_t ChunkSize = 1u << ChunkShift;
+		static constexpr uint32_t MaxChunks = 4096;		///< 1M events in flight per type
+
+		struct Node
+		{
+			std::optional<T> Event;
+			std::atomic<uint32_t> Next = Nil;	///< Queue link while posted, free list link while free
+		};
+
+		struct Listener
+		{
+			uint32_t Id = 0;				///< 0 once removed
+			ListenerFn Fn;
+		};
+
+		static uint64_t Pack(uint32_t index, uint32_t tag) { return (uint64_t(tag) << 32) | index; }
+		static uint32_t IndexOf(uint64_t head) { return static_cast<uint32_t>(head); }
+		static uint32_t TagOf(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+
+		Node &At(uint32_t index) const
+		{
+			return m_Chunks[index >> ChunkShift].load(std::memory_order_acquire)[index & (ChunkSize - 1)];
+		}
+
+		uint32_t Acquire()
+		{
+			uint64_t head = m_FreeHead.load(std::memory_order_acquire);
+			while (IndexOf(head) != Nil)
+			{
+				// The link may be stale if another thread took the node first; the tag then fails the exchange
+				const uint32_t next = At(IndexOf(head)).Next.load(std::memory_order_relaxed);
+				if (m_FreeHead.compare_exchange_weak(head, Pack(next, TagOf(head) + 1), std::memory_order_acq_rel, std::memory_order_acquire))
+					return IndexOf(head);
+			}
+			return Grow();
+		}
+
+		void Release(uint32_t index)
+		{
+			ReleaseChain(index, index);
+		}
+
+		/// Pushes the linked nodes first..last onto the free list.
+		void ReleaseChain(uint32_t first, uint32_t last)
+		{
+			uint64_t head = m_FreeHead.load(std::memory_order_relaxed);
+			do
+			{
+				At(last).Next.store(IndexOf(head), std::memory_order_relaxed);
+			}
+			while (!m_FreeHead.compare_exchange_weak(head, Pack(first, TagOf(head) + 1), std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		uint32_t Grow()
+		{
+			std::lock_guard<std::mutex> lock(m_GrowMutex);
+			const uint32_t chunk = m_ChunkCount.load(std::memory_order_relaxed);
+			if (chunk == MaxChunks)
+				return Nil;
+
+			Node *nodes = new Node[ChunkSize];
+			m_Chunks[chunk].store(nodes, std::memory_order_release);
+			m_ChunkCount.store(chunk + 1, std::memory_order_release);
+
+			// Keep the first node for the caller and free the rest in one exchange
+			const uint32_t base = chunk << ChunkShift;
+			for (uint32_t i = 1; i + 1 < ChunkSize; ++i)
+				nodes[i].Next.store(base + i + 1, std::memory_order_relaxed);
+			ReleaseChain(base + 1, base + ChunkSize - 1);
+			return base;
+		}
+
+		void Push(uint32_t index)
+		{
+			At(index).Next.store(Nil, std::memory_order_relaxed);
+			const uint32_t previous = m_Back.exchange(index, std::memory_order_acq_rel);
+			At(previous).Next.store(index, std::memory_order_release);
+		}
+
+		/// Consumer side of the queue. Returns Nil when empty, or when a producer is between
+		/// its exchange and its link; that event is picked up by the next call.
+		uint32_t Pop()
+		{
+			uint32_t front = m_Front;
+			uint32_t next = At(front).Next.load(std::memory_order_acquire);
+			if (front == m_Stub)
+			{
+				if (next == Nil)
+					return Nil;
+				m_Front = next;
+				front = next;
+				next = At(next).Next.load(std::memory_order_acquire);
+			}
+
+			if (next != Nil)
+			{
+				m_Front = next;
+				return front;
+			}
+
+			if (front != m_Back.load(std::memory_order_acquire))
+				return Nil;
+
+			Push(m_Stub);
+			next = At(front).Next.load(std::memory_order_acquire);
+			if (next != Nil)
+			{
+				m_Front = next;
+				return front;
+			}
+			return Nil;
+		}
+
+		void CompactListeners()
+		{
+			if (!m_HasRemovedListeners)
+				return;
+			std::erase_if(m_Listeners, [](const Listener &listener) { return listener.Id == 0; });
+			std::erase_if(m_PendingListeners, [](const Listener &listener) { return listener.Id == 0; });
+			m_HasRemovedListeners = false;
+		}
+
+		// Pool
+		std::array<std::atomic<Node *>, MaxChunks> m_Chunks{};
+		std::atomic<uint32_t> m_ChunkCount = 0;
+		std::atomic<uint64_t> m_FreeHead = Pack(Nil, 0);
+		std::mutex m_GrowMutex;
+
+		// Queue; producers share the back, the dispatching thread owns the front
+		alignas(64) std::atomic<uint32_t> m_Back = Nil;
+		alignas(64) uint32_t m_Front = Nil;
+		uint32_t m_Stub = Nil;
+
+		std::atomic<uint64_t> m_Posted = 0;
+		std::atomic<uint64_t> m_Dropped = 0;
+
+		// Dispatching thread only
+		std::vector<Listener> m_Listeners;
+		std::vector<Listener> m_PendingListeners;	///< Subscribed during a dispatch
+		std::vector<uint32_t> m_Batch;
+		uint32_t m_LastListenerId = 0;
+		uint64_t m_Delivered = 0;
+		uint64_t m_Coalesced = 0;
+		bool m_Dispatching = false;
+		bool m_HasRemovedListeners = false;
+	};
+
+	/// -------------------------------------------------------------------
+
+	/**
+	 * @brief Queued event bus that carries events from any thread to the main thread.
+	 *
+	 * Post() may be called from any thread, e.g. the asset or render thread, and does not
+	 * take a lock in steady state. Events wait in per-type pools until Dispatch(), which
+	 * the application calls once per frame, delivers them in per-type batches to the
+	 * listeners of that type. Order is kept within a type but not across types; code that
+	 * needs the two to interleave should use the immediate EventDispatcher path.
+	 *
+	 * Subscribe(), Unsubscribe() and Dispatch() belong to the dispatching thread. Listeners
+	 * may subscribe, unsubscribe and post from inside a dispatch.
+	 */
+	class EventBus
+	{
+	public:
+		using ListenerHandle = uint64_t;
+
+		static constexpr uint32_t MaxEventTypes = 256;
+
+		EventBus() = default;
+		~EventBus();
+
+		EventBus(const EventBus &) = delete;
+		EventBus &operator=(const EventBus &) = delete;
+
+		/**
+		 * @brief Queues an event of type T constructed from args.
+		 * @return False if the pool for T is full and the event was dropped.
+		 */
+		template<typename T, typename... Args>
+		bool Post(Args &&...args)
+		{
+			return GetChannel<T>().Post(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Registers a listener for events of type T.
+		 *
+		 * The function takes T& and returns bool (true stops later listeners) or void.
+		 */
+		template<typename T, typename Func>
+		ListenerHandle Subscribe(Func &&func)
+		{
+			typename EventChannel<T>::ListenerFn fn;
+			if constexpr (std::is_void_v<std::invoke_result_t<Func &, T &>>)
+				fn = [f = std::forward<Func>(func)](T &event) mutable { f(event); return false; };
+			else
+				fn = std::forward<Func>(func);
+
+			const uint32_t id = GetChannel<T>().AddListener(std::move(fn));
+			return (ListenerHandle(TypeIndex<T>() + 1) << 32) | id;
+		}
+
+		void Unsubscribe(ListenerHandle handle);
+
+		/**
+		 * @brief Delivers every queued event; the frame point for queued events.
+		 * @return Number of events delivered.
+		 */
+		uint32_t Dispatch();
+
+		[[nodiscard]] EventBusStats GetStats() const;
+
+	private:
+		template<typename T>
+		static uint32_t TypeIndex()
+		{
+			static const uint32_t index = NextTypeIndex();
+			return index;
+		}
+
+		static uint32_t NextTypeIndex();
+
+		template<typename T>
+		EventChannel<T> &GetChannel()
+		{
+			const uint32_t index = TypeIndex<T>();
+			if (EventChannelBase *channel = m_Channels[index].load(std::memory_order_acquire))
+				return static_cast<EventChannel<T> &>(*channel);
+
+			std::lock_guard<std::mutex> lock(m_ChannelMutex);
+			if (EventChannelBase *channel = m_Channels[index].load(std::memory_order_acquire))
+				return static_cast<EventChannel<T> &>(*channel);
+
+			auto *channel = new EventChannel<T>();
+			const uint32_t order = m_ChannelCount.load(std::memory_order_relaxed);
+			m_Ordered[order].store(channel, std::memory_order_release);
+			m_ChannelCount.store(order + 1, std::memory_order_release);
+			m_Channels[index].store(channel, std::memory_order_release);
+			return *channel;
+		}
+
+		std::array<std::atomic<EventChannelBase *>, MaxEventTypes> m_Channels{};	///< By type index
+		std::array<std::atomic<EventChannelBase *>, MaxEventTypes> m_Ordered{};	///< In creation order, for Dispatch()
+		std::atomic<uint32_t> m_ChannelCount = 0;
+		std::mutex m_ChannelMutex;
+	};
+
+}
+
+/// -------------------------------------------------------------------
@@ -69,6 +69,9 @@ namespace SceneryEditorX
 
     #define EVENT_CLASS_CATEGORY(category) virtual int GetCategoryFlags() const override { return category; }
 
+    /// Marks events of which EventBus only delivers the latest per dispatch, e.g. mouse moves.
+    #define EVENT_CLASS_COALESCED static constexpr bool Coalesced = true;
+
     /// -------------------------------------------------------------------
 
 	class Event
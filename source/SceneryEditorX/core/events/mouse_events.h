@@ -36,6 +36,7 @@ namespace SceneryEditorX
 
 		EVENT_CLASS_TYPE(MouseMoved)
 		EVENT_CLASS_CATEGORY(EventCategoryMouse | EventCategoryInput)
+		EVENT_CLASS_COALESCED
 	private:
 		float m_MouseX, m_MouseY;
 	};
@@ -0,0 +1,165 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* md5.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "md5.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		constexpr uint32_t SHIFTS[64] = {
+			7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+			5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+			4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+			6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+		};
+
+		/// floor(abs(sin(i + 1)) * 2^32)
+		constexpr uint32_t SINES[64] = {
+			0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+			0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+			0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+			0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+			0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+			0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+			0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+			0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+		};
+	}
+
+	MD5::MD5()
+	{
+		Reset();
+	}
+
+	void MD5::Reset()
+	{
+		m_State[0] = 0x67452301;
+		m_State[1] = 0xefcdab89;
+		m_State[2] = 0x98badcfe;
+		m_State[3] = 0x10325476;
+		m_Length = 0;
+		m_Buffered = 0;
+	}
+
+	void MD5::Transform(const uint8_t *block)
+	{
+		uint32_t words[16];
+		for (int i = 0; i < 16; ++i)
+		{
+			words[i] = static_cast<uint32_t>(block[i * 4]) | static_cast<uint32_t>(block[i * 4 + 1]) << 8 |
+			           static_cast<uint32_t>(block[i * 4 + 2]) << 16 | static_cast<uint32_t>(block[i * 4 + 3]) << 24;
+		}
+
+		uint32_t a = m_State[0];
+		uint32_t b = m_State[1];
+		uint32_t c = m_State[2];
+		uint32_t d = m_State[3];
+
+		for (uint32_t i = 0; i < 64; ++i)
+		{
+			uint32_t f;
+			uint32_t g;
+			if (i < 16)
+			{
+				f = (b & c) | (~b & d);
+				g = i;
+			}
+			else if (i < 32)
+			{
+				f = (d & b) | (~d & c);
+				g = (5 * i + 1) & 15;
+			}
+			else if (i < 48)
+			{
+				f = b ^ c ^ d;
+				g = (3 * i + 5) & 15;
+			}
+			else
+			{
+				f = c ^ (b | ~d);
+				g = (7 * i) & 15;
+			}
+
+			const uint32_t next = d;
+			d = c;
+			c = b;
+			b = b + std::rotl(a + f + SINES[i] + words[g], static_cast<int>(SHIFTS[i]));
+			a = next;
+		}
+
+		m_State[0] += a;
+		m_State[1] += b;
+		m_State[2] += c;
+		m_State[3] += d;
+	}
+
+	void MD5::Update(const void *data, size_t size)
+	{
+		const auto *bytes = static_cast<const uint8_t *>(data);
+		m_Length += size;
+
+		if (m_Buffered)
+		{
+			const size_t take = std::min(size, sizeof(m_Buffer) - m_Buffered);
+			std::memcpy(m_Buffer + m_Buffered, bytes, take);
+			m_Buffered += take;
+			bytes += take;
+			size -= take;
+			if (m_Buffered < sizeof(m_Buffer))
+				return;
+			Transform(m_Buffer);
+			m_Buffered = 0;
+		}
+
+		for (; size >= 64; size -= 64, bytes += 64)
+			Transform(bytes);
+
+		std::memcpy(m_Buffer, bytes, size);
+		m_Buffered = size;
+	}
+
+	MD5::Digest MD5::Finalize()
+	{
+		const uint64_t bits = m_Length * 8;
+		constexpr uint8_t padding[64] = { 0x80 };
+		Update(padding, m_Buffered < 56 ? 56 - m_Buffered : 120 - m_Buffered);
+
+		uint8_t length[8];
+		for (int i = 0; i < 8; ++i)
+			length[i] = static_cast<uint8_t>(bits >> (i * 8));
+		Update(length, sizeof(length));
+
+		Digest digest;
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+				digest[i * 4 + j] = static_cast<uint8_t>(m_State[i] >> (j * 8));
+		}
+		return digest;
+	}
+
+	MD5::Digest MD5::Compute(const void *data, const size_t size)
+	{
+		MD5 md5;
+		md5.Update(data, size);
+		return md5.Finalize();
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,53 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* md5.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/**
+	 * @brief Incremental MD5 digest (RFC 1321).
+	 *
+	 * Only used where a file format requires it, such as the DSF footer. It is not a secure hash.
+	 */
+	class MD5
+	{
+	public:
+		using Digest = std::array<uint8_t, 16>;
+
+		MD5();
+
+		void Update(const void *data, size_t size);
+
+		/// Pads and returns the digest. The object must be Reset() before reuse.
+		Digest Finalize();
+		void Reset();
+
+		static Digest Compute(const void *data, size_t size);
+
+	private:
+		void Transform(const uint8_t *block);
+
+		uint32_t m_State[4];
+		uint64_t m_Length = 0;
+		uint8_t m_Buffer[64];
+		size_t m_Buffered = 0;
+	};
+
+}
+
+/// -------------------------------------------------------
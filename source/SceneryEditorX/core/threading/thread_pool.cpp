@@ -0,0 +1,173 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* thread_pool.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "thread_pool.h"
+#include <algorithm>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	ThreadPool::ThreadPool(uint32_t workerCount)
+	{
+		if (workerCount == 0)
+		{
+			const uint32_t hw = std::thread::hardware_concurrency();
+			workerCount = hw > 1 ? hw - 1 : 1;
+		}
+
+		m_Workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i)
+			m_Workers.emplace_back([this]() { WorkerLoop(); });
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_JobAvailable.notify_all();
+
+		for (auto &worker : m_Workers)
+		{
+			if (worker.joinable())
+				worker.join();
+		}
+	}
+
+	ThreadPool &ThreadPool::Get()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+
+	void ThreadPool::Enqueue(std::function<void()> job)
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Jobs.emplace_back(std::move(job));
+		}
+		m_JobAvailable.notify_one();
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock lock(m_Mutex);
+				m_JobAvailable.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+				if (m_Stopping && m_Jobs.empty())
+					return;
+
+				job = std::move(m_Jobs.front());
+				m_Jobs.pop_front();
+				++m_ActiveJobs;
+			}
+
+			job();
+
+			{
+				std::lock_guard lock(m_Mutex);
+				--m_ActiveJobs;
+				if (m_ActiveJobs == 0 && m_Jobs.empty())
+					m_Idle.notify_all();
+			}
+		}
+	}
+
+	void ThreadPool::WaitIdle()
+	{
+		std::unique_lock lock(m_Mutex);
+		m_Idle.wait(lock, [this]() { return m_ActiveJobs == 0 && m_Jobs.empty(); });
+	}
+
+	void ThreadPool::ParallelFor(const uint32_t count, const std::function<void(uint32_t)> &func)
+	{
+		ParallelForRange(count, 1, [&func](const uint32_t begin, const uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+				func(i);
+		});
+	}
+
+	void ThreadPool::ParallelForRange(const uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)> &func)
+	{
+		if (count == 0)
+			return;
+
+		grainSize = std::max(grainSize, 1u);
+		const uint32_t chunkCount = (count + grainSize - 1) / grainSize;
+		if (chunkCount == 1 || m_Workers.empty())
+		{
+			func(0, count);
+			return;
+		}
+
+		/// Shared between the caller and the helper jobs; helpers may still be queued after the caller returns.
+		struct State
+		{
+			std::atomic<uint32_t> nextChunk {0};
+			std::atomic<uint32_t> doneChunks {0};
+			std::mutex mutex;
+			std::condition_variable finished;
+			std::exception_ptr error;
+		};
+		auto state = std::make_shared<State>();
+
+		auto drain = [state, count, grainSize, chunkCount, &func]()
+		{
+			while (true)
+			{
+				const uint32_t chunk = state->nextChunk.fetch_add(1, std::memory_order_relaxed);
+				if (chunk >= chunkCount)
+					return;
+
+				const uint32_t begin = chunk * grainSize;
+				const uint32_t end = std::min(begin + grainSize, count);
+				try
+				{
+					func(begin, end);
+				}
+				catch (...)
+				{
+					std::lock_guard lock(state->mutex);
+					if (!state->error)
+						state->error = std::current_exception();
+				}
+
+				if (state->doneChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == chunkCount)
+				{
+					std::lock_guard lock(state->mutex);
+					state->finished.notify_all();
+				}
+			}
+		};
+
+		/// `func` is only touched while chunks remain, and the caller does not return before every chunk is done.
+		const uint32_t helpers = std::min(chunkCount - 1, GetWorkerCount());
+		for (uint32_t i = 0; i < helpers; ++i)
+			Enqueue(drain);
+
+		drain();
+
+		std::unique_lock lock(state->mutex);
+		state->finished.wait(lock, [&state, chunkCount]() { return state->doneChunks.load(std::memory_order_acquire) == chunkCount; });
+		if (state->error)
+			std::rethrow_exception(state->error);
+	}
+
+}
+
+/// -------------------------------------------------------
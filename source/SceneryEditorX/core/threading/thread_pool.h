@@ -0,0 +1,104 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* thread_pool.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/**
+	 * @brief Fixed-size pool of worker threads for CPU bound jobs.
+	 *
+	 * Jobs are pulled from a single FIFO queue. ParallelFor() lets the calling thread
+	 * take part in the work, so it is safe to call from inside a job running on the
+	 * same pool without starving it.
+	 */
+	class ThreadPool
+	{
+	public:
+		/**
+		 * @brief Creates the pool.
+		 * @param workerCount Number of worker threads. 0 picks hardware_concurrency() - 1 (at least 1).
+		 */
+		explicit ThreadPool(uint32_t workerCount = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool &operator=(const ThreadPool &) = delete;
+
+		/**
+		 * @brief Queues a job and returns a future for its result.
+		 */
+		template<typename Func, typename... Args>
+		auto Submit(Func &&func, Args &&...args) -> std::future<std::invoke_result_t<Func, Args...>>
+		{
+			using Result = std::invoke_result_t<Func, Args...>;
+			auto task = std::make_shared<std::packaged_task<Result()>>(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
+			std::future<Result> future = task->get_future();
+			Enqueue([task]() { (*task)(); });
+			return future;
+		}
+
+		/**
+		 * @brief Runs func(i) for every i in [0, count) and blocks until all have finished.
+		 *
+		 * The calling thread works through indices alongside the pool. The first exception
+		 * thrown by any invocation is rethrown on the calling thread.
+		 */
+		void ParallelFor(uint32_t count, const std::function<void(uint32_t)> &func);
+
+		/**
+		 * @brief Same as ParallelFor() but hands out contiguous [begin, end) ranges of at most grainSize items.
+		 */
+		void ParallelForRange(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t begin, uint32_t end)> &func);
+
+		/**
+		 * @brief Blocks until the job queue is empty and every worker is idle.
+		 */
+		void WaitIdle();
+
+        [[nodiscard]] uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+		/**
+		 * @brief Process wide pool shared by the asset pipeline and importers.
+		 */
+		static ThreadPool &Get();
+
+	private:
+		void Enqueue(std::function<void()> job);
+		void WorkerLoop();
+
+		std::vector<std::thread> m_Workers;
+		std::deque<std::function<void()>> m_Jobs;
+		std::mutex m_Mutex;
+		std::condition_variable m_JobAvailable;
+		std::condition_variable m_Idle;
+		uint32_t m_ActiveJobs = 0;
+		bool m_Stopping = false;
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,349 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* file_watcher.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "file_watcher.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#ifdef __linux__
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+
+		std::filesystem::path NormalizeDirectory(const std::filesystem::path &directory)
+		{
+			std::error_code ec;
+			std::filesystem::path absolute = std::filesystem::absolute(directory, ec);
+			if (ec)
+				return {};
+			absolute = absolute.lexically_normal();
+			// "dir/" normalizes with an empty filename, which would break the prefix checks below
+			if (!absolute.has_filename() && absolute.has_parent_path() && absolute != absolute.root_path())
+				absolute = absolute.parent_path();
+			return absolute;
+		}
+
+		bool IsWithin(const std::filesystem::path &path, const std::filesystem::path &directory)
+		{
+			const auto [dirEnd, pathIt] = std::mismatch(directory.begin(), directory.end(), path.begin(), path.end());
+			return dirEnd == directory.end();
+		}
+
+		/// -------------------------------------------------------
+
+		/**
+		 * Portable fallback: walks every watched tree each interval and diffs write times and sizes.
+		 * The cost grows with the number of files, so it is meant for platforms without a native backend.
+		 */
+		class PollingFileWatcher final : public FileWatcher
+		{
+		public:
+			explicit PollingFileWatcher(const std::chrono::milliseconds interval) : m_Interval(interval) {}
+
+			bool AddDirectory(const std::filesystem::path &directory) override
+			{
+				const std::filesystem::path root = NormalizeDirectory(directory);
+				std::error_code ec;
+				if (root.empty() || !std::filesystem::is_directory(root, ec))
+					return false;
+
+				for (const Root &existing : m_Roots)
+				{
+					if (existing.Directory == root)
+						return true;
+				}
+
+				Root &added = m_Roots.emplace_back();
+				added.Directory = root;
+				Scan(root, added.Files);
+				return true;
+			}
+
+			void RemoveDirectory(const std::filesystem::path &directory) override
+			{
+				const std::filesystem::path root = NormalizeDirectory(directory);
+				std::erase_if(m_Roots, [&root](const Root &existing) { return existing.Directory == root; });
+			}
+
+			size_t Poll(std::vector<FileChangeEvent> &events, const std::chrono::milliseconds timeout) override
+			{
+				Clock::time_point now = Clock::now();
+				if (now < m_NextScan)
+				{
+					if (m_NextScan - now > timeout)
+					{
+						std::this_thread::sleep_for(timeout);
+						return 0;
+					}
+					std::this_thread::sleep_until(m_NextScan);
+					now = Clock::now();
+				}
+				m_NextScan = now + m_Interval;
+
+				const size_t before = events.size();
+				for (Root &root : m_Roots)
+				{
+					std::unordered_map<std::string, FileState> files;
+					files.reserve(root.Files.size());
+					Scan(root.Directory, files);
+
+					for (const auto &[path, state] : files)
+					{
+						const auto it = root.Files.find(path);
+						if (it == root.Files.end())
+							events.push_back({ path, FileChangeType::Added, now });
+						else if (it->second.WriteTime != state.WriteTime || it->second.Size != state.Size)
+							events.push_back({ path, FileChangeType::Modified, now });
+					}
+					for (const auto &[path, state] : root.Files)
+					{
+						if (!files.contains(path))
+							events.push_back({ path, FileChangeType::Removed, now });
+					}
+					root.Files.swap(files);
+				}
+				return events.size() - before;
+			}
+
+			[[nodiscard]] const char *GetBackendName() const override { return "polling"; }
+
+		private:
+			struct FileState
+			{
+				std::filesystem::file_time_type WriteTime;
+				uintmax_t Size = 0;
+			};
+
+			struct Root
+			{
+				std::filesystem::path Directory;
+				std::unordered_map<std::string, FileState> Files;
+			};
+
+			static void Scan(const std::filesystem::path &directory, std::unordered_map<std::string, FileState> &files)
+			{
+				std::error_code ec;
+				std::filesystem::recursive_directory_iterator it(directory, std::filesystem::directory_options::skip_permission_denied, ec);
+				for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+				{
+					if (!it->is_regular_file(ec))
+						continue;
+
+					FileState state;
+					state.WriteTime = it->last_write_time(ec);
+					state.Size = it->file_size(ec);
+					if (!ec)
+						files.emplace(it->path().lexically_normal().string(), state);
+					ec.clear();
+				}
+			}
+
+			std::vector<Root> m_Roots;
+			std::chrono::milliseconds m_Interval;
+			Clock::time_point m_NextScan = Clock::now();
+		};
+
+		/// -------------------------------------------------------
+
+	#ifdef __linux__
+		/**
+		 * inotify backend. inotify is not recursive, so every directory in a watched tree gets
+		 * its own watch, and directories created later are added as their create event arrives.
+		 */
+		class InotifyFileWatcher final : public FileWatcher
+		{
+		public:
+			explicit InotifyFileWatcher(const int fd) : m_Fd(fd) {}
+
+			~InotifyFileWatcher() override
+			{
+				close(m_Fd);
+			}
+
+			bool AddDirectory(const std::filesystem::path &directory) override
+			{
+				const std::filesystem::path root = NormalizeDirectory(directory);
+				std::error_code ec;
+				if (root.empty() || !std::filesystem::is_directory(root, ec))
+					return false;
+
+				if (!WatchTree(root, nullptr))
+					return false;
+
+				if (std::ranges::find(m_Roots, root) == m_Roots.end())
+					m_Roots.push_back(root);
+				return true;
+			}
+
+			void RemoveDirectory(const std::filesystem::path &directory) override
+			{
+				const std::filesystem::path root = NormalizeDirectory(directory);
+				std::erase(m_Roots, root);
+				Unwatch(root);
+			}
+
+			size_t Poll(std::vector<FileChangeEvent> &events, const std::chrono::milliseconds timeout) override
+			{
+				pollfd pfd{ m_Fd, POLLIN, 0 };
+				if (poll(&pfd, 1, static_cast<int>(timeout.count())) <= 0)
+					return 0;
+
+				const size_t before = events.size();
+				alignas(inotify_event) char buffer[16 * 1024];
+				while (true)
+				{
+					const ssize_t length = read(m_Fd, buffer, sizeof(buffer));
+					if (length <= 0)
+						break;
+
+					const Clock::time_point now = Clock::now();
+					for (ssize_t offset = 0; offset < length;)
+					{
+						const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+						offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+						Translate(*event, now, events);
+					}
+				}
+				return events.size() - before;
+			}
+
+			[[nodiscard]] const char *GetBackendName() const override { return "inotify"; }
+
+		private:
+			static constexpr uint32_t WatchMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM |
+				IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+			/**
+			 * Watches @p directory and everything below it. When @p events is set the tree is new,
+			 * so files that were written into it before the watch existed are reported as added.
+			 */
+			bool WatchTree(const std::filesystem::path &directory, std::vector<FileChangeEvent> *events)
+			{
+				if (!Watch(directory))
+					return false;
+
+				const Clock::time_point now = Clock::now();
+				std::error_code ec;
+				std::filesystem::recursive_directory_iterator it(directory, std::filesystem::directory_options::skip_permission_denied, ec);
+				for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+				{
+					if (it->is_directory(ec))
+						Watch(it->path().lexically_normal());
+					else if (events && it->is_regular_file(ec))
+						events->push_back({ it->path().lexically_normal(), FileChangeType::Added, now });
+					ec.clear();
+				}
+				return true;
+			}
+
+			bool Watch(const std::filesystem::path &directory)
+			{
+				const int wd = inotify_add_watch(m_Fd, directory.c_str(), WatchMask);
+				if (wd < 0)
+					return false;
+
+				m_Directories[wd] = directory;
+				return true;
+			}
+
+			void Unwatch(const std::filesystem::path &directory)
+			{
+				for (auto it = m_Directories.begin(); it != m_Directories.end();)
+				{
+					if (IsWithin(it->second, directory))
+					{
+						inotify_rm_watch(m_Fd, it->first);
+						it = m_Directories.erase(it);
+					}
+					else
+						++it;
+				}
+			}
+
+			void Translate(const inotify_event &event, const Clock::time_point now, std::vector<FileChangeEvent> &events)
+			{
+				if (event.mask & IN_Q_OVERFLOW)
+				{
+					for (const std::filesystem::path &root : m_Roots)
+						events.push_back({ root, FileChangeType::Overflow, now });
+					return;
+				}
+
+				if (event.mask & IN_IGNORED)
+				{
+					m_Directories.erase(event.wd);
+					return;
+				}
+
+				const auto dir = m_Directories.find(event.wd);
+				if (dir == m_Directories.end() || event.len == 0)
+					return;
+
+				std::filesystem::path path = dir->second / event.name;
+				if (event.mask & IN_ISDIR)
+				{
+					// Files inside a removed tree are reported one by one; a tree moved away is simply forgotten
+					if (event.mask & (IN_CREATE | IN_MOVED_TO))
+						WatchTree(path, &events);
+					else if (event.mask & IN_MOVED_FROM)
+						Unwatch(path);
+					return;
+				}
+
+				if (event.mask & (IN_CREATE | IN_MOVED_TO))
+					events.push_back({ std::move(path), FileChangeType::Added, now });
+				else if (event.mask & (IN_DELETE | IN_MOVED_FROM))
+					events.push_back({ std::move(path), FileChangeType::Removed, now });
+				else if (event.mask & (IN_MODIFY | IN_CLOSE_WRITE))
+					events.push_back({ std::move(path), FileChangeType::Modified, now });
+			}
+
+			int m_Fd = -1;
+			std::unordered_map<int, std::filesystem::path> m_Directories;	///< Watch descriptor -> directory
+			std::vector<std::filesystem::path> m_Roots;
+		};
+	#endif
+	}
+
+	/// -------------------------------------------------------
+
+	std::unique_ptr<FileWatcher> FileWatcher::Create()
+	{
+	#ifdef __linux__
+		const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (fd >= 0)
+			return std::make_unique<InotifyFileWatcher>(fd);
+	#endif
+		return CreatePolling();
+	}
+
+	std::unique_ptr<FileWatcher> FileWatcher::CreatePolling(const std::chrono::milliseconds interval)
+	{
+		return std::make_unique<PollingFileWatcher>(interval);
+	}
+
+} // namespace SceneryEditorX
+
+/// -------------------------------------------------------
@@ -0,0 +1,81 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* file_watcher.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	enum class FileChangeType : uint8_t
+	{
+		Added,
+		Modified,
+		Removed,
+		Overflow	///< The OS dropped events; Path is the watched root, whose contents must be rescanned
+	};
+
+	struct FileChangeEvent
+	{
+		std::filesystem::path Path;		///< Absolute, lexically normal path of the file
+		FileChangeType Type = FileChangeType::Modified;
+		std::chrono::steady_clock::time_point Time;	///< When the watcher picked the event up
+	};
+
+	/**
+	 * @brief Reports changes to files below a set of watched directories.
+	 *
+	 * Events are pulled with Poll() rather than pushed, so the owner decides which thread
+	 * handles them. A single save usually shows up as several raw events (create, writes,
+	 * close, or a rename over the old file); the watcher reports them as they come and
+	 * leaves debouncing to the caller, see AssetReloadMonitor.
+	 *
+	 * Not thread safe; use one watcher from one thread.
+	 */
+	class FileWatcher
+	{
+	public:
+		virtual ~FileWatcher() = default;
+
+		/**
+		 * @brief Starts watching a directory, including its current and future subdirectories.
+		 * @return false if the directory does not exist or cannot be watched.
+		 */
+		virtual bool AddDirectory(const std::filesystem::path &directory) = 0;
+
+		/// Stops watching a directory added with AddDirectory().
+		virtual void RemoveDirectory(const std::filesystem::path &directory) = 0;
+
+		/**
+		 * @brief Appends the changes seen since the last call.
+		 * @param timeout How long to wait if nothing has happened yet; zero returns at once.
+		 * @return Number of events appended.
+		 */
+		virtual size_t Poll(std::vector<FileChangeEvent> &events, std::chrono::milliseconds timeout = {}) = 0;
+
+		[[nodiscard]] virtual const char *GetBackendName() const = 0;
+
+		/// Creates the native watcher for the platform, or a polling watcher where there is none.
+		static std::unique_ptr<FileWatcher> Create();
+
+		/// Creates a watcher that compares file timestamps every @p interval; works on any file system.
+		static std::unique_ptr<FileWatcher> CreatePolling(std::chrono::milliseconds interval = std::chrono::milliseconds(500));
+	};
+
+} // namespace SceneryEditorX
+
+/// -------------------------------------------------------
@@ -12,6 +12,8 @@
 */
 #include <filesystem>
 #include <libconfig.h++>
+#include <type_traits>
+#include <variant>
 #include "settings.h"
 #include "steam_parser.h"
 #include "SceneryEditorX/core/application/application_data.h"
@@ -99,6 +101,7 @@ namespace SceneryEditorX
 
     bool ApplicationSettings::ReadSettings()
     {
+        ConfigWriteLock lock(*this);
         try
         {
             if (!std::filesystem::exists(filePath))
@@ -157,6 +160,9 @@ namespace SceneryEditorX
             LoadSettingsToMap();
             configInitialized = true;
 
+            /// Bring registered settings in line with the file
+            ReloadStore();
+
             return true;
         }
         catch (const FileIOException &fioex)
@@ -178,6 +184,7 @@ namespace SceneryEditorX
 
     void ApplicationSettings::WriteSettings()
     {
+        ConfigWriteLock lock(*this);
         try
         {
             /// Ensure all required sections exist before writing.
@@ -205,7 +212,9 @@ namespace SceneryEditorX
 
     void ApplicationSettings::SetOption(const std::string &key, const std::string &value)
     {
+        ConfigWriteLock lock(*this);
         settings[key] = value;
+        MirrorToStore(key, value);
 
         /// Try to update the config directly
         try
@@ -249,17 +258,20 @@ namespace SceneryEditorX
 
     void ApplicationSettings::GetOption(const std::string &key, std::string &value)
     {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);
         if (const auto it = settings.find(key); it != settings.end())
             value = it->second;
     }
 
     bool ApplicationSettings::HasOption(const std::string &key) const
     {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);
         return settings.contains(key);
     }
 
     void ApplicationSettings::RemoveOption(const std::string &key)
     {
+        ConfigWriteLock lock(*this);
         settings.erase(key);
 
         /// Try to remove from the config directly.
@@ -293,6 +305,7 @@ namespace SceneryEditorX
 
     void ApplicationSettings::AddIntOption(const std::string &path, const int value)
     {
+        ConfigWriteLock lock(*this);
         try
         {
             if (const size_t pos = path.find_last_of('.'); pos != std::string::npos)
@@ -321,6 +334,7 @@ namespace SceneryEditorX
 
             /// Update settings map
             settings[path] = std::to_string(value);
+            MirrorToStore(path, value);
         }
         catch (const SettingException &e)
         {
@@ -331,6 +345,7 @@ namespace SceneryEditorX
 
     void ApplicationSettings::AddFloatOption(const std::string &path, const double value)
     {
+        ConfigWriteLock lock(*this);
         try
         {
             if (const size_t pos = path.find_last_of('.'); pos != std::string::npos)
@@ -359,6 +374,7 @@ namespace SceneryEditorX
 
             /// Update settings map
             settings[path] = std::to_string(value);
+            MirrorToStore(path, value);
         }
         catch (const SettingException &e)
         {
@@ -369,6 +385,7 @@ namespace SceneryEditorX
 
     void ApplicationSettings::AddBoolOption(const std::string &path, const bool value)
     {
+        ConfigWriteLock lock(*this);
         try
         {
             if (const size_t pos = path.find_last_of('.'); pos != std::string::npos)
@@ -397,6 +414,7 @@ namespace SceneryEditorX
 
             /// Update settings map
             settings[path] = value ? "true" : "false";
+            MirrorToStore(path, value);
         }
         catch (const SettingException &e)
         {
@@ -407,6 +425,7 @@ namespace SceneryEditorX
 
     void ApplicationSettings::AddStringOption(const std::string &path, const std::string &value)
     {
+        ConfigWriteLock lock(*this);
         try
         {
             if (const size_t pos = path.find_last_of('.'); pos != std::string::npos)
@@ -435,6 +454,7 @@ namespace SceneryEditorX
 
             /// Update settings map
             settings[path] = value;
+            MirrorToStore(path, value);
         }
         catch (const SettingException &e)
         {
@@ -445,6 +465,7 @@ namespace SceneryEditorX
 
     bool ApplicationSettings::GetBoolOption(const std::string &path, const bool defaultValue) const
     {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);
         try
         {
             if (bool value; cfg.lookupValue(path, value))
@@ -459,6 +480,7 @@ namespace SceneryEditorX
 
     int ApplicationSettings::GetIntOption(const std::string &path, const int defaultValue) const
     {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);
         try
         {
             if (int value; cfg.lookupValue(path, value))
@@ -473,6 +495,7 @@ namespace SceneryEditorX
 
     double ApplicationSettings::GetFloatOption(const std::string &path, const double defaultValue) const
     {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);
         try
         {
             if (double value; cfg.lookupValue(path, value))
@@ -487,6 +510,7 @@ namespace SceneryEditorX
 
     std::string ApplicationSettings::GetStringOption(const std::string &path, const std::string &defaultValue) const
     {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);
         try
         {
             if (std::string value; cfg.lookupValue(path, value))
@@ -501,6 +525,7 @@ namespace SceneryEditorX
 
     bool ApplicationSettings::DetectXPlanePath()
     {
+        ConfigWriteLock lock(*this);
         /// First try to find X-Plane through Steam
         SEDX_CORE_TRACE_TAG("SETTINGS", "Attempting to detect X-Plane 12 via Steam...");
         if (const auto steamPath = SteamGameFinder::FindXPlane12())
@@ -580,6 +605,7 @@ namespace SceneryEditorX
 
     bool ApplicationSettings::SetXPlanePath(const std::string &path)
     {
+        ConfigWriteLock lock(*this);
         if (path.empty())
         {
             SEDX_CORE_ERROR_TAG("SETTINGS", "Cannot set X-Plane path: Empty path provided");
@@ -643,11 +669,13 @@ namespace SceneryEditorX
 
     std::string ApplicationSettings::GetXPlanePath() const
     {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);
         return xPlaneStats.xPlanePath;
     }
 
     bool ApplicationSettings::ValidateXPlanePaths() const
     {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);
         if (xPlaneStats.xPlanePath.empty())
             return false;
         
@@ -656,6 +684,7 @@ namespace SceneryEditorX
 
     void ApplicationSettings::UpdateDerivedXPlanePaths()
     {
+        ConfigWriteLock lock(*this);
         if (xPlaneStats.xPlanePath.empty())
         {
             SEDX_CORE_WARN_TAG("SETTINGS", "Cannot update derived paths: X-Plane path is empty");
@@ -913,6 +942,87 @@ namespace SceneryEditorX
         traverseSettings(cfg.getRoot(), "");
     }
 
+    SettingValue ApplicationSettings::LookupConfigValue(const std::string &path, SettingValue fallback) const
+    {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);
+        try
+        {
+            std::visit([&](auto &value)
+            {
+                std::decay_t<decltype(value)> found{};
+                if (cfg.lookupValue(path, found))
+                    value = std::move(found);
+            }, fallback);
+        }
+        catch (...)
+        {
+            /// Fallthrough to default
+        }
+        return fallback;
+    }
+
+    void ApplicationSettings::PersistSettings(const std::vector<SettingWrite> &writes)
+    {
+        ConfigWriteLock lock(*this);
+
+        /// The values came from the store, so don't mirror them back into it
+        applyingStore = true;
+        for (const SettingWrite &write : writes)
+        {
+            std::visit([&](const auto &value)
+            {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, bool>)
+                    AddBoolOption(write.Path, value);
+                else if constexpr (std::is_same_v<T, int>)
+                    AddIntOption(write.Path, value);
+                else if constexpr (std::is_same_v<T, double>)
+                    AddFloatOption(write.Path, value);
+                else
+                    AddStringOption(write.Path, value);
+            }, write.Value);
+        }
+        WriteSettings();
+        applyingStore = false;
+    }
+
+    void ApplicationSettings::MirrorToStore(const std::string &path, SettingValue value)
+    {
+        if (applyingStore)
+            return;
+
+        if (const uint32_t slot = settingsStore.FindSlot(path); slot != InvalidSettingSlot)
+            mirroredValues.emplace_back(slot, std::move(value));
+    }
+
+    void ApplicationSettings::ReloadStore()
+    {
+        const std::vector<std::string> paths = settingsStore.GetPaths();
+        if (paths.empty())
+            return;
+
+        const auto snapshot = settingsStore.GetSnapshot();
+        for (uint32_t slot = 0; slot < paths.size() && slot < snapshot->GetSlotCount(); ++slot)
+            mirroredValues.emplace_back(slot, LookupConfigValue(paths[slot], snapshot->GetValue(slot)));
+    }
+
+    ApplicationSettings::ConfigWriteLock::ConfigWriteLock(ApplicationSettings &settings) : owner(settings)
+    {
+        owner.configMutex.lock();
+        ++owner.configWriteDepth;
+    }
+
+    ApplicationSettings::ConfigWriteLock::~ConfigWriteLock()
+    {
+        std::vector<std::pair<uint32_t, SettingValue>> values;
+        if (--owner.configWriteDepth == 0)
+            values.swap(owner.mirroredValues);
+        owner.configMutex.unlock();
+
+        if (!values.empty())
+            owner.settingsStore.Publish(std::move(values), false);
+    }
+
     template <typename T>
     void ApplicationSettings::CreateSettingPath(const std::string &path, const T &value)
     {
@@ -13,8 +13,10 @@
 #pragma once
 #include <filesystem>
 #include <map>
+#include <mutex>
 #include <string>
 #include <../dependency/libconfig/lib/libconfig.h++>
+#include "settings_store.h"
 #include "SceneryEditorX/core/application/application_data.h"
 #include "SceneryEditorX/utils/pointers.h"
 
@@ -29,6 +31,10 @@ namespace SceneryEditorX
 	 * Provides functionality for reading and writing application settings, handling X-Plane
 	 * path detection and validation, and storing key-value configuration options in various formats.
 	 * Settings are stored in a configuration file using libconfig format.
+	 *
+	 * Code that reads settings every frame should register them with RegisterSetting() and
+	 * read through the returned key; see SettingsStore. The path-based accessors below stay
+	 * for one-off access and keep registered settings in sync.
 	 */
 	class ApplicationSettings : public RefCounted
 	{
@@ -139,6 +145,49 @@ namespace SceneryEditorX
 	     */
         [[nodiscard]] std::string GetStringOption(const std::string &path, const std::string &defaultValue = "") const;
 	
+	    /// ----------------------------------------------------
+
+	    /**
+	     * @brief Registers a typed setting backed by the configuration file.
+	     * @param path The hierarchical path for the option
+	     * @param defaultValue Value to use if the file does not have the option
+	     * @return Key for GetSetting()/SetSetting(); invalid if the path is registered with another type
+	     */
+	    template<SettingType T>
+	    SettingKey<T> RegisterSetting(const std::string &path, const T &defaultValue)
+	    {
+	        std::lock_guard<std::recursive_mutex> lock(configMutex);
+	        return settingsStore.Register<T>(path, std::get<T>(LookupConfigValue(path, SettingValue(defaultValue))));
+	    }
+
+	    /**
+	     * @brief Reads a registered setting without locking or a path lookup.
+	     */
+	    template<SettingType T>
+	    [[nodiscard]] T GetSetting(SettingKey<T> key) const { return settingsStore.Get(key); }
+
+	    /**
+	     * @brief Stages a new value for a registered setting; visible after CommitSettings().
+	     */
+	    template<SettingType T>
+	    void SetSetting(SettingKey<T> key, T value) { settingsStore.Set(key, std::move(value)); }
+
+	    /**
+	     * @brief Publishes staged settings, notifies subscribers and saves them in the background.
+	     * @return Number of settings that changed
+	     */
+	    uint32_t CommitSettings() { return settingsStore.Commit(); }
+
+	    /**
+	     * @brief Waits until committed settings have been written to the configuration file.
+	     */
+	    void FlushSettings() { settingsStore.Flush(); }
+
+	    /**
+	     * @brief Gets the store behind the registered settings, for snapshots and change subscriptions.
+	     */
+	    SettingsStore &GetSettingsStore() { return settingsStore; }
+
 	    /**
 	     * @brief Automatically detects X-Plane installation path.
 	     * @return true if X-Plane path was successfully detected, false otherwise
@@ -248,6 +297,47 @@ namespace SceneryEditorX
 	     */
 	    template <typename T>
 	    void CreateSettingPath(const std::string &path, const T &value);
+
+	    /**
+	     * @brief Looks up an option in the config with the type of the fallback value.
+	     * @return The option's value, or the fallback if missing
+	     */
+	    [[nodiscard]] SettingValue LookupConfigValue(const std::string &path, SettingValue fallback) const;
+
+	    /**
+	     * @brief Writes committed settings to the config and the file; runs on the store's persist thread.
+	     */
+	    void PersistSettings(const std::vector<SettingWrite> &writes);
+
+	    /**
+	     * @brief Queues a value set through the path-based API for the store if the path is registered.
+	     */
+	    void MirrorToStore(const std::string &path, SettingValue value);
+
+	    /**
+	     * @brief Queues every registered setting for reloading from the config after reading the file.
+	     */
+	    void ReloadStore();
+
+	    /**
+	     * @brief Holds configMutex for code that changes the config, and publishes the values it
+	     * mirrored once the outermost lock is released.
+	     *
+	     * Store listeners run while publishing. Running them under configMutex would deadlock a
+	     * listener that calls FlushSettings(), as the persist thread needs configMutex to finish.
+	     */
+	    class ConfigWriteLock
+	    {
+	    public:
+	        explicit ConfigWriteLock(ApplicationSettings &settings);
+	        ~ConfigWriteLock();
+
+	        ConfigWriteLock(const ConfigWriteLock &) = delete;
+	        ConfigWriteLock &operator=(const ConfigWriteLock &) = delete;
+
+	    private:
+	        ApplicationSettings &owner;
+	    };
 	    
 	    libconfig::Config cfg;							///< Configuration object
 	    XPlaneStats xPlaneStats;						///< X-Plane statistics and paths
@@ -255,6 +345,13 @@ namespace SceneryEditorX
 	    std::filesystem::path filePath;					///< Path to configuration file
         std::map<std::string, std::string> settings;    ///< Key-value settings map
         bool configInitialized = false;                 ///< Flag indicating if config is initialized
+        mutable std::recursive_mutex configMutex;       ///< Guards cfg and the settings map against the persist thread
+        bool applyingStore = false;                     ///< Set while PersistSettings() applies values, to skip mirroring them back
+        uint32_t configWriteDepth = 0;                  ///< Nesting of ConfigWriteLock on the thread holding configMutex
+        std::vector<std::pair<uint32_t, SettingValue>> mirroredValues; ///< Published when the outermost ConfigWriteLock is released
+
+        /// Typed settings; last so it is flushed and stopped before the config goes away
+        SettingsStore settingsStore{ [this](const std::vector<SettingWrite> &writes) { PersistSettings(writes); } };
 	};
 
     /// ----------------------------------------------------------
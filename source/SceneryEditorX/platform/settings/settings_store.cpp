@@ -0,0 +1,233 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* settings_store.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "settings_store.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+    SettingsStore::SettingsStore(PersistFn persist, const std::chrono::milliseconds persistDelay) :
+        m_Current(std::make_shared<const SettingsSnapshot>()),
+        m_Persist(std::move(persist)), m_PersistDelay(persistDelay)
+    {
+    }
+
+    SettingsStore::~SettingsStore()
+    {
+        if (m_PersistThread.joinable())
+        {
+            Flush();
+            {
+                std::lock_guard<std::mutex> lock(m_PersistMutex);
+                m_Stopping = true;
+            }
+            m_PersistWake.notify_all();
+            m_PersistThread.join();
+        }
+    }
+
+    uint32_t SettingsStore::RegisterSlot(const std::string &path, SettingValue initialValue)
+    {
+        std::lock_guard<std::mutex> commitLock(m_CommitMutex);
+
+        {
+            std::lock_guard<std::mutex> pathLock(m_PathMutex);
+            if (const auto it = m_Slots.find(path); it != m_Slots.end())
+                return GetSnapshot()->GetValue(it->second).index() == initialValue.index() ? it->second : InvalidSettingSlot;
+        }
+
+        auto snapshot = std::make_shared<SettingsSnapshot>(*GetSnapshot());
+        const uint32_t slot = snapshot->GetSlotCount();
+        snapshot->m_Values.push_back(std::move(initialValue));
+        snapshot->m_Version = ++m_Version;
+
+        {
+            std::lock_guard<std::mutex> pathLock(m_PathMutex);
+            m_Paths.push_back(path);
+            m_Slots.emplace(path, slot);
+        }
+
+        m_Current.store(std::move(snapshot), std::memory_order_release);
+        return slot;
+    }
+
+    uint32_t SettingsStore::FindSlot(const std::string &path) const
+    {
+        std::lock_guard<std::mutex> lock(m_PathMutex);
+        const auto it = m_Slots.find(path);
+        return it != m_Slots.end() ? it->second : InvalidSettingSlot;
+    }
+
+    std::vector<std::string> SettingsStore::GetPaths() const
+    {
+        std::lock_guard<std::mutex> lock(m_PathMutex);
+        return m_Paths;
+    }
+
+    std::shared_ptr<const SettingsSnapshot> SettingsStore::GetSnapshot() const
+    {
+        return m_Current.load(std::memory_order_acquire);
+    }
+
+    void SettingsStore::Stage(const uint32_t slot, SettingValue value)
+    {
+        std::lock_guard<std::mutex> lock(m_PendingMutex);
+        m_Pending.emplace_back(slot, std::move(value));
+    }
+
+    uint32_t SettingsStore::Commit()
+    {
+        std::vector<std::pair<uint32_t, SettingValue>> pending;
+        {
+            std::lock_guard<std::mutex> lock(m_PendingMutex);
+            pending.swap(m_Pending);
+        }
+        return Apply(std::move(pending), true);
+    }
+
+    uint32_t SettingsStore::Publish(std::vector<std::pair<uint32_t, SettingValue>> values, const bool persist)
+    {
+        return Apply(std::move(values), persist);
+    }
+
+    uint32_t SettingsStore::Apply(std::vector<std::pair<uint32_t, SettingValue>> values, const bool persist)
+    {
+        if (values.empty())
+            return 0;
+
+        std::unique_lock<std::mutex> commitLock(m_CommitMutex);
+
+        std::shared_ptr<SettingsSnapshot> snapshot;
+        std::vector<uint32_t> changed;
+        {
+            std::shared_ptr<const SettingsSnapshot> current = GetSnapshot();
+            for (auto &[slot, value] : values)
+            {
+                // Skip unknown slots and values of the wrong type rather than publish a broken snapshot
+                if (slot >= current->GetSlotCount() || current->GetValue(slot).index() != value.index())
+                    continue;
+
+                const SettingValue &existing = snapshot ? snapshot->m_Values[slot] : current->m_Values[slot];
+                if (existing == value)
+                    continue;
+
+                if (!snapshot)
+                    snapshot = std::make_shared<SettingsSnapshot>(*current);
+                snapshot->m_Values[slot] = std::move(value);
+                changed.push_back(slot);
+            }
+        }
+
+        if (!snapshot)
+            return 0;
+
+        // A slot changed back within the batch still counts as changed; listeners then see no difference
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+        snapshot->m_Version = ++m_Version;
+        m_Current.store(snapshot, std::memory_order_release);
+
+        if (persist && m_Persist)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_PersistMutex);
+                for (const uint32_t slot : changed)
+                    m_Dirty[slot] = snapshot->m_Values[slot];
+                ++m_DirtySequence;
+                if (!m_PersistThread.joinable())
+                    m_PersistThread = std::thread([this]() { PersistLoop(); });
+            }
+            m_PersistWake.notify_one();
+        }
+
+        // No lock is held while listeners run, so they are free to read, commit or use other locks
+        commitLock.unlock();
+
+        std::vector<ListenerFn> listeners;
+        {
+            std::lock_guard<std::mutex> lock(m_ListenerMutex);
+            listeners.reserve(m_Listeners.size());
+            for (const auto &[id, listener] : m_Listeners)
+                listeners.push_back(listener);
+        }
+
+        const SettingsChange change{ *snapshot, changed };
+        for (const ListenerFn &listener : listeners)
+            listener(change);
+
+        return static_cast<uint32_t>(changed.size());
+    }
+
+    uint64_t SettingsStore::Subscribe(ListenerFn listener)
+    {
+        std::lock_guard<std::mutex> lock(m_ListenerMutex);
+        m_Listeners.emplace_back(++m_LastListenerId, std::move(listener));
+        return m_LastListenerId;
+    }
+
+    void SettingsStore::Unsubscribe(const uint64_t id)
+    {
+        std::lock_guard<std::mutex> lock(m_ListenerMutex);
+        std::erase_if(m_Listeners, [id](const auto &entry) { return entry.first == id; });
+    }
+
+    void SettingsStore::Flush()
+    {
+        std::unique_lock<std::mutex> lock(m_PersistMutex);
+        if (!m_PersistThread.joinable())
+            return;
+
+        const uint64_t target = m_DirtySequence;
+        ++m_FlushWaiters;
+        m_PersistWake.notify_all();
+        m_PersistDone.wait(lock, [this, target]() { return m_PersistedSequence >= target; });
+        --m_FlushWaiters;
+    }
+
+    void SettingsStore::PersistLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_PersistMutex);
+        while (true)
+        {
+            m_PersistWake.wait(lock, [this]() { return m_Stopping || !m_Dirty.empty(); });
+            if (m_Dirty.empty())
+                return;
+
+            // Gather the commits that follow shortly after, unless someone is waiting on us
+            m_PersistWake.wait_for(lock, m_PersistDelay, [this]() { return m_Stopping || m_FlushWaiters > 0; });
+
+            std::unordered_map<uint32_t, SettingValue> dirty;
+            dirty.swap(m_Dirty);
+            const uint64_t sequence = m_DirtySequence;
+            lock.unlock();
+
+            std::vector<SettingWrite> writes;
+            writes.reserve(dirty.size());
+            {
+                std::lock_guard<std::mutex> pathLock(m_PathMutex);
+                for (auto &[slot, value] : dirty)
+                    writes.push_back({ m_Paths[slot], std::move(value) });
+            }
+            std::sort(writes.begin(), writes.end(), [](const SettingWrite &a, const SettingWrite &b) { return a.Path < b.Path; });
+            m_Persist(writes);
+
+            lock.lock();
+            m_PersistedSequence = sequence;
+            m_PersistDone.notify_all();
+        }
+    }
+
+} // namespace SceneryEditorX
+
+/// -------------------------------------------------------
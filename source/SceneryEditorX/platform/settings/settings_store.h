@@ -0,0 +1,239 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* settings_store.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	using SettingValue = std::variant<bool, int, double, std::string>;
+
+	template<typename T>
+	concept SettingType = std::same_as<T, bool> || std::same_as<T, int> || std::same_as<T, double> || std::same_as<T, std::string>;
+
+	inline constexpr uint32_t InvalidSettingSlot = 0xFFFFFFFFu;
+
+	/**
+	 * @brief Typed handle to a registered setting.
+	 *
+	 * Resolving the dotted path happens once at registration; reads through the key are
+	 * an index into the current snapshot.
+	 */
+	template<SettingType T>
+	struct SettingKey
+	{
+		uint32_t Slot = InvalidSettingSlot;
+
+		[[nodiscard]] bool IsValid() const { return Slot != InvalidSettingSlot; }
+		bool operator==(const SettingKey &) const = default;
+	};
+
+	/// -------------------------------------------------------
+
+	/**
+	 * @brief Immutable set of setting values, one per registered slot.
+	 *
+	 * Keys registered after a snapshot was published are not part of it.
+	 */
+	class SettingsSnapshot
+	{
+	public:
+		/// Invalid keys, and keys newer than the snapshot, read as the default value of T.
+		template<SettingType T>
+		[[nodiscard]] const T &Get(SettingKey<T> key) const
+		{
+			static const T fallback{};
+			if (!key.IsValid() || key.Slot >= m_Values.size())
+				return fallback;
+			return std::get<T>(m_Values[key.Slot]);
+		}
+
+		[[nodiscard]] const SettingValue &GetValue(const uint32_t slot) const { return m_Values[slot]; }
+		[[nodiscard]] uint32_t GetSlotCount() const { return static_cast<uint32_t>(m_Values.size()); }
+		[[nodiscard]] uint64_t GetVersion() const { return m_Version; }
+
+	private:
+		friend class SettingsStore;
+
+		std::vector<SettingValue> m_Values;
+		uint64_t m_Version = 0;
+	};
+
+	/**
+	 * @brief The slots that changed in one commit, sorted, and the snapshot that holds them.
+	 */
+	struct SettingsChange
+	{
+		const SettingsSnapshot &Snapshot;
+		std::span<const uint32_t> Slots;
+
+		template<SettingType T>
+		[[nodiscard]] bool Contains(SettingKey<T> key) const { return std::binary_search(Slots.begin(), Slots.end(), key.Slot); }
+	};
+
+	/// A setting handed to the persist function.
+	struct SettingWrite
+	{
+		std::string Path;
+		SettingValue Value;
+	};
+
+	/// -------------------------------------------------------
+
+	/**
+	 * @class SettingsStore
+	 * @brief Compiled, typed settings with lock-free snapshot reads.
+	 *
+	 * Settings are registered once by dotted path and read through the returned key.
+	 * Values live in an immutable SettingsSnapshot that is replaced as a whole on each
+	 * commit, so a reader always sees one consistent set. The current snapshot is published
+	 * through an atomic shared pointer, so a read on any thread is an atomic load and an
+	 * index, whichever store it reads.
+	 *
+	 * Writes are staged with Set() from any thread and become visible together on Commit().
+	 * Commit() then notifies listeners with the changed slots and hands the changes to the
+	 * persist function, which runs on a background thread after the persist delay so that
+	 * bursts of commits are written once.
+	 */
+	class SettingsStore
+	{
+	public:
+		using PersistFn = std::function<void(const std::vector<SettingWrite> &)>;
+		using ListenerFn = std::function<void(const SettingsChange &)>;
+
+		/**
+		 * @param persist Writes committed changes out; called on the persist thread. May be empty.
+		 * @param persistDelay How long to gather further commits before calling persist.
+		 */
+		explicit SettingsStore(PersistFn persist = {}, std::chrono::milliseconds persistDelay = std::chrono::milliseconds(250));
+		~SettingsStore();
+
+		SettingsStore(const SettingsStore &) = delete;
+		SettingsStore &operator=(const SettingsStore &) = delete;
+
+		/**
+		 * @brief Registers a setting, or returns the existing key for the path.
+		 * @param path Dotted path, e.g. "ui.font_size"
+		 * @param initialValue Value of the setting if the path is new
+		 * @return Invalid key if the path is already registered with another type.
+		 */
+		template<SettingType T>
+		SettingKey<T> Register(const std::string &path, T initialValue)
+		{
+			return { RegisterSlot(path, SettingValue(std::move(initialValue))) };
+		}
+
+		/// Finds the slot for a registered path.
+		[[nodiscard]] uint32_t FindSlot(const std::string &path) const;
+
+		/// Reads a setting from the current snapshot.
+		template<SettingType T>
+		[[nodiscard]] T Get(SettingKey<T> key) const { return m_Current.load(std::memory_order_acquire)->Get(key); }
+
+		/// Holds on to the current snapshot, for reading several settings as one consistent set.
+		[[nodiscard]] std::shared_ptr<const SettingsSnapshot> GetSnapshot() const;
+
+		/// Stages a value for the next Commit(). Safe from any thread; the last value staged per slot wins.
+		template<SettingType T>
+		void Set(SettingKey<T> key, T value)
+		{
+			if (key.IsValid())
+				Stage(key.Slot, SettingValue(std::move(value)));
+		}
+
+		/**
+		 * @brief Publishes the staged values as a new snapshot, notifies listeners and queues persistence.
+		 * @return Number of settings whose value changed.
+		 */
+		uint32_t Commit();
+
+		/**
+		 * @brief Publishes values directly, bypassing the staged batch.
+		 *
+		 * Used when the values come from the backing store itself, e.g. a reload from disk,
+		 * in which case persist should be false.
+		 */
+		uint32_t Publish(std::vector<std::pair<uint32_t, SettingValue>> values, bool persist);
+
+		/**
+		 * @brief Registers a function called after each commit that changed something.
+		 *
+		 * Listeners run on the committing thread with no store lock held, so they may read,
+		 * Set() and Commit(). Commits made on different threads can notify concurrently.
+		 */
+		uint64_t Subscribe(ListenerFn listener);
+		void Unsubscribe(uint64_t id);
+
+		/// Blocks until every commit so far has been persisted.
+		void Flush();
+
+		/// Paths of all registered settings, indexed by slot.
+		[[nodiscard]] std::vector<std::string> GetPaths() const;
+
+	private:
+		uint32_t RegisterSlot(const std::string &path, SettingValue initialValue);
+		void Stage(uint32_t slot, SettingValue value);
+		uint32_t Apply(std::vector<std::pair<uint32_t, SettingValue>> values, bool persist);
+		void PersistLoop();
+
+		// Published state; replaced under m_CommitMutex
+		std::atomic<std::shared_ptr<const SettingsSnapshot>> m_Current;
+		uint64_t m_Version = 0;
+
+		// Schema and commits; registration and commits are serialized
+		std::mutex m_CommitMutex;
+		std::vector<std::string> m_Paths;
+		std::unordered_map<std::string, uint32_t> m_Slots;
+		mutable std::mutex m_PathMutex;						///< Guards m_Paths and m_Slots for readers
+
+		// Staged writes
+		std::vector<std::pair<uint32_t, SettingValue>> m_Pending;
+		std::mutex m_PendingMutex;
+
+		std::vector<std::pair<uint64_t, ListenerFn>> m_Listeners;
+		std::mutex m_ListenerMutex;
+		uint64_t m_LastListenerId = 0;
+
+		// Persistence
+		PersistFn m_Persist;
+		std::chrono::milliseconds m_PersistDelay;
+		std::unordered_map<uint32_t, SettingValue> m_Dirty;
+		uint64_t m_DirtySequence = 0;						///< Bumped whenever m_Dirty gains values
+		uint64_t m_PersistedSequence = 0;
+		uint32_t m_FlushWaiters = 0;
+		bool m_Stopping = false;
+		std::mutex m_PersistMutex;
+		std::condition_variable m_PersistWake;
+		std::condition_variable m_PersistDone;
+		std::thread m_PersistThread;
+	};
+
+} // namespace SceneryEditorX
+
+/// -------------------------------------------------------
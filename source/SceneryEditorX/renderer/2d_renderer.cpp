@@ -11,11 +11,11 @@
 * -------------------------------------------------------
 */
 #include "2d_renderer.h"
-#include <codecvt>
 #include "renderer.h"
 #include "SceneryEditorX/scene/material.h"
 #include "fonts/msdf_impl.h"
 #include "vulkan/vk_cmd_buffers.h"
+#include "SceneryEditorX/core/threading/thread_pool.h"
 
 /// -------------------------------------------------------
 namespace SceneryEditorX
@@ -23,7 +23,9 @@ namespace SceneryEditorX
 
 	Renderer2D::Renderer2D(const Renderer2DSpecification& specification) :
         c_MaxVertices(specification.MaxQuads * 4), c_MaxIndices(specification.MaxQuads * 6), c_MaxLineVertices(specification.MaxLines * 2),
-        c_MaxLineIndices(specification.MaxLines * 2), m_Specification(specification)
+        c_MaxLineIndices(specification.MaxLines * 2), m_Specification(specification),
+		m_GlyphAtlas(GlyphAtlasSpecification{ specification.GlyphAtlasSize, specification.GlyphAtlasSize }),
+		m_TextLayoutCache(specification.TextLayoutCacheSize)
 	{
 		Init();
 	}
@@ -44,6 +46,9 @@ namespace SceneryEditorX
 
 		m_MemoryStats.TotalAllocated = 0;
 
+		if (m_Specification.GlyphWorkerCount > 0)
+			m_GlyphPool = std::make_unique<ThreadPool>(m_Specification.GlyphWorkerCount);
+
 		uint32_t framesInFlight = Renderer::GetRenderData().framesInFlight;
 
 		FramebufferSpecification framebufferSpec;
@@ -356,6 +361,8 @@ namespace SceneryEditorX
 
 		for (auto &m_FontTextureSlot : m_FontTextureSlots)
             m_FontTextureSlot = nullptr;
+
+		m_GlyphAtlas.BeginFrame();
 	}
 
 	void Renderer2D::EndScene()
@@ -394,6 +401,9 @@ namespace SceneryEditorX
 			}
 		}
 
+		///< Render glyphs first used this frame before the text pass samples the atlas
+		UploadGlyphAtlas();
+
 		///< Render text
 		for (uint32_t i = 0; i <= m_TextBufferWriteIndex; i++)
 		{
@@ -1249,18 +1259,6 @@ namespace SceneryEditorX
 			DrawLine(corners[i], corners[i + 4], color, onTop);
 	}
 
-	static bool NextLine(const int index, const std::vector<int>& lines)
-	{
-		for (const int line : lines)
-		{
-			if (line == index)
-				return true;
-		}
-
-		return false;
-	}
-
-
 	void Renderer2D::DrawString(const std::string& string, const Vec3& position, float maxWidth, const Vec4& color)
 	{
 		DrawString(string, Font::GetDefaultFont(), position, maxWidth, color); ///< Use default font
@@ -1271,190 +1269,137 @@ namespace SceneryEditorX
         DrawString(string, font, Mat4::Translate(position), maxWidth, color);
 	}
 
-	/**
-	 * @warning C4996: 'std::codecvt_utf8<char32_t,1114111,(std::codecvt_mode)0>': warning STL4017: std::wbuffer_convert, std::wstring_convert, and the <codecvt> header
-	 * (containing std::codecvt_mode, std::codecvt_utf8, std::codecvt_utf16, and std::codecvt_utf8_utf16) are deprecated in C++17. (The std::codecvt class template is NOT deprecated.)
-	 * The C++ Standard doesn't provide equivalent non-deprecated functionality; consider using MultiByteToWideChar() and WideCharToMultiByte() from <Windows.h> instead.
-	 * You can define _SILENCE_CXX17_CODECVT_HEADER_DEPRECATION_WARNING or _SILENCE_ALL_CXX17_DEPRECATION_WARNINGS to acknowledge that you have received this warning.
-	 */
+	const GlyphSource* Renderer2D::GetGlyphSource(const Ref<Font>& font)
+	{
+		const uint64_t fontID = font->GetFontID();
+		GlyphSourceEntry& entry = m_GlyphSources[fontID];
+		if (entry.font.Expired())
+		{
+			///< A destroyed font's id came back before the sweep saw it; its glyphs and layouts are stale
+			if (entry.source)
+				ReleaseFont(fontID);
 
-#pragma warning(disable : 4996)
+			entry.font = font;
+			entry.source = std::make_unique<MSDFGlyphSource>(fontID, *font->GetMSDFData());
+		}
+		return entry.source.get();
+	}
 
-	///< From https://stackoverflow.com/questions/31302506/stdu32string-conversion-to-from-stdstring-and-stdu16string
-	static std::u32string To_UTF32(const std::string& s)
+	void Renderer2D::ReleaseFont(const uint64_t fontID)
 	{
-		std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> conv;
-		return conv.from_bytes(s);
+		m_GlyphAtlas.RemoveFont(fontID);
+		m_TextLayoutCache.RemoveFont(fontID);
 	}
 
-#pragma warning(default : 4996)
-
-	void Renderer2D::DrawString(const std::string& string, const Ref<Font>& font, const Mat4& transform, float maxWidth, const Vec4& color, float lineHeightOffset, float kerningOffset)
+	void Renderer2D::ReleaseDestroyedFonts()
 	{
-		if (string.empty())
-			return;
-
-		float textureIndex = -1.0f;
-
-		///< TODO: this isn't really ideal, but we need to iterate through UTF-8 code points
-		std::u32string utf32string = To_UTF32(string);
-
-		Ref<Texture2D> fontAtlas = font->GetFontAtlas();
-		SEDX_CORE_ASSERT(fontAtlas);
-
-		for (uint32_t i = 0; i < m_FontTextureSlotIndex; i++)
+		///< Pending rasterisation reads the font's MSDF data, so this has to run before RasterizePending
+		for (auto it = m_GlyphSources.begin(); it != m_GlyphSources.end();)
 		{
-			if (m_FontTextureSlots[i]->GetHash() == fontAtlas->GetHash())
+			if (it->second.font.Expired())
 			{
-				textureIndex = (float)i;
-				break;
+				ReleaseFont(it->first);
+				it = m_GlyphSources.erase(it);
 			}
+			else
+				++it;
 		}
+	}
+
+	void Renderer2D::UploadGlyphAtlas()
+	{
+		ReleaseDestroyedFonts();
 
-		if (textureIndex == -1.0f)
+		m_GlyphAtlas.RasterizePending(m_GlyphPool ? m_GlyphPool.get() : &ThreadPool::Get());
+		if (!m_GlyphAtlas.IsDirty())
+			return;
+
+		const Buffer pixels(m_GlyphAtlas.GetPixels(), static_cast<uint64_t>(m_GlyphAtlas.GetRowPitch()) * m_GlyphAtlas.GetHeight());
+		if (!m_GlyphAtlasTexture)
+		{
+			TextureSpecification spec;
+			spec.format = VkFormat::VK_FORMAT_R8G8B8A8_UNORM;
+			spec.width = m_GlyphAtlas.GetWidth();
+			spec.height = m_GlyphAtlas.GetHeight();
+			spec.generateMips = false;
+			spec.samplerWrap = SamplerWrap::Clamp;
+			spec.debugName = "GlyphAtlas";
+			m_GlyphAtlasTexture = Texture2D::Create(spec, pixels);
+		}
+		else
 		{
-			textureIndex = (float)m_FontTextureSlotIndex;
-			m_FontTextureSlots[m_FontTextureSlotIndex] = fontAtlas;
-			m_FontTextureSlotIndex++;
+			///< Only the shelves touched this frame are re-uploaded; the image and its descriptors stay put
+			m_GlyphAtlasTexture->SetRows(pixels, m_GlyphAtlas.GetDirtyRowBegin(), m_GlyphAtlas.GetDirtyRowEnd());
 		}
+		m_GlyphAtlas.ClearDirty();
 
-		auto &fontGeometry = font->GetMSDFData()->FontGeometry;
-		const auto& metrics = fontGeometry.getMetrics();
+		m_FontTextureSlots[0] = m_GlyphAtlasTexture;
+	}
 
-	    /// TODO: these font metrics really should be cleaned up/refactored...(this is a first pass WIP)
-		std::vector<int> nextLines;
-		{
-			double x = 0.0;
-			double fsScale = 1 / (metrics.ascenderY - metrics.descenderY);
-			double y = -fsScale * metrics.ascenderY;
-			int lastSpace = -1;
-			for (int i = 0; i < utf32string.size(); i++)
-			{
-				char32_t character = utf32string[i];
-				if (character == '\n')
-				{
-					x = 0;
-					y -= fsScale * metrics.lineHeight + lineHeightOffset;
-					continue;
-				}
-				if (character == '\r')
-					continue;
+	void Renderer2D::DrawString(const std::string& string, const Ref<Font>& font, const Mat4& transform, float maxWidth, const Vec4& color, float lineHeightOffset, float kerningOffset)
+	{
+		if (string.empty())
+			return;
 
-				auto glyph = fontGeometry.getGlyph(character);
-				//if (!glyph)
-				//	glyph = fontGeometry.getGlyph('?');
-				if (!glyph)
-					continue;
+		SEDX_CORE_ASSERT(font && font->GetMSDFData());
+		const GlyphSource* source = GetGlyphSource(font);
 
-				if (character != ' ')
-				{
-                    ///< Calc geo
-					double pl, pb, pr, pt;
-					glyph->getQuadPlaneBounds(pl, pb, pr, pt);
-					Vec2 quadMin((float)pl, (float)pb);
-					Vec2 quadMax((float)pr, (float)pt);
-
-					quadMin *= fsScale;
-					quadMax *= fsScale;
-					quadMin += Vec2(x, y);
-					quadMax += Vec2(x, y);
-
-					if (quadMax.x > maxWidth && lastSpace != -1)
-					{
-						i = lastSpace;
-						nextLines.emplace_back(lastSpace);
-						lastSpace = -1;
-						x = 0;
-						y -= fsScale * metrics.lineHeight + lineHeightOffset;
-					}
-				}
-				else
-				{
-					lastSpace = i;
-				}
+		TextLayoutParams params;
+		params.maxWidth = maxWidth;
+		params.lineHeightOffset = lineHeightOffset;
+		params.kerningOffset = kerningOffset;
 
-				double advance = glyph->getAdvance();
-				fontGeometry.getAdvance(advance, character, utf32string[i + 1]);
-				x += fsScale * advance + kerningOffset;
-			}
-		}
+		///< Unchanged labels are a cache hit; only new strings are shaped
+		const TextLayout& layout = m_TextLayoutCache.Get(string, *source, params);
+
+		///< All fonts share the dynamic glyph atlas in slot 0
+		constexpr float textureIndex = 0.0f;
+		m_FontTextureSlots[0] = m_GlyphAtlasTexture;
+		m_FontTextureSlotIndex = 1;
 
+		const float texelWidth = 1.0f / static_cast<float>(m_GlyphAtlas.GetWidth());
+		const float texelHeight = 1.0f / static_cast<float>(m_GlyphAtlas.GetHeight());
+
+		for (const TextLayoutGlyph& glyph : layout.glyphs)
 		{
-			double x = 0.0;
-			double fsScale = 1 / (metrics.ascenderY - metrics.descenderY);
-			double y = 0.0; ///< -fsScale * metrics.ascenderY;
-			for (int i = 0; i < utf32string.size(); i++)
-			{
-				char32_t character = utf32string[i];
-				if (character == '\n' || NextLine(i, nextLines))
-				{
-					x = 0;
-					y -= fsScale * metrics.lineHeight + lineHeightOffset;
-					continue;
-				}
+			///< Touching the glyph pins its shelf for this frame; new glyphs are rendered in EndScene
+			const GlyphAtlasRect* rect = m_GlyphAtlas.Acquire(*source, glyph.codepoint);
+			if (!rect)
+				continue;
+
+			const float l = (static_cast<float>(rect->x) + 0.5f) * texelWidth;
+			const float b = (static_cast<float>(rect->y) + 0.5f) * texelHeight;
+			const float r = (static_cast<float>(rect->x + rect->width) - 0.5f) * texelWidth;
+			const float t = (static_cast<float>(rect->y + rect->height) - 0.5f) * texelHeight;
+
+			auto& bufferPtr = GetWriteableTextBuffer();
+			bufferPtr->Position = transform * Vec4(glyph.left, glyph.bottom, 0.0f, 1.0f);
+			bufferPtr->Color = color;
+			bufferPtr->TexCoord = Vec2(l, b);
+			bufferPtr->TexIndex = textureIndex;
+			bufferPtr++;
 
-				auto glyph = fontGeometry.getGlyph(character);
-				//if (!glyph)
-				//	glyph = fontGeometry.getGlyph('?');
-				if (!glyph)
-					continue;
-
-				double l, b, r, t;
-				glyph->getQuadAtlasBounds(l, b, r, t);
-
-				double pl, pb, pr, pt;
-				glyph->getQuadPlaneBounds(pl, pb, pr, pt);
-
-				pl *= fsScale, pb *= fsScale, pr *= fsScale, pt *= fsScale;
-				pl += x, pb += y, pr += x, pt += y;
-
-				double texelWidth = 1. / fontAtlas->GetWidth();
-				double texelHeight = 1. / fontAtlas->GetHeight();
-                l *= texelWidth;
-                b *= texelHeight;
-                r *= texelWidth;
-			    t *= texelHeight;
-
-				// ImGui::Begin("Font");
-				// ImGui::Text("Size: %d, %d", m_ExampleFontSheet->GetWidth(), m_ExampleFontSheet->GetHeight());
-				// UI::Image(m_ExampleFontSheet, ImVec2(m_ExampleFontSheet->GetWidth(), m_ExampleFontSheet->GetHeight()), ImVec2(0, 1), ImVec2(1, 0));
-				// ImGui::End();
-
-				auto& bufferPtr = GetWriteableTextBuffer();
-				bufferPtr->Position = transform * Vec4((float)pl, (float)pb, 0.0f, 1.0f);
-				bufferPtr->Color = color;
-                bufferPtr->TexCoord = Vec2(static_cast<float>(l), static_cast<float>(b));
-				bufferPtr->TexIndex = textureIndex;
-				bufferPtr++;
-
-				bufferPtr->Position = transform * Vec4((float)pl, (float)pt, 0.0f, 1.0f);
-				bufferPtr->Color = color;
-                bufferPtr->TexCoord = Vec2(static_cast<float>(l), static_cast<float>(t));
-				bufferPtr->TexIndex = textureIndex;
-				bufferPtr++;
-
-				bufferPtr->Position = transform * Vec4((float)pr, (float)pt, 0.0f, 1.0f);
-				bufferPtr->Color = color;
-                bufferPtr->TexCoord = Vec2(static_cast<float>(r), static_cast<float>(t));
-				bufferPtr->TexIndex = textureIndex;
-				bufferPtr++;
-
-				bufferPtr->Position = transform * Vec4((float)pr, (float)pb, 0.0f, 1.0f);
-				bufferPtr->Color = color;
-                bufferPtr->TexCoord = Vec2(static_cast<float>(r), static_cast<float>(b));
-				bufferPtr->TexIndex = textureIndex;
-				bufferPtr++;
-
-				m_TextIndexCount += 6;
-
-				double advance = glyph->getAdvance();
-				fontGeometry.getAdvance(advance, character, utf32string[i + 1]);
-				x += fsScale * advance + kerningOffset;
-
-				m_DrawStats.QuadCount++;
-			}
-		}
+			bufferPtr->Position = transform * Vec4(glyph.left, glyph.top, 0.0f, 1.0f);
+			bufferPtr->Color = color;
+			bufferPtr->TexCoord = Vec2(l, t);
+			bufferPtr->TexIndex = textureIndex;
+			bufferPtr++;
 
+			bufferPtr->Position = transform * Vec4(glyph.right, glyph.top, 0.0f, 1.0f);
+			bufferPtr->Color = color;
+			bufferPtr->TexCoord = Vec2(r, t);
+			bufferPtr->TexIndex = textureIndex;
+			bufferPtr++;
+
+			bufferPtr->Position = transform * Vec4(glyph.right, glyph.bottom, 0.0f, 1.0f);
+			bufferPtr->Color = color;
+			bufferPtr->TexCoord = Vec2(r, b);
+			bufferPtr->TexIndex = textureIndex;
+			bufferPtr++;
+
+			m_TextIndexCount += 6;
+			m_DrawStats.QuadCount++;
+		}
 	}
 
 	float Renderer2D::GetLineWidth() const
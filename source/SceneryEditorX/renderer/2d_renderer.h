@@ -17,6 +17,9 @@
 #include "buffers/index_buffer.h"
 #include "buffers/uniform_buffer.h"
 #include "fonts/font.h"
+#include "fonts/glyph_atlas.h"
+#include "fonts/msdf_glyph_source.h"
+#include "fonts/text_layout.h"
 #include "vulkan/vk_cmd_buffers.h"
 #include "vulkan/vk_render_pass.h"
 
@@ -29,6 +32,7 @@ namespace SceneryEditorX
     class CommandBuffer;
     class Material;
     class Pipeline;
+    class ThreadPool;
 
     /// -------------------------------------------------------
 
@@ -37,6 +41,9 @@ namespace SceneryEditorX
 		bool SwapChainTarget = false;
 		uint32_t MaxQuads = 5000;
 		uint32_t MaxLines = 1000;
+		uint32_t GlyphAtlasSize = 1024;		///< Width and height of the dynamic glyph atlas
+		uint32_t TextLayoutCacheSize = 4096;	///< Shaped strings kept for reuse across frames
+		uint32_t GlyphWorkerCount = 0;		///< Threads rendering new glyphs, 0 uses the shared thread pool
 	};
 
     /// -------------------------------------------------------
@@ -135,6 +142,8 @@ namespace SceneryEditorX
 		void ResetStats();
 		DrawStatistics GetDrawStats() const;
         MemoryStatistics GetMemoryStats() const;
+		const GlyphAtlasStats& GetGlyphAtlasStats() const { return m_GlyphAtlas.GetStats(); }
+		const TextLayoutCacheStats& GetTextLayoutStats() const { return m_TextLayoutCache.GetStats(); }
 		const Renderer2DSpecification& GetSpecification() const { return m_Specification; }
 
 	private:
@@ -183,6 +192,15 @@ namespace SceneryEditorX
 			Vec4 Color;
 		};
 
+        /// -------------------------------------------------------
+
+		///< Glyph source for a font, dropped along with its atlas glyphs once the font is destroyed
+		struct GlyphSourceEntry
+		{
+			WeakRef<Font> font;
+			std::unique_ptr<MSDFGlyphSource> source;
+		};
+
         /// -------------------------------------------------------
 
 		QuadVertex* &GetWriteableQuadBuffer();
@@ -190,6 +208,11 @@ namespace SceneryEditorX
 		TextVertex* &GetWriteableTextBuffer();
 		CircleVertex* &GetWriteableCircleBuffer();
 
+		const GlyphSource* GetGlyphSource(const Ref<Font>& font);
+		void ReleaseFont(uint64_t fontID);
+		void ReleaseDestroyedFonts();
+		void UploadGlyphAtlas();
+
         /// -------------------------------------------------------
 
 		static constexpr uint32_t MaxTextureSlots = 32; ///< TODO: RenderCaps
@@ -269,6 +292,12 @@ namespace SceneryEditorX
 		std::vector<TextVertex*> m_TextVertexBufferPtr;
 		uint32_t m_TextBufferWriteIndex = 0;
 
+		GlyphAtlas m_GlyphAtlas;
+		Ref<Texture2D> m_GlyphAtlasTexture;
+		TextLayoutCache m_TextLayoutCache;
+		std::unordered_map<uint64_t, GlyphSourceEntry> m_GlyphSources;
+		std::unique_ptr<ThreadPool> m_GlyphPool;
+
 		Mat4 m_CameraViewProj;
 		Mat4 m_CameraView;
 		bool m_DepthTest = true;
@@ -11,6 +11,7 @@
 * -------------------------------------------------------
 */
 #pragma once
+#include <atomic>
 #include <SceneryEditorX/renderer/texture.h>
 #include <SceneryEditorX/scene/components.h>
 
@@ -42,13 +43,18 @@ namespace SceneryEditorX
 		virtual ObjectType GetAssetType() const override { return GetStaticType(); }
 
 		const std::string& GetName() const { return m_Name; }
+
+		/// Process unique id used to key glyph atlas entries and cached text layouts.
+		uint64_t GetFontID() const { return m_FontID; }
 	private:
 		void CreateAtlas(Buffer buffer);
 		std::string m_Name;
 		Ref<Texture2D> m_TextureAtlas;
 		MSDFData* m_MSDFData = nullptr;
+		uint64_t m_FontID = s_NextFontID.fetch_add(1);
 
 		inline static Ref<Font> s_DefaultFont, s_DefaultMonoSpacedFont;
+		inline static std::atomic<uint64_t> s_NextFontID = 1;
 	};
 
 }
@@ -0,0 +1,267 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* glyph_atlas.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "glyph_atlas.h"
+#include <algorithm>
+#include <cstring>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		/// Shelf index of glyphs that have no bitmap (spaces); they are cached so the size is only queried once.
+		constexpr uint32_t NO_SHELF = ~0u;
+	}
+
+	GlyphAtlas::GlyphAtlas(const GlyphAtlasSpecification &specification) : m_Specification(specification)
+	{
+		m_Specification.width = std::clamp(m_Specification.width, 1u, 65535u);
+		m_Specification.height = std::clamp(m_Specification.height, 1u, 65535u);
+		m_Specification.shelfRounding = std::max(m_Specification.shelfRounding, 1u);
+		m_Pixels.resize(static_cast<size_t>(GetRowPitch()) * m_Specification.height);
+	}
+
+	void GlyphAtlas::BeginFrame()
+	{
+		++m_Frame;
+	}
+
+	const GlyphAtlasRect *GlyphAtlas::Acquire(const GlyphSource &source, const uint32_t codepoint)
+	{
+		const GlyphKey key { source.GetFontID(), codepoint };
+		if (const auto it = m_Glyphs.find(key); it != m_Glyphs.end())
+		{
+			++m_Stats.hits;
+			if (it->second.shelf == NO_SHELF)
+				return nullptr;
+
+			m_Shelves[it->second.shelf].lastUsedFrame = m_Frame;
+			return &it->second.rect;
+		}
+
+		++m_Stats.misses;
+
+		uint32_t width = 0;
+		uint32_t height = 0;
+		source.GetGlyphBitmapSize(codepoint, width, height);
+		if (width == 0 || height == 0)
+		{
+			m_Glyphs.emplace(key, Entry { GlyphAtlasRect(), NO_SHELF });
+			return nullptr;
+		}
+
+		const uint32_t paddedWidth = width + 2 * m_Specification.padding;
+		const uint32_t paddedHeight = height + 2 * m_Specification.padding;
+		const uint32_t rounding = m_Specification.shelfRounding;
+		const uint32_t shelfHeight = (paddedHeight + rounding - 1) / rounding * rounding;
+		if (paddedWidth > m_Specification.width || paddedHeight > m_Specification.height)
+		{
+			++m_Stats.failedAllocations;
+			return nullptr;
+		}
+
+		int32_t shelfIndex = FindShelf(paddedWidth, paddedHeight, shelfHeight);
+		if (shelfIndex < 0)
+		{
+			const uint32_t available = std::min(shelfHeight, m_Specification.height - std::min(m_NextShelfY, m_Specification.height));
+			if (available >= paddedHeight)
+			{
+				Shelf shelf;
+				shelf.y = m_NextShelfY;
+				shelf.height = available;
+				m_NextShelfY += available;
+				m_Shelves.push_back(std::move(shelf));
+				shelfIndex = static_cast<int32_t>(m_Shelves.size() - 1);
+			}
+		}
+
+		if (shelfIndex < 0)
+		{
+			/// Reuse the least recently used shelf that is tall enough and not referenced this frame.
+			for (uint32_t i = 0; i < m_Shelves.size(); ++i)
+			{
+				const Shelf &shelf = m_Shelves[i];
+				if (shelf.lastUsedFrame >= m_Frame || shelf.height < paddedHeight)
+					continue;
+
+				if (shelfIndex < 0)
+				{
+					shelfIndex = static_cast<int32_t>(i);
+					continue;
+				}
+
+				const Shelf &best = m_Shelves[shelfIndex];
+				if (shelf.lastUsedFrame < best.lastUsedFrame || (shelf.lastUsedFrame == best.lastUsedFrame && shelf.height < best.height))
+					shelfIndex = static_cast<int32_t>(i);
+			}
+
+			if (shelfIndex < 0)
+			{
+				++m_Stats.failedAllocations;
+				return nullptr;
+			}
+			EvictShelf(static_cast<uint32_t>(shelfIndex));
+		}
+
+		Shelf &shelf = m_Shelves[shelfIndex];
+		Entry entry;
+		entry.shelf = static_cast<uint32_t>(shelfIndex);
+		entry.rect.x = static_cast<uint16_t>(shelf.cursor + m_Specification.padding);
+		entry.rect.y = static_cast<uint16_t>(shelf.y + m_Specification.padding);
+		entry.rect.width = static_cast<uint16_t>(width);
+		entry.rect.height = static_cast<uint16_t>(height);
+
+		shelf.cursor += paddedWidth;
+		shelf.lastUsedFrame = m_Frame;
+		shelf.glyphs.push_back(key);
+
+		m_Pending.push_back({ &source, codepoint, entry.rect });
+		MarkDirty(entry.rect.y, entry.rect.y + height);
+
+		const auto [it, inserted] = m_Glyphs.emplace(key, entry);
+		m_Stats.glyphCount = static_cast<uint32_t>(m_Glyphs.size());
+		m_Stats.shelfCount = static_cast<uint32_t>(m_Shelves.size());
+		return &it->second.rect;
+	}
+
+	const GlyphAtlasRect *GlyphAtlas::Find(const uint64_t fontID, const uint32_t codepoint) const
+	{
+		const auto it = m_Glyphs.find(GlyphKey { fontID, codepoint });
+		if (it == m_Glyphs.end() || it->second.shelf == NO_SHELF)
+			return nullptr;
+		return &it->second.rect;
+	}
+
+	int32_t GlyphAtlas::FindShelf(const uint32_t paddedWidth, const uint32_t paddedHeight, const uint32_t shelfHeight)
+	{
+		/// Best fit by height, but do not put small glyphs on shelves more than 1.5x taller than they need.
+		const uint32_t maxHeight = shelfHeight + shelfHeight / 2;
+
+		int32_t best = -1;
+		for (uint32_t i = 0; i < m_Shelves.size(); ++i)
+		{
+			const Shelf &shelf = m_Shelves[i];
+			if (shelf.height < paddedHeight || shelf.height > maxHeight || shelf.cursor + paddedWidth > m_Specification.width)
+				continue;
+			if (best < 0 || shelf.height < m_Shelves[best].height)
+				best = static_cast<int32_t>(i);
+		}
+		return best;
+	}
+
+	void GlyphAtlas::EvictShelf(const uint32_t index)
+	{
+		Shelf &shelf = m_Shelves[index];
+		for (const GlyphKey &key : shelf.glyphs)
+			m_Glyphs.erase(key);
+
+		m_Stats.evictedGlyphs += shelf.glyphs.size();
+		++m_Stats.evictedShelves;
+		++m_EvictionEpoch;
+
+		const uint32_t begin = shelf.y;
+		const uint32_t end = shelf.y + shelf.height;
+		std::erase_if(m_Pending, [begin, end](const PendingGlyph &pending) { return pending.rect.y >= begin && pending.rect.y < end; });
+
+		/// Clear the old bitmaps so padding around new glyphs is empty again.
+		std::memset(m_Pixels.data() + static_cast<size_t>(begin) * GetRowPitch(), 0, static_cast<size_t>(shelf.height) * GetRowPitch());
+		MarkDirty(begin, end);
+
+		shelf.glyphs.clear();
+		shelf.cursor = 0;
+		m_Stats.glyphCount = static_cast<uint32_t>(m_Glyphs.size());
+	}
+
+	uint32_t GlyphAtlas::RasterizePending(ThreadPool *pool)
+	{
+		const uint32_t count = static_cast<uint32_t>(m_Pending.size());
+		if (count == 0)
+			return 0;
+
+		const uint32_t rowPitch = GetRowPitch();
+		const uint32_t bytesPerPixel = m_Specification.bytesPerPixel;
+		const auto rasterize = [&](const uint32_t index) {
+			const PendingGlyph &pending = m_Pending[index];
+			uint8_t *dst = m_Pixels.data() + static_cast<size_t>(pending.rect.y) * rowPitch + static_cast<size_t>(pending.rect.x) * bytesPerPixel;
+			pending.source->RasterizeGlyph(pending.codepoint, dst, rowPitch);
+		};
+
+		/// Each glyph owns a disjoint rectangle, so workers never write the same texels.
+		if (pool && count > 1)
+			pool->ParallelFor(count, rasterize);
+		else
+		{
+			for (uint32_t i = 0; i < count; ++i)
+				rasterize(i);
+		}
+
+		m_Stats.rasterized += count;
+		m_Pending.clear();
+		return count;
+	}
+
+	void GlyphAtlas::Clear()
+	{
+		m_Glyphs.clear();
+		m_Shelves.clear();
+		m_Pending.clear();
+		m_NextShelfY = 0;
+		++m_EvictionEpoch;
+
+		std::fill(m_Pixels.begin(), m_Pixels.end(), static_cast<uint8_t>(0));
+		MarkDirty(0, m_Specification.height);
+		m_Stats.glyphCount = 0;
+		m_Stats.shelfCount = 0;
+	}
+
+	void GlyphAtlas::RemoveFont(const uint64_t fontID)
+	{
+		std::erase_if(m_Glyphs, [fontID](const auto &glyph) { return glyph.first.fontID == fontID; });
+		std::erase_if(m_Pending, [fontID](const PendingGlyph &pending) { return pending.source->GetFontID() == fontID; });
+
+		for (Shelf &shelf : m_Shelves)
+		{
+			std::erase_if(shelf.glyphs, [fontID](const GlyphKey &key) { return key.fontID == fontID; });
+			/// Shelves left empty become the first eviction candidates.
+			if (shelf.glyphs.empty())
+				shelf.lastUsedFrame = 0;
+		}
+
+		++m_EvictionEpoch;
+		m_Stats.glyphCount = static_cast<uint32_t>(m_Glyphs.size());
+	}
+
+	void GlyphAtlas::MarkDirty(const uint32_t rowBegin, const uint32_t rowEnd)
+	{
+		if (!IsDirty())
+		{
+			m_DirtyBegin = rowBegin;
+			m_DirtyEnd = rowEnd;
+			return;
+		}
+
+		m_DirtyBegin = std::min(m_DirtyBegin, rowBegin);
+		m_DirtyEnd = std::max(m_DirtyEnd, rowEnd);
+	}
+
+	void GlyphAtlas::ClearDirty()
+	{
+		m_DirtyBegin = 0;
+		m_DirtyEnd = 0;
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,169 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* glyph_atlas.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "glyph_source.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	class ThreadPool;
+
+	struct GlyphAtlasSpecification
+	{
+		uint32_t width = 1024;
+		uint32_t height = 1024;
+		uint32_t bytesPerPixel = 4;		///< RGBA8 for MTSDF glyphs
+		uint32_t padding = 1;			///< Empty texels around each glyph so filtering does not bleed
+		uint32_t shelfRounding = 4;		///< Shelf heights are rounded up to a multiple of this to improve reuse
+	};
+
+	/// Placement of a glyph bitmap in the atlas, in texels. Row 0 is the bottom row.
+	struct GlyphAtlasRect
+	{
+		uint16_t x = 0;
+		uint16_t y = 0;
+		uint16_t width = 0;
+		uint16_t height = 0;
+	};
+
+	struct GlyphAtlasStats
+	{
+		uint32_t glyphCount = 0;
+		uint32_t shelfCount = 0;
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t rasterized = 0;
+		uint64_t evictedGlyphs = 0;
+		uint64_t evictedShelves = 0;
+		uint64_t failedAllocations = 0;
+	};
+
+	/**
+	 * @brief Glyph atlas filled on demand with shelf packing and LRU eviction.
+	 *
+	 * Glyphs are placed left to right on horizontal shelves. When the atlas is full the least
+	 * recently used shelf is cleared and reused as a whole, which keeps the allocator free of
+	 * fragmentation. Shelves touched in the current frame are never evicted because vertices
+	 * referencing them may already be written.
+	 *
+	 * Acquire() only reserves space; the bitmaps are produced in parallel by RasterizePending()
+	 * before the atlas texture is uploaded.
+	 */
+	class GlyphAtlas
+	{
+	public:
+		explicit GlyphAtlas(const GlyphAtlasSpecification &specification = GlyphAtlasSpecification());
+
+		/// Starts a new frame; glyphs used from here on are pinned until the next call.
+		void BeginFrame();
+
+		/**
+		 * @brief Returns the atlas placement of a glyph, reserving space and queueing rasterisation on a miss.
+		 * @return nullptr if the glyph has no bitmap or cannot fit without evicting pinned shelves.
+		 */
+		const GlyphAtlasRect *Acquire(const GlyphSource &source, uint32_t codepoint);
+
+		/// Placement of an already resident glyph without touching it.
+		[[nodiscard]] const GlyphAtlasRect *Find(uint64_t fontID, uint32_t codepoint) const;
+
+		/**
+		 * @brief Renders every glyph queued by Acquire() since the last call.
+		 * @param pool Workers to use; nullptr renders on the calling thread.
+		 * @return Number of glyphs rendered.
+		 */
+		uint32_t RasterizePending(ThreadPool *pool);
+
+		/// Drops every glyph. Sources must call this (or RemoveFont) before they are destroyed.
+		void Clear();
+		void RemoveFont(uint64_t fontID);
+
+		[[nodiscard]] const uint8_t *GetPixels() const { return m_Pixels.data(); }
+		[[nodiscard]] uint32_t GetRowPitch() const { return m_Specification.width * m_Specification.bytesPerPixel; }
+		[[nodiscard]] uint32_t GetWidth() const { return m_Specification.width; }
+		[[nodiscard]] uint32_t GetHeight() const { return m_Specification.height; }
+
+		/// Rows written since ClearDirty(), as [begin, end). Empty when begin == end.
+		[[nodiscard]] bool IsDirty() const { return m_DirtyEnd > m_DirtyBegin; }
+		[[nodiscard]] uint32_t GetDirtyRowBegin() const { return m_DirtyBegin; }
+		[[nodiscard]] uint32_t GetDirtyRowEnd() const { return m_DirtyEnd; }
+		void ClearDirty();
+
+		/// Changes whenever a glyph is evicted; placements cached with an older epoch must be re-acquired.
+		[[nodiscard]] uint64_t GetEvictionEpoch() const { return m_EvictionEpoch; }
+		[[nodiscard]] const GlyphAtlasStats &GetStats() const { return m_Stats; }
+
+	private:
+		struct GlyphKey
+		{
+			uint64_t fontID = 0;
+			uint32_t codepoint = 0;
+
+			bool operator==(const GlyphKey &other) const { return fontID == other.fontID && codepoint == other.codepoint; }
+		};
+
+		struct GlyphKeyHash
+		{
+			size_t operator()(const GlyphKey &key) const
+			{
+				return static_cast<size_t>((key.fontID * 0x9E3779B97F4A7C15ull) ^ (static_cast<uint64_t>(key.codepoint) * 0xC2B2AE3D27D4EB4Full));
+			}
+		};
+
+		struct Shelf
+		{
+			uint32_t y = 0;
+			uint32_t height = 0;
+			uint32_t cursor = 0;
+			uint64_t lastUsedFrame = 0;
+			std::vector<GlyphKey> glyphs;
+		};
+
+		struct Entry
+		{
+			GlyphAtlasRect rect;
+			uint32_t shelf = 0;
+		};
+
+		struct PendingGlyph
+		{
+			const GlyphSource *source = nullptr;
+			uint32_t codepoint = 0;
+			GlyphAtlasRect rect;
+		};
+
+		int32_t FindShelf(uint32_t paddedWidth, uint32_t paddedHeight, uint32_t shelfHeight);
+		void EvictShelf(uint32_t index);
+		void MarkDirty(uint32_t rowBegin, uint32_t rowEnd);
+
+		GlyphAtlasSpecification m_Specification;
+		std::vector<uint8_t> m_Pixels;
+		std::vector<Shelf> m_Shelves;
+		std::unordered_map<GlyphKey, Entry, GlyphKeyHash> m_Glyphs;
+		std::vector<PendingGlyph> m_Pending;
+
+		uint32_t m_NextShelfY = 0;
+		uint32_t m_DirtyBegin = 0;
+		uint32_t m_DirtyEnd = 0;
+		uint64_t m_Frame = 1;
+		uint64_t m_EvictionEpoch = 0;
+		GlyphAtlasStats m_Stats;
+	};
+
+}
+
+/// -------------------------------------------------------
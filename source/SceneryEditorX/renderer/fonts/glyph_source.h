@@ -0,0 +1,70 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* glyph_source.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/// Vertical font metrics in em units.
+	struct FontLineMetrics
+	{
+		float ascender = 0.8f;
+		float descender = -0.2f;
+		float lineHeight = 1.2f;
+	};
+
+	/// Horizontal advance and quad bounds (relative to the pen position) of one glyph, in em units.
+	struct GlyphMetrics
+	{
+		float advance = 0.0f;
+		float left = 0.0f;
+		float bottom = 0.0f;
+		float right = 0.0f;
+		float top = 0.0f;
+
+		[[nodiscard]] bool HasQuad() const { return right > left && top > bottom; }
+	};
+
+	/**
+	 * @brief Font data needed to lay out text and to fill the glyph atlas on demand.
+	 *
+	 * Metric queries are made from the render thread. RasterizeGlyph() is called from
+	 * worker threads and must not modify shared state.
+	 */
+	class GlyphSource
+	{
+	public:
+		virtual ~GlyphSource() = default;
+
+		/// Unique for the lifetime of the process, used to key layouts and atlas entries.
+		[[nodiscard]] virtual uint64_t GetFontID() const = 0;
+		[[nodiscard]] virtual const FontLineMetrics &GetLineMetrics() const = 0;
+
+		/// Returns false if the font has no glyph for the codepoint.
+		virtual bool GetGlyphMetrics(uint32_t codepoint, GlyphMetrics &metrics) const = 0;
+
+		/// Advance of `codepoint` in em units including kerning against `next` (0 at the end of the text).
+		[[nodiscard]] virtual float GetAdvance(uint32_t codepoint, uint32_t next) const = 0;
+
+		/// Size in texels of the bitmap RasterizeGlyph() produces, 0x0 for glyphs without a quad.
+		virtual void GetGlyphBitmapSize(uint32_t codepoint, uint32_t &width, uint32_t &height) const = 0;
+
+		/// Renders the glyph into `dst` in the atlas pixel format. Row 0 is the bottom row.
+		virtual void RasterizeGlyph(uint32_t codepoint, uint8_t *dst, uint32_t rowPitch) const = 0;
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,102 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* msdf_glyph_source.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "msdf_glyph_source.h"
+#include <algorithm>
+#include "msdf_impl.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	MSDFGlyphSource::MSDFGlyphSource(const uint64_t fontID, const MSDFData &data) : m_FontID(fontID), m_Data(data)
+	{
+		const auto &metrics = m_Data.FontGeometry.getMetrics();
+		m_LineMetrics.ascender = static_cast<float>(metrics.ascenderY);
+		m_LineMetrics.descender = static_cast<float>(metrics.descenderY);
+		m_LineMetrics.lineHeight = static_cast<float>(metrics.lineHeight);
+	}
+
+	bool MSDFGlyphSource::GetGlyphMetrics(const uint32_t codepoint, GlyphMetrics &metrics) const
+	{
+		const msdf_atlas::GlyphGeometry *glyph = m_Data.FontGeometry.getGlyph(static_cast<msdf_atlas::unicode_t>(codepoint));
+		if (!glyph)
+			return false;
+
+		double l, b, r, t;
+		glyph->getQuadPlaneBounds(l, b, r, t);
+		metrics.advance = static_cast<float>(glyph->getAdvance());
+		metrics.left = static_cast<float>(l);
+		metrics.bottom = static_cast<float>(b);
+		metrics.right = static_cast<float>(r);
+		metrics.top = static_cast<float>(t);
+		return true;
+	}
+
+	float MSDFGlyphSource::GetAdvance(const uint32_t codepoint, const uint32_t next) const
+	{
+		const msdf_atlas::GlyphGeometry *glyph = m_Data.FontGeometry.getGlyph(static_cast<msdf_atlas::unicode_t>(codepoint));
+		if (!glyph)
+			return 0.0f;
+
+		double advance = glyph->getAdvance();
+		m_Data.FontGeometry.getAdvance(advance, static_cast<msdf_atlas::unicode_t>(codepoint), static_cast<msdf_atlas::unicode_t>(next));
+		return static_cast<float>(advance);
+	}
+
+	void MSDFGlyphSource::GetGlyphBitmapSize(const uint32_t codepoint, uint32_t &width, uint32_t &height) const
+	{
+		width = 0;
+		height = 0;
+
+		const msdf_atlas::GlyphGeometry *glyph = m_Data.FontGeometry.getGlyph(static_cast<msdf_atlas::unicode_t>(codepoint));
+		if (!glyph || glyph->isWhitespace())
+			return;
+
+		int w = 0, h = 0;
+		glyph->getBoxSize(w, h);
+		width = static_cast<uint32_t>(std::max(w, 0));
+		height = static_cast<uint32_t>(std::max(h, 0));
+	}
+
+	void MSDFGlyphSource::RasterizeGlyph(const uint32_t codepoint, uint8_t *dst, const uint32_t rowPitch) const
+	{
+		const msdf_atlas::GlyphGeometry *glyph = m_Data.FontGeometry.getGlyph(static_cast<msdf_atlas::unicode_t>(codepoint));
+		if (!glyph)
+			return;
+
+		int w = 0, h = 0;
+		glyph->getBoxSize(w, h);
+		if (w <= 0 || h <= 0)
+			return;
+
+		msdf_atlas::GeneratorAttributes attributes;
+		attributes.config.overlapSupport = true;
+		attributes.scanlinePass = true;
+
+		msdfgen::Bitmap<float, 4> bitmap(w, h);
+		msdf_atlas::mtsdfGenerator(bitmap, *glyph, attributes);
+
+		/// Bitmap rows are bottom up like the atlas; quantise to RGBA8 the way msdfgen's byte bitmaps do.
+		const size_t channels = static_cast<size_t>(w) * 4;
+		for (int y = 0; y < h; ++y)
+		{
+			const float *src = bitmap(0, y);
+			uint8_t *row = dst + static_cast<size_t>(y) * rowPitch;
+			for (size_t i = 0; i < channels; ++i)
+				row[i] = static_cast<uint8_t>(std::clamp(256.0f * src[i], 0.0f, 255.0f));
+		}
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,49 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* msdf_glyph_source.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include "glyph_source.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	struct MSDFData;
+
+	/**
+	 * @brief GlyphSource backed by the msdf-atlas-gen font geometry of a Font.
+	 *
+	 * Glyph boxes must already be sized (the packer in Font::CreateAtlas does this). Glyphs
+	 * are rendered as MTSDF into RGBA8 texels, matching GlyphAtlasSpecification defaults.
+	 */
+	class MSDFGlyphSource : public GlyphSource
+	{
+	public:
+		MSDFGlyphSource(uint64_t fontID, const MSDFData &data);
+
+		[[nodiscard]] uint64_t GetFontID() const override { return m_FontID; }
+		[[nodiscard]] const FontLineMetrics &GetLineMetrics() const override { return m_LineMetrics; }
+
+		bool GetGlyphMetrics(uint32_t codepoint, GlyphMetrics &metrics) const override;
+		[[nodiscard]] float GetAdvance(uint32_t codepoint, uint32_t next) const override;
+		void GetGlyphBitmapSize(uint32_t codepoint, uint32_t &width, uint32_t &height) const override;
+		void RasterizeGlyph(uint32_t codepoint, uint8_t *dst, uint32_t rowPitch) const override;
+
+	private:
+		uint64_t m_FontID = 0;
+		const MSDFData &m_Data;
+		FontLineMetrics m_LineMetrics;
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,255 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* text_layout.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "text_layout.h"
+#include <algorithm>
+#include <bit>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	void TextLayoutEngine::DecodeUTF8(const std::string_view text, std::vector<uint32_t> &out)
+	{
+		constexpr uint32_t replacement = 0xFFFD;
+
+		out.clear();
+		out.reserve(text.size());
+
+		const auto *bytes = reinterpret_cast<const uint8_t *>(text.data());
+		const size_t size = text.size();
+		size_t i = 0;
+		while (i < size)
+		{
+			const uint8_t lead = bytes[i];
+			if (lead < 0x80)
+			{
+				out.push_back(lead);
+				++i;
+				continue;
+			}
+
+			uint32_t length = 0;
+			uint32_t codepoint = 0;
+			uint32_t minimum = 0;
+			if ((lead & 0xE0) == 0xC0)
+			{
+				length = 2;
+				codepoint = lead & 0x1F;
+				minimum = 0x80;
+			}
+			else if ((lead & 0xF0) == 0xE0)
+			{
+				length = 3;
+				codepoint = lead & 0x0F;
+				minimum = 0x800;
+			}
+			else if ((lead & 0xF8) == 0xF0)
+			{
+				length = 4;
+				codepoint = lead & 0x07;
+				minimum = 0x10000;
+			}
+
+			bool valid = length != 0 && i + length <= size;
+			for (uint32_t k = 1; valid && k < length; ++k)
+			{
+				const uint8_t continuation = bytes[i + k];
+				valid = (continuation & 0xC0) == 0x80;
+				codepoint = (codepoint << 6) | (continuation & 0x3F);
+			}
+
+			/// Overlong encodings, surrogates and values past U+10FFFF are malformed.
+			if (!valid || codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+			{
+				out.push_back(replacement);
+				++i;
+				continue;
+			}
+
+			out.push_back(codepoint);
+			i += length;
+		}
+	}
+
+	void TextLayoutEngine::Layout(const std::string_view text, const GlyphSource &source, const TextLayoutParams &params, TextLayout &out)
+	{
+		thread_local std::vector<uint32_t> codepoints;
+		DecodeUTF8(text, codepoints);
+
+		out.glyphs.clear();
+		out.glyphs.reserve(codepoints.size());
+		out.width = 0.0f;
+		out.height = 0.0f;
+		out.lineCount = 0;
+		if (codepoints.empty())
+			return;
+
+		const FontLineMetrics &metrics = source.GetLineMetrics();
+		const float emHeight = metrics.ascender - metrics.descender;
+		const float fsScale = emHeight > 0.0f ? 1.0f / emHeight : 1.0f;
+		const float lineAdvance = fsScale * metrics.lineHeight + params.lineHeightOffset;
+
+		float x = 0.0f;
+		float y = 0.0f;
+		uint32_t lines = 1;
+		size_t lastSpace = SIZE_MAX;
+		size_t glyphsAtSpace = 0;
+
+		const size_t count = codepoints.size();
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint32_t codepoint = codepoints[i];
+			if (codepoint == '\n')
+			{
+				x = 0.0f;
+				y -= lineAdvance;
+				++lines;
+				lastSpace = SIZE_MAX;
+				continue;
+			}
+			if (codepoint == '\r')
+				continue;
+
+			GlyphMetrics glyph;
+			if (!source.GetGlyphMetrics(codepoint, glyph))
+				continue;
+
+			if (codepoint == ' ')
+			{
+				lastSpace = i;
+				glyphsAtSpace = out.glyphs.size();
+			}
+			else if (glyph.HasQuad())
+			{
+				const float right = x + glyph.right * fsScale;
+				if (params.maxWidth > 0.0f && right > params.maxWidth && lastSpace != SIZE_MAX)
+				{
+					/// Move the word that overflowed to a new line and lay it out again.
+					out.glyphs.resize(glyphsAtSpace);
+					i = lastSpace;
+					lastSpace = SIZE_MAX;
+					x = 0.0f;
+					y -= lineAdvance;
+					++lines;
+					continue;
+				}
+
+				TextLayoutGlyph &quad = out.glyphs.emplace_back();
+				quad.codepoint = codepoint;
+				quad.left = x + glyph.left * fsScale;
+				quad.bottom = y + glyph.bottom * fsScale;
+				quad.right = right;
+				quad.top = y + glyph.top * fsScale;
+			}
+
+			const uint32_t next = i + 1 < count ? codepoints[i + 1] : 0;
+			x += fsScale * source.GetAdvance(codepoint, next) + params.kerningOffset;
+		}
+
+		for (const TextLayoutGlyph &quad : out.glyphs)
+			out.width = std::max(out.width, quad.right);
+		out.lineCount = lines;
+		out.height = fsScale * emHeight + static_cast<float>(lines - 1) * lineAdvance;
+	}
+
+	/// -------------------------------------------------------
+
+	bool TextLayoutCache::Key::operator==(const Key &other) const
+	{
+		return fontID == other.fontID && params.maxWidth == other.params.maxWidth && params.lineHeightOffset == other.params.lineHeightOffset &&
+		       params.kerningOffset == other.params.kerningOffset && text == other.text;
+	}
+
+	size_t TextLayoutCache::KeyHash::operator()(const Key &key) const
+	{
+		uint64_t hash = std::hash<std::string_view>()(key.text);
+		const auto mix = [&hash](const uint64_t value) {
+			hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+		};
+		mix(key.fontID);
+		mix(std::bit_cast<uint32_t>(key.params.maxWidth));
+		mix(std::bit_cast<uint32_t>(key.params.lineHeightOffset));
+		mix(std::bit_cast<uint32_t>(key.params.kerningOffset));
+		return static_cast<size_t>(hash);
+	}
+
+	TextLayoutCache::TextLayoutCache(const size_t capacity) : m_Capacity(std::max<size_t>(capacity, 1))
+	{
+	}
+
+	const TextLayout &TextLayoutCache::Get(const std::string_view text, const GlyphSource &source, const TextLayoutParams &params)
+	{
+		const Key lookup { source.GetFontID(), params, text };
+		if (const auto it = m_Index.find(lookup); it != m_Index.end())
+		{
+			++m_Stats.hits;
+			m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+			return it->second->layout;
+		}
+
+		++m_Stats.misses;
+
+		/// The key views the node's own copy of the string, so the node must be in place first.
+		Node &node = m_Entries.emplace_front();
+		node.text.assign(text);
+		node.key = Key { lookup.fontID, params, node.text };
+		TextLayoutEngine::Layout(node.text, source, params, node.layout);
+		m_Index.emplace(node.key, m_Entries.begin());
+
+		Trim();
+		m_Stats.entries = m_Entries.size();
+		return m_Entries.front().layout;
+	}
+
+	void TextLayoutCache::Trim()
+	{
+		while (m_Entries.size() > m_Capacity)
+		{
+			m_Index.erase(m_Entries.back().key);
+			m_Entries.pop_back();
+			++m_Stats.evictions;
+		}
+	}
+
+	void TextLayoutCache::RemoveFont(const uint64_t fontID)
+	{
+		for (auto it = m_Entries.begin(); it != m_Entries.end();)
+		{
+			if (it->key.fontID == fontID)
+			{
+				m_Index.erase(it->key);
+				it = m_Entries.erase(it);
+			}
+			else
+				++it;
+		}
+		m_Stats.entries = m_Entries.size();
+	}
+
+	void TextLayoutCache::Clear()
+	{
+		m_Index.clear();
+		m_Entries.clear();
+		m_Stats.entries = 0;
+	}
+
+	void TextLayoutCache::SetCapacity(const size_t capacity)
+	{
+		m_Capacity = std::max<size_t>(capacity, 1);
+		Trim();
+		m_Stats.entries = m_Entries.size();
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,130 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* text_layout.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "glyph_source.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	struct TextLayoutParams
+	{
+		float maxWidth = 0.0f;			///< Wrap at spaces past this width (layout units), 0 disables wrapping
+		float lineHeightOffset = 0.0f;
+		float kerningOffset = 0.0f;
+	};
+
+	/// Positioned glyph quad in layout units; the first baseline is y = 0 and lines go down.
+	struct TextLayoutGlyph
+	{
+		uint32_t codepoint = 0;
+		float left = 0.0f;
+		float bottom = 0.0f;
+		float right = 0.0f;
+		float top = 0.0f;
+	};
+
+	struct TextLayout
+	{
+		std::vector<TextLayoutGlyph> glyphs;
+		float width = 0.0f;
+		float height = 0.0f;
+		uint32_t lineCount = 0;
+	};
+
+	class TextLayoutEngine
+	{
+	public:
+		/**
+		 * @brief Shapes a UTF-8 string: glyph lookup, kerning, line breaks and greedy word wrap.
+		 *
+		 * Layout units are em units scaled so that ascender - descender == 1.
+		 */
+		static void Layout(std::string_view text, const GlyphSource &source, const TextLayoutParams &params, TextLayout &out);
+
+		/// Decodes UTF-8, replacing malformed sequences with U+FFFD.
+		static void DecodeUTF8(std::string_view text, std::vector<uint32_t> &out);
+	};
+
+	struct TextLayoutCacheStats
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t evictions = 0;
+		size_t entries = 0;
+	};
+
+	/**
+	 * @brief LRU cache of shaped text keyed by font, string and layout parameters.
+	 *
+	 * Labels that do not change between frames cost one hash lookup instead of a re-layout.
+	 */
+	class TextLayoutCache
+	{
+	public:
+		explicit TextLayoutCache(size_t capacity = 4096);
+
+		/**
+		 * @brief Returns the cached layout, shaping the text on a miss.
+		 *
+		 * The reference stays valid until the next call that inserts into the cache.
+		 */
+		const TextLayout &Get(std::string_view text, const GlyphSource &source, const TextLayoutParams &params);
+
+		void RemoveFont(uint64_t fontID);
+		void Clear();
+		void SetCapacity(size_t capacity);
+
+		[[nodiscard]] size_t GetCapacity() const { return m_Capacity; }
+		[[nodiscard]] const TextLayoutCacheStats &GetStats() const { return m_Stats; }
+
+	private:
+		struct Key
+		{
+			uint64_t fontID = 0;
+			TextLayoutParams params;
+			std::string_view text;
+
+			bool operator==(const Key &other) const;
+		};
+
+		struct KeyHash
+		{
+			size_t operator()(const Key &key) const;
+		};
+
+		struct Node
+		{
+			std::string text;
+			Key key;
+			TextLayout layout;
+		};
+
+		void Trim();
+
+		size_t m_Capacity;
+		std::list<Node> m_Entries;	///< Most recently used first; Key::text points into Node::text
+		std::unordered_map<Key, std::list<Node>::iterator, KeyHash> m_Index;
+		TextLayoutCacheStats m_Stats;
+	};
+
+}
+
+/// -------------------------------------------------------
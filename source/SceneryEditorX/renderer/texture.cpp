@@ -709,6 +709,80 @@ namespace SceneryEditorX
 			GenerateMips();
     }
 
+    void Texture2D::SetRows(const Buffer &buffer, uint32_t rowBegin, uint32_t rowEnd)
+    {
+		rowEnd = std::min(rowEnd, m_Specification.height);
+		if (rowBegin >= rowEnd)
+			return;
+
+		const size_t rowPitch = Utils::GetMemorySize(m_Specification.format, m_Specification.width, 1);
+		const size_t offset = rowBegin * rowPitch;
+		const VkDeviceSize size = (rowEnd - rowBegin) * rowPitch;
+		SEDX_CORE_ASSERT(buffer.data && buffer.size >= offset + size);
+
+		/// Keep the CPU copy in step so a later Invalidate or readback sees the new rows
+		if (m_ImageData.size >= offset + size)
+			m_ImageData.Write(buffer.As<uint8_t>() + offset, size, offset);
+
+	    const auto device = RenderContext::GetCurrentDevice();
+		const Ref<Image2D> image = m_Image.As<Image2D>();
+		const auto& info = image->GetImageInfo();
+		const VkImageLayout layout = image->GetDescriptorInfoVulkan().imageLayout;
+
+		MemoryAllocator allocator("Texture2D");
+
+		/// Create staging buffer for the dirty rows only
+		VkBufferCreateInfo bufferCreateInfo{};
+		bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferCreateInfo.size = size;
+		bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		VkBuffer stagingBuffer;
+		const VmaAllocation stagingBufferAllocation = allocator.AllocateBuffer(bufferCreateInfo, VMA_MEMORY_USAGE_CPU_TO_GPU, stagingBuffer);
+
+		uint8_t* destData = allocator.MapMemory<uint8_t>(stagingBufferAllocation);
+		memcpy(destData, buffer.As<uint8_t>() + offset, size);
+        MemoryAllocator::UnmapMemory(stagingBufferAllocation);
+
+		const VkCommandBuffer copyCmd = device->GetCommandBuffer(true);
+
+		VkImageSubresourceRange subresourceRange = {};
+		subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		subresourceRange.baseMipLevel = 0;
+		subresourceRange.levelCount = 1;
+		subresourceRange.layerCount = 1;
+
+		/// The image is live, so wait for earlier fragment reads on this queue instead of discarding it from UNDEFINED
+		InsertImageMemoryBarrier(copyCmd, info.image,
+			VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+			layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			subresourceRange);
+
+		VkBufferImageCopy bufferCopyRegion = {};
+		bufferCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		bufferCopyRegion.imageSubresource.mipLevel = 0;
+		bufferCopyRegion.imageSubresource.baseArrayLayer = 0;
+		bufferCopyRegion.imageSubresource.layerCount = 1;
+		bufferCopyRegion.imageOffset = { 0, static_cast<int32_t>(rowBegin), 0 };
+		bufferCopyRegion.imageExtent.width = m_Specification.width;
+		bufferCopyRegion.imageExtent.height = rowEnd - rowBegin;
+		bufferCopyRegion.imageExtent.depth = 1;
+		bufferCopyRegion.bufferOffset = 0;
+
+		vkCmdCopyBufferToImage(copyCmd, stagingBuffer, info.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &bufferCopyRegion);
+
+		InsertImageMemoryBarrier(copyCmd, info.image,
+			VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, layout,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			subresourceRange);
+
+		device->FlushCmdBuffer(copyCmd);
+
+		allocator.DestroyBuffer(stagingBuffer, stagingBufferAllocation);
+    }
+
 	//////////////////////////////////////////////////////////////////////////////////
     /// TextureCube
     //////////////////////////////////////////////////////////////////////////////////
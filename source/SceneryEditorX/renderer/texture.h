@@ -119,6 +119,10 @@ namespace SceneryEditorX
 		void GenerateMips();
 		virtual uint64_t GetHash() const override;
         void CopyToHostBuffer(Buffer &buffer) const;
+
+		///< Re-upload rows [rowBegin, rowEnd) of mip 0 from a full-size image buffer, keeping the image and its descriptors
+		void SetRows(const Buffer &buffer, uint32_t rowBegin, uint32_t rowEnd);
+
         virtual TextureType GetType() const override { return TextureType::Texture2D; }
 
     private:
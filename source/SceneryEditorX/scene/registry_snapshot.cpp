@@ -0,0 +1,211 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* registry_snapshot.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "registry_snapshot.h"
+#include <algorithm>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		void WriteFileHeader(SnapshotWriter &writer, const uint32_t blockCount)
+		{
+			writer.Write(RegistrySnapshot::MAGIC);
+			writer.Write(RegistrySnapshot::VERSION);
+			writer.Write(static_cast<uint16_t>(0));
+			writer.Write(blockCount);
+			writer.Write(static_cast<uint32_t>(0));
+		}
+
+		/// Copies a little-endian uint32 array out of the (possibly unaligned) file data.
+		std::vector<uint32_t> CopyWords(const uint8_t *data, const uint32_t count)
+		{
+			std::vector<uint32_t> words(count);
+			if (count)
+				std::memcpy(words.data(), data, static_cast<size_t>(count) * sizeof(uint32_t));
+			return words;
+		}
+	}
+
+	size_t RegistrySnapshot::WriteBlockHeader(SnapshotWriter &writer, const uint32_t typeId, const uint32_t flags, const uint32_t elementSize,
+	                                          const uint32_t wordCount, const uint32_t entityCount, const uint64_t payloadSize)
+	{
+		writer.Write(typeId);
+		writer.Write(flags);
+		writer.Write(elementSize);
+		writer.Write(wordCount);
+		writer.Write(entityCount);
+		writer.Write(static_cast<uint32_t>(0));
+
+		const size_t sizeOffset = writer.GetSize();
+		writer.Write(payloadSize);
+		return sizeOffset;
+	}
+
+	const RegistrySnapshot::Component *RegistrySnapshot::FindComponent(const uint32_t typeId) const
+	{
+		const auto it = std::ranges::find(m_Components, typeId, &Component::typeId);
+		return it != m_Components.end() ? &*it : nullptr;
+	}
+
+	void RegistrySnapshot::Save(const entt::registry &registry, std::vector<uint8_t> &out) const
+	{
+		out.clear();
+		SnapshotWriter writer(out);
+		WriteFileHeader(writer, static_cast<uint32_t>(m_Components.size()));
+
+		const entt::snapshot snapshot{registry};
+		SnapshotOutputArchive archive;
+		for (const Component &component : m_Components)
+		{
+			archive.Begin(component.elementSize);
+			component.save(snapshot, archive);
+
+			const auto &words = archive.GetWords();
+			const auto &entities = archive.GetEntities();
+			const auto &payload = archive.GetPayload();
+
+			writer.Reserve(32 + (words.size() + entities.size()) * sizeof(EntityType) + payload.size());
+			WriteBlockHeader(writer, component.typeId, component.flags, component.elementSize, static_cast<uint32_t>(words.size()),
+			                 static_cast<uint32_t>(entities.size()), payload.size());
+			writer.Write(words.data(), words.size() * sizeof(EntityType));
+			writer.Write(entities.data(), entities.size() * sizeof(EntityType));
+			writer.Write(payload.data(), payload.size());
+		}
+	}
+
+	RegistrySnapshotStaging RegistrySnapshot::Stage(const entt::registry &registry) const
+	{
+		RegistrySnapshotStaging staging;
+		staging.m_Blocks.reserve(m_Components.size());
+		for (const Component &component : m_Components)
+			staging.m_Blocks.push_back(component.stage(registry, component));
+		return staging;
+	}
+
+	void RegistrySnapshot::Encode(const RegistrySnapshotStaging &staging, std::vector<uint8_t> &out)
+	{
+		out.clear();
+		SnapshotWriter writer(out);
+		WriteFileHeader(writer, static_cast<uint32_t>(staging.m_Blocks.size()));
+		for (const auto &block : staging.m_Blocks)
+			block->Encode(writer);
+	}
+
+	RegistrySnapshotLoadResult RegistrySnapshot::Load(entt::registry &registry, const uint8_t *data, const size_t size, const RegistrySnapshotLoadOptions &options) const
+	{
+		RegistrySnapshotLoadResult result;
+		SnapshotReader reader(data, size);
+
+		uint32_t magic = 0;
+		uint16_t version = 0;
+		uint16_t headerFlags = 0;
+		uint32_t blockCount = 0;
+		uint32_t reserved = 0;
+		reader.Read(magic);
+		reader.Read(version);
+		reader.Read(headerFlags);
+		reader.Read(blockCount);
+		reader.Read(reserved);
+
+		if (!reader.IsGood() || magic != MAGIC)
+		{
+			result.error = "Not a registry snapshot";
+			return result;
+		}
+		if (version > VERSION)
+		{
+			result.error = "Snapshot version " + std::to_string(version) + " is newer than supported version " + std::to_string(VERSION);
+			return result;
+		}
+
+		entt::continuous_loader loader{registry};
+		std::vector<entt::entity> &loaded = result.entities;
+
+		for (uint32_t b = 0; b < blockCount; ++b)
+		{
+			uint32_t typeId = 0, flags = 0, elementSize = 0, wordCount = 0, entityCount = 0, blockReserved = 0;
+			uint64_t payloadSize = 0;
+			reader.Read(typeId);
+			reader.Read(flags);
+			reader.Read(elementSize);
+			reader.Read(wordCount);
+			reader.Read(entityCount);
+			reader.Read(blockReserved);
+			reader.Read(payloadSize);
+
+			const uint8_t *words = reader.Skip(static_cast<size_t>(wordCount) * sizeof(EntityType));
+			const uint8_t *entities = reader.Skip(static_cast<size_t>(entityCount) * sizeof(EntityType));
+			const uint8_t *payload = payloadSize <= reader.GetRemaining() ? reader.Skip(static_cast<size_t>(payloadSize)) : nullptr;
+			if (!reader.IsGood() || !payload)
+			{
+				result.error = "Snapshot is truncated in block " + std::to_string(b);
+				return result;
+			}
+
+			/// Types this build does not know, or whose raw layout changed, are left out rather than misread.
+			const Component *component = FindComponent(typeId);
+			if (!component || component->flags != flags || component->elementSize != elementSize)
+			{
+				++result.skippedBlocks;
+				continue;
+			}
+
+			const std::vector<uint32_t> wordArray = CopyWords(words, wordCount);
+			const std::vector<uint32_t> entityArray = CopyWords(entities, entityCount);
+			const bool sizesMatch = (flags & BLOCK_BITWISE) == 0 || payloadSize == static_cast<uint64_t>(entityCount) * elementSize;
+			if (wordArray.empty() || wordArray.front() != entityCount || !sizesMatch)
+			{
+				result.error = "Component block '" + component->name + "' is inconsistent";
+				return result;
+			}
+
+			SnapshotInputArchive archive(wordArray, entityArray, SnapshotReader(payload, static_cast<size_t>(payloadSize)));
+			component->load(loader, archive);
+			if (!archive.IsGood())
+			{
+				result.error = "Component block '" + component->name + "' is corrupt";
+				return result;
+			}
+
+			loaded.reserve(loaded.size() + entityArray.size());
+			for (const uint32_t entity : entityArray)
+				loaded.push_back(loader.map(static_cast<entt::entity>(entity)));
+			++result.loadedBlocks;
+		}
+
+		std::ranges::sort(loaded);
+		loaded.erase(std::ranges::unique(loaded).begin(), loaded.end());
+
+		if (options.regenerateUUIDs)
+		{
+			for (const Component &component : m_Components)
+			{
+				if (component.assignIdentity)
+					component.assignIdentity(registry, loaded, result.remap);
+			}
+			for (const Component &component : m_Components)
+			{
+				if (component.remapReferences)
+					component.remapReferences(registry, loaded, result.remap);
+			}
+		}
+
+		result.success = true;
+		return result;
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,563 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* registry_snapshot.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <entt/src/entt/entt.hpp>
+#include "SceneryEditorX/core/identifiers/uuid.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/**
+	 * @brief Components that are stored with a plain memcpy.
+	 *
+	 * Defaults to trivially copyable types. Specialise it for components that are bitwise safe
+	 * but not trivially copyable, e.g. plain structs holding a UUID.
+	 */
+	template<typename T>
+	struct SnapshotBitwise : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+	/// A UUID is a single 64-bit value; its copy constructor is only non-trivial because it is defined out of line.
+	template<>
+	struct SnapshotBitwise<UUID> : std::true_type {};
+
+	template<typename T>
+	inline constexpr bool SnapshotBitwise_v = SnapshotBitwise<T>::value;
+
+	/// -------------------------------------------------------
+
+	class SnapshotWriter
+	{
+	public:
+		explicit SnapshotWriter(std::vector<uint8_t> &out) : m_Out(out) {}
+
+		void Write(const void *data, const size_t size)
+		{
+			if (size == 0)
+				return;
+			const size_t offset = m_Out.size();
+			m_Out.resize(offset + size);
+			std::memcpy(m_Out.data() + offset, data, size);
+		}
+
+		template<typename T>
+		void Write(const T &value)
+		{
+			static_assert(SnapshotBitwise_v<T>, "Only bitwise types can be written directly");
+			Write(&value, sizeof(T));
+		}
+
+		template<typename T>
+		void Patch(const size_t offset, const T &value)
+		{
+			static_assert(SnapshotBitwise_v<T>, "Only bitwise types can be written directly");
+			std::memcpy(m_Out.data() + offset, &value, sizeof(T));
+		}
+
+		void WriteString(const std::string_view string)
+		{
+			Write(static_cast<uint32_t>(string.size()));
+			Write(string.data(), string.size());
+		}
+
+		template<typename T>
+		void WriteVector(const std::vector<T> &vector)
+		{
+			static_assert(SnapshotBitwise_v<T>, "Only vectors of bitwise types can be written directly");
+			Write(static_cast<uint32_t>(vector.size()));
+			Write(vector.data(), vector.size() * sizeof(T));
+		}
+
+		void Reserve(const size_t bytes) { m_Out.reserve(m_Out.size() + bytes); }
+		[[nodiscard]] size_t GetSize() const { return m_Out.size(); }
+
+	private:
+		std::vector<uint8_t> &m_Out;
+	};
+
+	/// Bounds checked reader. Reads past the end zero the destination and latch the failed state.
+	class SnapshotReader
+	{
+	public:
+		SnapshotReader() = default;
+		SnapshotReader(const uint8_t *data, const size_t size) : m_Data(data), m_Size(size) {}
+
+		bool Read(void *dst, const size_t size)
+		{
+			if (!m_Good || size > m_Size - m_Offset)
+			{
+				m_Good = false;
+				std::memset(dst, 0, size);
+				return false;
+			}
+			std::memcpy(dst, m_Data + m_Offset, size);
+			m_Offset += size;
+			return true;
+		}
+
+		template<typename T>
+		bool Read(T &value)
+		{
+			static_assert(SnapshotBitwise_v<T>, "Only bitwise types can be read directly");
+			return Read(&value, sizeof(T));
+		}
+
+		bool ReadString(std::string &string)
+		{
+			uint32_t length = 0;
+			if (!Read(length) || length > m_Size - m_Offset)
+			{
+				m_Good = false;
+				string.clear();
+				return false;
+			}
+			string.assign(reinterpret_cast<const char *>(m_Data + m_Offset), length);
+			m_Offset += length;
+			return true;
+		}
+
+		template<typename T>
+		bool ReadVector(std::vector<T> &vector)
+		{
+			static_assert(SnapshotBitwise_v<T>, "Only vectors of bitwise types can be read directly");
+			uint32_t count = 0;
+			if (!Read(count) || count > (m_Size - m_Offset) / sizeof(T))
+			{
+				m_Good = false;
+				vector.clear();
+				return false;
+			}
+			vector.resize(count);
+			return Read(vector.data(), static_cast<size_t>(count) * sizeof(T));
+		}
+
+		/// Returns a view of the next @p size bytes and moves past them, or nullptr if they are not there.
+		const uint8_t *Skip(const size_t size)
+		{
+			if (!m_Good || size > m_Size - m_Offset)
+			{
+				m_Good = false;
+				return nullptr;
+			}
+			const uint8_t *data = m_Data + m_Offset;
+			m_Offset += size;
+			return data;
+		}
+
+		[[nodiscard]] bool IsGood() const { return m_Good; }
+		[[nodiscard]] size_t GetOffset() const { return m_Offset; }
+		[[nodiscard]] size_t GetRemaining() const { return m_Size - m_Offset; }
+
+	private:
+		const uint8_t *m_Data = nullptr;
+		size_t m_Size = 0;
+		size_t m_Offset = 0;
+		bool m_Good = true;
+	};
+
+	/// -------------------------------------------------------
+
+	/// Old to new UUIDs of entities whose identity was regenerated on load.
+	class SnapshotUUIDRemap
+	{
+	public:
+		void Add(const UUID from, const UUID to) { m_Map[from] = to; }
+
+		/// Returns the new UUID, or @p id unchanged if it was not remapped (e.g. it refers outside the snapshot).
+		UUID operator()(const UUID id) const
+		{
+			const auto it = m_Map.find(id);
+			return it != m_Map.end() ? it->second : id;
+		}
+
+		[[nodiscard]] bool IsEmpty() const { return m_Map.empty(); }
+		[[nodiscard]] size_t GetSize() const { return m_Map.size(); }
+
+	private:
+		std::unordered_map<UUID, UUID> m_Map;
+	};
+
+	/**
+	 * @brief Component serialisation hooks, found by argument dependent lookup.
+	 *
+	 * Bitwise components need no hooks. Every other registered component must provide
+	 * @code
+	 * void SnapshotWrite(SnapshotWriter &writer, const T &component);
+	 * void SnapshotRead(SnapshotReader &reader, T &component);
+	 * @endcode
+	 * Optionally, for UUID regeneration on load:
+	 * @code
+	 * UUID &SnapshotIdentity(T &component);                               // the entity's own UUID
+	 * void SnapshotRemapUUIDs(T &component, const SnapshotUUIDRemap &remap); // references to other entities
+	 * @endcode
+	 */
+	template<typename T>
+	concept SnapshotSerializable = SnapshotBitwise_v<T> || requires(SnapshotWriter &writer, SnapshotReader &reader, const T &in, T &out) {
+		SnapshotWrite(writer, in);
+		SnapshotRead(reader, out);
+	};
+
+	template<typename T>
+	concept SnapshotHasIdentity = requires(T &component) {
+		{ SnapshotIdentity(component) } -> std::same_as<UUID &>;
+	};
+
+	template<typename T>
+	concept SnapshotHasUUIDReferences = requires(T &component, const SnapshotUUIDRemap &remap) { SnapshotRemapUUIDs(component, remap); };
+
+	/// -------------------------------------------------------
+
+	/**
+	 * @brief Archive handed to entt::snapshot. Splits what entt writes into counts, entities and
+	 * component payload so each component type ends up as contiguous arrays in its block.
+	 */
+	class SnapshotOutputArchive
+	{
+	public:
+		using EntityType = std::underlying_type_t<entt::entity>;
+
+		void operator()(const EntityType value)
+		{
+			if (m_Words.empty())
+			{
+				m_Entities.reserve(value);
+				m_Payload.reserve(static_cast<size_t>(value) * m_ElementSize);
+			}
+			m_Words.push_back(value);
+		}
+
+		void operator()(const entt::entity entity) { m_Entities.push_back(static_cast<EntityType>(entity)); }
+
+		template<typename T>
+		void operator()(const T &component)
+		{
+			if constexpr (SnapshotBitwise_v<T>)
+			{
+				const size_t offset = m_Payload.size();
+				m_Payload.resize(offset + sizeof(T));
+				std::memcpy(m_Payload.data() + offset, &component, sizeof(T));
+			}
+			else
+			{
+				SnapshotWriter writer(m_Payload);
+				SnapshotWrite(writer, component);
+			}
+		}
+
+		void Begin(const uint32_t elementSize)
+		{
+			m_Words.clear();
+			m_Entities.clear();
+			m_Payload.clear();
+			m_ElementSize = elementSize;
+		}
+
+		[[nodiscard]] const std::vector<EntityType> &GetWords() const { return m_Words; }
+		[[nodiscard]] const std::vector<EntityType> &GetEntities() const { return m_Entities; }
+		[[nodiscard]] const std::vector<uint8_t> &GetPayload() const { return m_Payload; }
+
+	private:
+		std::vector<EntityType> m_Words;
+		std::vector<EntityType> m_Entities;
+		std::vector<uint8_t> m_Payload;
+		uint32_t m_ElementSize = 0;
+	};
+
+	/// Archive handed to entt::continuous_loader; serves one block written by SnapshotOutputArchive.
+	class SnapshotInputArchive
+	{
+	public:
+		using EntityType = std::underlying_type_t<entt::entity>;
+
+		SnapshotInputArchive(const std::span<const EntityType> words, const std::span<const EntityType> entities, const SnapshotReader &payload) :
+			m_Words(words), m_Entities(entities), m_Payload(payload)
+		{
+		}
+
+		void operator()(EntityType &value)
+		{
+			if (m_NextWord < m_Words.size())
+				value = m_Words[m_NextWord++];
+			else
+			{
+				value = 0;
+				m_Good = false;
+			}
+		}
+
+		void operator()(entt::entity &entity)
+		{
+			if (m_NextEntity < m_Entities.size())
+				entity = static_cast<entt::entity>(m_Entities[m_NextEntity++]);
+			else
+			{
+				entity = entt::null;
+				m_Good = false;
+			}
+		}
+
+		template<typename T>
+		void operator()(T &component)
+		{
+			if constexpr (SnapshotBitwise_v<T>)
+				m_Payload.Read(&component, sizeof(T));
+			else
+				SnapshotRead(m_Payload, component);
+		}
+
+		/// False if entt asked for more than the block holds or a component failed to decode.
+		[[nodiscard]] bool IsGood() const { return m_Good && m_Payload.IsGood(); }
+
+	private:
+		std::span<const EntityType> m_Words;
+		std::span<const EntityType> m_Entities;
+		SnapshotReader m_Payload;
+		size_t m_NextWord = 0;
+		size_t m_NextEntity = 0;
+		bool m_Good = true;
+	};
+
+	/// -------------------------------------------------------
+
+	/**
+	 * @brief Registry state copied at a frame boundary so it can be encoded on another thread.
+	 *
+	 * Holds plain copies of every registered storage; nothing in it refers back to the registry.
+	 */
+	class RegistrySnapshotStaging
+	{
+	public:
+		struct Block
+		{
+			virtual ~Block() = default;
+			virtual void Encode(SnapshotWriter &writer) const = 0;
+			[[nodiscard]] virtual size_t GetEntityCount() const = 0;
+		};
+
+		[[nodiscard]] bool IsEmpty() const { return m_Blocks.empty(); }
+		[[nodiscard]] size_t GetBlockCount() const { return m_Blocks.size(); }
+
+	private:
+		friend class RegistrySnapshot;
+		std::vector<std::unique_ptr<Block>> m_Blocks;
+	};
+
+	struct RegistrySnapshotLoadOptions
+	{
+		bool regenerateUUIDs = false;	///< Give loaded entities fresh UUIDs and rewrite references between them (paste/import into an open scene)
+	};
+
+	struct RegistrySnapshotLoadResult
+	{
+		bool success = false;
+		std::string error;
+		uint32_t loadedBlocks = 0;
+		uint32_t skippedBlocks = 0;				///< Unknown types or component layouts that changed since the snapshot was written
+		std::vector<entt::entity> entities;		///< Entities created by the load, in the target registry
+		SnapshotUUIDRemap remap;				///< Only filled when regenerateUUIDs is set
+	};
+
+	/**
+	 * @brief Binary registry persistence built on entt snapshot archives.
+	 *
+	 * The file is a short header followed by one block per registered component type. A block
+	 * holds the entity list and the component payload as contiguous arrays; bitwise components are
+	 * stored as raw structs, others through their SnapshotWrite/SnapshotRead hooks. Blocks are
+	 * tagged with a hash of the registered name so unknown or reordered types can be skipped.
+	 *
+	 * Loading goes through entt::continuous_loader, so entity handles in the file are remapped to
+	 * fresh handles in the target registry and the target does not have to be empty.
+	 */
+	class RegistrySnapshot
+	{
+	public:
+		static constexpr uint32_t MAGIC = 0x53584553; ///< "SEXS"
+		static constexpr uint16_t VERSION = 1;
+		static constexpr uint32_t BLOCK_BITWISE = 1u << 0;
+
+		/// Registers a component type under a stable name. Registration order is the block order.
+		template<typename T>
+		void Register(std::string_view name);
+
+		/// Writes every registered component of @p registry through entt::snapshot.
+		void Save(const entt::registry &registry, std::vector<uint8_t> &out) const;
+
+		/**
+		 * @brief Copies the registered storages. Cheap enough to run between frames; the copy can
+		 * then be encoded on a worker while the registry keeps changing.
+		 */
+		[[nodiscard]] RegistrySnapshotStaging Stage(const entt::registry &registry) const;
+
+		/// Encodes staged state into the same format Save() produces. Safe to call on any thread.
+		static void Encode(const RegistrySnapshotStaging &staging, std::vector<uint8_t> &out);
+
+		/// Adds the snapshot's entities to @p registry.
+		RegistrySnapshotLoadResult Load(entt::registry &registry, const uint8_t *data, size_t size, const RegistrySnapshotLoadOptions &options = {}) const;
+
+		[[nodiscard]] size_t GetComponentCount() const { return m_Components.size(); }
+
+		/// FNV-1a hash used as the block type id.
+		static constexpr uint32_t HashName(const std::string_view name)
+		{
+			uint32_t hash = 2166136261u;
+			for (const char c : name)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 16777619u;
+			}
+			return hash;
+		}
+
+	private:
+		using EntityType = std::underlying_type_t<entt::entity>;
+		using EntitySpan = std::span<const entt::entity>;
+
+		struct Component
+		{
+			std::string name;
+			uint32_t typeId = 0;
+			uint32_t flags = 0;
+			uint32_t elementSize = 0;
+
+			void (*save)(const entt::snapshot &, SnapshotOutputArchive &) = nullptr;
+			void (*load)(entt::continuous_loader &, SnapshotInputArchive &) = nullptr;
+			std::unique_ptr<RegistrySnapshotStaging::Block> (*stage)(const entt::registry &, const Component &) = nullptr;
+			void (*assignIdentity)(entt::registry &, EntitySpan, SnapshotUUIDRemap &) = nullptr;
+			void (*remapReferences)(entt::registry &, EntitySpan, const SnapshotUUIDRemap &) = nullptr;
+		};
+
+		template<typename T>
+		struct StagedBlock final : RegistrySnapshotStaging::Block
+		{
+			uint32_t typeId = 0;
+			uint32_t flags = 0;
+			std::vector<EntityType> entities;
+			std::vector<T> components;
+
+			void Encode(SnapshotWriter &writer) const override;
+			[[nodiscard]] size_t GetEntityCount() const override { return entities.size(); }
+		};
+
+		/// Writes a block header followed by its arrays; @p payloadSize is patched afterwards when unknown.
+		static size_t WriteBlockHeader(SnapshotWriter &writer, uint32_t typeId, uint32_t flags, uint32_t elementSize, uint32_t wordCount, uint32_t entityCount, uint64_t payloadSize);
+
+		const Component *FindComponent(uint32_t typeId) const;
+
+		std::vector<Component> m_Components;
+	};
+
+	/// -------------------------------------------------------
+
+	template<typename T>
+	void RegistrySnapshot::Register(const std::string_view name)
+	{
+		static_assert(SnapshotSerializable<T>, "Component needs SnapshotWrite/SnapshotRead overloads or a SnapshotBitwise specialisation");
+		static_assert(std::is_default_constructible_v<T>, "entt::continuous_loader default constructs components before reading them");
+
+		Component component;
+		component.name = name;
+		component.typeId = HashName(name);
+		component.flags = SnapshotBitwise_v<T> ? BLOCK_BITWISE : 0;
+		component.elementSize = SnapshotBitwise_v<T> ? static_cast<uint32_t>(sizeof(T)) : 0;
+
+		component.save = [](const entt::snapshot &snapshot, SnapshotOutputArchive &archive) {
+			snapshot.template get<T>(archive);
+		};
+		component.load = [](entt::continuous_loader &loader, SnapshotInputArchive &archive) {
+			loader.template get<T>(archive);
+		};
+		component.stage = [](const entt::registry &registry, const Component &desc) -> std::unique_ptr<RegistrySnapshotStaging::Block> {
+			auto block = std::make_unique<StagedBlock<T>>();
+			block->typeId = desc.typeId;
+			block->flags = desc.flags;
+
+			const auto view = registry.view<T>();
+			block->entities.reserve(view.size());
+			block->components.reserve(view.size());
+			for (auto [entity, value] : view.each())
+			{
+				block->entities.push_back(static_cast<EntityType>(entity));
+				block->components.push_back(value);
+			}
+			return block;
+		};
+
+		if constexpr (SnapshotHasIdentity<T>)
+		{
+			component.assignIdentity = [](entt::registry &registry, const EntitySpan entities, SnapshotUUIDRemap &remap) {
+				for (const entt::entity entity : entities)
+				{
+					if (T *value = registry.try_get<T>(entity))
+					{
+						UUID &id = SnapshotIdentity(*value);
+						const UUID fresh;
+						remap.Add(id, fresh);
+						id = fresh;
+					}
+				}
+			};
+		}
+
+		if constexpr (SnapshotHasUUIDReferences<T>)
+		{
+			component.remapReferences = [](entt::registry &registry, const EntitySpan entities, const SnapshotUUIDRemap &remap) {
+				for (const entt::entity entity : entities)
+				{
+					if (T *value = registry.try_get<T>(entity))
+						SnapshotRemapUUIDs(*value, remap);
+				}
+			};
+		}
+
+		m_Components.push_back(std::move(component));
+	}
+
+	template<typename T>
+	void RegistrySnapshot::StagedBlock<T>::Encode(SnapshotWriter &writer) const
+	{
+		const auto count = static_cast<EntityType>(entities.size());
+		const uint32_t elementSize = SnapshotBitwise_v<T> ? static_cast<uint32_t>(sizeof(T)) : 0;
+		const uint64_t payloadSize = SnapshotBitwise_v<T> ? static_cast<uint64_t>(components.size()) * sizeof(T) : 0;
+
+		const size_t sizeOffset = WriteBlockHeader(writer, typeId, flags, elementSize, 1, count, payloadSize);
+		writer.Write(count);
+		writer.Write(entities.data(), entities.size() * sizeof(EntityType));
+
+		if constexpr (SnapshotBitwise_v<T>)
+		{
+			/// The staged copy is already one contiguous array in the on-disk layout.
+			writer.Write(components.data(), components.size() * sizeof(T));
+		}
+		else
+		{
+			const size_t begin = writer.GetSize();
+			for (const T &component : components)
+				SnapshotWrite(writer, component);
+			writer.Patch(sizeOffset, static_cast<uint64_t>(writer.GetSize() - begin));
+		}
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -11,6 +11,7 @@
 * -------------------------------------------------------
 */
 #include "scene.h"
+#include "scene_snapshot.h"
 
 /// -------------------------------------------------------
 
@@ -111,6 +112,69 @@ namespace SceneryEditorX
     {
     }
 
+    Entity Scene::GetEntityWithUUID(const UUID id) const
+    {
+        SEDX_CORE_VERIFY(m_EntityIDMap.contains(id), "Invalid entity ID or entity doesn't exist in the current scene!");
+        return m_EntityIDMap.at(id);
+    }
+
+    Entity Scene::TryGetEntityWithUUID(const UUID id) const
+    {
+        if (const auto it = m_EntityIDMap.find(id); it != m_EntityIDMap.end())
+            return it->second;
+        return Entity{};
+    }
+
+    void Scene::SaveSnapshot(std::vector<uint8_t> &out) const
+    {
+        GetSceneSnapshotSchema().Save(m_Registry, out);
+    }
+
+    RegistrySnapshotStaging Scene::StageSnapshot() const
+    {
+        return GetSceneSnapshotSchema().Stage(m_Registry);
+    }
+
+    bool Scene::LoadSnapshot(const uint8_t *data, const size_t size, const RegistrySnapshotLoadOptions &options)
+    {
+        const RegistrySnapshot &schema = GetSceneSnapshotSchema();
+
+        RegistrySnapshotLoadResult result;
+        if (options.regenerateUUIDs)
+        {
+            /// Merge: loaded entities get fresh UUIDs, so they cannot collide with the ones already here.
+            result = schema.Load(m_Registry, data, size, options);
+        }
+        else
+        {
+            /// Replace: build the new registry on the side so a bad file leaves the scene untouched.
+            entt::registry registry;
+            result = schema.Load(registry, data, size, options);
+            if (result.success)
+            {
+                m_Registry = std::move(registry);
+                m_EntityIDMap.clear();
+                m_SceneEntity = entt::null;
+            }
+        }
+
+        if (!result.success)
+        {
+            SEDX_CORE_ERROR_TAG("Scene", "Failed to load snapshot into scene '{}': {}", m_Name, result.error);
+            return false;
+        }
+
+        if (result.skippedBlocks)
+            SEDX_CORE_WARN_TAG("Scene", "Snapshot for scene '{}' had {} component blocks this build cannot read", m_Name, result.skippedBlocks);
+
+        for (const entt::entity handle : result.entities)
+        {
+            if (const auto *id = m_Registry.try_get<IDComponent>(handle))
+                m_EntityIDMap[id->ID] = Entity(handle, this);
+        }
+        return true;
+    }
+
 
 
 }
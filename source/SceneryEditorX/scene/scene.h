@@ -14,6 +14,7 @@
 #include <entt/src/entt/entt.hpp>
 #include "camera.h"
 #include "entity.h"
+#include "registry_snapshot.h"
 #include "SceneryEditorX/asset/asset.h"
 #include "SceneryEditorX/asset/asset_types.h"
 #include "SceneryEditorX/renderer/texture.h"
@@ -37,6 +38,8 @@ namespace SceneryEditorX
 
 	};
 
+    using EntityMap = std::unordered_map<UUID, Entity>;
+
     class Scene : public Asset
     {
     public:
@@ -63,7 +66,7 @@ namespace SceneryEditorX
         uint32_t GetViewportWidth() const { return m_ViewportRight - m_ViewportLeft; }
 		uint32_t GetViewportHeight() const { return m_ViewportBottom - m_ViewportTop; }
 		
-		//const EntityMap& GetEntityMap() const { return m_EntityIDMap; }
+		const EntityMap& GetEntityMap() const { return m_EntityIDMap; }
 		std::pair<std::unordered_set<AssetHandle>, std::unordered_set<AssetHandle>> GetAssetList(); // returns assetList, missingAssetList
 
         template<typename... Components>
@@ -116,6 +119,21 @@ namespace SceneryEditorX
 
 		void CopyTo(Ref<Scene>& target);
 
+		/// Binary snapshot of every component in GetSceneSnapshotSchema(); see scene_snapshot.h
+		void SaveSnapshot(std::vector<uint8_t>& out) const;
+
+		/// Copy of the component storages for encoding on another thread (autosave)
+		RegistrySnapshotStaging StageSnapshot() const;
+
+		/**
+		 * @brief Restores a snapshot written by SaveSnapshot().
+		 *
+		 * Replaces the scene's entities unless @p options.regenerateUUIDs is set, in which case the
+		 * snapshot is added to the scene with fresh UUIDs. On failure the scene is left unchanged
+		 * when replacing.
+		 */
+		bool LoadSnapshot(const uint8_t* data, size_t size, const RegistrySnapshotLoadOptions& options = {});
+
         /**
          * @brief Copies a component from the source entity to the destination entity if it exists.
          *
@@ -176,7 +194,7 @@ namespace SceneryEditorX
         uint32_t m_ViewportRight = 0;
         uint32_t m_ViewportBottom = 0;
 
-        //EntityMap m_EntityIDMap;
+        EntityMap m_EntityIDMap;
         //DirectionalLight m_Light;
         float m_LightMultiplier = 0.3f;
         //LightEnvironment m_LightEnvironment;
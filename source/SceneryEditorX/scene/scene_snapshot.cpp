@@ -0,0 +1,336 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* scene_snapshot.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "scene_snapshot.h"
+#include <chrono>
+#include <fstream>
+#include "scene.h"
+#include "SceneryEditorX/core/threading/thread_pool.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	namespace
+	{
+		void WriteMaterialTable(SnapshotWriter &writer, const Ref<MaterialTable> &table)
+		{
+			const auto &materials = table->GetMaterials();
+			writer.Write(table->GetMaterialCount());
+			writer.Write(static_cast<uint32_t>(materials.size()));
+			for (const auto &[index, material] : materials)
+			{
+				writer.Write(index);
+				writer.Write(material);
+			}
+		}
+
+		Ref<MaterialTable> ReadMaterialTable(SnapshotReader &reader)
+		{
+			uint32_t materialCount = 0;
+			uint32_t entries = 0;
+			reader.Read(materialCount);
+			reader.Read(entries);
+
+			Ref<MaterialTable> table = CreateRef<MaterialTable>(materialCount);
+			for (uint32_t i = 0; i < entries && reader.IsGood(); ++i)
+			{
+				uint32_t index = 0;
+				AssetHandle material;
+				reader.Read(index);
+				reader.Read(material);
+				if (reader.IsGood())
+					table->SetMaterial(index, material);
+			}
+			return table;
+		}
+
+		double MillisecondsSince(const std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	UUID &SnapshotIdentity(IDComponent &component)
+	{
+		return component.ID;
+	}
+
+	void SnapshotRemapUUIDs(MeshTagComponent &component, const SnapshotUUIDRemap &remap)
+	{
+		component.MeshEntity = remap(component.MeshEntity);
+	}
+
+	void SnapshotWrite(SnapshotWriter &writer, const TagComponent &component)
+	{
+		writer.WriteString(component.Tag);
+	}
+
+	void SnapshotRead(SnapshotReader &reader, TagComponent &component)
+	{
+		reader.ReadString(component.Tag);
+	}
+
+	void SnapshotWrite(SnapshotWriter &writer, const RelationshipComponent &component)
+	{
+		writer.Write(component.ParentHandle);
+		writer.WriteVector(component.Children);
+	}
+
+	void SnapshotRead(SnapshotReader &reader, RelationshipComponent &component)
+	{
+		reader.Read(component.ParentHandle);
+		reader.ReadVector(component.Children);
+	}
+
+	void SnapshotRemapUUIDs(RelationshipComponent &component, const SnapshotUUIDRemap &remap)
+	{
+		component.ParentHandle = remap(component.ParentHandle);
+		for (UUID &child : component.Children)
+			child = remap(child);
+	}
+
+	void SnapshotWrite(SnapshotWriter &writer, const SubmeshComponent &component)
+	{
+		writer.Write(component.Mesh);
+		WriteMaterialTable(writer, component.MaterialTable);
+		writer.WriteVector(component.BoneEntityIds);
+		writer.Write(component.SubmeshIndex);
+		writer.Write(component.Visible);
+	}
+
+	void SnapshotRead(SnapshotReader &reader, SubmeshComponent &component)
+	{
+		reader.Read(component.Mesh);
+		component.MaterialTable = ReadMaterialTable(reader);
+		reader.ReadVector(component.BoneEntityIds);
+		reader.Read(component.SubmeshIndex);
+		reader.Read(component.Visible);
+	}
+
+	void SnapshotRemapUUIDs(SubmeshComponent &component, const SnapshotUUIDRemap &remap)
+	{
+		for (UUID &bone : component.BoneEntityIds)
+			bone = remap(bone);
+	}
+
+	void SnapshotWrite(SnapshotWriter &writer, const StaticMeshComponent &component)
+	{
+		writer.Write(component.StaticMesh);
+		WriteMaterialTable(writer, component.MaterialTable);
+		writer.Write(component.Visible);
+	}
+
+	void SnapshotRead(SnapshotReader &reader, StaticMeshComponent &component)
+	{
+		reader.Read(component.StaticMesh);
+		component.MaterialTable = ReadMaterialTable(reader);
+		reader.Read(component.Visible);
+	}
+
+	void SnapshotWrite(SnapshotWriter &writer, const TextComponent &component)
+	{
+		writer.WriteString(component.TextString);
+		writer.Write(static_cast<uint64_t>(component.TextHash));
+		writer.Write(component.FontHandle);
+		writer.Write(component.Color);
+		writer.Write(component.LineSpacing);
+		writer.Write(component.Kerning);
+		writer.Write(component.MaxWidth);
+		writer.Write(component.ScreenSpace);
+		writer.Write(component.DropShadow);
+		writer.Write(component.ShadowDistance);
+		writer.Write(component.ShadowColor);
+	}
+
+	void SnapshotRead(SnapshotReader &reader, TextComponent &component)
+	{
+		uint64_t textHash = 0;
+		reader.ReadString(component.TextString);
+		reader.Read(textHash);
+		component.TextHash = static_cast<size_t>(textHash);
+		reader.Read(component.FontHandle);
+		reader.Read(component.Color);
+		reader.Read(component.LineSpacing);
+		reader.Read(component.Kerning);
+		reader.Read(component.MaxWidth);
+		reader.Read(component.ScreenSpace);
+		reader.Read(component.DropShadow);
+		reader.Read(component.ShadowDistance);
+		reader.Read(component.ShadowColor);
+	}
+
+	void SnapshotWrite(SnapshotWriter &writer, const TileRendererComponent &component)
+	{
+		writer.Write(component.StaticMesh);
+		writer.Write(component.Width);
+		writer.Write(component.Height);
+		writer.Write(static_cast<uint32_t>(component.Materials.size()));
+		for (const Ref<MaterialTable> &table : component.Materials)
+			WriteMaterialTable(writer, table);
+		writer.WriteVector(component.MaterialIDs);
+	}
+
+	void SnapshotRead(SnapshotReader &reader, TileRendererComponent &component)
+	{
+		uint32_t tableCount = 0;
+		reader.Read(component.StaticMesh);
+		reader.Read(component.Width);
+		reader.Read(component.Height);
+		reader.Read(tableCount);
+
+		component.Materials.clear();
+		for (uint32_t i = 0; i < tableCount && reader.IsGood(); ++i)
+			component.Materials.push_back(ReadMaterialTable(reader));
+		reader.ReadVector(component.MaterialIDs);
+	}
+
+	/// -------------------------------------------------------
+
+	const RegistrySnapshot &GetSceneSnapshotSchema()
+	{
+		/// Names are part of the file format; rename a component type freely but keep its string.
+		static const RegistrySnapshot schema = [] {
+			RegistrySnapshot snapshot;
+			snapshot.Register<IDComponent>("IDComponent");
+			snapshot.Register<TagComponent>("TagComponent");
+			snapshot.Register<RelationshipComponent>("RelationshipComponent");
+			snapshot.Register<PrefabComponent>("PrefabComponent");
+			snapshot.Register<TransformComponent>("TransformComponent");
+			snapshot.Register<MeshComponent>("MeshComponent");
+			snapshot.Register<MeshTagComponent>("MeshTagComponent");
+			snapshot.Register<SubmeshComponent>("SubmeshComponent");
+			snapshot.Register<StaticMeshComponent>("StaticMeshComponent");
+			snapshot.Register<SpriteRendererComponent>("SpriteRendererComponent");
+			snapshot.Register<TextComponent>("TextComponent");
+			snapshot.Register<DirectionalLightComponent>("DirectionalLightComponent");
+			snapshot.Register<PointLightComponent>("PointLightComponent");
+			snapshot.Register<SpotLightComponent>("SpotLightComponent");
+			snapshot.Register<SkyLightComponent>("SkyLightComponent");
+			snapshot.Register<TileRendererComponent>("TileRendererComponent");
+			return snapshot;
+		}();
+		return schema;
+	}
+
+	bool WriteSnapshotFile(const std::filesystem::path &path, const std::vector<uint8_t> &data)
+	{
+		std::filesystem::path temp = path;
+		temp += ".tmp";
+		{
+			std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+			if (!file)
+				return false;
+			file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+			if (!file.flush())
+				return false;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temp, path, error);
+		if (error)
+		{
+			std::filesystem::remove(temp, error);
+			return false;
+		}
+		return true;
+	}
+
+	bool ReadSnapshotFile(const std::filesystem::path &path, std::vector<uint8_t> &data)
+	{
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file)
+			return false;
+
+		const std::streamsize size = file.tellg();
+		if (size < 0)
+			return false;
+
+		data.resize(static_cast<size_t>(size));
+		file.seekg(0);
+		return static_cast<bool>(file.read(reinterpret_cast<char *>(data.data()), size));
+	}
+
+	/// -------------------------------------------------------
+
+	SceneAutosave::SceneAutosave(ThreadPool *pool) : m_Pool(pool)
+	{
+	}
+
+	SceneAutosave::~SceneAutosave()
+	{
+		Wait();
+	}
+
+	bool SceneAutosave::Begin(const Scene &scene, const std::filesystem::path &path)
+	{
+		if (IsBusy())
+		{
+			std::lock_guard lock(m_StatsMutex);
+			++m_Stats.skipped;
+			return false;
+		}
+		if (m_Pending.valid())
+			m_Pending.get();
+
+		const auto stageStart = std::chrono::steady_clock::now();
+		auto staging = std::make_shared<RegistrySnapshotStaging>(scene.StageSnapshot());
+		const double stageMs = MillisecondsSince(stageStart);
+
+		ThreadPool &pool = m_Pool ? *m_Pool : ThreadPool::Get();
+		m_Pending = pool.Submit([this, staging, path, stageMs]() {
+			const auto encodeStart = std::chrono::steady_clock::now();
+			std::vector<uint8_t> data;
+			RegistrySnapshot::Encode(*staging, data);
+			const double encodeMs = MillisecondsSince(encodeStart);
+
+			const auto writeStart = std::chrono::steady_clock::now();
+			const bool written = WriteSnapshotFile(path, data);
+			const double writeMs = MillisecondsSince(writeStart);
+
+			std::lock_guard lock(m_StatsMutex);
+			if (written)
+				++m_Stats.saves;
+			else
+				++m_Stats.failures;
+			m_Stats.lastBytes = data.size();
+			m_Stats.lastStageMs = stageMs;
+			m_Stats.lastEncodeMs = encodeMs;
+			m_Stats.lastWriteMs = writeMs;
+			return written;
+		});
+		return true;
+	}
+
+	bool SceneAutosave::IsBusy() const
+	{
+		return m_Pending.valid() && m_Pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+	}
+
+	bool SceneAutosave::Wait()
+	{
+		if (!m_Pending.valid())
+			return true;
+		return m_Pending.get();
+	}
+
+	SceneAutosaveStats SceneAutosave::GetStats() const
+	{
+		std::lock_guard lock(m_StatsMutex);
+		return m_Stats;
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,120 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* scene_snapshot.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include "components.h"
+#include "registry_snapshot.h"
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	class Scene;
+	class ThreadPool;
+
+	/// Plain data components, stored as raw structs in scene snapshots.
+	template<> struct SnapshotBitwise<IDComponent> : std::true_type {};
+	template<> struct SnapshotBitwise<PrefabComponent> : std::true_type {};
+	template<> struct SnapshotBitwise<TransformComponent> : std::true_type {};
+	template<> struct SnapshotBitwise<MeshComponent> : std::true_type {};
+	template<> struct SnapshotBitwise<MeshTagComponent> : std::true_type {};
+	template<> struct SnapshotBitwise<SpriteRendererComponent> : std::true_type {};
+	template<> struct SnapshotBitwise<DirectionalLightComponent> : std::true_type {};
+	template<> struct SnapshotBitwise<PointLightComponent> : std::true_type {};
+	template<> struct SnapshotBitwise<SpotLightComponent> : std::true_type {};
+	template<> struct SnapshotBitwise<SkyLightComponent> : std::true_type {};
+
+	/// Snapshot hooks for scene components that own heap data or refer to other entities.
+	UUID &SnapshotIdentity(IDComponent &component);
+	void SnapshotRemapUUIDs(MeshTagComponent &component, const SnapshotUUIDRemap &remap);
+
+	void SnapshotWrite(SnapshotWriter &writer, const TagComponent &component);
+	void SnapshotRead(SnapshotReader &reader, TagComponent &component);
+
+	void SnapshotWrite(SnapshotWriter &writer, const RelationshipComponent &component);
+	void SnapshotRead(SnapshotReader &reader, RelationshipComponent &component);
+	void SnapshotRemapUUIDs(RelationshipComponent &component, const SnapshotUUIDRemap &remap);
+
+	void SnapshotWrite(SnapshotWriter &writer, const SubmeshComponent &component);
+	void SnapshotRead(SnapshotReader &reader, SubmeshComponent &component);
+	void SnapshotRemapUUIDs(SubmeshComponent &component, const SnapshotUUIDRemap &remap);
+
+	void SnapshotWrite(SnapshotWriter &writer, const StaticMeshComponent &component);
+	void SnapshotRead(SnapshotReader &reader, StaticMeshComponent &component);
+
+	void SnapshotWrite(SnapshotWriter &writer, const TextComponent &component);
+	void SnapshotRead(SnapshotReader &reader, TextComponent &component);
+
+	void SnapshotWrite(SnapshotWriter &writer, const TileRendererComponent &component);
+	void SnapshotRead(SnapshotReader &reader, TileRendererComponent &component);
+
+	/// Component types stored in scene snapshots, in block order.
+	const RegistrySnapshot &GetSceneSnapshotSchema();
+
+	/// Writes through a temporary file and renames it over @p path, so a crash never leaves a half written snapshot.
+	bool WriteSnapshotFile(const std::filesystem::path &path, const std::vector<uint8_t> &data);
+	bool ReadSnapshotFile(const std::filesystem::path &path, std::vector<uint8_t> &data);
+
+	/// -------------------------------------------------------
+
+	struct SceneAutosaveStats
+	{
+		uint64_t saves = 0;
+		uint64_t failures = 0;
+		uint64_t skipped = 0;			///< Requests made while the previous save was still running
+		uint64_t lastBytes = 0;
+		double lastStageMs = 0.0;		///< Main thread cost: copying the registry at the frame boundary
+		double lastEncodeMs = 0.0;		///< Worker cost: encoding the snapshot
+		double lastWriteMs = 0.0;		///< Worker cost: writing the file
+	};
+
+	/**
+	 * @brief Saves scene snapshots without stalling the frame.
+	 *
+	 * Begin() copies the component storages on the calling thread, between frames, and hands the
+	 * copy to a worker that encodes and writes it. The scene can be edited as soon as Begin() returns.
+	 */
+	class SceneAutosave
+	{
+	public:
+		explicit SceneAutosave(ThreadPool *pool = nullptr);
+		~SceneAutosave();
+
+		SceneAutosave(const SceneAutosave &) = delete;
+		SceneAutosave &operator=(const SceneAutosave &) = delete;
+
+		/**
+		 * @brief Starts a background save of @p scene to @p path.
+		 * @return false if the previous save is still running; nothing is copied in that case.
+		 */
+		bool Begin(const Scene &scene, const std::filesystem::path &path);
+
+		[[nodiscard]] bool IsBusy() const;
+
+		/// Blocks until the running save is done. Returns its result, or true if nothing was running.
+		bool Wait();
+
+		[[nodiscard]] SceneAutosaveStats GetStats() const;
+
+	private:
+		ThreadPool *m_Pool;
+		std::future<bool> m_Pending;
+		mutable std::mutex m_StatsMutex;
+		SceneAutosaveStats m_Stats;
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -21,6 +21,8 @@ namespace SceneryEditorX::UI
 	bool showExitModal = false;
 	bool showAboutModal = false;
 	bool showSettingsPanel = false;
+	bool showExportDSFModal = false;
+	std::function<bool(DSFOverlay &overlay)> dsfOverlaySource;
 
     /// -------------------------------------------------------
 
@@ -11,6 +11,7 @@
 * -------------------------------------------------------
 */
 #pragma once
+#include <functional>
 #include <GLFW/glfw3.h>
 #include <Math/includes/xmath.hpp>
 #include "colors.h"
@@ -21,6 +22,11 @@
 
 /// -------------------------------------------------------
 
+namespace SceneryEditorX
+{
+    struct DSFOverlay;
+}
+
 namespace SceneryEditorX::UI
 {
     extern bool showViewport;
@@ -28,6 +34,11 @@ namespace SceneryEditorX::UI
     extern bool showExitModal;
     extern bool showAboutModal;
     extern bool showSettingsPanel;
+    extern bool showExportDSFModal;
+
+    /// Fills an overlay tile with the placements of the open project; returns false if there is nothing to export.
+    /// Nothing installs it yet, so the "Export '.dsf'" menu item stays disabled while it is empty.
+    extern std::function<bool(DSFOverlay &overlay)> dsfOverlaySource;
 
     /// -------------------------------------------------------
 
@@ -47,6 +58,7 @@ namespace SceneryEditorX::UI
 		GLOBAL void CreateProjectModal(GLFWwindow *window);
 		GLOBAL void ExitConfirmationModal(GLFWwindow *window);
 		GLOBAL void AboutModal();
+		GLOBAL void ExportDSFModal();
 		GLOBAL void ViewportWindow(iVec2& viewportSize, bool& viewportHovered, VkImageView imageView);
 
 		/// -------------------------------------------------------
@@ -0,0 +1,157 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* mapped_file.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "mapped_file.h"
+#include <utility>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	MappedFile::MappedFile(const std::filesystem::path &path)
+	{
+		Open(path);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile &&other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		Close();
+		m_Path = std::move(other.m_Path);
+		m_Data = std::exchange(other.m_Data, nullptr);
+		m_Size = std::exchange(other.m_Size, 0);
+		m_Open = std::exchange(other.m_Open, false);
+	#ifdef _WIN32
+		m_File = std::exchange(other.m_File, nullptr);
+		m_Mapping = std::exchange(other.m_Mapping, nullptr);
+	#endif
+		return *this;
+	}
+
+	bool MappedFile::Open(const std::filesystem::path &path)
+	{
+		Close();
+
+	#ifdef _WIN32
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size))
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		m_File = file;
+		m_Size = static_cast<size_t>(size.QuadPart);
+		if (m_Size)
+		{
+			/// Zero sized files cannot be mapped on Windows.
+			m_Mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!m_Mapping)
+			{
+				Close();
+				return false;
+			}
+			m_Data = static_cast<const uint8_t *>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+			if (!m_Data)
+			{
+				Close();
+				return false;
+			}
+		}
+	#else
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat info {};
+		if (::fstat(fd, &info) != 0)
+		{
+			::close(fd);
+			return false;
+		}
+
+		m_Size = static_cast<size_t>(info.st_size);
+		if (m_Size)
+		{
+			void *data = ::mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data == MAP_FAILED)
+			{
+				::close(fd);
+				m_Size = 0;
+				return false;
+			}
+			::madvise(data, m_Size, MADV_SEQUENTIAL);
+			m_Data = static_cast<const uint8_t *>(data);
+		}
+
+		/// The mapping keeps its own reference to the file.
+		::close(fd);
+	#endif
+
+		m_Path = path;
+		m_Open = true;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+	#ifdef _WIN32
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_Mapping)
+			CloseHandle(m_Mapping);
+		if (m_File)
+			CloseHandle(m_File);
+		m_Mapping = nullptr;
+		m_File = nullptr;
+	#else
+		if (m_Data)
+			::munmap(const_cast<uint8_t *>(m_Data), m_Size);
+	#endif
+		m_Data = nullptr;
+		m_Size = 0;
+		m_Open = false;
+		m_Path.clear();
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,66 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* mapped_file.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX
+{
+	/**
+	 * @brief Read-only memory mapping of a whole file.
+	 *
+	 * Pages are faulted in by the OS as they are touched, so large scenery files can be
+	 * parsed in place without a read into a heap buffer. The mapping stays valid until
+	 * Close() or destruction; pointers from GetData() must not outlive it.
+	 */
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::filesystem::path &path);
+		~MappedFile();
+
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator=(const MappedFile &) = delete;
+		MappedFile(MappedFile &&other) noexcept;
+		MappedFile &operator=(MappedFile &&other) noexcept;
+
+		/**
+		 * @brief Maps @p path, closing any previous mapping first.
+		 * @return false if the file cannot be opened or mapped. Empty files open successfully with a null data pointer.
+		 */
+		bool Open(const std::filesystem::path &path);
+		void Close();
+
+		[[nodiscard]] bool IsOpen() const { return m_Open; }
+		[[nodiscard]] const uint8_t *GetData() const { return m_Data; }
+		[[nodiscard]] size_t GetSize() const { return m_Size; }
+		[[nodiscard]] const std::filesystem::path &GetPath() const { return m_Path; }
+
+	private:
+		std::filesystem::path m_Path;
+		const uint8_t *m_Data = nullptr;
+		size_t m_Size = 0;
+		bool m_Open = false;
+	#ifdef _WIN32
+		void *m_File = nullptr;
+		void *m_Mapping = nullptr;
+	#endif
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,343 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* AssetReloadMonitorTest.cpp
+* -------------------------------------------------------
+* Tests for the file watcher and debounced asset reloads
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SceneryEditorX/asset/managers/asset_reload_monitor.h>
+#include <SceneryEditorX/platform/filesystem/file_watcher.h>
+
+/// -------------------------------------------------------
+
+using namespace SceneryEditorX;
+
+namespace SceneryEditorX::Tests
+{
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+		using namespace std::chrono_literals;
+
+		/// Fresh directory below the system temp directory, removed again on destruction.
+		struct TempDirectory
+		{
+			std::filesystem::path Path;
+
+			TempDirectory()
+			{
+				Path = std::filesystem::temp_directory_path() / ("sedx_watch_" + std::to_string(static_cast<uint64_t>(UUID())));
+				std::filesystem::create_directories(Path);
+			}
+
+			~TempDirectory()
+			{
+				std::error_code ec;
+				std::filesystem::remove_all(Path, ec);
+			}
+		};
+
+		void WriteFile(const std::filesystem::path &path, const std::string &contents)
+		{
+			std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+			stream << contents;
+		}
+
+		/// Polls until an event of @p type for @p path arrives or @p timeout passes.
+		bool WaitForEvent(FileWatcher &watcher, const std::filesystem::path &path, const FileChangeType type,
+		                  const std::chrono::milliseconds timeout = 2000ms)
+		{
+			const std::filesystem::path expected = std::filesystem::absolute(path).lexically_normal();
+			const Clock::time_point deadline = Clock::now() + timeout;
+			std::vector<FileChangeEvent> events;
+			while (Clock::now() < deadline)
+			{
+				events.clear();
+				watcher.Poll(events, 20ms);
+				for (const FileChangeEvent &event : events)
+				{
+					if (event.Path == expected && event.Type == type)
+						return true;
+				}
+			}
+			return false;
+		}
+
+		/// Runs Update() until nothing is pending and at least @p expected requests arrived, then one debounce longer.
+		std::vector<AssetReloadRequest> CollectReloads(AssetReloadMonitor &monitor, const size_t expected,
+		                                               const std::chrono::milliseconds timeout = 2000ms)
+		{
+			std::vector<AssetReloadRequest> requests;
+			const Clock::time_point deadline = Clock::now() + timeout;
+			while (Clock::now() < deadline && (requests.size() < expected || monitor.HasPendingChanges()))
+				monitor.Update(requests, 10ms);
+
+			// Anything that still trickles in afterwards would be a duplicate reload
+			const Clock::time_point settle = Clock::now() + 150ms;
+			while (Clock::now() < settle)
+				monitor.Update(requests, 10ms);
+			return requests;
+		}
+
+		bool Contains(const std::vector<AssetReloadRequest> &requests, const AssetHandle &handle, const AssetReloadReason reason)
+		{
+			return std::ranges::any_of(requests, [&](const AssetReloadRequest &request)
+			{
+				return request.Handle == handle && request.Reason == reason;
+			});
+		}
+
+		size_t IndexOf(const std::vector<AssetReloadRequest> &requests, const AssetHandle &handle)
+		{
+			const auto it = std::ranges::find_if(requests, [&](const AssetReloadRequest &request) { return request.Handle == handle; });
+			return static_cast<size_t>(it - requests.begin());
+		}
+
+		/// Shared by the native and polling backends, which must report the same changes.
+		void CheckWatcherReportsChanges(std::unique_ptr<FileWatcher> watcher)
+		{
+			TempDirectory temp;
+			const std::filesystem::path existing = temp.Path / "existing.obj";
+			WriteFile(existing, "A");
+
+			INFO("Backend: " << watcher->GetBackendName());
+			REQUIRE(watcher->AddDirectory(temp.Path));
+			REQUIRE_FALSE(watcher->AddDirectory(temp.Path / "missing"));
+
+			// Existing files are not reported just for being there
+			std::vector<FileChangeEvent> events;
+			watcher->Poll(events, 50ms);
+			REQUIRE(events.empty());
+
+			SECTION("Added, modified and removed files")
+			{
+				const std::filesystem::path added = temp.Path / "added.png";
+				WriteFile(added, "new");
+				REQUIRE(WaitForEvent(*watcher, added, FileChangeType::Added));
+
+				WriteFile(existing, "changed contents");
+				REQUIRE(WaitForEvent(*watcher, existing, FileChangeType::Modified));
+
+				std::filesystem::remove(existing);
+				REQUIRE(WaitForEvent(*watcher, existing, FileChangeType::Removed));
+			}
+
+			SECTION("Directories created later are watched too")
+			{
+				const std::filesystem::path nested = temp.Path / "objects" / "trees";
+				std::filesystem::create_directories(nested);
+				WriteFile(nested / "oak.obj", "oak");
+				REQUIRE(WaitForEvent(*watcher, nested / "oak.obj", FileChangeType::Added));
+
+				WriteFile(nested / "oak.obj", "bigger oak");
+				REQUIRE(WaitForEvent(*watcher, nested / "oak.obj", FileChangeType::Modified));
+			}
+
+			SECTION("Removed directories are no longer reported")
+			{
+				watcher->RemoveDirectory(temp.Path);
+				WriteFile(existing, "changed after removal");
+				REQUIRE_FALSE(WaitForEvent(*watcher, existing, FileChangeType::Modified, 200ms));
+			}
+		}
+	}
+
+	/// -------------------------------------------------------
+
+	TEST_CASE("Native FileWatcher reports file changes", "[asset][watcher]")
+	{
+		CheckWatcherReportsChanges(FileWatcher::Create());
+	}
+
+	TEST_CASE("Polling FileWatcher reports file changes", "[asset][watcher]")
+	{
+		CheckWatcherReportsChanges(FileWatcher::CreatePolling(20ms));
+	}
+
+	TEST_CASE("AssetReloadMonitor maps paths to assets", "[asset][watcher]")
+	{
+		AssetReloadMonitor monitor(FileWatcher::CreatePolling(20ms));
+		const AssetHandle texture(11);
+		const AssetHandle mesh(12);
+
+		monitor.TrackAsset(texture, "textures/../textures/ground.png");
+		monitor.TrackAsset(mesh, "objects/hangar.obj");
+		REQUIRE(monitor.FindAsset("textures/ground.png") == texture);
+		REQUIRE(monitor.FindAsset(std::filesystem::absolute("objects/hangar.obj")) == mesh);
+		REQUIRE(monitor.FindAsset("objects/other.obj") == AssetHandle(0));
+
+		// Moving an asset drops its old path
+		monitor.TrackAsset(mesh, "objects/hangar_v2.obj");
+		REQUIRE(monitor.FindAsset("objects/hangar.obj") == AssetHandle(0));
+		REQUIRE(monitor.FindAsset("objects/hangar_v2.obj") == mesh);
+		REQUIRE(monitor.GetTrackedAssetCount() == 2);
+
+		monitor.UntrackAsset(texture);
+		REQUIRE(monitor.FindAsset("textures/ground.png") == AssetHandle(0));
+		REQUIRE(monitor.GetTrackedAssetCount() == 1);
+	}
+
+	TEST_CASE("AssetReloadMonitor reloads changed assets and their dependents", "[asset][watcher]")
+	{
+		TempDirectory temp;
+		std::filesystem::create_directories(temp.Path / "textures");
+		const std::filesystem::path texturePath = temp.Path / "textures" / "hangar.png";
+		const std::filesystem::path materialPath = temp.Path / "hangar.mat";
+		const std::filesystem::path meshPath = temp.Path / "hangar.obj";
+		const std::filesystem::path otherPath = temp.Path / "tower.obj";
+		WriteFile(texturePath, "texture");
+		WriteFile(materialPath, "material");
+		WriteFile(meshPath, "mesh");
+		WriteFile(otherPath, "tower");
+
+		const AssetHandle texture(1);
+		const AssetHandle material(2);
+		const AssetHandle mesh(3);
+		const AssetHandle other(4);
+
+		AssetReloadMonitor monitor(FileWatcher::Create(), 50ms);
+		REQUIRE(monitor.WatchDirectory(temp.Path));
+		monitor.TrackAsset(texture, texturePath);
+		monitor.TrackAsset(material, materialPath);
+		monitor.TrackAsset(mesh, meshPath);
+		monitor.TrackAsset(other, otherPath);
+
+		// mesh -> material -> texture, and the mesh also uses the texture directly
+		monitor.RegisterDependency(texture, material);
+		monitor.RegisterDependency(material, mesh);
+		monitor.RegisterDependency(texture, mesh);
+
+		SECTION("A burst of writes reloads the asset once, followed by its dependents")
+		{
+			for (int i = 0; i < 20; ++i)
+			{
+				WriteFile(texturePath, std::string(100 + i, 'x'));
+				std::this_thread::sleep_for(2ms);
+			}
+
+			const auto requests = CollectReloads(monitor, 3);
+			REQUIRE(requests.size() == 3);
+			REQUIRE(requests[0].Handle == texture);
+			REQUIRE(requests[0].Reason == AssetReloadReason::FileChanged);
+			REQUIRE(Contains(requests, material, AssetReloadReason::Dependency));
+			REQUIRE(Contains(requests, mesh, AssetReloadReason::Dependency));
+			REQUIRE_FALSE(Contains(requests, other, AssetReloadReason::FileChanged));
+			REQUIRE(monitor.GetStats().coalescedEvents > 0);
+			REQUIRE(monitor.GetStats().dependentReloads == 2);
+		}
+
+		SECTION("Only the dependents of the changed asset are queued")
+		{
+			WriteFile(materialPath, "material v2");
+			const auto requests = CollectReloads(monitor, 2);
+			REQUIRE(requests.size() == 2);
+			REQUIRE(requests[0].Handle == material);
+			REQUIRE(requests[1].Handle == mesh);
+			REQUIRE(IndexOf(requests, texture) == requests.size());
+		}
+
+		SECTION("Saving through a temporary file and a rename counts as a change")
+		{
+			const std::filesystem::path staging = temp.Path / "hangar.obj.tmp";
+			WriteFile(staging, "mesh v2");
+			std::filesystem::rename(staging, meshPath);
+
+			const auto requests = CollectReloads(monitor, 1);
+			REQUIRE(requests.size() == 1);
+			REQUIRE(requests[0].Handle == mesh);
+			REQUIRE(requests[0].Reason == AssetReloadReason::FileChanged);
+			REQUIRE(monitor.GetStats().unindexedChanges == 1);
+		}
+
+		SECTION("Removed files are reported as such and still reload dependents")
+		{
+			std::filesystem::remove(materialPath);
+			const auto requests = CollectReloads(monitor, 2);
+			REQUIRE(requests.size() == 2);
+			REQUIRE(Contains(requests, material, AssetReloadReason::FileRemoved));
+			REQUIRE(Contains(requests, mesh, AssetReloadReason::Dependency));
+		}
+
+		SECTION("Deregistered dependencies stop propagating")
+		{
+			monitor.DeregisterDependencies(mesh);
+			monitor.DeregisterDependency(texture, material);
+			WriteFile(texturePath, "texture v3");
+
+			const auto requests = CollectReloads(monitor, 1);
+			REQUIRE(requests.size() == 1);
+			REQUIRE(requests[0].Handle == texture);
+		}
+
+		SECTION("Files no asset uses are ignored")
+		{
+			WriteFile(temp.Path / "notes.txt", "not an asset");
+			const auto requests = CollectReloads(monitor, 0);
+			REQUIRE(requests.empty());
+			REQUIRE(monitor.GetStats().unindexedChanges == 1);
+		}
+	}
+
+	TEST_CASE("AssetReloadMonitor event to reload latency", "[.][asset][watcher][performance]")
+	{
+		constexpr int saves = 20;
+		constexpr auto debounce = 50ms;
+
+		TempDirectory temp;
+		const std::filesystem::path texturePath = temp.Path / "apron.png";
+		WriteFile(texturePath, "texture");
+
+		const AssetHandle texture(1);
+		AssetReloadMonitor monitor(FileWatcher::Create(), debounce);
+		REQUIRE(monitor.WatchDirectory(temp.Path));
+		monitor.TrackAsset(texture, texturePath);
+		for (uint64_t i = 0; i < 100; ++i)
+		{
+			monitor.TrackAsset(AssetHandle(100 + i), temp.Path / ("unused_" + std::to_string(i) + ".png"));
+			monitor.RegisterDependency(texture, AssetHandle(100 + i));
+		}
+
+		double totalMs = 0.0;
+		double maxMs = 0.0;
+		int reloaded = 0;
+		for (int i = 0; i < saves; ++i)
+		{
+			const Clock::time_point written = Clock::now();
+			WriteFile(texturePath, std::string(64 + i, 't'));
+
+			std::vector<AssetReloadRequest> requests;
+			while (requests.empty() && Clock::now() - written < 2s)
+				monitor.Update(requests, 100ms);
+			if (requests.empty())
+				continue;
+
+			const double ms = std::chrono::duration<double, std::milli>(Clock::now() - written).count();
+			totalMs += ms;
+			maxMs = std::max(maxMs, ms);
+			reloaded += requests[0].Handle == texture && requests.size() == 101 ? 1 : 0;
+		}
+
+		const AssetReloadStats stats = monitor.GetStats();
+		INFO("Backend: " << monitor.GetBackendName());
+		INFO("Write to reload request: " << totalMs / saves << " ms average, " << maxMs << " ms worst (debounce " << debounce.count() << " ms)");
+		INFO("Monitor latency: " << stats.averageLatencyMs << " ms average, " << stats.maxLatencyMs << " ms worst");
+		INFO("File events: " << stats.fileEvents << ", coalesced: " << stats.coalescedEvents);
+		CHECK(reloaded == saves);
+	}
+
+} // namespace SceneryEditorX::Tests
+
+/// -------------------------------------------------------
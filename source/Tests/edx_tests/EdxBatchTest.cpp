@@ -0,0 +1,309 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX Batch Processing Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* EdxBatchTest.cpp
+* -------------------------------------------------------
+* Tests, contention tests and throughput benchmark for batch processing
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../edX/edXConfig.h"
+#include "../../edX/edXManager.h"
+
+/// -------------------------------------------------------
+
+using namespace edx;
+
+namespace EdxTests
+{
+namespace BatchTests
+{
+EdxProject MakeProject(const std::string& name, size_t assetCount, bool valid)
+{
+    EdxProject project;
+    project.project.name = name;
+    project.project.editorVersion = "1.0.0";
+    project.airport.icao = valid ? "KSEA" : "";
+    for (size_t i = 0; i < assetCount; ++i)
+    {
+        SceneAsset asset;
+        asset.id = name + "_" + std::to_string(i);
+        asset.latitude = 47.0 + double(i) * 1e-5;
+        asset.longitude = -122.0;
+        asset.heading = double(i % 360);
+        project.assets.push_back(asset);
+    }
+    project.rebuild_asset_index();
+    return project;
+}
+
+LibraryFile MakeLibrary(const std::string& name, size_t objectCount)
+{
+    LibraryFile library;
+    library.library.name = name;
+    library.library.version = "1.0.0";
+    library.library.author = "Tests";
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        LibraryObject obj;
+        obj.id = name + "_" + std::to_string(i);
+        obj.uniqueId = obj.id + "_u";
+        obj.name = "Object " + std::to_string(i);
+        obj.assetType = "prop";
+        library.add_object(obj);
+    }
+    return library;
+}
+
+std::filesystem::path TempDir(const std::string& name)
+{
+    const auto dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+// Projects 0, 4, 8... fail validation; then libraries, a damaged file and a missing one
+std::vector<BatchJob> WriteFiles(const std::filesystem::path& dir, size_t projectCount, size_t libraryCount, size_t assetCount)
+{
+    std::vector<BatchJob> jobs;
+    for (size_t i = 0; i < projectCount; ++i)
+    {
+        const auto path = dir / ("project_" + std::to_string(i) + ".edX");
+        MakeProject("p" + std::to_string(i), assetCount, i % 4 != 0).save_to_file(path);
+        jobs.push_back({ BATCH_VALIDATE, path.string(), "" });
+    }
+    for (size_t i = 0; i < libraryCount; ++i)
+    {
+        const auto path = dir / ("library_" + std::to_string(i) + ".edxlib");
+        MakeLibrary("l" + std::to_string(i), 50).save_to_file(path.string());
+        jobs.push_back({ BATCH_VALIDATE, path.string(), "" });
+    }
+
+    const auto damaged = dir / "damaged.edX";
+    std::ofstream(damaged) << "{ \"EditorProject\": [ not json";
+    jobs.push_back({ BATCH_VALIDATE, damaged.string(), "" });
+    jobs.push_back({ BATCH_VALIDATE, (dir / "missing.edX").string(), "" });
+    return jobs;
+}
+
+bool HasError(const BatchFileResult& result, const std::string& text)
+{
+    return std::any_of(result.errors.begin(), result.errors.end(), [&text](const std::string& error) { return error.find(text) != std::string::npos; });
+}
+
+} // namespace BatchTests
+} // namespace EdxTests
+
+/// -------------------------------------------------------
+
+TEST_CASE("Batch validation reports errors per file", "[manager][batch]")
+{
+    using namespace EdxTests::BatchTests;
+
+    const auto dir = TempDir("edx_batch_validate");
+    const auto jobs = WriteFiles(dir, 12, 4, 100);
+
+    EdxManager manager;
+    std::atomic<int> errorCalls = 0;
+    manager.set_error_callback([&errorCalls](const std::string&) { ++errorCalls; });
+
+    BatchOptions options;
+    options.workerCount = 4;
+    std::atomic<size_t> doneCalls = 0;
+    options.fileDone = [&doneCalls](const BatchFileResult&) { ++doneCalls; };
+
+    const BatchReport report = manager.process_batch(jobs, options);
+
+    REQUIRE(report.files.size() == jobs.size());
+    REQUIRE(doneCalls == jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i)
+        REQUIRE(report.files[i].inputPath == jobs[i].inputPath);
+
+    for (size_t i = 0; i < 12; ++i)
+    {
+        const BatchFileResult& result = report.files[i];
+        REQUIRE(result.success == (i % 4 != 0));
+        REQUIRE(result.fileBytes > 0);
+        if (!result.success)
+            REQUIRE(HasError(result, "Airport ICAO code cannot be empty"));
+    }
+    for (size_t i = 12; i < 16; ++i)
+        REQUIRE(report.files[i].success);
+
+    const BatchFileResult& damaged = report.files[16];
+    REQUIRE_FALSE(damaged.success);
+    REQUIRE(HasError(damaged, "damaged.edX"));
+    REQUIRE_FALSE(report.files[17].success);
+    REQUIRE(HasError(report.files[17], "missing.edX"));
+
+    REQUIRE(report.succeeded == 13);
+    REQUIRE(report.failed == 5);
+    REQUIRE(report.get_files_per_second() > 0.0);
+    REQUIRE(report.get_summary().find("18 files, 13 succeeded, 5 failed") != std::string::npos);
+
+    // Nothing leaks into the manager's own error state
+    REQUIRE(manager.get_last_error().empty());
+    REQUIRE(errorCalls == 0);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("Batch resave and conversion", "[manager][batch]")
+{
+    using namespace EdxTests::BatchTests;
+
+    const auto dir = TempDir("edx_batch_resave");
+    const auto outDir = TempDir("edx_batch_resave_out");
+    auto jobs = WriteFiles(dir, 8, 2, 200);
+    for (auto& job : jobs)
+    {
+        job.operation = BATCH_RESAVE;
+        job.outputPath = (outDir / std::filesystem::path(job.inputPath).filename()).string();
+    }
+
+    SECTION("Valid files are written to the output paths")
+    {
+        BatchOptions options;
+        options.workerCount = 3;
+        const BatchReport report = EdxManager().process_batch(jobs, options);
+
+        for (size_t i = 0; i < 8; ++i)
+        {
+            const bool valid = i % 4 != 0;
+            REQUIRE(report.files[i].success == valid);
+            REQUIRE(std::filesystem::exists(jobs[i].outputPath) == valid);
+            if (valid)
+            {
+                EdxProject loaded;
+                REQUIRE(loaded.load_from_file(jobs[i].outputPath));
+                REQUIRE(loaded.assets.size() == 200);
+            }
+            else
+            {
+                REQUIRE(HasError(report.files[i], "Project validation failed"));
+            }
+        }
+        REQUIRE(report.files[8].success);
+        REQUIRE(std::filesystem::exists(jobs[8].outputPath));
+    }
+
+    SECTION("A tiny memory budget runs the files one at a time")
+    {
+        BatchOptions options;
+        options.workerCount = 4;
+        options.memoryBudget = 1;
+        const BatchReport report = EdxManager().process_batch(jobs, options);
+        REQUIRE(report.succeeded == 8);
+    }
+
+    SECTION("Legacy conversion reports per file")
+    {
+        for (auto& job : jobs)
+            job.operation = BATCH_CONVERT_LEGACY;
+        const BatchReport report = EdxManager().process_batch(jobs);
+        REQUIRE(report.failed == jobs.size());
+        REQUIRE(HasError(report.files[0], "Legacy conversion not yet implemented"));
+    }
+
+    SECTION("An empty batch")
+    {
+        const BatchReport report = EdxManager().process_batch({});
+        REQUIRE(report.files.empty());
+        REQUIRE(report.succeeded == 0);
+    }
+
+    std::filesystem::remove_all(dir);
+    std::filesystem::remove_all(outDir);
+}
+
+TEST_CASE("EdxManager under contention", "[manager][batch]")
+{
+    using namespace EdxTests::BatchTests;
+
+    const auto dir = TempDir("edx_batch_contention");
+    const auto good = dir / "good.edX";
+    MakeProject("good", 300, true).save_to_file(good);
+
+    EdxManager manager;
+    manager.set_binary_companion(false);
+    std::atomic<int> errorCalls = 0;
+    manager.set_error_callback([&errorCalls](const std::string&) { ++errorCalls; });
+
+    std::atomic<int> loads = 0;
+    std::atomic<int> failures = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for (int round = 0; round < 10; ++round)
+            {
+                if (auto project = manager.load_project(good.string()))
+                {
+                    if (project->assets.size() == 300 && manager.validate_project(*project).empty())
+                        ++loads;
+                    const auto out = dir / ("out_" + std::to_string(t) + ".edX");
+                    if (!manager.save_project(*project, out.string()))
+                        ++failures;
+                }
+
+                // Failing calls from every thread race on the shared error state
+                if (!manager.load_project((dir / "missing.edX").string()))
+                    ++failures;
+                manager.get_last_error();
+                if (t == 0 && round % 3 == 0)
+                    manager.set_binary_companion(round % 2 == 0);
+                manager.clear_error();
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(loads == 80);
+    REQUIRE(errorCalls == failures);
+    REQUIRE(errorCalls >= 80);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("Batch throughput on 200 projects", "[.][manager][batch][performance]")
+{
+    using namespace EdxTests::BatchTests;
+
+    const auto dir = TempDir("edx_batch_benchmark");
+    auto jobs = WriteFiles(dir, 200, 20, 2000);
+
+    BatchOptions serial;
+    serial.workerCount = 1;
+    const BatchReport single = EdxManager().process_batch(jobs, serial);
+
+    const BatchReport pooled = EdxManager().process_batch(jobs);
+
+    std::vector<double> times;
+    for (const auto& result : pooled.files)
+        times.push_back(result.elapsedMs);
+    std::sort(times.begin(), times.end());
+
+    INFO("One worker: " << single.get_files_per_second() << " files/s");
+    INFO(std::thread::hardware_concurrency() << " workers: " << pooled.get_files_per_second() << " files/s");
+    INFO("Per file: median " << times[times.size() / 2] << " ms, slowest " << times.back() << " ms");
+    CHECK(pooled.failed == single.failed);
+    CHECK(pooled.succeeded == 170);
+
+    std::filesystem::remove_all(dir);
+}
+
+/// -------------------------------------------------------
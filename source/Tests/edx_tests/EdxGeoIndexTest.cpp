@@ -0,0 +1,420 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX Geo Index Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* EdxGeoIndexTest.cpp
+* -------------------------------------------------------
+* Tests and query benchmark for the asset spatial index
+* -------------------------------------------------------
+*/
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../edX/edXConfig.h"
+#include "../../edX/edXGeoIndex.h"
+#include "../../edX/edXProjectFile.h"
+
+/// -------------------------------------------------------
+
+using namespace edx;
+using Catch::Approx;
+
+namespace EdxTests
+{
+namespace GeoIndexTests
+{
+// Assets scattered around a few airports, with most of them packed near the datum
+std::vector<SceneAsset> MakeAssets(size_t count, uint32_t seed)
+{
+    const double centres[][2] = { { 47.4502, -122.3088 }, { 51.4700, -0.4543 }, { -33.9399, 151.1753 }, { 64.8378, -147.8764 }, { -16.5, 179.9 } };
+
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> clustered(0.0, 0.02);
+    std::uniform_real_distribution<double> spread(-1.0, 1.0);
+
+    std::vector<SceneAsset> assets(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto& centre = centres[i % 5];
+        const bool nearDatum = (i % 4) != 0;
+        assets[i].id = "asset_" + std::to_string(i);
+        assets[i].latitude = std::clamp(centre[0] + (nearDatum ? clustered(gen) : spread(gen)), -90.0, 90.0);
+        double lon = centre[1] + (nearDatum ? clustered(gen) : spread(gen));
+        if (lon > 180.0)
+            lon -= 360.0;
+        assets[i].longitude = lon;
+    }
+    return assets;
+}
+
+std::vector<size_t> BruteBox(const std::vector<SceneAsset>& assets, const GeoBounds& bounds)
+{
+    std::vector<size_t> result;
+    for (size_t i = 0; i < assets.size(); ++i)
+    {
+        if (bounds.contains(assets[i].latitude, assets[i].longitude))
+            result.push_back(i);
+    }
+    return result;
+}
+
+std::vector<size_t> BruteRadius(const std::vector<SceneAsset>& assets, double lat, double lon, double radius)
+{
+    std::vector<size_t> result;
+    for (size_t i = 0; i < assets.size(); ++i)
+    {
+        if (GeoIndex::distance_meters(lat, lon, assets[i].latitude, assets[i].longitude) <= radius)
+            result.push_back(i);
+    }
+    return result;
+}
+
+std::vector<size_t> Sorted(std::vector<size_t> values)
+{
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+} // namespace GeoIndexTests
+} // namespace EdxTests
+
+/// -------------------------------------------------------
+
+TEST_CASE("GeoIndex distance", "[geoindex][basic]")
+{
+    // One degree of latitude on the mean sphere
+    REQUIRE(GeoIndex::distance_meters(0.0, 0.0, 1.0, 0.0) == Approx(111195.08).epsilon(1e-6));
+    // Across the antimeridian is the short way round
+    REQUIRE(GeoIndex::distance_meters(0.0, 179.5, 0.0, -179.5) == Approx(111195.08).epsilon(1e-6));
+    REQUIRE(GeoIndex::distance_meters(90.0, 0.0, 90.0, 123.0) == Approx(0.0).margin(1e-6));
+}
+
+TEST_CASE("GeoIndex queries match a linear scan", "[geoindex][query]")
+{
+    using namespace EdxTests::GeoIndexTests;
+
+    const std::vector<SceneAsset> assets = MakeAssets(20000, 7);
+    GeoIndex index;
+    index.build(assets);
+    REQUIRE(index.size() == assets.size());
+    REQUIRE(index.get_node_count() > 1);
+
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<size_t> pick(0, assets.size() - 1);
+    std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+
+    SECTION("Box queries")
+    {
+        for (int q = 0; q < 200; ++q)
+        {
+            const SceneAsset& origin = assets[pick(gen)];
+            const double halfLat = std::abs(jitter(gen)) * (q % 10 == 0 ? 20.0 : 1.0);
+            const double halfLon = std::abs(jitter(gen)) * (q % 10 == 0 ? 20.0 : 1.0);
+            const GeoBounds bounds = { origin.latitude - halfLat, origin.longitude - halfLon, origin.latitude + halfLat, origin.longitude + halfLon };
+
+            std::vector<size_t> found;
+            index.query_box(bounds, found);
+            REQUIRE(Sorted(found) == BruteBox(assets, bounds));
+        }
+
+        // Boxes across the antimeridian wrap
+        const GeoBounds wrapped = { -18.0, 179.0, -15.0, -179.0 };
+        std::vector<size_t> found;
+        index.query_box(wrapped, found);
+        REQUIRE_FALSE(found.empty());
+        REQUIRE(Sorted(found) == BruteBox(assets, wrapped));
+
+        // The whole world
+        found.clear();
+        index.query_box(GeoBounds{}, found);
+        REQUIRE(found.size() == assets.size());
+    }
+
+    SECTION("Radius queries")
+    {
+        for (int q = 0; q < 200; ++q)
+        {
+            const SceneAsset& origin = assets[pick(gen)];
+            const double radius = (q % 10 == 0) ? 150000.0 : 500.0 + 50.0 * q;
+
+            const double lat = origin.latitude + jitter(gen);
+
+            std::vector<size_t> found;
+            index.query_radius(lat, origin.longitude, radius, found);
+            REQUIRE(Sorted(found) == BruteRadius(assets, lat, origin.longitude, radius));
+        }
+
+        // Deterministic cases, including a circle that spans the antimeridian
+        const double points[][2] = { { 47.45, -122.30 }, { -16.5, 179.95 }, { -16.5, -179.95 }, { 64.8, -147.9 } };
+        for (const auto& point : points)
+        {
+            std::vector<size_t> found;
+            index.query_radius(point[0], point[1], 25000.0, found);
+            REQUIRE(Sorted(found) == BruteRadius(assets, point[0], point[1], 25000.0));
+        }
+    }
+
+    SECTION("Nearest neighbour queries")
+    {
+        for (int q = 0; q < 100; ++q)
+        {
+            const SceneAsset& origin = assets[pick(gen)];
+            const double lat = origin.latitude + jitter(gen);
+            const double lon = origin.longitude + jitter(gen);
+            const size_t k = 1 + q % 16;
+
+            std::vector<GeoNeighbor> found;
+            index.query_nearest(lat, lon, k, found);
+            REQUIRE(found.size() == k);
+
+            std::vector<double> distances;
+            for (const auto& asset : assets)
+                distances.push_back(GeoIndex::distance_meters(lat, lon, asset.latitude, asset.longitude));
+            std::sort(distances.begin(), distances.end());
+
+            for (size_t i = 0; i < k; ++i)
+            {
+                REQUIRE(found[i].distanceMeters == Approx(distances[i]).margin(1e-6));
+                if (i > 0)
+                    REQUIRE(found[i - 1].distanceMeters <= found[i].distanceMeters);
+            }
+        }
+    }
+}
+
+TEST_CASE("GeoIndex stays in sync with project edits", "[geoindex][project]")
+{
+    using namespace EdxTests::GeoIndexTests;
+
+    EdxProject project;
+    for (const SceneAsset& asset : MakeAssets(2000, 3))
+        REQUIRE(project.add_asset(asset));
+
+    SceneLayer layer;
+    layer.layerId = "all";
+    for (const SceneAsset& asset : project.assets)
+        layer.assetIds.push_back(asset.id);
+    project.layers.push_back(layer);
+
+    SECTION("Duplicate ids are rejected")
+    {
+        REQUIRE_FALSE(project.add_asset(project.assets.front()));
+        REQUIRE(project.assets.size() == 2000);
+    }
+
+    SECTION("Lookups by id")
+    {
+        const SceneAsset* asset = project.find_asset("asset_1234");
+        REQUIRE(asset != nullptr);
+        REQUIRE(asset->id == "asset_1234");
+        REQUIRE(project.find_asset("missing") == nullptr);
+    }
+
+    SECTION("Moves are visible to queries")
+    {
+        REQUIRE(project.move_asset("asset_10", 10.0, 10.0, 50.0));
+        REQUIRE(project.find_asset("asset_10")->altitude == 50.0);
+
+        std::vector<GeoNeighbor> nearest;
+        project.assetIndex.query_nearest(10.0, 10.0, 1, nearest);
+        REQUIRE(nearest.size() == 1);
+        REQUIRE(project.assets[nearest[0].assetIndex].id == "asset_10");
+
+        // Moving every asset a little keeps the index consistent with a rebuild
+        for (const SceneAsset& asset : std::vector<SceneAsset>(project.assets))
+            project.move_asset(asset.id, asset.latitude + 0.01, asset.longitude - 0.01, asset.altitude);
+
+        const GeoBounds bounds = { 47.0, -123.0, 48.0, -122.0 };
+        std::vector<size_t> found;
+        project.assetIndex.query_box(bounds, found);
+        REQUIRE(Sorted(found) == BruteBox(project.assets, bounds));
+    }
+
+    SECTION("Removals keep the asset order and merge cells")
+    {
+        const size_t nodesBefore = project.assetIndex.get_node_count();
+        for (size_t i = 0; i < 2000; i += 2)
+            REQUIRE(project.remove_asset("asset_" + std::to_string(i)));
+        REQUIRE_FALSE(project.remove_asset("asset_0"));
+
+        REQUIRE(project.assets.size() == 1000);
+        for (size_t i = 0; i < project.assets.size(); ++i)
+            REQUIRE(project.assets[i].id == "asset_" + std::to_string(i * 2 + 1));
+        REQUIRE(project.assetIndex.size() == 1000);
+        REQUIRE(project.layers[0].assetIds.size() == 1000);
+        for (size_t i = 0; i < project.assets.size(); ++i)
+            REQUIRE(project.assetIndex.find(project.assets[i].id) == i);
+
+        std::vector<size_t> found;
+        project.assetIndex.query_box(GeoBounds{}, found);
+        REQUIRE(Sorted(found).size() == 1000);
+
+        for (size_t i = 1; i < 2000; i += 2)
+            REQUIRE(project.remove_asset("asset_" + std::to_string(i)));
+        REQUIRE(project.assets.empty());
+        REQUIRE(project.assetIndex.get_node_count() == 1);
+        REQUIRE(project.assetIndex.get_node_count() < nodesBefore);
+    }
+
+    SECTION("Direct edits of the assets vector are caught")
+    {
+        project.assets.erase(project.assets.begin() + 5);
+        project.assets.push_back(MakeAssets(1, 9).front());
+        project.assets.back().id = "pushed";
+
+        // Same count, shifted positions: the stored index must not be trusted
+        REQUIRE(project.find_asset("asset_6")->id == "asset_6");
+        REQUIRE(project.find_asset("asset_5") == nullptr);
+        REQUIRE(project.find_asset("pushed") != nullptr);
+
+        project.assets.erase(project.assets.begin());
+        const EdxProject& constProject = project;
+        REQUIRE(constProject.find_asset("asset_1999") != nullptr);
+        REQUIRE(constProject.find_asset("asset_0") == nullptr);
+
+        REQUIRE(project.remove_asset("asset_1999"));
+        REQUIRE(project.assets.back().id == "pushed");
+        const SceneAsset duplicate = *project.find_asset("asset_1");
+        REQUIRE_FALSE(project.add_asset(duplicate));
+        for (size_t i = 0; i < project.assets.size(); ++i)
+            REQUIRE(project.assetIndex.find(project.assets[i].id) == i);
+    }
+
+    SECTION("Empty and duplicate ids do not make every edit rebuild")
+    {
+        SceneAsset unnamed = project.assets[3];
+        unnamed.id.clear();
+        project.assets.push_back(unnamed);
+        project.assets.push_back(project.assets[7]);
+        project.rebuild_asset_index();
+        REQUIRE(project.assetIndex.size() == 2000);
+        REQUIRE(project.assetIndex.get_asset_count() == project.assets.size());
+
+        // Moved behind the index's back; a rebuild would pick the new position up
+        project.assets[10].latitude = 0.0;
+        project.assets[10].longitude = 0.0;
+        const GeoBounds origin = { -0.5, -0.5, 0.5, 0.5 };
+
+        SceneAsset added = project.assets[20];
+        for (int i = 0; i < 10; ++i)
+        {
+            added.id = "added_" + std::to_string(i);
+            REQUIRE(project.add_asset(added));
+            REQUIRE(project.find_asset("missing") == nullptr);
+            REQUIRE_FALSE(project.move_asset("missing", 1.0, 1.0, 0.0));
+            REQUIRE_FALSE(project.remove_asset("missing"));
+        }
+        std::vector<size_t> hits;
+        project.assetIndex.query_box(origin, hits);
+        REQUIRE(hits.empty());
+        REQUIRE(project.assetIndex.get_asset_count() == project.assets.size());
+
+        // Removing the indexed copy of a duplicate id leaves the later copy findable
+        REQUIRE(project.remove_asset("asset_7"));
+        const SceneAsset* survivor = project.find_asset("asset_7");
+        REQUIRE(survivor != nullptr);
+        REQUIRE(project.assetIndex.find("asset_7") == static_cast<size_t>(survivor - project.assets.data()));
+        REQUIRE(project.assetIndex.get_asset_count() == project.assets.size());
+    }
+
+    SECTION("Loading from json rebuilds the index")
+    {
+        json j;
+        project.to_json(j);
+        EdxProject loaded;
+        loaded.from_json(j);
+        REQUIRE(loaded.assetIndex.size() == project.assets.size());
+        REQUIRE(loaded.find_asset("asset_42") != nullptr);
+    }
+}
+
+TEST_CASE("GeoIndex query throughput on 500k assets", "[.][geoindex][performance]")
+{
+    using namespace EdxTests::GeoIndexTests;
+    using Clock = std::chrono::high_resolution_clock;
+    const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    const std::vector<SceneAsset> assets = MakeAssets(500000, 1);
+
+    auto start = Clock::now();
+    GeoIndex index;
+    index.build(assets);
+    const double buildMs = ms(start);
+
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<size_t> pick(0, assets.size() - 1);
+    constexpr int queries = 1000;
+
+    // Cursor picks: a 2 m box around an asset
+    std::vector<size_t> found;
+    start = Clock::now();
+    size_t boxHits = 0;
+    for (int q = 0; q < queries; ++q)
+    {
+        const SceneAsset& asset = assets[pick(gen)];
+        found.clear();
+        index.query_box({ asset.latitude - 1e-5, asset.longitude - 1e-5, asset.latitude + 1e-5, asset.longitude + 1e-5 }, found);
+        boxHits += found.size();
+    }
+    const double boxMs = ms(start) / queries;
+
+    // Near a runway: everything within 500 m
+    start = Clock::now();
+    size_t radiusHits = 0;
+    for (int q = 0; q < queries; ++q)
+    {
+        const SceneAsset& asset = assets[pick(gen)];
+        found.clear();
+        index.query_radius(asset.latitude, asset.longitude, 500.0, found);
+        radiusHits += found.size();
+    }
+    const double radiusMs = ms(start) / queries;
+
+    std::vector<GeoNeighbor> nearest;
+    start = Clock::now();
+    for (int q = 0; q < queries; ++q)
+    {
+        const SceneAsset& asset = assets[pick(gen)];
+        nearest.clear();
+        index.query_nearest(asset.latitude, asset.longitude, 10, nearest);
+    }
+    const double nearestMs = ms(start) / queries;
+
+    // What every query cost before: a scan of the assets vector
+    constexpr int scans = 20;
+    start = Clock::now();
+    size_t scanHits = 0;
+    for (int q = 0; q < scans; ++q)
+    {
+        const SceneAsset& asset = assets[pick(gen)];
+        scanHits += BruteRadius(assets, asset.latitude, asset.longitude, 500.0).size();
+    }
+    const double scanMs = ms(start) / scans;
+
+    // Moves of a few meters, as when dragging a selection
+    start = Clock::now();
+    for (int q = 0; q < queries; ++q)
+    {
+        const SceneAsset& asset = assets[pick(gen)];
+        index.move(asset.id, asset.latitude + 2e-5, asset.longitude + 2e-5);
+    }
+    const double moveUs = ms(start) * 1000.0 / queries;
+
+    INFO("Build: " << buildMs << " ms for " << assets.size() << " assets, " << index.get_node_count() << " nodes");
+    INFO("Box (cursor pick): " << boxMs * 1000.0 << " us/query, " << boxHits / double(queries) << " hits avg");
+    INFO("Radius 500 m: " << radiusMs * 1000.0 << " us/query, " << radiusHits / double(queries) << " hits avg");
+    INFO("10 nearest: " << nearestMs * 1000.0 << " us/query");
+    INFO("Linear scan radius 500 m: " << scanMs << " ms/query, " << scanHits / double(scans) << " hits avg");
+    INFO("Move: " << moveUs << " us/asset");
+    CHECK(boxHits >= static_cast<size_t>(queries));
+    CHECK(nearest.size() == 10);
+}
+
+/// -------------------------------------------------------
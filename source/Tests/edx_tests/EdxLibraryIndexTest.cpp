@@ -0,0 +1,331 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX Library Index Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* EdxLibraryIndexTest.cpp
+* -------------------------------------------------------
+* Tests and keystroke latency benchmark for the library object index
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../edX/edXConfig.h"
+#include "../../edX/edXLibraryFile.h"
+#include "../../edX/edXLibraryIndex.h"
+
+/// -------------------------------------------------------
+
+using namespace edx;
+
+namespace EdxTests
+{
+namespace LibraryIndexTests
+{
+LibraryObject MakeObject(const std::string& id, const std::string& name, const std::string& category,
+                         const std::string& assetType, std::vector<std::string> tags, const std::string& description = "")
+{
+    LibraryObject obj;
+    obj.id = id;
+    obj.uniqueId = id + "_u";
+    obj.name = name;
+    obj.description = description;
+    obj.category = category;
+    obj.assetType = assetType;
+    obj.tags = std::move(tags);
+    return obj;
+}
+
+LibraryFile MakeLibrary()
+{
+    LibraryFile library;
+    library.library.name = "Index Test";
+    library.add_object(MakeObject("jetway", "Jetway", "ground_support", "vehicle", { "gate", "bridge" }));
+    library.add_object(MakeObject("jetway_long", "Jetway Long Boarding Bridge", "ground_support", "vehicle", { "gate" }));
+    library.add_object(MakeObject("bluejet", "Bluejet Hangar", "buildings", "building", { "hangar" }));
+    library.add_object(MakeObject("tug", "Pushback Tug", "ground_support", "vehicle", { "tow" }, "Moves aircraft away from the jetway"));
+    library.add_object(MakeObject("terminal", "Terminal Building", "buildings", "building", { "gate", "terminal" }));
+    library.add_object(MakeObject("edge_light", "Taxiway Edge Light", "lighting", "lighting", {}));
+    return library;
+}
+
+std::vector<std::string> Ids(const LibraryFile& library, const std::vector<LibraryMatch>& matches)
+{
+    std::vector<std::string> ids;
+    for (const LibraryMatch& match : matches)
+        ids.push_back(library.objects[match.objectIndex].id);
+    return ids;
+}
+
+bool Contains(const std::vector<std::string>& values, const std::string& value)
+{
+    return std::find(values.begin(), values.end(), value) != values.end();
+}
+
+// Brute force filter for the benchmark's check
+std::vector<size_t> BruteFilter(const LibraryFile& library, const LibraryQuery& query)
+{
+    std::vector<size_t> result;
+    for (size_t i = 0; i < library.objects.size(); ++i)
+    {
+        const LibraryObject& obj = library.objects[i];
+        if (!query.category.empty() && obj.category != query.category)
+            continue;
+        if (!query.assetType.empty() && obj.assetType != query.assetType)
+            continue;
+        bool hasTags = true;
+        for (const std::string& tag : query.tags)
+            hasTags = hasTags && std::find(obj.tags.begin(), obj.tags.end(), tag) != obj.tags.end();
+        if (hasTags)
+            result.push_back(i);
+    }
+    return result;
+}
+
+} // namespace LibraryIndexTests
+} // namespace EdxTests
+
+/// -------------------------------------------------------
+
+TEST_CASE("LibraryIndex lookups and filters", "[library][index]")
+{
+    using namespace EdxTests::LibraryIndexTests;
+
+    LibraryFile library = MakeLibrary();
+    REQUIRE(library.objectIndex.size() == 6);
+
+    SECTION("By id and unique id")
+    {
+        REQUIRE(library.find_object("tug") != nullptr);
+        REQUIRE(library.find_object("tug")->name == "Pushback Tug");
+        REQUIRE(library.objectIndex.find_unique_id("tug_u") == library.objectIndex.find("tug"));
+        REQUIRE(library.find_object("missing") == nullptr);
+    }
+
+    SECTION("Duplicates are rejected")
+    {
+        library.add_object(MakeObject("tug", "Other", "x", "y", {}));
+        LibraryObject sameUnique = MakeObject("tug2", "Other", "x", "y", {});
+        sameUnique.uniqueId = "tug_u";
+        library.add_object(sameUnique);
+        REQUIRE(library.objects.size() == 6);
+    }
+
+    SECTION("Categories, asset types and tags")
+    {
+        REQUIRE(library.get_categories() == std::vector<std::string>{ "buildings", "ground_support", "lighting" });
+        REQUIRE(library.get_asset_types() == std::vector<std::string>{ "building", "lighting", "vehicle" });
+        REQUIRE(Contains(library.objectIndex.get_tags(), "gate"));
+
+        LibraryQuery query;
+        query.category = "ground_support";
+        query.tags = { "gate" };
+        REQUIRE(Ids(library, library.search(query)) == std::vector<std::string>{ "jetway", "jetway_long" });
+
+        query = LibraryQuery();
+        query.assetType = "building";
+        query.limit = 1;
+        REQUIRE(library.search(query).size() == 1);
+    }
+
+    SECTION("Removals keep the index in step")
+    {
+        REQUIRE(library.remove_object("jetway"));
+        REQUIRE_FALSE(library.remove_object("jetway"));
+        REQUIRE(library.objects.size() == 5);
+        for (size_t i = 0; i < library.objects.size(); ++i)
+            REQUIRE(library.objectIndex.find(library.objects[i].id) == i);
+
+        // The saved order is kept
+        const LibraryFile original = MakeLibrary();
+        std::vector<std::string> expected;
+        for (const LibraryObject& obj : original.objects)
+        {
+            if (obj.id != "jetway")
+                expected.push_back(obj.id);
+        }
+        std::vector<std::string> ids;
+        for (const LibraryObject& obj : library.objects)
+            ids.push_back(obj.id);
+        REQUIRE(ids == expected);
+
+        LibraryQuery query;
+        query.tags = { "bridge" };
+        REQUIRE(library.search(query).empty());
+
+        REQUIRE(library.remove_object("edge_light"));
+        REQUIRE_FALSE(Contains(library.get_categories(), "lighting"));
+    }
+
+    SECTION("Objects appended directly are still found")
+    {
+        library.objects.push_back(MakeObject("apron_light", "Apron Flood Light", "lighting", "lighting", {}));
+        REQUIRE(library.find_object("apron_light") != nullptr);
+
+        LibraryQuery query;
+        query.text = "flood";
+        REQUIRE(Ids(library, library.search(query)) == std::vector<std::string>{ "apron_light" });
+
+        library.add_object(MakeObject("stand", "Stand Marker", "markings", "marking", {}));
+        REQUIRE(library.objectIndex.size() == 8);
+    }
+
+    SECTION("Loading rebuilds the index")
+    {
+        json j;
+        library.to_json(j);
+        LibraryFile loaded;
+        loaded.from_json(j);
+        REQUIRE(loaded.objectIndex.size() == 6);
+        REQUIRE(loaded.find_object("terminal") != nullptr);
+    }
+}
+
+TEST_CASE("LibraryIndex text search", "[library][index]")
+{
+    using namespace EdxTests::LibraryIndexTests;
+
+    const LibraryFile library = MakeLibrary();
+    LibraryQuery query;
+
+    SECTION("The first keystrokes match word prefixes")
+    {
+        query.text = "j";
+        const auto ids = Ids(library, library.search(query));
+        REQUIRE(ids == std::vector<std::string>{ "jetway", "jetway_long", "tug" });
+
+        query.text = "te";
+        REQUIRE(Ids(library, library.search(query)) == std::vector<std::string>{ "terminal" });
+    }
+
+    SECTION("Exact and prefix matches rank first, substrings still match")
+    {
+        query.text = "jet";
+        const auto ids = Ids(library, library.search(query));
+        REQUIRE(ids.size() >= 3);
+        REQUIRE(ids[0] == "jetway");
+        REQUIRE(ids[1] == "jetway_long");
+        REQUIRE(Contains(ids, "bluejet"));
+        // The description mention of "jetway" ranks below every name match
+        REQUIRE(Contains(ids, "tug"));
+        REQUIRE(ids.back() == "tug");
+    }
+
+    SECTION("Typos are tolerated")
+    {
+        query.text = "jetwya";
+        REQUIRE(Ids(library, library.search(query)).front() == "jetway");
+
+        query.text = "pushbak";
+        REQUIRE(Ids(library, library.search(query)).front() == "tug");
+    }
+
+    SECTION("Case and punctuation are ignored")
+    {
+        query.text = "TAXIWAY-edge";
+        REQUIRE(Ids(library, library.search(query)).front() == "edge_light");
+    }
+
+    SECTION("Text and filters combine")
+    {
+        query.text = "jet";
+        query.category = "buildings";
+        REQUIRE(Ids(library, library.search(query)) == std::vector<std::string>{ "bluejet" });
+    }
+
+    SECTION("Unrelated text matches nothing")
+    {
+        query.text = "windsock";
+        REQUIRE(library.search(query).empty());
+    }
+}
+
+TEST_CASE("LibraryIndex keystroke latency on 100k objects", "[.][library][index][performance]")
+{
+    using namespace EdxTests::LibraryIndexTests;
+    using Clock = std::chrono::high_resolution_clock;
+    const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    const char* words[] = { "jetway", "hangar", "terminal", "tug", "baggage", "cart", "fuel", "truck", "stairs", "light",
+                            "sign", "fence", "tower", "radar", "cone", "barrier", "container", "dolly", "loader", "bus" };
+    const char* categories[] = { "buildings", "ground_support", "lighting", "signage", "vehicles", "misc" };
+    const char* types[] = { "building", "vehicle", "lighting", "sign", "prop" };
+
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> word(0, 19);
+    LibraryFile library;
+    std::vector<LibraryObject> objects;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const std::string name = std::string(words[word(gen)]) + " " + words[word(gen)] + " " + std::to_string(i % 500);
+        const std::string description = std::string("A ") + words[word(gen)] + " for the " + words[word(gen)] + " area";
+        objects.push_back(MakeObject("obj_" + std::to_string(i), name, categories[i % 6], types[i % 5],
+                                     { words[i % 20], words[(i / 20) % 20] }, description));
+    }
+
+    auto start = Clock::now();
+    library.objects = objects;
+    library.rebuild_object_index();
+    const double buildMs = ms(start);
+
+    // Typing "baggage loader" one key at a time, with and without a category filter
+    const std::string typed = "baggage loader";
+    std::vector<double> latencies;
+    size_t lastCount = 0;
+    for (const std::string& category : { std::string(), std::string("vehicles") })
+    {
+        for (size_t n = 1; n <= typed.size(); ++n)
+        {
+            LibraryQuery query;
+            query.text = typed.substr(0, n);
+            query.category = category;
+            start = Clock::now();
+            const auto matches = library.search(query);
+            latencies.push_back(ms(start));
+            lastCount = matches.size();
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const double medianMs = latencies[latencies.size() / 2];
+    const double worstMs = latencies.back();
+
+    // What the content browser did before: a scan with string compares per object
+    start = Clock::now();
+    size_t scanHits = 0;
+    for (const LibraryObject& obj : library.objects)
+    {
+        if (obj.name.find("baggage") != std::string::npos || obj.description.find("baggage") != std::string::npos)
+            ++scanHits;
+    }
+    const double scanMs = ms(start);
+
+    LibraryQuery filter;
+    filter.category = "vehicles";
+    filter.tags = { "fuel" };
+    filter.limit = 0;
+    start = Clock::now();
+    const auto filtered = library.search(filter);
+    const double filterMs = ms(start);
+
+    start = Clock::now();
+    for (int i = 0; i < 1000; ++i)
+        library.remove_object("obj_" + std::to_string(i * 7));
+    for (int i = 0; i < 1000; ++i)
+        library.add_object(objects[size_t(i) * 7]);
+    const double editMs = ms(start) / 2000.0;
+
+    INFO("Build over " << objects.size() << " objects: " << buildMs << " ms");
+    INFO("Per keystroke: median " << medianMs << " ms, worst " << worstMs << " ms, " << lastCount << " results on the last key");
+    INFO("Linear substring scan: " << scanMs << " ms (" << scanHits << " hits)");
+    INFO("Category and tag filter: " << filterMs << " ms for " << filtered.size() << " objects");
+    INFO("Add or remove: " << editMs << " ms");
+    CHECK(filtered.size() == BruteFilter(library, filter).size());
+}
+
+/// -------------------------------------------------------
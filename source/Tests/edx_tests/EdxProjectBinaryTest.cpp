@@ -0,0 +1,330 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX Binary Project Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* EdxProjectBinaryTest.cpp
+* -------------------------------------------------------
+* Tests and load benchmark for the .edXb companion format
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../../edX/edXConfig.h"
+#include "../../edX/edXManager.h"
+#include "../../edX/edXProjectBinary.h"
+#include "../../edX/edXProjectFile.h"
+#include "../../edX/edXProjectStream.h"
+
+/// -------------------------------------------------------
+
+using namespace edx;
+
+namespace EdxTests
+{
+namespace ProjectBinaryTests
+{
+EdxProject MakeProject(size_t assetCount)
+{
+    EdxProject project;
+    project.project.name = "Binary Test";
+    project.project.author = "Test Author";
+    project.project.editorVersion = VERSION;
+    project.project.createDate = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+    project.project.editDate = project.project.createDate;
+    project.airport.icao = "EGLL";
+    project.airport.datumLat = 51.4700;
+    project.airport.datumLon = -0.4543;
+
+    LibraryReference library;
+    library.name = "X-Plane Default";
+    library.shortId = "xp_default";
+    project.libraries.push_back(library);
+
+    const char* libraries[] = { "xp_default", "ortho_buildings", "" };
+    for (int l = 0; l < 3; ++l)
+    {
+        SceneLayer layer;
+        layer.layerId = "layer_" + std::to_string(l);
+        layer.name = "Layer " + std::to_string(l);
+        layer.opacity = 0.25 * (l + 1);
+        layer.zOrder = l;
+        if (l == 1)
+            layer.layerProperties["colour"] = "#ff8800";
+        project.layers.push_back(layer);
+    }
+
+    for (size_t i = 0; i < assetCount; ++i)
+    {
+        SceneAsset asset;
+        asset.id = "asset_" + std::to_string(i);
+        asset.uniqueId = "3f2b8c9e-" + std::to_string(100000 + i);
+        asset.latitude = 51.47 + double(i % 997) * 1.0e-5 + 1.0 / 3.0 * 1e-9;
+        asset.longitude = -0.4543 + double(i / 997) * 1.0e-5;
+        asset.altitude = 25.0 + double(i % 7);
+        asset.heading = double(i % 360) + 0.125;
+        asset.associatedLibrary = libraries[i % 3];
+        asset.layerId = "layer_" + std::to_string(i % 3);
+        asset.groupId = i % 5 == 0 ? "group_" + std::to_string(i / 50) : "";
+        asset.locked = i % 2 == 0;
+        asset.hidden = i % 3 == 0;
+        asset.selected = i % 11 == 0;
+        if (i % 4 == 0)
+            asset.otherProperties["object_type"] = "jetway";
+        if (i % 8 == 0)
+            asset.otherProperties["serial"] = i;
+        project.layers[i % 3].assetIds.push_back(asset.id);
+        project.assets.push_back(asset);
+    }
+    project.settings["grid"] = 5;
+    project.rebuild_asset_index();
+    return project;
+}
+
+json ToJson(const EdxProject& project)
+{
+    json j;
+    project.to_json(j);
+    return j;
+}
+
+std::filesystem::path TempDir(const std::string& name)
+{
+    const auto dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::vector<char> ReadBytes(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void WriteBytes(const std::filesystem::path& path, const std::vector<char>& bytes)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+} // namespace ProjectBinaryTests
+} // namespace EdxTests
+
+/// -------------------------------------------------------
+
+TEST_CASE(".edXb round trip", "[project][binary]")
+{
+    using namespace EdxTests::ProjectBinaryTests;
+
+    const auto dir = TempDir("edx_binary_roundtrip");
+    const auto path = dir / "airport.edXb";
+
+    SECTION("A project comes back field for field")
+    {
+        const EdxProject project = MakeProject(2000);
+        std::string error;
+        REQUIRE(ProjectBinaryFile::write(project, path, &error));
+        CHECK_FALSE(std::filesystem::exists(dir / "airport.edXb.tmp"));
+
+        ProjectBinaryFile binary;
+        REQUIRE(binary.open(path));
+        EdxProject loaded;
+        REQUIRE(binary.load(loaded));
+
+        CHECK(ToJson(loaded) == ToJson(project));
+        CHECK(loaded.find_asset("asset_1999") != nullptr);
+        CHECK(loaded.assetIndex.size() == project.assets.size());
+    }
+
+    SECTION("An empty project")
+    {
+        EdxProject project;
+        REQUIRE(ProjectBinaryFile::write(project, path));
+
+        ProjectBinaryFile binary;
+        REQUIRE(binary.open(path));
+        CHECK(binary.asset_count() == 0);
+        EdxProject loaded = MakeProject(3);
+        REQUIRE(binary.load(loaded));
+        CHECK(ToJson(loaded) == ToJson(project));
+    }
+
+    SECTION("Columns can be read in place")
+    {
+        const EdxProject project = MakeProject(100);
+        REQUIRE(ProjectBinaryFile::write(project, path));
+
+        ProjectBinaryFile binary;
+        REQUIRE(binary.open(path));
+        REQUIRE(binary.asset_count() == 100);
+        for (size_t i = 0; i < binary.asset_count(); ++i)
+        {
+            const SceneAsset& asset = project.assets[i];
+            CHECK(binary.latitudes()[i] == asset.latitude);
+            CHECK(binary.longitudes()[i] == asset.longitude);
+            CHECK(binary.altitudes()[i] == asset.altitude);
+            CHECK(binary.headings()[i] == asset.heading);
+            CHECK(((binary.asset_flags()[i] & ProjectBinaryFile::FLAG_LOCKED) != 0) == asset.locked);
+            CHECK(binary.asset_string(ProjectBinaryFile::COLUMN_ID, i) == asset.id);
+            CHECK(binary.asset_string(ProjectBinaryFile::COLUMN_LIBRARY, i) == asset.associatedLibrary);
+            CHECK(binary.asset_string(ProjectBinaryFile::COLUMN_GROUP_ID, i) == asset.groupId);
+        }
+
+        // Repeated strings are stored once
+        const uint32_t* libraries = binary.string_column(ProjectBinaryFile::COLUMN_LIBRARY);
+        CHECK(libraries[0] == libraries[3]);
+        CHECK(binary.string(binary.string_column(ProjectBinaryFile::COLUMN_LIBRARY)[2]).empty());
+        CHECK(binary.string_count() < 100 * 3);
+    }
+
+    SECTION("Damaged files are rejected")
+    {
+        const EdxProject project = MakeProject(50);
+        REQUIRE(ProjectBinaryFile::write(project, path));
+        const std::vector<char> good = ReadBytes(path);
+        ProjectBinaryFile binary;
+
+        std::vector<char> bytes(good.begin(), good.begin() + 40);
+        WriteBytes(path, bytes);
+        CHECK_FALSE(binary.open(path));
+        CHECK_FALSE(binary.get_error().empty());
+
+        bytes = good;
+        bytes[0] = 'J';
+        WriteBytes(path, bytes);
+        CHECK_FALSE(binary.open(path));
+
+        bytes = std::vector<char>(good.begin(), good.end() - 64);
+        WriteBytes(path, bytes);
+        CHECK_FALSE(binary.open(path));
+
+        // Asset count after the magic and version no longer matches the columns
+        bytes = good;
+        bytes[8] = char(bytes[8] + 1);
+        WriteBytes(path, bytes);
+        CHECK_FALSE(binary.open(path));
+        CHECK_FALSE(binary.is_open());
+
+        EdxProject untouched = MakeProject(2);
+        CHECK_FALSE(binary.load(untouched));
+        CHECK(untouched.assets.size() == 2);
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("EdxManager keeps the .edXb companion in sync", "[project][binary]")
+{
+    using namespace EdxTests::ProjectBinaryTests;
+
+    const auto dir = TempDir("edx_binary_manager");
+    const std::string path = (dir / "airport.edX").string();
+    const auto companion = ProjectBinaryFile::companion_path(path);
+    CHECK(companion.filename() == "airport.edXb");
+
+    EdxManager manager;
+    EdxProject project = MakeProject(300);
+
+    SECTION("Off by default")
+    {
+        REQUIRE(manager.save_project(project, path));
+        CHECK_FALSE(std::filesystem::exists(companion));
+    }
+
+    SECTION("Saving writes both and loading prefers the newer")
+    {
+        manager.set_binary_companion(true);
+        REQUIRE(manager.save_project(project, path));
+        REQUIRE(std::filesystem::exists(companion));
+        CHECK(std::filesystem::last_write_time(companion) >= std::filesystem::last_write_time(path));
+
+        auto loaded = manager.load_project(path);
+        REQUIRE(loaded);
+        CHECK(ToJson(*loaded) == ToJson(project));
+
+        // The JSON edited on its own, e.g. by a merge, is newer and wins
+        project.project.description = "Edited in a text editor";
+        REQUIRE(project.save_to_file(path));
+        std::filesystem::last_write_time(path, std::filesystem::last_write_time(companion) + std::chrono::seconds(2));
+        loaded = manager.load_project(path);
+        REQUIRE(loaded);
+        CHECK(loaded->project.description == "Edited in a text editor");
+
+        // A newer but damaged companion falls back to the JSON
+        WriteBytes(companion, std::vector<char>(16, 'x'));
+        std::filesystem::last_write_time(companion, std::filesystem::last_write_time(path) + std::chrono::seconds(2));
+        loaded = manager.load_project(path);
+        REQUIRE(loaded);
+        CHECK(loaded->project.description == "Edited in a text editor");
+
+        // Without the JSON the companion alone is enough
+        REQUIRE(manager.save_project(project, path));
+        std::filesystem::remove(path);
+        loaded = manager.load_project(path);
+        REQUIRE(loaded);
+        CHECK(loaded->assets.size() == project.assets.size());
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE(".edXb load time against JSON", "[.][project][binary][performance]")
+{
+    using namespace EdxTests::ProjectBinaryTests;
+    using Clock = std::chrono::high_resolution_clock;
+    const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    const auto dir = TempDir("edx_binary_benchmark");
+    const auto jsonPath = dir / "airport.edX";
+    const auto binaryPath = ProjectBinaryFile::companion_path(jsonPath);
+
+    const EdxProject project = MakeProject(500000);
+
+    auto start = Clock::now();
+    REQUIRE(project.save_to_file(jsonPath));
+    const double jsonSaveMs = ms(start);
+
+    start = Clock::now();
+    REQUIRE(ProjectBinaryFile::write(project, binaryPath));
+    const double binarySaveMs = ms(start);
+
+    start = Clock::now();
+    EdxProject fromJson;
+    ProjectStreamReader reader;
+    REQUIRE(reader.load(jsonPath, fromJson));
+    const double jsonLoadMs = ms(start);
+
+    start = Clock::now();
+    ProjectBinaryFile binary;
+    REQUIRE(binary.open(binaryPath));
+    const double openMs = ms(start);
+
+    start = Clock::now();
+    double latitudeSum = 0.0;
+    for (size_t i = 0; i < binary.asset_count(); ++i)
+        latitudeSum += binary.latitudes()[i];
+    const double scanMs = ms(start);
+
+    start = Clock::now();
+    EdxProject fromBinary;
+    REQUIRE(binary.load(fromBinary));
+    const double binaryLoadMs = ms(start);
+
+    INFO("Assets: " << project.assets.size());
+    INFO("File size: JSON " << std::filesystem::file_size(jsonPath) / (1 << 20) << " MB, .edXb " << std::filesystem::file_size(binaryPath) / (1 << 20) << " MB");
+    INFO("Save: JSON " << jsonSaveMs << " ms, .edXb " << binarySaveMs << " ms");
+    INFO("Load into EdxProject: JSON " << jsonLoadMs << " ms, .edXb " << binaryLoadMs << " ms");
+    INFO("Map and validate .edXb: " << openMs << " ms; scan latitudes in place: " << scanMs << " ms (" << latitudeSum << ")");
+    CHECK(fromBinary.assets.size() == fromJson.assets.size());
+
+    std::filesystem::remove_all(dir);
+}
+
+/// -------------------------------------------------------
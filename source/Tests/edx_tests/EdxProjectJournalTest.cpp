@@ -0,0 +1,512 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX Project Journal Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* EdxProjectJournalTest.cpp
+* -------------------------------------------------------
+* Tests and save latency benchmark for journaled saves
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../../edX/edXConfig.h"
+#include "../../edX/edXFileUtils.h"
+#include "../../edX/edXManager.h"
+#include "../../edX/edXProjectFile.h"
+#include "../../edX/edXProjectJournal.h"
+
+/// -------------------------------------------------------
+
+using namespace edx;
+
+namespace EdxTests
+{
+namespace ProjectJournalTests
+{
+SceneAsset MakeAsset(const std::string& id, double lat, double lon)
+{
+    SceneAsset asset;
+    asset.id = id;
+    asset.uniqueId = id + "_u";
+    asset.latitude = lat;
+    asset.longitude = lon;
+    asset.altitude = 13.0;
+    asset.heading = 90.0;
+    asset.associatedLibrary = "xp_default";
+    asset.layerId = "layer_0";
+    asset.otherProperties["object_type"] = "pushback_tug";
+    return asset;
+}
+
+EdxProject MakeProject(size_t assetCount)
+{
+    EdxProject project;
+    project.project.name = "Journal Test";
+    project.project.editorVersion = VERSION;
+    project.project.createDate = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+    project.project.editDate = project.project.createDate;
+    project.airport.icao = "KSEA";
+    project.airport.datumLat = 47.4502;
+    project.airport.datumLon = -122.3088;
+
+    SceneLayer layer;
+    layer.layerId = "layer_0";
+    layer.name = "Ground";
+    for (size_t i = 0; i < assetCount; ++i)
+    {
+        project.add_asset(MakeAsset("asset_" + std::to_string(i), 47.45 + double(i % 1000) * 1e-5, -122.31 + double(i / 1000) * 1e-5));
+        layer.assetIds.push_back("asset_" + std::to_string(i));
+    }
+    project.layers.push_back(layer);
+    return project;
+}
+
+json ToJson(const EdxProject& project)
+{
+    json j;
+    project.to_json(j);
+    return j;
+}
+
+// What loading a file saved from the project gives: the reference for replay
+json SavedJson(const EdxProject& project, const std::filesystem::path& path)
+{
+    EdxProject loaded;
+    REQUIRE(project.save_to_file(path));
+    REQUIRE(loaded.load_from_file(path));
+    std::filesystem::remove(path);
+    return ToJson(loaded);
+}
+
+// Moves, adds and removes assets, edits layers and metadata
+void RandomEdits(ProjectJournal& journal, EdxProject& project, std::mt19937& gen, int edits, int& nextId)
+{
+    for (int e = 0; e < edits; ++e)
+    {
+        const int kind = std::uniform_int_distribution<int>(0, 9)(gen);
+        if (kind < 5 && !project.assets.empty())
+        {
+            SceneAsset asset = project.assets[std::uniform_int_distribution<size_t>(0, project.assets.size() - 1)(gen)];
+            asset.latitude += 1e-5;
+            asset.heading = double(e % 360);
+            asset.otherProperties["moved"] = e;
+            REQUIRE(journal.put_asset(project, asset));
+        }
+        else if (kind < 7)
+        {
+            REQUIRE(journal.put_asset(project, MakeAsset("new_" + std::to_string(nextId++), 47.46, -122.30)));
+        }
+        else if (kind < 8 && !project.assets.empty())
+        {
+            const std::string id = project.assets[std::uniform_int_distribution<size_t>(0, project.assets.size() - 1)(gen)].id;
+            REQUIRE(journal.remove_asset(project, id));
+        }
+        else if (kind < 9)
+        {
+            SceneLayer layer;
+            layer.layerId = "layer_" + std::to_string(e % 3);
+            layer.name = "Edited " + std::to_string(e);
+            layer.opacity = 0.5;
+            if (!project.assets.empty())
+                layer.assetIds.push_back(project.assets.front().id);
+            REQUIRE(journal.put_layer(project, layer));
+            if (e % 4 == 0)
+                journal.remove_layer(project, "layer_" + std::to_string((e + 1) % 3));
+        }
+        else
+        {
+            project.project.description = "Edit " + std::to_string(e);
+            project.settings["grid"] = e;
+            journal.put_metadata(project);
+        }
+    }
+}
+
+std::filesystem::path TempDir(const std::string& name)
+{
+    const auto dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+} // namespace ProjectJournalTests
+} // namespace EdxTests
+
+/// -------------------------------------------------------
+
+TEST_CASE("write_json matches dump(4)", "[project][journal]")
+{
+    using namespace EdxTests::ProjectJournalTests;
+
+    EdxProject project = MakeProject(50);
+    project.assets[3].otherProperties["nested"] = { { "a", { 1, "two\nlines", json::object(), json::array() } } };
+    project.settings["units"] = "metric";
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        std::ostringstream out;
+        project.write_json(out);
+        REQUIRE(out.str() == ToJson(project).dump(4));
+
+        // Empty sections and no settings
+        project = EdxProject();
+    }
+}
+
+TEST_CASE("Journal replay gives the saved project", "[project][journal]")
+{
+    using namespace EdxTests::ProjectJournalTests;
+
+    const auto dir = TempDir("edx_journal_replay");
+    const auto path = dir / "airport.edX";
+
+    JournalOptions options;
+    options.compactThreshold = 0;
+
+    EdxProject live = MakeProject(200);
+    std::mt19937 gen(3);
+    int nextId = 0;
+    {
+        ProjectJournal journal(path, options);
+        REQUIRE(journal.create(live));
+        REQUIRE(std::filesystem::exists(ProjectJournal::journal_path(path)));
+
+        for (int batch = 0; batch < 5; ++batch)
+        {
+            RandomEdits(journal, live, gen, 40, nextId);
+            REQUIRE(journal.get_stats().pendingRecords > 0);
+            REQUIRE(journal.commit());
+            REQUIRE(journal.get_stats().pendingRecords == 0);
+        }
+
+        // Not committed, so not saved
+        journal.put_asset(live, MakeAsset("uncommitted", 47.0, -122.0));
+    }
+    REQUIRE(live.remove_asset("uncommitted"));
+
+    json expected = SavedJson(live, dir / "reference.edX");
+
+    // Journals are closed before the next one opens the files, as Windows cannot rename open files
+    {
+        EdxProject reopened;
+        ProjectJournal journal(path, options);
+        REQUIRE(journal.open(reopened));
+        REQUIRE(journal.get_stats().replayedRecords >= 200);
+        REQUIRE(ToJson(reopened) == expected);
+        REQUIRE(reopened.assetIndex.size() == reopened.assets.size());
+        REQUIRE(reopened.find_asset("uncommitted") == nullptr);
+
+        // Edits continue after reopening
+        RandomEdits(journal, reopened, gen, 30, nextId);
+        REQUIRE(journal.commit());
+        expected = SavedJson(reopened, dir / "reference.edX");
+    }
+    {
+        EdxProject again;
+        ProjectJournal journal(path, options);
+        REQUIRE(journal.open(again));
+        REQUIRE(ToJson(again) == expected);
+    }
+
+    SECTION("A commit cut short is dropped")
+    {
+        const auto journalPath = ProjectJournal::journal_path(path);
+        const auto size = std::filesystem::file_size(journalPath);
+        {
+            std::ofstream file(journalPath, std::ios::binary | std::ios::app);
+            file << "{\"op\":\"put-asset\",\"asset\":{\"id\":\"torn\",\"lat";
+        }
+
+        {
+            EdxProject recovered;
+            ProjectJournal journal(path, options);
+            REQUIRE(journal.open(recovered));
+            REQUIRE(ToJson(recovered) == expected);
+            REQUIRE(std::filesystem::file_size(journalPath) == size);
+
+            REQUIRE(journal.put_asset(recovered, MakeAsset("after_tear", 47.0, -122.0)));
+            REQUIRE(journal.commit());
+        }
+
+        EdxProject again;
+        ProjectJournal journal(path, options);
+        REQUIRE(journal.open(again));
+        REQUIRE(again.find_asset("after_tear") != nullptr);
+        REQUIRE(again.find_asset("torn") == nullptr);
+    }
+
+    SECTION("A journal for another base is ignored")
+    {
+        REQUIRE(MakeProject(10).save_to_file(path));
+
+        EdxProject replaced;
+        ProjectJournal journal(path, options);
+        REQUIRE(journal.open(replaced));
+        REQUIRE(replaced.assets.size() == 10);
+        REQUIRE(journal.get_stats().replayedRecords == 0);
+    }
+
+    SECTION("A corrupt record fails the open")
+    {
+        {
+            std::ofstream file(ProjectJournal::journal_path(path), std::ios::binary | std::ios::app);
+            file << "not json\n{\"op\":\"remove-asset\",\"id\":\"asset_1\"}\n";
+        }
+
+        EdxProject untouched;
+        untouched.project.name = "Untouched";
+        ProjectJournal journal(path, options);
+        REQUIRE_FALSE(journal.open(untouched));
+        REQUIRE_FALSE(journal.get_error().empty());
+        REQUIRE(untouched.project.name == "Untouched");
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("Journal compaction", "[project][journal]")
+{
+    using namespace EdxTests::ProjectJournalTests;
+
+    const auto dir = TempDir("edx_journal_compact");
+    const auto path = dir / "airport.edX";
+    const auto journalPath = ProjectJournal::journal_path(path);
+
+    JournalOptions options;
+    options.compactThreshold = 0;
+
+    EdxProject live = MakeProject(2000);
+    std::mt19937 gen(9);
+    int nextId = 0;
+
+    const std::filesystem::path oldJournal = dir / "old.journal";
+    {
+        ProjectJournal journal(path, options);
+        REQUIRE(journal.create(live));
+        RandomEdits(journal, live, gen, 300, nextId);
+        REQUIRE(journal.commit());
+        const auto journalBefore = std::filesystem::file_size(journalPath);
+        std::filesystem::copy_file(journalPath, oldJournal);
+
+        // Edits keep being committed while the compaction runs
+        REQUIRE(journal.compact());
+        REQUIRE_FALSE(journal.compact());
+        RandomEdits(journal, live, gen, 50, nextId);
+        REQUIRE(journal.commit());
+        REQUIRE(journal.wait_for_compaction());
+        RandomEdits(journal, live, gen, 20, nextId);
+        REQUIRE(journal.commit());
+
+        REQUIRE(journal.get_stats().compactions == 1);
+        REQUIRE(std::filesystem::file_size(journalPath) < journalBefore);
+        REQUIRE_FALSE(std::filesystem::exists(dir / "airport.edX.compact"));
+    }
+
+    const json expected = SavedJson(live, dir / "reference.edX");
+    {
+        EdxProject reopened;
+        ProjectJournal journal(path, options);
+        REQUIRE(journal.open(reopened));
+        REQUIRE(ToJson(reopened) == expected);
+    }
+
+    SECTION("The base is canonical pretty JSON")
+    {
+        {
+            EdxProject project;
+            ProjectJournal journal(path, options);
+            REQUIRE(journal.open(project));
+            REQUIRE(journal.compact());
+            REQUIRE(journal.wait_for_compaction());
+        }
+
+        EdxProject base;
+        REQUIRE(base.load_from_file(path));
+        REQUIRE(ToJson(base) == expected);
+
+        std::ifstream file(path);
+        std::stringstream text;
+        text << file.rdbuf();
+        REQUIRE(text.str() == expected.dump(4));
+    }
+
+    SECTION("Interrupted between replacing the base and the journal")
+    {
+        // The state a crash after the first rename leaves: new base, old journal, new journal beside it
+        std::filesystem::rename(journalPath, ProjectJournal::journal_path(path).string() + ".tmp");
+        std::filesystem::copy_file(oldJournal, journalPath);
+
+        EdxProject recovered;
+        ProjectJournal journal(path, options);
+        REQUIRE(journal.open(recovered));
+        REQUIRE(ToJson(recovered) == expected);
+        REQUIRE_FALSE(std::filesystem::exists(ProjectJournal::journal_path(path).string() + ".tmp"));
+    }
+
+    SECTION("Compaction starts on its own past the threshold")
+    {
+        JournalOptions small;
+        small.compactThreshold = 16 * 1024;
+
+        EdxProject project;
+        ProjectJournal journal(path, small);
+        REQUIRE(journal.open(project));
+        for (int i = 0; i < 20 && journal.get_stats().compactions == 0; ++i)
+        {
+            RandomEdits(journal, project, gen, 50, nextId);
+            REQUIRE(journal.commit());
+            REQUIRE(journal.wait_for_compaction());
+        }
+        REQUIRE(journal.get_stats().compactions > 0);
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("EdxManager keeps committed journal edits", "[project][journal][manager]")
+{
+    using namespace EdxTests::ProjectJournalTests;
+
+    const auto dir = TempDir("edx_journal_manager");
+    const auto path = dir / "airport.edX";
+
+    JournalOptions options;
+    options.compactThreshold = 0;
+
+    EdxProject live = MakeProject(100);
+    {
+        ProjectJournal journal(path, options);
+        REQUIRE(journal.create(live));
+
+        SceneAsset moved = *live.find_asset("asset_5");
+        moved.heading = 270.0;
+        REQUIRE(journal.put_asset(live, moved));
+        REQUIRE(journal.put_asset(live, MakeAsset("journaled", 47.46, -122.30)));
+        REQUIRE(journal.remove_asset(live, "asset_7"));
+        REQUIRE(journal.commit());
+    }
+    const json expected = SavedJson(live, dir / "reference.edX");
+
+    EdxManager manager;
+    auto loaded = manager.load_project(path.string());
+    REQUIRE(loaded != nullptr);
+    REQUIRE(ToJson(*loaded) == expected);
+
+    SECTION("Saving over the project folds the journal in")
+    {
+        // The base alone does not hold the edits yet
+        EdxProject base;
+        REQUIRE(base.load_from_file(path));
+        REQUIRE(base.find_asset("journaled") == nullptr);
+        REQUIRE(manager.save_project(*loaded, path.string()));
+
+        auto reloaded = manager.load_project(path.string());
+        REQUIRE(reloaded != nullptr);
+        REQUIRE(reloaded->find_asset("journaled") != nullptr);
+        REQUIRE(reloaded->find_asset("asset_5")->heading == 270.0);
+        REQUIRE(reloaded->find_asset("asset_7") == nullptr);
+
+        // The base holds the edits now, and reopening the journal replays nothing more
+        EdxProject reopened;
+        ProjectJournal journal(path, options);
+        REQUIRE(journal.open(reopened));
+        REQUIRE(journal.get_stats().replayedRecords == 0);
+        REQUIRE(reopened.find_asset("journaled") != nullptr);
+    }
+
+    SECTION("A batch resave keeps the edits")
+    {
+        const BatchReport report = manager.process_batch({ { BATCH_RESAVE, path.string(), "" } });
+        REQUIRE(report.succeeded == 1);
+
+        EdxProject base;
+        REQUIRE(base.load_from_file(path));
+        REQUIRE(base.find_asset("journaled") != nullptr);
+        REQUIRE(base.find_asset("asset_7") == nullptr);
+    }
+
+    SECTION("A corrupt journal fails the load and the save")
+    {
+        {
+            std::ofstream file(ProjectJournal::journal_path(path), std::ios::binary | std::ios::app);
+            file << "not json\n";
+        }
+
+        REQUIRE(manager.load_project(path.string()) == nullptr);
+        REQUIRE_FALSE(manager.save_project(*loaded, path.string()));
+        REQUIRE_FALSE(manager.get_last_error().empty());
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("Journaled save latency against edit count", "[.][project][journal][performance]")
+{
+    using namespace EdxTests::ProjectJournalTests;
+    using Clock = std::chrono::high_resolution_clock;
+    const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    const auto dir = TempDir("edx_journal_benchmark");
+    const auto path = dir / "airport.edX";
+
+    JournalOptions options;
+    options.compactThreshold = 0;
+
+    EdxProject project = MakeProject(200000);
+
+    auto start = Clock::now();
+    REQUIRE(project.save_to_file(dir / "full.edX"));
+    const double fullSaveMs = ms(start);
+
+    ProjectJournal journal(path, options);
+    REQUIRE(journal.create(project));
+
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<size_t> pick(0, project.assets.size() - 1);
+    std::ostringstream report;
+    for (const int edits : { 1, 10, 100, 1000, 10000 })
+    {
+        for (int e = 0; e < edits; ++e)
+        {
+            SceneAsset asset = project.assets[pick(gen)];
+            asset.latitude += 1e-6;
+            journal.put_asset(project, asset);
+        }
+
+        start = Clock::now();
+        REQUIRE(journal.commit());
+        const double commitMs = ms(start);
+        report << edits << " edits: " << commitMs << " ms; ";
+    }
+
+    start = Clock::now();
+    EdxProject reopened;
+    ProjectJournal second(path, options);
+    REQUIRE(second.open(reopened));
+    const double openMs = ms(start);
+
+    start = Clock::now();
+    REQUIRE(second.compact());
+    REQUIRE(second.wait_for_compaction());
+    const double compactMs = ms(start);
+
+    INFO("Full save of " << project.assets.size() << " assets: " << fullSaveMs << " ms");
+    INFO("Journal commit: " << report.str());
+    INFO("Open with " << second.get_stats().replayedRecords << " records to replay: " << openMs << " ms");
+    INFO("Background compaction: " << compactMs << " ms");
+    CHECK(reopened.assets.size() == project.assets.size());
+
+    std::filesystem::remove_all(dir);
+}
+
+/// -------------------------------------------------------
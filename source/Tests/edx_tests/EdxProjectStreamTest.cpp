@@ -0,0 +1,466 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX Project Stream Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* EdxProjectStreamTest.cpp
+* -------------------------------------------------------
+* Tests and load benchmark for the streaming project reader
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../edX/edXConfig.h"
+#include "../../edX/edXManager.h"
+#include "../../edX/edXProjectFile.h"
+#include "../../edX/edXProjectStream.h"
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(__linux__)
+    #include <unistd.h>
+#endif
+
+/// -------------------------------------------------------
+
+using namespace edx;
+
+namespace EdxTests
+{
+namespace ProjectStreamTests
+{
+// Assets with the kind of free form properties the demo generator writes
+SceneAsset MakeAsset(size_t i)
+{
+    SceneAsset asset;
+    asset.id = "asset_" + std::to_string(i);
+    asset.uniqueId = std::to_string(0x5EED0000u + i * 2654435761u);
+    asset.latitude = 37.6 + double(i % 1000) * 1e-5;
+    asset.longitude = -122.4 + double(i / 1000 % 1000) * 1e-5;
+    asset.altitude = 13.0 + double(i % 7);
+    asset.heading = double(i % 360);
+    asset.associatedLibrary = (i % 2) ? "xp_default" : "edx_demo";
+    asset.layerId = "layer_" + std::to_string(i % 3);
+    asset.locked = (i % 5) == 0;
+    asset.hidden = (i % 11) == 0;
+
+    switch (i % 3)
+    {
+        case 0:
+            asset.otherProperties["light_type"] = "runway_edge";
+            asset.otherProperties["intensity"] = 100;
+            asset.otherProperties["runway_number"] = std::to_string(i % 36 + 1);
+            break;
+        case 1:
+            asset.otherProperties["vehicle_id"] = "GSE-" + std::to_string(1000 + i);
+            asset.otherProperties["operational"] = (i % 5 != 0);
+            asset.otherProperties["object_type"] = "pushback_tug";
+            break;
+        default:
+            break;
+    }
+    return asset;
+}
+
+EdxProject MakeProject(size_t assetCount)
+{
+    EdxProject project;
+    project.project.name = "Stream Test \"Project\"";
+    project.project.editorVersion = VERSION;
+    project.project.author = "Tester \xC3\xA9\xE2\x82\xAC";
+    project.project.createDate = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+    project.project.editDate = project.project.createDate;
+    project.airport.name = "San Francisco International";
+    project.airport.icao = "KSFO";
+    project.airport.datumLat = 37.6188;
+    project.airport.datumLon = -122.375;
+    project.airport.elevation = 13;
+    project.airport.tower = std::make_unique<double>(120.5);
+
+    LibraryReference library;
+    library.name = "X-Plane Default";
+    library.shortId = "xp_default";
+    library.entryCount = 42;
+    project.libraries.push_back(library);
+
+    for (size_t i = 0; i < assetCount; ++i)
+        project.assets.push_back(MakeAsset(i));
+
+    // Values the chunk scanner has to step over: brackets, commas and escapes inside strings
+    project.assets[1].otherProperties["notes"] = "a, [b] {c} \"d\" \\ e\n";
+    project.assets[2].otherProperties["nested"] = { { "list", { 1, 2.5, "x", nullptr, { { "deep", { true, false } } } } }, { "empty", json::object() } };
+    project.assets[3].otherProperties = json::array({ 1, 2, 3 });
+
+    for (int l = 0; l < 3; ++l)
+    {
+        SceneLayer layer;
+        layer.layerId = "layer_" + std::to_string(l);
+        layer.name = "Layer " + std::to_string(l);
+        layer.opacity = 0.25 * (l + 1);
+        layer.zOrder = l;
+        for (size_t i = l; i < assetCount; i += 3)
+            layer.assetIds.push_back(project.assets[i].id);
+        layer.layerProperties["colour"] = { l, 255 - l, 0 };
+        project.layers.push_back(layer);
+    }
+
+    project.settings["units"] = "metric";
+    project.settings["snap"] = { { "enabled", true }, { "step", 0.5 } };
+    project.rebuild_asset_index();
+    return project;
+}
+
+json ToJson(const EdxProject& project)
+{
+    json j;
+    project.to_json(j);
+    return j;
+}
+
+std::filesystem::path TempPath(const std::string& name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+void WriteText(const std::filesystem::path& path, const std::string& text)
+{
+    std::ofstream file(path, std::ios::binary);
+    file << text;
+}
+
+bool LoadText(const std::string& text, EdxProject& project, ProjectStreamOptions options = {})
+{
+    std::istringstream stream(text);
+    ProjectStreamReader reader(std::move(options));
+    return reader.load(stream, text.size(), project);
+}
+
+// Resident set size of this process, 0 where it cannot be read
+size_t CurrentRss()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters = {};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.WorkingSetSize;
+    return 0;
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    if (statm >> pages >> resident)
+        return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return 0;
+#else
+    return 0;
+#endif
+}
+
+// Samples the resident set size on a thread to find the peak of one operation
+class PeakRssSampler
+{
+public:
+    PeakRssSampler() : m_baseline(CurrentRss()), m_peak(m_baseline)
+    {
+        m_thread = std::thread([this] {
+            while (!m_stop)
+            {
+                m_peak = std::max(m_peak.load(), CurrentRss());
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        });
+    }
+
+    // Growth over the RSS at construction
+    size_t stop()
+    {
+        m_stop = true;
+        m_thread.join();
+        m_peak = std::max(m_peak.load(), CurrentRss());
+        return m_peak - std::min(m_peak.load(), m_baseline);
+    }
+
+private:
+    size_t m_baseline;
+    std::atomic<size_t> m_peak;
+    std::atomic<bool> m_stop { false };
+    std::thread m_thread;
+};
+
+} // namespace ProjectStreamTests
+} // namespace EdxTests
+
+/// -------------------------------------------------------
+
+TEST_CASE("Streaming loader matches the DOM loader", "[project][stream]")
+{
+    using namespace EdxTests::ProjectStreamTests;
+
+    const EdxProject source = MakeProject(500);
+    const json expected = ToJson(source);
+
+    // Pretty and compact text, read in tiny blocks and cut into tiny chunks so
+    // that every boundary lands inside strings, numbers and nested values
+    for (const int indent : { 4, -1 })
+    {
+        const std::string text = expected.dump(indent);
+
+        EdxProject dom;
+        dom.from_json(json::parse(text));
+        REQUIRE(ToJson(dom) == expected);
+
+        for (const size_t chunk : { size_t(1), size_t(97), size_t(4096), size_t(1) << 22 })
+        {
+            for (const size_t block : { size_t(64), size_t(1000), size_t(1) << 20 })
+            {
+                ProjectStreamOptions options;
+                options.assetChunkSize = chunk;
+                options.readBlockSize = block;
+                options.threadCount = 3;
+
+                EdxProject streamed;
+                INFO("indent " << indent << ", chunk " << chunk << ", block " << block);
+                REQUIRE(LoadText(text, streamed, options));
+                REQUIRE(ToJson(streamed) == ToJson(dom));
+                REQUIRE(streamed.assetIndex.size() == source.assets.size());
+                REQUIRE(streamed.find_asset("asset_42") == &streamed.assets[42]);
+                REQUIRE(streamed.airport.tower != nullptr);
+                REQUIRE(streamed.airport.ctaf == nullptr);
+            }
+        }
+    }
+
+    SECTION("Through load_from_file")
+    {
+        const auto path = TempPath("edx_stream_roundtrip.edX");
+        REQUIRE(source.save_to_file(path));
+
+        EdxProject loaded;
+        REQUIRE(loaded.load_from_file(path));
+        REQUIRE(ToJson(loaded) == expected);
+        std::filesystem::remove(path);
+    }
+
+    SECTION("Escaped keys, a byte order mark and missing sections")
+    {
+        EdxProject project;
+        REQUIRE(LoadText("\xEF\xBB\xBF{\"Proj\\u0065ct\": {\"name\": \"Escaped\"}, \"Unknown\": [1, {\"a\": \"]\"}], \"Assets\": [{\"id\": \"a\", \"heading\": 90, \"extra\": {\"x\": [1]}}]}", project));
+        REQUIRE(project.project.name == "Escaped");
+        REQUIRE(project.assets.size() == 1);
+        REQUIRE(project.assets[0].heading == 90.0);
+        REQUIRE(project.assets[0].otherProperties.is_null());
+        REQUIRE(project.layers.empty());
+        REQUIRE(project.settings.is_null());
+
+        REQUIRE(LoadText("{}", project));
+        REQUIRE(project.assets.empty());
+        REQUIRE(LoadText("{\"Assets\": []}", project));
+        REQUIRE(LoadText("{\"Settings\": 5}", project));
+        REQUIRE(project.settings == 5);
+    }
+}
+
+TEST_CASE("Streaming loader reports byte progress", "[project][stream]")
+{
+    using namespace EdxTests::ProjectStreamTests;
+
+    const std::string text = ToJson(MakeProject(2000)).dump(4);
+
+    std::vector<std::pair<uint64_t, uint64_t>> calls;
+    ProjectStreamOptions options;
+    options.readBlockSize = 4096;
+    options.assetChunkSize = 16384;
+    options.threadCount = 2;
+    options.progress = [&calls](uint64_t done, uint64_t total) { calls.emplace_back(done, total); };
+
+    EdxProject project;
+    REQUIRE(LoadText(text, project, options));
+    REQUIRE(calls.size() > 20);
+    REQUIRE(calls.back().first == text.size());
+    for (size_t i = 0; i < calls.size(); ++i)
+    {
+        REQUIRE(calls[i].second == text.size());
+        if (i > 0)
+            REQUIRE(calls[i].first >= calls[i - 1].first);
+    }
+
+    SECTION("Through EdxManager")
+    {
+        const auto path = TempPath("edx_stream_progress.edX");
+        WriteText(path, text);
+
+        std::vector<float> fractions;
+        EdxManager manager;
+        auto loaded = manager.load_project(path.string(), [&fractions](float progress, const std::string&) { fractions.push_back(progress); });
+        REQUIRE(loaded != nullptr);
+        REQUIRE(loaded->assets.size() == 2000);
+        REQUIRE(fractions.size() > 3);
+        REQUIRE(std::is_sorted(fractions.begin(), fractions.end()));
+        REQUIRE(fractions.back() == 1.0f);
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_CASE("Streaming loader rejects malformed projects", "[project][stream]")
+{
+    using namespace EdxTests::ProjectStreamTests;
+
+    const std::string valid = ToJson(MakeProject(50)).dump();
+
+    ProjectStreamOptions options;
+    options.assetChunkSize = 64;
+    options.readBlockSize = 128;
+
+    // Long enough that the Assets array is cut before the trailing comma
+    std::string cutTrailingComma = "{\"Assets\": [";
+    for (int i = 0; i < 20; ++i)
+        cutTrailingComma += "{\"id\": \"asset_with_a_long_enough_id_" + std::to_string(i) + "\"},";
+    cutTrailingComma += "]}";
+
+    const std::vector<std::string> inputs = {
+        "",
+        cutTrailingComma,
+        "[]",
+        valid.substr(0, valid.size() / 2),
+        valid.substr(0, valid.size() - 1),
+        valid + " x",
+        "{\"Assets\": {}}",
+        "{\"Assets\": [{\"id\": \"a\"},]}",
+        "{\"Assets\": [{\"id\": \"a\"}, {\"id\": \"b\"},   ]}",
+        "{\"Assets\": [{\"id\": \"a\"}}",
+        "{\"Assets\": [{\"id\": \"a\", \"latitude\": \"north\"}]}",
+        "{\"Assets\": [{\"id\": 5}]}",
+        "{\"Assets\": [{\"id\": \"a\", \"locked\": 1}]}",
+        "{\"Assets\": [[1, 2]]}",
+        "{\"Assets\": [{\"id\": \"a\", \"latitude\": [1]}]}",
+        "{\"Layers\": [{\"asset-ids\": \"a\"}]}",
+        "{\"Layers\": [{\"asset-ids\": [1]}]}",
+        "{\"Airport\": {\"DatumLat\": \"x\"}}",
+        "{\"Project\" {}}",
+        "{\"Project\": {}, }",
+        "{\"Unknown\": [1, 2}",
+    };
+
+    for (const std::string& input : inputs)
+    {
+        INFO(input.substr(0, 120));
+
+        EdxProject project;
+        project.project.name = "Untouched";
+
+        std::istringstream stream(input);
+        ProjectStreamReader reader(options);
+        REQUIRE_FALSE(reader.load(stream, input.size(), project));
+        REQUIRE_FALSE(reader.get_error().empty());
+        REQUIRE(project.project.name == "Untouched");
+    }
+
+    ProjectStreamReader reader;
+    EdxProject project;
+    REQUIRE_FALSE(reader.load(TempPath("edx_stream_missing.edX"), project));
+    REQUIRE_FALSE(reader.get_error().empty());
+}
+
+TEST_CASE("Streaming and DOM load of a 1M asset project", "[.][project][stream][performance]")
+{
+    using namespace EdxTests::ProjectStreamTests;
+    using Clock = std::chrono::high_resolution_clock;
+    const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+    constexpr size_t assetCount = 1000000;
+
+    // Written an asset at a time, in save_to_file's layout, so the generator
+    // itself never holds a document of the whole project
+    const auto path = TempPath("edx_stream_benchmark.edX");
+    {
+        EdxProject header = MakeProject(3);
+        header.assets.clear();
+        header.layers.clear();
+        json j = ToJson(header);
+        j.erase("Assets");
+        j.erase("Layers");
+
+        std::ofstream file(path, std::ios::binary);
+        std::string text = j.dump(4);
+        text.resize(text.size() - 2);
+        file << text << ",\n    \"Assets\": [\n";
+        for (size_t i = 0; i < assetCount; ++i)
+        {
+            json asset;
+            MakeAsset(i).to_json(asset);
+            file << (i ? ",\n" : "") << asset.dump(4);
+        }
+
+        json layers = json::array();
+        for (int l = 0; l < 3; ++l)
+        {
+            SceneLayer layer;
+            layer.layerId = "layer_" + std::to_string(l);
+            layer.name = "Layer " + std::to_string(l);
+            for (size_t i = l; i < assetCount; i += 3)
+                layer.assetIds.push_back("asset_" + std::to_string(i));
+            json layerJson;
+            layer.to_json(layerJson);
+            layers.push_back(std::move(layerJson));
+        }
+        file << "\n    ],\n    \"Layers\": " << layers.dump(4) << "\n}\n";
+    }
+    const double fileMb = double(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+    // Streaming first: peak RSS is sampled, but allocator caches left by the
+    // larger DOM load would otherwise hide part of the streaming load's growth
+    double streamMs = 0.0;
+    size_t streamPeak = 0;
+    size_t chunks = 0;
+    {
+        PeakRssSampler sampler;
+        const auto start = Clock::now();
+        EdxProject project;
+        ProjectStreamReader reader;
+        REQUIRE(reader.load(path, project));
+        streamMs = ms(start);
+        streamPeak = sampler.stop();
+        chunks = reader.get_stats().assetChunks;
+        REQUIRE(project.assets.size() == assetCount);
+        REQUIRE(project.layers.size() == 3);
+        REQUIRE(project.find_asset("asset_999999") != nullptr);
+    }
+
+    double domMs = 0.0;
+    size_t domPeak = 0;
+    {
+        PeakRssSampler sampler;
+        const auto start = Clock::now();
+        EdxProject project;
+        {
+            std::ifstream file(path);
+            json j;
+            file >> j;
+            project.from_json(j);
+        }
+        domMs = ms(start);
+        domPeak = sampler.stop();
+        REQUIRE(project.assets.size() == assetCount);
+    }
+    std::filesystem::remove(path);
+
+    const double mb = 1024.0 * 1024.0;
+    INFO("File: " << fileMb << " MB, " << assetCount << " assets, " << std::thread::hardware_concurrency() << " hardware threads");
+    INFO("Streaming: " << streamMs << " ms, peak RSS +" << streamPeak / mb << " MB, " << chunks << " chunks");
+    INFO("DOM: " << domMs << " ms, peak RSS +" << domPeak / mb << " MB");
+    CHECK(chunks > 1);
+}
+
+/// -------------------------------------------------------
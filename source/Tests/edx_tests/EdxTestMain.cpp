@@ -21,8 +21,14 @@
 //  - EdxProjectFileTest.cpp    - Tests for edX project file operations
 //  - EdxLibraryFileTest.cpp    - Tests for edX library file operations
 //  - EdxManagerTest.cpp        - Tests for EdxManager high-level API
+//  - EdxGeoIndexTest.cpp       - Tests and benchmark for the asset spatial index
+//  - EdxProjectStreamTest.cpp  - Tests and load benchmark for the streaming project reader
+//  - EdxProjectJournalTest.cpp - Tests and save latency benchmark for journaled saves
+//  - EdxProjectBinaryTest.cpp  - Tests and load benchmark for the .edXb companion format
+//  - EdxLibraryIndexTest.cpp   - Tests and keystroke latency benchmark for the library object index
+//  - EdxValidationTest.cpp     - Tests and benchmark for incremental project and library validation
+//  - EdxBatchTest.cpp          - Tests, contention tests and throughput benchmark for batch processing
 //  - EdxSerializationTest.cpp  - Tests for JSON serialization/deserialization
-//  - EdxValidationTest.cpp     - Tests for data validation
 //  - EdxIntegrationTest.cpp    - Integration tests and file generation
 
 // To run specific tests, use the command line arguments:
@@ -0,0 +1,410 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX Validation Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* EdxValidationTest.cpp
+* -------------------------------------------------------
+* Tests and benchmark for incremental project and library validation
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "../../edX/edXConfig.h"
+#include "../../edX/edXLibraryFile.h"
+#include "../../edX/edXProjectFile.h"
+#include "../../edX/edXValidation.h"
+
+/// -------------------------------------------------------
+
+using namespace edx;
+
+namespace EdxTests
+{
+namespace ValidationTests
+{
+// The checks get_validation_errors() made before the validators, kept to compare against
+std::vector<std::string> ReferenceProjectErrors(const EdxProject& project)
+{
+    std::vector<std::string> errors;
+    if (project.project.name.empty())
+        errors.push_back("Project name cannot be empty");
+    if (project.project.editorVersion.empty())
+        errors.push_back("Editor version cannot be empty");
+    if (project.airport.icao.empty())
+        errors.push_back("Airport ICAO code cannot be empty");
+    if (project.airport.icao.length() != 4)
+        errors.push_back("Airport ICAO code must be 4 characters");
+    if (project.airport.datumLat < -90.0 || project.airport.datumLat > 90.0)
+        errors.push_back("Airport latitude must be between -90 and 90 degrees");
+    if (project.airport.datumLon < -180.0 || project.airport.datumLon > 180.0)
+        errors.push_back("Airport longitude must be between -180 and 180 degrees");
+    for (const auto& lib : project.libraries)
+    {
+        if (lib.name.empty())
+            errors.push_back("Library name cannot be empty");
+        if (lib.shortId.empty())
+            errors.push_back("Library short-id cannot be empty");
+    }
+    for (const auto& asset : project.assets)
+    {
+        if (asset.id.empty())
+            errors.push_back("Asset ID cannot be empty");
+        if (asset.latitude < -90.0 || asset.latitude > 90.0)
+            errors.push_back("Asset latitude must be between -90 and 90 degrees");
+        if (asset.longitude < -180.0 || asset.longitude > 180.0)
+            errors.push_back("Asset longitude must be between -180 and 180 degrees");
+        if (asset.heading < 0.0 || asset.heading >= 360.0)
+            errors.push_back("Asset heading must be between 0 and 360 degrees");
+    }
+    return errors;
+}
+
+std::vector<std::string> ReferenceLibraryErrors(const LibraryFile& library)
+{
+    std::vector<std::string> errors;
+    if (library.library.name.empty())
+        errors.push_back("Library name cannot be empty");
+    if (library.library.version.empty())
+        errors.push_back("Library version cannot be empty");
+    if (library.library.author.empty())
+        errors.push_back("Library author cannot be empty");
+
+    std::set<std::string> usedIds;
+    std::set<std::string> usedUniqueIds;
+    for (const auto& obj : library.objects)
+    {
+        if (obj.id.empty())
+            errors.push_back("Object ID cannot be empty");
+        else
+        {
+            if (usedIds.contains(obj.id))
+                errors.push_back("Duplicate object ID: " + obj.id);
+            usedIds.insert(obj.id);
+        }
+        if (obj.uniqueId.empty())
+            errors.push_back("Object unique ID cannot be empty");
+        else
+        {
+            if (usedUniqueIds.contains(obj.uniqueId))
+                errors.push_back("Duplicate object unique ID: " + obj.uniqueId);
+            usedUniqueIds.insert(obj.uniqueId);
+        }
+        if (obj.assetType.empty())
+            errors.push_back("Object asset type cannot be empty for object: " + obj.id);
+        if (obj.name.empty())
+            errors.push_back("Object name cannot be empty for object: " + obj.id);
+    }
+    return errors;
+}
+
+LibraryReference MakeReference(const std::string& name, const std::string& shortId)
+{
+    LibraryReference reference;
+    reference.name = name;
+    reference.shortId = shortId;
+    return reference;
+}
+
+// Roughly one asset in twenty carries an error
+void RandomizeAsset(SceneAsset& asset, std::mt19937& gen)
+{
+    std::uniform_int_distribution<int> roll(0, 99);
+    asset.latitude = roll(gen) == 0 ? 95.0 : 47.0 + roll(gen) * 0.001;
+    asset.longitude = roll(gen) == 0 ? -181.0 : -122.0 - roll(gen) * 0.001;
+    asset.heading = roll(gen) == 0 ? 360.0 : roll(gen) * 3.5;
+    if (roll(gen) == 0)
+        asset.id.clear();
+}
+
+EdxProject MakeProject(size_t assetCount, uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    EdxProject project;
+    project.project.name = "Validation Test";
+    project.project.editorVersion = "1.0.0";
+    project.airport.icao = "KSEA";
+    project.libraries.push_back(MakeReference("Default Library", "lib"));
+    project.libraries.push_back(MakeReference("Vehicles", "veh"));
+
+    project.assets.resize(assetCount);
+    for (size_t i = 0; i < assetCount; ++i)
+    {
+        SceneAsset& asset = project.assets[i];
+        asset.id = "asset_" + std::to_string(i);
+        asset.associatedLibrary = i % 2 ? "lib" : "veh";
+        RandomizeAsset(asset, gen);
+    }
+
+    for (size_t layer = 0; layer < 8; ++layer)
+    {
+        SceneLayer entry;
+        entry.layerId = "layer_" + std::to_string(layer);
+        for (size_t i = layer; i < assetCount; i += 8)
+            entry.assetIds.push_back("asset_" + std::to_string(i));
+        project.layers.push_back(entry);
+    }
+    project.rebuild_asset_index();
+    return project;
+}
+
+LibraryFile MakeLibrary(size_t objectCount, uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> roll(0, 49);
+    LibraryFile library;
+    library.library.name = "Validation Library";
+    library.library.version = "1.0.0";
+    library.library.author = "Tests";
+    library.objects.resize(objectCount);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        LibraryObject& obj = library.objects[i];
+        obj.id = roll(gen) == 0 ? "shared" : "obj_" + std::to_string(i);
+        obj.uniqueId = roll(gen) == 0 ? std::string() : "uid_" + std::to_string(i);
+        obj.name = roll(gen) == 0 ? std::string() : "Object";
+        obj.assetType = roll(gen) == 0 ? std::string() : "prop";
+    }
+    return library;
+}
+
+} // namespace ValidationTests
+} // namespace EdxTests
+
+/// -------------------------------------------------------
+
+TEST_CASE("ProjectValidator matches the existing project checks", "[validation][project]")
+{
+    using namespace EdxTests::ValidationTests;
+
+    EdxProject project = MakeProject(2000, 1);
+    project.airport.icao = "KSE";
+    project.libraries.push_back(MakeReference("", ""));
+
+    SECTION("A full pass")
+    {
+        ProjectValidator validator;
+        REQUIRE(validator.validate(project) == ReferenceProjectErrors(project));
+        REQUIRE(validator.get_stats().fullPass);
+        REQUIRE(project.get_validation_errors() == ReferenceProjectErrors(project));
+    }
+
+    SECTION("A parallel pass")
+    {
+        ValidationOptions options;
+        options.threadCount = 4;
+        options.parallelThreshold = 0;
+        ProjectValidator validator(options);
+        REQUIRE(validator.validate(project) == ReferenceProjectErrors(project));
+    }
+
+    SECTION("Only marked assets are checked again")
+    {
+        ProjectValidator validator;
+        validator.validate(project);
+
+        std::mt19937 gen(2);
+        std::uniform_int_distribution<size_t> pick(0, project.assets.size() - 1);
+        for (int round = 0; round < 20; ++round)
+        {
+            for (int edit = 0; edit < 5; ++edit)
+            {
+                const size_t index = pick(gen);
+                RandomizeAsset(project.assets[index], gen);
+                validator.mark_asset_dirty(index);
+            }
+            REQUIRE(validator.validate(project) == ReferenceProjectErrors(project));
+            REQUIRE_FALSE(validator.get_stats().fullPass);
+            REQUIRE(validator.get_stats().checkedEntities <= 5);
+        }
+
+        // Fields outside the assets are checked on every call
+        project.project.name.clear();
+        REQUIRE(validator.validate(project) == ReferenceProjectErrors(project));
+    }
+
+    SECTION("A change in the asset count triggers a full pass")
+    {
+        ProjectValidator validator;
+        validator.validate(project);
+
+        SceneAsset asset;
+        asset.id = "added";
+        asset.heading = 400.0;
+        project.add_asset(asset);
+        REQUIRE(validator.validate(project) == ReferenceProjectErrors(project));
+        REQUIRE(validator.get_stats().fullPass);
+    }
+}
+
+TEST_CASE("ProjectValidator reference checks", "[validation][project]")
+{
+    using namespace EdxTests::ValidationTests;
+
+    EdxProject project = MakeProject(40, 3);
+    for (size_t i = 0; i < project.assets.size(); ++i)
+        project.assets[i].id = "asset_" + std::to_string(i);
+    project.assets[5].associatedLibrary = "missing";
+    project.assets[7].id = "asset_6";
+    project.layers[0].assetIds.push_back("ghost");
+    project.rebuild_asset_index();
+
+    ValidationOptions options;
+    options.checkReferences = true;
+    ProjectValidator validator(options);
+
+    const auto errors = validator.validate(project);
+    const auto has = [](const std::vector<std::string>& list, const std::string& error) { return std::find(list.begin(), list.end(), error) != list.end(); };
+
+    REQUIRE(has(errors, "Asset asset_5 references unknown library: missing"));
+    REQUIRE(has(errors, "Duplicate asset ID: asset_6"));
+    REQUIRE(has(errors, "Layer layer_0 references missing asset: ghost"));
+    // asset_7 is listed by layer_7 but no asset has that id any more
+    REQUIRE(has(errors, "Layer layer_7 references missing asset: asset_7"));
+
+    // The default options leave the reference errors out
+    REQUIRE(ProjectValidator().validate(project) == ReferenceProjectErrors(project));
+
+    SECTION("Renaming an asset settles duplicates and layers without a full pass")
+    {
+        project.assets[7].id = "asset_7";
+        validator.mark_asset_dirty(7);
+        const auto after = validator.validate(project);
+        REQUIRE_FALSE(validator.get_stats().fullPass);
+        REQUIRE_FALSE(has(after, "Duplicate asset ID: asset_6"));
+        REQUIRE_FALSE(has(after, "Layer layer_7 references missing asset: asset_7"));
+        REQUIRE(has(after, "Layer layer_0 references missing asset: ghost"));
+
+        project.assets[7].id = "ghost";
+        validator.mark_asset_dirty(7);
+        const auto renamed = validator.validate(project);
+        REQUIRE_FALSE(has(renamed, "Layer layer_0 references missing asset: ghost"));
+        REQUIRE(has(renamed, "Layer layer_7 references missing asset: asset_7"));
+        ProjectValidator fresh(options);
+        REQUIRE(renamed == fresh.validate(project));
+    }
+
+    SECTION("Edited layers and libraries are picked up")
+    {
+        project.layers[0].assetIds.pop_back();
+        validator.mark_layer_dirty(0);
+        REQUIRE_FALSE(has(validator.validate(project), "Layer layer_0 references missing asset: ghost"));
+        REQUIRE(validator.get_stats().checkedEntities == 1);
+
+        project.libraries.push_back(MakeReference("Extra", "missing"));
+        REQUIRE_FALSE(has(validator.validate(project), "Asset asset_5 references unknown library: missing"));
+        REQUIRE(validator.get_stats().fullPass);
+    }
+}
+
+TEST_CASE("LibraryValidator matches the existing library checks", "[validation][library]")
+{
+    using namespace EdxTests::ValidationTests;
+
+    LibraryFile library = MakeLibrary(3000, 4);
+    library.library.author.clear();
+
+    LibraryValidator validator;
+    REQUIRE(validator.validate(library) == ReferenceLibraryErrors(library));
+    REQUIRE(library.get_validation_errors() == ReferenceLibraryErrors(library));
+
+    ValidationOptions options;
+    options.threadCount = 3;
+    options.parallelThreshold = 0;
+    REQUIRE(LibraryValidator(options).validate(library) == ReferenceLibraryErrors(library));
+
+    SECTION("Renames keep duplicates exact")
+    {
+        std::mt19937 gen(5);
+        std::uniform_int_distribution<size_t> pick(0, library.objects.size() - 1);
+        std::uniform_int_distribution<int> roll(0, 3);
+        for (int round = 0; round < 50; ++round)
+        {
+            for (int edit = 0; edit < 4; ++edit)
+            {
+                const size_t index = pick(gen);
+                LibraryObject& obj = library.objects[index];
+                switch (roll(gen))
+                {
+                case 0: obj.id = "shared"; break;
+                case 1: obj.id = "obj_" + std::to_string(pick(gen)); break;
+                case 2: obj.uniqueId = roll(gen) ? "uid_" + std::to_string(pick(gen)) : std::string(); break;
+                default: obj.name = roll(gen) ? "Renamed" : std::string(); break;
+                }
+                validator.mark_object_dirty(index);
+            }
+            REQUIRE(validator.validate(library) == ReferenceLibraryErrors(library));
+            REQUIRE_FALSE(validator.get_stats().fullPass);
+        }
+    }
+}
+
+TEST_CASE("Validation benchmark on 200k assets", "[.][validation][performance]")
+{
+    using namespace EdxTests::ValidationTests;
+    using Clock = std::chrono::high_resolution_clock;
+    const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    EdxProject project = MakeProject(200000, 6);
+
+    auto start = Clock::now();
+    const auto expected = ReferenceProjectErrors(project);
+    const double referenceMs = ms(start);
+
+    ProjectValidator validator;
+    start = Clock::now();
+    const auto errors = validator.validate(project);
+    const double fullMs = ms(start);
+    REQUIRE(errors == expected);
+
+    // A drag in the editor: a handful of assets change between validations
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<size_t> pick(0, project.assets.size() - 1);
+    double incrementalMs = 0.0;
+    for (int round = 0; round < 20; ++round)
+    {
+        for (int edit = 0; edit < 10; ++edit)
+        {
+            const size_t index = pick(gen);
+            project.assets[index].heading = double(round * 10 + edit);
+            validator.mark_asset_dirty(index);
+        }
+        start = Clock::now();
+        validator.validate(project);
+        incrementalMs += ms(start) / 20.0;
+    }
+    REQUIRE(validator.validate(project) == ReferenceProjectErrors(project));
+
+    ValidationOptions options;
+    options.checkReferences = true;
+    ProjectValidator referenced(options);
+    start = Clock::now();
+    const size_t referenceErrors = referenced.validate(project).size();
+    const double referencesFullMs = ms(start);
+
+    for (int edit = 0; edit < 10; ++edit)
+    {
+        const size_t index = pick(gen);
+        project.assets[index].id += "_renamed";
+        referenced.mark_asset_dirty(index);
+    }
+    start = Clock::now();
+    const auto renamed = referenced.validate(project);
+    const double referencesIncrementalMs = ms(start);
+
+    INFO("Previous full check: " << referenceMs << " ms for " << expected.size() << " errors");
+    INFO("Validator full pass: " << fullMs << " ms");
+    INFO("Validator after 10 edits: " << incrementalMs << " ms");
+    INFO("With reference checks, full pass: " << referencesFullMs << " ms (" << referenceErrors << " errors)");
+    INFO("With reference checks, after 10 renames: " << referencesIncrementalMs << " ms (" << renamed.size() << " errors)");
+    CHECK(renamed == ProjectValidator(options).validate(project));
+}
+
+/// -------------------------------------------------------
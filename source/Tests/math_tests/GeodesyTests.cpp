@@ -0,0 +1,289 @@
+﻿#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <Math/includes/geodesy.h>
+
+using namespace SceneryEditorX;
+
+namespace
+{
+    double Dms(double degrees, double minutes, double seconds)
+    {
+        const double value = std::abs(degrees) + minutes / 60.0 + seconds / 3600.0;
+        return degrees < 0.0 ? -value : value;
+    }
+
+    /// Positions spread over the globe, altitudes from below sea level to cruise.
+    std::vector<GeoPosition> RandomPositions(size_t count, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> latitude(-90.0, 90.0), longitude(-180.0, 180.0), altitude(-500.0, 15000.0);
+        std::vector<GeoPosition> positions(count);
+        for (GeoPosition &position : positions)
+            position = { latitude(rng), longitude(rng), altitude(rng) };
+        return positions;
+    }
+}
+
+TEST_CASE("GeodeticToEcef matches reference values", "[math][geodesy]") {
+    struct Reference { GeoPosition position; DVec3 ecef; };
+    const Reference references[] = {
+        { { 0.0, 0.0, 0.0 }, { WGS84::A, 0.0, 0.0 } },
+        { { 0.0, 90.0, 0.0 }, { 0.0, WGS84::A, 0.0 } },
+        { { 90.0, 0.0, 0.0 }, { 0.0, 0.0, WGS84::B } },
+        { { -90.0, 0.0, 100.0 }, { 0.0, 0.0, -WGS84::B - 100.0 } },
+        { { 47.4502, -122.3088, 131.0 }, { -2309517.4905856205, -3652053.41842692, 4675851.891760885 } },
+        { { -33.9461, 151.1772, 6.0 }, { -4640433.899208609, 2553505.3376189386, -3541491.7834880934 } },
+        { { 89.9, 45.0, 1000.0 }, { 7899.18707909042, 7899.1870790904195, 6357742.565586227 } },
+    };
+
+    for (const Reference &reference : references)
+    {
+        const DVec3 ecef = GeodeticToEcef(reference.position);
+        REQUIRE(ecef.x == Catch::Approx(reference.ecef.x).margin(1e-6));
+        REQUIRE(ecef.y == Catch::Approx(reference.ecef.y).margin(1e-6));
+        REQUIRE(ecef.z == Catch::Approx(reference.ecef.z).margin(1e-6));
+
+        const GeoPosition back = EcefToGeodetic(reference.ecef);
+        REQUIRE(back.latitude == Catch::Approx(reference.position.latitude).margin(1e-11));
+        REQUIRE(back.altitude == Catch::Approx(reference.position.altitude).margin(1e-6));
+        if (std::abs(reference.position.latitude) < 90.0)
+            REQUIRE(back.longitude == Catch::Approx(reference.position.longitude).margin(1e-11));
+    }
+}
+
+TEST_CASE("EcefToGeodetic round trips from the ground to orbit", "[math][geodesy]") {
+    double worstAngle = 0.0, worstAltitude = 0.0;
+    for (const double altitude : { -10000.0, -500.0, 0.0, 12000.0, 400000.0, 20200000.0 })
+    {
+        for (double latitude = -90.0; latitude <= 90.0; latitude += 0.37)
+        {
+            for (double longitude = -179.5; longitude < 180.0; longitude += 23.3)
+            {
+                const GeoPosition back = EcefToGeodetic(GeodeticToEcef({ latitude, longitude, altitude }));
+                worstAngle = std::max({ worstAngle, std::abs(back.latitude - latitude), std::abs(back.longitude - longitude) });
+                worstAltitude = std::max(worstAltitude, std::abs(back.altitude - altitude));
+            }
+        }
+    }
+    INFO("Worst error " << worstAngle << " degrees, " << worstAltitude << " m");
+    REQUIRE(worstAngle < 1e-11);
+    REQUIRE(worstAltitude < 1e-6);
+}
+
+TEST_CASE("GeodesicInverse reproduces Vincenty's Flinders Peak example", "[math][geodesy]") {
+    const GeoPosition flindersPeak{ Dms(-37, 57, 3.72030), Dms(144, 25, 29.52440), 0.0 };
+    const GeoPosition buninyong{ Dms(-37, 39, 10.15610), Dms(143, 55, 35.38390), 0.0 };
+
+    const GeodesicLine line = GeodesicInverse(flindersPeak, buninyong);
+    REQUIRE(line.converged);
+    REQUIRE(line.distance == Catch::Approx(54972.271).margin(1e-3));
+    REQUIRE(line.initialBearing == Catch::Approx(Dms(306, 52, 5.37)).margin(0.01 / 3600.0));
+    REQUIRE(line.finalBearing == Catch::Approx(Dms(307, 10, 25.07)).margin(0.01 / 3600.0));
+
+    const GeodesicLine back = GeodesicInverse(buninyong, flindersPeak);
+    REQUIRE(back.distance == Catch::Approx(line.distance).margin(1e-6));
+    REQUIRE(back.initialBearing == Catch::Approx(Dms(127, 10, 25.07)).margin(0.01 / 3600.0));
+
+    const GeodesicLine same = GeodesicInverse(buninyong, buninyong);
+    REQUIRE(same.converged);
+    REQUIRE(same.distance == 0.0);
+}
+
+TEST_CASE("GeodesicDirect inverts GeodesicInverse", "[math][geodesy]") {
+    const GeoPosition flindersPeak{ Dms(-37, 57, 3.72030), Dms(144, 25, 29.52440), 0.0 };
+    double finalBearing = 0.0;
+    const GeoPosition end = GeodesicDirect(flindersPeak, Dms(306, 52, 5.37), 54972.271, &finalBearing);
+    REQUIRE(end.latitude == Catch::Approx(Dms(-37, 39, 10.15610)).margin(1e-7));
+    REQUIRE(end.longitude == Catch::Approx(Dms(143, 55, 35.38390)).margin(1e-7));
+    REQUIRE(finalBearing == Catch::Approx(Dms(307, 10, 25.07)).margin(0.01 / 3600.0));
+
+    /// Long lines, across the antimeridian included.
+    const std::vector<GeoPosition> positions = RandomPositions(200, 3);
+    for (size_t i = 0; i + 1 < positions.size(); i += 2)
+    {
+        const GeoPosition from{ std::clamp(positions[i].latitude, -80.0, 80.0), positions[i].longitude, 0.0 };
+        const double bearing = std::fmod(positions[i + 1].longitude + 180.0, 360.0);
+        const double distance = 1000.0 + std::abs(positions[i + 1].latitude) * 50000.0;
+        const GeoPosition to = GeodesicDirect(from, bearing, distance);
+        REQUIRE(to.longitude > -180.0);
+        REQUIRE(to.longitude <= 180.0);
+
+        const GeodesicLine line = GeodesicInverse(from, to);
+        REQUIRE(line.converged);
+        REQUIRE(line.distance == Catch::Approx(distance).margin(1e-4));
+        REQUIRE(line.initialBearing == Catch::Approx(bearing).margin(1e-8));
+    }
+}
+
+TEST_CASE("LocalTangentPlane axes and round trips", "[math][geodesy]") {
+    const GeoPosition origin{ 47.4502, -122.3088, 131.0 };
+    const LocalTangentPlane plane(origin);
+
+    /// Orthonormal, right handed east-north-up.
+    const DVec3 &e = plane.GetEast(), &n = plane.GetNorth(), &u = plane.GetUp();
+    REQUIRE(e.x * n.x + e.y * n.y + e.z * n.z == Catch::Approx(0.0).margin(1e-15));
+    REQUIRE(e.x * u.x + e.y * u.y + e.z * u.z == Catch::Approx(0.0).margin(1e-15));
+    REQUIRE(e.y * n.z - e.z * n.y == Catch::Approx(u.x).margin(1e-15));
+    REQUIRE(e.z * n.x - e.x * n.z == Catch::Approx(u.y).margin(1e-15));
+    REQUIRE(e.x * n.y - e.y * n.x == Catch::Approx(u.z).margin(1e-15));
+
+    const DVec3 atOrigin = plane.GeodeticToEnu(origin);
+    REQUIRE(std::abs(atOrigin.x) < 1e-9);
+    REQUIRE(std::abs(atOrigin.y) < 1e-9);
+    REQUIRE(std::abs(atOrigin.z) < 1e-9);
+
+    /// Straight up is up, a little north is north.
+    REQUIRE(plane.GeodeticToEnu({ origin.latitude, origin.longitude, origin.altitude + 250.0 }).z == Catch::Approx(250.0).margin(1e-8));
+    const DVec3 north = plane.GeodeticToEnu({ origin.latitude + 0.01, origin.longitude, origin.altitude });
+    REQUIRE(std::abs(north.x) < 1e-8);
+    /// The ground distance, scaled out to the origin's 131 m altitude.
+    REQUIRE(north.y == Catch::Approx(GeodesicInverse(origin, { origin.latitude + 0.01, origin.longitude, 0.0 }).distance * (1.0 + 131.0 / 6.37e6)).epsilon(1e-6));
+
+    for (const DVec3 &enu : { DVec3(1500.0, -2200.0, 35.0), DVec3(-9000.0, 12000.0, -120.0), DVec3(0.0, 0.0, 10000.0) })
+    {
+        const DVec3 back = plane.GeodeticToEnu(plane.EnuToGeodetic(enu));
+        REQUIRE(back.x == Catch::Approx(enu.x).margin(1e-6));
+        REQUIRE(back.y == Catch::Approx(enu.y).margin(1e-6));
+        REQUIRE(back.z == Catch::Approx(enu.z).margin(1e-6));
+    }
+}
+
+TEST_CASE("LocalTangentPlane Project keeps altitude and Unproject inverts it", "[math][geodesy]") {
+    const LocalTangentPlane plane({ -33.9461, 151.1772, 6.0 });
+
+    /// Ten kilometres out the tangent plane is about 8 m above the ground; the projection is not.
+    const GeoPosition far = GeodesicDirect(plane.GetOrigin(), 45.0, 10000.0);
+    const DVec3 enu = plane.GeodeticToEnu({ far.latitude, far.longitude, 6.0 });
+    const DVec3 projected = plane.Project({ far.latitude, far.longitude, 6.0 });
+    REQUIRE(enu.z < -7.0);
+    REQUIRE(projected.z == 6.0);
+
+    for (const DVec3 &local : { DVec3(0.0, 0.0, 6.0), DVec3(10000.0, 10000.0, 40.0), DVec3(-250000.0, 80000.0, 0.0) })
+    {
+        const GeoPosition position = plane.Unproject(local);
+        REQUIRE(position.altitude == local.z);
+        const DVec3 back = plane.Project(position);
+        REQUIRE(back.x == Catch::Approx(local.x).margin(1e-6));
+        REQUIRE(back.y == Catch::Approx(local.y).margin(1e-6));
+    }
+    REQUIRE(std::isnan(plane.Unproject(DVec3(1e8, 0.0, 0.0)).latitude));
+}
+
+TEST_CASE("Batch geodesy matches the scalar functions", "[math][geodesy]") {
+    /// An odd count exercises the scalar tail after the vector lanes.
+    const std::vector<GeoPosition> positions = RandomPositions(1031, 11);
+    const size_t count = positions.size();
+    std::vector<double> lat(count), lon(count), alt(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        lat[i] = positions[i].latitude;
+        lon[i] = positions[i].longitude;
+        alt[i] = positions[i].altitude;
+    }
+
+    std::vector<double> x(count), y(count), z(count);
+    GeodeticToEcef(lat.data(), lon.data(), alt.data(), x.data(), y.data(), z.data(), count);
+    std::vector<double> lat2(count), lon2(count), alt2(count);
+    EcefToGeodetic(x.data(), y.data(), z.data(), lat2.data(), lon2.data(), alt2.data(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const DVec3 ecef = GeodeticToEcef(positions[i]);
+        REQUIRE(x[i] == Catch::Approx(ecef.x).margin(1e-6));
+        REQUIRE(y[i] == Catch::Approx(ecef.y).margin(1e-6));
+        REQUIRE(z[i] == Catch::Approx(ecef.z).margin(1e-6));
+        REQUIRE(lat2[i] == Catch::Approx(lat[i]).margin(1e-11));
+        REQUIRE(lon2[i] == Catch::Approx(lon[i]).margin(1e-11));
+        REQUIRE(alt2[i] == Catch::Approx(alt[i]).margin(1e-6));
+    }
+
+    /// Local frame, written in place over the inputs.
+    const LocalTangentPlane plane({ 51.4700, -0.4543, 25.0 });
+    std::vector<double> e(lat), n(lon), u(alt);
+    for (size_t i = 0; i < count; ++i)
+    {
+        e[i] = plane.GetOrigin().latitude + (lat[i] / 90.0) * 0.2;
+        n[i] = plane.GetOrigin().longitude + (lon[i] / 180.0) * 0.3;
+    }
+    const std::vector<double> nearLat(e), nearLon(n);
+    plane.Project(e.data(), n.data(), u.data(), e.data(), n.data(), u.data(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const DVec3 local = plane.Project({ nearLat[i], nearLon[i], alt[i] });
+        REQUIRE(e[i] == Catch::Approx(local.x).margin(1e-6));
+        REQUIRE(n[i] == Catch::Approx(local.y).margin(1e-6));
+        REQUIRE(u[i] == alt[i]);
+    }
+    plane.Unproject(e.data(), n.data(), u.data(), e.data(), n.data(), u.data(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        REQUIRE(e[i] == Catch::Approx(nearLat[i]).margin(1e-11));
+        REQUIRE(n[i] == Catch::Approx(nearLon[i]).margin(1e-11));
+        REQUIRE(u[i] == alt[i]);
+    }
+
+    plane.GeodeticToEnu(nearLat.data(), nearLon.data(), alt.data(), e.data(), n.data(), u.data(), count);
+    plane.EnuToGeodetic(e.data(), n.data(), u.data(), lat2.data(), lon2.data(), alt2.data(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const DVec3 enu = plane.GeodeticToEnu({ nearLat[i], nearLon[i], alt[i] });
+        REQUIRE(e[i] == Catch::Approx(enu.x).margin(1e-6));
+        REQUIRE(u[i] == Catch::Approx(enu.z).margin(1e-6));
+        REQUIRE(lat2[i] == Catch::Approx(nearLat[i]).margin(1e-11));
+        REQUIRE(lon2[i] == Catch::Approx(nearLon[i]).margin(1e-11));
+        REQUIRE(alt2[i] == Catch::Approx(alt[i]).margin(1e-6));
+    }
+}
+
+TEST_CASE("Geodesy batch throughput on an airport's objects", "[math][geodesy][performance]") {
+    using Clock = std::chrono::high_resolution_clock;
+    const auto ms = [](Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    /// 200k objects within 5 km of the airport reference point.
+    const LocalTangentPlane plane({ 47.4502, -122.3088, 131.0 });
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> offset(-0.05, 0.05), height(0.0, 60.0);
+    constexpr size_t count = 200000;
+    std::vector<double> lat(count), lon(count), alt(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        lat[i] = plane.GetOrigin().latitude + offset(rng);
+        lon[i] = plane.GetOrigin().longitude + offset(rng) * 1.5;
+        alt[i] = height(rng);
+    }
+    std::vector<double> east(count), north(count), up(count), lat2(count), lon2(count), alt2(count);
+
+    constexpr int rounds = 5;
+    auto start = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const DVec3 local = plane.Project({ lat[i], lon[i], alt[i] });
+            const GeoPosition back = plane.Unproject(local);
+            lat2[i] = back.latitude;
+            lon2[i] = back.longitude;
+            alt2[i] = back.altitude;
+        }
+    }
+    const double scalarMs = ms(start) / rounds;
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        plane.Project(lat.data(), lon.data(), alt.data(), east.data(), north.data(), up.data(), count);
+        plane.Unproject(east.data(), north.data(), up.data(), lat2.data(), lon2.data(), alt2.data(), count);
+    }
+    const double batchMs = ms(start) / rounds;
+
+    double worst = 0.0;
+    for (size_t i = 0; i < count; ++i)
+        worst = std::max({ worst, std::abs(lat2[i] - lat[i]), std::abs(lon2[i] - lon[i]) });
+
+    INFO("Vectorized: " << (IsGeodesyVectorized() ? "AVX2" : "no"));
+    INFO("Project + Unproject of " << count << " objects: scalar " << scalarMs << " ms, batch " << batchMs << " ms (" << scalarMs / batchMs << "x)");
+    INFO("Batch throughput: " << count * 2 / batchMs / 1000.0 << " M transforms/s, worst round trip error " << worst << " degrees");
+    REQUIRE(worst < 1e-11);
+}
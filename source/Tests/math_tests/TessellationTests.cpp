@@ -0,0 +1,356 @@
+﻿#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <Math/includes/tessellation.h>
+
+using namespace SceneryEditorX;
+
+namespace
+{
+    double RingArea(const std::vector<DVec2> &v, uint32_t begin, uint32_t end)
+    {
+        double area = 0.0;
+        for (uint32_t i = begin, j = end - 1; i < end; j = i++)
+            area += v[j].x * v[i].y - v[i].x * v[j].y;
+        return area * 0.5;
+    }
+
+    /// Sum of signed triangle areas; also reports the smallest one so inverted triangles show up.
+    double MeshArea(const std::vector<DVec2> &v, const std::vector<uint32_t> &indices, double *minArea = nullptr)
+    {
+        double area = 0.0;
+        double smallest = HUGE_VAL;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const DVec2 &a = v[indices[i]];
+            const DVec2 &b = v[indices[i + 1]];
+            const DVec2 &c = v[indices[i + 2]];
+            const double t = ((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y)) * 0.5;
+            area += t;
+            smallest = std::min(smallest, t);
+        }
+        if (minArea)
+            *minArea = smallest;
+        return area;
+    }
+
+    std::vector<DVec2> Circle(DVec2 center, double radius, uint32_t count, bool clockwise)
+    {
+        std::vector<DVec2> points;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const double a = 6.283185307179586 * i / count * (clockwise ? -1.0 : 1.0);
+            points.emplace_back(center.x + radius * std::cos(a), center.y + radius * std::sin(a));
+        }
+        return points;
+    }
+
+    TessRing ToRing(const std::vector<DVec2> &points)
+    {
+        TessRing ring;
+        for (const DVec2 &p : points)
+            ring.push_back({ p, p, false });
+        return ring;
+    }
+
+    /// Pavement-like ring: a rounded rectangle whose corners are bezier nodes.
+    TessRing RoundedRect(DVec2 min, DVec2 max, double handle)
+    {
+        TessRing ring;
+        const DVec2 corners[4] = { min, { max.x, min.y }, max, { min.x, max.y } };
+        const DVec2 along[4] = { { handle, 0.0 }, { 0.0, handle }, { -handle, 0.0 }, { 0.0, -handle } };
+        for (int i = 0; i < 4; ++i)
+            ring.push_back({ corners[i], corners[i] + along[i], true });
+        return ring;
+    }
+}
+
+TEST_CASE("Triangulate square in either winding", "[math][tessellation]") {
+    std::vector<DVec2> square = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+    std::vector<uint32_t> indices;
+    Triangulate(square, {}, indices);
+    REQUIRE(indices.size() == 6);
+    double minArea = 0.0;
+    REQUIRE(MeshArea(square, indices, &minArea) == Catch::Approx(1.0));
+    REQUIRE(minArea > 0.0);
+
+    std::vector<DVec2> clockwise(square.rbegin(), square.rend());
+    Triangulate(clockwise, {}, indices);
+    REQUIRE(indices.size() == 6);
+    REQUIRE(MeshArea(clockwise, indices, &minArea) == Catch::Approx(1.0));
+    REQUIRE(minArea > 0.0);
+}
+
+TEST_CASE("Triangulate polygon with holes", "[math][tessellation]") {
+    std::vector<DVec2> v = { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 } };
+    std::vector<uint32_t> starts = { 0 };
+    for (DVec2 c : { DVec2(3, 3), DVec2(7, 7), DVec2(3, 7) })
+    {
+        starts.push_back(static_cast<uint32_t>(v.size()));
+        for (const DVec2 &p : Circle(c, 1.0, 16, false))
+            v.push_back(p);
+    }
+
+    std::vector<uint32_t> indices;
+    Triangulate(v, starts, indices);
+    double expected = RingArea(v, 0, 4);
+    for (size_t h = 1; h < starts.size(); ++h)
+        expected -= std::abs(RingArea(v, starts[h], h + 1 < starts.size() ? starts[h + 1] : static_cast<uint32_t>(v.size())));
+
+    double minArea = 0.0;
+    REQUIRE(MeshArea(v, indices, &minArea) == Catch::Approx(expected).epsilon(1e-12));
+    REQUIRE(minArea > 0.0);
+    /// n - 2 + 2h triangles for a polygon with h holes.
+    REQUIRE(indices.size() / 3 == v.size() - 2 + 2 * 3);
+}
+
+TEST_CASE("Bezier edges flatten within tolerance", "[math][tessellation][bezier]") {
+    const TessRing ring = RoundedRect({ 0, 0 }, { 100, 50 }, 20.0);
+    TessOptions fine;
+    fine.pixelTolerance = 0.1;
+    TessOptions coarse;
+    coarse.pixelTolerance = 0.1;
+    coarse.unitsPerPixel = 10.0;
+
+    std::vector<DVec2> finePoints, coarsePoints;
+    FlattenRing(ring, fine, finePoints);
+    FlattenRing(ring, coarse, coarsePoints);
+    REQUIRE(finePoints.size() > coarsePoints.size());
+    REQUIRE(coarsePoints.size() >= 4);
+
+    /// Every sample of the exact first edge lies within tolerance of the flattened chain.
+    const DVec2 p0 = ring[0].position, p1 = ring[0].control;
+    const DVec2 p3 = ring[1].position, p2 = ring[1].position * 2.0 - ring[1].control;
+    double worst = 0.0;
+    for (int s = 0; s <= 200; ++s)
+    {
+        const double t = s / 200.0, u = 1.0 - t;
+        const DVec2 c = p0 * (u * u * u) + p1 * (3 * u * u * t) + p2 * (3 * u * t * t) + p3 * (t * t * t);
+        double best = HUGE_VAL;
+        for (size_t i = 0; i < finePoints.size(); ++i)
+        {
+            const DVec2 a = finePoints[i], b = finePoints[(i + 1) % finePoints.size()];
+            const DVec2 ab = b - a;
+            const double k = std::clamp(((c.x - a.x) * ab.x + (c.y - a.y) * ab.y) / ab.Length2(), 0.0, 1.0);
+            const DVec2 d = c - (a + ab * k);
+            best = std::min(best, std::sqrt(d.Length2()));
+        }
+        worst = std::max(worst, best);
+    }
+    REQUIRE(worst <= fine.GetTolerance());
+
+    /// Straight edges add no extra points.
+    std::vector<DVec2> straight;
+    FlattenRing(ToRing({ { 0, 0 }, { 1, 0 }, { 1, 1 } }), fine, straight);
+    REQUIRE(straight.size() == 3);
+}
+
+TEST_CASE("PolygonTessellator re-flattens only edited edges", "[math][tessellation][incremental]") {
+    std::vector<TessRing> rings = { RoundedRect({ 0, 0 }, { 200, 100 }, 30.0), RoundedRect({ 20, 20 }, { 60, 60 }, 8.0), RoundedRect({ 120, 20 }, { 160, 60 }, 8.0) };
+    for (TessNode &node : rings[1])
+        node.control = node.position * 2.0 - node.control;
+    PolygonTessellator tess(rings);
+
+    const TessMesh &mesh = tess.GetMesh();
+    REQUIRE(tess.GetLastUpdate().edgesFlattened == 12);
+    REQUIRE(mesh.ringStarts.size() == 3);
+    REQUIRE(!mesh.indices.empty());
+
+    tess.GetMesh();
+    REQUIRE_FALSE(tess.GetLastUpdate().triangulated);
+
+    TessNode moved = rings[2][1];
+    moved.position.x += 5.0;
+    moved.control.x += 5.0;
+    tess.MoveNode(2, 1, moved);
+    const TessMesh &edited = tess.GetMesh();
+    REQUIRE(tess.GetLastUpdate().edgesFlattened == 2);
+
+    /// Same result as tessellating the edited polygon from scratch.
+    PolygonTessellator fresh(tess.GetRings());
+    const TessMesh &reference = fresh.GetMesh();
+    REQUIRE(edited.vertices.size() == reference.vertices.size());
+    for (size_t i = 0; i < reference.vertices.size(); ++i)
+        REQUIRE(edited.vertices[i] == reference.vertices[i]);
+    REQUIRE(edited.indices == reference.indices);
+
+    tess.InsertNode(0, 2, { { 210, 50 }, { 210, 50 }, false });
+    tess.GetMesh();
+    REQUIRE(tess.GetLastUpdate().edgesFlattened == 2);
+    tess.RemoveNode(0, 2);
+    tess.GetMesh();
+    REQUIRE(tess.GetLastUpdate().edgesFlattened == 1);
+
+    /// Zooming out a little keeps the finer cache; zooming in re-flattens.
+    TessOptions options = tess.GetOptions();
+    options.unitsPerPixel *= 1.5;
+    tess.SetOptions(options);
+    tess.GetMesh();
+    REQUIRE_FALSE(tess.GetLastUpdate().triangulated);
+    options.unitsPerPixel *= 0.25;
+    tess.SetOptions(options);
+    tess.GetMesh();
+    REQUIRE(tess.GetLastUpdate().edgesFlattened == 12);
+}
+
+TEST_CASE("Triangulate fuzz: simple polygons with holes", "[math][tessellation][fuzz]") {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<double> radius(0.6, 1.0);
+    std::uniform_int_distribution<uint32_t> sides(3, 120);
+
+    for (int iteration = 0; iteration < 500; ++iteration)
+    {
+        const int holes = iteration % 4;
+        /// Enough sides that the holes stay inside the smallest possible star.
+        const uint32_t n = holes ? std::max(sides(rng), 12u) : sides(rng);
+        const double scale = std::pow(10.0, iteration % 7 - 3);
+        std::vector<DVec2> v;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const double a = 6.283185307179586 * i / n;
+            const double r = radius(rng) * scale;
+            v.emplace_back(r * std::cos(a) + 1000.0 * scale, r * std::sin(a));
+        }
+        std::vector<uint32_t> starts = { 0 };
+        const DVec2 centers[3] = { { -0.25, 0.0 }, { 0.2, 0.2 }, { 0.2, -0.2 } };
+        for (int h = 0; h < holes; ++h)
+        {
+            starts.push_back(static_cast<uint32_t>(v.size()));
+            for (const DVec2 &p : Circle(centers[h], 0.12, 3 + sides(rng) % 20, iteration % 2 == 0))
+                v.push_back({ p.x * scale + 1000.0 * scale, p.y * scale });
+        }
+
+        double expected = std::abs(RingArea(v, 0, n));
+        for (size_t h = 1; h < starts.size(); ++h)
+            expected -= std::abs(RingArea(v, starts[h], h + 1 < starts.size() ? starts[h + 1] : static_cast<uint32_t>(v.size())));
+
+        std::vector<uint32_t> indices;
+        Triangulate(v, starts, indices);
+        double minArea = 0.0;
+        INFO("iteration " << iteration << ", " << n << " sides, " << holes << " holes");
+        REQUIRE(MeshArea(v, indices, &minArea) == Catch::Approx(expected).epsilon(1e-9));
+        REQUIRE(minArea >= 0.0);
+    }
+}
+
+TEST_CASE("Triangulate fuzz: degenerate input", "[math][tessellation][fuzz]") {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<double> coord(-1.0, 1.0);
+
+    const auto check = [](const std::vector<DVec2> &v, const std::vector<uint32_t> &starts) {
+        std::vector<uint32_t> indices;
+        Triangulate(v, starts, indices);
+        REQUIRE(indices.size() % 3 == 0);
+        for (const uint32_t i : indices)
+            REQUIRE(i < v.size());
+        return indices;
+    };
+
+    /// Duplicate and collinear points on a square keep its area.
+    std::vector<DVec2> square = { { 0, 0 }, { 0, 0 }, { 0.5, 0 }, { 1, 0 }, { 1, 0.5 }, { 1, 1 }, { 1, 1 }, { 0, 1 }, { 0, 0.5 } };
+    REQUIRE(MeshArea(square, check(square, {})) == Catch::Approx(1.0));
+
+    /// Zero-area rings produce nothing.
+    REQUIRE(check({ { 0, 0 }, { 1, 1 }, { 2, 2 }, { 3, 3 } }, {}).empty());
+    REQUIRE(check({ { 1, 1 }, { 1, 1 }, { 1, 1 } }, {}).empty());
+    REQUIRE(check({ { 0, 0 }, { 1, 0 } }, {}).empty());
+
+    /// Hole touching the outer boundary, hole sharing a vertex, empty and single-point holes.
+    std::vector<DVec2> touching = { { 0, 0 }, { 4, 0 }, { 4, 4 }, { 0, 4 }, { 0, 1 }, { 1, 2 }, { 0, 3 }, { 2, 2 }, { 3, 1 }, { 3, 3 }, { 1, 1 } };
+    std::vector<uint32_t> indices = check(touching, { 0, 4, 7, 7, 10 });
+    REQUIRE(MeshArea(touching, indices) == Catch::Approx(16.0 - 1.0 - 1.0).margin(1e-9));
+
+    /// Non-finite points are skipped.
+    std::vector<DVec2> nan = { { 0, 0 }, { 1, 0 }, { std::nan(""), 0.5 }, { 1, 1 }, { 0, 1 } };
+    REQUIRE(MeshArea(nan, check(nan, {})) == Catch::Approx(1.0));
+
+    /// Self-intersecting garbage must terminate with valid indices and a bounded triangle count.
+    for (int iteration = 0; iteration < 300; ++iteration)
+    {
+        std::vector<DVec2> v;
+        const uint32_t n = 3 + iteration % 60;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            /// Snap to a coarse grid so exact duplicates and collinear triples are common.
+            v.emplace_back(std::round(coord(rng) * 4.0) / 4.0, std::round(coord(rng) * 4.0) / 4.0);
+        }
+        std::vector<uint32_t> starts = { 0 };
+        if (iteration % 3 == 0)
+            starts.push_back(n / 2);
+        const std::vector<uint32_t> out = check(v, starts);
+        REQUIRE(out.size() / 3 <= 3 * v.size());
+    }
+}
+
+TEST_CASE("Tessellation throughput on an airport pavement set", "[math][tessellation][performance]") {
+    using Clock = std::chrono::high_resolution_clock;
+    const auto ms = [](Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    /// Taxiway-like polygons: 24 bezier nodes around a wobbly ring and two drains as holes.
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> wobble(0.85, 1.15);
+    std::vector<std::vector<TessRing>> polygons;
+    for (int p = 0; p < 3000; ++p)
+    {
+        const DVec2 center((p % 60) * 300.0, (p / 60) * 300.0);
+        TessRing outer;
+        for (int i = 0; i < 24; ++i)
+        {
+            const double a = 6.283185307179586 * i / 24, r = 100.0 * wobble(rng);
+            const DVec2 pos(center.x + r * std::cos(a), center.y + r * std::sin(a));
+            const DVec2 tangent(-std::sin(a) * 10.0, std::cos(a) * 10.0);
+            outer.push_back({ pos, pos + tangent, i % 2 == 0 });
+        }
+        polygons.push_back({ outer, ToRing(Circle(center + DVec2(-30, 0), 8.0, 8, true)), ToRing(Circle(center + DVec2(30, 0), 8.0, 8, true)) });
+    }
+
+    TessOptions options;
+    options.unitsPerPixel = 0.1;
+    std::vector<PolygonTessellator> tessellators;
+    tessellators.reserve(polygons.size());
+    size_t vertices = 0, triangles = 0;
+    auto start = Clock::now();
+    for (auto &rings : polygons)
+    {
+        const TessMesh &mesh = tessellators.emplace_back(rings, options).GetMesh();
+        vertices += mesh.vertices.size();
+        triangles += mesh.indices.size() / 3;
+    }
+    const double fullMs = ms(start);
+
+    /// One large apron: 1500 bezier nodes and 60 holes, edited node by node like a drag.
+    TessRing apron;
+    for (int i = 0; i < 1500; ++i)
+    {
+        const double a = 6.283185307179586 * i / 1500, r = 2000.0 * (1.0 + 0.05 * std::sin(a * 17.0));
+        const DVec2 pos(r * std::cos(a), r * std::sin(a));
+        apron.push_back({ pos, pos + DVec2(-std::sin(a), std::cos(a)) * 3.0, i % 3 == 0 });
+    }
+    std::vector<TessRing> apronRings = { apron };
+    for (int h = 0; h < 60; ++h)
+        apronRings.push_back(ToRing(Circle(DVec2((h % 10) * 250.0 - 1125.0, (h / 10) * 250.0 - 625.0), 40.0, 12, true)));
+    PolygonTessellator large(apronRings, options);
+    start = Clock::now();
+    const size_t apronVertices = large.GetMesh().vertices.size();
+    const double apronMs = ms(start);
+
+    constexpr int drags = 50;
+    start = Clock::now();
+    for (int i = 0; i < drags; ++i)
+    {
+        TessNode node = large.GetRings()[0][300];
+        node.position.x += 0.5;
+        node.control.x += 0.5;
+        large.MoveNode(0, 300, node);
+        large.GetMesh();
+    }
+    const double dragMs = ms(start) / drags;
+
+    INFO("Pavement set: " << polygons.size() << " polygons, " << vertices << " vertices, " << triangles << " triangles in " << fullMs << " ms");
+    INFO("Throughput: " << triangles / fullMs * 1000.0 << " triangles/s");
+    INFO("Apron: " << apronVertices << " vertices in " << apronMs << " ms, node drag " << dragMs << " ms/update (" << large.GetLastUpdate().edgesFlattened << " edges re-flattened)");
+    REQUIRE(large.GetLastUpdate().edgesFlattened == 2);
+    REQUIRE(triangles > polygons.size() * 24);
+}
@@ -0,0 +1,365 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* RegistrySnapshotTest.cpp
+* -------------------------------------------------------
+* Round-trip tests and benchmarks for binary registry snapshots
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SceneryEditorX/scene/registry_snapshot.h>
+
+/// -------------------------------------------------------
+
+using namespace SceneryEditorX;
+
+namespace SceneryEditorX::Tests
+{
+	/// Stand-ins for the scene components, with the same mix of bitwise and heap-owning types.
+	struct SnapID
+	{
+		UUID ID = UUID(0);
+	};
+
+	struct SnapTransform
+	{
+		float Translation[3] = { 0.0f, 0.0f, 0.0f };
+		float Rotation[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+		float Scale[3] = { 1.0f, 1.0f, 1.0f };
+	};
+
+	struct SnapTag
+	{
+		std::string Tag;
+	};
+
+	struct SnapRelationship
+	{
+		UUID ParentHandle = UUID(0);
+		std::vector<UUID> Children;
+	};
+
+	/// Registered under a name the loading schema does not know.
+	struct SnapLegacy
+	{
+		uint32_t Value = 0;
+	};
+
+	UUID &SnapshotIdentity(SnapID &component) { return component.ID; }
+
+	void SnapshotWrite(SnapshotWriter &writer, const SnapTag &component) { writer.WriteString(component.Tag); }
+	void SnapshotRead(SnapshotReader &reader, SnapTag &component) { reader.ReadString(component.Tag); }
+
+	void SnapshotWrite(SnapshotWriter &writer, const SnapRelationship &component)
+	{
+		writer.Write(component.ParentHandle);
+		writer.WriteVector(component.Children);
+	}
+
+	void SnapshotRead(SnapshotReader &reader, SnapRelationship &component)
+	{
+		reader.Read(component.ParentHandle);
+		reader.ReadVector(component.Children);
+	}
+
+	void SnapshotRemapUUIDs(SnapRelationship &component, const SnapshotUUIDRemap &remap)
+	{
+		component.ParentHandle = remap(component.ParentHandle);
+		for (UUID &child : component.Children)
+			child = remap(child);
+	}
+
+}
+
+template<>
+struct SceneryEditorX::SnapshotBitwise<SceneryEditorX::Tests::SnapID> : std::true_type {};
+
+namespace SceneryEditorX::Tests
+{
+	namespace
+	{
+		RegistrySnapshot MakeSchema()
+		{
+			RegistrySnapshot schema;
+			schema.Register<SnapID>("SnapID");
+			schema.Register<SnapTag>("SnapTag");
+			schema.Register<SnapRelationship>("SnapRelationship");
+			schema.Register<SnapTransform>("SnapTransform");
+			return schema;
+		}
+
+		/// Builds a forest of small hierarchies: every eighth entity is a root with up to seven children.
+		void BuildScene(entt::registry &registry, const uint32_t count)
+		{
+			std::vector<entt::entity> entities(count);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				const entt::entity entity = registry.create();
+				entities[i] = entity;
+				registry.emplace<SnapID>(entity, SnapID{ UUID(1000 + i) });
+
+				SnapTransform transform;
+				transform.Translation[0] = static_cast<float>(i);
+				transform.Translation[2] = static_cast<float>(i) * 0.5f;
+				transform.Scale[1] = 1.0f + static_cast<float>(i % 5);
+				registry.emplace<SnapTransform>(entity, transform);
+
+				if (i % 3 != 2)
+					registry.emplace<SnapTag>(entity, SnapTag{ "Taxiway sign " + std::to_string(i) });
+
+				SnapRelationship relationship;
+				if (i % 8 != 0)
+				{
+					const uint32_t root = i - i % 8;
+					relationship.ParentHandle = UUID(1000 + root);
+					registry.get<SnapRelationship>(entities[root]).Children.emplace_back(1000 + i);
+				}
+				registry.emplace<SnapRelationship>(entity, std::move(relationship));
+			}
+		}
+
+		struct LoadedEntity
+		{
+			SnapTransform transform;
+			std::string tag;
+			bool hasTag = false;
+			uint64_t parent = 0;
+			std::vector<uint64_t> children;
+		};
+
+		/// Indexes a registry by UUID so the result does not depend on entity handles or iteration order.
+		std::unordered_map<uint64_t, LoadedEntity> CollectByUUID(const entt::registry &registry)
+		{
+			std::unordered_map<uint64_t, LoadedEntity> result;
+			for (auto [entity, id] : registry.view<SnapID>().each())
+			{
+				LoadedEntity &loaded = result[static_cast<uint64_t>(id.ID)];
+				if (const auto *transform = registry.try_get<SnapTransform>(entity))
+					loaded.transform = *transform;
+				if (const auto *tag = registry.try_get<SnapTag>(entity))
+				{
+					loaded.tag = tag->Tag;
+					loaded.hasTag = true;
+				}
+				if (const auto *relationship = registry.try_get<SnapRelationship>(entity))
+				{
+					loaded.parent = static_cast<uint64_t>(relationship->ParentHandle);
+					for (const UUID &child : relationship->Children)
+						loaded.children.push_back(static_cast<uint64_t>(child));
+				}
+			}
+			return result;
+		}
+
+		bool SameEntity(const LoadedEntity &a, const LoadedEntity &b)
+		{
+			return std::memcmp(&a.transform, &b.transform, sizeof(SnapTransform)) == 0 && a.hasTag == b.hasTag && a.tag == b.tag &&
+			       a.parent == b.parent && a.children == b.children;
+		}
+	}
+
+	TEST_CASE("Registry snapshot round trip", "[scene][snapshot]")
+	{
+		const RegistrySnapshot schema = MakeSchema();
+		entt::registry source;
+		BuildScene(source, 500);
+
+		std::vector<uint8_t> bytes;
+		schema.Save(source, bytes);
+		REQUIRE(bytes.size() > 500 * sizeof(SnapTransform));
+
+		entt::registry target;
+		const RegistrySnapshotLoadResult result = schema.Load(target, bytes.data(), bytes.size());
+		REQUIRE(result.success);
+		REQUIRE(result.loadedBlocks == 4);
+		REQUIRE(result.skippedBlocks == 0);
+		REQUIRE(result.entities.size() == 500);
+		REQUIRE(result.remap.IsEmpty());
+
+		const auto expected = CollectByUUID(source);
+		const auto loaded = CollectByUUID(target);
+		REQUIRE(loaded.size() == expected.size());
+		for (const auto &[id, entity] : expected)
+		{
+			REQUIRE(loaded.contains(id));
+			REQUIRE(SameEntity(loaded.at(id), entity));
+		}
+
+		SECTION("Staged encoding produces a loadable identical snapshot")
+		{
+			const RegistrySnapshotStaging staging = schema.Stage(source);
+			REQUIRE(staging.GetBlockCount() == 4);
+
+			/// The source can change after staging without affecting the copy.
+			BuildScene(source, 10);
+
+			std::vector<uint8_t> encoded;
+			RegistrySnapshot::Encode(staging, encoded);
+			REQUIRE(encoded.size() == bytes.size());
+
+			entt::registry staged;
+			REQUIRE(schema.Load(staged, encoded.data(), encoded.size()).success);
+			const auto fromStaging = CollectByUUID(staged);
+			REQUIRE(fromStaging.size() == expected.size());
+			for (const auto &[id, entity] : expected)
+				REQUIRE(SameEntity(fromStaging.at(id), entity));
+		}
+
+		SECTION("Empty registries round trip")
+		{
+			entt::registry empty;
+			schema.Save(empty, bytes);
+			entt::registry emptyTarget;
+			const RegistrySnapshotLoadResult emptyResult = schema.Load(emptyTarget, bytes.data(), bytes.size());
+			REQUIRE(emptyResult.success);
+			REQUIRE(emptyResult.entities.empty());
+		}
+	}
+
+	TEST_CASE("Registry snapshot UUID regeneration", "[scene][snapshot]")
+	{
+		const RegistrySnapshot schema = MakeSchema();
+		entt::registry source;
+		BuildScene(source, 64);
+
+		std::vector<uint8_t> bytes;
+		schema.Save(source, bytes);
+
+		/// Load the same snapshot twice into one registry, as a paste would.
+		entt::registry target;
+		REQUIRE(schema.Load(target, bytes.data(), bytes.size()).success);
+		RegistrySnapshotLoadOptions options;
+		options.regenerateUUIDs = true;
+		const RegistrySnapshotLoadResult pasted = schema.Load(target, bytes.data(), bytes.size(), options);
+		REQUIRE(pasted.success);
+		REQUIRE(pasted.entities.size() == 64);
+		REQUIRE(pasted.remap.GetSize() == 64);
+
+		const auto original = CollectByUUID(source);
+		const auto merged = CollectByUUID(target);
+		REQUIRE(merged.size() == 128);
+
+		for (const entt::entity entity : pasted.entities)
+		{
+			const UUID id = target.get<SnapID>(entity).ID;
+			REQUIRE_FALSE(original.contains(static_cast<uint64_t>(id)));
+
+			/// Parent and children of pasted entities point at the pasted copies, not the originals.
+			const SnapRelationship &relationship = target.get<SnapRelationship>(entity);
+			if (static_cast<uint64_t>(relationship.ParentHandle) != 0)
+			{
+				REQUIRE_FALSE(original.contains(static_cast<uint64_t>(relationship.ParentHandle)));
+				const auto &parent = merged.at(static_cast<uint64_t>(relationship.ParentHandle));
+				REQUIRE(std::ranges::find(parent.children, static_cast<uint64_t>(id)) != parent.children.end());
+			}
+			for (const UUID &child : relationship.Children)
+				REQUIRE(merged.at(static_cast<uint64_t>(child)).parent == static_cast<uint64_t>(id));
+		}
+	}
+
+	TEST_CASE("Registry snapshot rejects bad input and skips unknown blocks", "[scene][snapshot]")
+	{
+		entt::registry source;
+		BuildScene(source, 32);
+		for (auto [entity, id] : source.view<SnapID>().each())
+			source.emplace<SnapLegacy>(entity, SnapLegacy{ static_cast<uint32_t>(static_cast<uint64_t>(id.ID)) });
+
+		RegistrySnapshot writerSchema = MakeSchema();
+		writerSchema.Register<SnapLegacy>("SnapLegacy");
+
+		std::vector<uint8_t> bytes;
+		writerSchema.Save(source, bytes);
+
+		const RegistrySnapshot schema = MakeSchema();
+		entt::registry target;
+		const RegistrySnapshotLoadResult result = schema.Load(target, bytes.data(), bytes.size());
+		REQUIRE(result.success);
+		REQUIRE(result.skippedBlocks == 1);
+		REQUIRE(CollectByUUID(target).size() == 32);
+
+		SECTION("Bad magic")
+		{
+			bytes[0] ^= 0xFF;
+			entt::registry bad;
+			const RegistrySnapshotLoadResult badResult = schema.Load(bad, bytes.data(), bytes.size());
+			REQUIRE_FALSE(badResult.success);
+			REQUIRE_FALSE(badResult.error.empty());
+		}
+
+		SECTION("Truncated files never read out of bounds")
+		{
+			for (size_t size : { size_t(0), size_t(7), size_t(40), bytes.size() / 2, bytes.size() - 1 })
+			{
+				entt::registry bad;
+				REQUIRE_FALSE(schema.Load(bad, bytes.data(), size).success);
+			}
+		}
+
+		SECTION("Corrupt string lengths are caught")
+		{
+			/// Find the first tag string ("Taxiway sign 0") and give it an absurd length.
+			const std::string needle = "Taxiway sign";
+			const auto it = std::search(bytes.begin(), bytes.end(), needle.begin(), needle.end());
+			REQUIRE(it != bytes.end());
+			const auto lengthOffset = static_cast<size_t>(it - bytes.begin()) - sizeof(uint32_t);
+			const uint32_t length = 0x7FFFFFFF;
+			std::memcpy(bytes.data() + lengthOffset, &length, sizeof(length));
+
+			entt::registry bad;
+			const RegistrySnapshotLoadResult badResult = schema.Load(bad, bytes.data(), bytes.size());
+			REQUIRE_FALSE(badResult.success);
+			REQUIRE(badResult.error.find("SnapTag") != std::string::npos);
+		}
+	}
+
+	TEST_CASE("Registry snapshot save/load throughput", "[.][scene][snapshot][performance]")
+	{
+		using Clock = std::chrono::high_resolution_clock;
+		const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+		const RegistrySnapshot schema = MakeSchema();
+		for (const uint32_t count : { 10000u, 100000u, 1000000u })
+		{
+			entt::registry source;
+			BuildScene(source, count);
+
+			std::vector<uint8_t> bytes;
+			auto start = Clock::now();
+			schema.Save(source, bytes);
+			const double saveMs = ms(start);
+
+			start = Clock::now();
+			const RegistrySnapshotStaging staging = schema.Stage(source);
+			const double stageMs = ms(start);
+
+			std::vector<uint8_t> encoded;
+			start = Clock::now();
+			RegistrySnapshot::Encode(staging, encoded);
+			const double encodeMs = ms(start);
+
+			entt::registry target;
+			start = Clock::now();
+			const RegistrySnapshotLoadResult result = schema.Load(target, bytes.data(), bytes.size());
+			const double loadMs = ms(start);
+
+			INFO("Entities: " << count << ", snapshot size: " << bytes.size() / 1024 << " KiB");
+			INFO("Save (entt snapshot): " << saveMs << " ms, " << (bytes.size() / 1048576.0) / (saveMs / 1000.0) << " MiB/s");
+			INFO("Autosave frame cost (stage): " << stageMs << " ms, off-thread encode: " << encodeMs << " ms");
+			INFO("Load (entt continuous loader): " << loadMs << " ms");
+			CHECK(result.success);
+			CHECK(result.entities.size() == count);
+			CHECK(encoded.size() == bytes.size());
+		}
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,288 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* SettingsStoreTest.cpp
+* -------------------------------------------------------
+* Tests and read benchmark for the typed settings store
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SceneryEditorX/platform/settings/settings_store.h>
+
+/// -------------------------------------------------------------------
+
+namespace SceneryEditorX
+{
+    namespace Tests
+    {
+        TEST_CASE("SettingsStore registers typed keys once", "[Settings][store]")
+        {
+            SettingsStore store;
+            const SettingKey<int> fontSize = store.Register("ui.font_size", 12);
+            const SettingKey<std::string> theme = store.Register<std::string>("ui.theme", "dark");
+            const SettingKey<bool> autoSave = store.Register("project.auto_save", true);
+            const SettingKey<double> scale = store.Register("ui.scale", 1.25);
+
+            REQUIRE(fontSize.IsValid());
+            REQUIRE(store.Get(fontSize) == 12);
+            REQUIRE(store.Get(theme) == "dark");
+            REQUIRE(store.Get(autoSave));
+            REQUIRE(store.Get(scale) == 1.25);
+
+            SECTION("Registering a path again returns the same key and keeps the value")
+            {
+                REQUIRE(store.Register("ui.font_size", 20) == fontSize);
+                REQUIRE(store.Get(fontSize) == 12);
+                REQUIRE(store.FindSlot("ui.font_size") == fontSize.Slot);
+                REQUIRE(store.FindSlot("ui.missing") == InvalidSettingSlot);
+            }
+
+            SECTION("Registering a path with another type fails")
+            {
+                REQUIRE_FALSE(store.Register("ui.font_size", 1.0).IsValid());
+                REQUIRE_FALSE(store.Register<std::string>("ui.font_size", "12").IsValid());
+
+                // Reading through the failed key gives the type's default instead of a stray slot
+                const SettingKey<double> invalid = store.Register("ui.font_size", 1.0);
+                REQUIRE(store.Get(invalid) == 0.0);
+                REQUIRE(store.GetSnapshot()->Get(SettingKey<std::string>{ 99 }).empty());
+            }
+
+            SECTION("Paths are listed by slot")
+            {
+                const std::vector<std::string> paths = store.GetPaths();
+                REQUIRE(paths.size() == 4);
+                REQUIRE(paths[theme.Slot] == "ui.theme");
+            }
+        }
+
+        TEST_CASE("SettingsStore batches writes until commit", "[Settings][store]")
+        {
+            SettingsStore store;
+            const SettingKey<int> fontSize = store.Register("ui.font_size", 12);
+            const SettingKey<std::string> theme = store.Register<std::string>("ui.theme", "dark");
+            const SettingKey<bool> autoSave = store.Register("project.auto_save", true);
+
+            const auto before = store.GetSnapshot();
+            store.Set(fontSize, 14);
+            store.Set(fontSize, 16);
+            store.Set<std::string>(theme, "light");
+            store.Set(autoSave, true);
+
+            // Nothing is visible before the commit
+            REQUIRE(store.Get(fontSize) == 12);
+            REQUIRE(store.Commit() == 2);
+            REQUIRE(store.Get(fontSize) == 16);
+            REQUIRE(store.Get(theme) == "light");
+
+            // Snapshots already held stay as they were
+            REQUIRE(before->Get(fontSize) == 12);
+            REQUIRE(before->Get(theme) == "dark");
+            REQUIRE(store.GetSnapshot()->GetVersion() > before->GetVersion());
+
+            // Unchanged values and invalid keys are not a change
+            store.Set(fontSize, 16);
+            store.Set(SettingKey<int>{}, 3);
+            REQUIRE(store.Commit() == 0);
+            REQUIRE(store.Commit() == 0);
+        }
+
+        TEST_CASE("SettingsStore notifies listeners of changed keys", "[Settings][store]")
+        {
+            SettingsStore store;
+            const SettingKey<int> fontSize = store.Register("ui.font_size", 12);
+            const SettingKey<std::string> theme = store.Register<std::string>("ui.theme", "dark");
+            const SettingKey<int> backups = store.Register("project.backup_count", 3);
+
+            std::vector<std::vector<uint32_t>> changes;
+            std::vector<int> seenFontSizes;
+            const uint64_t id = store.Subscribe([&](const SettingsChange &change)
+            {
+                changes.emplace_back(change.Slots.begin(), change.Slots.end());
+                if (change.Contains(fontSize))
+                    seenFontSizes.push_back(change.Snapshot.Get(fontSize));
+            });
+
+            store.Set(backups, 5);
+            store.Set(fontSize, 18);
+            store.Commit();
+            REQUIRE(changes.size() == 1);
+            REQUIRE(changes[0] == std::vector<uint32_t>{ fontSize.Slot, backups.Slot });
+            REQUIRE(seenFontSizes == std::vector<int>{ 18 });
+
+            store.Set<std::string>(theme, "light");
+            store.Commit();
+            REQUIRE(changes.size() == 2);
+            REQUIRE(changes[1] == std::vector<uint32_t>{ theme.Slot });
+            REQUIRE(seenFontSizes.size() == 1);
+
+            SECTION("Listeners can commit from inside a notification")
+            {
+                store.Subscribe([&](const SettingsChange &change)
+                {
+                    if (change.Contains(theme))
+                    {
+                        store.Set(backups, 9);
+                        store.Commit();
+                    }
+                });
+                store.Set<std::string>(theme, "dark");
+                store.Commit();
+                REQUIRE(store.Get(backups) == 9);
+            }
+
+            SECTION("Unsubscribed listeners are not called")
+            {
+                store.Unsubscribe(id);
+                store.Set(fontSize, 10);
+                store.Commit();
+                REQUIRE(changes.size() == 2);
+            }
+        }
+
+        TEST_CASE("SettingsStore persists committed changes in the background", "[Settings][store]")
+        {
+            std::mutex mutex;
+            std::vector<std::map<std::string, SettingValue>> writes;
+            SettingsStore::PersistFn persist = [&](const std::vector<SettingWrite> &batch)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto &written = writes.emplace_back();
+                for (const SettingWrite &write : batch)
+                    written[write.Path] = write.Value;
+            };
+
+            SECTION("Commits inside the persist delay are written once")
+            {
+                SettingsStore store(persist, std::chrono::seconds(5));
+                const SettingKey<int> fontSize = store.Register("ui.font_size", 12);
+                const SettingKey<bool> autoSave = store.Register("project.auto_save", true);
+
+                for (int size = 13; size <= 20; ++size)
+                {
+                    store.Set(fontSize, size);
+                    store.Commit();
+                }
+                store.Set(autoSave, false);
+                store.Commit();
+                store.Flush();
+
+                std::lock_guard<std::mutex> lock(mutex);
+                REQUIRE(writes.size() == 1);
+                REQUIRE(writes[0].size() == 2);
+                REQUIRE(std::get<int>(writes[0]["ui.font_size"]) == 20);
+                REQUIRE_FALSE(std::get<bool>(writes[0]["project.auto_save"]));
+            }
+
+            SECTION("Publishing without persist skips the write")
+            {
+                SettingsStore store(persist, std::chrono::milliseconds(0));
+                const SettingKey<int> fontSize = store.Register("ui.font_size", 12);
+                REQUIRE(store.Publish({ { fontSize.Slot, SettingValue(14) } }, false) == 1);
+                REQUIRE(store.Get(fontSize) == 14);
+                store.Flush();
+                REQUIRE(writes.empty());
+            }
+
+            SECTION("Destroying the store writes what is still pending")
+            {
+                {
+                    SettingsStore store(persist, std::chrono::seconds(10));
+                    store.Set(store.Register("ui.font_size", 12), 15);
+                    store.Commit();
+                }
+                REQUIRE(writes.size() == 1);
+                REQUIRE(std::get<int>(writes[0]["ui.font_size"]) == 15);
+            }
+        }
+
+        TEST_CASE("SettingsStore readers always see a consistent snapshot", "[Settings][store]")
+        {
+            SettingsStore store(SettingsStore::PersistFn([](const std::vector<SettingWrite> &) {}), std::chrono::milliseconds(1));
+            const SettingKey<int> width = store.Register("window.width", 0);
+            const SettingKey<int> height = store.Register("window.height", 0);
+
+            std::atomic<bool> running = true;
+            std::atomic<bool> torn = false;
+            std::vector<std::thread> readers;
+            for (int t = 0; t < 3; ++t)
+            {
+                readers.emplace_back([&]()
+                {
+                    int last = 0;
+                    while (running)
+                    {
+                        const auto snapshot = store.GetSnapshot();
+                        const int w = snapshot->Get(width);
+                        if (w != snapshot->Get(height) || w < last)
+                            torn = true;
+                        last = w;
+                    }
+                });
+            }
+
+            // Every commit sets both, so any reader seeing them differ saw half a commit
+            for (int i = 1; i <= 2000; ++i)
+            {
+                store.Set(width, i);
+                store.Set(height, i);
+                store.Commit();
+            }
+            running = false;
+            for (auto &reader : readers)
+                reader.join();
+
+            REQUIRE_FALSE(torn);
+            REQUIRE(store.Get(width) == 2000);
+        }
+
+        TEST_CASE("SettingsStore read throughput", "[.][Settings][store][performance]")
+        {
+            using Clock = std::chrono::high_resolution_clock;
+            constexpr int reads = 10000000;
+
+            SettingsStore store;
+            const SettingKey<int> fontSize = store.Register("ui.font_size", 12);
+            const SettingKey<bool> autoSave = store.Register("project.auto_save", true);
+            for (int i = 0; i < 100; ++i)
+                store.Register("ui.padding_" + std::to_string(i), i);
+
+            // Path lookup through a string map, the same work as the settings map behind HasOption()
+            std::map<std::string, std::string> pathMap;
+            for (const std::string &path : store.GetPaths())
+                pathMap[path] = "12";
+
+            auto start = Clock::now();
+            int64_t keySum = 0;
+            for (int i = 0; i < reads; ++i)
+                keySum += store.Get(fontSize) + (store.Get(autoSave) ? 1 : 0);
+            const double keyMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+            start = Clock::now();
+            int64_t pathSum = 0;
+            const std::string path = "ui.font_size";
+            for (int i = 0; i < reads / 10; ++i)
+                pathSum += std::stoi(pathMap.find(path)->second);
+            const double pathMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() * 10.0;
+
+            INFO("Typed key reads:  " << 2.0 * reads / keyMs / 1000.0 << " M reads/s");
+            INFO("Path map lookups: " << reads / pathMs / 1000.0 << " M reads/s");
+            CHECK(keySum == int64_t(reads) * 13);
+            CHECK(pathSum == int64_t(reads / 10) * 12);
+        }
+
+    } // namespace Tests
+} // namespace SceneryEditorX
+
+/// -------------------------------------------------------
@@ -12,11 +12,13 @@
 */
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <SceneryEditorX/platform/settings/settings.h>
 #include <SceneryEditorX/utils/pointers.h>
 #include <string>
+#include <vector>
 
 /// -------------------------------------------------------------------
 
@@ -145,8 +147,6 @@ namespace SceneryEditorX
                 REQUIRE(settings->GetStringOption("nonexistent") == "");
                 REQUIRE(settings->GetStringOption("nonexistent", "default") == "default");
             }
-                REQUIRE(value == "another value");
-            }
 
             SECTION("AddStringOption adds string option")
             {
@@ -273,6 +273,100 @@ namespace SceneryEditorX
             }
         }
 
+        TEST_CASE_METHOD(Tests::SettingsFixture, "Registered settings read from the config", "[Settings][store]")
+        {
+            const SettingKey<int> fontSize = settings->RegisterSetting("ui.font_size", 10);
+            const SettingKey<std::string> theme = settings->RegisterSetting<std::string>("ui.theme", "light");
+            const SettingKey<double> scale = settings->RegisterSetting("ui.scale", 1.5);
+
+            SECTION("Values come from the file, defaults fill the gaps")
+            {
+                REQUIRE(settings->GetSetting(fontSize) == 12);
+                REQUIRE(settings->GetSetting(theme) == "dark");
+                REQUIRE(settings->GetSetting(scale) == Catch::Approx(1.5));
+            }
+
+            SECTION("Path-based writes reach registered settings")
+            {
+                settings->AddIntOption("ui.font_size", 16);
+                REQUIRE(settings->GetSetting(fontSize) == 16);
+            }
+
+            SECTION("Committed settings are written to the file")
+            {
+                std::vector<uint32_t> changed;
+                settings->GetSettingsStore().Subscribe([&changed](const SettingsChange &change)
+                {
+                    changed.assign(change.Slots.begin(), change.Slots.end());
+                });
+
+                settings->SetSetting(fontSize, 18);
+                settings->SetSetting<std::string>(theme, "light");
+                REQUIRE(settings->CommitSettings() == 2);
+                REQUIRE(changed.size() == 2);
+
+                settings->FlushSettings();
+                REQUIRE(settings->GetIntOption("ui.font_size") == 18);
+
+                auto reloaded = CreateRef<ApplicationSettings>(tempFilePath);
+                REQUIRE(reloaded->GetIntOption("ui.font_size") == 18);
+                REQUIRE(reloaded->GetStringOption("ui.theme") == "light");
+            }
+
+            SECTION("Listeners may flush while a path-based write publishes")
+            {
+                // Leaves a save queued on the persist thread, which needs the config lock to finish
+                settings->SetSetting(fontSize, 18);
+                REQUIRE(settings->CommitSettings() == 1);
+
+                bool flushed = false;
+                settings->GetSettingsStore().Subscribe([&](const SettingsChange &)
+                {
+                    settings->FlushSettings();
+                    flushed = true;
+                });
+
+                settings->AddIntOption("ui.font_size", 20);
+                REQUIRE(flushed);
+                REQUIRE(settings->GetSetting(fontSize) == 20);
+            }
+
+            SECTION("Re-reading the file updates registered settings")
+            {
+                {
+                    auto other = CreateRef<ApplicationSettings>(tempFilePath);
+                    other->AddIntOption("ui.font_size", 22);
+                    other->WriteSettings();
+                }
+                REQUIRE(settings->ReadSettings());
+                REQUIRE(settings->GetSetting(fontSize) == 22);
+            }
+        }
+
+        TEST_CASE_METHOD(Tests::SettingsFixture, "Registered setting read throughput", "[.][Settings][store][performance]")
+        {
+            using Clock = std::chrono::high_resolution_clock;
+            constexpr int reads = 1000000;
+
+            const SettingKey<int> fontSize = settings->RegisterSetting("ui.font_size", 10);
+
+            auto start = Clock::now();
+            int64_t pathSum = 0;
+            for (int i = 0; i < reads; ++i)
+                pathSum += settings->GetIntOption("ui.font_size");
+            const double pathMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+            start = Clock::now();
+            int64_t keySum = 0;
+            for (int i = 0; i < reads; ++i)
+                keySum += settings->GetSetting(fontSize);
+            const double keyMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+            INFO("GetIntOption: " << reads / pathMs / 1000.0 << " M reads/s");
+            INFO("GetSetting:   " << reads / keyMs / 1000.0 << " M reads/s");
+            CHECK(pathSum == keySum);
+        }
+
         TEST_CASE("Creating ApplicationSettings with non-existent file", "[Settings][initialization]")
         {
             // Create with a path to a non-existent file
@@ -364,7 +458,8 @@ namespace SceneryEditorX
             Tests::cleanupTempSettingsFile(tempPath);
         }
 
-}
+    } // namespace Tests
+} // namespace SceneryEditorX
 
 
 /// -------------------------------------------------------------------
@@ -0,0 +1,216 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* GlyphAtlasTest.cpp
+* -------------------------------------------------------
+* Tests for shelf packing, rasterisation and LRU eviction of the glyph atlas
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+#include <SceneryEditorX/renderer/fonts/glyph_atlas.h>
+#include "TextTestUtils.h"
+
+/// -------------------------------------------------------
+
+using namespace SceneryEditorX;
+
+namespace SceneryEditorX::Tests
+{
+	namespace
+	{
+		GlyphAtlasSpecification SmallAtlas(const uint32_t width, const uint32_t height)
+		{
+			GlyphAtlasSpecification spec;
+			spec.width = width;
+			spec.height = height;
+			spec.bytesPerPixel = 1;
+			spec.padding = 1;
+			return spec;
+		}
+
+		bool Overlaps(const GlyphAtlasRect &a, const GlyphAtlasRect &b)
+		{
+			return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+		}
+
+		/// Checks that the texels of a glyph hold its fill value and the padding ring stays empty.
+		bool GlyphPixelsMatch(const GlyphAtlas &atlas, const GlyphAtlasRect &rect, const uint32_t codepoint)
+		{
+			const uint8_t *pixels = atlas.GetPixels();
+			const uint32_t pitch = atlas.GetRowPitch();
+			for (int32_t y = rect.y - 1; y <= rect.y + rect.height; ++y)
+			{
+				for (int32_t x = rect.x - 1; x <= rect.x + rect.width; ++x)
+				{
+					if (x < 0 || y < 0 || x >= static_cast<int32_t>(atlas.GetWidth()) || y >= static_cast<int32_t>(atlas.GetHeight()))
+						continue;
+
+					const bool inside = x >= rect.x && x < rect.x + rect.width && y >= rect.y && y < rect.y + rect.height;
+					const uint8_t expected = inside ? static_cast<uint8_t>(codepoint & 0xFF) : 0;
+					if (pixels[static_cast<size_t>(y) * pitch + x] != expected)
+						return false;
+				}
+			}
+			return true;
+		}
+	}
+
+	TEST_CASE("Glyph atlas packs glyphs without overlap", "[text][atlas]")
+	{
+		const TestGlyphSource font(1);
+		GlyphAtlas atlas(SmallAtlas(256, 256));
+
+		std::vector<std::pair<uint32_t, GlyphAtlasRect>> placed;
+		for (uint32_t cp = 'A'; cp <= 'z'; ++cp)
+		{
+			const GlyphAtlasRect *rect = atlas.Acquire(font, cp);
+			REQUIRE(rect != nullptr);
+			REQUIRE(rect->x >= 1);
+			REQUIRE(rect->y >= 1);
+			REQUIRE(rect->x + rect->width < atlas.GetWidth());
+			REQUIRE(rect->y + rect->height < atlas.GetHeight());
+			placed.emplace_back(cp, *rect);
+		}
+
+		for (size_t i = 0; i < placed.size(); ++i)
+			for (size_t j = i + 1; j < placed.size(); ++j)
+				REQUIRE_FALSE(Overlaps(placed[i].second, placed[j].second));
+
+		REQUIRE(atlas.IsDirty());
+		REQUIRE(atlas.RasterizePending(nullptr) == placed.size());
+		for (const auto &[cp, rect] : placed)
+			REQUIRE(GlyphPixelsMatch(atlas, rect, cp));
+
+		SECTION("Second lookups hit and do not rasterise again")
+		{
+			const GlyphAtlasRect *again = atlas.Acquire(font, 'Q');
+			REQUIRE(again != nullptr);
+			REQUIRE(again == atlas.Find(font.GetFontID(), 'Q'));
+			REQUIRE(atlas.GetStats().hits == 1);
+			REQUIRE(atlas.RasterizePending(nullptr) == 0);
+		}
+
+		SECTION("Spaces are cached without taking atlas space")
+		{
+			REQUIRE(atlas.Acquire(font, ' ') == nullptr);
+			REQUIRE(atlas.Acquire(font, ' ') == nullptr);
+			REQUIRE(atlas.GetStats().misses == placed.size() + 1);
+			REQUIRE(atlas.RasterizePending(nullptr) == 0);
+		}
+
+		SECTION("The same codepoint in another font gets its own slot")
+		{
+			const TestGlyphSource other(2);
+			const GlyphAtlasRect *rect = atlas.Acquire(other, 'A');
+			REQUIRE(rect != nullptr);
+			REQUIRE_FALSE(Overlaps(*rect, placed.front().second));
+
+			atlas.RemoveFont(font.GetFontID());
+			REQUIRE(atlas.Find(font.GetFontID(), 'A') == nullptr);
+			REQUIRE(atlas.Find(other.GetFontID(), 'A') != nullptr);
+		}
+	}
+
+	TEST_CASE("Parallel rasterisation matches serial output", "[text][atlas]")
+	{
+		const TestGlyphSource font(1, 3);
+		GlyphAtlas serial(SmallAtlas(512, 512));
+		GlyphAtlas parallel(SmallAtlas(512, 512));
+
+		for (uint32_t cp = 0x20; cp < 0x7F; ++cp)
+		{
+			serial.Acquire(font, cp);
+			parallel.Acquire(font, cp);
+		}
+
+		ThreadPool pool(4);
+		serial.RasterizePending(nullptr);
+		REQUIRE(parallel.RasterizePending(&pool) == 0x7F - 0x21);
+
+		const size_t bytes = static_cast<size_t>(serial.GetRowPitch()) * serial.GetHeight();
+		REQUIRE(std::equal(serial.GetPixels(), serial.GetPixels() + bytes, parallel.GetPixels()));
+	}
+
+	TEST_CASE("Glyph atlas evicts the least recently used shelf", "[text][atlas]")
+	{
+		/// Codepoints that are multiples of five are 10 texels tall, so every shelf is 12 rows and the atlas holds five.
+		const TestGlyphSource font(1);
+		GlyphAtlas atlas(SmallAtlas(64, 64));
+
+		std::vector<std::pair<uint32_t, GlyphAtlasRect>> placed;
+		uint32_t cp = 0x104;
+		atlas.BeginFrame();
+		for (;; cp += 5)
+		{
+			const GlyphAtlasRect *rect = atlas.Acquire(font, cp);
+			if (!rect)
+				break;
+			placed.emplace_back(cp, *rect);
+		}
+		atlas.RasterizePending(nullptr);
+
+		const uint32_t overflow = cp;
+		REQUIRE(atlas.GetStats().shelfCount == 5);
+		REQUIRE(atlas.GetStats().failedAllocations == 1);
+		REQUIRE(atlas.GetStats().evictedShelves == 0);
+
+		SECTION("Shelves pinned by the current frame are never reused")
+		{
+			REQUIRE(atlas.Acquire(font, overflow) == nullptr);
+			REQUIRE(atlas.GetStats().failedAllocations == 2);
+			REQUIRE(atlas.GetStats().evictedShelves == 0);
+		}
+
+		SECTION("An old shelf is cleared and reused in a later frame")
+		{
+			atlas.BeginFrame();
+
+			/// Touch everything except the bottom shelf.
+			size_t bottomShelfGlyphs = 0;
+			for (const auto &[code, rect] : placed)
+			{
+				if (rect.y == 1)
+					++bottomShelfGlyphs;
+				else
+					REQUIRE(atlas.Acquire(font, code) != nullptr);
+			}
+
+			const uint64_t epoch = atlas.GetEvictionEpoch();
+			atlas.ClearDirty();
+
+			const GlyphAtlasRect *rect = atlas.Acquire(font, overflow);
+			REQUIRE(rect != nullptr);
+			REQUIRE(rect->y == 1);
+			REQUIRE(atlas.GetStats().evictedShelves == 1);
+			REQUIRE(atlas.GetStats().evictedGlyphs == bottomShelfGlyphs);
+			REQUIRE(atlas.GetEvictionEpoch() != epoch);
+			for (const auto &[code, placedRect] : placed)
+				REQUIRE((atlas.Find(font.GetFontID(), code) == nullptr) == (placedRect.y == 1));
+
+			REQUIRE(atlas.GetDirtyRowBegin() == 0);
+			REQUIRE(atlas.GetDirtyRowEnd() == 12);
+			REQUIRE(atlas.RasterizePending(nullptr) == 1);
+			REQUIRE(GlyphPixelsMatch(atlas, *rect, overflow));
+		}
+	}
+
+	TEST_CASE("Glyphs larger than the atlas are rejected", "[text][atlas]")
+	{
+		const TestGlyphSource huge(1, 40);
+		GlyphAtlas atlas(SmallAtlas(128, 128));
+
+		REQUIRE(atlas.Acquire(huge, 'A') == nullptr);
+		REQUIRE(atlas.GetStats().failedAllocations == 1);
+		REQUIRE(atlas.GetStats().shelfCount == 0);
+	}
+
+}
+
+/// -------------------------------------------------------
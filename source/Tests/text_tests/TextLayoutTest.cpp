@@ -0,0 +1,252 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* TextLayoutTest.cpp
+* -------------------------------------------------------
+* Tests and throughput benchmark for text shaping and the layout cache
+* -------------------------------------------------------
+*/
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <SceneryEditorX/renderer/fonts/glyph_atlas.h>
+#include <SceneryEditorX/renderer/fonts/text_layout.h>
+#include "TextTestUtils.h"
+
+/// -------------------------------------------------------
+
+using namespace SceneryEditorX;
+using Catch::Approx;
+
+namespace SceneryEditorX::Tests
+{
+	TEST_CASE("UTF-8 decoding", "[text][layout]")
+	{
+		std::vector<uint32_t> out;
+
+		TextLayoutEngine::DecodeUTF8("EGLL", out);
+		REQUIRE(out == std::vector<uint32_t> { 'E', 'G', 'L', 'L' });
+
+		TextLayoutEngine::DecodeUTF8("\xC3\xA9\xD0\x96\xE2\x82\xAC\xF0\x9F\x9B\xAB", out);
+		REQUIRE(out == std::vector<uint32_t> { 0xE9, 0x416, 0x20AC, 0x1F6EB });
+
+		SECTION("Malformed input is replaced, not dropped")
+		{
+			TextLayoutEngine::DecodeUTF8("a\xC3(b", out);
+			REQUIRE(out == std::vector<uint32_t> { 'a', 0xFFFD, '(', 'b' });
+
+			TextLayoutEngine::DecodeUTF8("\xC0\xAF", out);
+			REQUIRE(out == std::vector<uint32_t> { 0xFFFD, 0xFFFD });
+
+			TextLayoutEngine::DecodeUTF8("\xED\xA0\x80", out);
+			REQUIRE(out.front() == 0xFFFD);
+
+			TextLayoutEngine::DecodeUTF8("\xE2\x82", out);
+			REQUIRE(out == std::vector<uint32_t> { 0xFFFD, 0xFFFD });
+		}
+	}
+
+	TEST_CASE("Single line layout and kerning", "[text][layout]")
+	{
+		const TestGlyphSource font(1);
+		TextLayout layout;
+
+		TextLayoutEngine::Layout("AX B", font, {}, layout);
+		REQUIRE(layout.glyphs.size() == 3);
+		REQUIRE(layout.lineCount == 1);
+		REQUIRE(layout.glyphs[0].left == Approx(0.05f));
+		REQUIRE(layout.glyphs[1].left == Approx(0.55f));
+		REQUIRE(layout.glyphs[2].left == Approx(1.55f));
+		REQUIRE(layout.glyphs[2].bottom == Approx(-0.1f));
+		REQUIRE(layout.glyphs[2].top == Approx(0.7f));
+		REQUIRE(layout.width == Approx(1.95f));
+
+		TextLayoutEngine::Layout("AV", font, {}, layout);
+		REQUIRE(layout.glyphs[1].left == Approx(0.45f));
+
+		TextLayoutParams params;
+		params.kerningOffset = 0.25f;
+		TextLayoutEngine::Layout("AX", font, params, layout);
+		REQUIRE(layout.glyphs[1].left == Approx(0.8f));
+
+		SECTION("Missing glyphs and carriage returns are skipped")
+		{
+			TextLayoutEngine::Layout("A\x7F\rB", font, {}, layout);
+			REQUIRE(layout.glyphs.size() == 2);
+			REQUIRE(layout.glyphs[1].left == Approx(0.55f));
+		}
+	}
+
+	TEST_CASE("Line breaks and word wrap", "[text][layout]")
+	{
+		const TestGlyphSource font(1);
+		TextLayout layout;
+
+		TextLayoutParams params;
+		params.lineHeightOffset = 0.3f;
+		TextLayoutEngine::Layout("TWY\nA1", font, params, layout);
+		REQUIRE(layout.lineCount == 2);
+		REQUIRE(layout.glyphs[3].left == Approx(0.05f));
+		REQUIRE(layout.glyphs[3].bottom == Approx(-1.5f - 0.1f));
+
+		params = {};
+		params.maxWidth = 3.0f;
+		TextLayoutEngine::Layout("hello world again", font, params, layout);
+		REQUIRE(layout.lineCount == 3);
+		REQUIRE(layout.glyphs.size() == 15);
+		for (const TextLayoutGlyph &glyph : layout.glyphs)
+			REQUIRE(glyph.right <= params.maxWidth);
+
+		/// "world" starts the second line at the left edge.
+		REQUIRE(layout.glyphs[5].codepoint == 'w');
+		REQUIRE(layout.glyphs[5].left == Approx(0.05f));
+		REQUIRE(layout.glyphs[5].bottom == Approx(-1.2f - 0.1f));
+		REQUIRE(layout.glyphs[10].bottom == Approx(-2.4f - 0.1f));
+
+		SECTION("A single word longer than the width is not split")
+		{
+			TextLayoutEngine::Layout("RUNWAYHOLDINGPOINT", font, params, layout);
+			REQUIRE(layout.lineCount == 1);
+			REQUIRE(layout.glyphs.size() == 18);
+		}
+	}
+
+	TEST_CASE("Layout cache hits, keys and eviction", "[text][layout]")
+	{
+		const TestGlyphSource fontA(1);
+		const TestGlyphSource fontB(2);
+		TextLayoutCache cache(3);
+
+		const TextLayout &first = cache.Get("GATE A1", fontA, {});
+		REQUIRE(first.glyphs.size() == 6);
+		cache.Get("GATE A1", fontA, {});
+		REQUIRE(cache.GetStats().hits == 1);
+		REQUIRE(cache.GetStats().misses == 1);
+
+		/// Font and parameters are part of the key.
+		TextLayoutParams wrapped;
+		wrapped.maxWidth = 2.0f;
+		REQUIRE(cache.Get("GATE A1", fontA, wrapped).lineCount == 2);
+		REQUIRE(cache.Get("GATE A1", fontB, {}).lineCount == 1);
+		REQUIRE(cache.GetStats().misses == 3);
+
+		/// Refresh the first entry, then overflow: the least recently used (wrapped) entry goes.
+		cache.Get("GATE A1", fontA, {});
+		cache.Get("GATE B2", fontA, {});
+		REQUIRE(cache.GetStats().evictions == 1);
+		REQUIRE(cache.GetStats().entries == 3);
+
+		const uint64_t misses = cache.GetStats().misses;
+		cache.Get("GATE A1", fontA, {});
+		REQUIRE(cache.GetStats().misses == misses);
+		cache.Get("GATE A1", fontA, wrapped);
+		REQUIRE(cache.GetStats().misses == misses + 1);
+
+		SECTION("Removing a font drops its layouts")
+		{
+			cache.Get("GATE A1", fontB, {});
+			REQUIRE(cache.GetStats().misses == misses + 2);
+
+			cache.RemoveFont(fontA.GetFontID());
+			REQUIRE(cache.GetStats().entries == 1);
+			cache.Get("GATE A1", fontB, {});
+			cache.Get("GATE A1", fontA, {});
+			REQUIRE(cache.GetStats().misses == misses + 3);
+		}
+
+		SECTION("Shrinking the capacity trims the oldest entries")
+		{
+			cache.SetCapacity(1);
+			REQUIRE(cache.GetStats().entries == 1);
+			cache.Get("GATE A1", fontA, wrapped);
+			REQUIRE(cache.GetStats().misses == misses + 1);
+		}
+	}
+
+	TEST_CASE("Text layout throughput", "[text][layout][performance]")
+	{
+		constexpr int labelCount = 10000;
+		constexpr int frames = 20;
+
+		/// Taxiway signs and gate labels of a large airport.
+		std::vector<std::string> labels;
+		labels.reserve(labelCount);
+		for (int i = 0; i < labelCount; ++i)
+		{
+			switch (i % 3)
+			{
+				case 0: labels.push_back("TWY " + std::string(1, static_cast<char>('A' + i % 26)) + std::to_string(i % 97)); break;
+				case 1: labels.push_back("GATE " + std::string(1, static_cast<char>('A' + i % 12)) + std::to_string(i)); break;
+				default: labels.push_back("RWY " + std::to_string(1 + i % 36) + "L HOLD SHORT\nILS CAT III"); break;
+			}
+		}
+
+		const TestGlyphSource font(1);
+		TextLayoutParams params;
+		params.maxWidth = 8.0f;
+
+		using Clock = std::chrono::high_resolution_clock;
+		size_t glyphs = 0;
+
+		TextLayout layout;
+		auto start = Clock::now();
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			for (const std::string &label : labels)
+			{
+				TextLayoutEngine::Layout(label, font, params, layout);
+				glyphs += layout.glyphs.size();
+			}
+		}
+		const double uncachedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		TextLayoutCache cache(labelCount);
+		start = Clock::now();
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			for (const std::string &label : labels)
+				glyphs += cache.Get(label, font, params).glyphs.size();
+		}
+		const double cachedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		GlyphAtlasSpecification atlasSpec;
+		atlasSpec.bytesPerPixel = 1;
+		GlyphAtlas atlas(atlasSpec);
+
+		start = Clock::now();
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			atlas.BeginFrame();
+			for (const std::string &label : labels)
+			{
+				for (const TextLayoutGlyph &glyph : cache.Get(label, font, params).glyphs)
+					glyphs += atlas.Acquire(font, glyph.codepoint) != nullptr;
+			}
+			atlas.RasterizePending(nullptr);
+		}
+		const double atlasMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		const std::unordered_set<std::string> unique(labels.begin(), labels.end());
+		const double labelsPerSecond = static_cast<double>(labelCount) * frames * 1000.0 / 1e6;
+		INFO("Labels per frame: " << labelCount << " (" << unique.size() << " unique), glyphs counted: " << glyphs);
+		INFO("Re-layout every frame: " << uncachedMs / frames << " ms/frame (" << labelsPerSecond / uncachedMs << " M labels/s)");
+		INFO("Cached layout: " << cachedMs / frames << " ms/frame (" << labelsPerSecond / cachedMs << " M labels/s)");
+		INFO("Cached layout + atlas lookup: " << atlasMs / frames << " ms/frame");
+		INFO("Layout cache hits: " << cache.GetStats().hits << ", misses: " << cache.GetStats().misses);
+		INFO("Atlas glyphs: " << atlas.GetStats().glyphCount << ", rasterised: " << atlas.GetStats().rasterized);
+
+		REQUIRE(cache.GetStats().misses == unique.size());
+		REQUIRE(atlas.GetStats().rasterized == atlas.GetStats().glyphCount);
+		REQUIRE(atlas.GetStats().failedAllocations == 0);
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,86 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* TextTestUtils.h
+* -------------------------------------------------------
+* Synthetic font used by the text layout and glyph atlas tests
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <SceneryEditorX/renderer/fonts/glyph_source.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX::Tests
+{
+	/**
+	 * @brief Deterministic font: every glyph advances 0.5 em, 'A' followed by 'V' is kerned by -0.1 em.
+	 *
+	 * Bitmaps are one byte per texel filled with the low byte of the codepoint.
+	 */
+	class TestGlyphSource : public GlyphSource
+	{
+	public:
+		explicit TestGlyphSource(const uint64_t fontID, const uint32_t sizeScale = 1) : m_FontID(fontID), m_SizeScale(sizeScale) {}
+
+		[[nodiscard]] uint64_t GetFontID() const override { return m_FontID; }
+		[[nodiscard]] const FontLineMetrics &GetLineMetrics() const override { return m_Metrics; }
+
+		bool GetGlyphMetrics(const uint32_t codepoint, GlyphMetrics &metrics) const override
+		{
+			if (codepoint == 0x7F || codepoint == 0)
+				return false;
+
+			metrics.advance = 0.5f;
+			if (codepoint == ' ')
+			{
+				metrics.left = metrics.right = metrics.bottom = metrics.top = 0.0f;
+				return true;
+			}
+
+			metrics.left = 0.05f;
+			metrics.right = 0.45f;
+			metrics.bottom = -0.1f;
+			metrics.top = 0.7f;
+			return true;
+		}
+
+		[[nodiscard]] float GetAdvance(const uint32_t codepoint, const uint32_t next) const override
+		{
+			return codepoint == 'A' && next == 'V' ? 0.4f : 0.5f;
+		}
+
+		void GetGlyphBitmapSize(const uint32_t codepoint, uint32_t &width, uint32_t &height) const override
+		{
+			if (codepoint == ' ')
+			{
+				width = height = 0;
+				return;
+			}
+			width = (6 + codepoint % 7) * m_SizeScale;
+			height = (10 + codepoint % 5) * m_SizeScale;
+		}
+
+		void RasterizeGlyph(const uint32_t codepoint, uint8_t *dst, const uint32_t rowPitch) const override
+		{
+			uint32_t width = 0, height = 0;
+			GetGlyphBitmapSize(codepoint, width, height);
+			for (uint32_t y = 0; y < height; ++y)
+				std::memset(dst + static_cast<size_t>(y) * rowPitch, static_cast<int>(codepoint & 0xFF), width);
+		}
+
+	private:
+		uint64_t m_FontID;
+		uint32_t m_SizeScale;
+		FontLineMetrics m_Metrics { 0.8f, -0.2f, 1.2f };
+	};
+
+}
+
+/// -------------------------------------------------------
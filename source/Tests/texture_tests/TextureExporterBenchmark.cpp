@@ -0,0 +1,86 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* TextureExporterBenchmark.cpp
+* -------------------------------------------------------
+* Throughput and quality benchmarks for the texture pipeline
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <vector>
+#include <SceneryEditorX/asset/exporters/mip_generator.h>
+#include <SceneryEditorX/asset/exporters/texture_exporter.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+#include "TextureTestUtils.h"
+
+/// -------------------------------------------------------
+
+using namespace SceneryEditorX;
+
+namespace SceneryEditorX::Tests
+{
+	TEST_CASE("Texture export throughput on a 4k texture", "[.][texture][performance]")
+	{
+		constexpr uint32_t size = 4096;
+		const auto image = MakeTestImage(size, size, 11);
+		const double megapixels = static_cast<double>(size) * size / 1e6;
+
+		struct Run
+		{
+			const char *name;
+			TextureCompression format;
+			uint32_t channels;
+		};
+
+		for (const auto &[name, format, channels] : { Run { "BC1", TextureCompression::BC1, 3 },
+		                                              Run { "BC3", TextureCompression::BC3, 4 },
+		                                              Run { "BC5", TextureCompression::BC5, 2 },
+		                                              Run { "BC7", TextureCompression::BC7, 4 } })
+		{
+			TextureExportSettings settings;
+			settings.compression = format;
+			settings.mips.normalMap = format == TextureCompression::BC5;
+
+			TextureExportStats stats;
+			const auto file = TextureExporter::EncodeDDS(image.data(), size, size, settings, &stats);
+			REQUIRE_FALSE(file.empty());
+
+			const dds::Header header = dds::read_header(file.data(), file.size());
+			const auto top = TextureExporter::DecompressLevel(file.data() + header.mip_offset(0), size, size, format);
+			const double psnr = ComputePSNR(image, top, channels);
+
+			INFO(name << ": mips " << stats.mipMilliseconds << " ms, compression " << stats.compressMilliseconds << " ms, total "
+			          << stats.totalMilliseconds << " ms (" << megapixels / (stats.totalMilliseconds / 1000.0) << " MPix/s), PSNR " << psnr << " dB");
+
+			REQUIRE(psnr > 30.0);
+		}
+	}
+
+	TEST_CASE("Mip generation throughput per filter", "[.][texture][mips][performance]")
+	{
+		constexpr uint32_t size = 4096;
+		const auto image = MakeTestImage(size, size, 12);
+
+		for (const MipFilter filter : { MipFilter::Box, MipFilter::Triangle, MipFilter::Kaiser })
+		{
+			MipSettings settings;
+			settings.filter = filter;
+			FloatImage base = MipGenerator::FromRGBA8(image.data(), size, size, settings);
+
+			const auto start = std::chrono::high_resolution_clock::now();
+			const auto chain = MipGenerator::GenerateChain(std::move(base), settings, &ThreadPool::Get());
+			const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+			INFO("Filter " << static_cast<int>(filter) << ": " << chain.size() << " levels in " << duration << " ms");
+			REQUIRE(chain.size() == 13);
+		}
+	}
+
+}
+
+/// -------------------------------------------------------
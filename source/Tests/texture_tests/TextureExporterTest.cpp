@@ -0,0 +1,275 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* TextureExporterTest.cpp
+* -------------------------------------------------------
+* Tests for CPU mip generation, block compression and DDS output
+* -------------------------------------------------------
+*/
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <SceneryEditorX/asset/exporters/bc_encoder.h>
+#include <SceneryEditorX/asset/exporters/mip_generator.h>
+#include <SceneryEditorX/asset/exporters/texture_exporter.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+#include "TextureTestUtils.h"
+
+/// -------------------------------------------------------
+
+using namespace SceneryEditorX;
+using Catch::Approx;
+
+namespace SceneryEditorX::Tests
+{
+	TEST_CASE("Mip chain dimensions", "[texture][mips]")
+	{
+		MipSettings settings;
+		REQUIRE(MipGenerator::GetMipLevelCount(1, 1) == 1);
+		REQUIRE(MipGenerator::GetMipLevelCount(256, 256) == 9);
+		REQUIRE(MipGenerator::GetMipLevelCount(300, 200) == 9);
+
+		const auto image = MakeTestImage(300, 200, 1);
+		const auto chain = MipGenerator::GenerateChain(MipGenerator::FromRGBA8(image.data(), 300, 200, settings), settings);
+		REQUIRE(chain.size() == 9);
+		REQUIRE(chain[1].width == 150);
+		REQUIRE(chain[1].height == 100);
+		REQUIRE(chain[8].width == 1);
+		REQUIRE(chain[8].height == 1);
+
+		settings.maxLevels = 3;
+		const auto limited = MipGenerator::GenerateChain(MipGenerator::FromRGBA8(image.data(), 300, 200, settings), settings);
+		REQUIRE(limited.size() == 3);
+	}
+
+	TEST_CASE("Mip filters preserve constant images", "[texture][mips]")
+	{
+		std::vector<uint8_t> flat(64 * 64 * 4);
+		for (size_t i = 0; i < flat.size(); i += 4)
+		{
+			flat[i + 0] = 200;
+			flat[i + 1] = 90;
+			flat[i + 2] = 17;
+			flat[i + 3] = 128;
+		}
+
+		for (const MipFilter filter : { MipFilter::Box, MipFilter::Triangle, MipFilter::Kaiser })
+		{
+			for (const bool wrap : { true, false })
+			{
+				MipSettings settings;
+				settings.filter = filter;
+				settings.wrap = wrap;
+				const auto chain = MipGenerator::GenerateChain(MipGenerator::FromRGBA8(flat.data(), 64, 64, settings), settings);
+
+				std::vector<uint8_t> level;
+				MipGenerator::ToRGBA8(chain.back(), settings, level);
+				REQUIRE(level.size() == 4);
+				REQUIRE(level[0] == 200);
+				REQUIRE(level[1] == 90);
+				REQUIRE(level[2] == 17);
+				REQUIRE(level[3] == 128);
+			}
+		}
+	}
+
+	TEST_CASE("Mip filtering is gamma correct for sRGB", "[texture][mips]")
+	{
+		/// Black/white checker: linear average is 0.5 which is ~188 in sRGB, not 128.
+		std::vector<uint8_t> checker(2 * 2 * 4, 255);
+		checker[0] = checker[1] = checker[2] = 0;
+		checker[12] = checker[13] = checker[14] = 0;
+
+		MipSettings settings;
+		settings.filter = MipFilter::Box;
+
+		std::vector<uint8_t> level;
+		const auto chain = MipGenerator::GenerateChain(MipGenerator::FromRGBA8(checker.data(), 2, 2, settings), settings);
+		MipGenerator::ToRGBA8(chain[1], settings, level);
+		REQUIRE(std::abs(static_cast<int>(level[0]) - 188) <= 1);
+
+		settings.sRGB = false;
+		const auto linearChain = MipGenerator::GenerateChain(MipGenerator::FromRGBA8(checker.data(), 2, 2, settings), settings);
+		MipGenerator::ToRGBA8(linearChain[1], settings, level);
+		REQUIRE(std::abs(static_cast<int>(level[0]) - 128) <= 1);
+	}
+
+	TEST_CASE("Normal map mips stay normalised", "[texture][mips]")
+	{
+		std::mt19937 rng(7);
+		std::uniform_real_distribution<float> dist(-0.7f, 0.7f);
+		std::vector<uint8_t> normals(128 * 128 * 4);
+		for (size_t i = 0; i < normals.size(); i += 4)
+		{
+			float n[3] = { dist(rng), dist(rng), 1.0f };
+			const float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			for (int c = 0; c < 3; ++c)
+				normals[i + c] = static_cast<uint8_t>((n[c] / len * 0.5f + 0.5f) * 255.0f + 0.5f);
+			normals[i + 3] = 255;
+		}
+
+		MipSettings settings;
+		settings.normalMap = true;
+		const auto chain = MipGenerator::GenerateChain(MipGenerator::FromRGBA8(normals.data(), 128, 128, settings), settings);
+		for (size_t level = 1; level < chain.size(); ++level)
+		{
+			const auto &image = chain[level];
+			for (size_t i = 0; i < image.texels.size(); i += 4)
+			{
+				const float *n = image.texels.data() + i;
+				REQUIRE(std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) == Approx(1.0f).margin(1e-4f));
+			}
+		}
+	}
+
+	TEST_CASE("Block compression round trip quality", "[texture][bc]")
+	{
+		constexpr uint32_t size = 256;
+		const auto image = MakeTestImage(size, size, 3);
+		ThreadPool pool(2);
+
+		struct Expectation
+		{
+			TextureCompression format;
+			double minPsnr;
+			uint32_t channels;
+		};
+
+		for (const auto &[format, minPsnr, channels] : { Expectation { TextureCompression::BC1, 32.0, 3 },
+		                                                 Expectation { TextureCompression::BC3, 32.0, 4 },
+		                                                 Expectation { TextureCompression::BC5, 38.0, 2 },
+		                                                 Expectation { TextureCompression::BC7, 38.0, 4 } })
+		{
+			const auto encoded = TextureExporter::CompressLevel(image.data(), size, size, format, pool);
+			REQUIRE(encoded.size() == (size / 4) * (size / 4) * TextureExporter::GetBlockBytes(format));
+
+			const auto decoded = TextureExporter::DecompressLevel(encoded.data(), size, size, format);
+			const double psnr = ComputePSNR(image, decoded, channels);
+			INFO("Format " << static_cast<int>(format) << " PSNR " << psnr << " dB");
+			REQUIRE(psnr > minPsnr);
+		}
+	}
+
+	TEST_CASE("Block encoders handle flat and extreme blocks", "[texture][bc]")
+	{
+		uint8_t block[64];
+		uint8_t decoded[64];
+		uint8_t encoded[16];
+
+		SECTION("Flat colour is reproduced exactly by BC7")
+		{
+			for (int i = 0; i < 16; ++i)
+			{
+				block[i * 4 + 0] = 10;
+				block[i * 4 + 1] = 120;
+				block[i * 4 + 2] = 250;
+				block[i * 4 + 3] = 64;
+			}
+			BCEncoder::EncodeBC7(block, encoded);
+			REQUIRE(BCEncoder::DecodeBC7(encoded, decoded));
+			for (int i = 0; i < 64; ++i)
+				REQUIRE(std::abs(static_cast<int>(decoded[i]) - static_cast<int>(block[i])) <= 1);
+		}
+
+		SECTION("BC4 keeps exact 0 and 255")
+		{
+			uint8_t values[16];
+			uint8_t out[16];
+			for (int i = 0; i < 16; ++i)
+				values[i] = (i % 3 == 0) ? 0 : (i % 3 == 1 ? 255 : static_cast<uint8_t>(100 + i));
+			BCEncoder::EncodeBC4(values, encoded);
+			BCEncoder::DecodeBC4(encoded, out);
+			for (int i = 0; i < 16; ++i)
+			{
+				if (values[i] == 0 || values[i] == 255)
+					REQUIRE(out[i] == values[i]);
+			}
+		}
+
+		SECTION("BC1 always uses 4 colour mode")
+		{
+			for (int i = 0; i < 16; ++i)
+			{
+				block[i * 4 + 0] = static_cast<uint8_t>(i * 16);
+				block[i * 4 + 1] = static_cast<uint8_t>(255 - i * 16);
+				block[i * 4 + 2] = 30;
+				block[i * 4 + 3] = 255;
+			}
+			BCEncoder::EncodeBC1(block, encoded);
+			const uint16_t c0 = static_cast<uint16_t>(encoded[0] | (encoded[1] << 8));
+			const uint16_t c1 = static_cast<uint16_t>(encoded[2] | (encoded[3] << 8));
+			REQUIRE(c0 >= c1);
+			BCEncoder::DecodeBC1(encoded, decoded);
+			for (int i = 0; i < 16; ++i)
+				REQUIRE(decoded[i * 4 + 3] == 255);
+		}
+	}
+
+	TEST_CASE("DDS export layout", "[texture][dds]")
+	{
+		constexpr uint32_t width = 200;
+		constexpr uint32_t height = 120;
+		const auto image = MakeTestImage(width, height, 5);
+
+		TextureExportSettings settings;
+		settings.compression = TextureCompression::BC3;
+
+		ThreadPool pool(3);
+		TextureExportStats stats;
+		const auto file = TextureExporter::EncodeDDS(image.data(), width, height, settings, &stats, &pool);
+		REQUIRE_FALSE(file.empty());
+
+		const dds::Header header = dds::read_header(file.data(), file.size());
+		REQUIRE(header.is_valid());
+		REQUIRE(header.is_dx10());
+		REQUIRE(header.format() == dds::DXGI_FORMAT_BC3_UNORM_SRGB);
+		REQUIRE(header.width() == width);
+		REQUIRE(header.height() == height);
+		REQUIRE(header.mip_levels() == MipGenerator::GetMipLevelCount(width, height));
+		REQUIRE(file.size() == header.data_offset() + header.data_size());
+		REQUIRE(stats.mipLevels == header.mip_levels());
+		REQUIRE(stats.outputBytes == file.size());
+
+		const auto top = TextureExporter::DecompressLevel(file.data() + header.mip_offset(0), width, height, TextureCompression::BC3);
+		REQUIRE(ComputePSNR(image, top, 4) > 30.0);
+
+		SECTION("Normal maps use a linear format")
+		{
+			settings.compression = TextureCompression::BC5;
+			settings.mips.normalMap = true;
+			const auto normalFile = TextureExporter::EncodeDDS(image.data(), width, height, settings, nullptr, &pool);
+			REQUIRE(dds::read_header(normalFile.data(), normalFile.size()).format() == dds::DXGI_FORMAT_BC5_UNORM);
+		}
+
+		SECTION("Mip generation can be disabled")
+		{
+			settings.generateMips = false;
+			const auto single = TextureExporter::EncodeDDS(image.data(), width, height, settings, nullptr, &pool);
+			REQUIRE(dds::read_header(single.data(), single.size()).mip_levels() == 1);
+		}
+	}
+
+	TEST_CASE("DDS export is deterministic across thread counts", "[texture][dds]")
+	{
+		const auto image = MakeTestImage(333, 257, 9);
+		TextureExportSettings settings;
+		settings.compression = TextureCompression::BC7;
+
+		ThreadPool one(1);
+		ThreadPool many(6);
+		const auto a = TextureExporter::EncodeDDS(image.data(), 333, 257, settings, nullptr, &one);
+		const auto b = TextureExporter::EncodeDDS(image.data(), 333, 257, settings, nullptr, &many);
+		REQUIRE(a.size() == b.size());
+		REQUIRE(std::memcmp(a.data(), b.data(), a.size()) == 0);
+	}
+
+}
+
+/// -------------------------------------------------------
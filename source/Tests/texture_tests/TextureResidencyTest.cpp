@@ -0,0 +1,411 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* TextureResidencyTest.cpp
+* -------------------------------------------------------
+* Tests for budgeted DDS mip streaming
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <SceneryEditorX/asset/managers/texture_residency.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+/// -------------------------------------------------------
+
+using namespace SceneryEditorX;
+
+namespace SceneryEditorX::Tests
+{
+	namespace
+	{
+		/// RGBA8 DDS where every byte of level N is N + 1, so reads can be checked per level.
+		std::vector<uint8_t> MakeLevelPatternDDS(const uint32_t width, const uint32_t height)
+		{
+			uint32_t levels = 1;
+			while ((width >> levels) > 0 || (height >> levels) > 0)
+				++levels;
+
+			dds::Header header;
+			dds::write_header(&header, dds::DXGI_FORMAT_R8G8B8A8_UNORM, width, height, levels);
+
+			std::vector<uint8_t> file(header.data_offset() + header.data_size());
+			std::memcpy(file.data(), &header, sizeof(dds::Header));
+			for (uint32_t mip = 0; mip < levels; ++mip)
+				std::memset(file.data() + header.mip_offset(mip), static_cast<int>(mip + 1), header.mip_size(mip));
+			return file;
+		}
+
+		bool LevelMatches(const std::vector<uint8_t> *data, const uint32_t mip)
+		{
+			if (!data || data->empty())
+				return false;
+			for (const uint8_t value : *data)
+			{
+				if (value != mip + 1)
+					return false;
+			}
+			return true;
+		}
+
+		/// In-memory files with read accounting.
+		class MemoryStreamSource : public TextureStreamSource
+		{
+		public:
+			void Add(const std::string &path, std::vector<uint8_t> bytes) { m_Files[path] = std::move(bytes); }
+
+			uint64_t GetFileSize(const std::filesystem::path &path) override
+			{
+				const auto it = m_Files.find(path.string());
+				return it == m_Files.end() ? 0 : it->second.size();
+			}
+
+			bool Read(const std::filesystem::path &path, const uint64_t offset, const uint64_t size, uint8_t *dst) override
+			{
+				const auto it = m_Files.find(path.string());
+				if (it == m_Files.end() || offset + size > it->second.size())
+					return false;
+
+				std::memcpy(dst, it->second.data() + offset, size);
+				++reads;
+				bytes += size;
+				return true;
+			}
+
+			std::atomic<uint64_t> reads = 0;
+			std::atomic<uint64_t> bytes = 0;
+
+		private:
+			std::unordered_map<std::string, std::vector<uint8_t>> m_Files;
+		};
+
+		/// Serves a header for any path and zeros for pixel data, for large scale decision benchmarks.
+		class VirtualStreamSource : public TextureStreamSource
+		{
+		public:
+			VirtualStreamSource(const uint32_t width, const uint32_t height, const uint32_t levels)
+			{
+				dds::write_header(&m_Header, dds::DXGI_FORMAT_BC1_UNORM, width, height, levels);
+			}
+
+			uint64_t GetFileSize(const std::filesystem::path &) override { return m_Header.data_offset() + m_Header.data_size(); }
+
+			bool Read(const std::filesystem::path &, const uint64_t offset, const uint64_t size, uint8_t *dst) override
+			{
+				if (offset == 0)
+					std::memcpy(dst, &m_Header, std::min<uint64_t>(size, sizeof(dds::Header)));
+				else
+					std::memset(dst, 0, size);
+				return true;
+			}
+
+		private:
+			dds::Header m_Header {};
+		};
+
+		TextureResidencySettings SyncSettings()
+		{
+			TextureResidencySettings settings;
+			settings.asyncIO = false;
+			settings.tailDimension = 64;
+			return settings;
+		}
+	}
+
+	TEST_CASE("Desired mip follows screen coverage", "[texture][residency]")
+	{
+		REQUIRE(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 1024.0f, 11) == 0);
+		REQUIRE(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 2048.0f, 11) == 0);
+		REQUIRE(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 512.0f, 11) == 1);
+		REQUIRE(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 300.0f, 11) == 1);
+		REQUIRE(TextureResidencyManager::ComputeDesiredMip(1024, 512, 64.0f, 11) == 4);
+		REQUIRE(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 0.5f, 11) == 10);
+		REQUIRE(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 0.0f, 11) == 10);
+		REQUIRE(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 512.0f, 11, 1.0f) == 2);
+	}
+
+	TEST_CASE("Registration only reads the header and mip tail", "[texture][residency]")
+	{
+		auto source = std::make_shared<MemoryStreamSource>();
+		const auto file = MakeLevelPatternDDS(1024, 1024);
+		source->Add("a.dds", file);
+
+		TextureResidencyManager residency(SyncSettings(), source);
+		const auto id = residency.Register("a.dds");
+		REQUIRE(id != TextureResidencyManager::InvalidTexture);
+
+		const dds::Header &header = *residency.GetHeader(id);
+		REQUIRE(residency.GetMipCount(id) == 11);
+		REQUIRE(residency.GetTailMip(id) == 4);
+		REQUIRE(residency.GetResidentMip(id) == 4);
+
+		uint64_t tailBytes = 0;
+		for (uint32_t mip = 4; mip < 11; ++mip)
+		{
+			tailBytes += header.mip_size(mip);
+			REQUIRE(LevelMatches(residency.GetMipData(id, mip), mip));
+		}
+		REQUIRE(residency.GetMipData(id, 3) == nullptr);
+		REQUIRE(source->reads == 2);
+		REQUIRE(source->bytes == sizeof(dds::Header) + tailBytes);
+		REQUIRE(residency.GetStats().residentBytes == tailBytes);
+		REQUIRE(tailBytes < file.size() / 100);
+
+		SECTION("Missing and truncated files are rejected")
+		{
+			source->Add("short.dds", std::vector<uint8_t>(file.begin(), file.begin() + static_cast<std::ptrdiff_t>(file.size() / 2)));
+			source->Add("junk.dds", std::vector<uint8_t>(4096, 0x5A));
+			REQUIRE(residency.Register("missing.dds") == TextureResidencyManager::InvalidTexture);
+			REQUIRE(residency.Register("short.dds") == TextureResidencyManager::InvalidTexture);
+			REQUIRE(residency.Register("junk.dds") == TextureResidencyManager::InvalidTexture);
+			REQUIRE(residency.GetStats().textureCount == 1);
+		}
+	}
+
+	TEST_CASE("Demand streams finer levels one at a time", "[texture][residency]")
+	{
+		auto source = std::make_shared<MemoryStreamSource>();
+		source->Add("a.dds", MakeLevelPatternDDS(1024, 1024));
+
+		TextureResidencyManager residency(SyncSettings(), source);
+		const auto id = residency.Register("a.dds");
+
+		std::vector<uint32_t> notified;
+		residency.SetResidencyCallback([&](const TextureResidencyManager::TextureID, const uint32_t mip) { notified.push_back(mip); });
+
+		/// Without demand nothing is streamed.
+		for (int frame = 0; frame < 3; ++frame)
+			residency.Update();
+		REQUIRE(residency.GetResidentMip(id) == 4);
+
+		uint32_t previous = residency.GetResidentMip(id);
+		for (int frame = 0; frame < 10; ++frame)
+		{
+			residency.RequestCoverage(id, 1000.0f);
+			residency.RequestCoverage(id, 100.0f);
+			residency.Update();
+
+			const uint32_t resident = residency.GetResidentMip(id);
+			REQUIRE(resident <= previous);
+			REQUIRE(previous - resident <= 1);
+			previous = resident;
+		}
+
+		REQUIRE(residency.GetDesiredMip(id) == 0);
+		REQUIRE(residency.GetResidentMip(id) == 0);
+		for (uint32_t mip = 0; mip < 11; ++mip)
+			REQUIRE(LevelMatches(residency.GetMipData(id, mip), mip));
+
+		REQUIRE(notified == std::vector<uint32_t> { 3, 2, 1, 0 });
+		REQUIRE(residency.GetStats().completedRequests == 4);
+		REQUIRE(residency.GetStats().pendingRequests == 0);
+		REQUIRE(residency.GetStats().evictions == 0);
+	}
+
+	TEST_CASE("Budget is enforced with least recently used eviction", "[texture][residency]")
+	{
+		auto source = std::make_shared<MemoryStreamSource>();
+		const auto file = MakeLevelPatternDDS(256, 256);
+		const dds::Header header = dds::read_header(file.data(), file.size());
+		const uint64_t streamedBytes = header.mip_size(0) + header.mip_size(1);
+		const uint64_t tailBytes = header.data_size() - streamedBytes;
+
+		for (const char *name : { "a.dds", "b.dds", "c.dds", "d.dds" })
+			source->Add(name, file);
+
+		TextureResidencySettings settings = SyncSettings();
+		settings.budgetBytes = 4 * tailBytes + 2 * streamedBytes + 1024;
+		TextureResidencyManager residency(settings, source);
+
+		std::vector<TextureResidencyManager::TextureID> ids;
+		for (const char *name : { "a.dds", "b.dds", "c.dds", "d.dds" })
+			ids.push_back(residency.Register(name));
+
+		const auto runFrames = [&](const std::vector<TextureResidencyManager::TextureID> &visible, const int frames) {
+			for (int frame = 0; frame < frames; ++frame)
+			{
+				for (const auto id : visible)
+					residency.RequestCoverage(id, 256.0f);
+				residency.Update();
+				REQUIRE(residency.GetStats().residentBytes + residency.GetStats().inFlightBytes <= settings.budgetBytes);
+			}
+		};
+
+		runFrames({ ids[0], ids[1] }, 6);
+		REQUIRE(residency.GetResidentMip(ids[0]) == 0);
+		REQUIRE(residency.GetResidentMip(ids[1]) == 0);
+		REQUIRE(residency.GetStats().evictions == 0);
+
+		/// Touch b once more so a is the least recently used.
+		runFrames({ ids[1] }, 1);
+		runFrames({ ids[2] }, 6);
+		REQUIRE(residency.GetResidentMip(ids[2]) == 0);
+		REQUIRE(residency.GetResidentMip(ids[0]) == 2);
+		REQUIRE(residency.GetResidentMip(ids[1]) == 0);
+		REQUIRE(residency.GetStats().evictions == 2);
+		REQUIRE(residency.GetStats().evictedBytes == streamedBytes);
+
+		/// c and d are both visible and fill the budget; b is evicted, neither visible one is.
+		runFrames({ ids[2], ids[3] }, 6);
+		REQUIRE(residency.GetResidentMip(ids[2]) == 0);
+		REQUIRE(residency.GetResidentMip(ids[3]) == 0);
+		REQUIRE(residency.GetResidentMip(ids[1]) == 2);
+
+		/// A third visible texture cannot steal from textures used in the same frame.
+		runFrames({ ids[0], ids[2], ids[3] }, 6);
+		REQUIRE(residency.GetResidentMip(ids[2]) == 0);
+		REQUIRE(residency.GetResidentMip(ids[3]) == 0);
+		REQUIRE(residency.GetResidentMip(ids[0]) == 2);
+
+		SECTION("Shrinking the budget evicts immediately")
+		{
+			residency.SetBudget(4 * tailBytes + streamedBytes);
+			residency.Update();
+			REQUIRE(residency.GetStats().residentBytes <= 4 * tailBytes + streamedBytes);
+		}
+
+		SECTION("Surplus detail is dropped before recently used detail")
+		{
+			/// d is still in use but only needs its tail now, so it is evicted ahead of c.
+			for (int frame = 0; frame < 4; ++frame)
+			{
+				residency.RequestCoverage(ids[2], 256.0f);
+				residency.RequestCoverage(ids[3], 16.0f);
+				residency.RequestCoverage(ids[0], 256.0f);
+				residency.Update();
+			}
+			REQUIRE(residency.GetResidentMip(ids[2]) == 0);
+			REQUIRE(residency.GetResidentMip(ids[0]) == 0);
+			REQUIRE(residency.GetResidentMip(ids[3]) == 2);
+		}
+	}
+
+	TEST_CASE("Unregistering discards reads in flight", "[texture][residency]")
+	{
+		auto source = std::make_shared<MemoryStreamSource>();
+		source->Add("a.dds", MakeLevelPatternDDS(512, 512));
+
+		TextureResidencyManager residency(SyncSettings(), source);
+		const auto id = residency.Register("a.dds");
+		residency.RequestMip(id, 0);
+		residency.Update();
+		REQUIRE(residency.GetStats().pendingRequests == 1);
+
+		residency.Unregister(id);
+		REQUIRE_FALSE(residency.IsValid(id));
+
+		/// The slot is reused; the stale read must not land in the new texture.
+		source->Add("b.dds", MakeLevelPatternDDS(128, 128));
+		const auto reused = residency.Register("b.dds");
+		REQUIRE(reused == id);
+		residency.Update();
+
+		REQUIRE(residency.GetResidentMip(reused) == 1);
+		REQUIRE(residency.GetStats().inFlightBytes == 0);
+		REQUIRE(residency.GetStats().completedRequests == 0);
+		REQUIRE(residency.GetStats().textureCount == 1);
+	}
+
+	TEST_CASE("Asynchronous streaming from disk", "[texture][residency]")
+	{
+		const auto dir = std::filesystem::temp_directory_path() / "sedx_residency_test";
+		std::filesystem::create_directories(dir);
+		const auto path = dir / "stream.dds";
+		const auto file = MakeLevelPatternDDS(512, 256);
+		{
+			std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+			stream.write(reinterpret_cast<const char *>(file.data()), static_cast<std::streamsize>(file.size()));
+		}
+
+		ThreadPool pool(2);
+		TextureResidencySettings settings;
+		settings.tailDimension = 32;
+		TextureResidencyManager residency(settings, nullptr, &pool);
+
+		const auto id = residency.Register(path);
+		REQUIRE(id != TextureResidencyManager::InvalidTexture);
+		REQUIRE(residency.GetResidentMip(id) == 4);
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (residency.GetResidentMip(id) != 0 && std::chrono::steady_clock::now() < deadline)
+		{
+			residency.RequestCoverage(id, 512.0f);
+			residency.Update();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		residency.Flush();
+
+		REQUIRE(residency.GetResidentMip(id) == 0);
+		for (uint32_t mip = 0; mip < residency.GetMipCount(id); ++mip)
+			REQUIRE(LevelMatches(residency.GetMipData(id, mip), mip));
+
+		const auto &stats = residency.GetStats();
+		REQUIRE(stats.completedRequests == 4);
+		REQUIRE(stats.failedRequests == 0);
+		REQUIRE(stats.bytesRead == file.size());
+		REQUIRE(stats.maxLatencyMs >= stats.averageLatencyMs);
+		INFO("Average latency " << stats.averageLatencyMs << " ms, max " << stats.maxLatencyMs << " ms");
+
+		std::filesystem::remove_all(dir);
+	}
+
+	TEST_CASE("Texture residency decision performance", "[.][texture][residency][performance]")
+	{
+		constexpr uint32_t textureCount = 10000;
+		constexpr int frames = 200;
+
+		auto source = std::make_shared<VirtualStreamSource>(2048, 2048, 12);
+		TextureResidencySettings settings = SyncSettings();
+		settings.budgetBytes = 64ull << 20;
+		settings.maxInFlight = 32;
+		TextureResidencyManager residency(settings, source);
+
+		std::vector<TextureResidencyManager::TextureID> ids;
+		ids.reserve(textureCount);
+		for (uint32_t i = 0; i < textureCount; ++i)
+			ids.push_back(residency.Register("virtual_" + std::to_string(i) + ".dds"));
+
+		/// A camera panning across the set: a window of visible textures with varying screen size.
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<float> coverage(16.0f, 2048.0f);
+		uint64_t overBudgetFrames = 0;
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			const uint32_t first = static_cast<uint32_t>(frame) * 25;
+			for (uint32_t i = 0; i < 1500; ++i)
+				residency.RequestCoverage(ids[(first + i) % textureCount], coverage(rng));
+			residency.Update();
+
+			if (residency.GetStats().residentBytes > settings.budgetBytes)
+				++overBudgetFrames;
+		}
+		const double totalMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		const auto &stats = residency.GetStats();
+		INFO("Textures: " << textureCount << ", frames: " << frames);
+		INFO("Average frame: " << totalMs / frames << " ms");
+		INFO("Resident: " << (stats.residentBytes >> 20) << " MB, peak " << (stats.peakResidentBytes >> 20) << " MB");
+		INFO("Streamed levels: " << stats.completedRequests << ", evictions: " << stats.evictions);
+		INFO("Average latency: " << stats.averageLatencyMs << " ms");
+
+		REQUIRE(overBudgetFrames == 0);
+		REQUIRE(stats.evictions > 0);
+	}
+
+}
+
+/// -------------------------------------------------------
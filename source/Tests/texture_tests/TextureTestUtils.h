@@ -0,0 +1,83 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* TextureTestUtils.h
+* -------------------------------------------------------
+* Synthetic images and quality metrics for texture tests
+* -------------------------------------------------------
+*/
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX::Tests
+{
+	/**
+	 * @brief Photo-like RGBA8 test image: smooth gradients, a few hard edges and mild noise.
+	 */
+	inline std::vector<uint8_t> MakeTestImage(const uint32_t width, const uint32_t height, const uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::normal_distribution<float> noise(0.0f, 2.0f);
+
+		std::vector<uint8_t> image(static_cast<size_t>(width) * height * 4);
+		for (uint32_t y = 0; y < height; ++y)
+		{
+			for (uint32_t x = 0; x < width; ++x)
+			{
+				const float u = static_cast<float>(x) / static_cast<float>(width);
+				const float v = static_cast<float>(y) / static_cast<float>(height);
+				const bool stripe = ((x / 37) + (y / 53)) % 5 == 0;
+
+				float rgba[4] = {
+					120.0f + 100.0f * std::sin(u * 6.2831f + static_cast<float>(seed)),
+					90.0f + 80.0f * v + (stripe ? 60.0f : 0.0f),
+					60.0f + 70.0f * std::cos((u + v) * 4.0f),
+					255.0f * (0.5f + 0.5f * std::sin(v * 3.1415f))
+				};
+
+				uint8_t *texel = image.data() + (static_cast<size_t>(y) * width + x) * 4;
+				for (int c = 0; c < 4; ++c)
+					texel[c] = static_cast<uint8_t>(std::clamp(rgba[c] + (c < 3 ? noise(rng) : 0.0f), 0.0f, 255.0f));
+			}
+		}
+		return image;
+	}
+
+	/**
+	 * @brief Peak signal to noise ratio over the first `channels` channels of two RGBA8 images.
+	 */
+	inline double ComputePSNR(const std::vector<uint8_t> &reference, const std::vector<uint8_t> &test, const uint32_t channels)
+	{
+		double sum = 0.0;
+		size_t count = 0;
+		for (size_t i = 0; i + 3 < reference.size() && i + 3 < test.size(); i += 4)
+		{
+			for (uint32_t c = 0; c < channels; ++c)
+			{
+				const double d = static_cast<double>(reference[i + c]) - static_cast<double>(test[i + c]);
+				sum += d * d;
+				++count;
+			}
+		}
+
+		if (count == 0 || sum == 0.0)
+			return std::numeric_limits<double>::infinity();
+
+		const double mse = sum / static_cast<double>(count);
+		return 10.0 * std::log10(255.0 * 255.0 / mse);
+	}
+
+}
+
+/// -------------------------------------------------------
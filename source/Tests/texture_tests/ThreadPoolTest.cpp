@@ -0,0 +1,79 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* ThreadPoolTest.cpp
+* -------------------------------------------------------
+* Tests for the worker pool used by the asset pipeline
+* -------------------------------------------------------
+*/
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <vector>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+/// -------------------------------------------------------
+
+using namespace SceneryEditorX;
+
+namespace SceneryEditorX::Tests
+{
+	TEST_CASE("ThreadPool runs every index exactly once", "[threading]")
+	{
+		ThreadPool pool(4);
+		std::vector<std::atomic<int>> hits(10000);
+		pool.ParallelFor(static_cast<uint32_t>(hits.size()), [&](const uint32_t i) { hits[i].fetch_add(1); });
+
+		for (const auto &hit : hits)
+			REQUIRE(hit.load() == 1);
+	}
+
+	TEST_CASE("ThreadPool ranges cover the input", "[threading]")
+	{
+		ThreadPool pool(3);
+		std::atomic<uint64_t> sum = 0;
+		std::atomic<bool> oversized = false;
+		pool.ParallelForRange(1001, 64, [&](const uint32_t begin, const uint32_t end)
+		{
+			if (end - begin > 64)
+				oversized = true;
+			for (uint32_t i = begin; i < end; ++i)
+				sum.fetch_add(i);
+		});
+		REQUIRE(sum.load() == 1000ull * 1001ull / 2ull);
+		REQUIRE_FALSE(oversized.load());
+	}
+
+	TEST_CASE("ThreadPool nested ParallelFor does not deadlock", "[threading]")
+	{
+		ThreadPool pool(2);
+		std::atomic<int> total = 0;
+		pool.ParallelFor(8, [&](uint32_t)
+		{
+			pool.ParallelFor(8, [&](uint32_t) { total.fetch_add(1); });
+		});
+		REQUIRE(total.load() == 64);
+	}
+
+	TEST_CASE("ThreadPool propagates exceptions and futures", "[threading]")
+	{
+		ThreadPool pool(2);
+		REQUIRE_THROWS_AS(pool.ParallelFor(100, [](const uint32_t i)
+		{
+			if (i == 42)
+				throw std::runtime_error("boom");
+		}), std::runtime_error);
+
+		auto future = pool.Submit([](const int a, const int b) { return a + b; }, 20, 22);
+		REQUIRE(future.get() == 42);
+
+		pool.WaitIdle();
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,417 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* AptDatTest.cpp
+* -------------------------------------------------------
+* Index, parsing tests and benchmarks for the apt.dat reader
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <SceneryEditorX/asset/xplane/apt_dat.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+/// -------------------------------------------------------
+
+using namespace SceneryEditorX;
+
+namespace SceneryEditorX::Tests
+{
+	/// One airport exercising every row family the parser models.
+	const char *const APT_SAMPLE =
+		"I\r\n"
+		"1100 Generated by WorldEditor\r\n"
+		"\r\n"
+		"1   433 0 0 KTST Test   Field  Intl\r\n"
+		"1302 icao_code KTST\r\n"
+		"1302 city Testville\r\n"
+		"100 45.72 1 2 0.25 1 2 1 09 47.00000000 -122.00000000 120.5 30 3 8 1 2 27 47.00000000 -121.98000000 0 0 3 0 0 0\r\n"
+		"101 50.00 1 04 47.01 -122.01 22 47.02 -122.00\r\n"
+		"102 H1 47.0050 -121.9950 90.0 15.0 15.0 2 0 0 0.25 1\r\n"
+		"110 1 0.25 45.00 Apron A\r\n"
+		"111 47.001 -121.999 1 102\r\n"
+		"112 47.002 -121.999 47.0025 -121.9985\r\n"
+		"113 47.002 -121.998\r\n"
+		"111 47.0012 -121.9988\r\n"
+		"114 47.0013 -121.9987 47.0014 -121.9986\r\n"
+		"120 Hold short\r\n"
+		"111 47.003 -121.997 4\r\n"
+		"115 47.004 -121.997\r\n"
+		"130 Airport Boundary\r\n"
+		"111 47.0 -122.0\r\n"
+		"113 47.1 -122.0\r\n"
+		"14 47.003 -121.996 100 0 Tower Viewpoint\r\n"
+		"18 47.004 -121.996 1 BCN\r\n"
+		"19 47.005 -121.996 1 WS\r\n"
+		"20 47.006 -121.996 270.0 0 2 {@Y}A{@R}09-27\r\n"
+		"21 47.007 -121.996 2 90.00 3.00 09 PAPI-4L\r\n"
+		"1300 47.008 -121.996 180.0 gate jets|turboprops Gate A1\r\n"
+		"1301 C airline aal dal\r\n"
+		"15 47.009 -121.996 0.0 Ramp 1\r\n"
+		"50 12345 TST ATIS\r\n"
+		"1051 118275 TST TWR\r\n"
+		"1000 West flow\r\n"
+		"1001 KTST 180 359 15\r\n"
+		"1002 KTST 500\r\n"
+		"1003 KTST 1.5\r\n"
+		"1004 0000 2400\r\n"
+		"1101 27 right\r\n"
+		"1100 27 11827 arrivals|departures jets|turboprops 180 359 240 300 West arrivals\r\n"
+		"1200\r\n"
+		"1201 47.0 -122.0 both 0 A_start\r\n"
+		"1201 47.0 -121.9 junc 1\r\n"
+		"1202 0 1 twoway taxiway_E A\r\n"
+		"1204 departure 09,27\r\n"
+		"1204 ils 09\r\n"
+		"1206 1 0 oneway service road\r\n"
+		"1400 47.0 -122.0 90.0 fuel_liners 2 Truck\r\n"
+		"16 0 0 0 SEA1 Sea Base\r\n"
+		"101 40.0 0 18 48.0 -122.0 36 48.1 -122.0\r\n"
+		"17 12 0 0 HEL1 Hospital Heliport\r\n"
+		"102 H1 49.0 -122.0 0 20 20 1 0 0 0.25 0\r\n"
+		"99\r\n";
+
+	/// Deterministic apt.dat of @p count small airports, about 2 KiB each.
+	std::string MakeSyntheticAptDat(const uint32_t count)
+	{
+		std::string text = "I\n1100 Generated by WorldEditor\n\n";
+		text.reserve(static_cast<size_t>(count) * 4096);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const double lat = -60.0 + (i % 1200) * 0.1;
+			const double lon = -180.0 + (i / 1200) * 0.1;
+			const std::string ident = "X" + std::to_string(i);
+			text += "1 " + std::to_string(i % 9000) + " 0 0 " + ident + " Synthetic Airport " + std::to_string(i) + "\n";
+			text += "1302 icao_code " + ident + "\n";
+			text += "100 30.00 1 0 0.25 0 2 1 09 " + std::to_string(lat) + " " + std::to_string(lon) + " 0 0 3 0 0 0 27 " +
+			        std::to_string(lat) + " " + std::to_string(lon + 0.02) + " 0 0 3 0 0 0\n";
+			for (int polygon = 0; polygon < 4; ++polygon)
+			{
+				text += "110 1 0.25 0.00 Taxiway " + std::to_string(polygon) + "\n";
+				for (int node = 0; node < 12; ++node)
+				{
+					const std::string position = std::to_string(lat + node * 1e-4) + " " + std::to_string(lon + polygon * 1e-3);
+					if (node == 11)
+						text += "113 " + position + "\n";
+					else if (node % 3 == 0)
+						text += "112 " + position + " " + position + " 1 102\n";
+					else
+						text += "111 " + position + " 1\n";
+				}
+			}
+			for (int sign = 0; sign < 6; ++sign)
+				text += "20 " + std::to_string(lat) + " " + std::to_string(lon) + " 90.0 0 2 {@Y}A" + std::to_string(sign) + "\n";
+			text += "1050 122800 CTAF\n";
+			text += "1300 " + std::to_string(lat) + " " + std::to_string(lon) + " 90.0 tie_down props Ramp\n";
+		}
+		text += "99\n";
+		return text;
+	}
+
+	/// -------------------------------------------------------
+
+	TEST_CASE("apt.dat tokenizer", "[xplane][apt]")
+	{
+		AptRow row;
+		REQUIRE(AptDatFile::Tokenize("1   433 0 0 KTST Test   Field  Intl\r", row));
+		CHECK(row.code == 1);
+		CHECK(row.tokenCount == 8);
+		CHECK(row.Token(4) == "KTST");
+		CHECK(row.Rest(5) == "Test   Field  Intl");
+		CHECK(row.Int(1) == 433);
+		CHECK(row.Token(20).empty());
+		CHECK(row.Double(20, 7.5) == 7.5);
+
+		/// Views point into the source; nothing is copied.
+		const std::string line = "21 47.5 -122.25 2";
+		REQUIRE(AptDatFile::Tokenize(line, row));
+		CHECK(row.tokens[1].data() == line.data() + 3);
+		CHECK(row.Double(2) == Catch::Approx(-122.25));
+
+		CHECK_FALSE(AptDatFile::Tokenize("   \t\r", row));
+		CHECK_FALSE(AptDatFile::Tokenize("I", row));
+		CHECK_FALSE(AptDatFile::Tokenize("1a 2 3", row));
+	}
+
+	TEST_CASE("apt.dat index", "[xplane][apt]")
+	{
+		const std::string text = APT_SAMPLE;
+		AptDatFile file;
+		REQUIRE(file.Load(text.data(), text.size()));
+		CHECK(file.GetVersion() == 1100);
+
+		const auto &airports = file.GetAirports();
+		REQUIRE(airports.size() == 3);
+		CHECK(airports[0].ident == "KTST");
+		CHECK(airports[0].name == "Test   Field  Intl");
+		CHECK(airports[0].elevation == 433);
+		CHECK(airports[1].type == Apt::AirportType::Seaplane);
+		CHECK(airports[2].type == Apt::AirportType::Heliport);
+		CHECK(airports[0].offset + airports[0].length == airports[1].offset);
+		CHECK(text.compare(airports[2].offset + airports[2].length, 2, "99") == 0);
+
+		REQUIRE(file.Find("HEL1") == &airports[2]);
+		CHECK(file.Find("NOPE") == nullptr);
+
+		AptAirport airport;
+		CHECK_FALSE(file.ReadAirport("NOPE", airport));
+		CHECK(file.GetError().find("NOPE") != std::string::npos);
+
+		AptDatFile bad;
+		CHECK_FALSE(bad.Load("garbage\n", 8));
+		CHECK_FALSE(bad.IsOpen());
+	}
+
+	TEST_CASE("apt.dat airport rows", "[xplane][apt]")
+	{
+		const std::string text = APT_SAMPLE;
+		AptDatFile file;
+		REQUIRE(file.Load(text.data(), text.size()));
+
+		AptAirport airport;
+		REQUIRE(file.ReadAirport("KTST", airport));
+		CHECK(airport.ident == "KTST");
+		REQUIRE(airport.FindMetadata("city"));
+		CHECK(*airport.FindMetadata("city") == "Testville");
+
+		REQUIRE(airport.runways.size() == 1);
+		const AptRunway &runway = airport.runways[0];
+		CHECK(runway.width == Catch::Approx(45.72));
+		CHECK(runway.centreLights);
+		CHECK(runway.ends[0].number == "09");
+		CHECK(runway.ends[0].displacedThreshold == Catch::Approx(120.5));
+		CHECK(runway.ends[0].approachLights == 8);
+		CHECK(runway.ends[0].reil == 2);
+		CHECK(runway.ends[1].number == "27");
+		CHECK(runway.ends[1].longitude == Catch::Approx(-121.98));
+
+		REQUIRE(airport.waterRunways.size() == 1);
+		CHECK(airport.waterRunways[0].numbers[1] == "22");
+		REQUIRE(airport.helipads.size() == 1);
+		CHECK(airport.helipads[0].edgeLights == 1);
+
+		/// Pavement with a bezier outer ring and a hole, an open line chain and the boundary.
+		REQUIRE(airport.polygons.size() == 3);
+		const AptPolygon &apron = airport.polygons[0];
+		CHECK(apron.kind == AptPolygonKind::Pavement);
+		CHECK(apron.name == "Apron A");
+		CHECK(apron.textureHeading == Catch::Approx(45.0));
+		REQUIRE(apron.contours.size() == 2);
+		REQUIRE(apron.contours[0].nodes.size() == 3);
+		CHECK(apron.contours[0].closed);
+		CHECK(apron.contours[0].nodes[0].lineAttributes == std::vector<int>{ 1, 102 });
+		CHECK(apron.contours[0].nodes[1].bezier);
+		CHECK(apron.contours[0].nodes[1].controlLongitude == Catch::Approx(-121.9985));
+		REQUIRE(apron.contours[1].nodes.size() == 2);
+		CHECK(apron.contours[1].nodes[1].bezier);
+		CHECK(airport.polygons[1].kind == AptPolygonKind::LinearFeature);
+		REQUIRE(airport.polygons[1].contours.size() == 1);
+		CHECK_FALSE(airport.polygons[1].contours[0].closed);
+		CHECK(airport.polygons[2].kind == AptPolygonKind::Boundary);
+
+		REQUIRE(airport.markers.size() == 3);
+		CHECK(airport.markers[0].name == "Tower Viewpoint");
+		CHECK(airport.markers[0].value == Catch::Approx(100.0));
+		REQUIRE(airport.signs.size() == 1);
+		CHECK(airport.signs[0].size == 2);
+		CHECK(airport.signs[0].text == "{@Y}A{@R}09-27");
+		REQUIRE(airport.lights.size() == 1);
+		CHECK(airport.lights[0].runway == "09");
+		CHECK(airport.lights[0].description == "PAPI-4L");
+
+		REQUIRE(airport.startups.size() == 2);
+		CHECK(airport.startups[0].name == "Gate A1");
+		CHECK(airport.startups[0].widthCode == 'C');
+		CHECK(airport.startups[0].airlines == "aal dal");
+		CHECK(airport.startups[1].name == "Ramp 1");
+
+		REQUIRE(airport.frequencies.size() == 2);
+		CHECK(airport.frequencies[0].kilohertz == 123450);
+		CHECK(airport.frequencies[1].code == 51);
+		CHECK(airport.frequencies[1].kilohertz == 118275);
+		CHECK(airport.frequencies[1].name == "TST TWR");
+
+		REQUIRE(airport.flows.size() == 1);
+		const AptFlow &flow = airport.flows[0];
+		CHECK(flow.name == "West flow");
+		REQUIRE(flow.windRules.size() == 1);
+		CHECK(flow.windRules[0].maxSpeed == Catch::Approx(15.0));
+		CHECK(flow.ceilingRules.size() == 1);
+		CHECK(flow.visibilityRules[0].statuteMiles == Catch::Approx(1.5));
+		CHECK(flow.timeRules[0].to == 2400);
+		CHECK(flow.patterns[0].second == "right");
+		REQUIRE(flow.runwayRules.size() == 1);
+		CHECK(flow.runwayRules[0].initialHeadingTo == Catch::Approx(300.0));
+		CHECK(flow.runwayRules[0].name == "West arrivals");
+
+		REQUIRE(airport.taxiNodes.size() == 2);
+		CHECK(airport.taxiNodes[0].name == "A_start");
+		REQUIRE(airport.taxiEdges.size() == 2);
+		CHECK(airport.taxiEdges[0].type == "taxiway_E");
+		CHECK(airport.taxiEdges[0].activeZones.size() == 2);
+		CHECK(airport.taxiEdges[1].groundTruck);
+		CHECK(airport.taxiEdges[1].oneWay);
+		CHECK(airport.taxiEdges[1].name == "service road");
+
+		/// Rows the model does not cover survive verbatim.
+		REQUIRE(airport.otherRows.size() == 1);
+		CHECK(airport.otherRows[0].code == 1400);
+		CHECK(airport.otherRows[0].fields == "47.0 -122.0 90.0 fuel_liners 2 Truck");
+
+		/// The next airport starts clean.
+		REQUIRE(file.ReadAirport("SEA1", airport));
+		CHECK(airport.runways.empty());
+		CHECK(airport.waterRunways.size() == 1);
+	}
+
+	TEST_CASE("apt.dat parallel index matches serial", "[xplane][apt]")
+	{
+		/// Large enough for several 1 MiB chunks, so chunk edges fall inside airports.
+		const std::string text = MakeSyntheticAptDat(2000);
+		ThreadPool pool(4);
+		AptIndexOptions serialOptions;
+		serialOptions.parallel = false;
+		AptIndexOptions parallelOptions;
+		parallelOptions.threadPool = &pool;
+
+		AptDatFile serial;
+		REQUIRE(serial.Load(text.data(), text.size(), serialOptions));
+		AptDatFile parallel;
+		REQUIRE(parallel.Load(text.data(), text.size(), parallelOptions));
+		CHECK(parallel.GetStats().chunkCount > 1);
+
+		REQUIRE(serial.GetAirports().size() == 2000);
+		REQUIRE(parallel.GetAirports().size() == 2000);
+		for (size_t i = 0; i < 2000; ++i)
+		{
+			const AptIndexEntry &a = serial.GetAirports()[i];
+			const AptIndexEntry &b = parallel.GetAirports()[i];
+			REQUIRE(a.ident == b.ident);
+			REQUIRE(a.offset == b.offset);
+			REQUIRE(a.length == b.length);
+		}
+
+		std::vector<AptAirport> airports;
+		REQUIRE(parallel.ParseAll(airports, parallelOptions));
+		REQUIRE(airports.size() == 2000);
+		CHECK(airports[1999].ident == "X1999");
+		CHECK(airports[1999].polygons.size() == 4);
+		CHECK(airports[1999].signs.size() == 6);
+	}
+
+	TEST_CASE("apt.dat index cache", "[xplane][apt]")
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "sedx_apt_test.dat";
+		const std::filesystem::path cache = path.string() + ".sedxidx";
+		std::filesystem::remove(cache);
+		{
+			std::ofstream stream(path, std::ios::binary);
+			stream << APT_SAMPLE;
+		}
+
+		AptDatFile file;
+		REQUIRE(file.Open(path));
+		CHECK_FALSE(file.GetStats().fromCache);
+		REQUIRE(std::filesystem::exists(cache));
+		file.Close();
+
+		REQUIRE(file.Open(path));
+		CHECK(file.GetStats().fromCache);
+		CHECK(file.GetVersion() == 1100);
+		REQUIRE(file.GetAirports().size() == 3);
+		CHECK(file.GetAirports()[1].name == "Sea Base");
+		AptAirport airport;
+		REQUIRE(file.ReadAirport("KTST", airport));
+		CHECK(airport.runways.size() == 1);
+		file.Close();
+
+		/// A corrupt airport count is a cache miss, not an allocation of billions of entries.
+		{
+			std::fstream stream(cache, std::ios::binary | std::ios::in | std::ios::out);
+			const uint32_t count = 0xFFFFFFFFu;
+			stream.seekp(32);
+			stream.write(reinterpret_cast<const char *>(&count), sizeof(count));
+		}
+		REQUIRE(file.Open(path));
+		CHECK_FALSE(file.GetStats().fromCache);
+		CHECK(file.GetAirports().size() == 3);
+		file.Close();
+
+		/// A changed file invalidates the cache. Rows after the 99 row are ignored.
+		{
+			std::string text = APT_SAMPLE;
+			text.insert(text.rfind("99\r\n"), "1 10 0 0 LAST Inserted\r\n");
+			text += "1 10 0 0 GONE After the end\r\n";
+			std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+			stream << text;
+		}
+		REQUIRE(file.Open(path));
+		CHECK_FALSE(file.GetStats().fromCache);
+		CHECK(file.GetAirports().size() == 4);
+		CHECK(file.Find("LAST") != nullptr);
+		CHECK(file.Find("GONE") == nullptr);
+		file.Close();
+
+		std::filesystem::remove(path);
+		std::filesystem::remove(cache);
+	}
+
+	TEST_CASE("apt.dat index and extraction latency", "[xplane][apt][performance]")
+	{
+		using Clock = std::chrono::high_resolution_clock;
+		const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+		/// About a third of the global apt.dat's airport count.
+		const std::string text = MakeSyntheticAptDat(12000);
+
+		AptIndexOptions serialOptions;
+		serialOptions.parallel = false;
+		AptDatFile serial;
+		REQUIRE(serial.Load(text.data(), text.size(), serialOptions));
+		AptDatFile file;
+		REQUIRE(file.Load(text.data(), text.size()));
+
+		const std::filesystem::path cache = std::filesystem::temp_directory_path() / "sedx_apt_bench.sedxidx";
+		REQUIRE(file.SaveIndex(cache));
+		AptDatFile cached;
+		REQUIRE(cached.Load(text.data(), text.size()));
+		REQUIRE(cached.LoadIndex(cache));
+		std::filesystem::remove(cache);
+
+		constexpr uint32_t lookups = 1000;
+		AptAirport airport;
+		size_t polygons = 0;
+		auto start = Clock::now();
+		for (uint32_t i = 0; i < lookups; ++i)
+		{
+			REQUIRE(file.ReadAirport("X" + std::to_string((i * 7919u) % 12000u), airport));
+			polygons += airport.polygons.size();
+		}
+		const double lookupMs = ms(start) / lookups;
+
+		std::vector<AptAirport> airports;
+		start = Clock::now();
+		REQUIRE(file.ParseAll(airports));
+		const double parseAllMs = ms(start);
+
+		INFO("File: " << text.size() / 1048576.0 << " MiB, airports: " << file.GetAirports().size());
+		INFO("Index serial: " << serial.GetStats().indexMs << " ms, parallel: " << file.GetStats().indexMs << " ms (" << file.GetStats().chunkCount << " chunks, " << ThreadPool::Get().GetWorkerCount() << " workers)");
+		INFO("Index from cache: " << cached.GetStats().indexMs << " ms");
+		INFO("Single airport: " << lookupMs * 1000.0 << " us, parse all: " << parseAllMs << " ms");
+		CHECK(polygons == lookups * 4);
+		CHECK(airports.size() == 12000);
+		CHECK(cached.GetAirports().size() == 12000);
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,738 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* DSFReaderTest.cpp
+* -------------------------------------------------------
+* Decoding tests and benchmarks for the DSF reader
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <SceneryEditorX/asset/xplane/dsf_reader.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+/// -------------------------------------------------------
+
+using namespace SceneryEditorX;
+
+namespace SceneryEditorX::Tests
+{
+	/// Minimal little endian byte writer for hand built DSF files.
+	struct Bytes
+	{
+		std::vector<uint8_t> data;
+
+		template<typename T>
+		Bytes &Put(const T value)
+		{
+			const size_t at = data.size();
+			data.resize(at + sizeof(T));
+			std::memcpy(data.data() + at, &value, sizeof(T));
+			return *this;
+		}
+
+		Bytes &PutString(const std::string &text)
+		{
+			data.insert(data.end(), text.begin(), text.end());
+			data.push_back(0);
+			return *this;
+		}
+
+		Bytes &Append(const Bytes &other)
+		{
+			data.insert(data.end(), other.data.begin(), other.data.end());
+			return *this;
+		}
+
+		Bytes &Atom(const uint32_t id, const Bytes &payload)
+		{
+			Put(id);
+			Put(static_cast<uint32_t>(payload.data.size() + DSF::ATOM_HEADER_SIZE));
+			return Append(payload);
+		}
+
+		Bytes &Command(const DSF::Command command)
+		{
+			return Put(static_cast<uint8_t>(command));
+		}
+	};
+
+	Bytes StringTable(const std::vector<std::string> &strings)
+	{
+		Bytes bytes;
+		for (const std::string &text : strings)
+			bytes.PutString(text);
+		return bytes;
+	}
+
+	/// Encodes one plane. Run length output mixes repeat runs and literal runs like the X-Plane tools.
+	template<typename T>
+	void EncodePlane(Bytes &out, std::vector<T> values, const DSF::PoolEncoding encoding)
+	{
+		out.Put(static_cast<uint8_t>(encoding));
+		if (encoding == DSF::PoolEncoding::Differenced || encoding == DSF::PoolEncoding::RunLengthDifferenced)
+		{
+			T previous = 0;
+			for (T &value : values)
+			{
+				const T current = value;
+				value = static_cast<T>(current - previous);
+				previous = current;
+			}
+		}
+
+		if (encoding == DSF::PoolEncoding::Raw || encoding == DSF::PoolEncoding::Differenced)
+		{
+			for (const T value : values)
+				out.Put(value);
+			return;
+		}
+
+		size_t i = 0;
+		while (i < values.size())
+		{
+			size_t repeat = 1;
+			while (i + repeat < values.size() && repeat < 127 && values[i + repeat] == values[i])
+				++repeat;
+			if (repeat >= 3)
+			{
+				out.Put(static_cast<uint8_t>(0x80 | repeat));
+				out.Put(values[i]);
+				i += repeat;
+				continue;
+			}
+
+			size_t literal = 0;
+			while (i + literal < values.size() && literal < 127)
+			{
+				if (i + literal + 2 < values.size() && values[i + literal] == values[i + literal + 1] && values[i + literal] == values[i + literal + 2])
+					break;
+				++literal;
+			}
+			out.Put(static_cast<uint8_t>(literal));
+			for (size_t r = 0; r < literal; ++r)
+				out.Put(values[i + r]);
+			i += literal;
+		}
+	}
+
+	/// A pool given plane by plane, with one encoding and one scale/offset per plane.
+	template<typename T>
+	struct TestPool
+	{
+		std::vector<std::vector<T>> planes;
+		std::vector<DSF::PoolEncoding> encodings;
+		std::vector<std::pair<float, float>> scales;
+
+		[[nodiscard]] Bytes EncodePool() const
+		{
+			Bytes bytes;
+			bytes.Put(static_cast<uint32_t>(planes.empty() ? 0 : planes[0].size()));
+			bytes.Put(static_cast<uint8_t>(planes.size()));
+			for (size_t plane = 0; plane < planes.size(); ++plane)
+				EncodePlane(bytes, planes[plane], encodings[plane]);
+			return bytes;
+		}
+
+		[[nodiscard]] Bytes EncodeScale() const
+		{
+			Bytes bytes;
+			for (const auto &[scale, offset] : scales)
+				bytes.Put(scale).Put(offset);
+			return bytes;
+		}
+	};
+
+	/// Lon/lat pool over a 1x1 degree tile at (west, south) with identity scale on any extra planes.
+	TestPool<uint16_t> MakeTilePool(const std::vector<std::vector<uint16_t>> &planes, const DSF::PoolEncoding encoding = DSF::PoolEncoding::Raw)
+	{
+		TestPool<uint16_t> pool;
+		pool.planes = planes;
+		pool.encodings.assign(planes.size(), encoding);
+		pool.scales.assign(planes.size(), { 0.0f, 0.0f });
+		pool.scales[0] = { 1.0f, 8.0f };
+		pool.scales[1] = { 1.0f, 47.0f };
+		return pool;
+	}
+
+	struct TestDSF
+	{
+		std::vector<std::pair<std::string, std::string>> properties = {
+			{ "sim/west", "8" }, { "sim/south", "47" }, { "sim/east", "9" }, { "sim/north", "48" }, { "sim/planet", "earth" }
+		};
+		std::vector<std::string> terrains = { "terrain_Water", "lib/g10/terrain10/apt_tmp.ter" };
+		std::vector<std::string> objects = { "lib/airport/beacons/beacon.obj" };
+		std::vector<std::string> polygons = { "lib/g10/forests/mixed.for" };
+		std::vector<std::string> networks = { "lib/g10/roads.net" };
+		std::vector<TestPool<uint16_t>> pools;
+		std::vector<TestPool<uint32_t>> pools32;
+		Bytes commands;
+
+		[[nodiscard]] std::vector<uint8_t> Build() const
+		{
+			Bytes file;
+			file.data.assign(DSF::COOKIE, DSF::COOKIE + sizeof(DSF::COOKIE));
+			file.Put(DSF::VERSION);
+
+			Bytes props;
+			for (const auto &[name, value] : properties)
+				props.PutString(name).PutString(value);
+			file.Atom(DSF::Atom::Head, Bytes().Atom(DSF::Atom::Properties, props));
+
+			Bytes definitions;
+			definitions.Atom(DSF::Atom::TerrainTypes, StringTable(terrains));
+			definitions.Atom(DSF::Atom::Objects, StringTable(objects));
+			definitions.Atom(DSF::Atom::Polygons, StringTable(polygons));
+			definitions.Atom(DSF::Atom::Networks, StringTable(networks));
+			definitions.Atom(DSF::Atom::RasterNames, Bytes());
+			file.Atom(DSF::Atom::Definitions, definitions);
+
+			Bytes geodata;
+			for (const auto &pool : pools)
+				geodata.Atom(DSF::Atom::Pool, pool.EncodePool());
+			for (const auto &pool : pools)
+				geodata.Atom(DSF::Atom::Scale, pool.EncodeScale());
+			for (const auto &pool : pools32)
+				geodata.Atom(DSF::Atom::Pool32, pool.EncodePool()).Atom(DSF::Atom::Scale32, pool.EncodeScale());
+			file.Atom(DSF::Atom::Geodata, geodata);
+
+			file.Atom(DSF::Atom::Rasters, Bytes().Put(uint32_t(0xDEADBEEF)));
+			file.Atom(DSF::Atom::Commands, commands);
+
+			/// The reader does not verify the MD5 footer.
+			file.data.resize(file.data.size() + DSF::FOOTER_SIZE, 0);
+			return file.data;
+		}
+	};
+
+	/// Records every callback with its decoded coordinates.
+	struct Recorder : DSFCommandHandler
+	{
+		struct Event
+		{
+			std::string kind;
+			uint32_t definition = 0;
+			uint32_t extra = 0;
+			std::vector<double> coords;
+			std::vector<uint32_t> windingEnds;
+		};
+
+		std::vector<Event> events;
+
+		void OnObject(const DSFObject &object) override
+		{
+			events.push_back({ "object", object.definition, object.planeCount, { object.point, object.point + object.planeCount }, {} });
+		}
+
+		void OnPolygon(const DSFPolygon &polygon) override
+		{
+			events.push_back({ "polygon", polygon.definition, polygon.parameter, { polygon.coords.begin(), polygon.coords.end() },
+			                   { polygon.windingEnds.begin(), polygon.windingEnds.end() } });
+		}
+
+		void OnNetworkChain(const DSFNetworkChain &chain) override
+		{
+			events.push_back({ "chain", chain.definition, chain.subtype, { chain.coords.begin(), chain.coords.end() }, {} });
+		}
+
+		void OnBeginPatch(const DSFPatch &patch) override
+		{
+			events.push_back({ "patch", patch.definition, patch.flags, { patch.nearLOD, patch.farLOD }, {} });
+		}
+
+		void OnPatchPrimitive(const DSFPrimitive &primitive) override
+		{
+			events.push_back({ "primitive", static_cast<uint32_t>(primitive.type), primitive.vertexCount, { primitive.coords.begin(), primitive.coords.end() }, {} });
+		}
+
+		void OnEndPatch() override { events.push_back({ "end", 0, 0, {}, {} }); }
+
+		void OnComment(const std::string_view text) override { events.push_back({ "comment:" + std::string(text), 0, 0, {}, {} }); }
+	};
+
+	double Lon(const uint16_t raw) { return 8.0 + raw / 65535.0; }
+	double Lat(const uint16_t raw) { return 47.0 + raw / 65535.0; }
+
+	/// -------------------------------------------------------
+
+	TEST_CASE("DSF reader reads header tables and bounds", "[xplane][dsf]")
+	{
+		TestDSF dsf;
+		dsf.pools.push_back(MakeTilePool({ { 0, 65535 }, { 0, 65535 } }));
+		const std::vector<uint8_t> bytes = dsf.Build();
+
+		DSFReader reader;
+		REQUIRE(reader.Load(bytes.data(), bytes.size()));
+		REQUIRE(reader.IsOpen());
+		REQUIRE(reader.GetProperties().size() == 5);
+		REQUIRE(reader.FindProperty("sim/planet"));
+		REQUIRE(*reader.FindProperty("sim/planet") == "earth");
+		REQUIRE_FALSE(reader.FindProperty("sim/missing"));
+
+		double west, south, east, north;
+		REQUIRE(reader.GetBounds(west, south, east, north));
+		REQUIRE(west == 8.0);
+		REQUIRE(south == 47.0);
+		REQUIRE(east == 9.0);
+		REQUIRE(north == 48.0);
+
+		REQUIRE(reader.GetTerrainDefinitions() == dsf.terrains);
+		REQUIRE(reader.GetObjectDefinitions() == dsf.objects);
+		REQUIRE(reader.GetPolygonDefinitions() == dsf.polygons);
+		REQUIRE(reader.GetNetworkDefinitions() == dsf.networks);
+		REQUIRE(reader.GetRasterDefinitions().empty());
+
+		REQUIRE(reader.GetStats().fileBytes == bytes.size());
+		REQUIRE(reader.GetStats().poolCount == 1);
+		REQUIRE(reader.GetStats().pointCount == 2);
+		REQUIRE(reader.GetStats().memoryBytes > 0);
+	}
+
+	TEST_CASE("DSF reader decodes every pool encoding", "[xplane][dsf]")
+	{
+		/// Runs longer than 127, repeats and noise exercise both run kinds and wraparound in the differences.
+		std::vector<uint16_t> plane;
+		for (uint32_t i = 0; i < 1000; ++i)
+			plane.push_back(i < 300 ? 42 : static_cast<uint16_t>((i * 7919u) ^ (i >> 3)));
+		std::vector<uint32_t> plane32;
+		for (uint32_t i = 0; i < 1000; ++i)
+			plane32.push_back(i % 10 < 5 ? 0xFFFFFF00u : i * 2654435761u);
+
+		for (const DSF::PoolEncoding encoding : { DSF::PoolEncoding::Raw, DSF::PoolEncoding::Differenced, DSF::PoolEncoding::RunLength, DSF::PoolEncoding::RunLengthDifferenced })
+		{
+			INFO("encoding " << static_cast<int>(encoding));
+			TestDSF dsf;
+			dsf.pools.push_back(MakeTilePool({ plane, plane, plane }, encoding));
+			TestPool<uint32_t> pool32;
+			pool32.planes = { plane32, plane32 };
+			pool32.encodings = { encoding, encoding };
+			pool32.scales = { { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+			dsf.pools32.push_back(pool32);
+			const std::vector<uint8_t> bytes = dsf.Build();
+
+			DSFReader reader;
+			REQUIRE(reader.Load(bytes.data(), bytes.size()));
+			REQUIRE(reader.GetPools().size() == 1);
+			REQUIRE(reader.GetPools32().size() == 1);
+
+			const DSFPool16 &pool = reader.GetPools()[0];
+			REQUIRE(pool.GetPointCount() == 1000);
+			REQUIRE(pool.GetPlaneCount() == 3);
+			const DSFPool32 &decoded32 = reader.GetPools32()[0];
+			for (uint32_t i = 0; i < 1000; ++i)
+			{
+				REQUIRE(pool.GetRawValues()[i * 3 + 2] == plane[i]);
+				REQUIRE(decoded32.GetRawValues()[i * 2 + 1] == plane32[i]);
+			}
+		}
+	}
+
+	TEST_CASE("DSF reader applies plane scale and offset", "[xplane][dsf]")
+	{
+		TestDSF dsf;
+		TestPool<uint16_t> pool = MakeTilePool({ { 0, 32768, 65535 }, { 65535, 0, 100 }, { 0, 65535, 1000 } });
+		pool.scales[2] = { 1000.0f, -500.0f };
+		dsf.pools.push_back(pool);
+		const std::vector<uint8_t> bytes = dsf.Build();
+
+		DSFReader reader;
+		REQUIRE(reader.Load(bytes.data(), bytes.size()));
+		const DSFPool16 &decoded = reader.GetPools()[0];
+
+		double point[3];
+		decoded.GetPoint(1, point);
+		REQUIRE(point[0] == Catch::Approx(Lon(32768)));
+		REQUIRE(point[1] == Catch::Approx(47.0));
+		REQUIRE(point[2] == Catch::Approx(500.0));
+		decoded.GetPoint(2, point);
+		REQUIRE(point[0] == Catch::Approx(9.0));
+		REQUIRE(point[2] == Catch::Approx(-500.0 + 1000.0 * 1000.0 / 65535.0));
+		REQUIRE(decoded.GetValue(0, 1) == Catch::Approx(48.0));
+
+		/// A zero scale means the raw value is used as is.
+		REQUIRE(decoded.GetScale(0) == Catch::Approx(1.0));
+	}
+
+	TEST_CASE("DSF reader streams every command type", "[xplane][dsf]")
+	{
+		TestDSF dsf;
+		/// Pool 0: lon, lat, heading. Pool 1: lon, lat, elevation, u, v for terrain.
+		dsf.pools.push_back(MakeTilePool({ { 0, 100, 200, 300, 400 }, { 0, 10, 20, 30, 40 }, { 0, 90, 180, 270, 45 } }));
+		dsf.pools.push_back(MakeTilePool({ { 1000, 2000, 3000, 4000 }, { 500, 600, 700, 800 }, { 10, 20, 30, 40 }, { 0, 1, 1, 0 }, { 0, 0, 1, 1 } }));
+		TestPool<uint32_t> junctions;
+		junctions.planes = { { 10, 11, 12, 13, 14, 15 }, { 20, 21, 22, 23, 24, 25 } };
+		junctions.encodings = { DSF::PoolEncoding::Raw, DSF::PoolEncoding::Raw };
+		junctions.scales = { { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+		dsf.pools32.push_back(junctions);
+
+		Bytes &c = dsf.commands;
+		c.Command(DSF::Command::Comment8).Put(uint8_t(5)).data.insert(c.data.end(), { 'h', 'e', 'l', 'l', 'o' });
+		c.Command(DSF::Command::PoolSelect).Put(uint16_t(0));
+		c.Command(DSF::Command::SetDefinition8).Put(uint8_t(0));
+		c.Command(DSF::Command::Object).Put(uint16_t(2));
+		c.Command(DSF::Command::ObjectRange).Put(uint16_t(3)).Put(uint16_t(5));
+		c.Command(DSF::Command::SetDefinition16).Put(uint16_t(0));
+		c.Command(DSF::Command::Polygon).Put(uint16_t(255)).Put(uint8_t(3)).Put(uint16_t(0)).Put(uint16_t(1)).Put(uint16_t(2));
+		c.Command(DSF::Command::PolygonRange).Put(uint16_t(7)).Put(uint16_t(1)).Put(uint16_t(4));
+		c.Command(DSF::Command::NestedPolygon).Put(uint16_t(9)).Put(uint8_t(2)).Put(uint8_t(3)).Put(uint16_t(0)).Put(uint16_t(1)).Put(uint16_t(2)).Put(uint8_t(1)).Put(uint16_t(4));
+		c.Command(DSF::Command::NestedPolygonRange).Put(uint16_t(11)).Put(uint8_t(2)).Put(uint16_t(0)).Put(uint16_t(3)).Put(uint16_t(5));
+
+		c.Command(DSF::Command::SetDefinition32).Put(uint32_t(0));
+		c.Command(DSF::Command::SetRoadSubtype8).Put(uint8_t(4));
+		c.Command(DSF::Command::JunctionOffsetSelect).Put(uint32_t(2));
+		c.Command(DSF::Command::NetworkChain).Put(uint8_t(2)).Put(uint16_t(0)).Put(uint16_t(3));
+		c.Command(DSF::Command::NetworkChainRange).Put(uint16_t(1)).Put(uint16_t(3));
+		c.Command(DSF::Command::NetworkChain32).Put(uint8_t(2)).Put(uint32_t(0)).Put(uint32_t(1));
+
+		c.Command(DSF::Command::PoolSelect).Put(uint16_t(1));
+		c.Command(DSF::Command::SetDefinition8).Put(uint8_t(1));
+		c.Command(DSF::Command::TerrainPatchFlagsLOD).Put(uint8_t(DSF::PATCH_PHYSICAL)).Put(0.0f).Put(40000.0f);
+		c.Command(DSF::Command::PatchTriangle).Put(uint8_t(3)).Put(uint16_t(0)).Put(uint16_t(1)).Put(uint16_t(2));
+		c.Command(DSF::Command::PatchTriangleStripRange).Put(uint16_t(0)).Put(uint16_t(4));
+		c.Command(DSF::Command::PatchTriangleFanCrossPool).Put(uint8_t(3)).Put(uint16_t(1)).Put(uint16_t(3)).Put(uint16_t(0)).Put(uint16_t(4)).Put(uint16_t(1)).Put(uint16_t(0));
+		c.Command(DSF::Command::SetDefinition8).Put(uint8_t(0));
+		c.Command(DSF::Command::TerrainPatchFlags).Put(uint8_t(DSF::PATCH_OVERLAY));
+		c.Command(DSF::Command::PatchTriangleFan).Put(uint8_t(3)).Put(uint16_t(3)).Put(uint16_t(2)).Put(uint16_t(1));
+		c.Command(DSF::Command::TerrainPatch);
+		c.Command(DSF::Command::PatchTriangleRange).Put(uint16_t(1)).Put(uint16_t(4));
+		c.Command(DSF::Command::PatchTriangleStrip).Put(uint8_t(3)).Put(uint16_t(0)).Put(uint16_t(1)).Put(uint16_t(2));
+		c.Command(DSF::Command::PatchTriangleCrossPool).Put(uint8_t(3)).Put(uint16_t(1)).Put(uint16_t(0)).Put(uint16_t(1)).Put(uint16_t(1)).Put(uint16_t(1)).Put(uint16_t(2));
+		c.Command(DSF::Command::PatchTriangleStripCrossPool).Put(uint8_t(3)).Put(uint16_t(1)).Put(uint16_t(0)).Put(uint16_t(1)).Put(uint16_t(1)).Put(uint16_t(1)).Put(uint16_t(2));
+		c.Command(DSF::Command::PatchTriangleFanRange).Put(uint16_t(0)).Put(uint16_t(3));
+		c.Command(DSF::Command::Comment16).Put(uint16_t(2)).data.insert(c.data.end(), { 'o', 'k' });
+		c.Command(DSF::Command::Comment32).Put(uint32_t(0));
+
+		const std::vector<uint8_t> bytes = dsf.Build();
+		DSFReader reader;
+		REQUIRE(reader.Load(bytes.data(), bytes.size()));
+
+		Recorder recorder;
+		DSFCommandStats stats;
+		REQUIRE(reader.ReadCommands(recorder, &stats));
+		const auto &e = recorder.events;
+
+		size_t i = 0;
+		REQUIRE(e[i++].kind == "comment:hello");
+
+		/// Objects 2, 3 and 4.
+		for (const uint16_t index : { 2, 3, 4 })
+		{
+			REQUIRE(e[i].kind == "object");
+			REQUIRE(e[i].coords.size() == 3);
+			REQUIRE(e[i].coords[0] == Catch::Approx(Lon(static_cast<uint16_t>(index * 100))));
+			REQUIRE(e[i].coords[1] == Catch::Approx(Lat(static_cast<uint16_t>(index * 10))));
+			++i;
+		}
+		REQUIRE(e[2].coords[2] == Catch::Approx(270.0));
+
+		REQUIRE(e[i].kind == "polygon");
+		REQUIRE(e[i].extra == 255);
+		REQUIRE(e[i].coords.size() == 9);
+		REQUIRE(e[i].windingEnds == std::vector<uint32_t>{ 3 });
+		++i;
+		REQUIRE(e[i].extra == 7);
+		REQUIRE(e[i].coords[0] == Catch::Approx(Lon(100)));
+		REQUIRE(e[i].windingEnds == std::vector<uint32_t>{ 3 });
+		++i;
+		REQUIRE(e[i].extra == 9);
+		REQUIRE(e[i].windingEnds == std::vector<uint32_t>{ 3, 4 });
+		REQUIRE(e[i].coords[9] == Catch::Approx(Lon(400)));
+		++i;
+		REQUIRE(e[i].extra == 11);
+		REQUIRE(e[i].windingEnds == std::vector<uint32_t>{ 3, 5 });
+		++i;
+
+		/// Junction offset 2 shifts 16-bit chain indices but not 32-bit ones.
+		REQUIRE(e[i].kind == "chain");
+		REQUIRE(e[i].extra == 4);
+		REQUIRE(e[i].coords == std::vector<double>{ 12, 22, 15, 25 });
+		++i;
+		REQUIRE(e[i].coords == std::vector<double>{ 13, 23, 14, 24 });
+		++i;
+		REQUIRE(e[i].coords == std::vector<double>{ 10, 20, 11, 21 });
+		++i;
+
+		REQUIRE(e[i].kind == "patch");
+		REQUIRE(e[i].definition == 1);
+		REQUIRE(e[i].extra == DSF::PATCH_PHYSICAL);
+		REQUIRE(e[i].coords == std::vector<double>{ 0.0, 40000.0 });
+		++i;
+		REQUIRE(e[i].kind == "primitive");
+		REQUIRE(e[i].definition == static_cast<uint32_t>(DSF::PrimitiveType::Triangles));
+		REQUIRE(e[i].extra == 3);
+		REQUIRE(e[i].coords.size() == 15);
+		REQUIRE(e[i].coords[2] == 10.0);
+		++i;
+		REQUIRE(e[i].definition == static_cast<uint32_t>(DSF::PrimitiveType::TriangleStrip));
+		REQUIRE(e[i].extra == 4);
+		++i;
+		/// Cross pool vertex from pool 0 is padded to the current pool's 5 planes.
+		REQUIRE(e[i].definition == static_cast<uint32_t>(DSF::PrimitiveType::TriangleFan));
+		REQUIRE(e[i].coords.size() == 15);
+		REQUIRE(e[i].coords[5] == Catch::Approx(Lon(400)));
+		REQUIRE(e[i].coords[7] == Catch::Approx(45.0));
+		REQUIRE(e[i].coords[9] == 0.0);
+		REQUIRE(e[i].coords[10] == Catch::Approx(Lon(1000)));
+		++i;
+		REQUIRE(e[i++].kind == "end");
+
+		/// Flags set here carry into the following bare TerrainPatch, LOD carries from the first.
+		REQUIRE(e[i].kind == "patch");
+		REQUIRE(e[i].definition == 0);
+		REQUIRE(e[i].extra == DSF::PATCH_OVERLAY);
+		REQUIRE(e[i].coords == std::vector<double>{ 0.0, 40000.0 });
+		++i;
+		REQUIRE(e[i++].kind == "primitive");
+		REQUIRE(e[i++].kind == "end");
+		REQUIRE(e[i].kind == "patch");
+		REQUIRE(e[i].extra == DSF::PATCH_OVERLAY);
+		++i;
+		for (int p = 0; p < 5; ++p)
+			REQUIRE(e[i++].kind == "primitive");
+		REQUIRE(e[i++].kind == "comment:ok");
+		REQUIRE(e[i++].kind == "comment:");
+		REQUIRE(e[i++].kind == "end");
+		REQUIRE(i == e.size());
+
+		REQUIRE(stats.objects == 3);
+		REQUIRE(stats.polygons == 4);
+		REQUIRE(stats.networkChains == 3);
+		REQUIRE(stats.patches == 3);
+		REQUIRE(stats.primitives == 9);
+		REQUIRE(stats.vertices == 3 + 4 + 3 + 3 + 3 + 3 + 3 + 3 + 3);
+
+		/// Commands can be replayed.
+		Recorder second;
+		REQUIRE(reader.ReadCommands(second));
+		REQUIRE(second.events.size() == e.size());
+	}
+
+	TEST_CASE("DSF reader rejects malformed input", "[xplane][dsf]")
+	{
+		TestDSF dsf;
+		dsf.pools.push_back(MakeTilePool({ { 0, 1, 2 }, { 0, 1, 2 } }, DSF::PoolEncoding::RunLengthDifferenced));
+		dsf.commands.Command(DSF::Command::ObjectRange).Put(uint16_t(0)).Put(uint16_t(3));
+		const std::vector<uint8_t> good = dsf.Build();
+		DSFReader reader;
+
+		SECTION("Bad cookie")
+		{
+			std::vector<uint8_t> bytes = good;
+			bytes[0] = 'Y';
+			REQUIRE_FALSE(reader.Load(bytes.data(), bytes.size()));
+			REQUIRE_FALSE(reader.IsOpen());
+			REQUIRE(reader.GetError() == "not a DSF file");
+		}
+
+		SECTION("Unsupported version")
+		{
+			std::vector<uint8_t> bytes = good;
+			bytes[8] = 2;
+			REQUIRE_FALSE(reader.Load(bytes.data(), bytes.size()));
+			REQUIRE(reader.GetError().find("version") != std::string::npos);
+		}
+
+		SECTION("7z archive")
+		{
+			std::vector<uint8_t> bytes(DSF::SEVEN_ZIP_SIGNATURE, DSF::SEVEN_ZIP_SIGNATURE + sizeof(DSF::SEVEN_ZIP_SIGNATURE));
+			bytes.resize(64, 0);
+			REQUIRE_FALSE(reader.Load(bytes.data(), bytes.size()));
+			REQUIRE(reader.GetError().find("7z") != std::string::npos);
+		}
+
+		SECTION("Every truncation fails cleanly")
+		{
+			for (size_t size = 0; size < good.size() - DSF::FOOTER_SIZE; ++size)
+			{
+				/// Cutting the file moves the footer into the atoms, so keep a zero footer after the cut.
+				std::vector<uint8_t> bytes(good.begin(), good.begin() + static_cast<std::ptrdiff_t>(size));
+				bytes.resize(size + DSF::FOOTER_SIZE, 0);
+				DSFReader cut;
+				if (cut.Load(bytes.data(), bytes.size()))
+				{
+					Recorder recorder;
+					cut.ReadCommands(recorder);
+				}
+			}
+			REQUIRE(reader.Load(good.data(), good.size()));
+		}
+
+		SECTION("Point index outside the pool")
+		{
+			TestDSF bad = dsf;
+			bad.commands.Command(DSF::Command::Object).Put(uint16_t(3));
+			const std::vector<uint8_t> bytes = bad.Build();
+			REQUIRE(reader.Load(bytes.data(), bytes.size()));
+			Recorder recorder;
+			REQUIRE_FALSE(reader.ReadCommands(recorder));
+			REQUIRE(reader.GetError().find("point index 3") != std::string::npos);
+			REQUIRE(recorder.events.size() == 3);
+		}
+
+		SECTION("Unknown command")
+		{
+			TestDSF bad = dsf;
+			bad.commands.Put(uint8_t(200));
+			const std::vector<uint8_t> bytes = bad.Build();
+			REQUIRE(reader.Load(bytes.data(), bytes.size()));
+			Recorder recorder;
+			REQUIRE_FALSE(reader.ReadCommands(recorder));
+			REQUIRE(reader.GetError() == "unknown command 200 at command offset 5");
+		}
+
+		SECTION("Missing scale atom")
+		{
+			TestDSF bad = dsf;
+			bad.pools32.push_back({ { { 1 } }, { DSF::PoolEncoding::Raw }, {} });
+			std::vector<uint8_t> bytes = bad.Build();
+			/// Rename the SC32 atom so it is skipped.
+			const uint32_t scale32 = DSF::Atom::Scale32;
+			const auto it = std::search(bytes.begin(), bytes.end(), reinterpret_cast<const uint8_t *>(&scale32), reinterpret_cast<const uint8_t *>(&scale32) + 4);
+			REQUIRE(it != bytes.end());
+			*it = 'X';
+			REQUIRE_FALSE(reader.Load(bytes.data(), bytes.size()));
+			REQUIRE(reader.GetError().find("scale atoms") != std::string::npos);
+		}
+
+		SECTION("Unknown pool encoding")
+		{
+			TestDSF bad;
+			bad.pools.push_back(MakeTilePool({ { 0 }, { 0 } }));
+			bad.pools[0].encodings[1] = static_cast<DSF::PoolEncoding>(9);
+			const std::vector<uint8_t> bytes = bad.Build();
+			REQUIRE_FALSE(reader.Load(bytes.data(), bytes.size()));
+			REQUIRE(reader.GetError() == "POOL 0: unknown pool encoding 9");
+		}
+	}
+
+	TEST_CASE("DSF reader opens mapped files", "[xplane][dsf]")
+	{
+		TestDSF dsf;
+		dsf.pools.push_back(MakeTilePool({ { 0, 65535 }, { 0, 65535 }, { 0, 180 } }));
+		dsf.commands.Command(DSF::Command::ObjectRange).Put(uint16_t(0)).Put(uint16_t(2));
+		const std::vector<uint8_t> bytes = dsf.Build();
+
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "sedx_dsf_reader_test.dsf";
+		{
+			std::ofstream out(path, std::ios::binary);
+			out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		}
+
+		DSFReader reader;
+		REQUIRE(reader.Open(path));
+		Recorder recorder;
+		REQUIRE(reader.ReadCommands(recorder));
+		REQUIRE(recorder.events.size() == 2);
+		REQUIRE(recorder.events[1].coords[2] == Catch::Approx(180.0));
+		reader.Close();
+		REQUIRE_FALSE(reader.IsOpen());
+
+		std::filesystem::remove(path);
+		REQUIRE_FALSE(reader.Open(path));
+		REQUIRE(reader.GetError().find("cannot map") != std::string::npos);
+	}
+
+	/// -------------------------------------------------------
+
+	/// Builds a tile shaped like a global scenery DSF: many full 16-bit terrain pools and a junction pool.
+	TestDSF MakeSyntheticTile(const uint32_t poolCount, const uint32_t pointsPerPool)
+	{
+		TestDSF dsf;
+		for (uint32_t p = 0; p < poolCount; ++p)
+		{
+			std::vector<std::vector<uint16_t>> planes(7, std::vector<uint16_t>(pointsPerPool));
+			for (uint32_t i = 0; i < pointsPerPool; ++i)
+			{
+				const uint32_t x = i % 256;
+				const uint32_t y = i / 256;
+				planes[0][i] = static_cast<uint16_t>(x * 257);
+				planes[1][i] = static_cast<uint16_t>(y * 257);
+				planes[2][i] = static_cast<uint16_t>(20000 + ((x * 31 + y * 17 + p * 7) % 97) * 13);
+				planes[3][i] = static_cast<uint16_t>(32768 + (x % 9) * 100);
+				planes[4][i] = static_cast<uint16_t>(32768 - (y % 7) * 100);
+				planes[5][i] = 0;
+				planes[6][i] = static_cast<uint16_t>(p);
+			}
+			TestPool<uint16_t> pool = MakeTilePool(planes, DSF::PoolEncoding::RunLengthDifferenced);
+			pool.scales[2] = { 9000.0f, -500.0f };
+			dsf.pools.push_back(std::move(pool));
+
+			Bytes &c = dsf.commands;
+			c.Command(DSF::Command::PoolSelect).Put(static_cast<uint16_t>(p));
+			c.Command(DSF::Command::TerrainPatchFlagsLOD).Put(uint8_t(DSF::PATCH_PHYSICAL)).Put(0.0f).Put(-1.0f);
+			for (uint32_t first = 0; first + 255 <= pointsPerPool; first += 255)
+				c.Command(DSF::Command::PatchTriangleRange).Put(static_cast<uint16_t>(first)).Put(static_cast<uint16_t>(first + 255));
+		}
+		return dsf;
+	}
+
+	TEST_CASE("DSF reader parallel and serial decode agree", "[xplane][dsf]")
+	{
+		const std::vector<uint8_t> bytes = MakeSyntheticTile(12, 4096).Build();
+		ThreadPool pool(4);
+
+		DSFReader serial;
+		DSFReader parallel;
+		REQUIRE(serial.Load(bytes.data(), bytes.size(), { false, nullptr }));
+		REQUIRE(parallel.Load(bytes.data(), bytes.size(), { true, &pool }));
+		REQUIRE(serial.GetPools().size() == 12);
+		for (size_t i = 0; i < serial.GetPools().size(); ++i)
+		{
+			REQUIRE(serial.GetPools()[i].GetRawValues() == parallel.GetPools()[i].GetRawValues());
+			REQUIRE(serial.GetPools()[i].GetValue(100, 2) == parallel.GetPools()[i].GetValue(100, 2));
+		}
+	}
+
+	TEST_CASE("DSF reader tile decode throughput", "[xplane][dsf][performance]")
+	{
+		using Clock = std::chrono::high_resolution_clock;
+		const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+		/// About the size of a dense global scenery tile once extracted.
+		const std::vector<uint8_t> bytes = MakeSyntheticTile(96, 65280).Build();
+
+		DSFReader serial;
+		auto start = Clock::now();
+		REQUIRE(serial.Load(bytes.data(), bytes.size(), { false, nullptr }));
+		const double serialMs = ms(start);
+
+		DSFReader reader;
+		start = Clock::now();
+		REQUIRE(reader.Load(bytes.data(), bytes.size()));
+		const double parallelMs = ms(start);
+
+		/// Counts triangles without touching the coordinates beyond what the reader decodes.
+		struct Counter : DSFCommandHandler
+		{
+			uint64_t vertices = 0;
+			void OnPatchPrimitive(const DSFPrimitive &primitive) override { vertices += primitive.vertexCount; }
+		} counter;
+		DSFCommandStats commandStats;
+		REQUIRE(reader.ReadCommands(counter, &commandStats));
+
+		const DSFReadStats &stats = reader.GetStats();
+		INFO("File: " << bytes.size() / 1048576.0 << " MiB, pools: " << stats.poolCount << ", points: " << stats.pointCount);
+		INFO("Load serial: " << serialMs << " ms, parallel: " << parallelMs << " ms (" << ThreadPool::Get().GetWorkerCount() << " workers)");
+		INFO("Atom walk: " << stats.atomMs << " ms, pool decode: " << stats.poolDecodeMs << " ms");
+		INFO("Decoded memory: " << stats.memoryBytes / 1048576.0 << " MiB (" << stats.memoryBytes / static_cast<double>(stats.pointCount) << " bytes/point)");
+		INFO("Commands: " << commandStats.ms << " ms for " << commandStats.vertices << " vertices");
+		CHECK(counter.vertices == commandStats.vertices);
+		CHECK(stats.pointCount == 96ull * 65280);
+		/// Quantized storage: 7 planes at 2 bytes each, plus per-plane scale tables.
+		CHECK(stats.memoryBytes < stats.pointCount * 16);
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,446 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* DSFWriterTest.cpp
+* -------------------------------------------------------
+* Round trips through the DSF writer and reader
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <SceneryEditorX/asset/xplane/dsf_reader.h>
+#include <SceneryEditorX/asset/xplane/dsf_writer.h>
+#include <SceneryEditorX/core/identifiers/md5.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+/// -------------------------------------------------------
+
+using namespace SceneryEditorX;
+
+namespace SceneryEditorX::Tests
+{
+	/// Collects what the reader hands back, resolved to definition names.
+	struct OverlayCollector : DSFCommandHandler
+	{
+		const DSFReader *reader = nullptr;
+		DSFOverlay overlay;
+
+		void OnObject(const DSFObject &object) override
+		{
+			DSFOverlayObject &out = overlay.objects.emplace_back();
+			out.definition = reader->GetObjectDefinitions()[object.definition];
+			out.longitude = object.point[0];
+			out.latitude = object.point[1];
+			out.heading = object.point[2];
+			if (object.planeCount > 3)
+				out.elevation = object.point[3];
+		}
+
+		void OnPolygon(const DSFPolygon &polygon) override
+		{
+			DSFOverlayPolygon &out = overlay.polygons.emplace_back();
+			out.definition = reader->GetPolygonDefinitions()[polygon.definition];
+			out.parameter = polygon.parameter;
+			out.planeCount = polygon.planeCount;
+			uint32_t begin = 0;
+			for (const uint32_t end : polygon.windingEnds)
+			{
+				out.windings.emplace_back(polygon.coords.begin() + begin * polygon.planeCount, polygon.coords.begin() + end * polygon.planeCount);
+				begin = end;
+			}
+		}
+	};
+
+	DSFOverlay ReadBack(const std::vector<uint8_t> &bytes, DSFReader &reader)
+	{
+		DSFReadOptions options;
+		options.verifyChecksum = true;
+		REQUIRE(reader.Load(bytes.data(), bytes.size(), options));
+		OverlayCollector collector;
+		collector.reader = &reader;
+		REQUIRE(reader.ReadCommands(collector));
+		return collector.overlay;
+	}
+
+	/// Size of the first top level atom with @p id, or 0.
+	size_t AtomSize(const std::vector<uint8_t> &bytes, const uint32_t id)
+	{
+		for (size_t offset = DSF::HEADER_SIZE; offset + DSF::ATOM_HEADER_SIZE <= bytes.size() - DSF::FOOTER_SIZE;)
+		{
+			uint32_t atom;
+			uint32_t length;
+			std::memcpy(&atom, bytes.data() + offset, 4);
+			std::memcpy(&length, bytes.data() + offset + 4, 4);
+			if (atom == id)
+				return length;
+			offset += length;
+		}
+		return 0;
+	}
+
+	std::string Hex(const MD5::Digest &digest)
+	{
+		static constexpr char digits[] = "0123456789abcdef";
+		std::string text;
+		for (const uint8_t byte : digest)
+		{
+			text += digits[byte >> 4];
+			text += digits[byte & 15];
+		}
+		return text;
+	}
+
+	DSFOverlay MakeAirportOverlay()
+	{
+		DSFOverlay overlay;
+		overlay.west = -73;
+		overlay.south = 41;
+		overlay.properties = { { "sim/exclude_obj", "-72.9/41.2/-72.8/41.3" } };
+
+		for (int i = 0; i < 40; ++i)
+		{
+			DSFOverlayObject &object = overlay.objects.emplace_back();
+			object.definition = i % 3 ? "lib/airport/lights/taxi_edge.obj" : "objects/hangar.obj";
+			object.longitude = -72.9 + i * 0.0011;
+			object.latitude = 41.26 + (i % 7) * 0.0007;
+			object.heading = (i * 37) % 360;
+		}
+		DSFOverlayObject &tower = overlay.objects.emplace_back();
+		tower.definition = "objects/tower.obj";
+		tower.longitude = -72.887;
+		tower.latitude = 41.264;
+		tower.heading = 12.5;
+		tower.elevation = 4.2;
+
+		DSFOverlayPolygon &apron = overlay.polygons.emplace_back();
+		apron.definition = "lib/g10/forests/mixed.for";
+		apron.parameter = 180;
+		apron.windings = {
+			{ -72.89, 41.26, -72.88, 41.26, -72.88, 41.27, -72.89, 41.27 },
+			{ -72.886, 41.264, -72.884, 41.264, -72.885, 41.266 }
+		};
+
+		DSFOverlayPolygon &facade = overlay.polygons.emplace_back();
+		facade.definition = "objects/terminal.fac";
+		facade.parameter = 12;
+		facade.planeCount = 3;
+		facade.windings = { { -72.881, 41.262, 0.0, -72.880, 41.262, 1.0, -72.880, 41.263, 2.0 } };
+
+		DSFOverlayLine &line = overlay.lines.emplace_back();
+		line.definition = "lib/airport/lines/solid_yellow.lin";
+		line.closed = true;
+		line.coords = { -72.885, 41.261, -72.884, 41.261, -72.884, 41.262 };
+
+		DSFOverlayLine &open = overlay.lines.emplace_back();
+		open.definition = "lib/airport/lines/solid_yellow.lin";
+		open.coords = { -72.883, 41.261, -72.882, 41.263 };
+		return overlay;
+	}
+
+	/// -------------------------------------------------------
+
+	TEST_CASE("MD5 matches the RFC 1321 test suite", "[xplane][dsf][md5]")
+	{
+		const auto md5 = [](const std::string &text) { return Hex(MD5::Compute(text.data(), text.size())); };
+		REQUIRE(md5("") == "d41d8cd98f00b204e9800998ecf8427e");
+		REQUIRE(md5("a") == "0cc175b9c0f1b6a831c399e269772661");
+		REQUIRE(md5("abc") == "900150983cd24fb0d6963f7d28e17f72");
+		REQUIRE(md5("message digest") == "f96b697d7cb7938d525a2f31aaf161d0");
+		REQUIRE(md5("abcdefghijklmnopqrstuvwxyz") == "c3fcd3d76192e4007dfb496cca67e13b");
+		REQUIRE(md5("12345678901234567890123456789012345678901234567890123456789012345678901234567890") == "57edf4a22be3c955ac49da2e2107b67a");
+
+		/// Feeding in odd sized pieces gives the same digest.
+		const std::string text = "The quick brown fox jumps over the lazy dog, repeatedly, to cross a block boundary or two.";
+		MD5 incremental;
+		for (size_t i = 0; i < text.size(); i += 7)
+			incremental.Update(text.data() + i, std::min<size_t>(7, text.size() - i));
+		REQUIRE(incremental.Finalize() == MD5::Compute(text.data(), text.size()));
+	}
+
+	TEST_CASE("DSF writer round trips through the reader", "[xplane][dsf]")
+	{
+		const DSFOverlay overlay = MakeAirportOverlay();
+		DSFWriter writer;
+		std::vector<uint8_t> bytes;
+		REQUIRE(writer.Write(overlay, bytes));
+		REQUIRE(writer.GetStats().outputBytes == bytes.size());
+
+		DSFReader reader;
+		const DSFOverlay result = ReadBack(bytes, reader);
+
+		double west, south, east, north;
+		REQUIRE(reader.GetBounds(west, south, east, north));
+		REQUIRE(west == -73.0);
+		REQUIRE(south == 41.0);
+		REQUIRE(east == -72.0);
+		REQUIRE(north == 42.0);
+		REQUIRE(*reader.FindProperty("sim/overlay") == "1");
+		REQUIRE(*reader.FindProperty("sim/exclude_obj") == "-72.9/41.2/-72.8/41.3");
+
+		/// Definitions are deduplicated; lines share the polygon table.
+		REQUIRE(reader.GetObjectDefinitions().size() == 3);
+		REQUIRE(reader.GetPolygonDefinitions().size() == 3);
+		REQUIRE(reader.GetTerrainDefinitions().empty());
+
+		/// Placements come back grouped by definition, so match them by name and position.
+		REQUIRE(result.objects.size() == overlay.objects.size());
+		for (const DSFOverlayObject &expected : overlay.objects)
+		{
+			const auto it = std::ranges::find_if(result.objects, [&](const DSFOverlayObject &object) {
+				return object.definition == expected.definition && std::abs(object.longitude - expected.longitude) < 1e-6 &&
+				       std::abs(object.latitude - expected.latitude) < 1e-6;
+			});
+			REQUIRE(it != result.objects.end());
+			REQUIRE(it->heading == Catch::Approx(expected.heading).margin(0.01));
+			REQUIRE(it->elevation.has_value() == expected.elevation.has_value());
+			if (expected.elevation)
+				REQUIRE(*it->elevation == Catch::Approx(*expected.elevation));
+		}
+
+		REQUIRE(result.polygons.size() == 4);
+		const auto findPolygon = [&](const std::string &definition, const uint16_t parameter) {
+			const auto it = std::ranges::find_if(result.polygons, [&](const DSFOverlayPolygon &p) { return p.definition == definition && p.parameter == parameter; });
+			REQUIRE(it != result.polygons.end());
+			return *it;
+		};
+
+		const DSFOverlayPolygon apron = findPolygon("lib/g10/forests/mixed.for", 180);
+		REQUIRE(apron.windings.size() == 2);
+		REQUIRE(apron.windings[0].size() == 8);
+		REQUIRE(apron.windings[1].size() == 6);
+		for (size_t w = 0; w < 2; ++w)
+		{
+			for (size_t i = 0; i < apron.windings[w].size(); ++i)
+				REQUIRE(apron.windings[w][i] == Catch::Approx(overlay.polygons[0].windings[w][i]).margin(1e-6));
+		}
+
+		const DSFOverlayPolygon facade = findPolygon("objects/terminal.fac", 12);
+		REQUIRE(facade.planeCount == 3);
+		REQUIRE(facade.windings[0][5] == Catch::Approx(1.0).margin(1e-4));
+
+		const DSFOverlayPolygon closed = findPolygon("lib/airport/lines/solid_yellow.lin", 1);
+		REQUIRE(closed.windings[0].size() == 6);
+		const DSFOverlayPolygon open = findPolygon("lib/airport/lines/solid_yellow.lin", 0);
+		REQUIRE(open.windings[0][3] == Catch::Approx(41.263).margin(1e-6));
+	}
+
+	TEST_CASE("DSF writer scales pools to their extent", "[xplane][dsf]")
+	{
+		/// Two full pools worth of objects in clusters far apart, each pool quantized across its own cluster.
+		DSFOverlay overlay;
+		overlay.west = 8;
+		overlay.south = 47;
+		std::mt19937 random(7);
+		std::uniform_real_distribution<double> jitter(0.0, 0.002);
+		for (int cluster = 0; cluster < 2; ++cluster)
+		{
+			for (int i = 0; i < 65535; ++i)
+			{
+				DSFOverlayObject &object = overlay.objects.emplace_back();
+				object.definition = "lib/g10/trees/tree.obj";
+				object.longitude = 8.1 + cluster * 0.8 + jitter(random);
+				object.latitude = 47.1 + cluster * 0.8 + jitter(random);
+				object.heading = jitter(random) * 180000.0;
+			}
+		}
+
+		DSFWriter writer;
+		std::vector<uint8_t> bytes;
+		REQUIRE(writer.Write(overlay, bytes));
+		REQUIRE(writer.GetStats().poolCount == 2);
+		REQUIRE(writer.GetStats().pointCount == 131070);
+
+		DSFReader reader;
+		const DSFOverlay result = ReadBack(bytes, reader);
+		REQUIRE(result.objects.size() == overlay.objects.size());
+
+		/// Half a step of a 0.002 degree extent is about 1.5e-8 degrees, well under a millimetre.
+		/// Rounding is monotonic, so sorted inputs and outputs pair up axis by axis.
+		double worst = 0.0;
+		for (const auto axis : { &DSFOverlayObject::longitude, &DSFOverlayObject::latitude })
+		{
+			std::vector<double> expected;
+			std::vector<double> actual;
+			for (size_t i = 0; i < overlay.objects.size(); ++i)
+			{
+				expected.push_back(overlay.objects[i].*axis);
+				actual.push_back(result.objects[i].*axis);
+			}
+			std::ranges::sort(expected);
+			std::ranges::sort(actual);
+			for (size_t i = 0; i < expected.size(); ++i)
+				worst = std::max(worst, std::abs(expected[i] - actual[i]));
+		}
+		REQUIRE(worst < 2e-8);
+
+		/// One definition per pool collapses every object into a single range command.
+		REQUIRE(AtomSize(bytes, DSF::Atom::Commands) < 64);
+	}
+
+	TEST_CASE("DSF writer output is independent of threading", "[xplane][dsf]")
+	{
+		DSFOverlay overlay = MakeAirportOverlay();
+		for (int i = 0; i < 150000; ++i)
+		{
+			DSFOverlayObject &object = overlay.objects.emplace_back();
+			object.definition = "lib/g10/trees/tree" + std::to_string(i % 5) + ".obj";
+			object.longitude = -73.0 + (i % 997) / 997.0;
+			object.latitude = 41.0 + (i / 997) / 160.0;
+			object.heading = i % 360;
+		}
+
+		ThreadPool pool(4);
+		DSFWriter serial;
+		DSFWriter parallel;
+		std::vector<uint8_t> serialBytes;
+		std::vector<uint8_t> parallelBytes;
+		REQUIRE(serial.Write(overlay, serialBytes, { false, nullptr }));
+		REQUIRE(parallel.Write(overlay, parallelBytes, { true, &pool }));
+		REQUIRE(serial.GetStats().poolCount >= 3);
+		REQUIRE(serialBytes == parallelBytes);
+
+		DSFReader reader;
+		REQUIRE(ReadBack(parallelBytes, reader).objects.size() == overlay.objects.size());
+	}
+
+	TEST_CASE("DSF writer rejects invalid placements", "[xplane][dsf]")
+	{
+		DSFWriter writer;
+		std::vector<uint8_t> bytes;
+
+		SECTION("Object outside the tile")
+		{
+			DSFOverlay overlay = MakeAirportOverlay();
+			overlay.objects[3].longitude = -71.5;
+			REQUIRE_FALSE(writer.Write(overlay, bytes));
+			REQUIRE(writer.GetError() == "object 3 lies outside the tile");
+		}
+
+		SECTION("Missing definition")
+		{
+			DSFOverlay overlay = MakeAirportOverlay();
+			overlay.lines[1].definition.clear();
+			REQUIRE_FALSE(writer.Write(overlay, bytes));
+			REQUIRE(writer.GetError() == "line 1 has no definition");
+		}
+
+		SECTION("Partial point")
+		{
+			DSFOverlay overlay = MakeAirportOverlay();
+			overlay.polygons[1].windings[0].pop_back();
+			REQUIRE_FALSE(writer.Write(overlay, bytes));
+			REQUIRE(writer.GetError() == "polygon 1 has a winding that is not a whole number of points");
+		}
+
+		SECTION("Polygon larger than a pool")
+		{
+			DSFOverlay overlay;
+			DSFOverlayPolygon &polygon = overlay.polygons.emplace_back();
+			polygon.definition = "huge.pol";
+			polygon.windings.emplace_back(70000 * 2, 0.5);
+			REQUIRE_FALSE(writer.Write(overlay, bytes));
+			REQUIRE(writer.GetError().find("more than 65535 points") != std::string::npos);
+		}
+	}
+
+	TEST_CASE("DSF writer saves files the reader verifies", "[xplane][dsf]")
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "sedx_dsf_writer_test.dsf";
+		DSFWriter writer;
+		REQUIRE(writer.Save(MakeAirportOverlay(), path));
+		REQUIRE_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+		DSFReadOptions options;
+		options.verifyChecksum = true;
+		DSFReader reader;
+		REQUIRE(reader.Open(path, options));
+		reader.Close();
+
+		/// Flip one byte inside the atoms.
+		{
+			std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+			file.seekp(40);
+			file.put('\x7F');
+		}
+		REQUIRE_FALSE(reader.Open(path, options));
+		REQUIRE(reader.GetError() == "DSF checksum mismatch");
+		std::filesystem::remove(path);
+	}
+
+	TEST_CASE("DSF writer overlay encode throughput", "[xplane][dsf][performance]")
+	{
+		/// A dense autogen style overlay: scattered objects and many small polygons and lines.
+		DSFOverlay overlay;
+		overlay.west = 8;
+		overlay.south = 47;
+		std::mt19937 random(11);
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		for (int i = 0; i < 500000; ++i)
+		{
+			DSFOverlayObject &object = overlay.objects.emplace_back();
+			object.definition = "lib/g10/autogen/house" + std::to_string(i % 40) + ".obj";
+			object.longitude = 8.0 + unit(random);
+			object.latitude = 47.0 + unit(random);
+			object.heading = unit(random) * 360.0;
+		}
+		for (int i = 0; i < 50000; ++i)
+		{
+			const double lon = 8.0 + unit(random) * 0.99;
+			const double lat = 47.0 + unit(random) * 0.99;
+			DSFOverlayPolygon &polygon = overlay.polygons.emplace_back();
+			polygon.definition = "lib/g10/forests/forest" + std::to_string(i % 12) + ".for";
+			polygon.parameter = 255;
+			polygon.windings = { { lon, lat, lon + 0.002, lat, lon + 0.002, lat + 0.001, lon, lat + 0.001 } };
+			DSFOverlayLine &line = overlay.lines.emplace_back();
+			line.definition = "lib/g10/lines/fence.lin";
+			line.coords = { lon, lat, lon + 0.001, lat + 0.0005, lon + 0.002, lat };
+		}
+
+		using Clock = std::chrono::high_resolution_clock;
+		const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+		DSFWriter serial;
+		std::vector<uint8_t> serialBytes;
+		auto start = Clock::now();
+		REQUIRE(serial.Write(overlay, serialBytes, { false, nullptr }));
+		const double serialMs = ms(start);
+
+		DSFWriter writer;
+		std::vector<uint8_t> bytes;
+		start = Clock::now();
+		REQUIRE(writer.Write(overlay, bytes));
+		const double parallelMs = ms(start);
+
+		DSFReader reader;
+		start = Clock::now();
+		const DSFOverlay result = ReadBack(bytes, reader);
+		const double readMs = ms(start);
+
+		const DSFWriteStats &stats = writer.GetStats();
+		const size_t rawBytes = stats.pointCount * 3 * sizeof(uint16_t);
+		INFO("Output: " << stats.outputBytes / 1048576.0 << " MiB for " << stats.pointCount << " points in " << stats.poolCount << " pools");
+		INFO("Pool payload vs raw 16-bit: " << 100.0 * AtomSize(bytes, DSF::Atom::Geodata) / static_cast<double>(rawBytes) << "%");
+		INFO("Write serial: " << serialMs << " ms, parallel: " << parallelMs << " ms (" << ThreadPool::Get().GetWorkerCount() << " workers)");
+		INFO("Layout: " << stats.layoutMs << " ms, encode: " << stats.encodeMs << " ms, total: " << stats.totalMs << " ms");
+		INFO("Verified read back: " << readMs << " ms");
+		CHECK(result.objects.size() == overlay.objects.size());
+		CHECK(result.polygons.size() == overlay.polygons.size() + overlay.lines.size());
+		CHECK(serialBytes == bytes);
+	}
+
+}
+
+/// -------------------------------------------------------
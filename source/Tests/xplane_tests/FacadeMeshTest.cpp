@@ -0,0 +1,464 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* FacadeMeshTest.cpp
+* -------------------------------------------------------
+* Facade parsing, mesh generation and benchmarks
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <SceneryEditorX/asset/xplane/facade_mesh.h>
+#include <X-PlaneSceneryLibrary/XPFac.h>
+
+/// -------------------------------------------------------
+
+using namespace XPAsset;
+
+namespace SceneryEditorX::Tests
+{
+	/// Panel facade: 1 m caps and 3 m repeating bays across, a 3 m ground floor, 3 m storeys and a 1 m parapet up.
+	const char *const FAC_TYPE1_SAMPLE =
+		"A\r\n"
+		"800\r\n"
+		"FACADE\r\n"
+		"\r\n"
+		"TEXTURE office.png\r\n"
+		"TEXTURE_NORMAL 2.0 office_NML.png\r\n"
+		"RING 1\r\n"
+		"HARD_ROOF\r\n"
+		"LOD 0 5000\r\n"
+		"ROOF 0.5 0.0\r\n"
+		"ROOF 1.0 0.0\r\n"
+		"ROOF 1.0 0.5\r\n"
+		"ROOF 0.5 0.5\r\n"
+		"WALL 2 1000 0 360 office\r\n"
+		"SCALE 10 10\r\n"
+		"ROOF_SLOPE 0\r\n"
+		"BOTTOM 0 0.3\r\n"
+		"MIDDLE 0.3 0.6\r\n"
+		"TOP 0.9 1.0\r\n"
+		"LEFT 0 0.1\r\n"
+		"CENTER 0.1 0.4\r\n"
+		"RIGHT 0.9 1.0\r\n"
+		"LOD 5000 20000\r\n"
+		"WALL 2 1000 0 360\r\n"
+		"SCALE 20 20\r\n";
+
+	/// Segment facade: a 3 m and a 5 m bay, a low and a tall floor, and a lamp on the wide bay.
+	const char *const FAC_TYPE2_SAMPLE =
+		"I\n"
+		"1000\n"
+		"FACADE\n"
+		"SHADER_WALL\n"
+		"TEXTURE shed.png\n"
+		"SHADER_ROOF\n"
+		"TEXTURE shed_roof.png\n"
+		"ROOF_SCALE 8 4\n"
+		"OBJ lamp.obj\n"
+		"FLOOR low\n"
+		"ROOF_HEIGHT 4\n"
+		"SEGMENT 0\n"
+		"MESH 0 2000 10000 4 6\n"
+		"VERTEX 0 0 0 0 0 -1 0 0\n"
+		"VERTEX 3 0 0 0 0 -1 1 0\n"
+		"VERTEX 3 4 0 0 0 -1 1 1\n"
+		"VERTEX 0 4 0 0 0 -1 0 1\n"
+		"IDX 0 2 1 0 3 2\n"
+		"MESH 0 0 2000 4 6\n"
+		"VERTEX 0 0 0 0 0 -1 0 0\n"
+		"VERTEX 3 0 0 0 0 -1 0.3 0\n"
+		"VERTEX 3 4 0 0 0 -1 0.3 1\n"
+		"VERTEX 0 4 0 0 0 -1 0 1\n"
+		"IDX 0 2 1\n"
+		"IDX 0 3 2\n"
+		"SEGMENT 1\n"
+		"MESH 0 0 10000 4 6\n"
+		"VERTEX 0 0 -0.5 0 0 -1 0.3 0\n"
+		"VERTEX 5 0 -0.5 0 0 -1 0.8 0\n"
+		"VERTEX 5 4 -0.5 0 0 -1 0.8 1\n"
+		"VERTEX 0 4 -0.5 0 0 -1 0.3 1\n"
+		"IDX 0 2 1 0 3 2\n"
+		"ATTACH_DRAPED 0 2.5 3 -1 90\n"
+		"WALL 1 1000 0 360 sides\n"
+		"SPELLING 0 0\n"
+		"SPELLING 1 0 1\n"
+		"SPELLING 0\n"
+		"FLOOR tall\n"
+		"ROOF_HEIGHT 8\n"
+		"ROOF_HEIGHT 7\n"
+		"SEGMENT 0\n"
+		"MESH 0 0 10000 4 6\n"
+		"VERTEX 0 0 0 0 0 -1 0 0\n"
+		"VERTEX 4 0 0 0 0 -1 1 0\n"
+		"VERTEX 4 8 0 0 0 -1 1 1\n"
+		"VERTEX 0 8 0 0 0 -1 0 1\n"
+		"IDX 0 2 1 0 3 2\n"
+		"WALL 1 1000 0 360\n"
+		"SPELLING 0\n";
+
+	Vec3 Cross(const Vec3 &a, const Vec3 &b)
+	{
+		return Vec3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+	}
+
+	float Dot(const Vec3 &a, const Vec3 &b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	/// Counts triangles whose winding disagrees with their vertex normals, or whose normal does not face away from @p centre.
+	uint32_t CountBadTriangles(const FacadeMesh &mesh, const Vec3 &centre)
+	{
+		uint32_t bad = 0;
+		for (size_t i = 0; i < mesh.indices.size(); i += 3)
+		{
+			const FacadeVertex &a = mesh.vertices[mesh.indices[i]];
+			const FacadeVertex &b = mesh.vertices[mesh.indices[i + 1]];
+			const FacadeVertex &c = mesh.vertices[mesh.indices[i + 2]];
+			const Vec3 face = Cross(b.position - a.position, c.position - a.position);
+			const Vec3 middle = (a.position + b.position + c.position) / 3.0f;
+			const Vec3 away = i < mesh.roofIndexStart ? Vec3(middle.x - centre.x, 0.0f, middle.z - centre.z) : Vec3(0.0f, 1.0f, 0.0f);
+			if (Dot(face, a.normal) <= 0.0f || Dot(a.normal, away) <= 0.0f)
+				++bad;
+		}
+		return bad;
+	}
+
+	std::vector<DVec2> MakeRectangle(const double x, const double z, const double width, const double depth)
+	{
+		return {DVec2(x, z), DVec2(x + width, z), DVec2(x + width, z + depth), DVec2(x, z + depth)};
+	}
+
+	/// -------------------------------------------------------
+
+	TEST_CASE("facade parser reads panel facades", "[xplane][facade]")
+	{
+		Fac facade;
+		REQUIRE(facade.Parse(FAC_TYPE1_SAMPLE));
+		CHECK(facade.intVersion == 800);
+		CHECK_FALSE(facade.bType2);
+		CHECK(facade.bRing);
+		CHECK(facade.bHardRoof);
+		CHECK(facade.pBaseTex == "office.png");
+		CHECK(facade.pNormalTex == "office_NML.png");
+		CHECK(facade.dblNormalScale == Catch::Approx(2.0));
+
+		REQUIRE(facade.Lods.size() == 2);
+		CHECK(facade.Lods[1].fNear == Catch::Approx(5000.0f));
+		CHECK(facade.Lods[0].RoofCoords.size() == 8);
+		REQUIRE(facade.GetWalls() == &facade.Lods[0].Walls);
+		const FacWall &wall = facade.Lods[0].Walls[0];
+		CHECK(wall.strName == "office");
+		CHECK(wall.fMinWidth == Catch::Approx(2.0f));
+		CHECK(wall.fScaleS == Catch::Approx(10.0f));
+		CHECK(wall.Left.size() == 1);
+		CHECK(wall.Center[0].fEnd == Catch::Approx(0.4f));
+		CHECK(wall.Top[0].fStart == Catch::Approx(0.9f));
+	}
+
+	TEST_CASE("facade parser reads segment facades", "[xplane][facade]")
+	{
+		Fac facade;
+		REQUIRE(facade.Parse(FAC_TYPE2_SAMPLE));
+		CHECK(facade.intVersion == 1000);
+		CHECK(facade.bType2);
+		CHECK(facade.pBaseTex == "shed.png");
+		CHECK(facade.pRoofTex == "shed_roof.png");
+		CHECK(facade.fRoofScaleS == Catch::Approx(8.0f));
+		CHECK(facade.fRoofScaleT == Catch::Approx(4.0f));
+		REQUIRE(facade.Objects.size() == 1);
+		CHECK(facade.Objects[0] == "lamp.obj");
+
+		REQUIRE(facade.Floors.size() == 2);
+		const FacFloor &low = facade.Floors[0];
+		CHECK(low.strName == "low");
+		REQUIRE(low.Segments.size() == 2);
+
+		/// Only the nearest MESH is kept, whichever order the LODs come in.
+		CHECK(low.Segments[0].Vertices.size() == 4);
+		CHECK(low.Segments[0].Vertices[1].U == Catch::Approx(0.3f));
+		CHECK(low.Segments[0].Indices == std::vector<uint32_t>{0, 2, 1, 0, 3, 2});
+		CHECK(low.Segments[0].fWidth == Catch::Approx(3.0f));
+		CHECK(low.Segments[1].fWidth == Catch::Approx(5.0f));
+		REQUIRE(low.Segments[1].Attachments.size() == 1);
+		CHECK(low.Segments[1].Attachments[0].fHeading == Catch::Approx(90.0f));
+
+		REQUIRE(low.Walls.size() == 1);
+		CHECK(low.Walls[0].Spellings.size() == 3);
+		CHECK(low.Walls[0].Spellings[1] == std::vector<uint32_t>{1, 0, 1});
+
+		/// Roof heights are sorted and the highest caps the floor.
+		CHECK(facade.Floors[1].RoofHeights == std::vector<float>{7.0f, 8.0f});
+		CHECK(facade.Floors[1].GetHeight() == Catch::Approx(8.0f));
+	}
+
+	TEST_CASE("facade parser rejects malformed files", "[xplane][facade]")
+	{
+		Fac facade;
+		CHECK_FALSE(facade.Parse("A\n800\nOBJ\n"));
+		CHECK_FALSE(facade.Parse("A\n900\nFACADE\nLOD 0 100\nWALL 0 10 0 360\n"));
+		CHECK_FALSE(facade.Parse("A\n800\nFACADE\nTEXTURE a.png\n"));
+		CHECK_FALSE(facade.Parse("A\n800\nFACADE\nLEFT 0 1\n"));
+		CHECK_FALSE(facade.Parse("A\n800\nFACADE\nWALL 0 10 0\n"));
+		CHECK_FALSE(facade.Parse("I\n1000\nFACADE\nFLOOR f\nSEGMENT 1\n"));
+		CHECK_FALSE(facade.Parse("I\n1000\nFACADE\nFLOOR f\nSEGMENT 0\nMESH 0 0 100 1 3\nVERTEX 0 0 0 0 0 -1 0 0\nIDX 0 0 1\nWALL 0 10 0 360\nSPELLING 0\n"));
+		CHECK_FALSE(facade.Parse("I\n1000\nFACADE\nFLOOR f\nSEGMENT 0\nWALL 0 10 0 360\nSPELLING 1\n"));
+		CHECK_FALSE(facade.Parse("I\n1000\nFACADE\nFLOOR f\nSEGMENT 0\nATTACH_DRAPED 0 0 0 0 0\nWALL 0 10 0 360\nSPELLING 0\n"));
+		CHECK(facade.Parse("A\n800\nFACADE\nWALL 0 10 0 360\n"));
+		CHECK(facade.Lods.size() == 1);
+	}
+
+	TEST_CASE("panel facade walls and roof", "[xplane][facade]")
+	{
+		Fac facade;
+		REQUIRE(facade.Parse(FAC_TYPE1_SAMPLE));
+
+		FacadeGenerator generator(facade);
+		generator.SetFootprint(MakeRectangle(100.0, 50.0, 20.0, 10.0), 9.0f);
+		const FacadeMesh &mesh = generator.GetMesh();
+
+		/// 20 m walls: caps plus six bays; 10 m walls: caps plus three bays. Four rows up each.
+		CHECK(mesh.roofIndexStart == (2 * 8 * 4 + 2 * 5 * 4) * 6);
+		CHECK(mesh.indices.size() - mesh.roofIndexStart == 6);
+		CHECK(generator.GetLastUpdate().edgesBuilt == 4);
+		CHECK(generator.GetLastUpdate().roofBuilt);
+
+		float minY = 1e9f, maxY = -1e9f;
+		for (uint32_t i = 0; i < mesh.roofVertexStart; ++i)
+		{
+			const Vec3 &position = mesh.vertices[i].position;
+			minY = std::min(minY, position.y);
+			maxY = std::max(maxY, position.y);
+			CHECK(position.x >= 100.0f - 1e-4f);
+			CHECK(position.x <= 120.0f + 1e-4f);
+			CHECK(position.z >= 50.0f - 1e-4f);
+			CHECK(position.z <= 60.0f + 1e-4f);
+		}
+		CHECK(minY == Catch::Approx(0.0f));
+		CHECK(maxY == Catch::Approx(9.0f));
+		for (uint32_t i = mesh.roofVertexStart; i < mesh.vertices.size(); ++i)
+			CHECK(mesh.vertices[i].position.y == Catch::Approx(9.0f));
+
+		/// The first column of the north wall is the 1 m left cap, textured from its panel.
+		CHECK(mesh.vertices[1].position.x - mesh.vertices[0].position.x == Catch::Approx(20.0f / 20.0f).margin(0.05f));
+		CHECK(mesh.vertices[0].texcoord.x == Catch::Approx(0.0f));
+		CHECK(mesh.vertices[1].texcoord.x == Catch::Approx(0.1f));
+
+		/// The roof maps its bounds onto the ROOF coordinates, north up.
+		CHECK(mesh.vertices[mesh.roofVertexStart].texcoord.x == Catch::Approx(0.5f));
+		CHECK(mesh.vertices[mesh.roofVertexStart].texcoord.y == Catch::Approx(0.5f));
+
+		/// Every face points out of the building, whichever way the footprint winds.
+		const Vec3 centre(110.0f, 0.0f, 55.0f);
+		CHECK(CountBadTriangles(mesh, centre) == 0);
+
+		std::vector<DVec2> reversed = MakeRectangle(100.0, 50.0, 20.0, 10.0);
+		std::ranges::reverse(reversed);
+		FacadeGenerator mirrored(facade);
+		mirrored.SetFootprint(reversed, 9.0f);
+		CHECK(mirrored.GetMesh().indices.size() == mesh.indices.size());
+		CHECK(CountBadTriangles(mirrored.GetMesh(), centre) == 0);
+
+		/// An open facade is a fence: one wall per edge and no roof.
+		Fac fence;
+		REQUIRE(fence.Parse(std::string(FAC_TYPE1_SAMPLE).replace(std::string(FAC_TYPE1_SAMPLE).find("RING 1"), 6, "RING 0")));
+		FacadeGenerator fenceGenerator(fence);
+		fenceGenerator.SetFootprint(MakeRectangle(0.0, 0.0, 20.0, 10.0), 2.0f);
+		const FacadeMesh &fenceMesh = fenceGenerator.GetMesh();
+		CHECK(fenceGenerator.GetLastUpdate().edgesBuilt == 3);
+		CHECK(fenceMesh.roofIndexStart == fenceMesh.indices.size());
+		CHECK(fenceMesh.roofIndexStart > 0);
+	}
+
+	TEST_CASE("segment facade spellings, floors and objects", "[xplane][facade]")
+	{
+		Fac facade;
+		REQUIRE(facade.Parse(FAC_TYPE2_SAMPLE));
+
+		/// 14 m takes the widest spelling that fits (5 + 3 + 5 = 13 m), stretched; 4 m takes the 3 m one.
+		FacadeGenerator generator(facade);
+		generator.SetFootprint(MakeRectangle(0.0, 0.0, 14.0, 4.0), 3.0f);
+		const FacadeMesh &mesh = generator.GetMesh();
+		CHECK(mesh.roofIndexStart == (2 * 3 + 2 * 1) * 6);
+		CHECK(CountBadTriangles(mesh, Vec3(7.0f, 0.0f, 2.0f)) == 0);
+
+		/// The roof sits on the low floor and uses ROOF_SCALE metres.
+		REQUIRE(mesh.vertices.size() > mesh.roofVertexStart);
+		const FacadeVertex &roof = mesh.vertices[mesh.roofVertexStart + 1];
+		CHECK(roof.position.y == Catch::Approx(4.0f));
+		CHECK(roof.texcoord.x == Catch::Approx(14.0f / 8.0f));
+
+		/// Each 14 m wall has two lamps. The north wall faces 0 degrees, so lamps point at 90;
+		/// the south wall faces 180. Lamps sit 1 m in front of their wall.
+		REQUIRE(mesh.objects.size() == 4);
+		CHECK(mesh.objects[0].heading == Catch::Approx(90.0f));
+		CHECK(mesh.objects[0].position.x == Catch::Approx(2.5f * 14.0f / 13.0f));
+		CHECK(mesh.objects[0].position.z == Catch::Approx(-1.0f));
+		CHECK(mesh.objects[0].position.y == Catch::Approx(3.0f));
+		CHECK(mesh.objects[2].heading == Catch::Approx(270.0f));
+		CHECK(mesh.objects[2].position.z == Catch::Approx(5.0f));
+
+		/// Taller buildings move to the tall floor.
+		generator.SetHeight(7.5f);
+		const FacadeMesh &tall = generator.GetMesh();
+		CHECK(tall.vertices[tall.roofVertexStart].position.y == Catch::Approx(8.0f));
+		CHECK(tall.objects.empty());
+		CHECK(generator.GetLastUpdate().edgesBuilt == 4);
+	}
+
+	TEST_CASE("facade cache and incremental edits", "[xplane][facade]")
+	{
+		Fac facade;
+		REQUIRE(facade.Parse(FAC_TYPE1_SAMPLE));
+		FacadeSegmentCache cache;
+
+		FacadeGenerator first(facade, &cache);
+		first.SetFootprint(MakeRectangle(0.0, 0.0, 20.0, 10.0), 9.0f);
+		first.GetMesh();
+		CHECK(first.GetLastUpdate().cacheMisses == 2);
+		CHECK(first.GetLastUpdate().cacheHits == 2);
+		CHECK(cache.GetSize() == 2);
+
+		/// A building of the same size elsewhere reuses both walls.
+		FacadeGenerator second(facade, &cache);
+		second.SetFootprint(MakeRectangle(500.0, 300.0, 20.1, 10.1), 9.1f);
+		second.GetMesh();
+		CHECK(second.GetLastUpdate().cacheHits == 4);
+		CHECK(second.GetLastUpdate().cacheMisses == 0);
+
+		/// Dragging one corner rebuilds the two walls that meet at it, and the roof.
+		first.MoveNode(2, DVec2(24.0, 12.0));
+		const FacadeMesh &edited = first.GetMesh();
+		CHECK(first.GetLastUpdate().edgesBuilt == 2);
+		CHECK(first.GetLastUpdate().roofBuilt);
+
+		/// Nothing changed, nothing rebuilt.
+		first.GetMesh();
+		CHECK(first.GetLastUpdate().edgesBuilt == 0);
+		CHECK_FALSE(first.GetLastUpdate().roofBuilt);
+
+		/// The edited mesh matches one built from scratch, with or without the cache.
+		FacadeGenerator fresh(facade);
+		fresh.SetFootprint(first.GetFootprint(), 9.0f);
+		const FacadeMesh &rebuilt = fresh.GetMesh();
+		REQUIRE(rebuilt.vertices.size() == edited.vertices.size());
+		CHECK(std::memcmp(rebuilt.vertices.data(), edited.vertices.data(), edited.vertices.size() * sizeof(FacadeVertex)) == 0);
+		CHECK(rebuilt.indices == edited.indices);
+
+		/// Moving the first node also dirties the closing edge.
+		first.MoveNode(0, DVec2(-1.0, 0.0));
+		first.GetMesh();
+		CHECK(first.GetLastUpdate().edgesBuilt == 2);
+
+		/// Dropping a facade drops its walls.
+		cache.Erase(&facade);
+		CHECK(cache.GetSize() == 0);
+	}
+
+	TEST_CASE("facade generation for 10k buildings", "[xplane][facade][performance]")
+	{
+		using Clock = std::chrono::high_resolution_clock;
+		const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+		Fac panels;
+		Fac segments;
+		REQUIRE(panels.Parse(FAC_TYPE1_SAMPLE));
+		REQUIRE(segments.Parse(FAC_TYPE2_SAMPLE));
+
+		/// A town of rectangles and L shapes between 8 and 40 m across, 3 to 30 m tall.
+		constexpr uint32_t buildingCount = 10000;
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<double> size(8.0, 40.0);
+		std::uniform_real_distribution<float> height(3.0f, 30.0f);
+		struct Building
+		{
+			const Fac *facade;
+			std::vector<DVec2> footprint;
+			float height;
+		};
+		std::vector<Building> buildings;
+		buildings.reserve(buildingCount);
+		for (uint32_t i = 0; i < buildingCount; ++i)
+		{
+			const double x = (i % 100) * 60.0;
+			const double z = (i / 100) * 60.0;
+			const double width = size(random);
+			const double depth = size(random);
+			std::vector<DVec2> footprint = MakeRectangle(x, z, width, depth);
+			if (i % 3 == 0)
+			{
+				/// Notch the far corner out to make an L.
+				footprint[2] = DVec2(x + width, z + depth * 0.5);
+				footprint.insert(footprint.begin() + 3, {DVec2(x + width * 0.5, z + depth * 0.5), DVec2(x + width * 0.5, z + depth)});
+			}
+			buildings.push_back({i % 4 == 0 ? &segments : &panels, std::move(footprint), height(random)});
+		}
+
+		const auto generate = [&](FacadeSegmentCache *cache, size_t &triangles)
+		{
+			triangles = 0;
+			for (const Building &building : buildings)
+			{
+				FacadeGenerator generator(*building.facade, cache);
+				generator.SetFootprint(building.footprint, building.height);
+				triangles += generator.GetMesh().indices.size() / 3;
+			}
+		};
+
+		size_t uncachedTriangles = 0;
+		auto start = Clock::now();
+		generate(nullptr, uncachedTriangles);
+		const double uncachedMs = ms(start);
+
+		FacadeSegmentCache cache;
+		size_t coldTriangles = 0;
+		start = Clock::now();
+		generate(&cache, coldTriangles);
+		const double coldMs = ms(start);
+
+		size_t warmTriangles = 0;
+		start = Clock::now();
+		generate(&cache, warmTriangles);
+		const double warmMs = ms(start);
+
+		/// Dragging one corner of a 256 sided courtyard building.
+		std::vector<DVec2> ring;
+		for (int i = 0; i < 256; ++i)
+		{
+			const double angle = i * 2.0 * 3.14159265358979 / 256.0;
+			ring.push_back(DVec2(std::cos(angle) * 150.0, std::sin(angle) * 150.0));
+		}
+		FacadeGenerator large(panels, &cache);
+		large.SetFootprint(ring, 20.0f);
+		start = Clock::now();
+		large.GetMesh();
+		const double fullMs = ms(start);
+		start = Clock::now();
+		for (int i = 0; i < 100; ++i)
+		{
+			large.MoveNode(17, DVec2(ring[17].x + i * 0.01, ring[17].y));
+			large.GetMesh();
+		}
+		const double editMs = ms(start) / 100.0;
+
+		INFO("Buildings: " << buildingCount << ", triangles: " << warmTriangles << ", cached walls: " << cache.GetSize());
+		INFO("Uncached: " << uncachedMs << " ms, cold cache: " << coldMs << " ms, warm cache: " << warmMs << " ms");
+		INFO("256 edge building: full " << fullMs << " ms, one node drag " << editMs << " ms");
+		CHECK(warmTriangles == coldTriangles);
+		CHECK(large.GetLastUpdate().edgesBuilt == 2);
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,366 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* ForestScatterTest.cpp
+* -------------------------------------------------------
+* Forest parsing, tree scattering and benchmarks
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <SceneryEditorX/asset/xplane/forest_scatter.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+#include <X-PlaneSceneryLibrary/XPFor.h>
+
+/// -------------------------------------------------------
+
+using namespace XPAsset;
+
+namespace SceneryEditorX::Tests
+{
+	/// Two species, three quarters oaks, planted every 10 m.
+	const char *const FOR_SAMPLE =
+		"A\r\n"
+		"800\r\n"
+		"FOREST\r\n"
+		"\r\n"
+		"TEXTURE trees.png\r\n"
+		"LOD 20000\r\n"
+		"SPACING 10 10\r\n"
+		"RANDOM 4 4\r\n"
+		"SCALE_X 512\r\n"
+		"SCALE_Y 256\r\n"
+		"SKIP_SURFACE water\r\n"
+		"# s t w y offset freq min_h max_h quads type name\r\n"
+		"TREE 0 0 128 256 64 75 8 14 2 0 oak\r\n"
+		"TREE 128 0 128 256 64 25 12 20 2 0 tall pine\r\n";
+
+	/// Outer 400 x 300 m rectangle with a 100 m square hole.
+	void MakeForestPolygon(std::vector<DVec2> &vertices, std::vector<uint32_t> &ringStarts)
+	{
+		vertices = {DVec2(1000.0, 2000.0), DVec2(1400.0, 2000.0), DVec2(1400.0, 2300.0), DVec2(1000.0, 2300.0),
+		            DVec2(1150.0, 2100.0), DVec2(1150.0, 2200.0), DVec2(1250.0, 2200.0), DVec2(1250.0, 2100.0)};
+		ringStarts = {0, 4};
+	}
+
+	bool ForestPolygonContains(const std::vector<DVec2> &vertices, const std::vector<uint32_t> &ringStarts, const DVec2 &point)
+	{
+		bool inside = false;
+		for (size_t ring = 0; ring < ringStarts.size(); ++ring)
+		{
+			const size_t begin = ringStarts[ring];
+			const size_t end = ring + 1 < ringStarts.size() ? ringStarts[ring + 1] : vertices.size();
+			for (size_t i = begin; i < end; ++i)
+			{
+				const DVec2 &a = vertices[i];
+				const DVec2 &b = vertices[i + 1 < end ? i + 1 : begin];
+				if ((a.y > point.y) != (b.y > point.y) && point.x < a.x + (point.y - a.y) * (b.x - a.x) / (b.y - a.y))
+					inside = !inside;
+			}
+		}
+		return inside;
+	}
+
+	bool SameInstances(const ForestInstanceBuffer &a, const ForestInstanceBuffer &b)
+	{
+		return a.origin.x == b.origin.x && a.origin.y == b.origin.y && a.instances.size() == b.instances.size() &&
+		       std::memcmp(a.instances.data(), b.instances.data(), a.instances.size() * sizeof(ForestInstance)) == 0;
+	}
+
+	TEST_CASE("forest parser reads trees and spacing", "[xplane][forest]")
+	{
+		For forest;
+		REQUIRE(forest.Parse(FOR_SAMPLE));
+		REQUIRE(forest.intVersion == 800);
+		REQUIRE(forest.bHasBaseTex);
+		REQUIRE(forest.pBaseTex == "trees.png");
+		REQUIRE(forest.fLodFar == 20000.0f);
+		REQUIRE(forest.fSpacingX == 10.0f);
+		REQUIRE(forest.fSpacingZ == 10.0f);
+		REQUIRE(forest.fRandomX == 4.0f);
+		REQUIRE(forest.fScaleX == 512.0f);
+		REQUIRE(forest.fScaleY == 256.0f);
+		REQUIRE(forest.SkipSurfaces == std::vector<std::string>{"water"});
+
+		REQUIRE(forest.Trees.size() == 2);
+		REQUIRE(forest.Trees[0].strName == "oak");
+		REQUIRE(forest.Trees[0].fFrequency == 75.0f);
+		REQUIRE(forest.Trees[0].fMinHeight == 8.0f);
+		REQUIRE(forest.Trees[0].fMaxHeight == 14.0f);
+		REQUIRE(forest.Trees[0].intQuads == 2);
+		REQUIRE(forest.Trees[1].fS == 128.0f);
+		REQUIRE(forest.Trees[1].strName == "tall pine");
+
+		SECTION("Not a forest")
+		{
+			REQUIRE_FALSE(forest.Parse("A\n800\nFACADE\nSPACING 10 10\nTREE 0 0 1 1 0 100 5 10 2\n"));
+			REQUIRE_FALSE(forest.Parse("A\n900\nFOREST\nSPACING 10 10\nTREE 0 0 1 1 0 100 5 10 2\n"));
+			REQUIRE(forest.Trees.empty());
+		}
+
+		SECTION("Malformed commands")
+		{
+			REQUIRE_FALSE(forest.Parse("A\n800\nFOREST\nSPACING 10\nTREE 0 0 1 1 0 100 5 10 2\n"));
+			REQUIRE_FALSE(forest.Parse("A\n800\nFOREST\nSPACING 0 10\nTREE 0 0 1 1 0 100 5 10 2\n"));
+			REQUIRE_FALSE(forest.Parse("A\n800\nFOREST\nSPACING 10 10\nTREE 0 0 1 1 0 100 5 10\n"));
+			REQUIRE_FALSE(forest.Parse("A\n800\nFOREST\nSPACING 10 10\nTREE 0 0 1 1 0 100 12 10 2\n"));
+		}
+
+		SECTION("Nothing to plant")
+		{
+			REQUIRE_FALSE(forest.Parse("A\n800\nFOREST\nSPACING 10 10\n"));
+			REQUIRE_FALSE(forest.Parse("A\n800\nFOREST\nTREE 0 0 1 1 0 100 5 10 2\n"));
+		}
+	}
+
+	TEST_CASE("forest density comes from the DSF parameter", "[xplane][forest]")
+	{
+		REQUIRE(ForestDensityFromParameter(255) == 1.0f);
+		REQUIRE(ForestDensityFromParameter(0) == 0.0f);
+		REQUIRE(ForestDensityFromParameter(51) == Catch::Approx(0.2f));
+		REQUIRE(ForestDensityFromParameter(1051) == Catch::Approx(0.2f));
+		REQUIRE(ForestDensityFromParameter(2255) == 1.0f);
+	}
+
+	TEST_CASE("forest scatter fills the polygon around its holes", "[xplane][forest]")
+	{
+		For forest;
+		REQUIRE(forest.Parse(FOR_SAMPLE));
+		std::vector<DVec2> vertices;
+		std::vector<uint32_t> ringStarts;
+		MakeForestPolygon(vertices, ringStarts);
+
+		ForestScatter scatter;
+		ForestInstanceBuffer buffer;
+		ForestScatterOptions options;
+		options.seed = 42;
+		options.cellsPerTile = 8;
+		options.parallel = false;
+		REQUIRE(scatter.Scatter(forest, vertices, ringStarts, buffer, options));
+
+		const ForestScatterStats &stats = scatter.GetStats();
+		REQUIRE(stats.instances == buffer.instances.size());
+		REQUIRE(stats.clippedTiles > 0);
+		REQUIRE(stats.clippedTiles < stats.tiles);
+		REQUIRE(stats.samples > stats.instances);
+
+		/// 110000 m2 at one tree per 100 m2
+		REQUIRE(buffer.instances.size() == Catch::Approx(1100.0).epsilon(0.1));
+
+		uint32_t oaks = 0;
+		for (const ForestInstance &instance : buffer.instances)
+		{
+			const DVec2 position(buffer.origin.x + instance.x, buffer.origin.y + instance.z);
+			REQUIRE(ForestPolygonContains(vertices, ringStarts, position));
+			REQUIRE(instance.tree < 2);
+			const ForTree &tree = forest.Trees[instance.tree];
+			REQUIRE(instance.height >= tree.fMinHeight);
+			REQUIRE(instance.height <= tree.fMaxHeight);
+			oaks += instance.tree == 0;
+		}
+		REQUIRE(oaks / static_cast<double>(buffer.instances.size()) == Catch::Approx(0.75).margin(0.05));
+
+		/// No two trees closer than the Poisson-disk distance
+		const float minDistance = stats.minDistance;
+		for (size_t i = 0; i < buffer.instances.size(); ++i)
+		{
+			for (size_t j = i + 1; j < buffer.instances.size(); ++j)
+			{
+				const float dx = buffer.instances[i].x - buffer.instances[j].x;
+				const float dz = buffer.instances[i].z - buffer.instances[j].z;
+				if (dx * dx + dz * dz < minDistance * minDistance * 0.9999f)
+					FAIL("Trees " << i << " and " << j << " are " << std::sqrt(dx * dx + dz * dz) << " m apart");
+			}
+		}
+
+		SECTION("Density thins the forest")
+		{
+			ForestInstanceBuffer sparse;
+			options.density = ForestDensityFromParameter(64);
+			REQUIRE(scatter.Scatter(forest, vertices, ringStarts, sparse, options));
+			REQUIRE(sparse.instances.size() == Catch::Approx(1100.0 * 64 / 255).epsilon(0.15));
+			REQUIRE(scatter.GetStats().minDistance > minDistance * 1.9f);
+
+			options.density = 0.0f;
+			REQUIRE(scatter.Scatter(forest, vertices, ringStarts, sparse, options));
+			REQUIRE(sparse.instances.empty());
+		}
+
+		SECTION("The seed changes the trees")
+		{
+			ForestInstanceBuffer reseeded;
+			options.seed = 43;
+			REQUIRE(scatter.Scatter(forest, vertices, ringStarts, reseeded, options));
+			REQUIRE_FALSE(SameInstances(buffer, reseeded));
+		}
+	}
+
+	TEST_CASE("forest scatter is independent of threading", "[xplane][forest]")
+	{
+		For forest;
+		REQUIRE(forest.Parse(FOR_SAMPLE));
+
+		/// A 3 km square with a jagged edge, so many tiles are clipped.
+		std::vector<DVec2> vertices;
+		for (int i = 0; i < 360; ++i)
+		{
+			const double angle = i * 3.14159265358979 / 180.0;
+			const double radius = 1500.0 + (i % 2 ? 60.0 : 0.0);
+			vertices.emplace_back(-20000.0 + std::cos(angle) * radius, 5000.0 + std::sin(angle) * radius);
+		}
+
+		ForestScatterOptions options;
+		options.seed = 7;
+		options.parallel = false;
+		ForestScatter scatter;
+		ForestInstanceBuffer serial;
+		REQUIRE(scatter.Scatter(forest, vertices, {}, serial, options));
+		REQUIRE(serial.instances.size() > 50000);
+
+		for (const uint32_t workers : {1u, 2u, 4u, 7u})
+		{
+			INFO(workers << " workers");
+			ThreadPool pool(workers);
+			options.parallel = true;
+			options.threadPool = &pool;
+			ForestInstanceBuffer parallel;
+			REQUIRE(scatter.Scatter(forest, vertices, {}, parallel, options));
+			REQUIRE(SameInstances(serial, parallel));
+		}
+	}
+
+	TEST_CASE("forest scatter only moves trees near an edit", "[xplane][forest]")
+	{
+		For forest;
+		REQUIRE(forest.Parse(FOR_SAMPLE));
+		std::vector<DVec2> vertices = {DVec2(0.0, 0.0), DVec2(3000.0, 0.0), DVec2(3000.0, 500.0), DVec2(0.0, 500.0)};
+
+		ForestScatterOptions options;
+		options.parallel = false;
+		ForestScatter scatter;
+		ForestInstanceBuffer before;
+		REQUIRE(scatter.Scatter(forest, vertices, {}, before, options));
+		const double tileSize = scatter.GetStats().minDistance / std::sqrt(2.0) * options.cellsPerTile;
+
+		vertices[1].x += 40.0;
+		ForestInstanceBuffer after;
+		REQUIRE(scatter.Scatter(forest, vertices, {}, after, options));
+		REQUIRE_FALSE(SameInstances(before, after));
+
+		/// Each tile sees the tiles sampled in earlier phases, so an edit reaches at most three tiles away.
+		const double limit = 3000.0 - 4.0 * tileSize;
+		REQUIRE(limit > 1000.0);
+		const auto farFromEdit = [&](const ForestInstanceBuffer &buffer)
+		{
+			std::vector<ForestInstance> kept;
+			for (const ForestInstance &instance : buffer.instances)
+			{
+				if (buffer.origin.x + instance.x < limit)
+					kept.push_back(instance);
+			}
+			return kept;
+		};
+
+		const std::vector<ForestInstance> keptBefore = farFromEdit(before);
+		const std::vector<ForestInstance> keptAfter = farFromEdit(after);
+		REQUIRE(keptBefore.size() > 5000);
+		REQUIRE(keptBefore.size() == keptAfter.size());
+		REQUIRE(std::memcmp(keptBefore.data(), keptAfter.data(), keptBefore.size() * sizeof(ForestInstance)) == 0);
+	}
+
+	TEST_CASE("forest scatter rejects invalid input", "[xplane][forest]")
+	{
+		For forest;
+		REQUIRE(forest.Parse(FOR_SAMPLE));
+		std::vector<DVec2> vertices;
+		std::vector<uint32_t> ringStarts;
+		MakeForestPolygon(vertices, ringStarts);
+
+		ForestScatter scatter;
+		ForestInstanceBuffer buffer;
+
+		SECTION("Too few points")
+		{
+			REQUIRE_FALSE(scatter.Scatter(forest, {DVec2(0.0, 0.0), DVec2(1.0, 0.0)}, {}, buffer));
+			REQUIRE(scatter.GetError() == "Forest polygon needs at least three points");
+		}
+
+		SECTION("Bad rings")
+		{
+			REQUIRE_FALSE(scatter.Scatter(forest, vertices, {0, 8}, buffer));
+			REQUIRE(scatter.GetError() == "Forest polygon has invalid ring starts");
+			REQUIRE_FALSE(scatter.Scatter(forest, vertices, {4, 0}, buffer));
+		}
+
+		SECTION("Non-finite coordinates")
+		{
+			vertices[2].x = std::nan("");
+			REQUIRE_FALSE(scatter.Scatter(forest, vertices, ringStarts, buffer));
+			REQUIRE(scatter.GetError() == "Forest polygon has a non-finite coordinate");
+		}
+
+		SECTION("Too many trees")
+		{
+			ForestScatterOptions options;
+			options.maxInstances = 1000;
+			REQUIRE_FALSE(scatter.Scatter(forest, vertices, ringStarts, buffer, options));
+			REQUIRE(scatter.GetError() == "Forest polygon would plant about 1100 trees, more than the limit of 1000");
+		}
+
+		SECTION("Empty forest")
+		{
+			For empty;
+			REQUIRE_FALSE(scatter.Scatter(empty, vertices, ringStarts, buffer));
+			REQUIRE(scatter.GetError() == "Forest has no trees to plant");
+		}
+	}
+
+	TEST_CASE("forest scatter throughput", "[xplane][forest][performance]")
+	{
+		For forest;
+		REQUIRE(forest.Parse(FOR_SAMPLE));
+		forest.fSpacingX = forest.fSpacingZ = 6.0f;
+
+		/// Airport perimeter: a 7 x 5 km wavy outline around a 4 x 2 km airfield.
+		std::vector<DVec2> vertices;
+		for (int i = 0; i < 1024; ++i)
+		{
+			const double angle = i * 2.0 * 3.14159265358979 / 1024.0;
+			const double wobble = 1.0 + 0.03 * std::sin(angle * 37.0);
+			vertices.emplace_back(3500.0 * wobble * std::cos(angle), 2500.0 * wobble * std::sin(angle));
+		}
+		const std::vector<uint32_t> ringStarts = {0, static_cast<uint32_t>(vertices.size())};
+		vertices.insert(vertices.end(), {DVec2(-2000.0, -1000.0), DVec2(2000.0, -1000.0), DVec2(2000.0, 1000.0), DVec2(-2000.0, 1000.0)});
+
+		ForestScatterOptions options;
+		options.parallel = false;
+		ForestScatter scatter;
+		ForestInstanceBuffer serial;
+		REQUIRE(scatter.Scatter(forest, vertices, ringStarts, serial, options));
+		const ForestScatterStats serialStats = scatter.GetStats();
+
+		options.parallel = true;
+		ForestInstanceBuffer parallel;
+		REQUIRE(scatter.Scatter(forest, vertices, ringStarts, parallel, options));
+		const ForestScatterStats &parallelStats = scatter.GetStats();
+		REQUIRE(SameInstances(serial, parallel));
+
+		INFO("Trees: " << serialStats.instances << " from " << serialStats.samples << " samples, " << serialStats.tiles << " tiles (" << serialStats.clippedTiles << " clipped)");
+		INFO("Instance buffer: " << serial.instances.size() * sizeof(ForestInstance) / 1048576.0 << " MiB");
+		INFO("Serial: " << serialStats.totalMs << " ms, " << serialStats.instances / serialStats.totalMs / 1000.0 << " M trees/s");
+		INFO("Parallel: " << parallelStats.totalMs << " ms, " << parallelStats.instances / parallelStats.totalMs / 1000.0 << " M trees/s (" << ThreadPool::Get().GetWorkerCount() << " workers)");
+		REQUIRE(serialStats.instances > 500000);
+		REQUIRE(serialStats.totalMs > 0.0);
+		CHECK(parallelStats.instances == serialStats.instances);
+	}
+
+}
+
+/// -------------------------------------------------------
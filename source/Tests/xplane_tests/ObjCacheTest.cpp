@@ -0,0 +1,386 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* ObjCacheTest.cpp
+* -------------------------------------------------------
+* OBJ8 parsing, compiled cache tests and benchmarks
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <X-PlaneSceneryLibrary/XPObjCache.h>
+
+/// -------------------------------------------------------
+
+using namespace XPAsset;
+
+namespace SceneryEditorX::Tests
+{
+	/// One object using every command family the loader models.
+	const char *const OBJ_SAMPLE =
+		"I\r\n"
+		"800\r\n"
+		"OBJ\r\n"
+		"\r\n"
+		"TEXTURE   textures/hangar.png\r\n"
+		"TEXTURE_LIT textures/hangar_LIT.png\r\n"
+		"TEXTURE_NORMAL 2.0 textures/hangar_NML.png\r\n"
+		"TEXTURE_DRAPED textures/apron.png\r\n"
+		"TEXTURE_DRAPED_NORMAL 4.0 textures/apron_NML.png\r\n"
+		"GLOBAL_specular 1.0\r\n"
+		"POINT_COUNTS 4 2 1 8\r\n"
+		"# vertices\r\n"
+		"VT 0 0 0 0 1 0 0 0\r\n"
+		"VT 10 0 0 0 1 0 1 0\r\n"
+		"VT 10 2.5 -10 0 1 0 1 1\r\n"
+		"VT 0 -1e-3 -10 0 1 0 0 +1\r\n"
+		"VLINE 0 1 0 1 0.5 0\r\n"
+		"VLINE 10 1 0 1 0.5 0\r\n"
+		"VLIGHT 5 3 -5 1 1 1\r\n"
+		"IDX10 0 1 2 0 2 3 0 1 0 0\r\n"
+		"IDX 0\r\n"
+		"IDX 1\r\n"
+		"ATTR_LOD 0 1000\r\n"
+		"ATTR_layer_group_draped taxiways 1\r\n"
+		"ATTR_draped\r\n"
+		"TRIS 0 3\r\n"
+		"ATTR_no_draped\r\n"
+		"ATTR_hard concrete\r\n"
+		"ATTR_manip_drag_axis hand 0 0 1 0 1 sim/door Open door\r\n"
+		"ANIM_begin\r\n"
+		"ANIM_trans 0 0 0 0 2 0 0 1 sim/door\r\n"
+		"ANIM_rotate 0 1 0 0 90 0 1 sim/door\r\n"
+		"ANIM_trans_begin sim/flap\r\n"
+		"ANIM_trans_key 0 0 0 0\r\n"
+		"ANIM_trans_key 0.5 0 1 0\r\n"
+		"ANIM_trans_key 1 0 1 3\r\n"
+		"ANIM_keyframe_loop 1\r\n"
+		"ANIM_trans_end\r\n"
+		"ANIM_rotate_begin 1 0 0 sim/beacon\r\n"
+		"ANIM_rotate_key 0 0\r\n"
+		"ANIM_rotate_key 360 360\r\n"
+		"ANIM_rotate_end\r\n"
+		"ANIM_hide 0 0.5 sim/door\r\n"
+		"ANIM_show 0.5 1 sim/door\r\n"
+		"TRIS 3 3\r\n"
+		"LIGHT_NAMED airplane_beacon 5 5 -5\r\n"
+		"ANIM_end\r\n"
+		"ATTR_LOD 1000 5000\r\n"
+		"ATTR_layer_group objects 2\r\n"
+		"TRIS 0 6\r\n"
+		"LINES 6 2\r\n"
+		"LIGHTS 0 1\r\n"
+		"LIGHT_PARAM taxi_sign 1 2 3 0.5 1\r\n"
+		"LIGHT_CUSTOM 0 1 2 1 1 0.5 1 0.3 0 0 1 1 sim/light\r\n"
+		"LIGHT_SPILL_CUSTOM 0 1 2 1 1 1 0.4 20 0 0 -1 0.9 none\r\n"
+		"SMOKE_BLACK 0 10 0 2\r\n";
+
+	std::filesystem::path WriteObj(const std::filesystem::path &path, const std::string &text)
+	{
+		std::filesystem::create_directories(path.parent_path());
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream << text;
+		return path;
+	}
+
+	/// Small deterministic building: a grid of quads under two LODs with a spinning part. About 8 KiB.
+	std::string MakeSyntheticObj(const uint32_t seed)
+	{
+		constexpr int grid = 6;
+		std::string text = "I\n800\nOBJ\n\nTEXTURE building.png\nTEXTURE_LIT building_LIT.png\n";
+		text += "POINT_COUNTS " + std::to_string(grid * grid * 4) + " 0 0 " + std::to_string(grid * grid * 6) + "\n";
+		for (int quad = 0; quad < grid * grid; ++quad)
+		{
+			const float x = static_cast<float>(quad % grid) + static_cast<float>(seed) * 0.001f;
+			const float z = static_cast<float>(quad / grid);
+			for (int corner = 0; corner < 4; ++corner)
+			{
+				const float dx = corner == 1 || corner == 2 ? 1.0f : 0.0f;
+				const float dz = corner >= 2 ? 1.0f : 0.0f;
+				text += "VT " + std::to_string(x + dx) + " 3.25 " + std::to_string(-(z + dz)) + " 0 1 0 " + std::to_string(dx * 0.5f) + " " + std::to_string(dz * 0.5f) + "\n";
+			}
+		}
+		std::vector<int> indices;
+		for (int quad = 0; quad < grid * grid; ++quad)
+		{
+			const int base = quad * 4;
+			indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+		}
+		size_t next = 0;
+		for (; next + 10 <= indices.size(); next += 10)
+		{
+			text += "IDX10";
+			for (size_t i = next; i < next + 10; ++i)
+				text += " " + std::to_string(indices[i]);
+			text += "\n";
+		}
+		for (; next < indices.size(); ++next)
+			text += "IDX " + std::to_string(indices[next]) + "\n";
+		text += "ATTR_LOD 0 2000\nATTR_hard\nTRIS 0 " + std::to_string(grid * grid * 3) + "\n";
+		text += "ANIM_begin\nANIM_rotate_begin 0 1 0 sim/time/total_running_time_sec\nANIM_rotate_key 0 0\nANIM_rotate_key 10 360\nANIM_keyframe_loop 10\nANIM_rotate_end\n";
+		text += "TRIS " + std::to_string(grid * grid * 3) + " " + std::to_string(grid * grid * 3) + "\nANIM_end\n";
+		text += "ATTR_LOD 2000 10000\nTRIS 0 " + std::to_string(grid * grid * 6) + "\nLIGHT_NAMED airplane_beacon 0 10 0\n";
+		return text;
+	}
+
+	/// -------------------------------------------------------
+
+	TEST_CASE("obj8 command coverage", "[xplane][obj]")
+	{
+		Obj obj;
+		REQUIRE(obj.Parse(OBJ_SAMPLE));
+
+		CHECK(obj.pBaseTex == "textures/hangar.png");
+		CHECK(obj.pLitTex == "textures/hangar_LIT.png");
+		CHECK(obj.bHasNormalTex);
+		CHECK(obj.dblNormalScale == Catch::Approx(2.0));
+		CHECK(obj.pDrapedNormalTex == "textures/apron_NML.png");
+		CHECK(obj.dblDrapedNormalScale == Catch::Approx(4.0));
+		CHECK_FALSE(obj.bHasMaterialTex);
+
+		/// Vertices keep their real Y.
+		REQUIRE(obj.Vertices.size() == 4);
+		CHECK(obj.Vertices[2].Y == Catch::Approx(2.5f));
+		CHECK(obj.Vertices[3].Y == Catch::Approx(-1e-3f));
+		CHECK(obj.Vertices[3].V == Catch::Approx(1.0f));
+		CHECK(obj.LineVertices.size() == 2);
+		CHECK(obj.LightVertices.size() == 1);
+		CHECK(obj.Indices.size() == 12);
+
+		/// Draw calls carry the draped state, layer group and LOD.
+		REQUIRE(obj.DrawCalls.size() == 3);
+		CHECK(obj.DrawCalls[0].bDraped);
+		CHECK(obj.DrawCalls[0].intLayerGroup == XPLayerGroups::TAXIWAYS + 1);
+		CHECK(obj.DrawCalls[0].idxEnd == 3);
+		CHECK_FALSE(obj.DrawCalls[1].bDraped);
+		CHECK(obj.DrawCalls[1].intLod == 0);
+		CHECK(obj.DrawCalls[2].intLod == 1);
+		CHECK(obj.DrawCalls[2].intLayerGroup == XPLayerGroups::OBJECTS + 2);
+		CHECK(obj.intLayerGroup == XPLayerGroups::OBJECTS + 2);
+
+		/// Animations: two key forms, keyframe tables with a loop, hide and show.
+		REQUIRE(obj.Animations.size() == 6);
+		CHECK(obj.Animations[0].Type == ObjAnimationType::Translate);
+		CHECK(obj.AnimKeys[obj.Animations[0].intKeyStart + 1].Y == Catch::Approx(2.0f));
+		CHECK(obj.Animations[1].Type == ObjAnimationType::Rotate);
+		CHECK(obj.Animations[1].Axis[1] == Catch::Approx(1.0f));
+		CHECK(obj.AnimKeys[obj.Animations[1].intKeyStart + 1].X == Catch::Approx(90.0f));
+		CHECK(obj.Animations[2].intKeyCount == 3);
+		CHECK(obj.Animations[2].fLoop == Catch::Approx(1.0f));
+		CHECK(obj.GetString(obj.Animations[2].intDataref) == "sim/flap");
+		CHECK(obj.AnimKeys[obj.Animations[2].intKeyStart + 2].Z == Catch::Approx(3.0f));
+		CHECK(obj.Animations[3].Axis[0] == Catch::Approx(1.0f));
+		CHECK(obj.Animations[4].Type == ObjAnimationType::Hide);
+		CHECK(obj.Animations[5].Type == ObjAnimationType::Show);
+		CHECK(obj.AnimKeys[obj.Animations[5].intKeyStart].Value == Catch::Approx(0.5f));
+
+		/// Datarefs are shared.
+		CHECK(obj.Animations[0].intDataref == obj.Animations[4].intDataref);
+
+		/// Lights.
+		REQUIRE(obj.Lights.size() == 4);
+		CHECK(obj.Lights[0].Type == ObjLightType::Named);
+		CHECK(obj.GetString(obj.Lights[0].intName) == "airplane_beacon");
+		CHECK(obj.Lights[1].Type == ObjLightType::Param);
+		CHECK(obj.GetString(obj.Lights[1].intParams) == "0.5 1");
+		CHECK(obj.Lights[2].Type == ObjLightType::Custom);
+		CHECK(obj.Lights[2].Values[8] == Catch::Approx(1.0f));
+		CHECK(obj.GetString(obj.Lights[2].intName) == "sim/light");
+		CHECK(obj.Lights[3].Type == ObjLightType::SpillCustom);
+		CHECK(obj.Lights[3].Values[4] == Catch::Approx(20.0f));
+
+		/// LODs split the command stream.
+		REQUIRE(obj.Lods.size() == 2);
+		CHECK(obj.Lods[1].fNear == Catch::Approx(1000.0f));
+		CHECK(obj.Lods[0].intCommandStart + obj.Lods[0].intCommandCount == obj.Lods[1].intCommandStart);
+		CHECK(obj.Lods[1].intCommandStart + obj.Lods[1].intCommandCount == obj.Commands.size());
+		CHECK(obj.Commands[obj.Lods[1].intCommandStart].Type == ObjCommandType::Lod);
+
+		/// Everything else stays in the stream with its arguments.
+		bool foundManip = false;
+		bool foundSmoke = false;
+		bool foundGlobal = false;
+		for (const auto &command : obj.Commands)
+		{
+			if (command.Type != ObjCommandType::Attribute)
+				continue;
+			const std::string_view name = obj.GetString(command.A);
+			if (name == "ATTR_manip_drag_axis")
+			{
+				foundManip = true;
+				CHECK(obj.GetString(command.B) == "hand 0 0 1 0 1 sim/door Open door");
+				CHECK(command.intNumbers == 5);
+			}
+			foundSmoke |= name == "SMOKE_BLACK" && command.intNumbers == 4 && command.F[3] == Catch::Approx(2.0f);
+			foundGlobal |= name == "GLOBAL_specular";
+		}
+		CHECK(foundManip);
+		CHECK(foundSmoke);
+		CHECK(foundGlobal);
+	}
+
+	TEST_CASE("obj8 rejects malformed files", "[xplane][obj]")
+	{
+		Obj obj;
+		CHECK_FALSE(obj.Parse("A\n700\nOBJ\n"));
+		CHECK_FALSE(obj.Parse("I\n800\n"));
+		CHECK_FALSE(obj.Parse("I\n800\nOBJ\nVT 0 0 0 0 1 0 0\n"));
+		CHECK_FALSE(obj.Parse("I\n800\nOBJ\nVT 0 0 0 0 1 0 0 0\nIDX 0\nIDX 0\nIDX 0\nTRIS 0 4\n"));
+		CHECK_FALSE(obj.Parse("I\n800\nOBJ\nVT 0 0 0 0 1 0 0 0\nIDX 0\nIDX 0\nIDX 1\nTRIS 0 3\n"));
+		CHECK_FALSE(obj.Parse("I\n800\nOBJ\nANIM_trans_key 0 0 0 0\n"));
+		CHECK(obj.Parse("I\n800\nOBJ\nVT 0 0 0 0 1 0 0 0\nIDX 0\nIDX 0\nIDX 0\nTRIS 0 3\n"));
+		CHECK(obj.Vertices.size() == 1);
+
+		/// Load() only takes .obj files.
+		const std::filesystem::path path = WriteObj(std::filesystem::temp_directory_path() / "sedx_obj_test" / "sample.txt", OBJ_SAMPLE);
+		CHECK_FALSE(obj.Load(path));
+		std::filesystem::remove_all(path.parent_path());
+	}
+
+	TEST_CASE("objc cache round trip", "[xplane][obj]")
+	{
+		const std::filesystem::path root = std::filesystem::temp_directory_path() / "sedx_objc_test";
+		std::filesystem::remove_all(root);
+		const std::filesystem::path path = WriteObj(root / "hangar.obj", OBJ_SAMPLE);
+
+		Obj text;
+		REQUIRE(text.Load(path));
+
+		ObjCache cache(root / "Cache" / "objc");
+		Obj first;
+		REQUIRE(cache.Load(path, first));
+		CHECK(cache.GetStats().intMisses == 1);
+		CHECK(cache.GetStats().intWriteFailures == 0);
+
+		Obj cached;
+		REQUIRE(cache.Load(path, cached));
+		CHECK(cache.GetStats().intHits == 1);
+		CHECK(cached.pReal == path);
+
+		/// The entry reproduces every table byte for byte.
+		const auto sameBytes = [](const auto &a, const auto &b) { return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(a[0])) == 0); };
+		CHECK(sameBytes(cached.Vertices, text.Vertices));
+		CHECK(sameBytes(cached.LineVertices, text.LineVertices));
+		CHECK(sameBytes(cached.LightVertices, text.LightVertices));
+		CHECK(sameBytes(cached.Indices, text.Indices));
+		CHECK(sameBytes(cached.DrawCalls, text.DrawCalls));
+		CHECK(sameBytes(cached.Commands, text.Commands));
+		CHECK(sameBytes(cached.Animations, text.Animations));
+		CHECK(sameBytes(cached.AnimKeys, text.AnimKeys));
+		CHECK(sameBytes(cached.Lights, text.Lights));
+		CHECK(sameBytes(cached.Lods, text.Lods));
+		CHECK(cached.Strings == text.Strings);
+		CHECK(cached.pBaseTex == text.pBaseTex);
+		CHECK(cached.pLitTex == text.pLitTex);
+		CHECK(cached.pDrapedNormalTex == text.pDrapedNormalTex);
+		CHECK(cached.bHasDrapedBaseTex);
+		CHECK_FALSE(cached.bHasMaterialTex);
+		CHECK(cached.dblNormalScale == Catch::Approx(2.0));
+		CHECK(cached.intLayerGroup == text.intLayerGroup);
+
+		/// Editing the obj changes its key, so the stale entry is never read.
+		std::string edited = OBJ_SAMPLE;
+		edited.replace(edited.find("VT 10 2.5"), 9, "VT 10 7.5");
+		WriteObj(path, edited);
+		Obj changed;
+		REQUIRE(cache.Load(path, changed));
+		CHECK(cache.GetStats().intMisses == 2);
+		CHECK(changed.Vertices[2].Y == Catch::Approx(7.5f));
+
+		/// A damaged entry is rejected and rewritten.
+		const uint64_t hash = ObjCache::Hash(edited);
+		const std::filesystem::path entry = cache.GetEntryPath(hash);
+		REQUIRE(std::filesystem::exists(entry));
+		std::filesystem::resize_file(entry, std::filesystem::file_size(entry) / 2);
+		Obj damaged;
+		CHECK_FALSE(ObjCache::Read(entry, damaged, hash, edited.size()));
+		CHECK(damaged.Vertices.empty());
+		REQUIRE(cache.Load(path, damaged));
+		CHECK(cache.GetStats().intMisses == 3);
+		CHECK(ObjCache::Read(entry, damaged, hash, edited.size()));
+
+		/// Entries for other sources are rejected.
+		CHECK_FALSE(ObjCache::Read(entry, damaged, hash + 1, edited.size()));
+
+		std::filesystem::remove_all(root);
+	}
+
+	TEST_CASE("objc cold parse and warm cache load", "[xplane][obj][performance]")
+	{
+		using Clock = std::chrono::high_resolution_clock;
+		const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+		/// A project referencing 5000 distinct objects.
+		constexpr uint32_t objectCount = 5000;
+		const std::filesystem::path root = std::filesystem::temp_directory_path() / "sedx_objc_bench";
+		std::filesystem::remove_all(root);
+		std::vector<std::filesystem::path> paths;
+		paths.reserve(objectCount);
+		size_t textBytes = 0;
+		for (uint32_t i = 0; i < objectCount; ++i)
+		{
+			const std::string text = MakeSyntheticObj(i);
+			textBytes += text.size();
+			paths.push_back(WriteObj(root / "objects" / ("building_" + std::to_string(i) + ".obj"), text));
+		}
+
+		/// Cold: parse every object from text.
+		size_t coldVertices = 0;
+		auto start = Clock::now();
+		for (const auto &path : paths)
+		{
+			Obj obj;
+			REQUIRE(obj.Load(path));
+			coldVertices += obj.Vertices.size();
+		}
+		const double coldMs = ms(start);
+
+		/// First project open: parse and compile.
+		ObjCache compile(root / "Cache" / "objc");
+		start = Clock::now();
+		for (const auto &path : paths)
+		{
+			Obj obj;
+			REQUIRE(compile.Load(path, obj));
+		}
+		const double compileMs = ms(start);
+		REQUIRE(compile.GetStats().intMisses == objectCount);
+		REQUIRE(compile.GetStats().intWriteFailures == 0);
+
+		/// Re-open: every object comes from its entry.
+		ObjCache warm(root / "Cache" / "objc");
+		size_t warmVertices = 0;
+		start = Clock::now();
+		for (const auto &path : paths)
+		{
+			Obj obj;
+			REQUIRE(warm.Load(path, obj));
+			warmVertices += obj.Vertices.size();
+		}
+		const double warmMs = ms(start);
+
+		const ObjCacheStats &stats = warm.GetStats();
+		INFO("Objects: " << objectCount << ", text: " << textBytes / 1048576.0 << " MiB");
+		INFO("Cold text parse: " << coldMs << " ms, compile: " << compileMs << " ms (write " << compile.GetStats().dblWriteMs << " ms)");
+		INFO("Warm cache load: " << warmMs << " ms (hash " << stats.dblHashMs << " ms, read " << stats.dblReadMs << " ms)");
+		CHECK(stats.intHits == objectCount);
+		CHECK(stats.intMisses == 0);
+		CHECK(stats.dblParseMs == 0.0);
+		CHECK(warmVertices == coldVertices);
+
+		std::filesystem::remove_all(root);
+	}
+
+}
+
+/// -------------------------------------------------------
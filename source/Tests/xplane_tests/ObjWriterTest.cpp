@@ -0,0 +1,448 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* ObjWriterTest.cpp
+* -------------------------------------------------------
+* OBJ8 export, round trips through the loader and benchmarks
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <SceneryEditorX/asset/xplane/obj_writer.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+#include <X-PlaneSceneryLibrary/XPObj.h>
+
+/// -------------------------------------------------------
+
+using namespace XPAsset;
+
+namespace SceneryEditorX::Tests
+{
+	/// Hand written object in a loose layout: extra spaces, CRLF, comments and long float forms.
+	const char *const OBJ_EXPORT_SAMPLE =
+		"I\r\n"
+		"800\r\n"
+		"OBJ\r\n"
+		"\r\n"
+		"TEXTURE   hangar.png\r\n"
+		"TEXTURE_LIT hangar_LIT.png\r\n"
+		"TEXTURE_NORMAL 2.0 hangar_NML.png\r\n"
+		"GLOBAL_specular 1.0\r\n"
+		"POINT_COUNTS 4 2 1 14\r\n"
+		"VT 0.000 0 0 0 1 0 0 0\r\n"
+		"VT 10 0 0 0 1 0 1 0   # trailing comment\r\n"
+		"VT 10 2.5 -10 0 1 0 1 1\r\n"
+		"VT 0 -1e-3 -10 0.1 0.99 0 0.333333333 +1\r\n"
+		"VLINE 0 1 0 1 0.5 0\r\n"
+		"VLINE 10 1 0 1 0.5 0\r\n"
+		"VLIGHT 5 3 -5 1 1 1\r\n"
+		"IDX10 0 1 2 0 2 3 0 1 0 0\r\n"
+		"IDX 0\r\n"
+		"IDX 1\r\n"
+		"IDX 2\r\n"
+		"IDX 3\r\n"
+		"ATTR_LOD 0 1000.0\r\n"
+		"ATTR_draped\r\n"
+		"TRIS 0 3\r\n"
+		"ATTR_no_draped\r\n"
+		"ATTR_hard   concrete\r\n"
+		"ANIM_begin\r\n"
+		"ANIM_trans 0 0 0 0 2 0 0 1 sim/door\r\n"
+		"ANIM_rotate 0 1 0 0 90 0 1 sim/door\r\n"
+		"ANIM_trans_begin sim/flap\r\n"
+		"ANIM_trans_key 0 0 0 0\r\n"
+		"ANIM_trans_key 0.5 0 1 0\r\n"
+		"ANIM_trans_key 1 0 1 3\r\n"
+		"ANIM_keyframe_loop 1\r\n"
+		"ANIM_trans_end\r\n"
+		"ANIM_hide 0 0.5 sim/door\r\n"
+		"TRIS 3 3\r\n"
+		"LIGHT_NAMED airplane_beacon 5 5 -5\r\n"
+		"ANIM_end\r\n"
+		"ATTR_LOD 1000 5000\r\n"
+		"TRIS 0 6\r\n"
+		"LINES 6 2\r\n"
+		"LIGHTS 0 1\r\n"
+		"LIGHT_PARAM taxi_sign 1 2 3 0.5 1\r\n"
+		"LIGHT_CUSTOM 0 1 2 1 1 0.5 1 0.3 0 0 1 1 sim/light\r\n"
+		"SMOKE_BLACK 0 10 0 2\r\n";
+
+	/// Two triangles in LOD 1 and, listed after them, two draped triangles in LOD 0. Vertex 4 repeats vertex 0.
+	ObjExportMesh MakeExportQuad()
+	{
+		ObjExportMesh mesh;
+		const float corners[5][4] = {{0, 0, 0, 0}, {1, 0, 1, 0}, {1, -1, 1, 1}, {0, -1, 0, 1}, {0, 0, 0, 0}};
+		for (const auto &corner : corners)
+		{
+			ObjExportVertex &vertex = mesh.vertices.emplace_back();
+			vertex.position = Vec3(corner[0], 0.0f, corner[1]);
+			vertex.normal = Vec3(0.0f, 1.0f, 0.0f);
+			vertex.texcoord = Vec2(corner[2], corner[3]);
+		}
+		mesh.indices = {0, 1, 2, 0, 2, 3, 4, 2, 3, 4, 1, 2};
+
+		ObjExportPart &walls = mesh.parts.emplace_back();
+		walls.indexStart = 0;
+		walls.indexCount = 6;
+		walls.lod = 1;
+		walls.attributes = {"ATTR_hard"};
+
+		ObjExportPart &apron = mesh.parts.emplace_back();
+		apron.indexStart = 6;
+		apron.indexCount = 6;
+		apron.lod = 0;
+		apron.draped = true;
+
+		mesh.lods = {{0.0f, 1000.0f}, {1000.0f, 5000.0f}};
+		mesh.texture = "tex.png";
+		mesh.globals = {"GLOBAL_no_shadow"};
+		return mesh;
+	}
+
+	/// Deterministic roof: a grid of quads whose shared corners are stored once per quad, in two LODs.
+	ObjExportMesh MakeExportBuilding(const uint32_t seed, const int grid)
+	{
+		ObjExportMesh mesh;
+		const float offset = static_cast<float>(seed) * 0.37f;
+		for (int quad = 0; quad < grid * grid; ++quad)
+		{
+			const auto base = static_cast<uint32_t>(mesh.vertices.size());
+			for (int corner = 0; corner < 4; ++corner)
+			{
+				const float x = static_cast<float>(quad % grid + (corner == 1 || corner == 2 ? 1 : 0)) * 1.25f + offset;
+				const float z = static_cast<float>(quad / grid + (corner >= 2 ? 1 : 0)) * -1.25f;
+				ObjExportVertex &vertex = mesh.vertices.emplace_back();
+				vertex.position = Vec3(x, std::sin(x) * 0.1f + 3.0f, z);
+				vertex.normal = Vec3(0.0f, 1.0f, 0.0f);
+				vertex.texcoord = Vec2(x / 7.0f, z / 7.0f);
+			}
+			mesh.indices.insert(mesh.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+		}
+
+		const auto half = static_cast<uint32_t>(mesh.indices.size() / 2 / 3 * 3);
+		ObjExportPart &roof = mesh.parts.emplace_back();
+		roof.indexStart = 0;
+		roof.indexCount = half;
+		roof.attributes = {"ATTR_hard concrete"};
+		ObjExportPart &walls = mesh.parts.emplace_back();
+		walls.indexStart = half;
+		walls.indexCount = static_cast<uint32_t>(mesh.indices.size()) - half;
+		walls.attributes = {"ATTR_no_hard", "ATTR_shiny_rat 0.5"};
+		ObjExportPart &distant = mesh.parts.emplace_back();
+		distant.indexStart = 0;
+		distant.indexCount = static_cast<uint32_t>(mesh.indices.size());
+		distant.lod = 1;
+
+		mesh.lods = {{0.0f, 2000.0f}, {2000.0f, 10000.0f}};
+		mesh.texture = "building.png";
+		mesh.litTexture = "building_LIT.png";
+		return mesh;
+	}
+
+	std::string ReadText(const std::filesystem::path &path)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+	}
+
+	/// -------------------------------------------------------
+
+	TEST_CASE("obj8 writer deduplicates and packs a mesh", "[xplane][obj]")
+	{
+		ObjWriter writer;
+		std::string text;
+		REQUIRE(writer.Write(MakeExportQuad(), text));
+
+		/// LOD 0 comes first even though its part was listed second, and its vertices are numbered first.
+		CHECK(text ==
+			"I\n800\nOBJ\n\n"
+			"TEXTURE tex.png\n"
+			"GLOBAL_no_shadow\n"
+			"POINT_COUNTS 4 0 0 12\n"
+			"\n"
+			"VT 0 0 0 0 1 0 0 0\n"
+			"VT 1 0 -1 0 1 0 1 1\n"
+			"VT 0 0 -1 0 1 0 0 1\n"
+			"VT 1 0 0 0 1 0 1 0\n"
+			"\n"
+			"IDX10 0 1 2 0 3 1 0 3 1 0\n"
+			"IDX 1\n"
+			"IDX 2\n"
+			"\n"
+			"ATTR_LOD 0 1000\n"
+			"ATTR_draped\n"
+			"TRIS 0 6\n"
+			"ATTR_LOD 1000 5000\n"
+			"ATTR_no_draped\n"
+			"ATTR_hard\n"
+			"TRIS 6 6\n");
+		CHECK(writer.GetStats().inputVertices == 5);
+		CHECK(writer.GetStats().outputVertices == 4);
+		CHECK(writer.GetStats().triangles == 4);
+		CHECK(writer.GetStats().outputBytes == text.size());
+
+		/// Without deduplication or reordering every vertex is kept in place.
+		ObjWriteOptions options;
+		options.deduplicate = false;
+		options.reorder = false;
+		options.reverseWinding = true;
+		REQUIRE(writer.Write(MakeExportQuad(), text, options));
+		CHECK(text.find("POINT_COUNTS 5 0 0 12\n") != std::string::npos);
+		CHECK(text.find("IDX10 4 3 2 4 2 1 0 2 1 0\nIDX 3\nIDX 2\n") != std::string::npos);
+
+		/// Attributes are repeated only where the list changes.
+		std::string building;
+		REQUIRE(writer.Write(MakeExportBuilding(0, 4), building));
+		CHECK(building.find("ATTR_LOD 0 2000\nATTR_hard concrete\nTRIS 0 48\nATTR_no_hard\nATTR_shiny_rat 0.5\nTRIS 48 48\nATTR_LOD 2000 10000\nTRIS 96 96\n") != std::string::npos);
+		CHECK(writer.GetStats().inputVertices == 64);
+		CHECK(writer.GetStats().outputVertices == 25);
+	}
+
+	TEST_CASE("obj8 writer round trips through the loader", "[xplane][obj]")
+	{
+		const auto sameBytes = [](const auto &a, const auto &b) { return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(a[0])) == 0); };
+		ObjWriter writer;
+
+		SECTION("Exported mesh")
+		{
+			/// Writing the loaded object again reproduces the exported text byte for byte.
+			std::string exported;
+			REQUIRE(writer.Write(MakeExportBuilding(3, 6), exported));
+			Obj obj;
+			REQUIRE(obj.Parse(exported));
+			CHECK(obj.Vertices.size() == writer.GetStats().outputVertices);
+			CHECK(obj.Lods.size() == 2);
+			CHECK(obj.pLitTex == "building_LIT.png");
+
+			std::string written;
+			REQUIRE(writer.Write(obj, written));
+			CHECK(written == exported);
+
+			ObjWriter second;
+			std::string quad;
+			REQUIRE(second.Write(MakeExportQuad(), quad));
+			REQUIRE(obj.Parse(quad));
+			REQUIRE(obj.DrawCalls.size() == 2);
+			CHECK(obj.DrawCalls[0].bDraped);
+			CHECK_FALSE(obj.DrawCalls[1].bDraped);
+			REQUIRE(second.Write(obj, written));
+			CHECK(written == quad);
+		}
+
+		SECTION("Hand written object")
+		{
+			/// The first write normalises the layout, after that the text is a fixed point.
+			Obj source;
+			REQUIRE(source.Parse(OBJ_EXPORT_SAMPLE));
+			std::string first;
+			REQUIRE(writer.Write(source, first));
+			CHECK(first.find("\r") == std::string::npos);
+			CHECK(first.find("TEXTURE_NORMAL 2 hangar_NML.png\n") != std::string::npos);
+			CHECK(first.find("VT 0 -0.001 -10 0.1 0.99 0 0.33333334 1\n") != std::string::npos);
+			CHECK(first.find("ANIM_trans 0 0 0 0 2 0 0 1 sim/door\n") != std::string::npos);
+			CHECK(first.find("ANIM_trans_begin sim/flap\n") != std::string::npos);
+			CHECK(first.find("ANIM_keyframe_loop 1\nANIM_trans_end\n") != std::string::npos);
+			CHECK(first.find("ATTR_hard concrete\n") != std::string::npos);
+			CHECK(first.find("GLOBAL_specular 1.0\nPOINT_COUNTS 4 2 1 14\n") != std::string::npos);
+
+			Obj reloaded;
+			REQUIRE(reloaded.Parse(first));
+			std::string second;
+			REQUIRE(writer.Write(reloaded, second));
+			CHECK(second == first);
+
+			/// Every table survives the trip unchanged.
+			CHECK(sameBytes(reloaded.Vertices, source.Vertices));
+			CHECK(sameBytes(reloaded.LineVertices, source.LineVertices));
+			CHECK(sameBytes(reloaded.LightVertices, source.LightVertices));
+			CHECK(sameBytes(reloaded.Indices, source.Indices));
+			CHECK(sameBytes(reloaded.DrawCalls, source.DrawCalls));
+			CHECK(sameBytes(reloaded.Commands, source.Commands));
+			CHECK(sameBytes(reloaded.Animations, source.Animations));
+			CHECK(sameBytes(reloaded.AnimKeys, source.AnimKeys));
+			CHECK(sameBytes(reloaded.Lights, source.Lights));
+			CHECK(sameBytes(reloaded.Lods, source.Lods));
+			CHECK(reloaded.Strings == source.Strings);
+			CHECK(reloaded.dblNormalScale == source.dblNormalScale);
+			CHECK(reloaded.intLayerGroup == source.intLayerGroup);
+		}
+	}
+
+	TEST_CASE("obj8 writer rejects invalid meshes", "[xplane][obj]")
+	{
+		ObjWriter writer;
+		std::string text;
+		ObjExportMesh mesh = MakeExportQuad();
+
+		SECTION("Index outside the vertex list")
+		{
+			mesh.indices[7] = 5;
+			REQUIRE_FALSE(writer.Write(mesh, text));
+			REQUIRE(writer.GetError() == "index 7 is outside the vertex list");
+		}
+
+		SECTION("Part splits a triangle")
+		{
+			mesh.parts[1].indexCount = 5;
+			REQUIRE_FALSE(writer.Write(mesh, text));
+			REQUIRE(writer.GetError() == "part 1 does not cover whole triangles");
+		}
+
+		SECTION("Part outside the index list")
+		{
+			mesh.parts[1].indexStart = 9;
+			REQUIRE_FALSE(writer.Write(mesh, text));
+			REQUIRE(writer.GetError() == "part 1 is outside the index list");
+		}
+
+		SECTION("Unknown LOD")
+		{
+			mesh.parts[0].lod = 2;
+			REQUIRE_FALSE(writer.Write(mesh, text));
+			REQUIRE(writer.GetError() == "part 0 uses LOD 2 of 2");
+		}
+
+		SECTION("Vertex that is not finite")
+		{
+			mesh.vertices[3].position.y = std::numeric_limits<float>::quiet_NaN();
+			REQUIRE_FALSE(writer.Write(mesh, text));
+			REQUIRE(writer.GetError() == "vertex 3 is not finite");
+		}
+
+		SECTION("Batch job without an object")
+		{
+			std::vector<ObjExportJob> jobs(3);
+			jobs[0].mesh = &mesh;
+			jobs[2].mesh = &mesh;
+			const std::filesystem::path root = std::filesystem::temp_directory_path() / "sedx_obj_writer_test";
+			std::filesystem::create_directories(root);
+			for (size_t i = 0; i < jobs.size(); ++i)
+				jobs[i].path = root / ("part_" + std::to_string(i) + ".obj");
+
+			ObjWriteOptions options;
+			options.parallel = false;
+			REQUIRE_FALSE(writer.WriteBatch(jobs, options));
+			REQUIRE(writer.GetError() == jobs[1].path.string() + ": job needs exactly one of mesh and obj");
+			CHECK(std::filesystem::exists(jobs[0].path));
+			CHECK_FALSE(std::filesystem::exists(jobs[2].path));
+			std::filesystem::remove_all(root);
+		}
+	}
+
+	TEST_CASE("obj8 parallel batch export matches serial export", "[xplane][obj]")
+	{
+		std::vector<ObjExportMesh> meshes;
+		for (uint32_t i = 0; i < 24; ++i)
+			meshes.push_back(MakeExportBuilding(i, 5 + static_cast<int>(i % 4)));
+		Obj loaded;
+		REQUIRE(loaded.Parse(OBJ_EXPORT_SAMPLE));
+
+		const std::filesystem::path root = std::filesystem::temp_directory_path() / "sedx_obj_batch_test";
+		std::filesystem::remove_all(root);
+		std::filesystem::create_directories(root / "serial");
+		std::filesystem::create_directories(root / "parallel");
+
+		const auto makeJobs = [&](const std::filesystem::path &directory)
+		{
+			std::vector<ObjExportJob> jobs;
+			for (size_t i = 0; i < meshes.size(); ++i)
+			{
+				ObjExportJob &job = jobs.emplace_back();
+				job.mesh = &meshes[i];
+				job.path = directory / ("building_" + std::to_string(i) + ".obj");
+			}
+			ObjExportJob &job = jobs.emplace_back();
+			job.obj = &loaded;
+			job.path = directory / "hangar.obj";
+			return jobs;
+		};
+
+		ThreadPool pool(4);
+		ObjWriteOptions serialOptions;
+		serialOptions.parallel = false;
+		ObjWriteOptions parallelOptions;
+		parallelOptions.threadPool = &pool;
+
+		ObjWriter serial;
+		ObjWriter parallel;
+		const std::vector<ObjExportJob> serialJobs = makeJobs(root / "serial");
+		const std::vector<ObjExportJob> parallelJobs = makeJobs(root / "parallel");
+		REQUIRE(serial.WriteBatch(serialJobs, serialOptions));
+		REQUIRE(parallel.WriteBatch(parallelJobs, parallelOptions));
+
+		CHECK(parallel.GetStats().objectCount == serialJobs.size());
+		CHECK(parallel.GetStats().outputBytes == serial.GetStats().outputBytes);
+		CHECK(parallel.GetStats().outputVertices == serial.GetStats().outputVertices);
+		for (size_t i = 0; i < serialJobs.size(); ++i)
+		{
+			const std::string expected = ReadText(serialJobs[i].path);
+			CHECK_FALSE(expected.empty());
+			CHECK(ReadText(parallelJobs[i].path) == expected);
+			CHECK_FALSE(std::filesystem::exists(std::filesystem::path(parallelJobs[i].path) += ".tmp"));
+		}
+
+		std::filesystem::remove_all(root);
+	}
+
+	TEST_CASE("obj8 export throughput", "[xplane][obj][performance]")
+	{
+		using Clock = std::chrono::high_resolution_clock;
+		const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+		/// 200 roofs of 3600 vertices, 961 after deduplication.
+		std::vector<ObjExportMesh> meshes;
+		for (uint32_t i = 0; i < 200; ++i)
+			meshes.push_back(MakeExportBuilding(i, 30));
+
+		ObjWriter writer;
+		std::string text;
+		size_t bytes = 0;
+		uint64_t vertices = 0;
+		auto start = Clock::now();
+		for (const ObjExportMesh &mesh : meshes)
+		{
+			REQUIRE(writer.Write(mesh, text));
+			bytes += text.size();
+			vertices += writer.GetStats().outputVertices;
+		}
+		const double writerMs = ms(start);
+
+		/// Baseline: the same vertex lines through a stream at round-trip precision.
+		size_t streamBytes = 0;
+		start = Clock::now();
+		for (const ObjExportMesh &mesh : meshes)
+		{
+			std::ostringstream stream;
+			stream << std::setprecision(std::numeric_limits<float>::max_digits10);
+			for (const ObjExportVertex &vertex : mesh.vertices)
+			{
+				stream << "VT " << vertex.position.x << ' ' << vertex.position.y << ' ' << vertex.position.z << ' '
+					   << vertex.normal.x << ' ' << vertex.normal.y << ' ' << vertex.normal.z << ' '
+					   << vertex.texcoord.x << ' ' << vertex.texcoord.y << '\n';
+			}
+			streamBytes += stream.str().size();
+		}
+		const double streamMs = ms(start);
+
+		INFO("Objects: " << meshes.size() << ", vertices: " << vertices << ", text: " << bytes / 1048576.0 << " MiB");
+		INFO("Writer: " << writerMs << " ms (" << bytes / 1048576.0 / (writerMs / 1000.0) << " MiB/s)");
+		INFO("Stream vertices only: " << streamMs << " ms (" << streamBytes / 1048576.0 / (streamMs / 1000.0) << " MiB/s)");
+		CHECK(vertices == 200ull * 31 * 31);
+	}
+
+}
+
+/// -------------------------------------------------------
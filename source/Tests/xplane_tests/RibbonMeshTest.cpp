@@ -0,0 +1,533 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* RibbonMeshTest.cpp
+* -------------------------------------------------------
+* Line and road network parsing, ribbon tessellation and benchmarks
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <SceneryEditorX/asset/xplane/ribbon_mesh.h>
+#include <X-PlaneSceneryLibrary/XPLin.h>
+#include <X-PlaneSceneryLibrary/XPNet.h>
+
+/// -------------------------------------------------------
+
+using namespace XPAsset;
+
+namespace SceneryEditorX::Tests
+{
+	/// Taxiway centreline: a 1 m black border under a 0.5 m yellow line, repeating every 16 m, with 1 m caps.
+	const char *const LIN_SAMPLE =
+		"A\r\n"
+		"850\r\n"
+		"LINE_PAINT\r\n"
+		"\r\n"
+		"# Yellow with a black border\r\n"
+		"TEXTURE lines.png\r\n"
+		"TEX_WIDTH 64\r\n"
+		"TEX_HEIGHT 32\r\n"
+		"SCALE 2 16\r\n"
+		"LAYER_GROUP markings 1\r\n"
+		"S_OFFSET 1 0 8 16\r\n"
+		"S_OFFSET 0 16 32 48\r\n"
+		"START_CAP 0 16 32 48 0 2\r\n"
+		"END_CAP 0 16 32 48 2 4\r\n"
+		"MIRROR\r\n";
+
+	/// A 10 m road with a draped 2 m shoulder on the left, a 0.2 m kerb on the right and a coarser far LOD.
+	const char *const NET_SAMPLE =
+		"A\n"
+		"800\n"
+		"ROADS\n"
+		"\n"
+		"TEXTURE 3 road.png\n"
+		"TEXTURE_LIT road_LIT.png\n"
+		"TEXTURE 0 shoulder.png\n"
+		"SCALE 1000\n"
+		"ROAD_TYPE 1 10 25 0 0.5 0.5 0.5\n"
+		"SEGMENT 0 20000 0.0 0.0 0 1.0 0.0 1000\n"
+		"SEGMENT_HARD 0 20000 1.0 0.0 0 1.0 0.2 10 concrete\n"
+		"SEGMENT_DRAPED 1 0 20000 -0.2 0 0.0 500\n"
+		"SEGMENT 20000 40000 0.0 0.0 0 1.0 0.0 500\n"
+		"ROAD_TYPE 7 4 10 1 1 1 1\n"
+		"SEGMENT_DRAPED 1 0 10000 0 0 1 1000\n"
+		"CAR 0 2.5 20 0.1 cars.obj\n";
+
+	RibbonProfile MakeSingleStrip(const float halfWidth, const float repeat)
+	{
+		RibbonProfile profile;
+		profile.strips.push_back({-halfWidth, halfWidth, 0.0f, 0.0f, 0.0f, 1.0f, 0});
+		profile.repeatLength = repeat;
+		return profile;
+	}
+
+	std::vector<TessNode> MakeStraightNodes(const std::vector<DVec2> &points)
+	{
+		std::vector<TessNode> nodes;
+		for (const DVec2 &point : points)
+			nodes.push_back({point, point, false});
+		return nodes;
+	}
+
+	/// Signed area seen from above of every triangle; all positive means all wind counter-clockwise with +Y up.
+	bool AllTrianglesFaceUp(const RibbonMesh &mesh)
+	{
+		for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+		{
+			const Vec3 &a = mesh.vertices[mesh.indices[i]].position;
+			const Vec3 &b = mesh.vertices[mesh.indices[i + 1]].position;
+			const Vec3 &c = mesh.vertices[mesh.indices[i + 2]].position;
+			const float up = (b.z - a.z) * (c.x - a.x) - (b.x - a.x) * (c.z - a.z);
+			if (up <= 0.0f)
+				return false;
+		}
+		return true;
+	}
+
+	bool HasVertex(const RibbonMesh &mesh, const float x, const float z, const float tolerance = 1e-4f)
+	{
+		for (const RibbonVertex &vertex : mesh.vertices)
+		{
+			if (std::abs(vertex.position.x - x) < tolerance && std::abs(vertex.position.z - z) < tolerance)
+				return true;
+		}
+		return false;
+	}
+
+	/// -------------------------------------------------------
+
+	TEST_CASE("line and road network parsers", "[xplane][ribbon]")
+	{
+		SECTION("line")
+		{
+			Lin line;
+			REQUIRE(line.Parse(LIN_SAMPLE));
+			CHECK(line.intVersion == 850);
+			CHECK(line.pBaseTex == "lines.png");
+			CHECK(line.fTexWidth == 64.0f);
+			CHECK(line.GetTexHeight() == 32.0f);
+			CHECK(line.fScaleX == 2.0f);
+			CHECK(line.fScaleY == 16.0f);
+			CHECK(line.bMirror);
+			CHECK(line.intLayerGroup == XPLayerGroups::Resolve("markings", 1));
+			REQUIRE(line.Layers.size() == 2);
+			CHECK(line.Layers[0].intLayer == 1);
+			CHECK(line.Layers[1].fS2 == 48.0f);
+			REQUIRE(line.StartCaps.size() == 1);
+			REQUIRE(line.EndCaps.size() == 1);
+			CHECK(line.EndCaps[0].fT2 == 4.0f);
+
+			const RibbonProfile profile = MakeLineProfile(line);
+			REQUIRE(profile.strips.size() == 2);
+			CHECK(profile.repeatLength == 16.0f);
+			CHECK(profile.strips[0].left == Catch::Approx(-0.25f));
+			CHECK(profile.strips[0].right == Catch::Approx(0.25f));
+			CHECK(profile.strips[0].sRight == Catch::Approx(0.25f));
+			CHECK(profile.strips[0].material == 1);
+			CHECK(profile.strips[1].left == Catch::Approx(-0.5f));
+			CHECK(profile.strips[1].sLeft == Catch::Approx(0.25f));
+			REQUIRE(profile.startCaps.size() == 1);
+			CHECK(profile.startCaps[0].length == Catch::Approx(1.0f));
+			CHECK(profile.endCaps[0].tInner == Catch::Approx(0.0625f));
+			CHECK(profile.endCaps[0].tOuter == Catch::Approx(0.125f));
+		}
+
+		SECTION("road network")
+		{
+			Net network;
+			REQUIRE(network.Parse(NET_SAMPLE));
+			CHECK(network.intVersion == 800);
+			CHECK(network.fScale == 1000.0f);
+			REQUIRE(network.Textures.size() == 2);
+			CHECK(network.Textures[0].intBias == 3);
+			CHECK(network.Textures[0].pLitTex == "road_LIT.png");
+			CHECK(network.Textures[1].pLitTex.empty());
+			CHECK(network.pBaseTex == "road.png");
+			REQUIRE(network.RoadTypes.size() == 2);
+			CHECK(network.FindRoadType(3) == nullptr);
+
+			const NetRoadType *road = network.FindRoadType(1);
+			REQUIRE(road != nullptr);
+			CHECK(road->fWidth == 10.0f);
+			CHECK(road->fLength == 25.0f);
+			REQUIRE(road->Segments.size() == 4);
+			CHECK(road->Segments[1].strSurface == "concrete");
+			CHECK(road->Segments[2].bDraped);
+			CHECK(road->Segments[2].intTexture == 1);
+
+			const RibbonProfile profile = MakeRoadProfile(network, *road);
+			REQUIRE(profile.strips.size() == 3);
+			CHECK(profile.repeatLength == 25.0f);
+			CHECK(profile.strips[0].left == Catch::Approx(-5.0f));
+			CHECK(profile.strips[0].right == Catch::Approx(5.0f));
+			CHECK(profile.strips[0].sRight == Catch::Approx(1.0f));
+			CHECK(profile.strips[1].rightHeight == Catch::Approx(0.2f));
+			CHECK(profile.strips[2].left == Catch::Approx(-7.0f));
+			CHECK(profile.strips[2].material == 1);
+		}
+	}
+
+	TEST_CASE("line and road network parsers reject malformed files", "[xplane][ribbon]")
+	{
+		Lin line;
+		CHECK_FALSE(line.Parse("A\n800\nLINE_PAINT\nS_OFFSET 0 0 8 16\n"));
+		CHECK_FALSE(line.Parse("A\n850\nFOREST\nS_OFFSET 0 0 8 16\n"));
+		CHECK_FALSE(line.Parse("A\n850\nLINE_PAINT\nS_OFFSET 0 0 20 16\n"));
+		CHECK_FALSE(line.Parse("A\n850\nLINE_PAINT\nS_OFFSET 0 0 8\n"));
+		CHECK_FALSE(line.Parse("A\n850\nLINE_PAINT\nSCALE 0 16\nS_OFFSET 0 0 8 16\n"));
+		CHECK_FALSE(line.Parse("A\n850\nLINE_PAINT\nTEXTURE lines.png\n"));
+		CHECK(line.Parse("I\n850\nLINE_PAINT\nS_OFFSET 0 0 8 16\n"));
+
+		Net network;
+		CHECK_FALSE(network.Parse("A\n800\nROADS\nROAD_TYPE 1 10 25 0 1 1 1\n"));
+		CHECK_FALSE(network.Parse("A\n800\nROADS\nTEXTURE 0 road.png\nSEGMENT 0 1000 0 0 0 1 0 1\n"));
+		CHECK_FALSE(network.Parse("A\n800\nROADS\nTEXTURE 0 road.png\nROAD_TYPE 1 10 25 0 1 1 1\nSEGMENT_HARD 0 1000 0 0 0 1 0 1\n"));
+		CHECK_FALSE(network.Parse("A\n800\nROADS\nTEXTURE 0 road.png\nROAD_TYPE 1 10 25 0 1 1 1\nSEGMENT_DRAPED 2 0 1000 0 0 1 1\n"));
+		CHECK_FALSE(network.Parse("A\n800\nROADS\nTEXTURE_LIT lit.png\n"));
+		CHECK_FALSE(network.Parse("A\n800\nROADS\nTEXTURE 0 road.png\n"));
+		CHECK(network.Parse("A\n800\nROADS\nTEXTURE 0 road.png\nROAD_TYPE 1 10 25 0 1 1 1\n"));
+	}
+
+	TEST_CASE("ribbons are mitered with a continuous texture", "[xplane][ribbon]")
+	{
+		SECTION("straight")
+		{
+			/// Heading east, so the right of travel is south (+Z).
+			RibbonTessellator ribbon(MakeSingleStrip(0.5f, 25.0f));
+			ribbon.SetChain(MakeStraightNodes({DVec2(0, 0), DVec2(10, 0), DVec2(20, 0)}), false);
+			const RibbonMesh &mesh = ribbon.GetMesh();
+
+			REQUIRE(mesh.vertices.size() == 8);
+			REQUIRE(mesh.indices.size() == 12);
+			REQUIRE(mesh.batches.size() == 1);
+			CHECK(mesh.batches[0].indexCount == 12);
+			CHECK(AllTrianglesFaceUp(mesh));
+			CHECK(HasVertex(mesh, 0.0f, -0.5f));
+			CHECK(HasVertex(mesh, 20.0f, 0.5f));
+
+			/// The first edge ends and the second starts 10 m along, 0.4 of a repeat.
+			for (const RibbonVertex &vertex : mesh.vertices)
+			{
+				CHECK(vertex.normal.y == Catch::Approx(1.0f));
+				CHECK(vertex.texcoord.y == Catch::Approx(vertex.position.x / 25.0f));
+				CHECK((vertex.texcoord.x == 0.0f) == (vertex.position.z < 0.0f));
+			}
+		}
+
+		SECTION("right angle")
+		{
+			/// East then south is a right turn: the right side is the inside of the corner.
+			RibbonTessellator ribbon(MakeSingleStrip(0.5f, 25.0f));
+			ribbon.SetChain(MakeStraightNodes({DVec2(0, 0), DVec2(10, 0), DVec2(10, 10)}), false);
+			const RibbonMesh &mesh = ribbon.GetMesh();
+
+			REQUIRE(mesh.vertices.size() == 8);
+			CHECK(AllTrianglesFaceUp(mesh));
+			CHECK(HasVertex(mesh, 9.5f, 0.5f));
+			CHECK(HasVertex(mesh, 10.5f, -0.5f));
+			CHECK(HasVertex(mesh, 10.5f, 10.0f));
+			for (const RibbonVertex &vertex : mesh.vertices)
+			{
+				if (vertex.position.z > 9.0f)
+					CHECK(vertex.texcoord.y == Catch::Approx(20.0f / 25.0f));
+			}
+		}
+
+		SECTION("closed ring")
+		{
+			RibbonTessellator ribbon(MakeSingleStrip(0.5f, 40.0f));
+			ribbon.SetChain(MakeStraightNodes({DVec2(0, 0), DVec2(10, 0), DVec2(10, 10), DVec2(0, 10)}), true);
+			const RibbonMesh &mesh = ribbon.GetMesh();
+
+			/// Four edges and no caps, every corner mitered both ways.
+			CHECK(mesh.vertices.size() == 16);
+			CHECK(mesh.indices.size() == 24);
+			CHECK(AllTrianglesFaceUp(mesh));
+			CHECK(HasVertex(mesh, -0.5f, -0.5f));
+			CHECK(HasVertex(mesh, 0.5f, 0.5f));
+		}
+	}
+
+	TEST_CASE("sharp turns are bevelled", "[xplane][ribbon]")
+	{
+		RibbonOptions options;
+		options.miterLimit = 2.0f;
+		RibbonTessellator ribbon(MakeSingleStrip(1.0f, 25.0f), options);
+
+		/// Almost doubling back: a miter would reach tens of metres past the corner.
+		ribbon.SetChain(MakeStraightNodes({DVec2(0, 0), DVec2(20, 0), DVec2(0, 2)}), false);
+		const RibbonMesh &mesh = ribbon.GetMesh();
+
+		/// The second edge adds the outgoing section, sharing its inner vertex, and the wedge triangle.
+		CHECK(mesh.vertices.size() == 9);
+		CHECK(mesh.indices.size() == 15);
+		for (const RibbonVertex &vertex : mesh.vertices)
+		{
+			const float dx = vertex.position.x - 20.0f;
+			const float dz = vertex.position.z;
+			if (std::abs(dx) < 5.0f)
+				CHECK(std::sqrt(dx * dx + dz * dz) <= 2.0f + 1e-4f);
+		}
+		CHECK(HasVertex(mesh, 20.0f, -1.0f));
+	}
+
+	TEST_CASE("line caps and material batches", "[xplane][ribbon]")
+	{
+		Lin line;
+		REQUIRE(line.Parse(LIN_SAMPLE));
+		RibbonTessellator ribbon(MakeLineProfile(line));
+
+		/// The profile is kept in material order: the border (layer 0) is drawn first.
+		REQUIRE(ribbon.GetProfile().strips.size() == 2);
+		CHECK(ribbon.GetProfile().strips[0].material == 0);
+
+		SECTION("open chain")
+		{
+			ribbon.SetChain(MakeStraightNodes({DVec2(0, 0), DVec2(0, -10)}), false);
+			const RibbonMesh &mesh = ribbon.GetMesh();
+			CHECK(ribbon.GetLastUpdate().capsBuilt);
+
+			/// Heading north: the start cap reaches 1 m south of the start, the end cap 1 m north of the end.
+			REQUIRE(mesh.batches.size() == 2);
+			CHECK(mesh.batches[0].material == 0);
+			CHECK(mesh.batches[0].indexCount == 18);
+			CHECK(mesh.batches[1].material == 1);
+			CHECK(mesh.batches[1].indexStart == 18);
+			CHECK(mesh.batches[1].indexCount == 6);
+			CHECK(mesh.vertices.size() == 16);
+			CHECK(AllTrianglesFaceUp(mesh));
+			CHECK(HasVertex(mesh, -0.5f, 1.0f));
+			CHECK(HasVertex(mesh, 0.5f, -11.0f));
+			CHECK(HasVertex(mesh, 0.25f, -10.0f));
+		}
+
+		SECTION("closed chain")
+		{
+			ribbon.SetChain(MakeStraightNodes({DVec2(0, 0), DVec2(10, 0), DVec2(0, 10)}), true);
+			const RibbonMesh &mesh = ribbon.GetMesh();
+			CHECK(mesh.vertices.size() == 24);
+			CHECK(mesh.indices.size() == 36);
+			CHECK(AllTrianglesFaceUp(mesh));
+		}
+	}
+
+	TEST_CASE("road ribbons follow the cross section", "[xplane][ribbon]")
+	{
+		Net network;
+		REQUIRE(network.Parse(NET_SAMPLE));
+		RibbonTessellator ribbon(MakeRoadProfile(network, *network.FindRoadType(1)));
+		ribbon.SetChain(MakeStraightNodes({DVec2(0, 0), DVec2(50, 0)}), false);
+		const RibbonMesh &mesh = ribbon.GetMesh();
+
+		/// Road and kerb on texture 0, the shoulder on texture 1. Heading east the kerb is on the south side.
+		REQUIRE(mesh.batches.size() == 2);
+		CHECK(mesh.batches[0].indexCount == 12);
+		CHECK(mesh.batches[1].indexCount == 6);
+		bool foundKerb = false;
+		for (const RibbonVertex &vertex : mesh.vertices)
+		{
+			if (vertex.position.y > 0.1f)
+			{
+				foundKerb = true;
+				CHECK(vertex.position.z == Catch::Approx(5.0f));
+				CHECK(vertex.normal.z == Catch::Approx(-1.0f));
+			}
+			CHECK(vertex.position.z >= -7.0f - 1e-4f);
+		}
+		CHECK(foundKerb);
+		CHECK(HasVertex(mesh, 50.0f, -7.0f));
+	}
+
+	TEST_CASE("ribbon bezier chains rebuild only around an edit", "[xplane][ribbon]")
+	{
+		Lin line;
+		REQUIRE(line.Parse(LIN_SAMPLE));
+
+		/// A winding taxi route with a handle on every other node.
+		std::vector<TessNode> nodes;
+		for (int i = 0; i < 12; ++i)
+		{
+			const DVec2 position(i * 30.0, (i % 2) * 20.0);
+			nodes.push_back({position, DVec2(position.x + 10.0, position.y - 5.0), i % 2 == 1});
+		}
+		RibbonOptions options;
+		options.tessellation.pixelTolerance = 0.05;
+
+		RibbonTessellator ribbon(MakeLineProfile(line), options);
+		ribbon.SetChain(nodes, false);
+		const size_t builtVertices = ribbon.GetMesh().vertices.size();
+		CHECK(ribbon.GetLastUpdate().edgesFlattened == 11);
+		CHECK(ribbon.GetLastUpdate().edgesBuilt == 11);
+		CHECK(builtVertices > 12 * 4);
+
+		/// Texture coordinates stay continuous where edges meet. The caps' 4 vertices at either end have their own.
+		const auto checkContinuity = [](const RibbonMesh &mesh)
+		{
+			size_t matched = 0;
+			for (size_t a = 4; a + 4 < mesh.vertices.size(); ++a)
+			{
+				for (size_t b = a + 1; b + 4 < mesh.vertices.size(); ++b)
+				{
+					const RibbonVertex &va = mesh.vertices[a];
+					const RibbonVertex &vb = mesh.vertices[b];
+					if (va.texcoord.x != vb.texcoord.x || std::abs(va.position.x - vb.position.x) > 1e-4f || std::abs(va.position.z - vb.position.z) > 1e-4f)
+						continue;
+					const float t = std::abs(va.texcoord.y - vb.texcoord.y);
+					CHECK(std::abs(t - std::round(t)) < 1e-4f);
+					++matched;
+				}
+			}
+			return matched;
+		};
+		CHECK(checkContinuity(ribbon.GetMesh()) >= 10 * 4);
+
+		SECTION("middle node")
+		{
+			TessNode moved = nodes[5];
+			moved.position.y += 7.0;
+			moved.control.y += 7.0;
+			ribbon.MoveNode(5, moved);
+			const RibbonMesh &edited = ribbon.GetMesh();
+			CHECK(ribbon.GetLastUpdate().edgesFlattened == 2);
+			CHECK(ribbon.GetLastUpdate().edgesBuilt == 4);
+			CHECK_FALSE(ribbon.GetLastUpdate().capsBuilt);
+
+			/// Identical to building the edited chain from scratch.
+			nodes[5] = moved;
+			RibbonTessellator fresh(MakeLineProfile(line), options);
+			fresh.SetChain(nodes, false);
+			const RibbonMesh &expected = fresh.GetMesh();
+			REQUIRE(edited.vertices.size() == expected.vertices.size());
+			REQUIRE(edited.indices == expected.indices);
+			for (size_t i = 0; i < edited.vertices.size(); ++i)
+			{
+				CHECK(edited.vertices[i].position.x == expected.vertices[i].position.x);
+				CHECK(edited.vertices[i].position.z == expected.vertices[i].position.z);
+				CHECK(edited.vertices[i].texcoord.y == Catch::Approx(expected.vertices[i].texcoord.y).margin(1e-5));
+			}
+			checkContinuity(edited);
+
+			/// Nothing to do without an edit.
+			ribbon.GetMesh();
+			CHECK(ribbon.GetLastUpdate().edgesFlattened == 0);
+			CHECK(ribbon.GetLastUpdate().edgesBuilt == 0);
+		}
+
+		SECTION("end node")
+		{
+			TessNode moved = nodes[0];
+			moved.position.x -= 5.0;
+			ribbon.MoveNode(0, moved);
+			ribbon.GetMesh();
+			CHECK(ribbon.GetLastUpdate().edgesFlattened == 1);
+			CHECK(ribbon.GetLastUpdate().edgesBuilt == 2);
+			CHECK(ribbon.GetLastUpdate().capsBuilt);
+		}
+
+		SECTION("closed chain wraps around")
+		{
+			ribbon.SetChain(nodes, true);
+			ribbon.GetMesh();
+			CHECK(ribbon.GetLastUpdate().edgesBuilt == 12);
+			ribbon.MoveNode(0, nodes[0]);
+			ribbon.GetMesh();
+			CHECK(ribbon.GetLastUpdate().edgesFlattened == 2);
+			CHECK(ribbon.GetLastUpdate().edgesBuilt == 4);
+			CHECK_FALSE(ribbon.GetLastUpdate().capsBuilt);
+		}
+	}
+
+	TEST_CASE("ribbon tessellation of an airport's lines", "[xplane][ribbon][performance]")
+	{
+		using Clock = std::chrono::high_resolution_clock;
+		const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+		Lin line;
+		REQUIRE(line.Parse(LIN_SAMPLE));
+		const RibbonProfile profile = MakeLineProfile(line);
+
+		/// A large airport: 4000 taxiway lines of 4 to 40 nodes over 4 km, a third of the nodes curved.
+		constexpr uint32_t chainCount = 4000;
+		std::mt19937 random(4321);
+		std::uniform_real_distribution<double> place(0.0, 4000.0);
+		std::uniform_real_distribution<double> step(-40.0, 40.0);
+		std::uniform_int_distribution<int> length(4, 40);
+		std::vector<std::vector<TessNode>> chains(chainCount);
+		size_t nodeCount = 0;
+		for (std::vector<TessNode> &chain : chains)
+		{
+			DVec2 position(place(random), place(random));
+			const int count = length(random);
+			for (int i = 0; i < count; ++i)
+			{
+				position = DVec2(position.x + 20.0 + std::abs(step(random)), position.y + step(random));
+				const bool curved = i % 3 == 1;
+				chain.push_back({position, DVec2(position.x + 8.0, position.y + step(random) * 0.25), curved});
+			}
+			nodeCount += chain.size();
+		}
+
+		RibbonOptions options;
+		options.tessellation.pixelTolerance = 0.25;
+		options.tessellation.unitsPerPixel = 0.1;
+
+		std::vector<RibbonTessellator> ribbons;
+		ribbons.reserve(chainCount);
+		size_t vertexCount = 0;
+		size_t triangleCount = 0;
+		const auto start = Clock::now();
+		for (const std::vector<TessNode> &chain : chains)
+		{
+			RibbonTessellator &ribbon = ribbons.emplace_back(profile, options);
+			ribbon.SetChain(chain, false);
+			const RibbonMesh &mesh = ribbon.GetMesh();
+			vertexCount += mesh.vertices.size();
+			triangleCount += mesh.indices.size() / 3;
+		}
+		const double fullMs = ms(start);
+
+		/// Dragging a node in the middle of a 500 node perimeter line.
+		std::vector<TessNode> perimeter;
+		for (int i = 0; i < 500; ++i)
+		{
+			const double angle = i * 2.0 * 3.14159265358979 / 500.0;
+			const DVec2 position(std::cos(angle) * 1500.0, std::sin(angle) * 1500.0);
+			perimeter.push_back({position, DVec2(position.x - std::sin(angle) * 5.0, position.y + std::cos(angle) * 5.0), true});
+		}
+		RibbonTessellator large(profile, options);
+		large.SetChain(perimeter, true);
+		auto timer = Clock::now();
+		large.GetMesh();
+		const double largeMs = ms(timer);
+		timer = Clock::now();
+		for (int i = 0; i < 100; ++i)
+		{
+			TessNode moved = perimeter[250];
+			moved.position.x += i * 0.05;
+			moved.control.x += i * 0.05;
+			large.MoveNode(250, moved);
+			large.GetMesh();
+		}
+		const double editMs = ms(timer) / 100.0;
+
+		INFO("Chains: " << chainCount << ", nodes: " << nodeCount << ", vertices: " << vertexCount << ", triangles: " << triangleCount);
+		INFO("Full build: " << fullMs << " ms, " << nodeCount / (fullMs / 1000.0) / 1e6 << " M nodes/s, " << triangleCount / (fullMs / 1000.0) / 1e6 << " M triangles/s");
+		INFO("500 node perimeter: full " << largeMs << " ms, one node drag " << editMs << " ms");
+		CHECK(large.GetLastUpdate().edgesBuilt == 4);
+		CHECK(triangleCount > nodeCount * 2);
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,309 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - Unit Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* TerrainHeightTest.cpp
+* -------------------------------------------------------
+* Terrain height queries, tile caching and benchmarks
+* -------------------------------------------------------
+*/
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+#include <Math/includes/geodesy.h>
+#include <SceneryEditorX/asset/xplane/dsf_reader.h>
+#include <SceneryEditorX/asset/xplane/terrain_height.h>
+#include <SceneryEditorX/core/threading/thread_pool.h>
+
+/// -------------------------------------------------------
+
+namespace SceneryEditorX::Tests
+{
+	/// Heights of a raster over one tile, north row first, from @p height(longitude, latitude).
+	template<typename Func>
+	std::vector<float> MakeRaster(const int west, const int south, const uint32_t posts, const Func &height)
+	{
+		std::vector<float> heights(static_cast<size_t>(posts) * posts);
+		for (uint32_t row = 0; row < posts; ++row)
+		{
+			for (uint32_t column = 0; column < posts; ++column)
+				heights[row * posts + column] = static_cast<float>(height(west + column / (posts - 1.0), south + 1.0 - row / (posts - 1.0)));
+		}
+		return heights;
+	}
+
+	TerrainMesh MakeTile(const int west, const int south, const uint32_t posts, const std::vector<float> &heights)
+	{
+		TerrainMesh mesh;
+		BuildTerrainMesh(heights.data(), posts, posts, west, south, west + 1.0, south + 1.0, mesh);
+		return mesh;
+	}
+
+	/// Height of the raster at a position, interpolated over the same two triangles per cell the mesh uses.
+	double ExpectedHeight(const std::vector<float> &heights, const uint32_t posts, const double east, const double north)
+	{
+		const double x = east * (posts - 1.0);
+		const double y = (1.0 - north) * (posts - 1.0);
+		const uint32_t column = std::min(static_cast<uint32_t>(x), posts - 2);
+		const uint32_t row = std::min(static_cast<uint32_t>(y), posts - 2);
+		const double u = x - column;
+		const double t = y - row;
+		const double nw = heights[row * posts + column], ne = heights[row * posts + column + 1];
+		const double sw = heights[(row + 1) * posts + column], se = heights[(row + 1) * posts + column + 1];
+		if (u + t <= 1.0)
+			return nw + u * (ne - nw) + t * (sw - nw);
+		return se + (1.0 - u) * (sw - se) + (1.0 - t) * (ne - se);
+	}
+
+	double Rolling(const double longitude, const double latitude)
+	{
+		return 400.0 + 120.0 * std::sin(longitude * 37.0) * std::cos(latitude * 23.0) + 35.0 * std::sin(longitude * 211.0 + latitude * 173.0);
+	}
+
+	TEST_CASE("terrain heights and normals of a sloping plane", "[xplane][terrain]")
+	{
+		/// 300 m per degree east, -150 m per degree north.
+		const auto plane = [](const double longitude, const double latitude) { return 200.0 + 300.0 * (longitude - 7.0) - 150.0 * (latitude - 46.0); };
+		const std::vector<float> heights = MakeRaster(7, 46, 101, plane);
+
+		TerrainHeightService service;
+		REQUIRE(service.AddTile(7, 46, MakeTile(7, 46, 101, heights)));
+
+		std::mt19937 rng(3);
+		std::uniform_real_distribution<double> offset(0.0, 1.0);
+		for (int i = 0; i < 2000; ++i)
+		{
+			const double longitude = 7.0 + offset(rng), latitude = 46.0 + offset(rng);
+			TerrainSample sample;
+			REQUIRE(service.Sample(latitude, longitude, sample));
+			REQUIRE(sample.hit);
+			REQUIRE(sample.height == Catch::Approx(plane(longitude, latitude)).margin(0.01));
+
+			/// Slope in metres from the ellipsoid's radii of curvature.
+			const double phi = latitude * std::numbers::pi / 180.0;
+			const double w = 1.0 - WGS84::E2 * std::sin(phi) * std::sin(phi);
+			const double east = WGS84::A / std::sqrt(w) * std::cos(phi) * std::numbers::pi / 180.0;
+			const double north = WGS84::A * (1.0 - WGS84::E2) / (w * std::sqrt(w)) * std::numbers::pi / 180.0;
+			const double gx = 300.0 / east, gy = -150.0 / north, length = std::sqrt(gx * gx + gy * gy + 1.0);
+			REQUIRE(sample.normal.x == Catch::Approx(-gx / length).margin(1e-5));
+			REQUIRE(sample.normal.y == Catch::Approx(-gy / length).margin(1e-5));
+			REQUIRE(sample.normal.z == Catch::Approx(1.0 / length).margin(1e-5));
+		}
+	}
+
+	TEST_CASE("terrain heights follow the raster triangulation", "[xplane][terrain]")
+	{
+		constexpr uint32_t posts = 121;
+		const std::vector<float> heights = MakeRaster(-123, 49, posts, Rolling);
+		TerrainHeightService service;
+		REQUIRE(service.AddTile(-123, 49, MakeTile(-123, 49, posts, heights)));
+
+		/// Posts themselves, on the south and west edges too. The north and east edges belong to the next tiles.
+		TerrainSample sample;
+		for (const uint32_t row : {1u, 60u, posts - 1})
+		{
+			for (const uint32_t column : {0u, 7u, posts - 2})
+			{
+				REQUIRE(service.Sample(50.0 - row / (posts - 1.0), -123.0 + column / (posts - 1.0), sample));
+				REQUIRE(sample.height == Catch::Approx(heights[row * posts + column]).margin(1e-3));
+			}
+		}
+
+		std::mt19937 rng(9);
+		std::uniform_real_distribution<double> offset(0.0, 1.0);
+		std::vector<double> latitudes, longitudes;
+		for (int i = 0; i < 20000; ++i)
+		{
+			latitudes.push_back(49.0 + offset(rng));
+			longitudes.push_back(-123.0 + offset(rng));
+		}
+		std::vector<TerrainSample> samples(latitudes.size());
+		service.Sample(latitudes.data(), longitudes.data(), samples.data(), samples.size());
+		for (size_t i = 0; i < samples.size(); ++i)
+		{
+			REQUIRE(samples[i].hit);
+			REQUIRE(samples[i].height == Catch::Approx(ExpectedHeight(heights, posts, longitudes[i] + 123.0, latitudes[i] - 49.0)).margin(0.01));
+			REQUIRE(samples[i].normal.z > 0.0f);
+		}
+		REQUIRE(service.GetStats().misses == 0);
+
+		/// Batch and single queries agree, threaded or not.
+		std::vector<TerrainSample> serial(samples.size());
+		service.Sample(latitudes.data(), longitudes.data(), serial.data(), serial.size(), {.parallel = false});
+		for (size_t i = 0; i < samples.size(); i += 97)
+		{
+			REQUIRE(service.Sample(latitudes[i], longitudes[i], sample));
+			REQUIRE(sample.height == samples[i].height);
+			REQUIRE(serial[i].height == samples[i].height);
+		}
+	}
+
+	TEST_CASE("terrain misses outside the mesh and in voids", "[xplane][terrain]")
+	{
+		std::vector<float> heights = MakeRaster(10, 10, 11, [](double, double) { return 50.0; });
+		heights[5 * 11 + 5] = std::nanf("");
+		TerrainHeightService service;
+		REQUIRE(service.AddTile(10, 10, MakeTile(10, 10, 11, heights)));
+
+		TerrainSample sample;
+		REQUIRE(service.Sample(10.25, 10.25, sample));
+		REQUIRE(sample.height == Catch::Approx(50.0));
+		REQUIRE_FALSE(service.Sample(10.5, 10.5, sample));
+		REQUIRE_FALSE(sample.hit);
+		REQUIRE(std::isnan(sample.height));
+		REQUIRE_FALSE(service.Sample(11.5, 10.5, sample));
+		REQUIRE_FALSE(service.Sample(95.0, 10.5, sample));
+		REQUIRE(service.GetStats().misses == 3);
+
+		/// Longitudes wrap onto the tile.
+		REQUIRE(service.Sample(10.25, 370.25, sample));
+
+		TerrainMesh broken = MakeTile(10, 10, 11, heights);
+		broken.indices.push_back(0);
+		REQUIRE_FALSE(service.AddTile(11, 10, broken));
+		REQUIRE_FALSE(service.GetError().empty());
+		REQUIRE_FALSE(service.AddTile(180, 10, MakeTile(10, 10, 11, heights)));
+	}
+
+	TEST_CASE("terrain primitives unroll strips and fans", "[xplane][terrain]")
+	{
+		/// Five planes: longitude, latitude, elevation and a normal that is ignored.
+		const std::vector<double> coords = {0, 0, 1, 0, 0, 1, 0, 2, 0, 0, 0, 1, 3, 0, 0, 1, 1, 4, 0, 0, 2, 0, 5, 0, 0};
+		DSFPrimitive primitive;
+		primitive.planeCount = 5;
+		primitive.vertexCount = 5;
+		primitive.coords = coords;
+
+		TerrainMesh mesh;
+		primitive.type = DSF::PrimitiveType::TriangleStrip;
+		AppendTerrainPrimitive(primitive, mesh);
+		REQUIRE(mesh.vertices.size() == 5);
+		REQUIRE(mesh.vertices[2].z == 3.0);
+		REQUIRE(mesh.indices == std::vector<uint32_t>{0, 1, 2, 2, 1, 3, 2, 3, 4});
+
+		primitive.type = DSF::PrimitiveType::TriangleFan;
+		AppendTerrainPrimitive(primitive, mesh);
+		REQUIRE(mesh.vertices.size() == 10);
+		REQUIRE(std::vector<uint32_t>(mesh.indices.begin() + 9, mesh.indices.end()) == std::vector<uint32_t>{5, 6, 7, 5, 7, 8, 5, 8, 9});
+
+		primitive.type = DSF::PrimitiveType::Triangles;
+		AppendTerrainPrimitive(primitive, mesh);
+		REQUIRE(mesh.indices.size() == 21);
+	}
+
+	TEST_CASE("terrain tiles load on demand and stay under the memory cap", "[xplane][terrain]")
+	{
+		uint32_t loads = 0;
+		TerrainHeightService service;
+		service.SetTileLoader([&](const int west, const int south, TerrainMesh &out)
+		{
+			++loads;
+			if (south != 40)
+				return false;
+			out = MakeTile(west, south, 65, MakeRaster(west, south, 65, [west](double, double) { return west * 10.0; }));
+			return true;
+		});
+
+		TerrainSample sample;
+		REQUIRE(service.Sample(40.5, 0.5, sample));
+		const size_t tileBytes = service.GetStats().memoryBytes;
+		service.SetMemoryBudget(tileBytes * 5 / 2);
+
+		for (int west = 0; west < 5; ++west)
+		{
+			REQUIRE(service.Sample(40.5, west + 0.5, sample));
+			REQUIRE(sample.height == Catch::Approx(west * 10.0));
+			REQUIRE(service.GetStats().memoryBytes <= service.GetMemoryBudget());
+		}
+		REQUIRE(loads == 5);
+		REQUIRE(service.GetStats().tilesLoaded == 5);
+		REQUIRE(service.GetStats().tilesEvicted == 3);
+		REQUIRE(service.GetStats().residentTiles == 2);
+
+		/// Recently used tiles stay, evicted ones come back through the loader.
+		REQUIRE(service.Sample(40.5, 4.5, sample));
+		REQUIRE(loads == 5);
+		REQUIRE(service.Sample(40.5, 0.5, sample));
+		REQUIRE(loads == 6);
+
+		/// Tiles without terrain are remembered.
+		REQUIRE_FALSE(service.Sample(30.5, 0.5, sample));
+		REQUIRE_FALSE(service.Sample(30.5, 0.5, sample));
+		REQUIRE(loads == 7);
+
+		/// A batch keeps every tile it needs, even past the budget, and trims afterwards.
+		service.SetMemoryBudget(tileBytes);
+		const std::vector<double> latitudes = {40.5, 40.5, 40.5, 40.5};
+		const std::vector<double> longitudes = {0.5, 1.5, 2.5, 3.5};
+		std::vector<TerrainSample> samples(4);
+		service.Sample(latitudes.data(), longitudes.data(), samples.data(), samples.size());
+		for (int i = 0; i < 4; ++i)
+			REQUIRE(samples[i].height == Catch::Approx(i * 10.0));
+		REQUIRE(service.Sample(40.5, 3.5, sample));
+		REQUIRE(service.GetStats().memoryBytes <= tileBytes);
+
+		/// Pinned tiles are never evicted.
+		REQUIRE(service.AddTile(20, 40, MakeTile(20, 40, 65, MakeRaster(20, 40, 65, [](double, double) { return 7.0; }))));
+		service.SetMemoryBudget(0);
+		REQUIRE(service.GetStats().residentTiles == 1);
+		REQUIRE(service.Sample(40.5, 20.5, sample));
+		REQUIRE(sample.height == Catch::Approx(7.0));
+	}
+
+	TEST_CASE("terrain query throughput", "[xplane][terrain][performance]")
+	{
+		using Clock = std::chrono::steady_clock;
+		const auto ms = [](const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+		/// A 3 arc-second DEM tile: 1201 x 1201 posts, 2.9 M triangles.
+		constexpr uint32_t posts = 1201;
+		const std::vector<float> heights = MakeRaster(8, 47, posts, Rolling);
+		auto start = Clock::now();
+		const TerrainMesh mesh = MakeTile(8, 47, posts, heights);
+		const double meshMs = ms(start);
+
+		TerrainHeightService service;
+		start = Clock::now();
+		REQUIRE(service.AddTile(8, 47, mesh));
+		const double indexMs = ms(start);
+
+		/// Objects being dragged: one million positions, each snapped once.
+		constexpr size_t count = 1000000;
+		std::mt19937 rng(21);
+		std::uniform_real_distribution<double> offset(0.0, 1.0);
+		std::vector<double> latitudes(count), longitudes(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			latitudes[i] = 47.0 + offset(rng);
+			longitudes[i] = 8.0 + offset(rng);
+		}
+
+		std::vector<TerrainSample> samples(count);
+		service.Sample(latitudes.data(), longitudes.data(), samples.data(), count, {.parallel = false});
+		const double serialMs = service.GetStats().lastBatchMs;
+		service.Sample(latitudes.data(), longitudes.data(), samples.data(), count);
+		const double parallelMs = service.GetStats().lastBatchMs;
+
+		double worst = 0.0;
+		for (size_t i = 0; i < count; i += 101)
+			worst = std::max(worst, std::abs(samples[i].height - ExpectedHeight(heights, posts, longitudes[i] - 8.0, latitudes[i] - 47.0)));
+
+		INFO("Tile: " << mesh.indices.size() / 3 << " triangles, mesh " << meshMs << " ms, index " << indexMs << " ms, " << service.GetStats().memoryBytes / 1048576.0 << " MiB");
+		INFO("Serial: " << count / serialMs / 1000.0 << " M queries/s");
+		INFO("Parallel: " << count / parallelMs / 1000.0 << " M queries/s (" << ThreadPool::Get().GetWorkerCount() << " workers)");
+		INFO("Worst height error " << worst << " m");
+		REQUIRE(service.GetStats().misses == 0);
+		REQUIRE(worst < 0.01);
+		REQUIRE(serialMs > 0.0);
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,390 @@
+//Module:	XPFac
+//Author:	Connor Russell
+//Date:		10/18/2026
+//Purpose:	Implements XPFac.h
+#include "XPFac.h"
+#include "XPTextLine.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+using namespace XPAsset::Text;
+
+/**
+* @brief Loads the facade
+*
+* @Param InPath = Path to the fac
+* @return True on success, false on failure
+*/
+bool XPAsset::Fac::Load(const std::filesystem::path &InPath)
+{
+    try
+    {
+        ///<make sure the file exists and ends in .fac
+        if (!std::filesystem::exists(InPath) || !EqualsIgnoreCase(InPath.extension().string(), ".fac"))
+            return false;
+
+        std::ifstream FacFile(InPath, std::ios::binary);
+        if (!FacFile.is_open())
+            return false;
+
+        const std::string strText{std::istreambuf_iterator<char>(FacFile), std::istreambuf_iterator<char>()};
+        FacFile.close();
+
+        if (!Parse(strText))
+            return false;
+
+        pReal = InPath;
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool XPAsset::Fac::Parse(const std::string_view InText)
+{
+    Clear();
+
+    try
+    {
+        TextLine Line;
+        size_t intHeaderLine = 0;
+        bool bRoofShader = false;                 ///< TEXTURE lines after SHADER_ROOF belong to the roof
+        FacWall *pWall = nullptr;                 ///< Wall that SCALE, panels and SPELLING apply to
+        FacSegment *pSegment = nullptr;
+        float fMeshNear = 0;                      ///< Near distance of the MESH kept for the current segment
+        bool bKeepMesh = false;
+        uint32_t intMeshBase = 0;
+
+        ///< Type 1 commands before any LOD go to an implicit one
+        const auto CurrentLod = [&]() -> FacLod &
+        {
+            if (Lods.empty())
+                Lods.push_back({0, std::numeric_limits<float>::max(), {}, {}});
+            return Lods.back();
+        };
+
+        const auto ReadPanel = [&](std::vector<FacPanel> &OutPanels)
+        {
+            float fValues[2];
+            if (!pWall || !ReadFloats(Line, 1, 2, fValues))
+                return false;
+            OutPanels.push_back({fValues[0], fValues[1]});
+            return true;
+        };
+
+        size_t intPos = 0;
+        while (NextLine(InText, intPos, Line))
+        {
+            ///< Skip blank lines and comments
+            if (Line.intCount == 0 || Line.Tokens[0].front() == '#')
+                continue;
+
+            const std::string_view strCommand = Line.Tokens[0];
+
+            ///< Header: A or I for the line endings, the version, then FACADE
+            if (intHeaderLine < 3)
+            {
+                if (intHeaderLine == 0 && strCommand != "A" && strCommand != "I")
+                    return false;
+                if (intHeaderLine == 1 && (!ParseUint(strCommand, intVersion) || (intVersion != 800 && intVersion != 1000)))
+                    return false;
+                if (intHeaderLine == 2 && strCommand != "FACADE")
+                    return false;
+                ++intHeaderLine;
+                continue;
+            }
+
+            ///< Segment geometry, by far the most common lines of a type 2 facade
+            if (strCommand == "VERTEX")
+            {
+                ///< Format: VERTEX X Y Z Nx Ny Nz S T
+                float fValues[8];
+                if (!pSegment || !ReadFloats(Line, 1, 8, fValues))
+                    return false;
+                if (bKeepMesh)
+                    pSegment->Vertices.push_back({fValues[0], fValues[1], fValues[2], fValues[3], fValues[4], fValues[5], fValues[6], fValues[7]});
+            }
+            else if (strCommand == "IDX")
+            {
+                ///< Format: IDX i1 i2 ..., any number per line
+                if (!pSegment)
+                    return false;
+                for (size_t i = 1; i < Line.intCount; ++i)
+                {
+                    uint32_t intIndex;
+                    if (!ParseUint(Line.Tokens[i], intIndex))
+                        return false;
+                    if (bKeepMesh)
+                        pSegment->Indices.push_back(intMeshBase + intIndex);
+                }
+            }
+            else if (strCommand == "MESH")
+            {
+                ///< Format: MESH group near far vertex_count index_count. Only the most detailed meshes are kept
+                float fRange[2];
+                if (!pSegment || !ReadFloats(Line, 2, 2, fRange))
+                    return false;
+                const bool bFirst = pSegment->Vertices.empty() && pSegment->Indices.empty() && !bKeepMesh;
+                if (bFirst || fRange[0] < fMeshNear)
+                {
+                    pSegment->Vertices.clear();
+                    pSegment->Indices.clear();
+                    fMeshNear = fRange[0];
+                }
+                bKeepMesh = fRange[0] == fMeshNear;
+                intMeshBase = static_cast<uint32_t>(pSegment->Vertices.size());
+            }
+
+            ///< Textures. SHADER_WALL and SHADER_ROOF switch which one TEXTURE sets
+            else if (strCommand == "SHADER_WALL" || strCommand == "SHADER_ROOF")
+                bRoofShader = strCommand == "SHADER_ROOF";
+            else if (strCommand == "TEXTURE")
+            {
+                (bRoofShader ? pRoofTex : pBaseTex) = std::string(RestOfLine(Line, 1));
+                (bRoofShader ? bHasRoofTex : bHasBaseTex) = Line.intCount > 1;
+            }
+            else if (strCommand == "TEXTURE_NORMAL")
+            {
+                ///< Format: TEXTURE_NORMAL [ratio] Tex
+                float fRatio = 1;
+                const size_t intPathToken = Line.intCount > 2 && ParseFloat(Line.Tokens[1], fRatio) ? 2 : 1;
+                (bRoofShader ? pRoofNormalTex : pNormalTex) = std::string(RestOfLine(Line, intPathToken));
+                (bRoofShader ? bHasRoofNormalTex : bHasNormalTex) = Line.intCount > intPathToken;
+                if (!bRoofShader)
+                    dblNormalScale = fRatio;
+            }
+            else if (strCommand == "TEXTURE_LIT")
+            {
+                pLitTex = std::string(RestOfLine(Line, 1));
+                bHasLitTex = Line.intCount > 1;
+            }
+
+            ///< Whole facade properties
+            else if (strCommand == "RING")
+                bRing = Line.Token(1) != "0";
+            else if (strCommand == "HARD_ROOF")
+                bHardRoof = true;
+            else if (strCommand == "DOUBLED")
+                bDoubled = Line.Token(1) != "0";
+            else if (strCommand == "GRADED")
+                bGraded = true;
+            else if (strCommand == "BASEMENT_DEPTH")
+            {
+                if (!ReadFloats(Line, 1, 1, &fBasementDepth))
+                    return false;
+            }
+            else if (strCommand == "ROOF_SCALE")
+            {
+                ///< Format: ROOF_SCALE s [t]
+                if (!ReadFloats(Line, 1, 1, &fRoofScaleS))
+                    return false;
+                fRoofScaleT = fRoofScaleS;
+                if (Line.intCount > 2 && !ReadFloats(Line, 2, 1, &fRoofScaleT))
+                    return false;
+            }
+            else if (strCommand == "LAYER_GROUP")
+            {
+                ///< Format: LAYER_GROUP group [offset]
+                float fOffset = 0;
+                if (Line.intCount < 2 || (Line.intCount > 2 && !ParseFloat(Line.Tokens[2], fOffset)))
+                    return false;
+                intLayerGroup = XPLayerGroups::Resolve(std::string(Line.Token(1)), static_cast<int>(fOffset));
+            }
+
+            ///< Type 1: LODs with roof coordinates and panel walls
+            else if (strCommand == "LOD")
+            {
+                ///< Format: LOD near far
+                FacLod NewLod;
+                if (!ReadFloats(Line, 1, 1, &NewLod.fNear) || !ReadFloats(Line, 2, 1, &NewLod.fFar))
+                    return false;
+                Lods.push_back(NewLod);
+                pWall = nullptr;
+            }
+            else if (strCommand == "ROOF")
+            {
+                ///< Format: ROOF s t
+                float fValues[2];
+                if (!ReadFloats(Line, 1, 2, fValues))
+                    return false;
+                CurrentLod().RoofCoords.insert(CurrentLod().RoofCoords.end(), {fValues[0], fValues[1]});
+            }
+            else if (strCommand == "WALL")
+            {
+                ///< Format: WALL min_width max_width min_heading max_heading [name]. Type 2 walls belong to the current floor
+                FacWall NewWall;
+                if (!ReadFloats(Line, 1, 1, &NewWall.fMinWidth) || !ReadFloats(Line, 2, 1, &NewWall.fMaxWidth) || !ReadFloats(Line, 3, 1, &NewWall.fMinHeading) ||
+                    !ReadFloats(Line, 4, 1, &NewWall.fMaxHeading))
+                    return false;
+                NewWall.strName = std::string(RestOfLine(Line, 5));
+                std::vector<FacWall> &Walls = bType2 ? Floors.back().Walls : CurrentLod().Walls;
+                Walls.push_back(std::move(NewWall));
+                pWall = &Walls.back();
+            }
+            else if (strCommand == "SCALE")
+            {
+                float fValues[2];
+                if (!pWall || !ReadFloats(Line, 1, 2, fValues))
+                    return false;
+                pWall->fScaleS = fValues[0];
+                pWall->fScaleT = fValues[1];
+            }
+            else if (strCommand == "ROOF_SLOPE")
+            {
+                if (!pWall || !ReadFloats(Line, 1, 1, &pWall->fRoofSlope))
+                    return false;
+            }
+            else if (strCommand == "LEFT" || strCommand == "CENTER" || strCommand == "RIGHT" || strCommand == "BOTTOM" || strCommand == "MIDDLE" || strCommand == "TOP")
+            {
+                if (!pWall)
+                    return false;
+                std::vector<FacPanel> &Panels = strCommand == "LEFT" ? pWall->Left : strCommand == "CENTER" ? pWall->Center : strCommand == "RIGHT" ? pWall->Right
+                                              : strCommand == "BOTTOM" ? pWall->Bottom : strCommand == "MIDDLE" ? pWall->Middle : pWall->Top;
+                if (!ReadPanel(Panels))
+                    return false;
+            }
+
+            ///< Type 2: floors of segments, walls spelled from them, and attached objects
+            else if (strCommand == "FLOOR")
+            {
+                bType2 = true;
+                Floors.emplace_back().strName = std::string(RestOfLine(Line, 1));
+                pWall = nullptr;
+                pSegment = nullptr;
+            }
+            else if (strCommand == "ROOF_HEIGHT")
+            {
+                ///< Format: ROOF_HEIGHT height [...]. Only the height is used
+                float fHeight;
+                if (Floors.empty() || !ReadFloats(Line, 1, 1, &fHeight))
+                    return false;
+                Floors.back().RoofHeights.push_back(fHeight);
+            }
+            else if (strCommand == "SEGMENT" || strCommand == "SEGMENT_CURVED")
+            {
+                ///< Format: SEGMENT index. Segments are numbered in order
+                uint32_t intIndex;
+                if (Floors.empty() || !ParseUint(Line.Token(1), intIndex) || intIndex != Floors.back().Segments.size())
+                    return false;
+                pSegment = &Floors.back().Segments.emplace_back();
+                pSegment->bCurved = strCommand == "SEGMENT_CURVED";
+                bKeepMesh = false;
+                pWall = nullptr;
+            }
+            else if (strCommand == "ATTACH_DRAPED" || strCommand == "ATTACH_GRADED")
+            {
+                ///< Format: ATTACH_DRAPED obj x y z heading [show_lo show_hi]
+                FacAttachment NewAttachment;
+                float fValues[4];
+                if (!pSegment || !ParseUint(Line.Token(1), NewAttachment.intObject) || !ReadFloats(Line, 2, 4, fValues))
+                    return false;
+                NewAttachment.X = fValues[0];
+                NewAttachment.Y = fValues[1];
+                NewAttachment.Z = fValues[2];
+                NewAttachment.fHeading = fValues[3];
+                NewAttachment.bDraped = strCommand == "ATTACH_DRAPED";
+                pSegment->Attachments.push_back(NewAttachment);
+            }
+            else if (strCommand == "OBJ")
+            {
+                if (Line.intCount < 2)
+                    return false;
+                Objects.emplace_back(RestOfLine(Line, 1));
+            }
+            else if (strCommand == "SPELLING")
+            {
+                ///< Format: SPELLING segment segment ...
+                if (!pWall || !bType2 || Line.intCount < 2)
+                    return false;
+                std::vector<uint32_t> &Spelling = pWall->Spellings.emplace_back();
+                for (size_t i = 1; i < Line.intCount; ++i)
+                {
+                    uint32_t intSegment;
+                    if (!ParseUint(Line.Tokens[i], intSegment))
+                        return false;
+                    Spelling.push_back(intSegment);
+                }
+            }
+
+            ///< Anything else (roof objects, wall rules, show levels) does not affect the generated mesh
+        }
+
+        ///< Not a facade
+        if (intHeaderLine < 3)
+            return false;
+
+        ///< Check every reference once, so the mesh generator can trust the tables
+        for (FacFloor &Floor : Floors)
+        {
+            std::ranges::sort(Floor.RoofHeights);
+            for (FacSegment &Segment : Floor.Segments)
+            {
+                if (std::ranges::any_of(Segment.Indices, [&](const uint32_t intIndex) { return intIndex >= Segment.Vertices.size(); }) || Segment.Indices.size() % 3 != 0)
+                    return false;
+                if (std::ranges::any_of(Segment.Attachments, [&](const FacAttachment &Attachment) { return Attachment.intObject >= Objects.size(); }))
+                    return false;
+
+                float fMinX = 0;
+                float fMaxX = 0;
+                for (size_t i = 0; i < Segment.Vertices.size(); ++i)
+                {
+                    fMinX = i == 0 ? Segment.Vertices[i].X : std::min(fMinX, Segment.Vertices[i].X);
+                    fMaxX = i == 0 ? Segment.Vertices[i].X : std::max(fMaxX, Segment.Vertices[i].X);
+                }
+                Segment.fWidth = fMaxX - fMinX;
+            }
+            for (const FacWall &Wall : Floor.Walls)
+            {
+                for (const std::vector<uint32_t> &Spelling : Wall.Spellings)
+                {
+                    if (std::ranges::any_of(Spelling, [&](const uint32_t intSegment) { return intSegment >= Floor.Segments.size(); }))
+                        return false;
+                }
+            }
+        }
+
+        return GetWalls() != nullptr;
+    }
+    catch (...)
+    {
+        ///< Failure
+        return false;
+    }
+}
+
+void XPAsset::Fac::Clear()
+{
+    pReal.clear();
+    pBaseTex.clear();
+    pNormalTex.clear();
+    pMaterialTex.clear();
+    pLitTex.clear();
+    pRoofTex.clear();
+    pRoofNormalTex.clear();
+    bHasBaseTex = bHasNormalTex = bHasMaterialTex = false;
+    bHasLitTex = bHasRoofTex = bHasRoofNormalTex = false;
+    dblNormalScale = 1;
+    intLayerGroup = XPLayerGroups::Resolve("objects", 0);
+
+    intVersion = 0;
+    bType2 = false;
+    bRing = true;
+    bHardRoof = bDoubled = bGraded = false;
+    fBasementDepth = 0;
+    fRoofScaleS = fRoofScaleT = 0;
+
+    Lods.clear();
+    Floors.clear();
+    Objects.clear();
+}
+
+const std::vector<XPAsset::FacWall> *XPAsset::Fac::GetWalls(const size_t InFloor) const
+{
+    if (bType2)
+        return InFloor < Floors.size() && !Floors[InFloor].Walls.empty() ? &Floors[InFloor].Walls : nullptr;
+    return !Lods.empty() && !Lods.front().Walls.empty() ? &Lods.front().Walls : nullptr;
+}
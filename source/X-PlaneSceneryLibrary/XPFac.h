@@ -0,0 +1,153 @@
+//Module:	XPFac
+//Author:	Connor Russell
+//Date:		10/18/2026
+//Purpose:	Facade (.fac) definitions, both the type 1 panel facades and the type 2 segment facades
+
+#pragma once
+#include "XPAsset.h"
+#include "XPObj.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace XPAsset
+{
+    /**
+     * @brief A strip of a type 1 facade texture. Horizontal panels use S, vertical panels use T
+     */
+    struct FacPanel
+    {
+        float fStart{0};
+        float fEnd{0};
+    };
+
+    /**
+     * @brief An object placed by a type 2 segment (ATTACH_DRAPED, ATTACH_GRADED)
+     */
+    struct FacAttachment
+    {
+        uint32_t intObject{0}; //Index into Fac::Objects
+        float X{0};            //Segment space, see FacSegment
+        float Y{0};
+        float Z{0};
+        float fHeading{0};     //Degrees, clockwise from the segment's -Z
+        bool bDraped{true};
+    };
+
+    /**
+     * @brief A type 2 wall piece. Modelled along +X from 0 to its width, Y up, with the front facing -Z
+     */
+    struct FacSegment
+    {
+        std::vector<XPAsset::Vertex> Vertices; //Highest detail MESH only
+        std::vector<uint32_t> Indices;
+        std::vector<XPAsset::FacAttachment> Attachments;
+        float fWidth{0};                       //Extent of the vertices along X
+        bool bCurved{false};                   //SEGMENT_CURVED. Generated like a straight segment
+    };
+
+    /**
+     * @brief A wall choice. The generator picks the first wall whose width and heading ranges contain the edge
+     */
+    struct FacWall
+    {
+        float fMinWidth{0};
+        float fMaxWidth{0};
+        float fMinHeading{0}; //Heading the wall faces, degrees clockwise from -Z
+        float fMaxHeading{360};
+        std::string strName;
+
+        ///< Type 1
+        float fScaleS{1};     //Metres per unit of S
+        float fScaleT{1};     //Metres per unit of T
+        float fRoofSlope{0};
+        std::vector<XPAsset::FacPanel> Left, Center, Right; //Across the wall. Center repeats to fill the length
+        std::vector<XPAsset::FacPanel> Bottom, Middle, Top; //Up the wall. Middle repeats to fill the height
+
+        ///< Type 2. Segment sequences, each a valid way to fill a wall; the best fit for the length is used
+        std::vector<std::vector<uint32_t>> Spellings;
+    };
+
+    /**
+     * @brief One height variant of a type 2 facade
+     */
+    struct FacFloor
+    {
+        std::string strName;
+        std::vector<float> RoofHeights; //ROOF_HEIGHT, lowest first. The highest caps the walls
+        std::vector<XPAsset::FacSegment> Segments;
+        std::vector<XPAsset::FacWall> Walls;
+
+        float GetHeight() const { return RoofHeights.empty() ? 0.0f : RoofHeights.back(); }
+    };
+
+    /**
+     * @brief One LOD of a type 1 facade
+     */
+    struct FacLod
+    {
+        float fNear{0};
+        float fFar{0};
+        std::vector<float> RoofCoords; //ROOF s t pairs, the texture region of the roof
+        std::vector<XPAsset::FacWall> Walls;
+    };
+
+    /**
+     * @brief Represents an X-Plane facade (.fac)
+     */
+	class Fac : public Asset
+	{
+	public:
+	    uint32_t intVersion{0}; //800 or 1000
+	    bool bType2{false};     //Built from FLOOR/SEGMENT meshes rather than texture panels
+	    bool bRing{true};       //Closed footprint. Open facades are fences and walls without roofs
+	    bool bHardRoof{false};
+	    bool bDoubled{false};   //Walls are visible from both sides
+	    bool bGraded{false};    //Walls follow the terrain instead of a flat base
+	    float fBasementDepth{0};
+	    float fRoofScaleS{0};   //Metres per unit of roof texture. 0 maps the roof onto the ROOF coordinates
+	    float fRoofScaleT{0};
+
+	    std::filesystem::path pLitTex;
+	    std::filesystem::path pRoofTex;       //TEXTURE under SHADER_ROOF
+	    std::filesystem::path pRoofNormalTex;
+	    bool bHasLitTex{false};
+	    bool bHasRoofTex{false};
+	    bool bHasRoofNormalTex{false};
+
+	    std::vector<XPAsset::FacLod> Lods;        //Type 1
+	    std::vector<XPAsset::FacFloor> Floors;    //Type 2
+	    std::vector<std::string> Objects;         //OBJ paths used by attachments, relative to the facade
+
+	    /**
+	     * @brief Loads the facade
+		 *
+		 * @param InPath = Path to the fac
+		 * @returns True on success, false on failure
+	     */
+	    bool Load(const std::filesystem::path &InPath);
+
+	    /**
+	     * @brief Parses a facade from text already in memory. Clears any previously loaded data first
+		 *
+		 * @param InText = The contents of a fac file
+		 * @returns True on success, false if the text is not a facade, a command is malformed or an index is out of range
+	     */
+	    bool Parse(std::string_view InText);
+
+	    /**
+	     * @brief Empties every table and resets the flags
+	     */
+	    void Clear();
+
+	    /**
+	     * @brief Walls of the highest detail: the first LOD of a type 1 facade, or a floor of a type 2 one
+	     */
+	    const std::vector<XPAsset::FacWall> *GetWalls(size_t InFloor = 0) const;
+
+    private:
+        void MakeMeVirtual() override {}
+	};
+
+}
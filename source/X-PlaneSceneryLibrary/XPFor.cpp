@@ -0,0 +1,182 @@
+//Module:	XPFor
+//Author:	Connor Russell
+//Date:		10/18/2026
+//Purpose:	Implements XPFor.h
+#include "XPFor.h"
+#include "XPTextLine.h"
+#include <fstream>
+#include <iterator>
+
+using namespace XPAsset::Text;
+
+/**
+* @brief Loads the forest
+*
+* @Param InPath = Path to the for
+* @return True on success, false on failure
+*/
+bool XPAsset::For::Load(const std::filesystem::path &InPath)
+{
+    try
+    {
+        ///<make sure the file exists and ends in .for
+        if (!std::filesystem::exists(InPath) || !EqualsIgnoreCase(InPath.extension().string(), ".for"))
+            return false;
+
+        std::ifstream ForFile(InPath, std::ios::binary);
+        if (!ForFile.is_open())
+            return false;
+
+        const std::string strText{std::istreambuf_iterator<char>(ForFile), std::istreambuf_iterator<char>()};
+        ForFile.close();
+
+        if (!Parse(strText))
+            return false;
+
+        pReal = InPath;
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool XPAsset::For::Parse(const std::string_view InText)
+{
+    Clear();
+
+    try
+    {
+        TextLine Line;
+        size_t intHeaderLine = 0;
+
+        size_t intPos = 0;
+        while (NextLine(InText, intPos, Line))
+        {
+            ///< Skip blank lines and comments
+            if (Line.intCount == 0 || Line.Tokens[0].front() == '#')
+                continue;
+
+            const std::string_view strCommand = Line.Tokens[0];
+
+            ///< Header: A or I for the line endings, the version, then FOREST
+            if (intHeaderLine < 3)
+            {
+                if (intHeaderLine == 0 && strCommand != "A" && strCommand != "I")
+                    return false;
+                if (intHeaderLine == 1 && (!ParseUint(strCommand, intVersion) || intVersion != 800))
+                    return false;
+                if (intHeaderLine == 2 && strCommand != "FOREST")
+                    return false;
+                ++intHeaderLine;
+                continue;
+            }
+
+            if (strCommand == "TREE")
+            {
+                ///< Format: TREE s t w y offset frequency min_h max_h quads [type] [name]
+                float fValues[8];
+                ForTree Tree;
+                if (!ReadFloats(Line, 1, 8, fValues) || !ParseUint(Line.Token(9), Tree.intQuads))
+                    return false;
+                if (Line.intCount > 10 && !ParseUint(Line.Tokens[10], Tree.intLayer))
+                    return false;
+                Tree.fS = fValues[0];
+                Tree.fT = fValues[1];
+                Tree.fWidth = fValues[2];
+                Tree.fHeight = fValues[3];
+                Tree.fOffset = fValues[4];
+                Tree.fFrequency = fValues[5];
+                Tree.fMinHeight = fValues[6];
+                Tree.fMaxHeight = fValues[7];
+                Tree.strName = std::string(RestOfLine(Line, 11));
+                if (Tree.fFrequency < 0 || Tree.fMinHeight > Tree.fMaxHeight)
+                    return false;
+                Trees.push_back(std::move(Tree));
+            }
+            else if (strCommand == "SPACING")
+            {
+                ///< Format: SPACING x z
+                float fValues[2];
+                if (!ReadFloats(Line, 1, 2, fValues) || fValues[0] <= 0 || fValues[1] <= 0)
+                    return false;
+                fSpacingX = fValues[0];
+                fSpacingZ = fValues[1];
+            }
+            else if (strCommand == "RANDOM")
+            {
+                ///< Format: RANDOM x z
+                float fValues[2];
+                if (!ReadFloats(Line, 1, 2, fValues))
+                    return false;
+                fRandomX = fValues[0];
+                fRandomZ = fValues[1];
+            }
+            else if (strCommand == "SCALE_X" || strCommand == "SCALE_Y")
+            {
+                float fScale;
+                if (!ReadFloats(Line, 1, 1, &fScale) || fScale <= 0)
+                    return false;
+                (strCommand == "SCALE_X" ? fScaleX : fScaleY) = fScale;
+            }
+            else if (strCommand == "LOD")
+            {
+                ///< Format: LOD far
+                if (!ReadFloats(Line, 1, 1, &fLodFar))
+                    return false;
+            }
+            else if (strCommand == "SKIP_SURFACE")
+            {
+                if (Line.intCount < 2)
+                    return false;
+                SkipSurfaces.emplace_back(Line.Tokens[1]);
+            }
+
+            ///< Textures
+            else if (strCommand == "TEXTURE")
+            {
+                pBaseTex = std::string(RestOfLine(Line, 1));
+                bHasBaseTex = Line.intCount > 1;
+            }
+            else if (strCommand == "TEXTURE_NORMAL")
+            {
+                ///< Format: TEXTURE_NORMAL [ratio] Tex
+                float fRatio = 1;
+                const size_t intPathToken = Line.intCount > 2 && ParseFloat(Line.Tokens[1], fRatio) ? 2 : 1;
+                pNormalTex = std::string(RestOfLine(Line, intPathToken));
+                bHasNormalTex = Line.intCount > intPathToken;
+                dblNormalScale = fRatio;
+            }
+
+            ///< Anything else (shadows, groups, 3D trees) does not affect where trees are planted
+        }
+
+        ///< Not a forest, or one that plants nothing
+        return intHeaderLine == 3 && fSpacingX > 0 && !Trees.empty();
+    }
+    catch (...)
+    {
+        ///< Failure
+        return false;
+    }
+}
+
+void XPAsset::For::Clear()
+{
+    pReal.clear();
+    pBaseTex.clear();
+    pNormalTex.clear();
+    pMaterialTex.clear();
+    bHasBaseTex = bHasNormalTex = bHasMaterialTex = false;
+    dblNormalScale = 1;
+    intLayerGroup = XPLayerGroups::Resolve("objects", 0);
+
+    intVersion = 0;
+    fSpacingX = fSpacingZ = 0;
+    fRandomX = fRandomZ = 0;
+    fScaleX = fScaleY = 1;
+    fLodFar = 0;
+    SkipSurfaces.clear();
+    Trees.clear();
+}
@@ -0,0 +1,75 @@
+//Module:	XPFor
+//Author:	Connor Russell
+//Date:		10/18/2026
+//Purpose:	Forest (.for) definitions: the tree billboards and how densely they are planted
+
+#pragma once
+#include "XPAsset.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace XPAsset
+{
+    /**
+     * @brief One tree of a forest, a region of the texture drawn as crossed quads
+     */
+    struct ForTree
+    {
+        float fS{0};          //Left edge of the tree in the texture, in SCALE_X units
+        float fT{0};          //Bottom edge, in SCALE_Y units
+        float fWidth{0};
+        float fHeight{0};
+        float fOffset{0};     //Horizontal position of the trunk from the left edge
+        float fFrequency{0};  //Percentage of the forest made of this tree
+        float fMinHeight{0};  //Metres
+        float fMaxHeight{0};
+        uint32_t intQuads{2};
+        uint32_t intLayer{0};
+        std::string strName;
+    };
+
+    /**
+     * @brief Represents an X-Plane forest (.for)
+     */
+	class For : public Asset
+	{
+	public:
+	    uint32_t intVersion{0}; //800
+	    float fSpacingX{0};     //Metres between trees of a fully dense forest
+	    float fSpacingZ{0};
+	    float fRandomX{0};      //Metres of jitter applied to the spacing grid
+	    float fRandomZ{0};
+	    float fScaleX{1};       //Texture units across the whole texture
+	    float fScaleY{1};
+	    float fLodFar{0};       //0 when the file does not set one
+	    std::vector<std::string> SkipSurfaces;
+	    std::vector<XPAsset::ForTree> Trees;
+
+	    /**
+	     * @brief Loads the forest
+		 *
+		 * @param InPath = Path to the for
+		 * @returns True on success, false on failure
+	     */
+	    bool Load(const std::filesystem::path &InPath);
+
+	    /**
+	     * @brief Parses a forest from text already in memory. Clears any previously loaded data first
+		 *
+		 * @param InText = The contents of a for file
+		 * @returns True on success, false if the text is not a forest, a command is malformed or it has no trees
+	     */
+	    bool Parse(std::string_view InText);
+
+	    /**
+	     * @brief Empties every table and resets the settings
+	     */
+	    void Clear();
+
+    private:
+        void MakeMeVirtual() override {}
+	};
+
+}
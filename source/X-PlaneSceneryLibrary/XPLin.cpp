@@ -0,0 +1,182 @@
+//Module:	XPLin
+//Author:	Connor Russell
+//Date:		10/18/2026
+//Purpose:	Implements XPLin.h
+#include "XPLin.h"
+#include "XPTextLine.h"
+#include <fstream>
+#include <iterator>
+
+using namespace XPAsset::Text;
+
+/**
+* @brief Loads the line
+*
+* @Param InPath = Path to the lin
+* @return True on success, false on failure
+*/
+bool XPAsset::Lin::Load(const std::filesystem::path &InPath)
+{
+    try
+    {
+        ///<make sure the file exists and ends in .lin
+        if (!std::filesystem::exists(InPath) || !EqualsIgnoreCase(InPath.extension().string(), ".lin"))
+            return false;
+
+        std::ifstream LinFile(InPath, std::ios::binary);
+        if (!LinFile.is_open())
+            return false;
+
+        const std::string strText{std::istreambuf_iterator<char>(LinFile), std::istreambuf_iterator<char>()};
+        LinFile.close();
+
+        if (!Parse(strText))
+            return false;
+
+        pReal = InPath;
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool XPAsset::Lin::Parse(const std::string_view InText)
+{
+    Clear();
+
+    try
+    {
+        TextLine Line;
+        size_t intHeaderLine = 0;
+
+        size_t intPos = 0;
+        while (NextLine(InText, intPos, Line))
+        {
+            ///< Skip blank lines and comments
+            if (Line.intCount == 0 || Line.Tokens[0].front() == '#')
+                continue;
+
+            const std::string_view strCommand = Line.Tokens[0];
+
+            ///< Header: A or I for the line endings, the version, then LINE_PAINT
+            if (intHeaderLine < 3)
+            {
+                if (intHeaderLine == 0 && strCommand != "A" && strCommand != "I")
+                    return false;
+                if (intHeaderLine == 1 && (!ParseUint(strCommand, intVersion) || intVersion != 850))
+                    return false;
+                if (intHeaderLine == 2 && strCommand != "LINE_PAINT")
+                    return false;
+                ++intHeaderLine;
+                continue;
+            }
+
+            if (strCommand == "S_OFFSET")
+            {
+                ///< Format: S_OFFSET layer s1 sm s2
+                float fValues[3];
+                LinLayer Layer;
+                if (!ParseUint(Line.Token(1), Layer.intLayer) || !ReadFloats(Line, 2, 3, fValues))
+                    return false;
+                Layer.fS1 = fValues[0];
+                Layer.fSm = fValues[1];
+                Layer.fS2 = fValues[2];
+                if (Layer.fS1 > Layer.fSm || Layer.fSm > Layer.fS2)
+                    return false;
+                Layers.push_back(Layer);
+            }
+            else if (strCommand == "START_CAP" || strCommand == "END_CAP")
+            {
+                ///< Format: START_CAP layer s1 sm s2 t1 t2
+                float fValues[5];
+                LinCap Cap;
+                if (!ParseUint(Line.Token(1), Cap.intLayer) || !ReadFloats(Line, 2, 5, fValues))
+                    return false;
+                Cap.fS1 = fValues[0];
+                Cap.fSm = fValues[1];
+                Cap.fS2 = fValues[2];
+                Cap.fT1 = fValues[3];
+                Cap.fT2 = fValues[4];
+                if (Cap.fS1 > Cap.fSm || Cap.fSm > Cap.fS2)
+                    return false;
+                (strCommand == "START_CAP" ? StartCaps : EndCaps).push_back(Cap);
+            }
+            else if (strCommand == "SCALE")
+            {
+                ///< Format: SCALE across along
+                float fValues[2];
+                if (!ReadFloats(Line, 1, 2, fValues) || fValues[0] <= 0 || fValues[1] <= 0)
+                    return false;
+                fScaleX = fValues[0];
+                fScaleY = fValues[1];
+            }
+            else if (strCommand == "TEX_WIDTH" || strCommand == "TEX_HEIGHT")
+            {
+                float fSize;
+                if (!ReadFloats(Line, 1, 1, &fSize) || fSize <= 0)
+                    return false;
+                (strCommand == "TEX_WIDTH" ? fTexWidth : fTexHeight) = fSize;
+            }
+            else if (strCommand == "MIRROR")
+            {
+                bMirror = true;
+            }
+            else if (strCommand == "LAYER_GROUP")
+            {
+                ///< Format: LAYER_GROUP group [offset]
+                float fOffset = 0;
+                if (Line.intCount < 2 || (Line.intCount > 2 && !ParseFloat(Line.Tokens[2], fOffset)))
+                    return false;
+                intLayerGroup = XPLayerGroups::Resolve(std::string(Line.Token(1)), static_cast<int>(fOffset));
+            }
+
+            ///< Textures
+            else if (strCommand == "TEXTURE")
+            {
+                pBaseTex = std::string(RestOfLine(Line, 1));
+                bHasBaseTex = Line.intCount > 1;
+            }
+            else if (strCommand == "TEXTURE_NORMAL")
+            {
+                ///< Format: TEXTURE_NORMAL [ratio] Tex
+                float fRatio = 1;
+                const size_t intPathToken = Line.intCount > 2 && ParseFloat(Line.Tokens[1], fRatio) ? 2 : 1;
+                pNormalTex = std::string(RestOfLine(Line, intPathToken));
+                bHasNormalTex = Line.intCount > intPathToken;
+                dblNormalScale = fRatio;
+            }
+
+            ///< Anything else (decals, lighting, alignment hints) does not change the geometry
+        }
+
+        ///< Not a line, or one that draws nothing
+        return intHeaderLine == 3 && !Layers.empty();
+    }
+    catch (...)
+    {
+        ///< Failure
+        return false;
+    }
+}
+
+void XPAsset::Lin::Clear()
+{
+    pReal.clear();
+    pBaseTex.clear();
+    pNormalTex.clear();
+    pMaterialTex.clear();
+    bHasBaseTex = bHasNormalTex = bHasMaterialTex = false;
+    dblNormalScale = 1;
+    intLayerGroup = XPLayerGroups::Resolve("markings", 0);
+
+    intVersion = 0;
+    fScaleX = fScaleY = 1;
+    fTexWidth = 1;
+    fTexHeight = 0;
+    bMirror = false;
+    Layers.clear();
+    StartCaps.clear();
+    EndCaps.clear();
+}
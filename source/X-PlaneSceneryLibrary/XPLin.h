@@ -0,0 +1,81 @@
+//Module:	XPLin
+//Author:	Connor Russell
+//Date:		10/18/2026
+//Purpose:	Line (.lin) definitions: painted lines draped along a path, like taxiway markings
+
+#pragma once
+#include "XPAsset.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace XPAsset
+{
+    /**
+     * @brief One strip of a line, S_OFFSET. S values are in TEX_WIDTH units across the texture
+     */
+    struct LinLayer
+    {
+        uint32_t intLayer{0}; //Draw order, lower layers first
+        float fS1{0};         //Left edge of the strip in the texture
+        float fSm{0};         //Where the centre of the path falls
+        float fS2{0};         //Right edge
+    };
+
+    /**
+     * @brief Texture drawn past one end of a line, START_CAP or END_CAP. T values are in TEX_HEIGHT units
+     */
+    struct LinCap
+    {
+        uint32_t intLayer{0};
+        float fS1{0};
+        float fSm{0};
+        float fS2{0};
+        float fT1{0};         //Edge of the cap at the end of the line
+        float fT2{0};         //Outer edge
+    };
+
+    /**
+     * @brief Represents an X-Plane line (.lin)
+     */
+	class Lin : public Asset
+	{
+	public:
+	    uint32_t intVersion{0}; //850
+	    float fScaleX{1};       //Metres covered by TEX_WIDTH across the line
+	    float fScaleY{1};       //Metres covered by TEX_HEIGHT along the line, the repeat length
+	    float fTexWidth{1};     //Units of the S coordinates
+	    float fTexHeight{0};    //Units of the T coordinates, the texture width when 0
+	    bool bMirror{false};    //Texture may be flipped to follow the direction of travel
+	    std::vector<XPAsset::LinLayer> Layers;
+	    std::vector<XPAsset::LinCap> StartCaps;
+	    std::vector<XPAsset::LinCap> EndCaps;
+
+	    /**
+	     * @brief Loads the line
+		 *
+		 * @param InPath = Path to the lin
+		 * @returns True on success, false on failure
+	     */
+	    bool Load(const std::filesystem::path &InPath);
+
+	    /**
+	     * @brief Parses a line from text already in memory. Clears any previously loaded data first
+		 *
+		 * @param InText = The contents of a lin file
+		 * @returns True on success, false if the text is not a line, a command is malformed or it has no layers
+	     */
+	    bool Parse(std::string_view InText);
+
+	    /**
+	     * @brief Empties every table and resets the settings
+	     */
+	    void Clear();
+
+	    float GetTexHeight() const { return fTexHeight > 0 ? fTexHeight : fTexWidth; }
+
+    private:
+        void MakeMeVirtual() override {}
+	};
+
+}
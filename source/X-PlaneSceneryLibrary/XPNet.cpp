@@ -0,0 +1,201 @@
+//Module:	XPNet
+//Author:	Connor Russell
+//Date:		10/18/2026
+//Purpose:	Implements XPNet.h
+#include "XPNet.h"
+#include "XPTextLine.h"
+#include <fstream>
+#include <iterator>
+
+using namespace XPAsset::Text;
+
+/**
+* @brief Loads the network
+*
+* @Param InPath = Path to the net
+* @return True on success, false on failure
+*/
+bool XPAsset::Net::Load(const std::filesystem::path &InPath)
+{
+    try
+    {
+        ///<make sure the file exists and ends in .net
+        if (!std::filesystem::exists(InPath) || !EqualsIgnoreCase(InPath.extension().string(), ".net"))
+            return false;
+
+        std::ifstream NetFile(InPath, std::ios::binary);
+        if (!NetFile.is_open())
+            return false;
+
+        const std::string strText{std::istreambuf_iterator<char>(NetFile), std::istreambuf_iterator<char>()};
+        NetFile.close();
+
+        if (!Parse(strText))
+            return false;
+
+        pReal = InPath;
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool XPAsset::Net::Parse(const std::string_view InText)
+{
+    Clear();
+
+    try
+    {
+        TextLine Line;
+        size_t intHeaderLine = 0;
+
+        size_t intPos = 0;
+        while (NextLine(InText, intPos, Line))
+        {
+            ///< Skip blank lines and comments
+            if (Line.intCount == 0 || Line.Tokens[0].front() == '#')
+                continue;
+
+            const std::string_view strCommand = Line.Tokens[0];
+
+            ///< Header: A or I for the line endings, the version, then ROADS
+            if (intHeaderLine < 3)
+            {
+                if (intHeaderLine == 0 && strCommand != "A" && strCommand != "I")
+                    return false;
+                if (intHeaderLine == 1 && (!ParseUint(strCommand, intVersion) || intVersion != 800))
+                    return false;
+                if (intHeaderLine == 2 && strCommand != "ROADS")
+                    return false;
+                ++intHeaderLine;
+                continue;
+            }
+
+            if (strCommand == "ROAD_TYPE")
+            {
+                ///< Format: ROAD_TYPE id width length texture r g b
+                float fValues[2];
+                float fColour[3];
+                NetRoadType RoadType;
+                if (!ParseUint(Line.Token(1), RoadType.intId) || !ReadFloats(Line, 2, 2, fValues) ||
+                    !ParseUint(Line.Token(4), RoadType.intTexture) || !ReadFloats(Line, 5, 3, fColour))
+                    return false;
+                if (fValues[0] <= 0 || fValues[1] <= 0 || RoadType.intTexture >= Textures.size())
+                    return false;
+                RoadType.fWidth = fValues[0];
+                RoadType.fLength = fValues[1];
+                RoadType.fRed = fColour[0];
+                RoadType.fGreen = fColour[1];
+                RoadType.fBlue = fColour[2];
+                RoadTypes.push_back(std::move(RoadType));
+            }
+            else if (strCommand == "SEGMENT" || strCommand == "SEGMENT_HARD")
+            {
+                ///< Format: SEGMENT near far lat1 y1 s1 lat2 y2 s2, SEGMENT_HARD adds the surface
+                float fValues[8];
+                if (RoadTypes.empty() || !ReadFloats(Line, 1, 8, fValues))
+                    return false;
+                if (strCommand == "SEGMENT_HARD" && Line.intCount < 10)
+                    return false;
+
+                NetSegment Segment;
+                Segment.fNear = fValues[0];
+                Segment.fFar = fValues[1];
+                Segment.fLat1 = fValues[2];
+                Segment.fY1 = fValues[3];
+                Segment.fS1 = fValues[4];
+                Segment.fLat2 = fValues[5];
+                Segment.fY2 = fValues[6];
+                Segment.fS2 = fValues[7];
+                Segment.intTexture = RoadTypes.back().intTexture;
+                if (strCommand == "SEGMENT_HARD")
+                    Segment.strSurface = std::string(Line.Tokens[9]);
+                RoadTypes.back().Segments.push_back(std::move(Segment));
+            }
+            else if (strCommand == "SEGMENT_DRAPED")
+            {
+                ///< Format: SEGMENT_DRAPED texture near far lat1 s1 lat2 s2
+                float fValues[6];
+                NetSegment Segment;
+                if (RoadTypes.empty() || !ParseUint(Line.Token(1), Segment.intTexture) || !ReadFloats(Line, 2, 6, fValues))
+                    return false;
+                if (Segment.intTexture >= Textures.size())
+                    return false;
+                Segment.fNear = fValues[0];
+                Segment.fFar = fValues[1];
+                Segment.fLat1 = fValues[2];
+                Segment.fS1 = fValues[3];
+                Segment.fLat2 = fValues[4];
+                Segment.fS2 = fValues[5];
+                Segment.bDraped = true;
+                RoadTypes.back().Segments.push_back(std::move(Segment));
+            }
+            else if (strCommand == "SCALE")
+            {
+                if (!ReadFloats(Line, 1, 1, &fScale) || fScale <= 0)
+                    return false;
+            }
+
+            ///< Textures
+            else if (strCommand == "TEXTURE")
+            {
+                ///< Format: TEXTURE bias Tex
+                float fBias;
+                if (Line.intCount < 3 || !ParseFloat(Line.Tokens[1], fBias))
+                    return false;
+                Textures.push_back({std::string(RestOfLine(Line, 2)), {}, static_cast<int>(fBias)});
+
+                ///< The first texture is the asset's base texture
+                if (!bHasBaseTex)
+                {
+                    pBaseTex = Textures.back().pTex;
+                    bHasBaseTex = true;
+                }
+            }
+            else if (strCommand == "TEXTURE_LIT")
+            {
+                if (Textures.empty() || Line.intCount < 2)
+                    return false;
+                Textures.back().pLitTex = std::string(RestOfLine(Line, 1));
+            }
+
+            ///< Anything else (objects, wires, traffic, junction shaders) does not change the road surfaces
+        }
+
+        ///< Not a network, or one without roads
+        return intHeaderLine == 3 && !RoadTypes.empty();
+    }
+    catch (...)
+    {
+        ///< Failure
+        return false;
+    }
+}
+
+void XPAsset::Net::Clear()
+{
+    pReal.clear();
+    pBaseTex.clear();
+    pNormalTex.clear();
+    pMaterialTex.clear();
+    bHasBaseTex = bHasNormalTex = bHasMaterialTex = false;
+    dblNormalScale = 1;
+    intLayerGroup = XPLayerGroups::Resolve("roads", 0);
+
+    intVersion = 0;
+    fScale = 1;
+    Textures.clear();
+    RoadTypes.clear();
+}
+
+const XPAsset::NetRoadType *XPAsset::Net::FindRoadType(const uint32_t InId) const
+{
+    for (const NetRoadType &RoadType : RoadTypes)
+    {
+        if (RoadType.intId == InId)
+            return &RoadType;
+    }
+    return nullptr;
+}
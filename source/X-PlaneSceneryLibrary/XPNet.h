@@ -0,0 +1,101 @@
+//Module:	XPNet
+//Author:	Connor Russell
+//Date:		10/18/2026
+//Purpose:	Road network (.net) definitions: the cross sections of the road types a DSF network refers to
+
+#pragma once
+#include "XPAsset.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace XPAsset
+{
+    /**
+     * @brief A texture of the network, TEXTURE
+     */
+    struct NetTexture
+    {
+        std::filesystem::path pTex;
+        std::filesystem::path pLitTex; //TEXTURE_LIT following it, empty if none
+        int intBias{0};                //Z bias the texture is drawn with
+    };
+
+    /**
+     * @brief One quad strip of a road's cross section, SEGMENT, SEGMENT_HARD or SEGMENT_DRAPED
+     */
+    struct NetSegment
+    {
+        float fNear{0};        //Metres from the camera the segment is drawn between
+        float fFar{0};
+        float fLat1{0};        //Left edge as a fraction of the road width, 0 at the left and 1 at the right
+        float fY1{0};          //Metres above the road's centreline
+        float fS1{0};          //In SCALE units across the texture
+        float fLat2{0};        //Right edge
+        float fY2{0};
+        float fS2{0};
+        uint32_t intTexture{0}; //Into Net::Textures
+        bool bDraped{false};
+        std::string strSurface; //SEGMENT_HARD only
+    };
+
+    /**
+     * @brief A road type, ROAD_TYPE and the segments following it
+     */
+    struct NetRoadType
+    {
+        uint32_t intId{0};     //Subtype referenced by DSF network segments
+        float fWidth{0};       //Metres
+        float fLength{0};      //Metres of road per repeat of the texture
+        uint32_t intTexture{0}; //Into Net::Textures, used by SEGMENT and SEGMENT_HARD
+        float fRed{1};         //Map colour
+        float fGreen{1};
+        float fBlue{1};
+        std::vector<XPAsset::NetSegment> Segments;
+    };
+
+    /**
+     * @brief Represents an X-Plane road network (.net)
+     */
+	class Net : public Asset
+	{
+	public:
+	    uint32_t intVersion{0}; //800
+	    float fScale{1};        //Units of the S coordinates across a texture
+	    std::vector<XPAsset::NetTexture> Textures;
+	    std::vector<XPAsset::NetRoadType> RoadTypes;
+
+	    /**
+	     * @brief Loads the network
+		 *
+		 * @param InPath = Path to the net
+		 * @returns True on success, false on failure
+	     */
+	    bool Load(const std::filesystem::path &InPath);
+
+	    /**
+	     * @brief Parses a network from text already in memory. Clears any previously loaded data first
+		 *
+		 * @param InText = The contents of a net file
+		 * @returns True on success, false if the text is not a network, a command is malformed or it has no road types
+	     */
+	    bool Parse(std::string_view InText);
+
+	    /**
+	     * @brief Empties every table and resets the settings
+	     */
+	    void Clear();
+
+	    /**
+	     * @brief Finds a road type by its id
+		 *
+		 * @returns The road type, or nullptr if the network does not define it
+	     */
+	    const NetRoadType *FindRoadType(uint32_t InId) const;
+
+    private:
+        void MakeMeVirtual() override {}
+	};
+
+}
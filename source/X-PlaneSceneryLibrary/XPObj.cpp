@@ -3,9 +3,14 @@
 //Date:		10/11/2024 7:11:58 PM
 //Purpose:	Implements XPObj.h
 #include "XPObj.h"
-#include "TextUtils.h"
+#include "XPTextLine.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
-#include <sstream>
+#include <iterator>
+#include <unordered_map>
+
+using namespace XPAsset::Text;
 
 /**
 * @brief Loads the object
@@ -18,188 +23,390 @@ bool XPAsset::Obj::Load(const std::filesystem::path &InPath)
     try
     {
         ///<make sure the file exists and ends in .obj
-        if (!std::filesystem::exists(InPath) || InPath.extension() == "obj")
+        if (!std::filesystem::exists(InPath) || !EqualsIgnoreCase(InPath.extension().string(), ".obj"))
             return false;
 
-        ///< Set the real path
-        pReal = InPath;
-
         ///< Open
-        std::ifstream ObjFile(InPath);
+        std::ifstream ObjFile(InPath, std::ios::binary);
 
         ///< Make sure it opened
         if (!ObjFile.is_open())
             return false;
 
-        ///< Buffers
-        std::string strLine;
-        std::string strCommand;
-        bool bInDraped = false;
-        int intCurrentDrapedLayerGroup = XPLayerGroups::Resolve("objects", 0);
+        ///< Read the whole file, the parser works on views into it
+        const std::string strText{std::istreambuf_iterator<char>(ObjFile), std::istreambuf_iterator<char>()};
+        ObjFile.close();
 
-        ///< Read line by line
-        while (ObjFile.good())
-        {
-            ///< Line buffer
-            std::stringstream ssLine;
+        if (!Parse(strText))
+            return false;
 
-            ///< Read the line
-            strCommand = "";
-            getline(ObjFile, strLine);
-            ssLine.str(strLine);
-            ObjFile.peek(); ///< Set flags
+        ///< Set the real path
+        pReal = InPath;
 
-            ///< Get the command
-            ssLine >> strCommand;
+        ///< Success
+        return true;
+    }
+    catch (...)
+    {
+        ///< Failure
+        return false;
+    }
+}
 
-            ///< Draped commands set the draped flags, which determine whether draw calls are saved
-            if (strCommand == "ATTR_draped")
-                bInDraped = true;
-            else if (strCommand == "ATTR_no_draped")
-                bInDraped = false;
+/**
+* @brief Parses an obj8 from text already in memory
+*
+* @Param InText = The contents of an obj file
+* @return True on success, false on failure
+*/
+bool XPAsset::Obj::Parse(const std::string_view InText)
+{
+    try
+    {
+        Clear();
 
-            ///< Generic layer group, only applies if we don't have a layer group already
-            else if (strCommand == "ATTR_layer_group")
-            {
-                ///< Format: ATTR_layer_group group offset
-                std::string strLayerGroupArgs[2];
+        ///< Parser state
+        int intHeaderLine = 0;
+        bool bInDraped = false;
+        int intCurrentDrapedLayerGroup = XPLayerGroups::Resolve("objects", 0);
+        size_t intOpenKeyframes = SIZE_MAX; ///< Animation whose ANIM_*_begin table we are in
+        std::unordered_map<std::string, uint32_t> mStringIndices;
+        TextLine Line;
 
-                ///< Read the args
-                ssLine >> strLayerGroupArgs[0] >> strLayerGroupArgs[1];
+        ///< Datarefs and light names repeat a lot, so share them
+        const auto Intern = [&](const std::string_view InString) -> uint32_t
+        {
+            const auto [Iter, bInserted] = mStringIndices.try_emplace(std::string(InString), static_cast<uint32_t>(Strings.size()));
+            if (bInserted)
+                Strings.emplace_back(InString);
+            return Iter->second;
+        };
+
+        ///< Adds a command that points at a table entry
+        const auto PushCommand = [&](const ObjCommandType InType, const size_t InA, const uint32_t InB = 0)
+        {
+            ObjCommand NewCommand;
+            NewCommand.Type = InType;
+            NewCommand.A = static_cast<uint32_t>(InA);
+            NewCommand.B = InB;
+            Commands.push_back(NewCommand);
+        };
+
+        ///< Adds an animation, its keys are appended by the caller
+        const auto PushAnimation = [&](const ObjAnimationType InType, const std::string_view InDataref)
+        {
+            ObjAnimation NewAnimation;
+            NewAnimation.Type = InType;
+            NewAnimation.intDataref = Intern(InDataref);
+            NewAnimation.intKeyStart = static_cast<uint32_t>(AnimKeys.size());
+            Animations.push_back(NewAnimation);
+            PushCommand(ObjCommandType::Animation, Animations.size() - 1);
+            return &Animations.back();
+        };
+
+        const auto PushKey = [&](const float InValue, const float InX, const float InY, const float InZ)
+        {
+            AnimKeys.push_back({InValue, InX, InY, InZ});
+            ++Animations.back().intKeyCount;
+        };
 
-                ///< Set the layer group. An object can only be in a single *non-draped* layer group, and said layer group does not effect draped layer groups, so we can just set it directly.
-                intLayerGroup = XPLayerGroups::Resolve(strLayerGroupArgs[0], stoi(strLayerGroupArgs[1]));
-            }
+        ///< Read line by line
+        size_t intPos = 0;
+        while (NextLine(InText, intPos, Line))
+        {
 
-            ///< Generic layer group, only applies if we don't have a layer group already
-            else if (strCommand == "ATTR_layer_group_draped")
-            {
-                ///< Format: ATTR_layer_group_draped group offset
-                std::string strLayerGroupArgs[2];
+            ///< Skip blank lines and comments
+            if (Line.intCount == 0 || Line.Tokens[0].front() == '#')
+                continue;
 
-                ///< Read the args
-                ssLine >> strLayerGroupArgs[0] >> strLayerGroupArgs[1];
+            const std::string_view strCommand = Line.Tokens[0];
 
-                ///< Set the layer group
-                intCurrentDrapedLayerGroup = XPLayerGroups::Resolve(strLayerGroupArgs[0], stoi(strLayerGroupArgs[1]));
+            ///< Header: A or I for the line endings, the version, then OBJ
+            if (intHeaderLine < 3)
+            {
+                if ((intHeaderLine == 0 && strCommand != "A" && strCommand != "I") || (intHeaderLine == 1 && strCommand != "800") || (intHeaderLine == 2 && strCommand != "OBJ"))
+                    return false;
+                ++intHeaderLine;
+                continue;
             }
 
-            ///< Vertex, save em all
-            else if (strCommand == "VT")
+            ///< Vertex, save em all. The most common line, so checked first
+            if (strCommand == "VT")
             {
                 ///< Format: VT X Y Z Nx Ny Nz U V
-                std::string strVertexArgs[8];
-
-                ///< Read the args
-                ssLine >> strVertexArgs[0] >> strVertexArgs[1] >> strVertexArgs[2] >> strVertexArgs[3] >> strVertexArgs[4] >> strVertexArgs[5] >> strVertexArgs[6] >> strVertexArgs[7];
-
-                ///< Create a vertex. Y is replaced with the current layer group. These don't have normals cuz they're auto calculated by blender
+                float fValues[8];
+                if (!ReadFloats(Line, 1, 8, fValues))
+                    return false;
                 XPAsset::Vertex NewVertex;
-                NewVertex.X = stof(strVertexArgs[0]);
-                NewVertex.Y = intCurrentDrapedLayerGroup * 0.1;
-                NewVertex.Z = stof(strVertexArgs[2]);
-                NewVertex.NX = stof(strVertexArgs[3]);
-                NewVertex.NY = stof(strVertexArgs[4]);
-                NewVertex.NZ = stof(strVertexArgs[5]);
-                NewVertex.U = stof(strVertexArgs[6]);
-                NewVertex.V = stof(strVertexArgs[7]);
-
-                ///< Push it back
+                std::memcpy(&NewVertex, fValues, sizeof(NewVertex));
                 Vertices.push_back(NewVertex);
             }
 
             ///< IDX10 we add these 10 indices
-            else if (strCommand == "IDX10")
+            else if (strCommand == "IDX10" || strCommand == "IDX")
             {
-                ///< Format: IDX10 i1 i2 i3 i4 i5 i6 i7 i8 i9 i10
-                ///< We just push them back into indices vector in order
-                std::string strIndicies[10];
-
-                ///< Read the args
-                ssLine >> strIndicies[0] >> strIndicies[1] >> strIndicies[2] >> strIndicies[3] >> strIndicies[4] >> strIndicies[5] >> strIndicies[6] >> strIndicies[7] >> strIndicies[8] >> strIndicies[9];
-
-                ///< Push 'em back
-                for (const auto &strIndicie : strIndicies)
+                ///< Format: IDX10 i1 ... i10, or IDX i1. We just push them back into indices vector in order
+                const size_t intCount = strCommand.size() == 5 ? 10 : 1;
+                if (Line.intCount < 1 + intCount)
+                    return false;
+                for (size_t i = 1; i <= intCount; ++i)
                 {
-                    Indices.push_back(stoi(strIndicie));
+                    uint32_t intIndex;
+                    if (!ParseUint(Line.Tokens[i], intIndex))
+                        return false;
+                    Indices.push_back(intIndex);
                 }
             }
 
-            ///< IDX we save this one index
-            else if (strCommand == "IDX")
+            ///< Line and light vertices
+            else if (strCommand == "VLINE" || strCommand == "VLIGHT")
             {
-                ///< Format: IDX i1
-                ///< Push it back into indices vector
-                std::string strIndex;
+                ///< Format: VLINE X Y Z R G B
+                float fValues[6];
+                if (!ReadFloats(Line, 1, 6, fValues))
+                    return false;
+                XPAsset::ObjColorVertex NewVertex;
+                std::memcpy(&NewVertex, fValues, sizeof(NewVertex));
+                (strCommand == "VLINE" ? LineVertices : LightVertices).push_back(NewVertex);
+            }
+
+            ///< TRIS, LINES and LIGHTS. TRIS also saves a draw call with the current draped state
+            else if (strCommand == "TRIS" || strCommand == "LINES" || strCommand == "LIGHTS")
+            {
+                ///< Format: TRIS Offset Count. Offset and count are into the Indices vector, which are indexes to Vertices.
+                ///< The index's position in the vector does not always match its value!!!
+                uint32_t intOffset, intCount;
+                if (!ParseUint(Line.Token(1), intOffset) || !ParseUint(Line.Token(2), intCount))
+                    return false;
 
-                ///< Read the args
-                ssLine >> strIndex;
+                const ObjCommandType Type = strCommand == "TRIS" ? ObjCommandType::Tris : strCommand == "LINES" ? ObjCommandType::Lines : ObjCommandType::Lights;
+                PushCommand(Type, intOffset, intCount);
 
-                ///< Push it back
-                Indices.push_back(stoi(strIndex));
+                if (Type == ObjCommandType::Tris)
+                {
+                    XPAsset::ObjDrawCall NewDrawCall;
+                    NewDrawCall.idxStart = intOffset;
+                    NewDrawCall.idxEnd = intOffset + intCount;
+                    NewDrawCall.intLayerGroup = bInDraped ? intCurrentDrapedLayerGroup : intLayerGroup;
+                    NewDrawCall.intLod = static_cast<uint16_t>(Lods.empty() ? 0 : Lods.size() - 1);
+                    NewDrawCall.bDraped = bInDraped;
+                    DrawCalls.push_back(NewDrawCall);
+                }
             }
 
-            ///< TRIS. This saves a draw call if in draped state
-            else if (strCommand == "TRIS")
+            ///< Count of each table, so we can allocate once
+            else if (strCommand == "POINT_COUNTS")
             {
-                ///< Format: TRIS StartIndex EndIndex. Inclusive (ie TRIS 0 6 means indices 0 1 2 3 4 5 and 6).
-                ///< Indices here are indices in Indices vector, which are indexes to Vertices. The index's position in the vector does not always match its value!!!
-                std::string strDrawCallArgs[2];
+                ///< Format: POINT_COUNTS tris lines lights indices
+                uint32_t intCounts[4];
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    if (!ParseUint(Line.Token(i + 1), intCounts[i]))
+                        return false;
+                }
+                Vertices.reserve(intCounts[0]);
+                LineVertices.reserve(intCounts[1]);
+                LightVertices.reserve(intCounts[2]);
+                Indices.reserve(intCounts[3]);
+            }
 
-                ///< Read the args
-                ssLine >> strDrawCallArgs[0] >> strDrawCallArgs[1];
+            ///< Animation blocks
+            else if (strCommand == "ANIM_begin")
+                PushCommand(ObjCommandType::AnimBegin, 0);
+            else if (strCommand == "ANIM_end")
+                PushCommand(ObjCommandType::AnimEnd, 0);
 
-                ///< Create a new draw call
-                XPAsset::ObjDrawCall NewDrawCall;
-                NewDrawCall.idxStart = stoi(strDrawCallArgs[0]);
-                NewDrawCall.idxEnd = stoi(strDrawCallArgs[1]);
-                NewDrawCall.bDraped = bInDraped;
+            else if (strCommand == "ANIM_trans")
+            {
+                ///< Format: ANIM_trans X1 Y1 Z1 X2 Y2 Z2 V1 V2 Dataref
+                float fValues[8];
+                if (!ReadFloats(Line, 1, 8, fValues) || Line.intCount < 10)
+                    return false;
+                PushAnimation(ObjAnimationType::Translate, Line.Tokens[9]);
+                PushKey(fValues[6], fValues[0], fValues[1], fValues[2]);
+                PushKey(fValues[7], fValues[3], fValues[4], fValues[5]);
+            }
+            else if (strCommand == "ANIM_rotate")
+            {
+                ///< Format: ANIM_rotate AxisX AxisY AxisZ R1 R2 V1 V2 Dataref
+                float fValues[7];
+                if (!ReadFloats(Line, 1, 7, fValues) || Line.intCount < 9)
+                    return false;
+                ObjAnimation *pAnimation = PushAnimation(ObjAnimationType::Rotate, Line.Tokens[8]);
+                std::copy_n(fValues, 3, pAnimation->Axis);
+                PushKey(fValues[5], fValues[3], 0, 0);
+                PushKey(fValues[6], fValues[4], 0, 0);
+            }
+            else if (strCommand == "ANIM_trans_begin" || strCommand == "ANIM_rotate_begin")
+            {
+                ///< Format: ANIM_trans_begin Dataref, or ANIM_rotate_begin AxisX AxisY AxisZ Dataref. Keys follow
+                const bool bRotate = strCommand == "ANIM_rotate_begin";
+                float fAxis[3]{};
+                if ((bRotate && !ReadFloats(Line, 1, 3, fAxis)) || Line.intCount < (bRotate ? 5u : 2u))
+                    return false;
+                ObjAnimation *pAnimation = PushAnimation(bRotate ? ObjAnimationType::Rotate : ObjAnimationType::Translate, Line.Tokens[bRotate ? 4 : 1]);
+                std::copy_n(fAxis, 3, pAnimation->Axis);
+                intOpenKeyframes = Animations.size() - 1;
+            }
+            else if (strCommand == "ANIM_trans_key" || strCommand == "ANIM_rotate_key")
+            {
+                ///< Format: ANIM_trans_key Value X Y Z, or ANIM_rotate_key Value Angle
+                const bool bRotate = strCommand == "ANIM_rotate_key";
+                float fValues[4]{};
+                if (Animations.empty() || intOpenKeyframes != Animations.size() - 1 || !ReadFloats(Line, 1, bRotate ? 2 : 4, fValues))
+                    return false;
+                PushKey(fValues[0], fValues[1], fValues[2], fValues[3]);
+            }
+            else if (strCommand == "ANIM_keyframe_loop")
+            {
+                ///< Format: ANIM_keyframe_loop Value. Applies to the table it is in, or else the animation before it
+                float fLoop;
+                if (Animations.empty() || !ReadFloats(Line, 1, 1, &fLoop))
+                    return false;
+                Animations.back().fLoop = fLoop;
+            }
+            else if (strCommand == "ANIM_trans_end" || strCommand == "ANIM_rotate_end")
+                intOpenKeyframes = SIZE_MAX;
 
-                ///< Save the draw call
-                DrawCalls.push_back(NewDrawCall);
+            else if (strCommand == "ANIM_hide" || strCommand == "ANIM_show")
+            {
+                ///< Format: ANIM_hide V1 V2 Dataref
+                float fValues[2];
+                if (!ReadFloats(Line, 1, 2, fValues) || Line.intCount < 4)
+                    return false;
+                PushAnimation(strCommand == "ANIM_hide" ? ObjAnimationType::Hide : ObjAnimationType::Show, Line.Tokens[3]);
+                PushKey(fValues[0], 0, 0, 0);
+                PushKey(fValues[1], 0, 0, 0);
             }
 
-            ///< TEXTURE_DRAPED
-            else if (strCommand == "TEXTURE_DRAPED")
+            ///< Lights
+            else if (strCommand == "LIGHT_NAMED" || strCommand == "LIGHT_PARAM")
             {
-                ///< Format: TEXTURE_DRAPED Tex
-                std::string strTexPath;
-                ssLine >> strTexPath;
+                ///< Format: LIGHT_NAMED Name X Y Z, or LIGHT_PARAM Name X Y Z Params...
+                XPAsset::ObjLight NewLight;
+                NewLight.Type = strCommand == "LIGHT_NAMED" ? ObjLightType::Named : ObjLightType::Param;
+                if (!ReadFloats(Line, 2, 3, NewLight.Position))
+                    return false;
+                NewLight.intName = Intern(Line.Tokens[1]);
+                if (NewLight.Type == ObjLightType::Param && Line.intCount > 5)
+                    NewLight.intParams = Intern(RestOfLine(Line, 5));
+                Lights.push_back(NewLight);
+                PushCommand(ObjCommandType::Light, Lights.size() - 1);
+            }
+            else if (strCommand == "LIGHT_CUSTOM" || strCommand == "LIGHT_SPILL_CUSTOM")
+            {
+                ///< Format: LIGHT_CUSTOM X Y Z R G B A S S1 T1 S2 T2 Dataref, or LIGHT_SPILL_CUSTOM X Y Z R G B A Size DX DY DZ Semi Dataref
+                XPAsset::ObjLight NewLight;
+                NewLight.Type = strCommand == "LIGHT_CUSTOM" ? ObjLightType::Custom : ObjLightType::SpillCustom;
+                if (!ReadFloats(Line, 1, 3, NewLight.Position) || !ReadFloats(Line, 4, 9, NewLight.Values) || Line.intCount < 14)
+                    return false;
+                NewLight.intName = Intern(Line.Tokens[13]);
+                Lights.push_back(NewLight);
+                PushCommand(ObjCommandType::Light, Lights.size() - 1);
+            }
 
-                ///< Set the base texture
-                pDrapedBaseTex = strTexPath;
-                bHasDrapedBaseTex = true;
+            ///< LOD ranges. Every command after an ATTR_LOD belongs to it until the next one
+            else if (strCommand == "ATTR_LOD")
+            {
+                ///< Format: ATTR_LOD Near Far
+                XPAsset::ObjLod NewLod;
+                if (!ReadFloats(Line, 1, 1, &NewLod.fNear) || !ReadFloats(Line, 2, 1, &NewLod.fFar))
+                    return false;
+                if (!Lods.empty())
+                    Lods.back().intCommandCount = static_cast<uint32_t>(Commands.size()) - Lods.back().intCommandStart;
+                NewLod.intCommandStart = static_cast<uint32_t>(Commands.size());
+                Lods.push_back(NewLod);
+
+                PushCommand(ObjCommandType::Lod, Lods.size() - 1);
+                Commands.back().intNumbers = 2;
+                Commands.back().F[0] = NewLod.fNear;
+                Commands.back().F[1] = NewLod.fFar;
             }
 
-            ///< TEXTURE command
+            ///< Textures
             else if (strCommand == "TEXTURE")
             {
                 ///< Format: TEXTURE Tex
-                std::string strTexPath;
-                ssLine >> strTexPath;
+                pBaseTex = std::string(RestOfLine(Line, 1));
+                bHasBaseTex = Line.intCount > 1;
+            }
+            else if (strCommand == "TEXTURE_LIT")
+            {
+                ///< Format: TEXTURE_LIT Tex
+                pLitTex = std::string(RestOfLine(Line, 1));
+                bHasLitTex = Line.intCount > 1;
+            }
+            else if (strCommand == "TEXTURE_NORMAL" || strCommand == "TEXTURE_DRAPED_NORMAL")
+            {
+                ///< Format: TEXTURE_NORMAL [TileRatio] Tex, or TEXTURE_DRAPED_NORMAL TileRatio Tex
+                float fRatio = 1;
+                size_t intPathToken = 1;
+                if (Line.intCount > 2 && ParseFloat(Line.Tokens[1], fRatio))
+                    intPathToken = 2;
 
-                ///< Set the base texture
-                pBaseTex = strTexPath;
-                bHasBaseTex = true;
+                if (strCommand == "TEXTURE_NORMAL")
+                {
+                    pNormalTex = std::string(RestOfLine(Line, intPathToken));
+                    bHasNormalTex = Line.intCount > intPathToken;
+                    dblNormalScale = fRatio;
+                }
+                else
+                {
+                    pDrapedNormalTex = std::string(RestOfLine(Line, intPathToken));
+                    bHasDrapedNormalTex = Line.intCount > intPathToken;
+                    dblDrapedNormalScale = fRatio;
+                }
+            }
+            else if (strCommand == "TEXTURE_DRAPED")
+            {
+                ///< Format: TEXTURE_DRAPED Tex
+                pDrapedBaseTex = std::string(RestOfLine(Line, 1));
+                bHasDrapedBaseTex = Line.intCount > 1;
             }
 
-            ///< TEXTURE_DRAPED_NORMAL
-            else if (strCommand == "TEXTURE_DRAPED_NORMAL")
+            ///< Everything else is a state command. Keep it in the stream with its raw arguments
+            else
             {
-                ///< Format: TEXTURE_DRAPED_NORMAL TileRatio Tex
-                std::string strTexArgs[2];
-                ssLine >> strTexArgs[0] >> strTexArgs[1];
+                ///< Draped commands set the draped flags, which determine whether draw calls are saved
+                if (strCommand == "ATTR_draped")
+                    bInDraped = true;
+                else if (strCommand == "ATTR_no_draped")
+                    bInDraped = false;
+
+                ///< Format: ATTR_layer_group group offset. An object can only be in a single *non-draped* layer group,
+                ///< and said layer group does not effect draped layer groups, so we can just set it directly.
+                else if (strCommand == "ATTR_layer_group" || strCommand == "ATTR_layer_group_draped")
+                {
+                    float fOffset = 0;
+                    if (Line.intCount > 2 && !ParseFloat(Line.Tokens[2], fOffset))
+                        return false;
+                    const int intGroup = XPLayerGroups::Resolve(std::string(Line.Token(1)), static_cast<int>(fOffset));
+                    (strCommand == "ATTR_layer_group" ? intLayerGroup : intCurrentDrapedLayerGroup) = intGroup;
+                }
 
-                ///< Set the normal texture
-                pDrapedNormalTex = strTexArgs[1];
+                ObjCommand NewCommand;
+                NewCommand.Type = ObjCommandType::Attribute;
+                NewCommand.A = Intern(strCommand);
+                NewCommand.B = Line.intCount > 1 ? Intern(RestOfLine(Line, 1)) : OBJ_NO_STRING;
+                for (size_t i = 1; i < Line.intCount && NewCommand.intNumbers < std::size(NewCommand.F); ++i)
+                {
+                    if (ParseFloat(Line.Tokens[i], NewCommand.F[NewCommand.intNumbers]))
+                        ++NewCommand.intNumbers;
+                }
+                Commands.push_back(NewCommand);
             }
         }
 
-        ///< Close the file
-        ObjFile.close();
+        ///< Not an obj8
+        if (intHeaderLine < 3)
+            return false;
 
-        ///< Success
-        return true;
+        ///< Close the last LOD
+        if (!Lods.empty())
+            Lods.back().intCommandCount = static_cast<uint32_t>(Commands.size()) - Lods.back().intCommandStart;
+
+        ///< Make sure every command stays inside the tables, so nothing downstream has to check again
+        return Validate();
     }
     catch (...)
     {
@@ -208,3 +415,118 @@ bool XPAsset::Obj::Load(const std::filesystem::path &InPath)
     }
 }
 
+/**
+* @brief Checks that every command, draw call, animation and LOD points inside the tables
+*/
+bool XPAsset::Obj::Validate() const
+{
+    const auto IsString = [&](const uint32_t InIndex) { return InIndex == OBJ_NO_STRING || InIndex < Strings.size(); };
+
+    ///< Index ranges, and the vertices the indices point at
+    const auto IsIndexRange = [&](const size_t InStart, const size_t InEnd, const size_t InVertexCount)
+    {
+        if (InStart > InEnd || InEnd > Indices.size())
+            return false;
+        for (size_t i = InStart; i < InEnd; ++i)
+        {
+            if (Indices[i] >= InVertexCount)
+                return false;
+        }
+        return true;
+    };
+
+    for (const auto &Command : Commands)
+    {
+        const size_t intEnd = static_cast<size_t>(Command.A) + Command.B;
+        bool bValid = true;
+        switch (Command.Type)
+        {
+        case ObjCommandType::Tris: bValid = IsIndexRange(Command.A, intEnd, Vertices.size()); break;
+        case ObjCommandType::Lines: bValid = IsIndexRange(Command.A, intEnd, LineVertices.size()); break;
+        case ObjCommandType::Lights: bValid = intEnd <= LightVertices.size(); break;
+        case ObjCommandType::Light: bValid = Command.A < Lights.size(); break;
+        case ObjCommandType::Animation: bValid = Command.A < Animations.size(); break;
+        case ObjCommandType::Lod: bValid = Command.A < Lods.size(); break;
+        case ObjCommandType::Attribute: bValid = Command.A < Strings.size() && IsString(Command.B); break;
+        case ObjCommandType::AnimBegin:
+        case ObjCommandType::AnimEnd: break;
+        default: bValid = false; break;
+        }
+        if (!bValid || Command.intNumbers > std::size(Command.F))
+            return false;
+    }
+
+    for (const auto &DrawCall : DrawCalls)
+    {
+        if (DrawCall.idxStart > DrawCall.idxEnd || DrawCall.idxEnd > Indices.size() || (!Lods.empty() && DrawCall.intLod >= Lods.size()))
+            return false;
+    }
+
+    for (const auto &Animation : Animations)
+    {
+        if (static_cast<size_t>(Animation.intKeyStart) + Animation.intKeyCount > AnimKeys.size() || !IsString(Animation.intDataref))
+            return false;
+    }
+
+    for (const auto &Light : Lights)
+    {
+        if (!IsString(Light.intName) || !IsString(Light.intParams))
+            return false;
+    }
+
+    for (const auto &Lod : Lods)
+    {
+        if (static_cast<size_t>(Lod.intCommandStart) + Lod.intCommandCount > Commands.size())
+            return false;
+    }
+
+    return true;
+}
+
+/**
+* @brief Empties every table and resets the textures
+*/
+void XPAsset::Obj::Clear()
+{
+    Vertices.clear();
+    LineVertices.clear();
+    LightVertices.clear();
+    Indices.clear();
+    DrawCalls.clear();
+    Commands.clear();
+    Animations.clear();
+    AnimKeys.clear();
+    Lights.clear();
+    Lods.clear();
+    Strings.clear();
+
+    pBaseTex.clear();
+    pNormalTex.clear();
+    pMaterialTex.clear();
+    pLitTex.clear();
+    pDrapedBaseTex.clear();
+    pDrapedNormalTex.clear();
+    pDrapedMaterialTex.clear();
+    bHasBaseTex = bHasNormalTex = bHasMaterialTex = bHasLitTex = false;
+    bHasDrapedBaseTex = bHasDrapedNormalTex = bHasDrapedMaterialTex = false;
+    dblNormalScale = 1;
+    dblDrapedNormalScale = 1;
+    intLayerGroup = XPLayerGroups::Resolve("objects", 0);
+}
+
+/**
+* @brief Adds a string to Strings
+*/
+uint32_t XPAsset::Obj::AddString(const std::string_view InString)
+{
+    Strings.emplace_back(InString);
+    return static_cast<uint32_t>(Strings.size() - 1);
+}
+
+/**
+* @brief Returns a string from Strings, or an empty string for OBJ_NO_STRING
+*/
+std::string_view XPAsset::Obj::GetString(const uint32_t InIndex) const
+{
+    return InIndex < Strings.size() ? std::string_view(Strings[InIndex]) : std::string_view();
+}
@@ -6,63 +6,196 @@
 #pragma once
 #include "XPAsset.h"
 #include "XPLayerGroups.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace XPAsset
 {
+    ///< Index into Obj::Strings that means "no string"
+    constexpr uint32_t OBJ_NO_STRING = 0xFFFFFFFFu;
+
     /**
      * @brief Represents a draw call (TRIS) in an X-Plane obj8 file
      */
 	class ObjDrawCall
 	{
 	public:
-	    size_t idxStart;                           //Zero based start index of the first vertex
-	    size_t idxEnd;                             //Zero based end vertex to draw to
-	    int intLayerGroup{XPLayerGroups::OBJECTS}; //Layer group
-	    bool bDraped{false};                       //Is this draw call in the object draped?
-	
-	    //There theoretically could be other properties, but are not implemented here.
+	    uint32_t idxStart{0};                          //Zero based offset of the first entry in Indices
+	    uint32_t idxEnd{0};                            //One past the last entry in Indices
+	    int32_t intLayerGroup{XPLayerGroups::OBJECTS}; //Layer group. Draped draw calls use the draped layer group
+	    uint16_t intLod{0};                            //Index into Obj::Lods, 0 if the object has no ATTR_LOD
+	    bool bDraped{false};                           //Is this draw call in the object draped?
+	    uint8_t intReserved{0};
 	};
 
    /**
-    * @brief Represents a vertex in an X-Plane obj8 file
-    *
-    * @
+    * @brief Represents a vertex in an X-Plane obj8 file (VT). Floats, as X-Plane stores them.
 	*/
 	class Vertex
 	{
 	public:
-	    double X;
-	    double Y;
-	    double Z;
-	    double NX;
-	    double NY;
-	    double NZ;
-	    double U;
-	    double V;
+	    float X;
+	    float Y;
+	    float Z;
+	    float NX;
+	    float NY;
+	    float NZ;
+	    float U;
+	    float V;
 	};
 
+    /**
+     * @brief A coloured line or light vertex (VLINE, VLIGHT)
+     */
+    struct ObjColorVertex
+    {
+        float X;
+        float Y;
+        float Z;
+        float R;
+        float G;
+        float B;
+    };
+
+    /**
+     * @brief Every command that is not vertex or index data, in file order
+     */
+    enum class ObjCommandType : uint16_t
+    {
+        Tris,       ///< A = offset into Indices, B = count
+        Lines,      ///< A = offset into Indices, B = count
+        Lights,     ///< A = offset into LightVertices, B = count
+        Light,      ///< A = index into Lights
+        AnimBegin,
+        AnimEnd,
+        Animation,  ///< A = index into Animations
+        Lod,        ///< A = index into Lods, F[0]/F[1] = near/far
+        Attribute   ///< Any other state command. A = name, B = raw arguments (string indices), F = first numeric arguments
+    };
+
+    /**
+     * @brief One entry of the state-change stream. Fixed size so the stream can be copied straight out of a cache file
+     */
+    struct ObjCommand
+    {
+        ObjCommandType Type{ObjCommandType::Attribute};
+        uint16_t intNumbers{0}; ///< How many entries of F are set
+        uint32_t A{0};
+        uint32_t B{0};
+        float F[5]{};
+    };
+
+    enum class ObjAnimationType : uint32_t
+    {
+        Translate,  ///< Keys hold X/Y/Z offsets
+        Rotate,     ///< Keys hold the angle in degrees in X, around Axis
+        Hide,       ///< Two keys, the dataref range the geometry is hidden in
+        Show        ///< Two keys, the dataref range the geometry is shown in
+    };
+
+    /**
+     * @brief A keyframe: dataref value and the transform at that value
+     */
+    struct ObjAnimKey
+    {
+        float Value;
+        float X;
+        float Y;
+        float Z;
+    };
+
+    /**
+     * @brief One ANIM_trans, ANIM_rotate, ANIM_hide or ANIM_show, in either the two key or the keyframe table form
+     */
+    struct ObjAnimation
+    {
+        ObjAnimationType Type{ObjAnimationType::Translate};
+        uint32_t intDataref{OBJ_NO_STRING}; ///< Index into Strings
+        uint32_t intKeyStart{0};            ///< Offset into AnimKeys
+        uint32_t intKeyCount{0};
+        float Axis[3]{};
+        float fLoop{0};                     ///< ANIM_keyframe_loop, 0 if the animation does not loop
+    };
+
+    enum class ObjLightType : uint32_t
+    {
+        Named,      ///< LIGHT_NAMED name x y z
+        Param,      ///< LIGHT_PARAM name x y z params...
+        Custom,     ///< LIGHT_CUSTOM x y z r g b a s s1 t1 s2 t2 dataref
+        SpillCustom ///< LIGHT_SPILL_CUSTOM x y z r g b a size dx dy dz semi dataref
+    };
+
+    struct ObjLight
+    {
+        ObjLightType Type{ObjLightType::Named};
+        uint32_t intName{OBJ_NO_STRING};   ///< Light name, or the dataref for custom lights
+        uint32_t intParams{OBJ_NO_STRING}; ///< Raw parameters of a LIGHT_PARAM
+        float Position[3]{};
+        float Values[9]{};                 ///< Numeric arguments after the position (custom lights)
+    };
+
+    /**
+     * @brief An ATTR_LOD range and the commands that belong to it
+     */
+    struct ObjLod
+    {
+        float fNear{0};
+        float fFar{0};
+        uint32_t intCommandStart{0};
+        uint32_t intCommandCount{0};
+    };
+
+    ///< Everything below is copied to and from cache files as raw bytes
+    static_assert(std::is_trivially_copyable_v<ObjDrawCall> && sizeof(ObjDrawCall) == 16);
+    static_assert(std::is_trivially_copyable_v<Vertex> && sizeof(Vertex) == 32);
+    static_assert(std::is_trivially_copyable_v<ObjColorVertex> && sizeof(ObjColorVertex) == 24);
+    static_assert(std::is_trivially_copyable_v<ObjCommand> && sizeof(ObjCommand) == 32);
+    static_assert(std::is_trivially_copyable_v<ObjAnimKey> && sizeof(ObjAnimKey) == 16);
+    static_assert(std::is_trivially_copyable_v<ObjAnimation> && sizeof(ObjAnimation) == 32);
+    static_assert(std::is_trivially_copyable_v<ObjLight> && sizeof(ObjLight) == 60);
+    static_assert(std::is_trivially_copyable_v<ObjLod> && sizeof(ObjLod) == 16);
+
     /**
      * @brief Represents an X-Plane obj8 file
+     *
+     * Geometry is kept as X-Plane's vertex and index tables. Everything else is kept in file order in Commands,
+     * which points into the Animations, Lights and Lods tables. Commands the loader has no table for are kept as
+     * Attribute commands with their name and raw arguments, so nothing in the file is dropped.
 	 */
 	class Obj : public Asset
 	{
 	public:
-	    std::vector<XPAsset::Vertex> Vertices; //Vertices
-	    std::vector<size_t> Indices;           //Indices. These are zero based indicies of verticies
+	    std::vector<XPAsset::Vertex> Vertices;           //Vertices
+	    std::vector<XPAsset::ObjColorVertex> LineVertices;  //VLINE
+	    std::vector<XPAsset::ObjColorVertex> LightVertices; //VLIGHT
+	    std::vector<uint32_t> Indices;                   //Indices. These are zero based indicies of verticies
 	    std::vector<XPAsset::ObjDrawCall>
 	        DrawCalls; //These are draw calls that point to the indicies, and contain state data
-	
+
+	    std::vector<XPAsset::ObjCommand> Commands;     //State-change stream, in file order
+	    std::vector<XPAsset::ObjAnimation> Animations; //Animation table, referenced by Animation commands
+	    std::vector<XPAsset::ObjAnimKey> AnimKeys;     //Keyframes of all animations
+	    std::vector<XPAsset::ObjLight> Lights;         //Named, parameterised and custom lights
+	    std::vector<XPAsset::ObjLod> Lods;             //ATTR_LOD ranges. Empty if the object has no LODs
+	    std::vector<std::string> Strings;              //Datarefs, light names, attribute names and arguments
+
 	    //All paths are relative to the obj path
+	    std::filesystem::path pLitTex;          //TEXTURE_LIT
 	    std::filesystem::path pDrapedBaseTex;   //The draped base texture
 	    std::filesystem::path pDrapedNormalTex; //The draped normal texture. Material is typically in the alpha channel
 	    std::filesystem::path
 	        pDrapedMaterialTex; //The draped material texture. This is only used if specified to have a dedicated material map - this is generally bundled in with the normal int he b/alpha channels
+	    bool bHasLitTex{false};
 	    bool bHasDrapedBaseTex{false};
 	    bool bHasDrapedNormalTex{false};   //Material is typically in the b/alpha channel
 	    bool bHasDrapedMaterialTex{false}; //Only set if the material is in a separate texture
-	
-	    void *Refcon; //A reference to an object that can be used to store additional data acociated with this object
-	
+	    double dblDrapedNormalScale{1};     //Ratio of TEXTURE_DRAPED_NORMAL
+
+	    void *Refcon{nullptr}; //A reference to an object that can be used to store additional data acociated with this object
+
 	    /**
 	     * @brief Loads the object
 		 *
@@ -70,6 +203,41 @@ namespace XPAsset
 		 * @returns True on success, false on failure
 	     */
 	    bool Load(const std::filesystem::path &InPath);
+
+	    /**
+	     * @brief Parses an obj8 from text already in memory. Clears any previously loaded data first
+		 *
+		 * @param InText = The contents of an obj file
+		 * @returns True on success, false if the text is not an obj8 or a command is malformed
+	     */
+	    bool Parse(std::string_view InText);
+
+	    /**
+	     * @brief Checks that every command, draw call, animation and LOD points inside the tables
+		 *
+		 * @returns True if the object is safe to walk without further bounds checks
+	     */
+	    bool Validate() const;
+
+	    /**
+	     * @brief Empties every table and resets the textures
+	     */
+	    void Clear();
+
+	    /**
+	     * @brief Adds a string to Strings
+		 *
+		 * @returns Its index
+	     */
+	    uint32_t AddString(std::string_view InString);
+
+	    /**
+	     * @brief Returns a string from Strings, or an empty string for OBJ_NO_STRING
+	     */
+	    std::string_view GetString(uint32_t InIndex) const;
+
+    private:
+        void MakeMeVirtual() override {}
 	};
 
 }
@@ -0,0 +1,494 @@
+//Module:	XPObjCache
+//Author:	Connor Russell
+//Date:		10/18/2026 10:12:44 AM
+//Purpose:	Implements XPObjCache.h
+#include "XPObjCache.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief Read only mapping of a whole file. Empty files map to an empty view
+     */
+    class FileMapping
+    {
+    public:
+        FileMapping() = default;
+        FileMapping(const FileMapping &) = delete;
+        FileMapping &operator=(const FileMapping &) = delete;
+        ~FileMapping() { Close(); }
+
+        bool Open(const std::filesystem::path &InPath)
+        {
+            Close();
+#ifdef _WIN32
+            hFile = CreateFileW(InPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (hFile == INVALID_HANDLE_VALUE)
+                return false;
+
+            LARGE_INTEGER Size;
+            if (!GetFileSizeEx(hFile, &Size))
+                return false;
+            intSize = static_cast<size_t>(Size.QuadPart);
+            if (intSize == 0)
+                return true;
+
+            hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!hMapping)
+                return false;
+            pData = static_cast<const char *>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+#else
+            intFile = open(InPath.c_str(), O_RDONLY | O_CLOEXEC);
+            if (intFile < 0)
+                return false;
+
+            struct stat Info;
+            if (fstat(intFile, &Info) != 0)
+                return false;
+            intSize = static_cast<size_t>(Info.st_size);
+            if (intSize == 0)
+                return true;
+
+            void *pMapped = mmap(nullptr, intSize, PROT_READ, MAP_PRIVATE, intFile, 0);
+            pData = pMapped == MAP_FAILED ? nullptr : static_cast<const char *>(pMapped);
+#endif
+            return pData != nullptr;
+        }
+
+        void Close()
+        {
+#ifdef _WIN32
+            if (pData)
+                UnmapViewOfFile(pData);
+            if (hMapping)
+                CloseHandle(hMapping);
+            if (hFile != INVALID_HANDLE_VALUE)
+                CloseHandle(hFile);
+            hMapping = nullptr;
+            hFile = INVALID_HANDLE_VALUE;
+#else
+            if (pData)
+                munmap(const_cast<char *>(pData), intSize);
+            if (intFile >= 0)
+                close(intFile);
+            intFile = -1;
+#endif
+            pData = nullptr;
+            intSize = 0;
+        }
+
+        std::string_view View() const { return pData ? std::string_view(pData, intSize) : std::string_view(); }
+
+    private:
+        const char *pData{nullptr};
+        size_t intSize{0};
+#ifdef _WIN32
+        HANDLE hFile{INVALID_HANDLE_VALUE};
+        HANDLE hMapping{nullptr};
+#else
+        int intFile{-1};
+#endif
+    };
+
+    ///< Tables of an entry, in file order
+    enum Section : uint32_t
+    {
+        SECTION_VERTICES,
+        SECTION_LINE_VERTICES,
+        SECTION_LIGHT_VERTICES,
+        SECTION_INDICES,
+        SECTION_DRAW_CALLS,
+        SECTION_COMMANDS,
+        SECTION_ANIMATIONS,
+        SECTION_ANIM_KEYS,
+        SECTION_LIGHTS,
+        SECTION_LODS,
+        SECTION_STRING_OFFSETS, ///< One uint32 per string plus the end, into SECTION_STRING_DATA
+        SECTION_STRING_DATA,
+        SECTION_COUNT
+    };
+
+    ///< Textures are saved as extra strings after Obj::Strings
+    enum Texture : uint32_t
+    {
+        TEXTURE_BASE,
+        TEXTURE_NORMAL,
+        TEXTURE_MATERIAL,
+        TEXTURE_LIT,
+        TEXTURE_DRAPED_BASE,
+        TEXTURE_DRAPED_NORMAL,
+        TEXTURE_DRAPED_MATERIAL,
+        TEXTURE_COUNT
+    };
+
+    constexpr char CACHE_MAGIC[8] = {'S', 'E', 'D', 'X', 'O', 'B', 'J', 'C'};
+
+    struct CacheSection
+    {
+        uint64_t intOffset;
+        uint64_t intCount;
+    };
+
+    struct CacheHeader
+    {
+        char Magic[8];
+        uint32_t intVersion;
+        uint32_t intSectionCount;
+        uint64_t intSourceHash;
+        uint64_t intSourceSize;
+        double dblNormalScale;
+        double dblDrapedNormalScale;
+        int32_t intLayerGroup;
+        uint32_t intObjStringCount;             ///< Strings that belong to Obj::Strings, the textures follow
+        uint32_t intTextureMask;                ///< Bit per Texture that is set
+        uint32_t intReserved;
+        CacheSection Sections[SECTION_COUNT];
+    };
+    static_assert(std::is_trivially_copyable_v<CacheHeader> && sizeof(CacheHeader) % 8 == 0);
+
+    ///< Element size of each section
+    constexpr size_t SECTION_ELEMENT_SIZE[SECTION_COUNT] = {
+        sizeof(XPAsset::Vertex), sizeof(XPAsset::ObjColorVertex), sizeof(XPAsset::ObjColorVertex), sizeof(uint32_t),
+        sizeof(XPAsset::ObjDrawCall), sizeof(XPAsset::ObjCommand), sizeof(XPAsset::ObjAnimation), sizeof(XPAsset::ObjAnimKey),
+        sizeof(XPAsset::ObjLight), sizeof(XPAsset::ObjLod), sizeof(uint32_t), 1};
+
+    constexpr size_t AlignUp(const size_t InValue) { return (InValue + 7) & ~size_t(7); }
+
+    double MillisecondsSince(const std::chrono::steady_clock::time_point InStart)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - InStart).count();
+    }
+
+    /**
+     * @brief Copies a section of a mapped entry into a vector. Bounds were checked by the caller
+     */
+    template <typename T>
+    void CopySection(const char *InData, const CacheSection &InSection, std::vector<T> &OutVector)
+    {
+        OutVector.resize(static_cast<size_t>(InSection.intCount));
+        if (!OutVector.empty())
+            std::memcpy(OutVector.data(), InData + InSection.intOffset, OutVector.size() * sizeof(T));
+    }
+
+    std::string PathToString(const std::filesystem::path &InPath)
+    {
+        const std::u8string strPath = InPath.u8string();
+        return {strPath.begin(), strPath.end()};
+    }
+
+    std::filesystem::path StringToPath(const std::string_view InString)
+    {
+        return std::filesystem::path(std::u8string(InString.begin(), InString.end()));
+    }
+}
+
+XPAsset::ObjCache::ObjCache(std::filesystem::path InDirectory) : pDirectory(std::move(InDirectory))
+{
+}
+
+/**
+* @brief Returns the path of the entry for a given source hash
+*/
+std::filesystem::path XPAsset::ObjCache::GetEntryPath(const uint64_t InHash) const
+{
+    char strName[32];
+    std::snprintf(strName, sizeof(strName), "%016llx.objc", static_cast<unsigned long long>(InHash));
+    return pDirectory / strName;
+}
+
+/**
+* @brief Hashes the contents of an obj, eight bytes at a time
+*/
+uint64_t XPAsset::ObjCache::Hash(const std::string_view InBytes)
+{
+    constexpr uint64_t K1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t K2 = 0xC2B2AE3D27D4EB4Full;
+    const auto Mix = [](uint64_t InHash, const uint64_t InWord)
+    {
+        InHash ^= InWord * K2;
+        InHash = (InHash << 31) | (InHash >> 33);
+        return InHash * K1;
+    };
+
+    uint64_t intHash = K1 ^ InBytes.size();
+    size_t i = 0;
+    for (; i + 8 <= InBytes.size(); i += 8)
+    {
+        uint64_t intWord;
+        std::memcpy(&intWord, InBytes.data() + i, 8);
+        intHash = Mix(intHash, intWord);
+    }
+
+    uint64_t intTail = 0;
+    if (i < InBytes.size())
+        std::memcpy(&intTail, InBytes.data() + i, InBytes.size() - i);
+    intHash = Mix(intHash, intTail);
+
+    ///< Final avalanche so the short tail affects every bit
+    intHash ^= intHash >> 33;
+    intHash *= 0xFF51AFD7ED558CCDull;
+    intHash ^= intHash >> 33;
+    intHash *= 0xC4CEB9FE1A85EC53ull;
+    intHash ^= intHash >> 33;
+    return intHash;
+}
+
+/**
+* @brief Loads an obj, from its cache entry if there is one, otherwise from text, then saves the entry
+*/
+bool XPAsset::ObjCache::Load(const std::filesystem::path &InPath, Obj &OutObj)
+{
+    try
+    {
+        ///< Hash the source. This is the only time the text is touched on a hit
+        auto tpStart = std::chrono::steady_clock::now();
+        FileMapping Source;
+        if (!Source.Open(InPath))
+            return false;
+        const std::string_view strText = Source.View();
+        const uint64_t intHash = Hash(strText);
+        Stats.dblHashMs += MillisecondsSince(tpStart);
+
+        const std::filesystem::path pEntry = GetEntryPath(intHash);
+
+        tpStart = std::chrono::steady_clock::now();
+        if (Read(pEntry, OutObj, intHash, strText.size()))
+        {
+            OutObj.pReal = InPath;
+            Stats.dblReadMs += MillisecondsSince(tpStart);
+            ++Stats.intHits;
+            return true;
+        }
+
+        ///< Miss, parse the text straight from the mapping
+        ++Stats.intMisses;
+        tpStart = std::chrono::steady_clock::now();
+        const bool bParsed = OutObj.Parse(strText);
+        Stats.dblParseMs += MillisecondsSince(tpStart);
+        if (!bParsed)
+            return false;
+        OutObj.pReal = InPath;
+
+        ///< Failing to save only costs us the parse next time
+        tpStart = std::chrono::steady_clock::now();
+        std::error_code ErrorCode;
+        std::filesystem::create_directories(pDirectory, ErrorCode);
+        if (!Write(pEntry, OutObj, intHash, strText.size()))
+            ++Stats.intWriteFailures;
+        Stats.dblWriteMs += MillisecondsSince(tpStart);
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+/**
+* @brief Writes an entry through a temporary file
+*/
+bool XPAsset::ObjCache::Write(const std::filesystem::path &InPath, const Obj &InObj, const uint64_t InSourceHash, const uint64_t InSourceSize)
+{
+    try
+    {
+        ///< Strings: the object's own, then one per texture
+        const std::filesystem::path *pTextures[TEXTURE_COUNT] = {&InObj.pBaseTex, &InObj.pNormalTex, &InObj.pMaterialTex, &InObj.pLitTex,
+                                                                 &InObj.pDrapedBaseTex, &InObj.pDrapedNormalTex, &InObj.pDrapedMaterialTex};
+        const bool bHasTextures[TEXTURE_COUNT] = {InObj.bHasBaseTex, InObj.bHasNormalTex, InObj.bHasMaterialTex, InObj.bHasLitTex,
+                                                  InObj.bHasDrapedBaseTex, InObj.bHasDrapedNormalTex, InObj.bHasDrapedMaterialTex};
+
+        std::vector<uint32_t> vctStringOffsets;
+        std::string strStringData;
+        vctStringOffsets.reserve(InObj.Strings.size() + TEXTURE_COUNT + 1);
+        for (const auto &strString : InObj.Strings)
+        {
+            vctStringOffsets.push_back(static_cast<uint32_t>(strStringData.size()));
+            strStringData += strString;
+        }
+
+        CacheHeader Header{};
+        for (uint32_t i = 0; i < TEXTURE_COUNT; ++i)
+        {
+            vctStringOffsets.push_back(static_cast<uint32_t>(strStringData.size()));
+            strStringData += PathToString(*pTextures[i]);
+            if (bHasTextures[i])
+                Header.intTextureMask |= 1u << i;
+        }
+        vctStringOffsets.push_back(static_cast<uint32_t>(strStringData.size()));
+
+        std::memcpy(Header.Magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        Header.intVersion = VERSION;
+        Header.intSectionCount = SECTION_COUNT;
+        Header.intSourceHash = InSourceHash;
+        Header.intSourceSize = InSourceSize;
+        Header.dblNormalScale = InObj.dblNormalScale;
+        Header.dblDrapedNormalScale = InObj.dblDrapedNormalScale;
+        Header.intLayerGroup = InObj.intLayerGroup;
+        Header.intObjStringCount = static_cast<uint32_t>(InObj.Strings.size());
+
+        ///< Lay the sections out back to back, each starting on 8 bytes
+        const std::pair<const void *, size_t> Sections[SECTION_COUNT] = {
+            {InObj.Vertices.data(), InObj.Vertices.size()},       {InObj.LineVertices.data(), InObj.LineVertices.size()},
+            {InObj.LightVertices.data(), InObj.LightVertices.size()}, {InObj.Indices.data(), InObj.Indices.size()},
+            {InObj.DrawCalls.data(), InObj.DrawCalls.size()},     {InObj.Commands.data(), InObj.Commands.size()},
+            {InObj.Animations.data(), InObj.Animations.size()},   {InObj.AnimKeys.data(), InObj.AnimKeys.size()},
+            {InObj.Lights.data(), InObj.Lights.size()},           {InObj.Lods.data(), InObj.Lods.size()},
+            {vctStringOffsets.data(), vctStringOffsets.size()},   {strStringData.data(), strStringData.size()}};
+
+        size_t intOffset = sizeof(CacheHeader);
+        for (uint32_t i = 0; i < SECTION_COUNT; ++i)
+        {
+            Header.Sections[i].intOffset = intOffset;
+            Header.Sections[i].intCount = Sections[i].second;
+            intOffset = AlignUp(intOffset + Sections[i].second * SECTION_ELEMENT_SIZE[i]);
+        }
+
+        std::vector<char> vctBuffer(intOffset, 0);
+        std::memcpy(vctBuffer.data(), &Header, sizeof(Header));
+        for (uint32_t i = 0; i < SECTION_COUNT; ++i)
+        {
+            if (Sections[i].second)
+                std::memcpy(vctBuffer.data() + Header.Sections[i].intOffset, Sections[i].first, Sections[i].second * SECTION_ELEMENT_SIZE[i]);
+        }
+
+        ///< Unique temporary name, so two writers of the same entry cannot interleave
+        std::filesystem::path pTemp = InPath;
+        pTemp += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        {
+            std::ofstream File(pTemp, std::ios::binary | std::ios::trunc);
+            if (!File.is_open())
+                return false;
+            File.write(vctBuffer.data(), static_cast<std::streamsize>(vctBuffer.size()));
+            if (!File.good())
+                return false;
+        }
+
+        std::error_code ErrorCode;
+        std::filesystem::rename(pTemp, InPath, ErrorCode);
+        if (ErrorCode)
+        {
+            std::filesystem::remove(pTemp, ErrorCode);
+            return false;
+        }
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+/**
+* @brief Reads an entry into OutObj
+*/
+bool XPAsset::ObjCache::Read(const std::filesystem::path &InPath, Obj &OutObj, const uint64_t InSourceHash, const uint64_t InSourceSize)
+{
+    try
+    {
+        OutObj.Clear();
+
+        FileMapping Entry;
+        if (!Entry.Open(InPath))
+            return false;
+        const std::string_view strEntry = Entry.View();
+        if (strEntry.size() < sizeof(CacheHeader))
+            return false;
+
+        CacheHeader Header;
+        std::memcpy(&Header, strEntry.data(), sizeof(Header));
+        if (std::memcmp(Header.Magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || Header.intVersion != VERSION || Header.intSectionCount != SECTION_COUNT ||
+            Header.intSourceHash != InSourceHash || Header.intSourceSize != InSourceSize)
+            return false;
+
+        ///< Every section has to be aligned and inside the file
+        for (uint32_t i = 0; i < SECTION_COUNT; ++i)
+        {
+            const CacheSection &Section = Header.Sections[i];
+            if (Section.intOffset % 4 != 0 || Section.intOffset > strEntry.size() || Section.intCount > (strEntry.size() - Section.intOffset) / SECTION_ELEMENT_SIZE[i])
+                return false;
+        }
+
+        ///< Strings: offsets must be ascending and end at the data size
+        const CacheSection &OffsetSection = Header.Sections[SECTION_STRING_OFFSETS];
+        const CacheSection &DataSection = Header.Sections[SECTION_STRING_DATA];
+        const size_t intStringCount = static_cast<size_t>(Header.intObjStringCount) + TEXTURE_COUNT;
+        if (OffsetSection.intCount != intStringCount + 1)
+            return false;
+
+        std::vector<uint32_t> vctStringOffsets;
+        CopySection(strEntry.data(), OffsetSection, vctStringOffsets);
+        if (vctStringOffsets.front() != 0 || vctStringOffsets.back() != DataSection.intCount)
+            return false;
+        for (size_t i = 1; i < vctStringOffsets.size(); ++i)
+        {
+            if (vctStringOffsets[i] < vctStringOffsets[i - 1])
+                return false;
+        }
+
+        const std::string_view strStringData = strEntry.substr(static_cast<size_t>(DataSection.intOffset), static_cast<size_t>(DataSection.intCount));
+        const auto GetCachedString = [&](const size_t InIndex) { return strStringData.substr(vctStringOffsets[InIndex], vctStringOffsets[InIndex + 1] - vctStringOffsets[InIndex]); };
+
+        CopySection(strEntry.data(), Header.Sections[SECTION_VERTICES], OutObj.Vertices);
+        CopySection(strEntry.data(), Header.Sections[SECTION_LINE_VERTICES], OutObj.LineVertices);
+        CopySection(strEntry.data(), Header.Sections[SECTION_LIGHT_VERTICES], OutObj.LightVertices);
+        CopySection(strEntry.data(), Header.Sections[SECTION_INDICES], OutObj.Indices);
+        CopySection(strEntry.data(), Header.Sections[SECTION_DRAW_CALLS], OutObj.DrawCalls);
+        CopySection(strEntry.data(), Header.Sections[SECTION_COMMANDS], OutObj.Commands);
+        CopySection(strEntry.data(), Header.Sections[SECTION_ANIMATIONS], OutObj.Animations);
+        CopySection(strEntry.data(), Header.Sections[SECTION_ANIM_KEYS], OutObj.AnimKeys);
+        CopySection(strEntry.data(), Header.Sections[SECTION_LIGHTS], OutObj.Lights);
+        CopySection(strEntry.data(), Header.Sections[SECTION_LODS], OutObj.Lods);
+
+        OutObj.Strings.reserve(Header.intObjStringCount);
+        for (size_t i = 0; i < Header.intObjStringCount; ++i)
+            OutObj.Strings.emplace_back(GetCachedString(i));
+
+        std::filesystem::path *pTextures[TEXTURE_COUNT] = {&OutObj.pBaseTex, &OutObj.pNormalTex, &OutObj.pMaterialTex, &OutObj.pLitTex,
+                                                           &OutObj.pDrapedBaseTex, &OutObj.pDrapedNormalTex, &OutObj.pDrapedMaterialTex};
+        bool *pHasTextures[TEXTURE_COUNT] = {&OutObj.bHasBaseTex, &OutObj.bHasNormalTex, &OutObj.bHasMaterialTex, &OutObj.bHasLitTex,
+                                             &OutObj.bHasDrapedBaseTex, &OutObj.bHasDrapedNormalTex, &OutObj.bHasDrapedMaterialTex};
+        for (uint32_t i = 0; i < TEXTURE_COUNT; ++i)
+        {
+            *pTextures[i] = StringToPath(GetCachedString(Header.intObjStringCount + i));
+            *pHasTextures[i] = (Header.intTextureMask & (1u << i)) != 0;
+        }
+
+        OutObj.dblNormalScale = Header.dblNormalScale;
+        OutObj.dblDrapedNormalScale = Header.dblDrapedNormalScale;
+        OutObj.intLayerGroup = Header.intLayerGroup;
+
+        ///< The hash guards against stale entries, this against damaged ones
+        if (!OutObj.Validate())
+        {
+            OutObj.Clear();
+            return false;
+        }
+        return true;
+    }
+    catch (...)
+    {
+        OutObj.Clear();
+        return false;
+    }
+}
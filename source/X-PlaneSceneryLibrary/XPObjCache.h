@@ -0,0 +1,96 @@
+//Module:	XPObjCache
+//Author:	Connor Russell
+//Date:		10/18/2026 10:12:31 AM
+//Purpose:	Compiled binary cache of parsed obj8 files
+#pragma once
+#include "XPObj.h"
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace XPAsset
+{
+    /**
+     * @brief Counters and timings of an ObjCache, accumulated over every Load
+     */
+    struct ObjCacheStats
+    {
+        uint32_t intHits{0};
+        uint32_t intMisses{0};          ///< Objects that had to be parsed from text
+        uint32_t intWriteFailures{0};   ///< Misses whose entry could not be saved. The object still loaded
+        double dblHashMs{0};            ///< Mapping and hashing the .obj files
+        double dblParseMs{0};           ///< Text parsing on misses
+        double dblReadMs{0};            ///< Reading entries on hits
+        double dblWriteMs{0};           ///< Writing entries on misses
+    };
+
+    /**
+     * @brief Compiled obj8 cache
+     *
+     * Every object is parsed once and written as a ".objc" entry named after a hash of the .obj contents, so edited
+     * objects get a new entry and identical objects in different packages share one. An entry is the Obj tables
+     * as raw little endian arrays behind a small header, so loading one is a file mapping and a copy per table with
+     * no text parsing at all. The directory is meant to live in the project cache, e.g. Project::GetCacheDirectory() / "objc".
+     *
+     * This is a library facility only for now. The editor has no OBJ8 load path yet, so nothing loads objects through it.
+     *
+     * Not thread safe. Threads loading objects in parallel should each use their own ObjCache over the same directory.
+     */
+    class ObjCache
+    {
+    public:
+        static constexpr uint32_t VERSION = 1;
+
+        explicit ObjCache(std::filesystem::path InDirectory);
+
+        /**
+         * @brief Loads an obj, from its cache entry if there is one, otherwise from text, then saves the entry
+		 *
+		 * @param InPath = Path to the obj
+		 * @param OutObj = Object to load into
+		 * @returns True on success, false if the obj could not be read or parsed
+         */
+        bool Load(const std::filesystem::path &InPath, Obj &OutObj);
+
+        /**
+         * @brief Returns the path of the entry for a given source hash
+         */
+        std::filesystem::path GetEntryPath(uint64_t InHash) const;
+
+        const std::filesystem::path &GetDirectory() const { return pDirectory; }
+        const ObjCacheStats &GetStats() const { return Stats; }
+        void ResetStats() { Stats = {}; }
+
+        /**
+         * @brief Hashes the contents of an obj. This is the cache key
+         */
+        static uint64_t Hash(std::string_view InBytes);
+
+        /**
+         * @brief Writes an entry. Goes through a temporary file so readers never see a partial entry
+		 *
+		 * @param InPath = Path of the entry
+		 * @param InObj = The parsed object
+		 * @param InSourceHash = Hash of the obj text it was parsed from
+		 * @param InSourceSize = Size of the obj text in bytes
+		 * @returns True on success, false on failure
+         */
+        static bool Write(const std::filesystem::path &InPath, const Obj &InObj, uint64_t InSourceHash, uint64_t InSourceSize);
+
+        /**
+         * @brief Reads an entry into OutObj
+		 *
+		 * @param InPath = Path of the entry
+		 * @param OutObj = Object to load into. Left cleared on failure
+		 * @param InSourceHash = Expected source hash
+		 * @param InSourceSize = Expected source size
+		 * @returns True on success, false if the entry is missing, from another version, for other source or damaged
+         */
+        static bool Read(const std::filesystem::path &InPath, Obj &OutObj, uint64_t InSourceHash, uint64_t InSourceSize);
+
+    private:
+        std::filesystem::path pDirectory;
+        ObjCacheStats Stats;
+    };
+
+}
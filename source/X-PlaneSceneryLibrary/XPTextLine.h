@@ -0,0 +1,126 @@
+//Module:	XPTextLine
+//Author:	Connor Russell
+//Date:		10/18/2026
+//Purpose:	Line tokenizing and number parsing shared by the text asset parsers (obj, fac, for, lin, net)
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+
+namespace XPAsset::Text
+{
+    constexpr size_t MAX_TOKENS = 32;
+
+    /**
+     * @brief One whitespace separated line of a text asset. Tokens are views into the text being parsed
+     */
+    struct TextLine
+    {
+        std::string_view strLine;
+        std::string_view Tokens[MAX_TOKENS];
+        size_t intCount{0};
+
+        std::string_view Token(const size_t InIndex) const { return InIndex < intCount ? Tokens[InIndex] : std::string_view(); }
+    };
+
+    inline bool IsSpace(const char InChar)
+    {
+        return InChar == ' ' || InChar == '\t' || InChar == '\r' || InChar == '\n' || InChar == '\f' || InChar == '\v';
+    }
+
+    /**
+     * @brief Splits a line into whitespace separated tokens. Tokens past MAX_TOKENS are only reachable through RestOfLine()
+     */
+    inline void TokenizeLine(const std::string_view InLine, TextLine &OutLine)
+    {
+        OutLine.strLine = InLine;
+        OutLine.intCount = 0;
+
+        size_t intPos = 0;
+        while (OutLine.intCount < MAX_TOKENS)
+        {
+            while (intPos < InLine.size() && IsSpace(InLine[intPos]))
+                ++intPos;
+            if (intPos >= InLine.size())
+                break;
+
+            const size_t intStart = intPos;
+            while (intPos < InLine.size() && !IsSpace(InLine[intPos]))
+                ++intPos;
+            OutLine.Tokens[OutLine.intCount++] = InLine.substr(intStart, intPos - intStart);
+        }
+    }
+
+    /**
+     * @brief Tokenizes the line starting at IOPos and moves IOPos past it
+     *
+     * @returns False once the text is exhausted
+     */
+    inline bool NextLine(const std::string_view InText, size_t &IOPos, TextLine &OutLine)
+    {
+        if (IOPos >= InText.size())
+            return false;
+
+        size_t intEnd = InText.find('\n', IOPos);
+        if (intEnd == std::string_view::npos)
+            intEnd = InText.size();
+        TokenizeLine(InText.substr(IOPos, intEnd - IOPos), OutLine);
+        IOPos = intEnd + 1;
+        return true;
+    }
+
+    /**
+     * @brief Returns token InIndex and everything after it, with trailing whitespace removed. Used for paths and free text
+     */
+    inline std::string_view RestOfLine(const TextLine &InLine, const size_t InIndex)
+    {
+        if (InIndex >= InLine.intCount)
+            return {};
+
+        std::string_view strRest = InLine.strLine.substr(InLine.Tokens[InIndex].data() - InLine.strLine.data());
+        while (!strRest.empty() && IsSpace(strRest.back()))
+            strRest.remove_suffix(1);
+        return strRest;
+    }
+
+    inline bool ParseFloat(std::string_view InToken, float &OutValue)
+    {
+        ///< from_chars does not accept a leading plus sign
+        if (!InToken.empty() && InToken.front() == '+')
+            InToken.remove_prefix(1);
+
+        const auto Result = std::from_chars(InToken.data(), InToken.data() + InToken.size(), OutValue);
+        return Result.ec == std::errc() && Result.ptr == InToken.data() + InToken.size();
+    }
+
+    inline bool ParseUint(const std::string_view InToken, uint32_t &OutValue)
+    {
+        const auto Result = std::from_chars(InToken.data(), InToken.data() + InToken.size(), OutValue);
+        return Result.ec == std::errc() && Result.ptr == InToken.data() + InToken.size();
+    }
+
+    /**
+     * @brief Reads InCount floats starting at token InFirst
+     *
+     * @returns False if a token is missing or not a number
+     */
+    inline bool ReadFloats(const TextLine &InLine, const size_t InFirst, const size_t InCount, float *OutValues)
+    {
+        if (InFirst + InCount > InLine.intCount)
+            return false;
+
+        for (size_t i = 0; i < InCount; ++i)
+        {
+            if (!ParseFloat(InLine.Tokens[InFirst + i], OutValues[i]))
+                return false;
+        }
+        return true;
+    }
+
+    inline bool EqualsIgnoreCase(const std::string_view InA, const std::string_view InB)
+    {
+        return std::ranges::equal(InA, InB, [](const char A, const char B) { return std::tolower(static_cast<unsigned char>(A)) == std::tolower(static_cast<unsigned char>(B)); });
+    }
+} // namespace XPAsset::Text
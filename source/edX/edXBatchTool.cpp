@@ -0,0 +1,181 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXBatchTool.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+
+#include "edXManager.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// ----------------------------------------------------------------------------
+
+namespace
+{
+    void print_usage()
+    {
+        std::cout <<
+            "Usage: edXBatch [options] <file or directory>...\n"
+            "\n"
+            "Processes .edX projects and .lib/.edxlib libraries concurrently. Directories\n"
+            "are searched recursively for both.\n"
+            "\n"
+            "Options:\n"
+            "  --validate          Load and validate each file (default)\n"
+            "  --resave            Load and save each file in the current format\n"
+            "  --convert-legacy    Convert legacy projects\n"
+            "  --out <dir>         Write resaved or converted files here instead of over the input\n"
+            "  --jobs <n>          Worker threads (default: hardware concurrency)\n"
+            "  --memory <MB>       Input megabytes loaded at once (default: 512)\n"
+            "  --binary            Read and write .edXb companions\n"
+            "  --quiet             Print only failures and the totals\n";
+    }
+
+    bool is_edx_file(const std::filesystem::path& path)
+    {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".edx" || extension == ".lib" || extension == ".edxlib";
+    }
+
+} // namespace
+
+/// ----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    edx::BatchOperation operation = edx::BATCH_VALIDATE;
+    edx::BatchOptions options;
+    std::filesystem::path outputDir;
+    std::vector<std::filesystem::path> inputs;
+    bool binaryCompanion = false;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--validate")
+            operation = edx::BATCH_VALIDATE;
+        else if (arg == "--resave")
+            operation = edx::BATCH_RESAVE;
+        else if (arg == "--convert-legacy")
+            operation = edx::BATCH_CONVERT_LEGACY;
+        else if (arg == "--out" && hasValue)
+            outputDir = argv[++i];
+        else if (arg == "--jobs" && hasValue)
+            options.workerCount = static_cast<unsigned>(std::max(0, std::atoi(argv[++i])));
+        else if (arg == "--memory" && hasValue)
+            options.memoryBudget = static_cast<uint64_t>(std::max(1, std::atoi(argv[++i]))) << 20;
+        else if (arg == "--binary")
+            binaryCompanion = true;
+        else if (arg == "--quiet")
+            quiet = true;
+        else if (arg == "--help" || arg == "-h")
+        {
+            print_usage();
+            return 0;
+        }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            std::cerr << "Unknown option: " << arg << "\n\n";
+            print_usage();
+            return 2;
+        }
+        else
+            inputs.emplace_back(arg);
+    }
+
+    if (inputs.empty())
+    {
+        print_usage();
+        return 2;
+    }
+
+    // Collect the files, sorted within each directory so runs are repeatable
+    std::vector<edx::BatchJob> jobs;
+    const auto add_job = [&](const std::filesystem::path& path)
+    {
+        edx::BatchJob job;
+        job.operation = operation;
+        job.inputPath = path.string();
+        if (!outputDir.empty())
+            job.outputPath = (outputDir / path.filename()).string();
+        jobs.push_back(std::move(job));
+    };
+
+    for (const auto& input : inputs)
+    {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(input, ec))
+        {
+            add_job(input);
+            continue;
+        }
+
+        std::vector<std::filesystem::path> found;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(input, ec))
+        {
+            if (entry.is_regular_file() && is_edx_file(entry.path()))
+                found.push_back(entry.path());
+        }
+        std::sort(found.begin(), found.end());
+        for (const auto& path : found)
+            add_job(path);
+    }
+
+    if (!outputDir.empty())
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(outputDir, ec);
+    }
+
+    edx::EdxManager manager;
+    manager.set_binary_companion(binaryCompanion);
+
+    // Progress while the batch runs; the callback is never called concurrently
+    size_t done = 0;
+    if (!quiet)
+    {
+        options.fileDone = [&done, total = jobs.size()](const edx::BatchFileResult& result)
+        {
+            std::cout << "[" << ++done << "/" << total << "] " << result.inputPath << std::endl;
+        };
+    }
+
+    const edx::BatchReport report = manager.process_batch(jobs, options);
+
+    if (quiet)
+    {
+        for (const auto& result : report.files)
+        {
+            if (result.success)
+                continue;
+            std::cout << "FAILED " << result.inputPath << "\n";
+            for (const auto& error : result.errors)
+                std::cout << "       " << error << "\n";
+        }
+        std::cout << report.files.size() << " files, " << report.failed << " failed, "
+                  << report.get_files_per_second() << " files/s" << std::endl;
+    }
+    else
+    {
+        std::cout << "\n" << report.get_summary();
+    }
+
+    return report.failed == 0 ? 0 : 1;
+}
+
+/// ----------------------------------------------------------------------------
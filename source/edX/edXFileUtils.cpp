@@ -0,0 +1,119 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXFileUtils.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include "edXFileUtils.h"
+#include <cstring>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+#if defined(_WIN32)
+    #include <fcntl.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    bool sync_file(const std::filesystem::path& path)
+    {
+#if defined(_WIN32)
+        const int fd = _wopen(path.c_str(), _O_WRONLY | _O_BINARY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        const bool ok = _commit(fd) == 0;
+        _close(fd);
+        return ok;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        const bool ok = ::fsync(fd) == 0;
+        ::close(fd);
+        return ok;
+#endif
+    }
+
+    bool sync_file(std::FILE* file)
+    {
+        if (std::fflush(file) != 0)
+        {
+            return false;
+        }
+#if defined(_WIN32)
+        return _commit(_fileno(file)) == 0;
+#else
+        return ::fsync(fileno(file)) == 0;
+#endif
+    }
+
+    bool replace_file(const std::filesystem::path& from, const std::filesystem::path& to, std::string* error)
+    {
+        std::error_code ec;
+        std::filesystem::rename(from, to, ec);
+        if (ec && error)
+        {
+            *error = "Cannot replace " + to.string() + ": " + ec.message();
+        }
+        return !ec;
+    }
+
+    std::optional<uint64_t> hash_file(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            return std::nullopt;
+        }
+
+        constexpr uint64_t OFFSET_BASIS = 0xcbf29ce484222325ull;
+        constexpr uint64_t PRIME = 0x100000001b3ull;
+
+        uint64_t hash = OFFSET_BASIS;
+        std::vector<char> block(size_t(1) << 20);
+        while (file)
+        {
+            file.read(block.data(), static_cast<std::streamsize>(block.size()));
+            const size_t count = static_cast<size_t>(file.gcount());
+
+            // Whole words first; only the last block of the file can have a tail
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, block.data() + i, 8);
+                hash = (hash ^ word) * PRIME;
+            }
+            for (; i < count; ++i)
+            {
+                hash = (hash ^ static_cast<unsigned char>(block[i])) * PRIME;
+            }
+        }
+
+        if (file.bad())
+        {
+            return std::nullopt;
+        }
+        return hash;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
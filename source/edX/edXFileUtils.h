@@ -0,0 +1,58 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXFileUtils.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include "edXConfig.h"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    /**
+     * @brief Flushes a written file through to the disk
+     *
+     * Call after the file is closed and before renaming it over a file it
+     * replaces, so the rename never exposes a file whose data is still in
+     * the OS cache.
+     *
+     * @return False if the file cannot be opened or flushed
+     */
+    EDX_API bool sync_file(const std::filesystem::path& path);
+
+    /**
+     * @brief Flushes an open stdio file through to the disk
+     */
+    EDX_API bool sync_file(std::FILE* file);
+
+    /**
+     * @brief Renames a file over another one, replacing it in a single step
+     */
+    EDX_API bool replace_file(const std::filesystem::path& from, const std::filesystem::path& to, std::string* error = nullptr);
+
+    /**
+     * @brief 64 bit FNV-1a hash of a file's contents, taken a word at a time
+     *
+     * Identifies which version of a project file a journal was written
+     * against. Not a cryptographic hash.
+     *
+     * @return Nothing if the file cannot be read
+     */
+    EDX_API std::optional<uint64_t> hash_file(const std::filesystem::path& path);
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,495 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXGeoIndex.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+
+#include "edXGeoIndex.h"
+#include "edXProjectFile.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+        double clamp_latitude(double lat)
+        {
+            return std::clamp(lat, -90.0, 90.0);
+        }
+
+        double clamp_longitude(double lon)
+        {
+            return std::clamp(lon, -180.0, 180.0);
+        }
+
+        /// Longitude difference wrapped to [-180, 180]
+        double wrap_delta_lon(double delta)
+        {
+            delta = std::fmod(delta, 360.0);
+            if (delta > 180.0)
+                delta -= 360.0;
+            else if (delta < -180.0)
+                delta += 360.0;
+            return delta;
+        }
+
+        /// Closest distance from a point to the part of a meridian between two latitudes
+        double distance_to_meridian(double lat, double lon, double meridian, double minLat, double maxLat)
+        {
+            const double phi = lat * DEG_TO_RAD;
+            const double deltaLon = wrap_delta_lon(lon - meridian) * DEG_TO_RAD;
+
+            // Foot of the perpendicular on the full meridian great circle. The distance along
+            // the segment has no other interior minimum, so the answer is there or at an end.
+            const double foot = std::atan2(std::sin(phi), std::cos(phi) * std::cos(deltaLon)) / DEG_TO_RAD;
+            const double candidates[] = { std::clamp(foot, minLat, maxLat), minLat, maxLat };
+
+            double best = GeoIndex::distance_meters(lat, lon, candidates[0], meridian);
+            for (int i = 1; i < 3; ++i)
+                best = std::min(best, GeoIndex::distance_meters(lat, lon, candidates[i], meridian));
+            return best;
+        }
+    }
+
+    // GeoBounds
+
+    bool GeoBounds::contains(double lat, double lon) const
+    {
+        if (lat < minLat || lat > maxLat)
+            return false;
+        if (crosses_antimeridian())
+            return lon >= minLon || lon <= maxLon;
+        return lon >= minLon && lon <= maxLon;
+    }
+
+    // GeoIndex
+
+    bool GeoIndex::Node::contains(double lat, double lon) const
+    {
+        // Half open cells, closed on the outer edge of the world so 90N and 180E are covered.
+        const bool inLat = lat >= minLat && (lat < maxLat || maxLat == 90.0);
+        const bool inLon = lon >= minLon && (lon < maxLon || maxLon == 180.0);
+        return inLat && inLon;
+    }
+
+    GeoIndex::GeoIndex()
+    {
+        clear();
+    }
+
+    void GeoIndex::clear()
+    {
+        m_nodes.clear();
+        m_nodes.emplace_back();
+        m_freeNodes.clear();
+        m_slots.clear();
+        m_freeSlots.clear();
+        m_slotLookup.clear();
+        m_skippedCount = 0;
+    }
+
+    void GeoIndex::build(const std::vector<SceneAsset>& assets)
+    {
+        clear();
+        m_slots.reserve(assets.size());
+        m_slotLookup.reserve(assets.size());
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            if (assets[i].id.empty() || !insert(assets[i].id, assets[i].latitude, assets[i].longitude, i))
+                ++m_skippedCount;
+        }
+    }
+
+    bool GeoIndex::insert(const std::string& id, double latitude, double longitude, size_t assetIndex)
+    {
+        if (m_slotLookup.count(id))
+            return false;
+
+        uint32_t slot;
+        if (!m_freeSlots.empty())
+        {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        Slot& entry = m_slots[slot];
+        entry.id = id;
+        entry.latitude = clamp_latitude(latitude);
+        entry.longitude = clamp_longitude(longitude);
+        entry.assetIndex = assetIndex;
+        m_slotLookup.emplace(id, slot);
+
+        add_to_leaf(find_leaf(entry.latitude, entry.longitude), slot);
+        return true;
+    }
+
+    bool GeoIndex::move(const std::string& id, double latitude, double longitude)
+    {
+        const auto it = m_slotLookup.find(id);
+        if (it == m_slotLookup.end())
+            return false;
+
+        const uint32_t slot = it->second;
+        const double lat = clamp_latitude(latitude);
+        const double lon = clamp_longitude(longitude);
+
+        // Small moves usually stay inside the same cell.
+        const uint32_t oldLeaf = m_slots[slot].node;
+        m_slots[slot].latitude = lat;
+        m_slots[slot].longitude = lon;
+        if (m_nodes[oldLeaf].contains(lat, lon))
+            return true;
+
+        remove_from_leaf(slot);
+        add_to_leaf(find_leaf(lat, lon), slot);
+        if (m_nodes[oldLeaf].parent != INVALID)
+            try_merge(m_nodes[oldLeaf].parent);
+        return true;
+    }
+
+    bool GeoIndex::remove(const std::string& id)
+    {
+        const auto it = m_slotLookup.find(id);
+        if (it == m_slotLookup.end())
+            return false;
+
+        const uint32_t slot = it->second;
+        const uint32_t leaf = m_slots[slot].node;
+        remove_from_leaf(slot);
+        if (m_nodes[leaf].parent != INVALID)
+            try_merge(m_nodes[leaf].parent);
+
+        m_slotLookup.erase(it);
+        m_slots[slot].id.clear();
+        m_slots[slot].node = INVALID;
+        m_freeSlots.push_back(slot);
+        return true;
+    }
+
+    bool GeoIndex::set_asset_index(const std::string& id, size_t assetIndex)
+    {
+        const auto it = m_slotLookup.find(id);
+        if (it == m_slotLookup.end())
+            return false;
+        m_slots[it->second].assetIndex = assetIndex;
+        return true;
+    }
+
+    std::optional<size_t> GeoIndex::find(const std::string& id) const
+    {
+        const auto it = m_slotLookup.find(id);
+        if (it == m_slotLookup.end())
+            return std::nullopt;
+        return m_slots[it->second].assetIndex;
+    }
+
+    double GeoIndex::distance_meters(double lat1, double lon1, double lat2, double lon2)
+    {
+        const double phi1 = lat1 * DEG_TO_RAD;
+        const double phi2 = lat2 * DEG_TO_RAD;
+        const double sinLat = std::sin((phi2 - phi1) * 0.5);
+        const double sinLon = std::sin(wrap_delta_lon(lon2 - lon1) * DEG_TO_RAD * 0.5);
+        const double h = sinLat * sinLat + std::cos(phi1) * std::cos(phi2) * sinLon * sinLon;
+        return 2.0 * EARTH_RADIUS_METERS * std::asin(std::sqrt(std::min(1.0, h)));
+    }
+
+    // Tree maintenance
+
+    uint32_t GeoIndex::find_leaf(double lat, double lon) const
+    {
+        uint32_t node = 0;
+        while (!m_nodes[node].is_leaf())
+        {
+            const Node& current = m_nodes[node];
+            const double midLat = (current.minLat + current.maxLat) * 0.5;
+            const double midLon = (current.minLon + current.maxLon) * 0.5;
+            node = current.firstChild + (lat >= midLat ? 2u : 0u) + (lon >= midLon ? 1u : 0u);
+        }
+        return node;
+    }
+
+    void GeoIndex::add_to_leaf(uint32_t leaf, uint32_t slot)
+    {
+        m_slots[slot].node = leaf;
+        m_nodes[leaf].slots.push_back(slot);
+        for (uint32_t node = leaf; node != INVALID; node = m_nodes[node].parent)
+            ++m_nodes[node].count;
+
+        if (m_nodes[leaf].slots.size() > NODE_CAPACITY && m_nodes[leaf].depth < MAX_DEPTH)
+            split(leaf);
+    }
+
+    void GeoIndex::remove_from_leaf(uint32_t slot)
+    {
+        const uint32_t leaf = m_slots[slot].node;
+        std::vector<uint32_t>& slots = m_nodes[leaf].slots;
+        const auto it = std::find(slots.begin(), slots.end(), slot);
+        *it = slots.back();
+        slots.pop_back();
+
+        for (uint32_t node = leaf; node != INVALID; node = m_nodes[node].parent)
+            --m_nodes[node].count;
+    }
+
+    void GeoIndex::split(uint32_t node)
+    {
+        uint32_t first;
+        if (!m_freeNodes.empty())
+        {
+            first = m_freeNodes.back();
+            m_freeNodes.pop_back();
+        }
+        else
+        {
+            first = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.resize(m_nodes.size() + 4);
+        }
+
+        const Node parent = { m_nodes[node].minLat, m_nodes[node].minLon, m_nodes[node].maxLat, m_nodes[node].maxLon,
+                              INVALID, INVALID, 0, m_nodes[node].depth, {} };
+        const double midLat = (parent.minLat + parent.maxLat) * 0.5;
+        const double midLon = (parent.minLon + parent.maxLon) * 0.5;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            Node& child = m_nodes[first + i];
+            child.minLat = (i & 2) ? midLat : parent.minLat;
+            child.maxLat = (i & 2) ? parent.maxLat : midLat;
+            child.minLon = (i & 1) ? midLon : parent.minLon;
+            child.maxLon = (i & 1) ? parent.maxLon : midLon;
+            child.firstChild = INVALID;
+            child.parent = node;
+            child.count = 0;
+            child.depth = parent.depth + 1;
+            child.slots.clear();
+        }
+
+        std::vector<uint32_t> slots = std::move(m_nodes[node].slots);
+        m_nodes[node].slots = {};
+        m_nodes[node].firstChild = first;
+        for (const uint32_t slot : slots)
+        {
+            const uint32_t child = find_leaf(m_slots[slot].latitude, m_slots[slot].longitude);
+            m_slots[slot].node = child;
+            m_nodes[child].slots.push_back(slot);
+            ++m_nodes[child].count;
+        }
+
+        // Clustered assets can all land in one quadrant.
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            const uint32_t child = first + i;
+            if (m_nodes[child].slots.size() > NODE_CAPACITY && m_nodes[child].depth < MAX_DEPTH)
+                split(child);
+        }
+    }
+
+    void GeoIndex::try_merge(uint32_t node)
+    {
+        // Merge at the highest ancestor that has become sparse.
+        uint32_t target = INVALID;
+        for (uint32_t current = node; current != INVALID; current = m_nodes[current].parent)
+        {
+            if (!m_nodes[current].is_leaf() && m_nodes[current].count <= NODE_CAPACITY / 2)
+                target = current;
+        }
+        if (target == INVALID)
+            return;
+
+        std::vector<uint32_t> slots;
+        slots.reserve(m_nodes[target].count);
+
+        std::vector<uint32_t> stack = { m_nodes[target].firstChild };
+        while (!stack.empty())
+        {
+            const uint32_t first = stack.back();
+            stack.pop_back();
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                Node& child = m_nodes[first + i];
+                if (child.is_leaf())
+                    slots.insert(slots.end(), child.slots.begin(), child.slots.end());
+                else
+                    stack.push_back(child.firstChild);
+                child.slots = {};
+                child.firstChild = INVALID;
+            }
+            m_freeNodes.push_back(first);
+        }
+
+        for (const uint32_t slot : slots)
+            m_slots[slot].node = target;
+        m_nodes[target].slots = std::move(slots);
+        m_nodes[target].firstChild = INVALID;
+    }
+
+    // Queries
+
+    void GeoIndex::collect(uint32_t node, std::vector<size_t>& out) const
+    {
+        const Node& current = m_nodes[node];
+        if (current.is_leaf())
+        {
+            for (const uint32_t slot : current.slots)
+                out.push_back(m_slots[slot].assetIndex);
+            return;
+        }
+        for (uint32_t i = 0; i < 4; ++i)
+            collect(current.firstChild + i, out);
+    }
+
+    void GeoIndex::query_box_impl(uint32_t node, const GeoBounds& bounds, std::vector<size_t>& out) const
+    {
+        const Node& current = m_nodes[node];
+        if (current.count == 0)
+            return;
+        if (current.maxLat < bounds.minLat || current.minLat > bounds.maxLat ||
+            current.maxLon < bounds.minLon || current.minLon > bounds.maxLon)
+            return;
+
+        if (current.minLat >= bounds.minLat && current.maxLat <= bounds.maxLat &&
+            current.minLon >= bounds.minLon && current.maxLon <= bounds.maxLon)
+        {
+            collect(node, out);
+            return;
+        }
+
+        if (current.is_leaf())
+        {
+            for (const uint32_t slot : current.slots)
+            {
+                if (bounds.contains(m_slots[slot].latitude, m_slots[slot].longitude))
+                    out.push_back(m_slots[slot].assetIndex);
+            }
+            return;
+        }
+
+        for (uint32_t i = 0; i < 4; ++i)
+            query_box_impl(current.firstChild + i, bounds, out);
+    }
+
+    void GeoIndex::query_box(const GeoBounds& bounds, std::vector<size_t>& out) const
+    {
+        if (bounds.crosses_antimeridian())
+        {
+            query_box_impl(0, { bounds.minLat, bounds.minLon, bounds.maxLat, 180.0 }, out);
+            query_box_impl(0, { bounds.minLat, -180.0, bounds.maxLat, bounds.maxLon }, out);
+            return;
+        }
+        query_box_impl(0, bounds, out);
+    }
+
+    double GeoIndex::min_distance_to_node(const Node& node, double lat, double lon) const
+    {
+        if (lon >= node.minLon && lon <= node.maxLon)
+        {
+            if (lat < node.minLat)
+                return (node.minLat - lat) * DEG_TO_RAD * EARTH_RADIUS_METERS;
+            if (lat > node.maxLat)
+                return (lat - node.maxLat) * DEG_TO_RAD * EARTH_RADIUS_METERS;
+            return 0.0;
+        }
+
+        // Outside the cell's longitudes the nearest point lies on one of its bounding meridians.
+        return std::min(distance_to_meridian(lat, lon, node.minLon, node.minLat, node.maxLat),
+                        distance_to_meridian(lat, lon, node.maxLon, node.minLat, node.maxLat));
+    }
+
+    void GeoIndex::query_radius(double latitude, double longitude, double radiusMeters, std::vector<size_t>& out) const
+    {
+        const double lat = clamp_latitude(latitude);
+        const double lon = clamp_longitude(longitude);
+
+        std::vector<uint32_t> stack = { 0 };
+        while (!stack.empty())
+        {
+            const Node& current = m_nodes[stack.back()];
+            stack.pop_back();
+            if (current.count == 0 || min_distance_to_node(current, lat, lon) > radiusMeters)
+                continue;
+
+            if (!current.is_leaf())
+            {
+                for (uint32_t i = 0; i < 4; ++i)
+                    stack.push_back(current.firstChild + i);
+                continue;
+            }
+
+            for (const uint32_t slot : current.slots)
+            {
+                if (distance_meters(lat, lon, m_slots[slot].latitude, m_slots[slot].longitude) <= radiusMeters)
+                    out.push_back(m_slots[slot].assetIndex);
+            }
+        }
+    }
+
+    void GeoIndex::query_nearest(double latitude, double longitude, size_t k, std::vector<GeoNeighbor>& out) const
+    {
+        if (k == 0)
+            return;
+
+        const double lat = clamp_latitude(latitude);
+        const double lon = clamp_longitude(longitude);
+
+        // Best first search: cells are ordered by their closest possible asset, so once an
+        // asset reaches the front of the queue nothing unvisited can beat it.
+        struct Candidate
+        {
+            double distance;
+            uint32_t index;
+            bool isSlot;
+            bool operator>(const Candidate& other) const { return distance > other.distance; }
+        };
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> queue;
+        queue.push({ 0.0, 0, false });
+
+        size_t found = 0;
+        while (!queue.empty() && found < k)
+        {
+            const Candidate candidate = queue.top();
+            queue.pop();
+
+            if (candidate.isSlot)
+            {
+                out.push_back({ m_slots[candidate.index].assetIndex, candidate.distance });
+                ++found;
+                continue;
+            }
+
+            const Node& current = m_nodes[candidate.index];
+            if (current.is_leaf())
+            {
+                for (const uint32_t slot : current.slots)
+                    queue.push({ distance_meters(lat, lon, m_slots[slot].latitude, m_slots[slot].longitude), slot, true });
+                continue;
+            }
+
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                const uint32_t child = current.firstChild + i;
+                if (m_nodes[child].count != 0)
+                    queue.push({ min_distance_to_node(m_nodes[child], lat, lon), child, false });
+            }
+        }
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
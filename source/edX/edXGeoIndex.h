@@ -0,0 +1,202 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXGeoIndex.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "edXConfig.h"
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    struct SceneAsset;
+
+    /**
+     * @brief Latitude/longitude rectangle in degrees
+     *
+     * A box whose minLon is greater than its maxLon crosses the antimeridian,
+     * e.g. minLon = 170, maxLon = -170 covers 20 degrees around 180.
+     */
+    struct EDX_API GeoBounds
+    {
+        double minLat = -90.0;
+        double minLon = -180.0;
+        double maxLat = 90.0;
+        double maxLon = 180.0;
+
+        [[nodiscard]] bool crosses_antimeridian() const { return minLon > maxLon; }
+        [[nodiscard]] bool contains(double lat, double lon) const;
+    };
+
+    /**
+     * @brief Result of a nearest neighbour query
+     */
+    struct EDX_API GeoNeighbor
+    {
+        size_t assetIndex = 0;
+        double distanceMeters = 0.0;
+    };
+
+    /**
+     * @brief Spatial index over scene asset placements
+     *
+     * An adaptive quadtree over the whole lat/lon domain. Leaves split once they
+     * hold more than NODE_CAPACITY assets and merge back when their parent drops
+     * to half that, so the tree follows the asset density of a project: dense
+     * around terminals, a handful of cells over open terrain.
+     *
+     * Assets are keyed by their id and carry the index of the asset in
+     * EdxProject::assets, which is what queries return. Distances use a
+     * spherical earth of mean radius, which is well within placement tolerance
+     * at airport scale.
+     */
+    class EDX_API GeoIndex
+    {
+    public:
+        static constexpr uint32_t NODE_CAPACITY = 32;
+        static constexpr uint32_t MAX_DEPTH = 24;
+        static constexpr double EARTH_RADIUS_METERS = 6371008.8;
+
+        GeoIndex();
+
+        /**
+         * @brief Replace the index contents with the given assets
+         *
+         * Asset i is stored with asset index i. Assets with an empty or
+         * duplicate id are not indexed.
+         */
+        void build(const std::vector<SceneAsset>& assets);
+
+        /**
+         * @brief Add an asset to the index
+         *
+         * @return False if the id is already indexed
+         */
+        bool insert(const std::string& id, double latitude, double longitude, size_t assetIndex);
+
+        /**
+         * @brief Update the position of an indexed asset
+         *
+         * @return False if the id is not indexed
+         */
+        bool move(const std::string& id, double latitude, double longitude);
+
+        /**
+         * @brief Remove an asset from the index
+         *
+         * @return False if the id is not indexed
+         */
+        bool remove(const std::string& id);
+
+        /**
+         * @brief Change the asset index stored for an id, e.g. after the assets vector is compacted
+         */
+        bool set_asset_index(const std::string& id, size_t assetIndex);
+
+        /**
+         * @brief Look up the asset index for an id without scanning the project
+         */
+        [[nodiscard]] std::optional<size_t> find(const std::string& id) const;
+
+        [[nodiscard]] bool contains(const std::string& id) const { return m_slotLookup.count(id) != 0; }
+        [[nodiscard]] size_t size() const { return m_slotLookup.size(); }
+        [[nodiscard]] bool empty() const { return m_slotLookup.empty(); }
+        void clear();
+
+        /**
+         * @brief Assets the index accounts for, indexed or skipped by build()
+         *
+         * Differs from the size of the assets vector once assets are added to
+         * or erased from it without going through the index.
+         */
+        [[nodiscard]] size_t get_asset_count() const { return m_slotLookup.size() + m_skippedCount; }
+
+        // Queries append asset indices to the output vector, which is not cleared.
+
+        /**
+         * @brief Collect every asset inside a lat/lon box
+         */
+        void query_box(const GeoBounds& bounds, std::vector<size_t>& out) const;
+
+        /**
+         * @brief Collect every asset within a great circle distance of a point
+         */
+        void query_radius(double latitude, double longitude, double radiusMeters, std::vector<size_t>& out) const;
+
+        /**
+         * @brief Collect the k assets closest to a point, nearest first
+         */
+        void query_nearest(double latitude, double longitude, size_t k, std::vector<GeoNeighbor>& out) const;
+
+        /**
+         * @brief Great circle distance between two points in meters
+         */
+        static double distance_meters(double lat1, double lon1, double lat2, double lon2);
+
+        /**
+         * @brief Number of quadtree nodes in use, for diagnostics
+         */
+        [[nodiscard]] size_t get_node_count() const { return m_nodes.size() - m_freeNodes.size() * 4; }
+
+    private:
+        static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+        struct Node
+        {
+            double minLat = -90.0;
+            double minLon = -180.0;
+            double maxLat = 90.0;
+            double maxLon = 180.0;
+            uint32_t firstChild = INVALID;     // Four children stored contiguously
+            uint32_t parent = INVALID;
+            uint32_t count = 0;                // Assets in this subtree
+            uint32_t depth = 0;
+            std::vector<uint32_t> slots;       // Leaves only
+
+            [[nodiscard]] bool is_leaf() const { return firstChild == INVALID; }
+            [[nodiscard]] bool contains(double lat, double lon) const;
+        };
+
+        struct Slot
+        {
+            double latitude = 0.0;
+            double longitude = 0.0;
+            size_t assetIndex = 0;
+            uint32_t node = INVALID;
+            std::string id;
+        };
+
+        std::vector<Node> m_nodes;
+        std::vector<uint32_t> m_freeNodes;     // First index of unused groups of four
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+        std::unordered_map<std::string, uint32_t> m_slotLookup;
+        size_t m_skippedCount = 0;
+
+        uint32_t find_leaf(double lat, double lon) const;
+        void add_to_leaf(uint32_t leaf, uint32_t slot);
+        void remove_from_leaf(uint32_t slot);
+        void split(uint32_t node);
+        void try_merge(uint32_t node);
+        void collect(uint32_t node, std::vector<size_t>& out) const;
+        void query_box_impl(uint32_t node, const GeoBounds& bounds, std::vector<size_t>& out) const;
+        double min_distance_to_node(const Node& node, double lat, double lon) const;
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
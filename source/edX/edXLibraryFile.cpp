@@ -13,10 +13,12 @@
 
 #include "edXLibraryFile.h"
 #include "edXTimeUtils.h"
+#include "edXValidation.h"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
 #include <set>
+#include <utility>
 
 /// ----------------------------------------------------------------------------
 
@@ -129,6 +131,8 @@ namespace edx
                 objects.push_back(obj);
             }
         }
+
+        rebuild_object_index();
     }
 
     // File operations
@@ -197,62 +201,26 @@ namespace edx
 
     std::vector<std::string> LibraryFile::get_validation_errors() const
     {
-        std::vector<std::string> errors;
-
-        // Validate library info
-        if (library.name.empty())
-            errors.push_back("Library name cannot be empty");
-
-        if (library.version.empty())
-            errors.push_back("Library version cannot be empty");
-
-        if (library.author.empty())
-            errors.push_back("Library author cannot be empty");
-
-        // Validate objects
-        std::set<std::string> usedIds;
-        std::set<std::string> usedUniqueIds;
-
-        for (const auto& obj : objects) {
-            if (obj.id.empty())
-                errors.push_back("Object ID cannot be empty");
-            else
-			{
-                if (usedIds.contains(obj.id))
-                    errors.push_back("Duplicate object ID: " + obj.id);
-
-                usedIds.insert(obj.id);
-            }
-
-            if (obj.uniqueId.empty())
-                errors.push_back("Object unique ID cannot be empty");
-            else
-			{
-                if (usedUniqueIds.contains(obj.uniqueId))
-                    errors.push_back("Duplicate object unique ID: " + obj.uniqueId);
-
-                usedUniqueIds.insert(obj.uniqueId);
-            }
-
-            if (obj.assetType.empty())
-                errors.push_back("Object asset type cannot be empty for object: " + obj.id);
+        return LibraryValidator().validate(*this);
+    }
 
-            if (obj.name.empty())
-                errors.push_back("Object name cannot be empty for object: " + obj.id);
+    namespace
+    {
+        /// False once objects were appended to the vector without going through the index
+        bool index_covers(const LibraryFile& library)
+        {
+            return library.objectIndex.get_object_count() == library.objects.size();
         }
-
-        return errors;
     }
 
     // Object management
     void LibraryFile::add_object(const LibraryObject& obj)
     {
-        // Check for duplicate IDs
-        const auto it = std::ranges::find_if(objects,[&obj](const LibraryObject& existing) {
-            return existing.id == obj.id || existing.uniqueId == obj.uniqueId;
-        });
+        if (!index_covers(*this))
+            rebuild_object_index();
 
-        if (it != objects.end())
+        // Rejects duplicate IDs and unique IDs
+        if (!objectIndex.insert(obj, objects.size()))
 		{
             std::cerr << "Warning: Object with ID " << obj.id << " already exists. Not adding." << std::endl;
             return;
@@ -263,17 +231,44 @@ namespace edx
 
     bool LibraryFile::remove_object(const std::string& id)
     {
-        if (const auto it = std::ranges::find_if(objects,[&id](const LibraryObject& obj) {return obj.id == id;}); it != objects.end()) 
+        if (!index_covers(*this))
+            rebuild_object_index();
+
+        auto index = objectIndex.find(id);
+        if (index && (*index >= objects.size() || objects[*index].id != id))
         {
-            objects.erase(it);
-            return true;
+            // The objects vector was reordered directly
+            rebuild_object_index();
+            index = objectIndex.find(id);
         }
+        if (!index)
+            return false;
 
-        return false;
+        // Erase keeps the saved order of the objects; the ones after it move down a place
+        objectIndex.remove(id);
+        objects.erase(objects.begin() + static_cast<std::ptrdiff_t>(*index));
+        for (size_t i = *index; i < objects.size(); ++i)
+        {
+            // A duplicate id is not indexed; its first occurrence keeps its own position
+            if (objectIndex.find(objects[i].id) == i + 1)
+                objectIndex.set_object_index(objects[i].id, i);
+        }
+        return true;
     }
 
     LibraryObject* LibraryFile::find_object(const std::string& id)
     {
+        return const_cast<LibraryObject*>(std::as_const(*this).find_object(id));
+    }
+
+    const LibraryObject* LibraryFile::find_object(const std::string& id) const
+    {
+        if (index_covers(*this))
+        {
+            const auto index = objectIndex.find(id);
+            return index ? &objects[*index] : nullptr;
+        }
+
         const auto it = std::ranges::find_if(objects,[&id](const LibraryObject& obj)
         {
             return obj.id == id;
@@ -282,19 +277,32 @@ namespace edx
         return it != objects.end() ? &*it : nullptr;
     }
 
-    const LibraryObject* LibraryFile::find_object(const std::string& id) const
+    void LibraryFile::rebuild_object_index()
     {
-        const auto it = std::ranges::find_if(objects,[&id](const LibraryObject& obj)
+        objectIndex.build(objects);
+    }
+
+    std::vector<LibraryMatch> LibraryFile::search(const LibraryQuery& query) const
+    {
+        std::vector<LibraryMatch> matches;
+        if (index_covers(*this))
         {
-            return obj.id == id;
-        });
+            objectIndex.search(query, matches);
+            return matches;
+        }
 
-        return it != objects.end() ? &*it : nullptr;
+        LibraryIndex index;
+        index.build(objects);
+        index.search(query, matches);
+        return matches;
     }
 
     // Statistics
     std::vector<std::string> LibraryFile::get_categories() const
     {
+        if (index_covers(*this))
+            return objectIndex.get_categories();
+
         std::set<std::string> uniqueCategories;
         for (const auto& obj : objects)
 		{
@@ -307,6 +315,9 @@ namespace edx
 
     std::vector<std::string> LibraryFile::get_asset_types() const
     {
+        if (index_covers(*this))
+            return objectIndex.get_asset_types();
+
         std::set<std::string> uniqueTypes;
         for (const auto& obj : objects)
 		{
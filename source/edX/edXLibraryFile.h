@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 #include "edXConfig.h"
+#include "edXLibraryIndex.h"
 
 /// ----------------------------------------------------------------------------
 
@@ -111,6 +112,12 @@ namespace edx
         Library library;
         std::vector<LibraryObject> objects;
 
+        // Lookup and search index over objects. Not serialized; rebuilt on load.
+        // Objects appended to the vector directly are found by a linear scan
+        // until rebuild_object_index(), which is also needed after editing an
+        // object in place.
+        LibraryIndex objectIndex;
+
         // JSON serialization support
         void to_json(json& j) const;
         void from_json(const json& j);
@@ -123,11 +130,15 @@ namespace edx
         bool validate() const;
         std::vector<std::string> get_validation_errors() const;
 
-        // Object management
+        // Object management, keeps objectIndex in sync
         void add_object(const LibraryObject& obj);
         bool remove_object(const std::string& id);
         LibraryObject* find_object(const std::string& id);
         const LibraryObject* find_object(const std::string& id) const;
+        void rebuild_object_index();
+
+        // Ranked search by text, category, asset type and tags
+        std::vector<LibraryMatch> search(const LibraryQuery& query) const;
 
         // Statistics
         size_t get_object_count() const { return objects.size(); }
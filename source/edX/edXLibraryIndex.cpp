@@ -0,0 +1,447 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXLibraryIndex.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+
+#include "edXLibraryIndex.h"
+#include "edXLibraryFile.h"
+#include <algorithm>
+#include <string_view>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        /// Letters, digits and anything outside ASCII make up words; the rest separates them
+        bool is_word_char(char c)
+        {
+            const auto u = static_cast<unsigned char>(c);
+            return u >= 0x80 || (u >= '0' && u <= '9') || (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z');
+        }
+
+        std::string to_lower(std::string_view text)
+        {
+            std::string lowered(text);
+            for (char& c : lowered)
+            {
+                if (c >= 'A' && c <= 'Z')
+                    c = static_cast<char>(c - 'A' + 'a');
+            }
+            return lowered;
+        }
+
+        std::vector<std::string_view> split_words(std::string_view text)
+        {
+            std::vector<std::string_view> words;
+            size_t start = 0;
+            while (start < text.size())
+            {
+                while (start < text.size() && !is_word_char(text[start]))
+                    ++start;
+                size_t end = start;
+                while (end < text.size() && is_word_char(text[end]))
+                    ++end;
+                if (end > start)
+                    words.push_back(text.substr(start, end - start));
+                start = end;
+            }
+            return words;
+        }
+
+        uint32_t gram(char a, char b, char c)
+        {
+            return (uint32_t(static_cast<unsigned char>(a)) << 16) | (uint32_t(static_cast<unsigned char>(b)) << 8) | uint32_t(static_cast<unsigned char>(c));
+        }
+
+        /// Trigrams of a word padded with two spaces at the front, so "jet" gives "  j", " je" and "jet"
+        void padded_grams(std::string_view word, std::vector<uint32_t>& grams)
+        {
+            for (size_t i = 0; i < word.size(); ++i)
+            {
+                const char a = i >= 2 ? word[i - 2] : ' ';
+                const char b = i >= 1 ? word[i - 1] : ' ';
+                grams.push_back(gram(a, b, word[i]));
+            }
+        }
+
+        void sort_unique(std::vector<uint32_t>& values)
+        {
+            std::sort(values.begin(), values.end());
+            values.erase(std::unique(values.begin(), values.end()), values.end());
+        }
+
+        /// Distinct trigrams of every word of a lowercased text
+        std::vector<uint32_t> text_grams(std::string_view lowered)
+        {
+            std::vector<uint32_t> grams;
+            for (const std::string_view word : split_words(lowered))
+                padded_grams(word, grams);
+            sort_unique(grams);
+            return grams;
+        }
+
+        /// Trigrams a query must share with a match. Short words only match as prefixes; longer
+        /// words use their inner trigrams, so they also match inside other words.
+        std::vector<uint32_t> query_grams(std::string_view lowered)
+        {
+            std::vector<uint32_t> grams;
+            for (const std::string_view word : split_words(lowered))
+            {
+                if (word.size() < 3)
+                {
+                    padded_grams(word, grams);
+                    continue;
+                }
+                for (size_t i = 2; i < word.size(); ++i)
+                    grams.push_back(gram(word[i - 2], word[i - 1], word[i]));
+            }
+            sort_unique(grams);
+            return grams;
+        }
+
+        void add_posting(std::vector<uint32_t>& postings, uint32_t slot)
+        {
+            const auto it = std::lower_bound(postings.begin(), postings.end(), slot);
+            if (it == postings.end() || *it != slot)
+                postings.insert(it, slot);
+        }
+
+        template <typename Map, typename Key>
+        void remove_posting(Map& map, const Key& key, uint32_t slot)
+        {
+            const auto found = map.find(key);
+            if (found == map.end())
+                return;
+            auto& postings = found->second;
+            const auto it = std::lower_bound(postings.begin(), postings.end(), slot);
+            if (it != postings.end() && *it == slot)
+                postings.erase(it);
+            if (postings.empty())
+                map.erase(found);
+        }
+
+        template <typename Map>
+        const std::vector<uint32_t>* postings_for(const Map& map, const std::string& key)
+        {
+            static const std::vector<uint32_t> none;
+            const auto it = map.find(key);
+            return it != map.end() ? &it->second : &none;
+        }
+
+        std::vector<std::string> sorted_keys(const std::unordered_map<std::string, std::vector<uint32_t>>& map)
+        {
+            std::vector<std::string> keys;
+            keys.reserve(map.size());
+            for (const auto& [key, postings] : map)
+                keys.push_back(key);
+            std::sort(keys.begin(), keys.end());
+            return keys;
+        }
+
+        /// Ranking bonus for how the whole query appears in a name
+        double name_bonus(const std::string& name, const std::string& query)
+        {
+            if (name == query)
+                return 3.0;
+            const size_t at = name.find(query);
+            if (at == 0)
+                return 2.0;
+            if (at == std::string::npos)
+                return 0.0;
+
+            // A later word starting with the query still beats a match inside a word
+            for (size_t pos = at; pos != std::string::npos; pos = name.find(query, pos + 1))
+            {
+                if (!is_word_char(name[pos - 1]))
+                    return 1.0;
+            }
+            return 0.5;
+        }
+
+    } // namespace
+
+    /// ----------------------------------------------------------------------------
+
+    LibraryIndex::LibraryIndex() = default;
+
+    void LibraryIndex::clear()
+    {
+        m_slots.clear();
+        m_freeSlots.clear();
+        m_slotLookup.clear();
+        m_uniqueIdLookup.clear();
+        m_skippedCount = 0;
+        m_categories.clear();
+        m_assetTypes.clear();
+        m_tags.clear();
+        m_nameGrams.clear();
+        m_descriptionGrams.clear();
+    }
+
+    void LibraryIndex::build(const std::vector<LibraryObject>& objects)
+    {
+        clear();
+        m_slots.reserve(objects.size());
+        m_slotLookup.reserve(objects.size());
+        m_uniqueIdLookup.reserve(objects.size());
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            if (!insert(objects[i], i))
+                ++m_skippedCount;
+        }
+    }
+
+    bool LibraryIndex::insert(const LibraryObject& object, size_t objectIndex)
+    {
+        if (m_slotLookup.count(object.id) || m_uniqueIdLookup.count(object.uniqueId))
+            return false;
+
+        uint32_t slot;
+        if (!m_freeSlots.empty())
+        {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        Slot& entry = m_slots[slot];
+        entry.objectIndex = objectIndex;
+        entry.used = true;
+        entry.id = object.id;
+        entry.uniqueId = object.uniqueId;
+        entry.category = object.category;
+        entry.assetType = object.assetType;
+        entry.tags = object.tags;
+        entry.name = to_lower(object.name);
+        entry.description = to_lower(object.description);
+        m_slotLookup.emplace(object.id, slot);
+        m_uniqueIdLookup.emplace(object.uniqueId, slot);
+
+        add_postings(slot);
+        return true;
+    }
+
+    bool LibraryIndex::remove(const std::string& id)
+    {
+        const auto it = m_slotLookup.find(id);
+        if (it == m_slotLookup.end())
+            return false;
+
+        const uint32_t slot = it->second;
+        remove_postings(slot);
+        m_uniqueIdLookup.erase(m_slots[slot].uniqueId);
+        m_slotLookup.erase(it);
+        m_slots[slot] = Slot();
+        m_freeSlots.push_back(slot);
+        return true;
+    }
+
+    bool LibraryIndex::set_object_index(const std::string& id, size_t objectIndex)
+    {
+        const auto it = m_slotLookup.find(id);
+        if (it == m_slotLookup.end())
+            return false;
+        m_slots[it->second].objectIndex = objectIndex;
+        return true;
+    }
+
+    std::optional<size_t> LibraryIndex::find(const std::string& id) const
+    {
+        const auto it = m_slotLookup.find(id);
+        if (it == m_slotLookup.end())
+            return std::nullopt;
+        return m_slots[it->second].objectIndex;
+    }
+
+    std::optional<size_t> LibraryIndex::find_unique_id(const std::string& uniqueId) const
+    {
+        const auto it = m_uniqueIdLookup.find(uniqueId);
+        if (it == m_uniqueIdLookup.end())
+            return std::nullopt;
+        return m_slots[it->second].objectIndex;
+    }
+
+    std::vector<std::string> LibraryIndex::get_categories() const
+    {
+        return sorted_keys(m_categories);
+    }
+
+    std::vector<std::string> LibraryIndex::get_asset_types() const
+    {
+        return sorted_keys(m_assetTypes);
+    }
+
+    std::vector<std::string> LibraryIndex::get_tags() const
+    {
+        return sorted_keys(m_tags);
+    }
+
+    void LibraryIndex::add_postings(uint32_t slot)
+    {
+        const Slot& entry = m_slots[slot];
+        if (!entry.category.empty())
+            add_posting(m_categories[entry.category], slot);
+        if (!entry.assetType.empty())
+            add_posting(m_assetTypes[entry.assetType], slot);
+        for (const std::string& tag : entry.tags)
+        {
+            if (!tag.empty())
+                add_posting(m_tags[tag], slot);
+        }
+        for (const uint32_t g : text_grams(entry.name))
+            add_posting(m_nameGrams[g], slot);
+        for (const uint32_t g : text_grams(entry.description))
+            add_posting(m_descriptionGrams[g], slot);
+    }
+
+    void LibraryIndex::remove_postings(uint32_t slot)
+    {
+        const Slot& entry = m_slots[slot];
+        remove_posting(m_categories, entry.category, slot);
+        remove_posting(m_assetTypes, entry.assetType, slot);
+        for (const std::string& tag : entry.tags)
+            remove_posting(m_tags, tag, slot);
+        for (const uint32_t g : text_grams(entry.name))
+            remove_posting(m_nameGrams, g, slot);
+        for (const uint32_t g : text_grams(entry.description))
+            remove_posting(m_descriptionGrams, g, slot);
+    }
+
+    bool LibraryIndex::passes_filters(const Slot& slot, const LibraryQuery& query) const
+    {
+        if (!query.category.empty() && slot.category != query.category)
+            return false;
+        if (!query.assetType.empty() && slot.assetType != query.assetType)
+            return false;
+        for (const std::string& tag : query.tags)
+        {
+            if (std::find(slot.tags.begin(), slot.tags.end(), tag) == slot.tags.end())
+                return false;
+        }
+        return true;
+    }
+
+    void LibraryIndex::search(const LibraryQuery& query, std::vector<LibraryMatch>& out) const
+    {
+        const std::string text = to_lower(query.text);
+        const std::vector<uint32_t> grams = query_grams(text);
+        const size_t first = out.size();
+
+        if (grams.empty())
+        {
+            // Filters only: walk the shortest slot list among them
+            const std::vector<uint32_t>* candidates = nullptr;
+            if (!query.category.empty())
+                candidates = postings_for(m_categories, query.category);
+            if (!query.assetType.empty())
+            {
+                const auto* postings = postings_for(m_assetTypes, query.assetType);
+                if (!candidates || postings->size() < candidates->size())
+                    candidates = postings;
+            }
+            for (const std::string& tag : query.tags)
+            {
+                const auto* postings = postings_for(m_tags, tag);
+                if (!candidates || postings->size() < candidates->size())
+                    candidates = postings;
+            }
+
+            const auto consider = [&](uint32_t slot)
+            {
+                if (m_slots[slot].used && passes_filters(m_slots[slot], query))
+                    out.push_back({ m_slots[slot].objectIndex, 0.0 });
+            };
+            if (candidates)
+            {
+                for (const uint32_t slot : *candidates)
+                    consider(slot);
+            }
+            else
+            {
+                for (uint32_t slot = 0; slot < m_slots.size(); ++slot)
+                    consider(slot);
+            }
+
+            std::sort(out.begin() + first, out.end(), [](const LibraryMatch& a, const LibraryMatch& b) { return a.objectIndex < b.objectIndex; });
+            if (query.limit != 0 && out.size() - first > query.limit)
+                out.resize(first + query.limit);
+            return;
+        }
+
+        // Count the query trigrams found in each name and description
+        std::vector<uint16_t> nameHits(m_slots.size(), 0);
+        std::vector<uint16_t> descriptionHits(m_slots.size(), 0);
+        std::vector<uint32_t> touched;
+        for (const uint32_t g : grams)
+        {
+            if (const auto it = m_nameGrams.find(g); it != m_nameGrams.end())
+            {
+                for (const uint32_t slot : it->second)
+                {
+                    if (nameHits[slot]++ == 0 && descriptionHits[slot] == 0)
+                        touched.push_back(slot);
+                }
+            }
+            if (const auto it = m_descriptionGrams.find(g); it != m_descriptionGrams.end())
+            {
+                for (const uint32_t slot : it->second)
+                {
+                    if (descriptionHits[slot]++ == 0 && nameHits[slot] == 0)
+                        touched.push_back(slot);
+                }
+            }
+        }
+
+        // Up to two trigrams must all match; past that, half of them
+        const size_t required = grams.size() <= 2 ? grams.size() : (grams.size() + 1) / 2;
+        struct Ranked
+        {
+            LibraryMatch match;
+            size_t nameLength;
+        };
+        std::vector<Ranked> ranked;
+        for (const uint32_t slot : touched)
+        {
+            const size_t hits = std::max(nameHits[slot], descriptionHits[slot]);
+            if (hits < required || !passes_filters(m_slots[slot], query))
+                continue;
+
+            // Name hits count fully, description hits half
+            const double share = std::max(double(nameHits[slot]), 0.5 * double(descriptionHits[slot])) / double(grams.size());
+            const Slot& entry = m_slots[slot];
+            ranked.push_back({ { entry.objectIndex, share + name_bonus(entry.name, text) }, entry.name.size() });
+        }
+
+        const auto better = [](const Ranked& a, const Ranked& b)
+        {
+            if (a.match.score != b.match.score)
+                return a.match.score > b.match.score;
+            if (a.nameLength != b.nameLength)
+                return a.nameLength < b.nameLength;
+            return a.match.objectIndex < b.match.objectIndex;
+        };
+        const size_t count = query.limit == 0 ? ranked.size() : std::min(query.limit, ranked.size());
+        std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(count), ranked.end(), better);
+
+        out.reserve(first + count);
+        for (size_t i = 0; i < count; ++i)
+            out.push_back(ranked[i].match);
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
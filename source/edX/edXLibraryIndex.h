@@ -0,0 +1,166 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXLibraryIndex.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "edXConfig.h"
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    struct LibraryObject;
+
+    /**
+     * @brief Search over the objects of a library
+     *
+     * Every field set narrows the result; a default query matches every object.
+     */
+    struct EDX_API LibraryQuery
+    {
+        std::string text;               // Words matched against names and descriptions, tolerating typos
+        std::string category;           // Exact category, empty for any
+        std::string assetType;          // Exact asset type, empty for any
+        std::vector<std::string> tags;  // Objects must carry all of these
+        size_t limit = 50;              // Most results returned, 0 for all
+    };
+
+    /**
+     * @brief Result of a library search
+     */
+    struct EDX_API LibraryMatch
+    {
+        size_t objectIndex = 0;
+        double score = 0.0;             // Higher is better; 0 when the query has no text
+    };
+
+    /**
+     * @brief Lookup and search index over library objects
+     *
+     * Objects are keyed by id and unique id and carry the index of the object
+     * in LibraryFile::objects, which is what lookups and searches return.
+     * Category, asset type and tag each have an inverted index.
+     *
+     * Text search uses trigrams of the lowercased words of each name and
+     * description. Words are padded at the front so their first one and two
+     * letters form trigrams too, which lets the first keystrokes match word
+     * prefixes. A query word of three or more letters matches an object that
+     * shares at least half of its trigrams, so a mistyped letter or two still
+     * finds it. Results are ranked by the share of trigrams found, then by an
+     * exact, prefix or substring match of the whole query in the name.
+     */
+    class EDX_API LibraryIndex
+    {
+    public:
+        LibraryIndex();
+
+        /**
+         * @brief Replace the index contents with the given objects
+         *
+         * Object i is stored with object index i. Objects whose id or unique id
+         * is already taken are not indexed.
+         */
+        void build(const std::vector<LibraryObject>& objects);
+
+        /**
+         * @brief Add an object to the index
+         *
+         * @return False if its id or unique id is already indexed
+         */
+        bool insert(const LibraryObject& object, size_t objectIndex);
+
+        /**
+         * @brief Remove an object from the index
+         *
+         * @return False if the id is not indexed
+         */
+        bool remove(const std::string& id);
+
+        /**
+         * @brief Change the object index stored for an id, e.g. after the objects vector is compacted
+         */
+        bool set_object_index(const std::string& id, size_t objectIndex);
+
+        /**
+         * @brief Look up the object index for an id without scanning the library
+         */
+        [[nodiscard]] std::optional<size_t> find(const std::string& id) const;
+        [[nodiscard]] std::optional<size_t> find_unique_id(const std::string& uniqueId) const;
+
+        [[nodiscard]] bool contains(const std::string& id) const { return m_slotLookup.count(id) != 0; }
+        [[nodiscard]] size_t size() const { return m_slotLookup.size(); }
+        [[nodiscard]] bool empty() const { return m_slotLookup.empty(); }
+        void clear();
+
+        /**
+         * @brief Objects the index accounts for, indexed or skipped by build()
+         *
+         * Differs from the size of the objects vector once objects are added
+         * to it without going through the index.
+         */
+        [[nodiscard]] size_t get_object_count() const { return m_slotLookup.size() + m_skippedCount; }
+
+        // Distinct values in use, sorted
+        [[nodiscard]] std::vector<std::string> get_categories() const;
+        [[nodiscard]] std::vector<std::string> get_asset_types() const;
+        [[nodiscard]] std::vector<std::string> get_tags() const;
+
+        /**
+         * @brief Append the objects matching a query to the output vector, best first
+         *
+         * Without text the matches come in object order.
+         */
+        void search(const LibraryQuery& query, std::vector<LibraryMatch>& out) const;
+
+    private:
+        using Postings = std::unordered_map<std::string, std::vector<uint32_t>>;
+        using GramPostings = std::unordered_map<uint32_t, std::vector<uint32_t>>;
+
+        struct Slot
+        {
+            size_t objectIndex = 0;
+            bool used = false;
+            std::string id;
+            std::string uniqueId;
+            std::string category;
+            std::string assetType;
+            std::vector<std::string> tags;
+            std::string name;               // Lowercased
+            std::string description;        // Lowercased
+        };
+
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+        std::unordered_map<std::string, uint32_t> m_slotLookup;
+        std::unordered_map<std::string, uint32_t> m_uniqueIdLookup;
+        size_t m_skippedCount = 0;
+
+        // Slot lists are kept sorted
+        Postings m_categories;
+        Postings m_assetTypes;
+        Postings m_tags;
+        GramPostings m_nameGrams;
+        GramPostings m_descriptionGrams;
+
+        void add_postings(uint32_t slot);
+        void remove_postings(uint32_t slot);
+        [[nodiscard]] bool passes_filters(const Slot& slot, const LibraryQuery& query) const;
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -12,10 +12,20 @@
 */
 
 #include "edXManager.h"
+#include "edXProjectBinary.h"
+#include "edXProjectJournal.h"
+#include "edXProjectStream.h"
 #include "edXTimeUtils.h"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
 
 /// ----------------------------------------------------------------------------
 
@@ -24,15 +34,25 @@ namespace edx
     // Private implementation struct
     struct EdxManager::Impl
     {
+        // Guards the callback and the last error, which every operation may touch
+        mutable std::mutex mutex;
         ErrorCallback errorCallback;
         std::string lastError;
+        std::atomic<bool> binaryCompanion = false;
 
         void reportError(const std::string& error)
         {
-            lastError = error;
-            if (errorCallback)
+            ErrorCallback callback;
             {
-                errorCallback(error);
+                std::lock_guard<std::mutex> lock(mutex);
+                lastError = error;
+                callback = errorCallback;
+            }
+
+            // Called outside the lock so that it may call back into the manager
+            if (callback)
+            {
+                callback(error);
             }
         }
     };
@@ -79,11 +99,65 @@ namespace edx
             if (progressCallback)
                 progressCallback(0.0f, "Loading project file...");
 
+            // The companion is used only while it is at least as new as the JSON
+            if (m_pImpl->binaryCompanion)
+            {
+                const auto binaryPath = ProjectBinaryFile::companion_path(filePath);
+                std::error_code binaryError, jsonError;
+                const auto binaryTime = std::filesystem::last_write_time(binaryPath, binaryError);
+                const auto jsonTime = std::filesystem::last_write_time(filePath, jsonError);
+                if (!binaryError && (jsonError || binaryTime >= jsonTime))
+                {
+                    auto project = std::make_unique<EdxProject>();
+                    ProjectBinaryFile binary;
+                    if (binary.open(binaryPath) && binary.load(*project))
+                    {
+                        // The companion mirrors the JSON base, so the journal applies on top of it too
+                        std::string journalError;
+                        if (!jsonError && !ProjectJournal::replay(filePath, *project, nullptr, &journalError))
+                        {
+                            m_pImpl->reportError("Failed to load project from: " + filePath + ": " + journalError);
+                            return nullptr;
+                        }
+
+                        if (progressCallback)
+                            progressCallback(1.0f, "Project loaded successfully");
+                        return project;
+                    }
+
+                    // A damaged companion falls back to the JSON file
+                    if (jsonError)
+                    {
+                        m_pImpl->reportError("Failed to load project from: " + binaryPath.string() + ": " + binary.get_error());
+                        return nullptr;
+                    }
+                }
+            }
+
+            ProjectStreamOptions options;
+            if (progressCallback)
+            {
+                options.progress = [&progressCallback](uint64_t bytesDone, uint64_t bytesTotal)
+                {
+                    if (bytesTotal > 0)
+                        progressCallback(static_cast<float>(double(bytesDone) / double(bytesTotal)), "Loading project file...");
+                };
+            }
+
             auto project = std::make_unique<EdxProject>();
 
-            if (!project->load_from_file(filePath))
+            ProjectStreamReader reader(std::move(options));
+            if (!reader.load(filePath, *project))
             {
-                m_pImpl->reportError("Failed to load project from: " + filePath);
+                m_pImpl->reportError("Failed to load project from: " + filePath + ": " + reader.get_error());
+                return nullptr;
+            }
+
+            // Edits committed through a ProjectJournal since the last full save
+            std::string journalError;
+            if (!ProjectJournal::replay(filePath, *project, nullptr, &journalError))
+            {
+                m_pImpl->reportError("Failed to load project from: " + filePath + ": " + journalError);
                 return nullptr;
             }
 
@@ -125,18 +199,40 @@ namespace edx
             if (progressCallback)
                 progressCallback(0.5f, "Saving project file...");
 
+            // Replacing the base makes its journal stale, so committed edits go into the base first
+            std::string journalError;
+            if (!ProjectJournal::fold(filePath, &journalError))
+            {
+                m_pImpl->reportError("Cannot save " + filePath + " over its journal: " + journalError);
+                return false;
+            }
+
             // Update edit date
             const_cast<EdxProject&>(project).project.editDate = std::chrono::system_clock::now();
 
             bool result = project.save_to_file(filePath);
 
-            if (progressCallback)
-                progressCallback(1.0f, result ? "Project saved successfully" : "Failed to save project");
-
             if (!result)
             {
                 m_pImpl->reportError("Failed to save project to: " + filePath);
             }
+            else if (m_pImpl->binaryCompanion)
+            {
+                // Written after the JSON so that it is the newer of the two
+                const auto binaryPath = ProjectBinaryFile::companion_path(filePath);
+                std::string binaryError;
+                if (!ProjectBinaryFile::write(project, binaryPath, &binaryError))
+                {
+                    // A stale companion is older than the JSON and would not be loaded, but do not leave it behind
+                    std::error_code ec;
+                    std::filesystem::remove(binaryPath, ec);
+                    m_pImpl->reportError("Saved " + filePath + " but not its binary companion: " + binaryError);
+                    result = false;
+                }
+            }
+
+            if (progressCallback)
+                progressCallback(1.0f, result ? "Project saved successfully" : "Failed to save project");
 
             return result;
         }
@@ -147,6 +243,16 @@ namespace edx
         }
     }
 
+    void EdxManager::set_binary_companion(bool enabled)
+    {
+        m_pImpl->binaryCompanion = enabled;
+    }
+
+    bool EdxManager::get_binary_companion() const
+    {
+        return m_pImpl->binaryCompanion;
+    }
+
     // Library operations
     std::unique_ptr<LibraryFile> EdxManager::create_library(
         const std::string& libraryName,
@@ -286,16 +392,19 @@ namespace edx
     // Error and progress handling
     void EdxManager::set_error_callback(ErrorCallback callback)
     {
-        m_pImpl->errorCallback = callback;
+        std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+        m_pImpl->errorCallback = std::move(callback);
     }
 
     std::string EdxManager::get_last_error() const
     {
+        std::lock_guard<std::mutex> lock(m_pImpl->mutex);
         return m_pImpl->lastError;
     }
 
     void EdxManager::clear_error()
     {
+        std::lock_guard<std::mutex> lock(m_pImpl->mutex);
         m_pImpl->lastError.clear();
     }
 
@@ -309,6 +418,187 @@ namespace edx
         return false;
     }
 
+    // Batch processing
+    namespace
+    {
+        bool is_library_path(const std::string& filePath)
+        {
+            std::string extension = std::filesystem::path(filePath).extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return extension == ".lib" || extension == ".edxlib";
+        }
+
+        /// Admits files while the input bytes in flight stay within the budget, one at a time past it
+        class MemoryGate
+        {
+        public:
+            explicit MemoryGate(uint64_t budget) : m_budget(budget) {}
+
+            void acquire(uint64_t bytes)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_released.wait(lock, [this, bytes] { return m_inFlight == 0 || m_inFlight + bytes <= m_budget; });
+                m_inFlight += bytes;
+            }
+
+            void release(uint64_t bytes)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_inFlight -= bytes;
+                }
+                m_released.notify_all();
+            }
+
+        private:
+            std::mutex m_mutex;
+            std::condition_variable m_released;
+            uint64_t m_budget;
+            uint64_t m_inFlight = 0;
+        };
+
+        void run_job(EdxManager& manager, const BatchJob& job, BatchFileResult& result)
+        {
+            const std::string& outputPath = job.outputPath.empty() ? job.inputPath : job.outputPath;
+            const bool library = is_library_path(job.inputPath);
+            manager.clear_error();
+
+            switch (job.operation)
+            {
+            case BATCH_VALIDATE:
+                if (library)
+                {
+                    if (auto loaded = manager.load_library(job.inputPath))
+                        result.errors = manager.validate_library(*loaded);
+                }
+                else if (auto loaded = manager.load_project(job.inputPath))
+                {
+                    result.errors = manager.validate_project(*loaded);
+                }
+                break;
+
+            case BATCH_RESAVE:
+                if (library)
+                {
+                    if (auto loaded = manager.load_library(job.inputPath))
+                        manager.save_library(*loaded, outputPath);
+                }
+                else if (auto loaded = manager.load_project(job.inputPath))
+                {
+                    manager.save_project(*loaded, outputPath);
+                }
+                break;
+
+            case BATCH_CONVERT_LEGACY:
+                manager.convert_legacy_project(job.inputPath, outputPath);
+                break;
+            }
+
+            // Validation errors are returned, everything else went through the worker's last error
+            const std::string error = manager.get_last_error();
+            if (!error.empty())
+                result.errors.insert(result.errors.begin(), error);
+            result.success = result.errors.empty();
+        }
+
+    } // namespace
+
+    BatchReport EdxManager::process_batch(
+        const std::vector<BatchJob>& jobs,
+        const BatchOptions& options)
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto batchStart = Clock::now();
+
+        BatchReport report;
+        report.files.resize(jobs.size());
+
+        const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        const size_t workerCount = std::min<size_t>(options.workerCount ? options.workerCount : hardware, std::max<size_t>(1, jobs.size()));
+        const bool binaryCompanion = m_pImpl->binaryCompanion;
+
+        MemoryGate gate(options.memoryBudget);
+        std::atomic<size_t> nextJob = 0;
+        std::mutex callbackMutex;
+
+        const auto worker = [&]()
+        {
+            EdxManager manager;
+            manager.set_binary_companion(binaryCompanion);
+
+            for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+            {
+                const BatchJob& job = jobs[i];
+                BatchFileResult& result = report.files[i];
+                result.inputPath = job.inputPath;
+
+                std::error_code ec;
+                const uintmax_t size = std::filesystem::file_size(job.inputPath, ec);
+                result.fileBytes = ec ? 0 : static_cast<uint64_t>(size);
+
+                gate.acquire(result.fileBytes);
+                const auto start = Clock::now();
+                try
+                {
+                    run_job(manager, job, result);
+                }
+                catch (const std::exception& e)
+                {
+                    result.errors.push_back("Exception processing " + job.inputPath + ": " + e.what());
+                    result.success = false;
+                }
+                result.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                gate.release(result.fileBytes);
+
+                if (options.fileDone)
+                {
+                    std::lock_guard<std::mutex> lock(callbackMutex);
+                    options.fileDone(result);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < workerCount; ++t)
+            threads.emplace_back(worker);
+        worker();
+        for (auto& thread : threads)
+            thread.join();
+
+        for (const auto& result : report.files)
+        {
+            if (result.success)
+                ++report.succeeded;
+            else
+                ++report.failed;
+        }
+        report.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - batchStart).count();
+        return report;
+    }
+
+    double BatchReport::get_files_per_second() const
+    {
+        return elapsedMs > 0.0 ? double(files.size()) * 1000.0 / elapsedMs : 0.0;
+    }
+
+    std::string BatchReport::get_summary() const
+    {
+        std::string summary;
+        char line[64];
+        for (const auto& result : files)
+        {
+            std::snprintf(line, sizeof(line), "%-6s %10.1f ms  ", result.success ? "OK" : "FAILED", result.elapsedMs);
+            summary += line + result.inputPath + "\n";
+            for (const auto& error : result.errors)
+                summary += "       " + error + "\n";
+        }
+
+        std::snprintf(line, sizeof(line), "%.1f files/s", get_files_per_second());
+        summary += std::to_string(files.size()) + " files, " + std::to_string(succeeded) + " succeeded, " +
+                   std::to_string(failed) + " failed in " + std::to_string(static_cast<long long>(elapsedMs)) + " ms (" + line + ")\n";
+        return summary;
+    }
+
     std::string EdxManager::export_project_to_json(
         const EdxProject& project,
         bool prettyPrint)
@@ -14,6 +14,7 @@
 #include "edXConfig.h"
 #include "edXProjectFile.h"
 #include "edXLibraryFile.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -24,12 +25,79 @@
 
 namespace edx
 {
+    /**
+     * @brief Work done on each file of a batch
+     */
+    enum BatchOperation : uint8_t
+    {
+        BATCH_VALIDATE,         // Load and validate
+        BATCH_RESAVE,           // Load and save again in the current format
+        BATCH_CONVERT_LEGACY    // Run convert_legacy_project()
+    };
+
+    /**
+     * @brief One file of a batch
+     *
+     * Files ending in .lib (such as .edX.lib) or .edxlib are treated as
+     * libraries, everything else as projects.
+     */
+    struct EDX_API BatchJob
+    {
+        BatchOperation operation = BATCH_VALIDATE;
+        std::string inputPath;
+        std::string outputPath;         // Resave and conversion target; empty writes over the input
+    };
+
+    /**
+     * @brief Outcome of one file of a batch
+     */
+    struct EDX_API BatchFileResult
+    {
+        std::string inputPath;
+        bool success = false;
+        std::vector<std::string> errors;    // Load, save or validation errors for this file only
+        uint64_t fileBytes = 0;
+        double elapsedMs = 0.0;
+    };
+
+    /**
+     * @brief Outcome of a whole batch, with files in job order
+     */
+    struct EDX_API BatchReport
+    {
+        std::vector<BatchFileResult> files;
+        size_t succeeded = 0;
+        size_t failed = 0;
+        double elapsedMs = 0.0;
+
+        [[nodiscard]] double get_files_per_second() const;
+
+        /**
+         * @brief Text report with one line per file and the totals
+         */
+        [[nodiscard]] std::string get_summary() const;
+    };
+
+    /**
+     * @brief Settings for EdxManager::process_batch()
+     */
+    struct EDX_API BatchOptions
+    {
+        unsigned workerCount = 0;                   // 0 uses the hardware concurrency
+        uint64_t memoryBudget = 512ull << 20;       // Input bytes loaded at once; a larger file still runs, alone
+        std::function<void(const BatchFileResult&)> fileDone;  // Called from the worker threads, one at a time
+    };
+
     /**
      * @brief High-level manager for edX file operations
      *
      * Provides a simplified interface for working with edX project and library
      * files, following Scenery Editor X architecture patterns with proper
      * error handling, logging integration, and cross-platform compatibility.
+     *
+     * Operations may run on several threads at once. The last error is
+     * shared by all of them, so concurrent callers should use
+     * process_batch(), which reports errors per file.
      */
     class EDX_API EdxManager
     {
@@ -67,6 +135,8 @@ namespace edx
         /**
          * @brief Load a project from file
          *
+         * Edits committed to the project's journal are replayed on top.
+         *
          * @param filePath Path to the .edX file
          * @param progressCallback Optional progress callback
          * @return Unique pointer to the loaded project, nullptr on failure
@@ -79,6 +149,10 @@ namespace edx
         /**
          * @brief Save a project to file
          *
+         * A journal beside the file is folded into it first, and the save
+         * fails if that does not work. Close any ProjectJournal open on the
+         * file before saving over it.
+         *
          * @param project Project to save
          * @param filePath Path where to save the .edX file
          * @param progressCallback Optional progress callback
@@ -90,6 +164,21 @@ namespace edx
             ProgressCallback progressCallback = nullptr
         );
 
+        /**
+         * @brief Keep a binary .edXb companion next to saved projects
+         *
+         * Off by default. When enabled, save_project() also writes the .edXb
+         * file, and load_project() loads whichever of the two is newer.
+         *
+         * @param enabled True to write and load the companion
+         */
+        void set_binary_companion(bool enabled);
+
+        /**
+         * @brief Whether the .edXb companion is in use
+         */
+        bool get_binary_companion() const;
+
         // Library file operations
 
         /**
@@ -208,6 +297,26 @@ namespace edx
             const std::string& newFormatFile
         );
 
+        // Batch processing
+
+        /**
+         * @brief Process many files at once on a bounded pool of worker threads
+         *
+         * Each worker owns its own EdxManager, with this manager's binary
+         * companion setting, and holds at most one file in memory. Files wait
+         * while the input bytes in flight would exceed the memory budget.
+         * Errors go to the per-file results, not to get_last_error() or the
+         * error callback.
+         *
+         * @param jobs Files to process
+         * @param options Worker count, memory budget and per-file callback
+         * @return Per-file results in job order, with totals
+         */
+        BatchReport process_batch(
+            const std::vector<BatchJob>& jobs,
+            const BatchOptions& options = {}
+        );
+
         /**
          * @brief Export project to JSON string
          *
@@ -0,0 +1,634 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXProjectBinary.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "edXFileUtils.h"
+#include "edXProjectBinary.h"
+#include "edXProjectFile.h"
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        constexpr char MAGIC[4] = { 'E', 'D', 'X', 'B' };
+        constexpr uint32_t FORMAT_VERSION = 1;
+
+        // Sections of the file, in file order
+        enum Section : uint32_t
+        {
+            SECTION_LATITUDE,
+            SECTION_LONGITUDE,
+            SECTION_ALTITUDE,
+            SECTION_HEADING,
+            SECTION_FLAGS,
+            SECTION_STRING_COLUMNS,     // One per ProjectBinaryFile::StringColumn
+            SECTION_LAYER_ASSET_OFFSETS = SECTION_STRING_COLUMNS + ProjectBinaryFile::STRING_COLUMN_COUNT,
+            SECTION_LAYER_ASSET_IDS,
+            SECTION_STRING_OFFSETS,     // One uint64 per string plus the end, into SECTION_STRING_DATA
+            SECTION_STRING_DATA,
+            SECTION_METADATA,           // JSON: Project, Airport, Libraries, Settings and Layers without their asset ids
+            SECTION_COUNT
+        };
+
+        struct SectionEntry
+        {
+            uint64_t offset;
+            uint64_t size;
+        };
+
+        struct FileHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint64_t assetCount;
+            uint64_t layerCount;
+            uint64_t stringCount;
+            SectionEntry sections[SECTION_COUNT];
+        };
+        static_assert(sizeof(FileHeader) % 8 == 0, "Sections after the header must stay 8 byte aligned");
+
+        uint64_t align8(uint64_t value)
+        {
+            return (value + 7) & ~uint64_t(7);
+        }
+
+        /**
+         * @brief Interns strings in order of first use; index 0 is the empty string
+         */
+        class StringPool
+        {
+        public:
+            StringPool()
+            {
+                m_offsets.push_back(0);
+                intern(std::string_view());
+            }
+
+            // The string must outlive the pool
+            uint32_t intern(std::string_view value)
+            {
+                const auto [it, inserted] = m_index.try_emplace(value, static_cast<uint32_t>(m_offsets.size() - 1));
+                if (inserted)
+                {
+                    m_data.append(value);
+                    m_offsets.push_back(m_data.size());
+                }
+                return it->second;
+            }
+
+            uint32_t intern_owned(std::string value)
+            {
+                const auto it = m_index.find(value);
+                if (it != m_index.end())
+                {
+                    return it->second;
+                }
+                return intern(m_owned.emplace_back(std::move(value)));
+            }
+
+            size_t size() const { return m_offsets.size() - 1; }
+            const std::vector<uint64_t>& offsets() const { return m_offsets; }
+            const std::string& data() const { return m_data; }
+
+        private:
+            std::unordered_map<std::string_view, uint32_t> m_index;
+            std::deque<std::string> m_owned;
+            std::vector<uint64_t> m_offsets;
+            std::string m_data;
+        };
+
+        /**
+         * @brief Columns of a project, ready to be written
+         */
+        struct Columns
+        {
+            std::vector<double> latitudes;
+            std::vector<double> longitudes;
+            std::vector<double> altitudes;
+            std::vector<double> headings;
+            std::vector<uint8_t> flags;
+            std::vector<uint32_t> strings[ProjectBinaryFile::STRING_COLUMN_COUNT];
+            std::vector<uint64_t> layerAssetOffsets;
+            std::vector<uint32_t> layerAssetIds;
+            StringPool pool;
+            std::string metadata;
+        };
+
+        void build_columns(const EdxProject& project, Columns& columns)
+        {
+            const size_t count = project.assets.size();
+            columns.latitudes.reserve(count);
+            columns.longitudes.reserve(count);
+            columns.altitudes.reserve(count);
+            columns.headings.reserve(count);
+            columns.flags.reserve(count);
+            for (auto& column : columns.strings)
+            {
+                column.reserve(count);
+            }
+
+            for (const SceneAsset& asset : project.assets)
+            {
+                columns.latitudes.push_back(asset.latitude);
+                columns.longitudes.push_back(asset.longitude);
+                columns.altitudes.push_back(asset.altitude);
+                columns.headings.push_back(asset.heading);
+                columns.flags.push_back(static_cast<uint8_t>(
+                    (asset.locked ? ProjectBinaryFile::FLAG_LOCKED : 0) |
+                    (asset.hidden ? ProjectBinaryFile::FLAG_HIDDEN : 0) |
+                    (asset.selected ? ProjectBinaryFile::FLAG_SELECTED : 0)));
+
+                columns.strings[ProjectBinaryFile::COLUMN_ID].push_back(columns.pool.intern(asset.id));
+                columns.strings[ProjectBinaryFile::COLUMN_UNIQUE_ID].push_back(columns.pool.intern(asset.uniqueId));
+                columns.strings[ProjectBinaryFile::COLUMN_LIBRARY].push_back(columns.pool.intern(asset.associatedLibrary));
+                columns.strings[ProjectBinaryFile::COLUMN_LAYER_ID].push_back(columns.pool.intern(asset.layerId));
+                columns.strings[ProjectBinaryFile::COLUMN_GROUP_ID].push_back(columns.pool.intern(asset.groupId));
+                columns.strings[ProjectBinaryFile::COLUMN_PROPERTIES].push_back(
+                    asset.otherProperties.empty() ? 0 : columns.pool.intern_owned(asset.otherProperties.dump()));
+            }
+
+            json layersJson = json::array();
+            columns.layerAssetOffsets.push_back(0);
+            for (const SceneLayer& layer : project.layers)
+            {
+                json layerJson;
+                layer.to_json(layerJson);
+                layerJson.erase("asset-ids");
+                layersJson.push_back(std::move(layerJson));
+
+                for (const std::string& id : layer.assetIds)
+                {
+                    columns.layerAssetIds.push_back(columns.pool.intern(id));
+                }
+                columns.layerAssetOffsets.push_back(columns.layerAssetIds.size());
+            }
+
+            json projectJson, airportJson;
+            project.project.to_json(projectJson);
+            project.airport.to_json(airportJson);
+
+            json librariesJson = json::array();
+            for (const auto& lib : project.libraries)
+            {
+                json libJson;
+                lib.to_json(libJson);
+                librariesJson.push_back(std::move(libJson));
+            }
+
+            json metadata = {
+                {"Project", std::move(projectJson)},
+                {"Airport", std::move(airportJson)},
+                {"Libraries", std::move(librariesJson)},
+                {"Layers", std::move(layersJson)}
+            };
+            if (!project.settings.empty())
+            {
+                metadata["Settings"] = project.settings;
+            }
+            columns.metadata = metadata.dump();
+        }
+
+        template <typename T>
+        std::pair<const void*, uint64_t> bytes_of(const std::vector<T>& values)
+        {
+            return { values.data(), values.size() * sizeof(T) };
+        }
+
+    } // namespace
+
+    /// ----------------------------------------------------------------------------
+
+    /**
+     * @brief Read only mapping of a whole file
+     */
+    struct ProjectBinaryFile::Mapping
+    {
+        const char* data = nullptr;
+        size_t size = 0;
+#if defined(_WIN32)
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#else
+        int file = -1;
+#endif
+
+        ~Mapping()
+        {
+#if defined(_WIN32)
+            if (data)
+                UnmapViewOfFile(data);
+            if (mapping)
+                CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE)
+                CloseHandle(file);
+#else
+            if (data)
+                munmap(const_cast<char*>(data), size);
+            if (file >= 0)
+                ::close(file);
+#endif
+        }
+
+        bool open(const std::filesystem::path& path)
+        {
+#if defined(_WIN32)
+            file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return false;
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+                return false;
+            size = static_cast<size_t>(fileSize.QuadPart);
+
+            mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping)
+                return false;
+            data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+            file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (file < 0)
+                return false;
+
+            struct stat info;
+            if (fstat(file, &info) != 0 || info.st_size == 0)
+                return false;
+            size = static_cast<size_t>(info.st_size);
+
+            void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+            data = mapped == MAP_FAILED ? nullptr : static_cast<const char*>(mapped);
+#endif
+            return data != nullptr;
+        }
+    };
+
+    /// ----------------------------------------------------------------------------
+
+    ProjectBinaryFile::ProjectBinaryFile() = default;
+
+    ProjectBinaryFile::~ProjectBinaryFile() = default;
+
+    std::filesystem::path ProjectBinaryFile::companion_path(const std::filesystem::path& projectPath)
+    {
+        std::filesystem::path path = projectPath;
+        path.replace_extension(".edXb");
+        return path;
+    }
+
+    bool ProjectBinaryFile::write(const EdxProject& project, const std::filesystem::path& filePath, std::string* error)
+    {
+        const auto report = [error](std::string message)
+        {
+            if (error)
+            {
+                *error = std::move(message);
+            }
+            return false;
+        };
+
+        std::filesystem::path tempPath = filePath;
+        tempPath += ".tmp";
+
+        try
+        {
+            Columns columns;
+            build_columns(project, columns);
+            if (columns.pool.size() > std::numeric_limits<uint32_t>::max())
+            {
+                return report("Too many distinct strings for " + filePath.string());
+            }
+
+            std::pair<const void*, uint64_t> sections[SECTION_COUNT] = {
+                bytes_of(columns.latitudes),
+                bytes_of(columns.longitudes),
+                bytes_of(columns.altitudes),
+                bytes_of(columns.headings),
+                bytes_of(columns.flags)
+            };
+            for (uint32_t column = 0; column < STRING_COLUMN_COUNT; ++column)
+            {
+                sections[SECTION_STRING_COLUMNS + column] = bytes_of(columns.strings[column]);
+            }
+            sections[SECTION_LAYER_ASSET_OFFSETS] = bytes_of(columns.layerAssetOffsets);
+            sections[SECTION_LAYER_ASSET_IDS] = bytes_of(columns.layerAssetIds);
+            sections[SECTION_STRING_OFFSETS] = bytes_of(columns.pool.offsets());
+            sections[SECTION_STRING_DATA] = { columns.pool.data().data(), columns.pool.data().size() };
+            sections[SECTION_METADATA] = { columns.metadata.data(), columns.metadata.size() };
+
+            FileHeader header = {};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = FORMAT_VERSION;
+            header.assetCount = project.assets.size();
+            header.layerCount = project.layers.size();
+            header.stringCount = columns.pool.size();
+
+            uint64_t offset = sizeof(FileHeader);
+            for (uint32_t section = 0; section < SECTION_COUNT; ++section)
+            {
+                header.sections[section] = { offset, sections[section].second };
+                offset = align8(offset + sections[section].second);
+            }
+
+            {
+                std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+                if (!file.is_open())
+                {
+                    return report("Cannot open file for writing: " + tempPath.string());
+                }
+
+                static constexpr char padding[8] = {};
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                for (uint32_t section = 0; section < SECTION_COUNT; ++section)
+                {
+                    const auto& [data, size] = sections[section];
+                    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+                    file.write(padding, static_cast<std::streamsize>(align8(size) - size));
+                }
+
+                file.close();
+                if (file.fail())
+                {
+                    std::filesystem::remove(tempPath);
+                    return report("Cannot write file: " + tempPath.string());
+                }
+            }
+
+            std::string replaceError;
+            if (!sync_file(tempPath) || !replace_file(tempPath, filePath, &replaceError))
+            {
+                std::filesystem::remove(tempPath);
+                return report(replaceError.empty() ? "Cannot flush " + tempPath.string() : replaceError);
+            }
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return report(std::string("Cannot write ") + filePath.string() + ": " + e.what());
+        }
+    }
+
+    bool ProjectBinaryFile::fail(std::string error)
+    {
+        close();
+        m_error = std::move(error);
+        return false;
+    }
+
+    void ProjectBinaryFile::close()
+    {
+        m_mapping.reset();
+        m_data = nullptr;
+        m_size = 0;
+        m_assetCount = 0;
+        m_layerCount = 0;
+        m_stringCount = 0;
+        m_latitudes = m_longitudes = m_altitudes = m_headings = nullptr;
+        m_flags = nullptr;
+        for (auto& column : m_columns)
+        {
+            column = nullptr;
+        }
+        m_layerAssetOffsets = nullptr;
+        m_layerAssetIds = nullptr;
+        m_stringOffsets = nullptr;
+        m_stringData = nullptr;
+        m_metadata = {};
+    }
+
+    bool ProjectBinaryFile::open(const std::filesystem::path& filePath)
+    {
+        close();
+        m_error.clear();
+
+        auto mapping = std::make_unique<Mapping>();
+        if (!mapping->open(filePath))
+        {
+            return fail("Cannot map file: " + filePath.string());
+        }
+        const char* data = mapping->data;
+        const uint64_t size = mapping->size;
+
+        FileHeader header;
+        if (size < sizeof(header))
+        {
+            return fail("Not an .edXb file: " + filePath.string());
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            return fail("Not an .edXb file: " + filePath.string());
+        }
+        if (header.version != FORMAT_VERSION)
+        {
+            return fail("Unsupported .edXb version " + std::to_string(header.version) + " in " + filePath.string());
+        }
+
+        // Every count is bounded by the file size, so the products below cannot overflow
+        const auto corrupt = [&filePath](const char* what) { return "Corrupt .edXb file " + filePath.string() + ": " + what; };
+        if (header.assetCount > size || header.layerCount > size || header.stringCount > size)
+        {
+            return fail(corrupt("bad counts"));
+        }
+
+        for (const SectionEntry& section : header.sections)
+        {
+            if (section.offset % 8 != 0 || section.offset > size || section.size > size - section.offset)
+            {
+                return fail(corrupt("section out of bounds"));
+            }
+        }
+
+        const auto& sections = header.sections;
+        const uint64_t assets = header.assetCount;
+        bool sizesMatch =
+            sections[SECTION_LATITUDE].size == assets * sizeof(double) &&
+            sections[SECTION_LONGITUDE].size == assets * sizeof(double) &&
+            sections[SECTION_ALTITUDE].size == assets * sizeof(double) &&
+            sections[SECTION_HEADING].size == assets * sizeof(double) &&
+            sections[SECTION_FLAGS].size == assets &&
+            sections[SECTION_LAYER_ASSET_OFFSETS].size == (header.layerCount + 1) * sizeof(uint64_t) &&
+            sections[SECTION_LAYER_ASSET_IDS].size % sizeof(uint32_t) == 0 &&
+            sections[SECTION_STRING_OFFSETS].size == (header.stringCount + 1) * sizeof(uint64_t);
+        for (uint32_t column = 0; column < STRING_COLUMN_COUNT; ++column)
+        {
+            sizesMatch = sizesMatch && sections[SECTION_STRING_COLUMNS + column].size == assets * sizeof(uint32_t);
+        }
+        if (!sizesMatch)
+        {
+            return fail(corrupt("section sizes do not match the counts"));
+        }
+
+        const auto at = [data, &sections](Section section) { return data + sections[section].offset; };
+        const auto* stringOffsets = reinterpret_cast<const uint64_t*>(at(SECTION_STRING_OFFSETS));
+        const uint64_t stringBytes = sections[SECTION_STRING_DATA].size;
+        if (stringOffsets[0] != 0 || stringOffsets[header.stringCount] != stringBytes)
+        {
+            return fail(corrupt("bad string table"));
+        }
+        for (uint64_t i = 0; i < header.stringCount; ++i)
+        {
+            if (stringOffsets[i] > stringOffsets[i + 1])
+            {
+                return fail(corrupt("bad string table"));
+            }
+        }
+
+        // Indices are checked once here so the accessors need not check them
+        const auto indicesValid = [&header](const uint32_t* indices, uint64_t count)
+        {
+            uint32_t largest = 0;
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                largest = std::max(largest, indices[i]);
+            }
+            return count == 0 || largest < header.stringCount;
+        };
+
+        for (uint32_t column = 0; column < STRING_COLUMN_COUNT; ++column)
+        {
+            m_columns[column] = reinterpret_cast<const uint32_t*>(at(Section(SECTION_STRING_COLUMNS + column)));
+            if (!indicesValid(m_columns[column], assets))
+            {
+                return fail(corrupt("string index out of range"));
+            }
+        }
+
+        const auto* layerOffsets = reinterpret_cast<const uint64_t*>(at(SECTION_LAYER_ASSET_OFFSETS));
+        const uint64_t layerIdCount = sections[SECTION_LAYER_ASSET_IDS].size / sizeof(uint32_t);
+        if (layerOffsets[0] != 0 || layerOffsets[header.layerCount] != layerIdCount)
+        {
+            return fail(corrupt("bad layer table"));
+        }
+        for (uint64_t i = 0; i < header.layerCount; ++i)
+        {
+            if (layerOffsets[i] > layerOffsets[i + 1])
+            {
+                return fail(corrupt("bad layer table"));
+            }
+        }
+        const auto* layerIds = reinterpret_cast<const uint32_t*>(at(SECTION_LAYER_ASSET_IDS));
+        if (!indicesValid(layerIds, layerIdCount))
+        {
+            return fail(corrupt("string index out of range"));
+        }
+
+        m_mapping = std::move(mapping);
+        m_data = data;
+        m_size = size;
+        m_assetCount = assets;
+        m_layerCount = header.layerCount;
+        m_stringCount = header.stringCount;
+        m_latitudes = reinterpret_cast<const double*>(at(SECTION_LATITUDE));
+        m_longitudes = reinterpret_cast<const double*>(at(SECTION_LONGITUDE));
+        m_altitudes = reinterpret_cast<const double*>(at(SECTION_ALTITUDE));
+        m_headings = reinterpret_cast<const double*>(at(SECTION_HEADING));
+        m_flags = reinterpret_cast<const uint8_t*>(at(SECTION_FLAGS));
+        m_layerAssetOffsets = layerOffsets;
+        m_layerAssetIds = layerIds;
+        m_stringOffsets = stringOffsets;
+        m_stringData = at(SECTION_STRING_DATA);
+        m_metadata = std::string_view(at(SECTION_METADATA), sections[SECTION_METADATA].size);
+        return true;
+    }
+
+    bool ProjectBinaryFile::load(EdxProject& project)
+    {
+        if (!is_open())
+        {
+            m_error = "No .edXb file is open";
+            return false;
+        }
+
+        try
+        {
+            EdxProject loaded;
+            loaded.from_json(json::parse(m_metadata));
+            if (loaded.layers.size() != m_layerCount)
+            {
+                m_error = "Corrupt .edXb file: layer count does not match the metadata";
+                return false;
+            }
+
+            for (size_t layer = 0; layer < m_layerCount; ++layer)
+            {
+                auto& ids = loaded.layers[layer].assetIds;
+                ids.reserve(m_layerAssetOffsets[layer + 1] - m_layerAssetOffsets[layer]);
+                for (uint64_t i = m_layerAssetOffsets[layer]; i < m_layerAssetOffsets[layer + 1]; ++i)
+                {
+                    ids.emplace_back(string(m_layerAssetIds[i]));
+                }
+            }
+
+            loaded.assets.resize(m_assetCount);
+            for (size_t i = 0; i < m_assetCount; ++i)
+            {
+                SceneAsset& asset = loaded.assets[i];
+                asset.id = asset_string(COLUMN_ID, i);
+                asset.uniqueId = asset_string(COLUMN_UNIQUE_ID, i);
+                asset.latitude = m_latitudes[i];
+                asset.longitude = m_longitudes[i];
+                asset.altitude = m_altitudes[i];
+                asset.heading = m_headings[i];
+                asset.associatedLibrary = asset_string(COLUMN_LIBRARY, i);
+                asset.layerId = asset_string(COLUMN_LAYER_ID, i);
+                asset.groupId = asset_string(COLUMN_GROUP_ID, i);
+                asset.locked = (m_flags[i] & FLAG_LOCKED) != 0;
+                asset.hidden = (m_flags[i] & FLAG_HIDDEN) != 0;
+                asset.selected = (m_flags[i] & FLAG_SELECTED) != 0;
+
+                const std::string_view properties = asset_string(COLUMN_PROPERTIES, i);
+                if (!properties.empty())
+                {
+                    asset.otherProperties = json::parse(properties);
+                }
+            }
+            loaded.rebuild_asset_index();
+
+            project = std::move(loaded);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            m_error = std::string("Corrupt .edXb file: ") + e.what();
+            return false;
+        }
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,151 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXProjectBinary.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "edXConfig.h"
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    struct EdxProject;
+
+    /**
+     * @brief Read only, memory mapped .edXb project file
+     *
+     * .edXb is a binary companion to the .edX JSON project, written next to it
+     * for fast loading. Assets are stored as columns: one array per numeric
+     * field, a byte of flags per asset, and for each string field an array of
+     * indices into a shared string pool, so a library name or layer id used
+     * by thousands of assets is stored once. Layer asset id lists use the
+     * same pool. The project, airport, library and settings blocks and the
+     * rest of the layers are kept as a small JSON document.
+     *
+     * Every section is 8 byte aligned and the whole file is validated on
+     * open, so the columns can be read in place straight from the mapping.
+     * load() turns the file into an EdxProject equal to the one it was
+     * written from. Values are little endian, as on every platform the
+     * editor builds for.
+     */
+    class EDX_API ProjectBinaryFile
+    {
+    public:
+        // String columns of the asset table
+        enum StringColumn : uint32_t
+        {
+            COLUMN_ID,
+            COLUMN_UNIQUE_ID,
+            COLUMN_LIBRARY,
+            COLUMN_LAYER_ID,
+            COLUMN_GROUP_ID,
+            COLUMN_PROPERTIES,      // otherProperties as compact JSON, empty if it has none
+            STRING_COLUMN_COUNT
+        };
+
+        // Bits of asset_flags()
+        enum AssetFlag : uint8_t
+        {
+            FLAG_LOCKED = 1 << 0,
+            FLAG_HIDDEN = 1 << 1,
+            FLAG_SELECTED = 1 << 2
+        };
+
+        ProjectBinaryFile();
+        ~ProjectBinaryFile();
+
+        ProjectBinaryFile(const ProjectBinaryFile&) = delete;
+        ProjectBinaryFile& operator=(const ProjectBinaryFile&) = delete;
+
+        /**
+         * @brief Companion path of a project: the same name with an .edXb extension
+         */
+        static std::filesystem::path companion_path(const std::filesystem::path& projectPath);
+
+        /**
+         * @brief Write a project as .edXb, through a temporary file like EdxProject::save_to_file
+         */
+        static bool write(const EdxProject& project, const std::filesystem::path& filePath, std::string* error = nullptr);
+
+        /**
+         * @brief Map a file and check its layout
+         *
+         * @return False with get_error() set if the file cannot be mapped or is not a valid .edXb file
+         */
+        bool open(const std::filesystem::path& filePath);
+        void close();
+
+        /**
+         * @brief Build the project stored in the open file
+         *
+         * @return False with get_error() set on failure. The project is only replaced on success.
+         */
+        bool load(EdxProject& project);
+
+        [[nodiscard]] bool is_open() const { return m_data != nullptr; }
+        [[nodiscard]] const std::string& get_error() const { return m_error; }
+
+        // In place access to the open file. Pointers stay valid until close().
+
+        [[nodiscard]] size_t asset_count() const { return m_assetCount; }
+        [[nodiscard]] const double* latitudes() const { return m_latitudes; }
+        [[nodiscard]] const double* longitudes() const { return m_longitudes; }
+        [[nodiscard]] const double* altitudes() const { return m_altitudes; }
+        [[nodiscard]] const double* headings() const { return m_headings; }
+        [[nodiscard]] const uint8_t* asset_flags() const { return m_flags; }
+
+        /**
+         * @brief String pool indices of one column, asset_count() of them
+         */
+        [[nodiscard]] const uint32_t* string_column(StringColumn column) const { return m_columns[column]; }
+        [[nodiscard]] std::string_view asset_string(StringColumn column, size_t asset) const { return string(m_columns[column][asset]); }
+
+        [[nodiscard]] size_t string_count() const { return m_stringCount; }
+        [[nodiscard]] std::string_view string(uint32_t index) const
+        {
+            return { m_stringData + m_stringOffsets[index], size_t(m_stringOffsets[index + 1] - m_stringOffsets[index]) };
+        }
+
+    private:
+        bool fail(std::string error);
+
+        struct Mapping;
+        std::unique_ptr<Mapping> m_mapping;
+        std::string m_error;
+
+        const char* m_data = nullptr;
+        size_t m_size = 0;
+
+        size_t m_assetCount = 0;
+        size_t m_layerCount = 0;
+        size_t m_stringCount = 0;
+        const double* m_latitudes = nullptr;
+        const double* m_longitudes = nullptr;
+        const double* m_altitudes = nullptr;
+        const double* m_headings = nullptr;
+        const uint8_t* m_flags = nullptr;
+        const uint32_t* m_columns[STRING_COLUMN_COUNT] = {};
+        const uint64_t* m_layerAssetOffsets = nullptr;
+        const uint32_t* m_layerAssetIds = nullptr;
+        const uint64_t* m_stringOffsets = nullptr;
+        const char* m_stringData = nullptr;
+        std::string_view m_metadata;
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -10,11 +10,16 @@
 * Created: 11/7/2025
 * -------------------------------------------------------
 */
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include "edXFileUtils.h"
 #include "edXProjectFile.h"
+#include "edXProjectStream.h"
 #include "edXTimeUtils.h"
+#include "edXValidation.h"
 
 /// ----------------------------------------------------------------------------
 
@@ -298,64 +303,131 @@ namespace edx
         if (j.contains("Settings")) {
             settings = j["Settings"];
         }
+
+        rebuild_asset_index();
+    }
+
+    namespace
+    {
+        // Writes value.dump(4) as it appears nested depth levels into a larger dump(4)
+        void write_nested(std::ostream& out, const json& value, size_t depth)
+        {
+            const std::string text = value.dump(4);
+            const std::string indent(depth * 4, ' ');
+
+            // Raw newlines only occur between tokens; those inside strings are escaped
+            size_t start = 0;
+            for (size_t newline = text.find('\n'); newline != std::string::npos; newline = text.find('\n', start)) {
+                out.write(text.data() + start, static_cast<std::streamsize>(newline + 1 - start));
+                out << indent;
+                start = newline + 1;
+            }
+            out.write(text.data() + start, static_cast<std::streamsize>(text.size() - start));
+        }
+
+        template <typename Record>
+        void write_records(std::ostream& out, const std::vector<Record>& records)
+        {
+            if (records.empty()) {
+                out << "[]";
+                return;
+            }
+
+            out << "[\n";
+            json j;
+            for (size_t i = 0; i < records.size(); ++i) {
+                records[i].to_json(j);
+                out << "        ";
+                write_nested(out, j, 2);
+                out << (i + 1 < records.size() ? ",\n" : "\n");
+            }
+            out << "    ]";
+        }
+    }
+
+    void EdxProject::write_json(std::ostream& out) const
+    {
+        json projectJson, airportJson;
+        project.to_json(projectJson);
+        airport.to_json(airportJson);
+
+        // Keys in the order a json object keeps them, which is sorted
+        out << "{\n    \"Airport\": ";
+        write_nested(out, airportJson, 1);
+        out << ",\n    \"Assets\": ";
+        write_records(out, assets);
+        out << ",\n    \"Layers\": ";
+        write_records(out, layers);
+        out << ",\n    \"Libraries\": ";
+        write_records(out, libraries);
+        out << ",\n    \"Project\": ";
+        write_nested(out, projectJson, 1);
+        if (!settings.empty()) {
+            out << ",\n    \"Settings\": ";
+            write_nested(out, settings, 1);
+        }
+        out << "\n}";
     }
 
     // File operations
     bool EdxProject::save_to_file(const std::filesystem::path& filePath) const
     {
+        std::filesystem::path tempPath = filePath;
+        tempPath += ".tmp";
+
         try {
-            json j;
-            to_json(j);
+            {
+                std::ofstream file(tempPath);
+                if (!file.is_open()) {
+                    std::cerr << "Error: Cannot open file for writing: " << tempPath << std::endl;
+                    return false;
+                }
+
+                // Pretty print JSON with 4-space indentation
+                write_json(file);
+                file.close();
+                if (file.fail()) {
+                    std::cerr << "Error: Cannot write file: " << tempPath << std::endl;
+                    std::filesystem::remove(tempPath);
+                    return false;
+                }
+            }
 
-            std::ofstream file(filePath);
-            if (!file.is_open()) {
-                std::cerr << "Error: Cannot open file for writing: " << filePath << std::endl;
+            // The previous file stays intact until the new one is on disk
+            std::string error;
+            if (!sync_file(tempPath) || !replace_file(tempPath, filePath, &error)) {
+                std::cerr << "Error saving project file: " << (error.empty() ? "cannot flush " + tempPath.string() : error) << std::endl;
+                std::filesystem::remove(tempPath);
                 return false;
             }
 
-            // Pretty print JSON with 4-space indentation
-            file << j.dump(4);
-            file.close();
-
             std::cout << "Successfully saved project to: " << filePath << std::endl;
             return true;
 
         } catch (const std::exception& e) {
             std::cerr << "Error saving project file: " << e.what() << std::endl;
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
             return false;
         }
     }
 
     bool EdxProject::load_from_file(const std::filesystem::path& filePath)
     {
-        try {
-            if (!std::filesystem::exists(filePath)) {
-                std::cerr << "Error: File does not exist: " << filePath << std::endl;
-                return false;
-            }
-
-            std::ifstream file(filePath);
-            if (!file.is_open()) {
-                std::cerr << "Error: Cannot open file for reading: " << filePath << std::endl;
-                return false;
-            }
-
-            json j;
-            file >> j;
-            file.close();
-
-            from_json(j);
-
-            std::cout << "Successfully loaded project from: " << filePath << std::endl;
-            return true;
-
-        } catch (const json::parse_error& e) {
-            std::cerr << "JSON parse error: " << e.what() << std::endl;
+        if (!std::filesystem::exists(filePath)) {
+            std::cerr << "Error: File does not exist: " << filePath << std::endl;
             return false;
-        } catch (const std::exception& e) {
-            std::cerr << "Error loading project file: " << e.what() << std::endl;
+        }
+
+        // Streams the file into the project; see ProjectStreamReader
+        ProjectStreamReader reader;
+        if (!reader.load(filePath, *this)) {
+            std::cerr << "Error loading project file: " << reader.get_error() << std::endl;
             return false;
         }
+
+        std::cout << "Successfully loaded project from: " << filePath << std::endl;
+        return true;
     }
 
     // Validation
@@ -366,67 +438,115 @@ namespace edx
 
     std::vector<std::string> EdxProject::get_validation_errors() const
     {
-        std::vector<std::string> errors;
+        // A fresh validator does a full pass; editors keep their own to re-check only edits
+        return ProjectValidator().validate(*this);
+    }
 
-        // Validate project info
-        if (project.name.empty()) {
-            errors.push_back("Project name cannot be empty");
+    // Asset management
+    namespace
+    {
+        // The assets vector is public; code that edits it directly leaves the index behind
+        bool index_covers(const EdxProject& project)
+        {
+            return project.assetIndex.get_asset_count() == project.assets.size();
         }
 
-        if (project.editorVersion.empty()) {
-            errors.push_back("Editor version cannot be empty");
+        bool index_matches(const EdxProject& project, const std::optional<size_t>& index, const std::string& id)
+        {
+            return index && *index < project.assets.size() && project.assets[*index].id == id;
         }
+    }
 
-        // Validate airport info
-        if (airport.icao.empty()) {
-            errors.push_back("Airport ICAO code cannot be empty");
+    bool EdxProject::add_asset(const SceneAsset& asset)
+    {
+        if (!index_covers(*this)) {
+            rebuild_asset_index();
         }
 
-        if (airport.icao.length() != 4) {
-            errors.push_back("Airport ICAO code must be 4 characters");
+        if (asset.id.empty() || !assetIndex.insert(asset.id, asset.latitude, asset.longitude, assets.size())) {
+            return false;
         }
 
-        // Validate geographic coordinates
-        if (airport.datumLat < -90.0 || airport.datumLat > 90.0) {
-            errors.push_back("Airport latitude must be between -90 and 90 degrees");
+        assets.push_back(asset);
+        return true;
+    }
+
+    bool EdxProject::move_asset(const std::string& id, double latitude, double longitude, double altitude)
+    {
+        SceneAsset* asset = find_asset(id);
+        if (!asset || !assetIndex.move(id, latitude, longitude)) {
+            return false;
         }
 
-        if (airport.datumLon < -180.0 || airport.datumLon > 180.0) {
-            errors.push_back("Airport longitude must be between -180 and 180 degrees");
+        asset->latitude = latitude;
+        asset->longitude = longitude;
+        asset->altitude = altitude;
+        return true;
+    }
+
+    bool EdxProject::remove_asset(const std::string& id)
+    {
+        const SceneAsset* asset = find_asset(id);
+        if (!asset) {
+            return false;
         }
 
-        // Validate library references
-        for (const auto& lib : libraries) {
-            if (lib.name.empty()) {
-                errors.push_back("Library name cannot be empty");
-            }
-            if (lib.shortId.empty()) {
-                errors.push_back("Library short-id cannot be empty");
+        // Erase keeps the saved order of the assets; the ones after it move down a place
+        const size_t index = static_cast<size_t>(asset - assets.data());
+        assetIndex.remove(id);
+        assets.erase(assets.begin() + static_cast<std::ptrdiff_t>(index));
+        if (std::any_of(assets.begin() + static_cast<std::ptrdiff_t>(index), assets.end(), [&id](const SceneAsset& other) { return other.id == id; })) {
+            // A later duplicate of the id was skipped by the index and now takes its place
+            rebuild_asset_index();
+        } else {
+            for (size_t i = index; i < assets.size(); ++i) {
+                // A duplicate id is not indexed; its first occurrence keeps its own position
+                if (assetIndex.find(assets[i].id) == i + 1) {
+                    assetIndex.set_asset_index(assets[i].id, i);
+                }
             }
         }
 
-        // Validate assets
-        for (const auto& asset : assets) {
-            if (asset.id.empty()) {
-                errors.push_back("Asset ID cannot be empty");
-            }
+        for (auto& layer : layers) {
+            auto& ids = layer.assetIds;
+            ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+        }
+        return true;
+    }
 
-            // Validate geographic coordinates
-            if (asset.latitude < -90.0 || asset.latitude > 90.0) {
-                errors.push_back("Asset latitude must be between -90 and 90 degrees");
-            }
+    SceneAsset* EdxProject::find_asset(const std::string& id)
+    {
+        const auto index = assetIndex.find(id);
+        if (index_matches(*this, index, id)) {
+            return &assets[*index];
+        }
+        if (!index && index_covers(*this)) {
+            return nullptr;
+        }
 
-            if (asset.longitude < -180.0 || asset.longitude > 180.0) {
-                errors.push_back("Asset longitude must be between -180 and 180 degrees");
-            }
+        rebuild_asset_index();
+        const auto rebuilt = assetIndex.find(id);
+        return rebuilt ? &assets[*rebuilt] : nullptr;
+    }
 
-            // Validate heading
-            if (asset.heading < 0.0 || asset.heading >= 360.0) {
-                errors.push_back("Asset heading must be between 0 and 360 degrees");
-            }
+    const SceneAsset* EdxProject::find_asset(const std::string& id) const
+    {
+        const auto index = assetIndex.find(id);
+        if (index_matches(*this, index, id)) {
+            return &assets[*index];
         }
+        if (!index && index_covers(*this)) {
+            return nullptr;
+        }
+
+        // A stale index cannot be rebuilt here, so scan
+        const auto it = std::find_if(assets.begin(), assets.end(), [&id](const SceneAsset& asset) { return asset.id == id; });
+        return it != assets.end() ? &*it : nullptr;
+    }
 
-        return errors;
+    void EdxProject::rebuild_asset_index()
+    {
+        assetIndex.build(assets);
     }
 
 } // namespace edx
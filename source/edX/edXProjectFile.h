@@ -13,11 +13,13 @@
 */
 #pragma once
 #include <filesystem>
+#include <iosfwd>
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 #include "edXConfig.h"
+#include "edXGeoIndex.h"
 
 /// ----------------------------------------------------------------------------
 
@@ -184,17 +186,35 @@ namespace edx
         // Project-wide settings
         json settings;
 
+        // Spatial index over assets, keyed by asset id. Not serialized; rebuilt on load.
+        // Code that edits the assets vector directly must call rebuild_asset_index()
+        // before querying it; the asset management calls below rebuild it if they find it stale.
+        GeoIndex assetIndex;
+
         // JSON serialization support
         void to_json(json& j) const;
         void from_json(const json& j);
 
-        // File operations
+        // Writes the same text as to_json() followed by dump(4), one record at a
+        // time, so large projects never exist as a whole JSON document
+        void write_json(std::ostream& out) const;
+
+        // File operations. Saves go to a temporary file that replaces the
+        // target only once it is completely written.
         bool save_to_file(const std::filesystem::path& filePath) const;
         bool load_from_file(const std::filesystem::path& filePath);
 
         // Validation
         bool validate() const;
         [[nodiscard]] std::vector<std::string> get_validation_errors() const;
+
+        // Asset management, keeps assetIndex in sync
+        bool add_asset(const SceneAsset& asset);
+        bool move_asset(const std::string& id, double latitude, double longitude, double altitude);
+        bool remove_asset(const std::string& id);
+        SceneAsset* find_asset(const std::string& id);
+        const SceneAsset* find_asset(const std::string& id) const;
+        void rebuild_asset_index();
     };
 
 }
@@ -0,0 +1,792 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXProjectJournal.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <utility>
+#include "edXFileUtils.h"
+#include "edXProjectFile.h"
+#include "edXProjectJournal.h"
+#include "edXProjectStream.h"
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        constexpr int JOURNAL_VERSION = 1;
+
+        std::filesystem::path with_suffix(const std::filesystem::path& path, const char* suffix)
+        {
+            std::filesystem::path result = path;
+            result += suffix;
+            return result;
+        }
+
+        std::FILE* open_file(const std::filesystem::path& path, bool append)
+        {
+#if defined(_WIN32)
+            return _wfopen(path.c_str(), append ? L"ab" : L"wb");
+#else
+            return std::fopen(path.c_str(), append ? "ab" : "wb");
+#endif
+        }
+
+        std::string make_header(uint64_t baseHash)
+        {
+            char hex[17];
+            std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(baseHash));
+            return json{ { "edx-journal", JOURNAL_VERSION }, { "base-hash", hex } }.dump() + "\n";
+        }
+
+        std::optional<uint64_t> parse_header(const std::string& line)
+        {
+            const json header = json::parse(line, nullptr, false);
+            if (!header.is_object() || header.value("edx-journal", 0) != JOURNAL_VERSION || !header.contains("base-hash") || !header["base-hash"].is_string())
+            {
+                return std::nullopt;
+            }
+
+            try
+            {
+                return std::stoull(header["base-hash"].get<std::string>(), nullptr, 16);
+            }
+            catch (const std::exception&)
+            {
+                return std::nullopt;
+            }
+        }
+
+        // Writes a new journal file and flushes it to disk
+        bool write_journal_file(const std::filesystem::path& path, const std::string& text)
+        {
+            std::FILE* file = open_file(path, false);
+            if (!file)
+            {
+                return false;
+            }
+
+            const bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size() && sync_file(file);
+            return std::fclose(file) == 0 && ok;
+        }
+
+        // The same edits on the live project and on replay, so both end up alike
+
+        bool apply_put_asset(EdxProject& project, const SceneAsset& asset)
+        {
+            if (asset.id.empty())
+            {
+                return false;
+            }
+
+            if (SceneAsset* existing = project.find_asset(asset.id))
+            {
+                *existing = asset;
+                return project.assetIndex.move(asset.id, asset.latitude, asset.longitude);
+            }
+            return project.add_asset(asset);
+        }
+
+        bool apply_put_layer(EdxProject& project, const SceneLayer& layer)
+        {
+            if (layer.layerId.empty())
+            {
+                return false;
+            }
+
+            const auto it = std::find_if(project.layers.begin(), project.layers.end(), [&layer](const SceneLayer& l) { return l.layerId == layer.layerId; });
+            if (it != project.layers.end())
+            {
+                *it = layer;
+            }
+            else
+            {
+                project.layers.push_back(layer);
+            }
+            return true;
+        }
+
+        bool apply_remove_layer(EdxProject& project, const std::string& layerId)
+        {
+            const auto it = std::find_if(project.layers.begin(), project.layers.end(), [&layerId](const SceneLayer& l) { return l.layerId == layerId; });
+            if (it == project.layers.end())
+            {
+                return false;
+            }
+            project.layers.erase(it);
+            return true;
+        }
+
+        void apply_metadata(EdxProject& project, const json& record)
+        {
+            project.project.from_json(record.at("Project"));
+
+            // from_json only sets the frequencies that are present
+            project.airport = AirportInfo();
+            project.airport.from_json(record.at("Airport"));
+
+            project.libraries.clear();
+            for (const auto& libJson : record.at("Libraries"))
+            {
+                LibraryReference lib;
+                lib.from_json(libJson);
+                project.libraries.push_back(lib);
+            }
+
+            project.settings = record.value("Settings", json());
+        }
+
+        // Returns an error for records this version cannot apply
+        std::string apply_record(EdxProject& project, const json& record)
+        {
+            const std::string op = record.at("op").get<std::string>();
+            if (op == "put-asset")
+            {
+                SceneAsset asset;
+                asset.from_json(record.at("asset"));
+                return apply_put_asset(project, asset) ? std::string() : "asset without an id";
+            }
+            if (op == "remove-asset")
+            {
+                project.remove_asset(record.at("id").get<std::string>());
+                return {};
+            }
+            if (op == "put-layer")
+            {
+                SceneLayer layer;
+                layer.from_json(record.at("layer"));
+                return apply_put_layer(project, layer) ? std::string() : "layer without an id";
+            }
+            if (op == "remove-layer")
+            {
+                apply_remove_layer(project, record.at("id").get<std::string>());
+                return {};
+            }
+            if (op == "put-metadata")
+            {
+                apply_metadata(project, record);
+                return {};
+            }
+            return "unknown record '" + op + "'";
+        }
+
+        struct ReplayResult
+        {
+            bool stale = false;         // Written against another base
+            uint64_t validBytes = 0;    // Length of the complete lines read
+            size_t records = 0;
+            std::string error;
+        };
+
+        /**
+         * Applies the journal lines before the limit to the project. A last
+         * line without its newline is a commit cut short and is not applied.
+         */
+        ReplayResult replay_journal(const std::filesystem::path& path, uint64_t limit, uint64_t baseHash, EdxProject& project)
+        {
+            ReplayResult result;
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open())
+            {
+                result.error = "Cannot open " + path.string();
+                return result;
+            }
+
+            std::string line;
+            if (!std::getline(file, line) || file.eof())
+            {
+                // Not even a whole header: the journal was never started
+                result.stale = true;
+                return result;
+            }
+
+            const std::optional<uint64_t> hash = parse_header(line);
+            if (!hash || *hash != baseHash)
+            {
+                result.stale = true;
+                return result;
+            }
+            result.validBytes = line.size() + 1;
+
+            while (result.validBytes < limit && std::getline(file, line) && !file.eof())
+            {
+                const json record = json::parse(line, nullptr, false);
+                if (record.is_discarded() || !record.is_object())
+                {
+                    result.error = "Corrupt record at byte " + std::to_string(result.validBytes);
+                    return result;
+                }
+
+                try
+                {
+                    const std::string error = apply_record(project, record);
+                    if (!error.empty())
+                    {
+                        result.error = error + " at byte " + std::to_string(result.validBytes);
+                        return result;
+                    }
+                }
+                catch (const json::exception& e)
+                {
+                    result.error = std::string(e.what()) + " at byte " + std::to_string(result.validBytes);
+                    return result;
+                }
+
+                result.validBytes += line.size() + 1;
+                ++result.records;
+            }
+            return result;
+        }
+    }
+
+    ProjectJournal::ProjectJournal(std::filesystem::path projectPath, JournalOptions options)
+        : m_projectPath(std::move(projectPath)), m_journalPath(journal_path(m_projectPath)), m_options(options)
+    {
+    }
+
+    ProjectJournal::~ProjectJournal()
+    {
+        if (m_compaction.joinable())
+        {
+            m_compaction.join();
+        }
+        if (m_file)
+        {
+            std::fclose(m_file);
+        }
+    }
+
+    std::filesystem::path ProjectJournal::journal_path(const std::filesystem::path& projectPath)
+    {
+        return with_suffix(projectPath, ".journal");
+    }
+
+    bool ProjectJournal::replay(const std::filesystem::path& projectPath, EdxProject& project, size_t* records, std::string* error)
+    {
+        const std::filesystem::path journalPath = journal_path(projectPath);
+        const std::filesystem::path tempJournal = with_suffix(journalPath, ".tmp");
+        if (!std::filesystem::exists(journalPath) && !std::filesystem::exists(tempJournal))
+        {
+            return true;
+        }
+
+        const std::optional<uint64_t> baseHash = hash_file(projectPath);
+        if (!baseHash)
+        {
+            if (error)
+                *error = "Cannot read " + projectPath.string();
+            return false;
+        }
+
+        // A compaction stopped between its renames left the journal for this base in the temporary file
+        std::filesystem::path path = journalPath;
+        if (std::filesystem::exists(tempJournal))
+        {
+            std::string header;
+            std::ifstream tempFile(tempJournal, std::ios::binary);
+            std::getline(tempFile, header);
+            if (parse_header(header) == baseHash)
+            {
+                path = tempJournal;
+            }
+        }
+        if (!std::filesystem::exists(path))
+        {
+            return true;
+        }
+
+        const ReplayResult result = replay_journal(path, std::numeric_limits<uint64_t>::max(), *baseHash, project);
+        if (!result.error.empty())
+        {
+            if (error)
+                *error = "Journal " + path.string() + ": " + result.error;
+            return false;
+        }
+        if (records)
+        {
+            *records = result.records;
+        }
+        return true;
+    }
+
+    bool ProjectJournal::fold(const std::filesystem::path& projectPath, std::string* error)
+    {
+        if (!std::filesystem::exists(journal_path(projectPath)) && !std::filesystem::exists(with_suffix(journal_path(projectPath), ".tmp")))
+        {
+            return true;
+        }
+
+        JournalOptions options;
+        options.compactThreshold = 0;
+        ProjectJournal journal(projectPath, options);
+
+        EdxProject project;
+        bool ok = journal.open(project);
+        if (ok && journal.get_stats().replayedRecords > 0)
+        {
+            ok = journal.compact() && journal.wait_for_compaction();
+        }
+        if (!ok && error)
+        {
+            *error = journal.get_error();
+        }
+        return ok;
+    }
+
+    bool ProjectJournal::fail(std::string error)
+    {
+        m_error = std::move(error);
+        return false;
+    }
+
+    bool ProjectJournal::start_journal(uint64_t baseHash)
+    {
+        const std::filesystem::path tempPath = with_suffix(m_journalPath, ".tmp");
+        const std::string header = make_header(baseHash);
+
+        std::string error;
+        if (!write_journal_file(tempPath, header) || !replace_file(tempPath, m_journalPath, &error))
+        {
+            return fail(error.empty() ? "Cannot write " + tempPath.string() : error);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_file = open_file(m_journalPath, true);
+        m_journalBytes = header.size();
+        m_baseHash = baseHash;
+        return m_file ? true : fail("Cannot open " + m_journalPath.string());
+    }
+
+    bool ProjectJournal::open(EdxProject& project)
+    {
+        wait_for_compaction();
+        if (m_file)
+        {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+        m_pending.clear();
+        m_pendingRecords = 0;
+        m_error.clear();
+
+        std::error_code ec;
+        std::filesystem::remove(with_suffix(m_projectPath, ".compact"), ec);
+
+        const std::optional<uint64_t> baseHash = hash_file(m_projectPath);
+        if (!baseHash)
+        {
+            return fail("Cannot read " + m_projectPath.string());
+        }
+
+        // A compaction that replaced the base but not yet the journal
+        const std::filesystem::path tempJournal = with_suffix(m_journalPath, ".tmp");
+        if (std::filesystem::exists(tempJournal))
+        {
+            std::string header;
+            std::ifstream tempFile(tempJournal, std::ios::binary);
+            std::getline(tempFile, header);
+            tempFile.close();
+            if (parse_header(header) == baseHash)
+            {
+                std::string error;
+                if (!replace_file(tempJournal, m_journalPath, &error))
+                {
+                    return fail(error);
+                }
+            }
+            else
+            {
+                std::filesystem::remove(tempJournal, ec);
+            }
+        }
+
+        EdxProject loaded;
+        ProjectStreamReader reader;
+        if (!reader.load(m_projectPath, loaded))
+        {
+            return fail(reader.get_error());
+        }
+
+        ReplayResult replay;
+        replay.stale = true;
+        if (std::filesystem::exists(m_journalPath))
+        {
+            replay = replay_journal(m_journalPath, std::numeric_limits<uint64_t>::max(), *baseHash, loaded);
+            if (!replay.error.empty())
+            {
+                return fail("Journal " + m_journalPath.string() + ": " + replay.error);
+            }
+        }
+
+        if (replay.stale)
+        {
+            // Everything in it is already part of the base, or it belongs to another one
+            if (!start_journal(*baseHash))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // Drop a commit that was cut short so new records start on a fresh line
+            if (std::filesystem::file_size(m_journalPath) != replay.validBytes)
+            {
+                std::filesystem::resize_file(m_journalPath, replay.validBytes);
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_file = open_file(m_journalPath, true);
+            m_journalBytes = replay.validBytes;
+            m_baseHash = *baseHash;
+            if (!m_file)
+            {
+                return fail("Cannot open " + m_journalPath.string());
+            }
+        }
+
+        project = std::move(loaded);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.replayedRecords = replay.records;
+        return true;
+    }
+
+    bool ProjectJournal::create(const EdxProject& project)
+    {
+        wait_for_compaction();
+        if (m_file)
+        {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+        m_pending.clear();
+        m_pendingRecords = 0;
+        m_error.clear();
+
+        if (!project.save_to_file(m_projectPath))
+        {
+            return fail("Cannot save " + m_projectPath.string());
+        }
+
+        // A journal left from the previous base is now stale, so it is replaced, not appended to
+        const std::optional<uint64_t> baseHash = hash_file(m_projectPath);
+        if (!baseHash)
+        {
+            return fail("Cannot read " + m_projectPath.string());
+        }
+        return start_journal(*baseHash);
+    }
+
+    void ProjectJournal::queue(const json& record)
+    {
+        m_pending += record.dump();
+        m_pending += '\n';
+        ++m_pendingRecords;
+    }
+
+    bool ProjectJournal::put_asset(EdxProject& project, const SceneAsset& asset)
+    {
+        if (!apply_put_asset(project, asset))
+        {
+            return false;
+        }
+
+        json assetJson;
+        asset.to_json(assetJson);
+        queue({ { "op", "put-asset" }, { "asset", std::move(assetJson) } });
+        return true;
+    }
+
+    bool ProjectJournal::remove_asset(EdxProject& project, const std::string& id)
+    {
+        if (!project.remove_asset(id))
+        {
+            return false;
+        }
+
+        queue({ { "op", "remove-asset" }, { "id", id } });
+        return true;
+    }
+
+    bool ProjectJournal::put_layer(EdxProject& project, const SceneLayer& layer)
+    {
+        if (!apply_put_layer(project, layer))
+        {
+            return false;
+        }
+
+        json layerJson;
+        layer.to_json(layerJson);
+        queue({ { "op", "put-layer" }, { "layer", std::move(layerJson) } });
+        return true;
+    }
+
+    bool ProjectJournal::remove_layer(EdxProject& project, const std::string& layerId)
+    {
+        if (!apply_remove_layer(project, layerId))
+        {
+            return false;
+        }
+
+        queue({ { "op", "remove-layer" }, { "id", layerId } });
+        return true;
+    }
+
+    void ProjectJournal::put_metadata(const EdxProject& project)
+    {
+        json projectJson, airportJson;
+        project.project.to_json(projectJson);
+        project.airport.to_json(airportJson);
+
+        json librariesJson = json::array();
+        for (const auto& lib : project.libraries)
+        {
+            json libJson;
+            lib.to_json(libJson);
+            librariesJson.push_back(libJson);
+        }
+
+        json record = { { "op", "put-metadata" }, { "Project", projectJson }, { "Airport", airportJson }, { "Libraries", librariesJson } };
+        if (!project.settings.empty())
+        {
+            record["Settings"] = project.settings;
+        }
+        queue(record);
+    }
+
+    bool ProjectJournal::commit()
+    {
+        if (m_pending.empty())
+        {
+            return true;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_file)
+            {
+                return fail("Journal is not open");
+            }
+
+            const bool written = std::fwrite(m_pending.data(), 1, m_pending.size(), m_file) == m_pending.size();
+            if (!written || (m_options.syncOnCommit ? !sync_file(m_file) : std::fflush(m_file) != 0))
+            {
+                // The file may end in part of a record now; open() again to trim it
+                std::fclose(m_file);
+                m_file = nullptr;
+                return fail("Cannot write " + m_journalPath.string());
+            }
+
+            m_journalBytes += m_pending.size();
+            m_stats.lastCommitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        m_pending.clear();
+        m_pendingRecords = 0;
+
+        if (m_options.compactThreshold > 0 && !m_compacting)
+        {
+            uint64_t bytes;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                bytes = m_journalBytes;
+            }
+            if (bytes >= m_options.compactThreshold)
+            {
+                compact();
+            }
+        }
+        return true;
+    }
+
+    bool ProjectJournal::compact()
+    {
+        if (m_compacting)
+        {
+            return false;
+        }
+        if (m_compaction.joinable())
+        {
+            m_compaction.join();
+        }
+
+        uint64_t bytes;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_file)
+            {
+                return fail("Journal is not open");
+            }
+            if (!m_compactionError.empty())
+            {
+                m_error = std::move(m_compactionError);
+                m_compactionError.clear();
+            }
+            bytes = m_journalBytes;
+        }
+
+        m_compacting = true;
+        m_compaction = std::thread(&ProjectJournal::run_compaction, this, bytes);
+        return true;
+    }
+
+    bool ProjectJournal::wait_for_compaction()
+    {
+        if (m_compaction.joinable())
+        {
+            m_compaction.join();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_compactionError.empty())
+        {
+            m_error = std::move(m_compactionError);
+            m_compactionError.clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool ProjectJournal::is_open() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_file != nullptr;
+    }
+
+    JournalStats ProjectJournal::get_stats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        JournalStats stats = m_stats;
+        stats.journalBytes = m_journalBytes;
+        stats.pendingRecords = m_pendingRecords;
+        return stats;
+    }
+
+    void ProjectJournal::run_compaction(uint64_t journalBytes)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const std::filesystem::path compactPath = with_suffix(m_projectPath, ".compact");
+        const std::filesystem::path tempJournal = with_suffix(m_journalPath, ".tmp");
+
+        uint64_t baseHash;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            baseHash = m_baseHash;
+        }
+
+        std::string error;
+        try
+        {
+            // Base plus the journal as it was when the compaction started
+            EdxProject project;
+            ProjectStreamReader reader;
+            if (!reader.load(m_projectPath, project))
+            {
+                error = reader.get_error();
+            }
+            else
+            {
+                const ReplayResult replay = replay_journal(m_journalPath, journalBytes, baseHash, project);
+                if (replay.stale)
+                {
+                    error = "Journal does not match " + m_projectPath.string();
+                }
+                else if (!replay.error.empty())
+                {
+                    error = replay.error;
+                }
+                else if (!project.save_to_file(compactPath))
+                {
+                    error = "Cannot write " + compactPath.string();
+                }
+            }
+
+            const std::optional<uint64_t> newHash = error.empty() ? hash_file(compactPath) : std::nullopt;
+            if (error.empty() && !newHash)
+            {
+                error = "Cannot read " + compactPath.string();
+            }
+
+            if (error.empty())
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                // Records committed while the base was being written start the new journal
+                std::string text = make_header(*newHash);
+                const uint64_t tailBytes = m_journalBytes - journalBytes;
+                if (tailBytes > 0)
+                {
+                    std::ifstream journal(m_journalPath, std::ios::binary);
+                    journal.seekg(static_cast<std::streamoff>(journalBytes));
+                    const size_t headerSize = text.size();
+                    text.resize(headerSize + tailBytes);
+                    journal.read(&text[headerSize], static_cast<std::streamsize>(tailBytes));
+                    if (static_cast<uint64_t>(journal.gcount()) != tailBytes)
+                    {
+                        error = "Cannot read " + m_journalPath.string();
+                    }
+                }
+
+                // Crash safe order: open() finishes a compaction stopped between the two renames
+                if (error.empty() && !write_journal_file(tempJournal, text))
+                {
+                    error = "Cannot write " + tempJournal.string();
+                }
+                if (error.empty() && replace_file(compactPath, m_projectPath, &error))
+                {
+                    std::fclose(m_file);
+                    m_file = nullptr;
+                    if (replace_file(tempJournal, m_journalPath, &error))
+                    {
+                        m_file = open_file(m_journalPath, true);
+                        m_journalBytes = text.size();
+                        m_baseHash = *newHash;
+                        if (!m_file)
+                        {
+                            error = "Cannot open " + m_journalPath.string();
+                        }
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+        }
+
+        std::error_code ec;
+        std::filesystem::remove(compactPath, ec);
+        if (!error.empty())
+        {
+            std::filesystem::remove(tempJournal, ec);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_compactionError = error;
+            if (error.empty())
+            {
+                ++m_stats.compactions;
+                m_stats.lastCompactionMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+        }
+        m_compacting = false;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,186 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXProjectJournal.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "edXConfig.h"
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    struct EdxProject;
+    struct SceneAsset;
+    struct SceneLayer;
+
+    /**
+     * @brief Settings for ProjectJournal
+     */
+    struct EDX_API JournalOptions
+    {
+        bool syncOnCommit = true;                       // Flush the journal to disk on every commit
+        uint64_t compactThreshold = uint64_t(64) << 20; // Journal size at which commit() starts a compaction; 0 never does
+    };
+
+    /**
+     * @brief Figures for the journal, for diagnostics
+     */
+    struct EDX_API JournalStats
+    {
+        uint64_t journalBytes = 0;
+        size_t pendingRecords = 0;      // Edits waiting for the next commit
+        size_t replayedRecords = 0;     // Edits applied on top of the base by open()
+        size_t compactions = 0;
+        double lastCommitMs = 0.0;
+        double lastCompactionMs = 0.0;
+    };
+
+    /**
+     * @brief Append-only change journal kept beside an .edX project
+     *
+     * Edits are applied to the project through the journal, which queues one
+     * JSON line per changed asset, layer or metadata block. commit() appends
+     * the queued lines to "<project>.journal", so a save costs what was edited
+     * rather than the size of the project.
+     *
+     * Compaction folds the journal into the project file in the background:
+     * it loads the base, replays the committed journal onto it and writes the
+     * canonical pretty JSON through a temporary file and a rename. Edits
+     * committed meanwhile carry over into the new journal.
+     *
+     * The journal's first line holds a hash of the base it applies to. A
+     * journal whose base was replaced is stale and is dropped on open; a
+     * compaction interrupted between its two renames is finished on open.
+     *
+     * Replaying the journal gives the same project as loading a file saved
+     * from the edited project. Use one journal per project, from one thread.
+     */
+    class EDX_API ProjectJournal
+    {
+    public:
+        explicit ProjectJournal(std::filesystem::path projectPath, JournalOptions options = {});
+        ~ProjectJournal();
+
+        ProjectJournal(const ProjectJournal&) = delete;
+        ProjectJournal& operator=(const ProjectJournal&) = delete;
+
+        static std::filesystem::path journal_path(const std::filesystem::path& projectPath);
+
+        /**
+         * @brief Apply the committed journal of a project to a base loaded some other way
+         *
+         * For loaders that read the base themselves, such as the .edXb
+         * companion. Nothing is written; a missing or stale journal applies
+         * nothing.
+         *
+         * @return False with the error set if the journal is corrupt
+         */
+        static bool replay(const std::filesystem::path& projectPath, EdxProject& project, size_t* records = nullptr, std::string* error = nullptr);
+
+        /**
+         * @brief Fold the committed journal into the project file and wait for it
+         *
+         * Call before replacing the project file by other means, which would
+         * leave the journal stale. Does nothing if the project has no journal.
+         */
+        static bool fold(const std::filesystem::path& projectPath, std::string* error = nullptr);
+
+        /**
+         * @brief Load the project file and replay its journal onto it
+         */
+        bool open(EdxProject& project);
+
+        /**
+         * @brief Save a whole project as the base and start an empty journal
+         */
+        bool create(const EdxProject& project);
+
+        // Edits: applied to the project now, written by the next commit()
+
+        /**
+         * @brief Add an asset, or replace the one with the same id
+         *
+         * @return False if the asset has no id
+         */
+        bool put_asset(EdxProject& project, const SceneAsset& asset);
+        bool remove_asset(EdxProject& project, const std::string& id);
+
+        /**
+         * @brief Add a layer, or replace the one with the same layer id
+         */
+        bool put_layer(EdxProject& project, const SceneLayer& layer);
+        bool remove_layer(EdxProject& project, const std::string& layerId);
+
+        /**
+         * @brief Record the project, airport, library and settings blocks after editing them directly
+         */
+        void put_metadata(const EdxProject& project);
+
+        /**
+         * @brief Append the queued edits to the journal
+         */
+        bool commit();
+
+        /**
+         * @brief Start folding the committed journal into the project file
+         *
+         * @return False if a compaction is already running or the journal is not open
+         */
+        bool compact();
+
+        /**
+         * @brief Wait for a running compaction
+         *
+         * @return False with get_error() set if it failed; the journal is still intact then
+         */
+        bool wait_for_compaction();
+
+        [[nodiscard]] bool is_compacting() const { return m_compacting; }
+        [[nodiscard]] bool is_open() const;
+        [[nodiscard]] const std::string& get_error() const { return m_error; }
+        [[nodiscard]] JournalStats get_stats() const;
+
+    private:
+        bool fail(std::string error);
+        bool start_journal(uint64_t baseHash);
+        void queue(const json& record);
+        void run_compaction(uint64_t journalBytes);
+
+        std::filesystem::path m_projectPath;
+        std::filesystem::path m_journalPath;
+        JournalOptions m_options;
+
+        std::string m_pending;
+        size_t m_pendingRecords = 0;
+        std::string m_error;
+
+        // Shared with the compaction thread
+        mutable std::mutex m_mutex;
+        JournalStats m_stats;
+        std::FILE* m_file = nullptr;
+        uint64_t m_journalBytes = 0;
+        uint64_t m_baseHash = 0;
+        std::string m_compactionError;
+        std::atomic<bool> m_compacting { false };
+        std::thread m_compaction;
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
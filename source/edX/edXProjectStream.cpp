@@ -0,0 +1,1139 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXProjectStream.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "edXProjectFile.h"
+#include "edXProjectStream.h"
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        bool is_space(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        // A SAX value event, before it is stored into a record field
+        struct SaxValue
+        {
+            enum class Kind { Null, Boolean, Integer, Unsigned, Float, String, Object, Array };
+
+            Kind kind = Kind::Null;
+            bool boolean = false;
+            int64_t integer = 0;
+            uint64_t unsignedInteger = 0;
+            double number = 0.0;
+            std::string* text = nullptr;
+
+            [[nodiscard]] bool is_number() const { return kind == Kind::Integer || kind == Kind::Unsigned || kind == Kind::Float; }
+
+            [[nodiscard]] double as_double() const
+            {
+                switch (kind)
+                {
+                    case Kind::Integer: return static_cast<double>(integer);
+                    case Kind::Unsigned: return static_cast<double>(unsignedInteger);
+                    case Kind::Boolean: return boolean ? 1.0 : 0.0;
+                    default: return number;
+                }
+            }
+
+            [[nodiscard]] int as_int() const
+            {
+                switch (kind)
+                {
+                    case Kind::Unsigned: return static_cast<int>(unsignedInteger);
+                    case Kind::Float: return static_cast<int>(number);
+                    case Kind::Boolean: return boolean ? 1 : 0;
+                    default: return static_cast<int>(integer);
+                }
+            }
+
+            [[nodiscard]] json to_json() const
+            {
+                switch (kind)
+                {
+                    case Kind::Boolean: return boolean;
+                    case Kind::Integer: return integer;
+                    case Kind::Unsigned: return unsignedInteger;
+                    case Kind::Float: return number;
+                    case Kind::String: return std::move(*text);
+                    default: return nullptr;
+                }
+            }
+        };
+
+        // Where the value of a record key goes
+        struct FieldSlot
+        {
+            enum class Type { Unknown, String, Double, Int, Bool, Json, StringList };
+
+            Type type = Type::Unknown;
+            void* target = nullptr;
+        };
+
+        FieldSlot asset_field(SceneAsset& asset, const std::string& key)
+        {
+            using Type = FieldSlot::Type;
+            if (key == "id") return { Type::String, &asset.id };
+            if (key == "unique-id") return { Type::String, &asset.uniqueId };
+            if (key == "latitude") return { Type::Double, &asset.latitude };
+            if (key == "longitude") return { Type::Double, &asset.longitude };
+            if (key == "altitude") return { Type::Double, &asset.altitude };
+            if (key == "heading") return { Type::Double, &asset.heading };
+            if (key == "associated-library") return { Type::String, &asset.associatedLibrary };
+            if (key == "layer-id") return { Type::String, &asset.layerId };
+            if (key == "group-id") return { Type::String, &asset.groupId };
+            if (key == "locked") return { Type::Bool, &asset.locked };
+            if (key == "hidden") return { Type::Bool, &asset.hidden };
+            if (key == "selected") return { Type::Bool, &asset.selected };
+            if (key == "other-properties") return { Type::Json, &asset.otherProperties };
+            return {};
+        }
+
+        FieldSlot layer_field(SceneLayer& layer, const std::string& key)
+        {
+            using Type = FieldSlot::Type;
+            if (key == "layer-id") return { Type::String, &layer.layerId };
+            if (key == "name") return { Type::String, &layer.name };
+            if (key == "description") return { Type::String, &layer.description };
+            if (key == "locked") return { Type::Bool, &layer.locked };
+            if (key == "hidden") return { Type::Bool, &layer.hidden };
+            if (key == "opacity") return { Type::Double, &layer.opacity };
+            if (key == "z-order") return { Type::Int, &layer.zOrder };
+            if (key == "asset-ids") return { Type::StringList, &layer.assetIds };
+            if (key == "layer-properties") return { Type::Json, &layer.layerProperties };
+            return {};
+        }
+
+        /**
+         * Builds a json value from SAX events, for the free form properties
+         * nested in records.
+         */
+        class JsonBuilder
+        {
+        public:
+            void begin(json& root)
+            {
+                m_root = &root;
+                m_stack.clear();
+            }
+
+            void value(json&& value) { place(std::move(value)); }
+            void key(std::string& key) { m_key = std::move(key); }
+            void start(json&& container) { m_stack.push_back(place(std::move(container))); }
+
+            // Returns true once the root value is complete
+            bool end()
+            {
+                m_stack.pop_back();
+                return m_stack.empty();
+            }
+
+        private:
+            json* place(json&& value)
+            {
+                if (m_stack.empty())
+                {
+                    *m_root = std::move(value);
+                    return m_root;
+                }
+
+                json& parent = *m_stack.back();
+                if (parent.is_array())
+                {
+                    parent.push_back(std::move(value));
+                    return &parent.back();
+                }
+
+                json& slot = parent[m_key];
+                slot = std::move(value);
+                return &slot;
+            }
+
+            json* m_root = nullptr;
+            std::vector<json*> m_stack;
+            std::string m_key;
+        };
+
+        /**
+         * SAX handler for an array of records, e.g. [ {asset}, {asset} ].
+         *
+         * Keys are looked up once as they arrive and values are stored straight
+         * into the record, with the same type rules as the records' from_json.
+         */
+        template <typename Record>
+        class RecordArrayHandler
+        {
+        public:
+            using FieldLookup = FieldSlot (*)(Record&, const std::string&);
+
+            RecordArrayHandler(std::vector<Record>& records, FieldLookup lookup, const char* noun)
+                : m_records(records), m_lookup(lookup), m_noun(noun)
+            {
+            }
+
+            [[nodiscard]] const std::string& get_error() const { return m_error; }
+
+            bool null()
+            {
+                SaxValue value;
+                return this->value(value);
+            }
+
+            bool boolean(bool v)
+            {
+                SaxValue value;
+                value.kind = SaxValue::Kind::Boolean;
+                value.boolean = v;
+                return this->value(value);
+            }
+
+            bool number_integer(json::number_integer_t v)
+            {
+                SaxValue value;
+                value.kind = SaxValue::Kind::Integer;
+                value.integer = v;
+                return this->value(value);
+            }
+
+            bool number_unsigned(json::number_unsigned_t v)
+            {
+                SaxValue value;
+                value.kind = SaxValue::Kind::Unsigned;
+                value.unsignedInteger = v;
+                return this->value(value);
+            }
+
+            bool number_float(json::number_float_t v, const std::string&)
+            {
+                SaxValue value;
+                value.kind = SaxValue::Kind::Float;
+                value.number = v;
+                return this->value(value);
+            }
+
+            bool string(std::string& v)
+            {
+                SaxValue value;
+                value.kind = SaxValue::Kind::String;
+                value.text = &v;
+                return this->value(value);
+            }
+
+            bool binary(json::binary_t&) { return fail("binary values are not supported"); }
+
+            bool key(std::string& key)
+            {
+                if (m_nested == Nested::Capture)
+                {
+                    m_builder.key(key);
+                }
+                else if (m_nested == Nested::None)
+                {
+                    m_slot = m_lookup(m_records.back(), key);
+                    m_key = std::move(key);
+                }
+                return true;
+            }
+
+            bool start_object(size_t) { return start(SaxValue::Kind::Object); }
+            bool start_array(size_t) { return start(SaxValue::Kind::Array); }
+            bool end_object() { return end(); }
+            bool end_array() { return end(); }
+
+            bool parse_error(size_t, const std::string&, const json::exception& e) { return fail(e.what()); }
+
+        private:
+            enum class Nested { None, Capture, Strings, Skip };
+
+            bool fail(std::string error)
+            {
+                m_error = std::move(error);
+                return false;
+            }
+
+            bool type_error(const char* expected)
+            {
+                return fail("'" + m_key + "' of a " + m_noun + " must be " + expected);
+            }
+
+            bool value(SaxValue& value)
+            {
+                switch (m_nested)
+                {
+                    case Nested::Capture:
+                        m_builder.value(value.to_json());
+                        return true;
+                    case Nested::Strings:
+                        if (value.kind != SaxValue::Kind::String)
+                        {
+                            return type_error("an array of strings");
+                        }
+                        static_cast<std::vector<std::string>*>(m_slot.target)->push_back(std::move(*value.text));
+                        return true;
+                    case Nested::Skip:
+                        return true;
+                    case Nested::None:
+                        break;
+                }
+
+                if (m_depth != 2)
+                {
+                    return fail(m_depth == 0 ? std::string("expected an array of ") + m_noun + "s" : std::string("each ") + m_noun + " must be an object");
+                }
+
+                return store(value);
+            }
+
+            bool store(SaxValue& value)
+            {
+                using Type = FieldSlot::Type;
+                switch (m_slot.type)
+                {
+                    case Type::Unknown:
+                        return true;
+                    case Type::String:
+                        if (value.kind != SaxValue::Kind::String)
+                        {
+                            return type_error("a string");
+                        }
+                        *static_cast<std::string*>(m_slot.target) = std::move(*value.text);
+                        return true;
+                    case Type::Double:
+                        if (!value.is_number())
+                        {
+                            return type_error("a number");
+                        }
+                        *static_cast<double*>(m_slot.target) = value.as_double();
+                        return true;
+                    case Type::Int:
+                        if (!value.is_number() && value.kind != SaxValue::Kind::Boolean)
+                        {
+                            return type_error("a number");
+                        }
+                        *static_cast<int*>(m_slot.target) = value.as_int();
+                        return true;
+                    case Type::Bool:
+                        if (value.kind != SaxValue::Kind::Boolean)
+                        {
+                            return type_error("a boolean");
+                        }
+                        *static_cast<bool*>(m_slot.target) = value.boolean;
+                        return true;
+                    case Type::Json:
+                        *static_cast<json*>(m_slot.target) = value.to_json();
+                        return true;
+                    case Type::StringList:
+                        return type_error("an array of strings");
+                }
+                return true;
+            }
+
+            bool start(SaxValue::Kind kind)
+            {
+                const bool isArray = kind == SaxValue::Kind::Array;
+                ++m_depth;
+
+                switch (m_nested)
+                {
+                    case Nested::Capture:
+                        m_builder.start(isArray ? json::array() : json::object());
+                        return true;
+                    case Nested::Strings:
+                        return type_error("an array of strings");
+                    case Nested::Skip:
+                        return true;
+                    case Nested::None:
+                        break;
+                }
+
+                if (m_depth == 1)
+                {
+                    return isArray ? true : fail(std::string("expected an array of ") + m_noun + "s");
+                }
+
+                if (m_depth == 2)
+                {
+                    if (isArray)
+                    {
+                        return fail(std::string("each ") + m_noun + " must be an object");
+                    }
+                    m_records.emplace_back();
+                    return true;
+                }
+
+                // A container value of a record key
+                using Type = FieldSlot::Type;
+                m_nestedDepth = m_depth;
+                switch (m_slot.type)
+                {
+                    case Type::Unknown:
+                        m_nested = Nested::Skip;
+                        return true;
+                    case Type::Json:
+                        m_nested = Nested::Capture;
+                        m_builder.begin(*static_cast<json*>(m_slot.target));
+                        m_builder.start(isArray ? json::array() : json::object());
+                        return true;
+                    case Type::StringList:
+                        if (!isArray)
+                        {
+                            return type_error("an array of strings");
+                        }
+                        m_nested = Nested::Strings;
+                        static_cast<std::vector<std::string>*>(m_slot.target)->clear();
+                        return true;
+                    case Type::String:
+                        return type_error("a string");
+                    case Type::Bool:
+                        return type_error("a boolean");
+                    default:
+                        return type_error("a number");
+                }
+            }
+
+            bool end()
+            {
+                if (m_nested == Nested::Capture)
+                {
+                    m_builder.end();
+                }
+
+                if (m_nested != Nested::None && m_depth == m_nestedDepth)
+                {
+                    m_nested = Nested::None;
+                }
+
+                --m_depth;
+                return true;
+            }
+
+            std::vector<Record>& m_records;
+            FieldLookup m_lookup;
+            const char* m_noun;
+
+            uint32_t m_depth = 0;           // 1 inside the array, 2 inside a record
+            Nested m_nested = Nested::None;
+            uint32_t m_nestedDepth = 0;     // Depth of the container value being captured or skipped
+            FieldSlot m_slot;
+            std::string m_key;
+            JsonBuilder m_builder;
+            std::string m_error;
+        };
+
+        struct AssetChunk
+        {
+            std::vector<SceneAsset> assets;
+            std::string error;
+        };
+
+        AssetChunk parse_asset_chunk(const std::string& text)
+        {
+            AssetChunk chunk;
+            RecordArrayHandler<SceneAsset> handler(chunk.assets, asset_field, "asset");
+            if (!json::sax_parse(text, &handler))
+            {
+                chunk.error = handler.get_error();
+                chunk.assets.clear();
+            }
+            return chunk;
+        }
+
+        /**
+         * Incremental scanner over the top level object of a project file.
+         *
+         * Only the structure needed to find value boundaries is tracked:
+         * nesting depth and whether the scan is inside a string. Everything
+         * else is left to the JSON parser that each section is handed to.
+         */
+        class ProjectScanner
+        {
+        public:
+            ProjectScanner(const ProjectStreamOptions& options, uint64_t totalBytes, EdxProject& project)
+                : m_options(options), m_totalBytes(totalBytes), m_project(project)
+            {
+                m_threads = options.threadCount ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+                m_chunkSize = std::max<size_t>(options.assetChunkSize, 1);
+            }
+
+            bool feed(const char* data, size_t size);
+            bool finish();
+
+            [[nodiscard]] const std::string& get_error() const { return m_error; }
+            [[nodiscard]] size_t get_chunk_count() const { return m_chunkCount; }
+
+        private:
+            enum class State { Start, Key, KeyText, Colon, Value, Section, Assets, AfterValue, End };
+
+            struct PendingChunk
+            {
+                std::future<AssetChunk> result;
+                uint64_t start = 0;
+            };
+
+            bool fail(std::string error)
+            {
+                m_error = std::move(error);
+                return false;
+            }
+
+            bool fail_at(uint64_t offset, const std::string& error)
+            {
+                return fail(error + " at byte " + std::to_string(offset));
+            }
+
+            size_t scan_section(const char* data, size_t i, size_t size);
+            size_t scan_assets(const char* data, size_t i, size_t size);
+            bool complete_section();
+            void submit_chunk();
+            bool collect_chunk();
+            bool collect_ready_chunks();
+            void report_progress();
+
+            const ProjectStreamOptions& m_options;
+            uint64_t m_totalBytes;
+            EdxProject& m_project;
+            unsigned m_threads = 1;
+            size_t m_chunkSize = 0;
+
+            State m_state = State::Start;
+            uint64_t m_offset = 0;          // File offset of the block being scanned
+            uint64_t m_reported = 0;
+            bool m_reportedAny = false;
+            std::string m_error;
+
+            // Key scanning
+            std::string m_key;
+            bool m_allowClose = true;
+            bool m_keyEscaped = false;
+
+            // Shared by section and Assets scanning
+            bool m_inString = false;
+            bool m_escape = false;
+            uint32_t m_depth = 0;
+
+            std::string m_section;
+            uint64_t m_sectionStart = 0;
+
+            std::string m_chunk;
+            uint64_t m_chunkStart = 0;
+            bool m_chunkCut = false;        // The current Assets array has been cut at least once
+            std::deque<PendingChunk> m_pending;
+            size_t m_chunkCount = 0;
+        };
+
+        bool ProjectScanner::feed(const char* data, size_t size)
+        {
+            size_t i = 0;
+
+            // UTF-8 byte order mark, which the DOM parser skips too
+            if (m_offset == 0 && size >= 3 && static_cast<unsigned char>(data[0]) == 0xEF && static_cast<unsigned char>(data[1]) == 0xBB && static_cast<unsigned char>(data[2]) == 0xBF)
+            {
+                i = 3;
+            }
+
+            while (i < size && m_error.empty())
+            {
+                const char c = data[i];
+                switch (m_state)
+                {
+                    case State::Start:
+                        if (is_space(c))
+                        {
+                            ++i;
+                        }
+                        else if (c == '{')
+                        {
+                            m_state = State::Key;
+                            ++i;
+                        }
+                        else
+                        {
+                            return fail_at(m_offset + i, "Expected a project object");
+                        }
+                        break;
+
+                    case State::Key:
+                        if (is_space(c))
+                        {
+                            ++i;
+                        }
+                        else if (c == '"')
+                        {
+                            m_key.clear();
+                            m_keyEscaped = false;
+                            m_escape = false;
+                            m_state = State::KeyText;
+                            ++i;
+                        }
+                        else if (c == '}' && m_allowClose)
+                        {
+                            m_state = State::End;
+                            ++i;
+                        }
+                        else
+                        {
+                            return fail_at(m_offset + i, "Expected a key");
+                        }
+                        break;
+
+                    case State::KeyText:
+                    {
+                        const size_t start = i;
+                        for (; i < size; ++i)
+                        {
+                            if (m_escape)
+                            {
+                                m_escape = false;
+                            }
+                            else if (data[i] == '\\')
+                            {
+                                m_escape = m_keyEscaped = true;
+                            }
+                            else if (data[i] == '"')
+                            {
+                                break;
+                            }
+                        }
+                        m_key.append(data + start, i - start);
+                        if (i < size)
+                        {
+                            if (m_keyEscaped)
+                            {
+                                m_key = json::parse("\"" + m_key + "\"").get<std::string>();
+                            }
+                            m_state = State::Colon;
+                            ++i;
+                        }
+                        break;
+                    }
+
+                    case State::Colon:
+                        if (is_space(c))
+                        {
+                            ++i;
+                        }
+                        else if (c == ':')
+                        {
+                            m_state = State::Value;
+                            ++i;
+                        }
+                        else
+                        {
+                            return fail_at(m_offset + i, "Expected ':' after \"" + m_key + "\"");
+                        }
+                        break;
+
+                    case State::Value:
+                        if (is_space(c))
+                        {
+                            ++i;
+                            break;
+                        }
+
+                        m_inString = false;
+                        m_escape = false;
+                        m_depth = 0;
+                        if (m_key == "Assets")
+                        {
+                            if (c != '[')
+                            {
+                                return fail_at(m_offset + i, "Assets must be an array");
+                            }
+
+                            // A repeated key replaces the earlier value, as in the DOM
+                            while (!m_pending.empty())
+                            {
+                                if (!collect_chunk())
+                                {
+                                    return false;
+                                }
+                            }
+                            m_project.assets.clear();
+
+                            m_chunk.assign(1, '[');
+                            m_chunkStart = m_offset + i;
+                            m_chunkCut = false;
+                            m_state = State::Assets;
+                            ++i;
+                        }
+                        else
+                        {
+                            m_section.clear();
+                            m_sectionStart = m_offset + i;
+                            m_state = State::Section;
+                        }
+                        break;
+
+                    case State::Section:
+                        i = scan_section(data, i, size);
+                        break;
+
+                    case State::Assets:
+                        i = scan_assets(data, i, size);
+                        break;
+
+                    case State::AfterValue:
+                        if (is_space(c))
+                        {
+                            ++i;
+                        }
+                        else if (c == ',')
+                        {
+                            m_allowClose = false;
+                            m_state = State::Key;
+                            ++i;
+                        }
+                        else if (c == '}')
+                        {
+                            m_state = State::End;
+                            ++i;
+                        }
+                        else
+                        {
+                            return fail_at(m_offset + i, "Expected ',' or '}'");
+                        }
+                        break;
+
+                    case State::End:
+                        if (!is_space(c))
+                        {
+                            return fail_at(m_offset + i, "Unexpected data after the project");
+                        }
+                        ++i;
+                        break;
+                }
+            }
+
+            m_offset += size;
+            if (!m_error.empty() || !collect_ready_chunks())
+            {
+                return false;
+            }
+
+            report_progress();
+            return true;
+        }
+
+        size_t ProjectScanner::scan_section(const char* data, size_t i, size_t size)
+        {
+            const size_t start = i;
+            size_t end = std::string::npos;
+
+            for (; i < size && end == std::string::npos; ++i)
+            {
+                const char c = data[i];
+                if (m_inString)
+                {
+                    if (m_escape)
+                    {
+                        m_escape = false;
+                    }
+                    else if (c == '\\')
+                    {
+                        m_escape = true;
+                    }
+                    else if (c == '"')
+                    {
+                        m_inString = false;
+                        if (m_depth == 0)
+                        {
+                            end = i + 1;
+                        }
+                    }
+                    continue;
+                }
+
+                switch (c)
+                {
+                    case '"':
+                        m_inString = true;
+                        break;
+                    case '{':
+                    case '[':
+                        ++m_depth;
+                        break;
+                    case '}':
+                    case ']':
+                        if (m_depth == 0)
+                        {
+                            end = i;
+                        }
+                        else if (--m_depth == 0)
+                        {
+                            end = i + 1;
+                        }
+                        break;
+                    case ',':
+                    case ' ':
+                    case '\t':
+                    case '\n':
+                    case '\r':
+                        // Ends a number or literal
+                        if (m_depth == 0)
+                        {
+                            end = i;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            if (end == std::string::npos)
+            {
+                m_section.append(data + start, size - start);
+                return size;
+            }
+
+            m_section.append(data + start, end - start);
+            m_state = State::AfterValue;
+            complete_section();
+            return end;
+        }
+
+        size_t ProjectScanner::scan_assets(const char* data, size_t i, size_t size)
+        {
+            size_t segment = i;
+
+            for (; i < size; ++i)
+            {
+                const char c = data[i];
+                if (m_inString)
+                {
+                    if (m_escape)
+                    {
+                        m_escape = false;
+                        continue;
+                    }
+
+                    // Skip to the next quote or escape
+                    while (i < size && data[i] != '"' && data[i] != '\\')
+                    {
+                        ++i;
+                    }
+                    if (i == size)
+                    {
+                        break;
+                    }
+
+                    if (data[i] == '\\')
+                    {
+                        m_escape = true;
+                    }
+                    else
+                    {
+                        m_inString = false;
+                    }
+                    continue;
+                }
+
+                if (c == '"')
+                {
+                    m_inString = true;
+                }
+                else if (c == '{' || c == '[')
+                {
+                    ++m_depth;
+                }
+                else if (c == '}' || c == ']')
+                {
+                    if (m_depth == 0)
+                    {
+                        if (c != ']')
+                        {
+                            fail_at(m_offset + i, "Unbalanced '}' in Assets");
+                            return size;
+                        }
+
+                        m_chunk.append(data + segment, i - segment);
+                        if (m_chunkCut && std::all_of(m_chunk.begin() + 1, m_chunk.end(), is_space))
+                        {
+                            fail_at(m_offset + i, "Trailing ',' in Assets");
+                            return size;
+                        }
+
+                        submit_chunk();
+                        m_state = State::AfterValue;
+                        return i + 1;
+                    }
+                    --m_depth;
+                }
+                else if (c == ',' && m_depth == 0 && m_chunk.size() + (i - segment) >= m_chunkSize)
+                {
+                    // Cut between two assets; the comma itself belongs to neither chunk
+                    m_chunk.append(data + segment, i - segment);
+                    submit_chunk();
+                    m_chunk.assign(1, '[');
+                    m_chunkStart = m_offset + i + 1;
+                    m_chunkCut = true;
+                    segment = i + 1;
+
+                    if (m_pending.size() >= m_threads && !collect_chunk())
+                    {
+                        return size;
+                    }
+                }
+            }
+
+            m_chunk.append(data + segment, size - segment);
+            return size;
+        }
+
+        bool ProjectScanner::complete_section()
+        {
+            if (m_key == "Layers")
+            {
+                m_project.layers.clear();
+                RecordArrayHandler<SceneLayer> handler(m_project.layers, layer_field, "layer");
+                if (!json::sax_parse(m_section, &handler))
+                {
+                    return fail("Layers: " + handler.get_error());
+                }
+            }
+            else if (m_key == "Project" || m_key == "Airport" || m_key == "Libraries" || m_key == "Settings")
+            {
+                // Small sections, converted by their from_json so both loaders agree
+                json value = json::parse(m_section);
+                if (m_key == "Project")
+                {
+                    m_project.project.from_json(value);
+                }
+                else if (m_key == "Airport")
+                {
+                    m_project.airport.from_json(value);
+                }
+                else if (m_key == "Libraries")
+                {
+                    m_project.libraries.clear();
+                    for (const auto& libJson : value)
+                    {
+                        LibraryReference lib;
+                        lib.from_json(libJson);
+                        m_project.libraries.push_back(lib);
+                    }
+                }
+                else
+                {
+                    m_project.settings = std::move(value);
+                }
+            }
+            else if (!json::accept(m_section))
+            {
+                // Unknown keys are ignored but must still be valid JSON
+                return fail("Invalid value for \"" + m_key + "\"");
+            }
+
+            m_section.clear();
+            m_section.shrink_to_fit();
+            return true;
+        }
+
+        void ProjectScanner::submit_chunk()
+        {
+            m_chunk.push_back(']');
+            m_pending.push_back({ std::async(std::launch::async, parse_asset_chunk, std::move(m_chunk)), m_chunkStart });
+            m_chunk = std::string();
+            m_chunk.reserve(m_chunkSize + 4096);
+            ++m_chunkCount;
+        }
+
+        bool ProjectScanner::collect_chunk()
+        {
+            PendingChunk pending = std::move(m_pending.front());
+            m_pending.pop_front();
+
+            AssetChunk chunk = pending.result.get();
+            if (!chunk.error.empty())
+            {
+                return fail("Assets: " + chunk.error + " (in the chunk starting at byte " + std::to_string(pending.start) + ")");
+            }
+
+            auto& assets = m_project.assets;
+            if (assets.empty() && m_totalBytes > pending.start)
+            {
+                // Size the vector once from the density of the first chunk
+                const double perByte = double(chunk.assets.size()) / double(std::max<uint64_t>(m_chunkSize, 1));
+                assets.reserve(static_cast<size_t>(perByte * double(m_totalBytes - pending.start) * 1.05) + chunk.assets.size());
+            }
+            assets.insert(assets.end(), std::make_move_iterator(chunk.assets.begin()), std::make_move_iterator(chunk.assets.end()));
+
+            report_progress();
+            return true;
+        }
+
+        bool ProjectScanner::collect_ready_chunks()
+        {
+            while (!m_pending.empty() && m_pending.front().result.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                if (!collect_chunk())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void ProjectScanner::report_progress()
+        {
+            if (!m_options.progress)
+            {
+                return;
+            }
+
+            // Everything before the first byte that is not parsed yet
+            uint64_t done = m_offset;
+            if (!m_pending.empty())
+            {
+                done = std::min(done, m_pending.front().start);
+            }
+            if (m_state == State::Section)
+            {
+                done = std::min(done, m_sectionStart);
+            }
+            else if (m_state == State::Assets)
+            {
+                done = std::min(done, m_chunkStart);
+            }
+
+            if (m_totalBytes > 0)
+            {
+                done = std::min(done, m_totalBytes);
+            }
+
+            if (done > m_reported || !m_reportedAny)
+            {
+                m_reported = done;
+                m_reportedAny = true;
+                m_options.progress(done, m_totalBytes);
+            }
+        }
+
+        bool ProjectScanner::finish()
+        {
+            if (m_state != State::End)
+            {
+                return fail("Unexpected end of file");
+            }
+
+            while (!m_pending.empty())
+            {
+                if (!collect_chunk())
+                {
+                    return false;
+                }
+            }
+
+            if (m_options.progress)
+            {
+                m_options.progress(m_offset, m_offset);
+            }
+            return true;
+        }
+    }
+
+    ProjectStreamReader::ProjectStreamReader(ProjectStreamOptions options)
+        : m_options(std::move(options))
+    {
+        m_options.readBlockSize = std::max<size_t>(m_options.readBlockSize, 64);
+    }
+
+    bool ProjectStreamReader::load(const std::filesystem::path& filePath, EdxProject& project)
+    {
+        std::error_code ec;
+        const uint64_t size = std::filesystem::file_size(filePath, ec);
+        if (ec)
+        {
+            m_error = "Cannot read " + filePath.string() + ": " + ec.message();
+            return false;
+        }
+
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file.is_open())
+        {
+            m_error = "Cannot open " + filePath.string();
+            return false;
+        }
+
+        return load(file, size, project);
+    }
+
+    bool ProjectStreamReader::load(std::istream& stream, uint64_t totalBytes, EdxProject& project)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        m_error.clear();
+        m_stats = {};
+
+        EdxProject loaded;
+        ProjectScanner scanner(m_options, totalBytes, loaded);
+        std::vector<char> block(m_options.readBlockSize);
+
+        try
+        {
+            while (stream)
+            {
+                stream.read(block.data(), static_cast<std::streamsize>(block.size()));
+                const size_t count = static_cast<size_t>(stream.gcount());
+                if (count == 0)
+                {
+                    break;
+                }
+
+                m_stats.bytesRead += count;
+                if (!scanner.feed(block.data(), count))
+                {
+                    m_error = scanner.get_error();
+                    return false;
+                }
+            }
+
+            if (stream.bad())
+            {
+                m_error = "Read error after " + std::to_string(m_stats.bytesRead) + " bytes";
+                return false;
+            }
+
+            if (!scanner.finish())
+            {
+                m_error = scanner.get_error();
+                return false;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            m_error = scanner.get_error().empty() ? e.what() : scanner.get_error();
+            return false;
+        }
+
+        loaded.rebuild_asset_index();
+        project = std::move(loaded);
+
+        m_stats.assetCount = project.assets.size();
+        m_stats.assetChunks = scanner.get_chunk_count();
+        m_stats.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
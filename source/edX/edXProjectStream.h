@@ -0,0 +1,98 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXProjectStream.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <string>
+#include "edXConfig.h"
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    struct EdxProject;
+
+    /**
+     * @brief Settings for ProjectStreamReader
+     */
+    struct EDX_API ProjectStreamOptions
+    {
+        // Called from the loading thread with the bytes parsed so far and the file size.
+        // bytesDone never goes down and the last call has bytesDone == bytesTotal.
+        std::function<void(uint64_t bytesDone, uint64_t bytesTotal)> progress;
+
+        size_t readBlockSize = size_t(1) << 20;      // Bytes read from the stream at a time
+        size_t assetChunkSize = size_t(4) << 20;     // Bytes of the Assets array handed to each parser task
+        unsigned threadCount = 0;                    // Parser tasks in flight; 0 uses the hardware concurrency
+    };
+
+    /**
+     * @brief Figures from the last load, for diagnostics
+     */
+    struct EDX_API ProjectStreamStats
+    {
+        uint64_t bytesRead = 0;
+        size_t assetCount = 0;
+        size_t assetChunks = 0;
+        double elapsedMs = 0.0;
+    };
+
+    /**
+     * @brief Loads .edX project files without building a JSON document first
+     *
+     * The file is read a block at a time and scanned for the top level keys.
+     * The Assets array, which is nearly all of a large project, is cut at
+     * element boundaries into chunks that are SAX parsed straight into
+     * SceneAsset records on worker threads, in parallel with reading the rest
+     * of the file. Layers are SAX parsed as well. The small sections (Project,
+     * Airport, Libraries, Settings) go through their from_json, so the result
+     * matches EdxProject::from_json field for field.
+     *
+     * Memory stays at the loaded project plus the chunks in flight, where the
+     * DOM path holds the whole document and the project at once.
+     */
+    class EDX_API ProjectStreamReader
+    {
+    public:
+        explicit ProjectStreamReader(ProjectStreamOptions options = {});
+
+        /**
+         * @brief Load a project file
+         *
+         * @return False with get_error() set if the file cannot be read or is
+         *         not a valid project. The project is only replaced on success.
+         */
+        bool load(const std::filesystem::path& filePath, EdxProject& project);
+
+        /**
+         * @brief Load a project from a stream
+         *
+         * @param totalBytes Size reported to the progress callback, 0 if unknown
+         */
+        bool load(std::istream& stream, uint64_t totalBytes, EdxProject& project);
+
+        [[nodiscard]] const std::string& get_error() const { return m_error; }
+        [[nodiscard]] const ProjectStreamStats& get_stats() const { return m_stats; }
+
+    private:
+        ProjectStreamOptions m_options;
+        std::string m_error;
+        ProjectStreamStats m_stats;
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
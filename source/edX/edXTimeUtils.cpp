@@ -21,8 +21,16 @@ namespace edx
     std::string time_point_to_iso_string(const std::chrono::system_clock::time_point& tp)
     {
         const auto time_t = std::chrono::system_clock::to_time_t(tp);
+
+        // Reentrant gmtime; projects are saved from background threads too
+        std::tm tm = {};
+#if defined(_WIN32)
+        gmtime_s(&tm, &time_t);
+#else
+        gmtime_r(&time_t, &tm);
+#endif
         std::stringstream ss;
-        ss << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%SZ");
+        ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
         return ss.str();
     }
 
@@ -31,7 +39,13 @@ namespace edx
         std::tm tm = {};
         std::stringstream ss(iso_string);
         ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
-        return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+
+        // The string is UTC; mktime would read it as local time and touches the shared time zone state
+#if defined(_WIN32)
+        return std::chrono::system_clock::from_time_t(_mkgmtime(&tm));
+#else
+        return std::chrono::system_clock::from_time_t(timegm(&tm));
+#endif
     }
 
 } // namespace edx
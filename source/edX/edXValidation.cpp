@@ -0,0 +1,443 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXValidation.cpp
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+
+#include "edXValidation.h"
+#include "edXLibraryFile.h"
+#include "edXProjectFile.h"
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <thread>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        enum AssetError : uint8_t
+        {
+            ASSET_ID_EMPTY = 1 << 0,
+            ASSET_LATITUDE = 1 << 1,
+            ASSET_LONGITUDE = 1 << 2,
+            ASSET_HEADING = 1 << 3,
+            ASSET_ID_DUPLICATE = 1 << 4,    // Reference checks only
+            ASSET_LIBRARY_UNKNOWN = 1 << 5  // Reference checks only
+        };
+
+        enum ObjectError : uint8_t
+        {
+            OBJECT_ID_EMPTY = 1 << 0,
+            OBJECT_ID_DUPLICATE = 1 << 1,
+            OBJECT_UNIQUE_ID_EMPTY = 1 << 2,
+            OBJECT_UNIQUE_ID_DUPLICATE = 1 << 3,
+            OBJECT_ASSET_TYPE_EMPTY = 1 << 4,
+            OBJECT_NAME_EMPTY = 1 << 5
+        };
+        constexpr uint8_t OBJECT_DUPLICATES = OBJECT_ID_DUPLICATE | OBJECT_UNIQUE_ID_DUPLICATE;
+
+        /// Runs fn(begin, end) over [0, count), on worker threads once count reaches the threshold
+        template <typename Fn>
+        void run_split(size_t count, const ValidationOptions& options, Fn&& fn)
+        {
+            const unsigned threads = options.threadCount ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+            if (threads <= 1 || count < options.parallelThreshold)
+            {
+                fn(size_t(0), count);
+                return;
+            }
+
+            const size_t step = (count + threads - 1) / threads;
+            std::vector<std::future<void>> tasks;
+            for (size_t begin = step; begin < count; begin += step)
+                tasks.push_back(std::async(std::launch::async, fn, begin, std::min(count, begin + step)));
+            fn(size_t(0), std::min(count, step));
+            for (auto& task : tasks)
+                task.get();
+        }
+
+        void take_unique(std::vector<size_t>& indices)
+        {
+            std::sort(indices.begin(), indices.end());
+            indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        }
+
+        using KeyMap = std::unordered_map<std::string, std::vector<uint32_t>>;
+
+        /// Flags every entity after the first filed under a key as a duplicate
+        void mark_duplicates(const KeyMap& map, const std::string& key, std::vector<uint8_t>& errors, uint8_t bit)
+        {
+            const auto it = map.find(key);
+            if (it == map.end())
+                return;
+
+            const std::vector<uint32_t>& indices = it->second;
+            for (size_t n = 0; n < indices.size(); ++n)
+            {
+                if (n == 0)
+                    errors[indices[n]] &= static_cast<uint8_t>(~bit);
+                else
+                    errors[indices[n]] |= bit;
+            }
+        }
+
+        /// Moves an entity from the key it was filed under to its current key and settles the duplicates of both
+        void refile(KeyMap& map, std::string& filed, const std::string& key, uint32_t index, std::vector<uint8_t>& errors, uint8_t bit)
+        {
+            if (!filed.empty())
+            {
+                const auto it = map.find(filed);
+                std::vector<uint32_t>& indices = it->second;
+                indices.erase(std::lower_bound(indices.begin(), indices.end(), index));
+                if (indices.empty())
+                    map.erase(it);
+                else
+                    mark_duplicates(map, filed, errors, bit);
+            }
+
+            errors[index] &= static_cast<uint8_t>(~bit);
+            if (!key.empty())
+            {
+                std::vector<uint32_t>& indices = map[key];
+                indices.insert(std::lower_bound(indices.begin(), indices.end(), index), index);
+                mark_duplicates(map, key, errors, bit);
+            }
+            filed = key;
+        }
+
+        /// Files entities in order, flagging each one whose key was already taken
+        template <typename KeyOf>
+        void file_all(KeyMap& map, std::vector<std::string>& filed, size_t count, KeyOf&& keyOf, std::vector<uint8_t>& errors, uint8_t bit)
+        {
+            map.clear();
+            filed.resize(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                filed[i] = keyOf(i);
+                if (filed[i].empty())
+                    continue;
+
+                std::vector<uint32_t>& indices = map[filed[i]];
+                if (!indices.empty())
+                    errors[i] |= bit;
+                indices.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        using Clock = std::chrono::steady_clock;
+
+        double elapsed_ms(Clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+    } // namespace
+
+    /// ----------------------------------------------------------------------------
+
+    ProjectValidator::ProjectValidator(ValidationOptions options)
+        : m_options(options)
+    {
+    }
+
+    void ProjectValidator::mark_asset_dirty(size_t assetIndex)
+    {
+        m_dirtyAssets.push_back(assetIndex);
+    }
+
+    void ProjectValidator::mark_layer_dirty(size_t layerIndex)
+    {
+        m_dirtyLayers.push_back(layerIndex);
+    }
+
+    void ProjectValidator::mark_all_dirty()
+    {
+        m_allDirty = true;
+    }
+
+    void ProjectValidator::check_assets(const EdxProject& project, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const SceneAsset& asset = project.assets[i];
+            uint8_t errors = m_assetErrors[i] & ASSET_ID_DUPLICATE;
+            if (asset.id.empty())
+                errors |= ASSET_ID_EMPTY;
+            if (asset.latitude < -90.0 || asset.latitude > 90.0)
+                errors |= ASSET_LATITUDE;
+            if (asset.longitude < -180.0 || asset.longitude > 180.0)
+                errors |= ASSET_LONGITUDE;
+            if (asset.heading < 0.0 || asset.heading >= 360.0)
+                errors |= ASSET_HEADING;
+            if (m_options.checkReferences && !asset.associatedLibrary.empty() && !m_libraryIds.count(asset.associatedLibrary))
+                errors |= ASSET_LIBRARY_UNKNOWN;
+            m_assetErrors[i] = errors;
+        }
+    }
+
+    void ProjectValidator::check_layer(const EdxProject& project, size_t layer)
+    {
+        const SceneLayer& entry = project.layers[layer];
+        std::vector<std::string>& errors = m_layerErrors[layer];
+        errors.clear();
+        for (const std::string& id : entry.assetIds)
+        {
+            std::vector<uint32_t>& layers = m_idLayers[id];
+            if (std::find(layers.begin(), layers.end(), static_cast<uint32_t>(layer)) == layers.end())
+                layers.push_back(static_cast<uint32_t>(layer));
+            if (!m_idAssets.count(id))
+                errors.push_back("Layer " + entry.layerId + " references missing asset: " + id);
+        }
+    }
+
+    std::vector<std::string> ProjectValidator::validate(const EdxProject& project)
+    {
+        const auto start = Clock::now();
+        std::vector<std::string> errors;
+
+        // Validate project info
+        if (project.project.name.empty())
+            errors.push_back("Project name cannot be empty");
+        if (project.project.editorVersion.empty())
+            errors.push_back("Editor version cannot be empty");
+
+        // Validate airport info
+        if (project.airport.icao.empty())
+            errors.push_back("Airport ICAO code cannot be empty");
+        if (project.airport.icao.length() != 4)
+            errors.push_back("Airport ICAO code must be 4 characters");
+        if (project.airport.datumLat < -90.0 || project.airport.datumLat > 90.0)
+            errors.push_back("Airport latitude must be between -90 and 90 degrees");
+        if (project.airport.datumLon < -180.0 || project.airport.datumLon > 180.0)
+            errors.push_back("Airport longitude must be between -180 and 180 degrees");
+
+        // Validate library references
+        std::unordered_set<std::string> libraryIds;
+        for (const auto& lib : project.libraries)
+        {
+            if (lib.name.empty())
+                errors.push_back("Library name cannot be empty");
+            if (lib.shortId.empty())
+                errors.push_back("Library short-id cannot be empty");
+            libraryIds.insert(lib.shortId);
+        }
+
+        // Everything is checked again when the entity counts or the libraries changed
+        const size_t assetCount = project.assets.size();
+        const size_t layerCount = project.layers.size();
+        bool full = m_allDirty || m_assetErrors.size() != assetCount || m_layerErrors.size() != layerCount;
+        if (m_options.checkReferences && libraryIds != m_libraryIds)
+        {
+            m_libraryIds = std::move(libraryIds);
+            full = true;
+        }
+
+        size_t checked = 0;
+        if (full)
+        {
+            m_assetErrors.assign(assetCount, 0);
+            m_layerErrors.assign(layerCount, {});
+            run_split(assetCount, m_options, [this, &project](size_t begin, size_t end) { check_assets(project, begin, end); });
+            checked = assetCount;
+
+            if (m_options.checkReferences)
+            {
+                file_all(m_idAssets, m_assetIds, assetCount, [&project](size_t i) { return project.assets[i].id; }, m_assetErrors, ASSET_ID_DUPLICATE);
+                m_idLayers.clear();
+                for (size_t layer = 0; layer < layerCount; ++layer)
+                    check_layer(project, layer);
+                checked += layerCount;
+            }
+        }
+        else
+        {
+            take_unique(m_dirtyAssets);
+            for (const size_t index : m_dirtyAssets)
+            {
+                if (index >= assetCount)
+                    continue;
+
+                // A new id can clear or raise duplicates and missing assets elsewhere
+                const std::string& id = project.assets[index].id;
+                if (m_options.checkReferences && m_assetIds[index] != id)
+                {
+                    for (const std::string& key : { m_assetIds[index], id })
+                    {
+                        const auto it = m_idLayers.find(key);
+                        if (it != m_idLayers.end())
+                            m_dirtyLayers.insert(m_dirtyLayers.end(), it->second.begin(), it->second.end());
+                    }
+                    refile(m_idAssets, m_assetIds[index], id, static_cast<uint32_t>(index), m_assetErrors, ASSET_ID_DUPLICATE);
+                }
+                check_assets(project, index, index + 1);
+                ++checked;
+            }
+
+            if (m_options.checkReferences)
+            {
+                take_unique(m_dirtyLayers);
+                for (const size_t layer : m_dirtyLayers)
+                {
+                    if (layer < layerCount)
+                    {
+                        check_layer(project, layer);
+                        ++checked;
+                    }
+                }
+            }
+        }
+        m_dirtyAssets.clear();
+        m_dirtyLayers.clear();
+        m_allDirty = false;
+
+        // Validate assets, from the cached bits
+        for (size_t i = 0; i < assetCount; ++i)
+        {
+            const uint8_t bits = m_assetErrors[i];
+            if (bits == 0)
+                continue;
+
+            const SceneAsset& asset = project.assets[i];
+            if (bits & ASSET_ID_EMPTY)
+                errors.push_back("Asset ID cannot be empty");
+            if (bits & ASSET_LATITUDE)
+                errors.push_back("Asset latitude must be between -90 and 90 degrees");
+            if (bits & ASSET_LONGITUDE)
+                errors.push_back("Asset longitude must be between -180 and 180 degrees");
+            if (bits & ASSET_HEADING)
+                errors.push_back("Asset heading must be between 0 and 360 degrees");
+            if (bits & ASSET_ID_DUPLICATE)
+                errors.push_back("Duplicate asset ID: " + asset.id);
+            if (bits & ASSET_LIBRARY_UNKNOWN)
+                errors.push_back("Asset " + asset.id + " references unknown library: " + asset.associatedLibrary);
+        }
+
+        for (const auto& layerErrors : m_layerErrors)
+            errors.insert(errors.end(), layerErrors.begin(), layerErrors.end());
+
+        m_stats.checkedEntities = checked;
+        m_stats.fullPass = full;
+        m_stats.elapsedMs = elapsed_ms(start);
+        return errors;
+    }
+
+    /// ----------------------------------------------------------------------------
+
+    LibraryValidator::LibraryValidator(ValidationOptions options)
+        : m_options(options)
+    {
+    }
+
+    void LibraryValidator::mark_object_dirty(size_t objectIndex)
+    {
+        m_dirtyObjects.push_back(objectIndex);
+    }
+
+    void LibraryValidator::mark_all_dirty()
+    {
+        m_allDirty = true;
+    }
+
+    void LibraryValidator::check_objects(const LibraryFile& library, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const LibraryObject& obj = library.objects[i];
+            uint8_t errors = m_objectErrors[i] & OBJECT_DUPLICATES;
+            if (obj.id.empty())
+                errors |= OBJECT_ID_EMPTY;
+            if (obj.uniqueId.empty())
+                errors |= OBJECT_UNIQUE_ID_EMPTY;
+            if (obj.assetType.empty())
+                errors |= OBJECT_ASSET_TYPE_EMPTY;
+            if (obj.name.empty())
+                errors |= OBJECT_NAME_EMPTY;
+            m_objectErrors[i] = errors;
+        }
+    }
+
+    std::vector<std::string> LibraryValidator::validate(const LibraryFile& library)
+    {
+        const auto start = Clock::now();
+        std::vector<std::string> errors;
+
+        // Validate library info
+        if (library.library.name.empty())
+            errors.push_back("Library name cannot be empty");
+        if (library.library.version.empty())
+            errors.push_back("Library version cannot be empty");
+        if (library.library.author.empty())
+            errors.push_back("Library author cannot be empty");
+
+        const size_t count = library.objects.size();
+        const bool full = m_allDirty || m_objectErrors.size() != count;
+        size_t checked = 0;
+        if (full)
+        {
+            m_objectErrors.assign(count, 0);
+            run_split(count, m_options, [this, &library](size_t begin, size_t end) { check_objects(library, begin, end); });
+            file_all(m_idObjects, m_ids, count, [&library](size_t i) { return library.objects[i].id; }, m_objectErrors, OBJECT_ID_DUPLICATE);
+            file_all(m_uniqueIdObjects, m_uniqueIds, count, [&library](size_t i) { return library.objects[i].uniqueId; }, m_objectErrors, OBJECT_UNIQUE_ID_DUPLICATE);
+            checked = count;
+        }
+        else
+        {
+            take_unique(m_dirtyObjects);
+            for (const size_t index : m_dirtyObjects)
+            {
+                if (index >= count)
+                    continue;
+
+                const LibraryObject& obj = library.objects[index];
+                if (m_ids[index] != obj.id)
+                    refile(m_idObjects, m_ids[index], obj.id, static_cast<uint32_t>(index), m_objectErrors, OBJECT_ID_DUPLICATE);
+                if (m_uniqueIds[index] != obj.uniqueId)
+                    refile(m_uniqueIdObjects, m_uniqueIds[index], obj.uniqueId, static_cast<uint32_t>(index), m_objectErrors, OBJECT_UNIQUE_ID_DUPLICATE);
+                check_objects(library, index, index + 1);
+                ++checked;
+            }
+        }
+        m_dirtyObjects.clear();
+        m_allDirty = false;
+
+        // Validate objects, from the cached bits
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint8_t bits = m_objectErrors[i];
+            if (bits == 0)
+                continue;
+
+            const LibraryObject& obj = library.objects[i];
+            if (bits & OBJECT_ID_EMPTY)
+                errors.push_back("Object ID cannot be empty");
+            if (bits & OBJECT_ID_DUPLICATE)
+                errors.push_back("Duplicate object ID: " + obj.id);
+            if (bits & OBJECT_UNIQUE_ID_EMPTY)
+                errors.push_back("Object unique ID cannot be empty");
+            if (bits & OBJECT_UNIQUE_ID_DUPLICATE)
+                errors.push_back("Duplicate object unique ID: " + obj.uniqueId);
+            if (bits & OBJECT_ASSET_TYPE_EMPTY)
+                errors.push_back("Object asset type cannot be empty for object: " + obj.id);
+            if (bits & OBJECT_NAME_EMPTY)
+                errors.push_back("Object name cannot be empty for object: " + obj.id);
+        }
+
+        m_stats.checkedEntities = checked;
+        m_stats.fullPass = full;
+        m_stats.elapsedMs = elapsed_ms(start);
+        return errors;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,159 @@
+/**
+* -------------------------------------------------------
+* Scenery Editor X - edX File Format
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* edXValidation.h
+* -------------------------------------------------------
+* Created: 18/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "edXConfig.h"
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    struct EdxProject;
+    struct LibraryFile;
+
+    /**
+     * @brief Settings for ProjectValidator and LibraryValidator
+     */
+    struct EDX_API ValidationOptions
+    {
+        // Also report duplicate asset ids, assets whose library is not among the
+        // project's library references, and layer asset ids that match no asset.
+        // Off by default, so the errors match EdxProject::get_validation_errors().
+        bool checkReferences = false;
+
+        unsigned threadCount = 0;               // Checker tasks for a full pass; 0 uses the hardware concurrency
+        size_t parallelThreshold = 16384;       // Entities below which a pass stays on the calling thread
+    };
+
+    /**
+     * @brief Figures from the last validation, for diagnostics
+     */
+    struct EDX_API ValidationStats
+    {
+        size_t checkedEntities = 0;             // Assets, layers or objects checked by the last call
+        bool fullPass = false;
+        double elapsedMs = 0.0;
+    };
+
+    /**
+     * @brief Validates an EdxProject and re-checks only what changed since the last call
+     *
+     * Each asset's errors are kept as a few bits. The first validate() checks
+     * every asset, splitting them over worker threads for large projects.
+     * Later calls check only the assets and layers marked dirty, and go over
+     * everything again when the number of assets or layers changes or after
+     * mark_all_dirty(). The error list is rebuilt from the cached bits in
+     * project order, so it reads the same as a full check.
+     *
+     * Reference checks keep hash maps from each asset id to the assets
+     * using it and to the layers listing it. An asset whose id changes
+     * re-checks the assets and layers sharing its old and new ids, so
+     * duplicate and missing asset errors stay exact without a full pass.
+     * The few project, airport and library checks run on every call, and a
+     * change to the set of library short ids re-checks every asset.
+     *
+     * The caller marks what it edits. A change in the number of assets or
+     * layers is caught on its own, but a removal and an add between two
+     * calls leave the count as it was and need mark_all_dirty(). Use one
+     * validator per project.
+     */
+    class EDX_API ProjectValidator
+    {
+    public:
+        explicit ProjectValidator(ValidationOptions options = {});
+
+        /**
+         * @brief Validation errors for the project, same wording and order as EdxProject::get_validation_errors()
+         */
+        std::vector<std::string> validate(const EdxProject& project);
+
+        // Marks take indices into EdxProject::assets and EdxProject::layers
+        void mark_asset_dirty(size_t assetIndex);
+        void mark_layer_dirty(size_t layerIndex);
+        void mark_all_dirty();
+
+        [[nodiscard]] const ValidationStats& get_stats() const { return m_stats; }
+
+    private:
+        using KeyMap = std::unordered_map<std::string, std::vector<uint32_t>>;
+
+        void check_assets(const EdxProject& project, size_t begin, size_t end);
+        void check_layer(const EdxProject& project, size_t layer);
+
+        ValidationOptions m_options;
+        ValidationStats m_stats;
+
+        std::vector<uint8_t> m_assetErrors;             // AssetError bits per asset
+        std::vector<std::vector<std::string>> m_layerErrors;
+        std::unordered_set<std::string> m_libraryIds;  // Short ids of the library references
+
+        // Reference checks only
+        std::vector<std::string> m_assetIds;            // Key each asset is filed under
+        KeyMap m_idAssets;                              // Sorted asset indices per id
+        KeyMap m_idLayers;                              // Layers listing each id, possibly some that no longer do
+
+        std::vector<size_t> m_dirtyAssets;
+        std::vector<size_t> m_dirtyLayers;
+        bool m_allDirty = true;
+    };
+
+    /**
+     * @brief Validates a LibraryFile and re-checks only what changed since the last call
+     *
+     * Works like ProjectValidator. Duplicate ids are found through hash maps
+     * from each id and unique id to the objects using it, kept up to date as
+     * marked objects change, so an edit re-checks the objects sharing its
+     * old and new ids rather than the whole library.
+     */
+    class EDX_API LibraryValidator
+    {
+    public:
+        explicit LibraryValidator(ValidationOptions options = {});
+
+        /**
+         * @brief Validation errors for the library, same wording and order as LibraryFile::get_validation_errors()
+         */
+        std::vector<std::string> validate(const LibraryFile& library);
+
+        // Marks take indices into LibraryFile::objects
+        void mark_object_dirty(size_t objectIndex);
+        void mark_all_dirty();
+
+        [[nodiscard]] const ValidationStats& get_stats() const { return m_stats; }
+
+    private:
+        using KeyMap = std::unordered_map<std::string, std::vector<uint32_t>>;
+
+        void check_objects(const LibraryFile& library, size_t begin, size_t end);
+
+        ValidationOptions m_options;
+        ValidationStats m_stats;
+
+        std::vector<uint8_t> m_objectErrors;            // ObjectError bits per object
+        std::vector<std::string> m_ids;                 // Keys each object is filed under
+        std::vector<std::string> m_uniqueIds;
+        KeyMap m_idObjects;                             // Sorted object indices per key
+        KeyMap m_uniqueIdObjects;
+
+        std::vector<size_t> m_dirtyObjects;
+        bool m_allDirty = true;
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------